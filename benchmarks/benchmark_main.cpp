@@ -0,0 +1,90 @@
+/**
+ * @file benchmark_main.cpp
+ * @brief Entry point of the benchmark executable
+ *
+ * This file contains the entry point of VitalSyncBenchmarks. By default it
+ * runs the ingest microbenchmarks and the offscreen rendering benchmarks and
+ * prints one row per case; with --soak it runs the multi-bed soak test
+ * instead. Unless QT_QPA_PLATFORM says otherwise, Qt runs on the offscreen
+ * platform, so no display is needed.
+ *
+ * The benchmarks keep their settings under their own application name, so
+ * they neither read nor change the settings of the application.
+ */
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+
+#include "../include/config_manager.h"
+#include "../src/utils/metrics.h"
+#include "benchmark_runner.h"
+#include "benchmark_suites.h"
+#include "soak_driver.h"
+
+
+int main(int argc, char *argv[])
+{
+    // Render without a display unless a platform was chosen explicitly
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+    QApplication::setApplicationName("VitalSyncBenchmarks");
+    QApplication::setOrganizationName("VitalSyncTech");
+    QApplication::setOrganizationDomain("vitalsynctech.com");
+    QApplication::setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("VitalSync ingest and rendering benchmarks");
+    parser.addHelpOption();
+
+    const QCommandLineOption filterOption({ "f", "filter" }, "Only run cases whose name contains <text>.", "text");
+    const QCommandLineOption minTimeOption("min-time", "Time each case for at least <seconds> (default 0.5).", "seconds", "0.5");
+    const QCommandLineOption soakOption("soak", "Run the multi-bed soak test instead of the benchmark cases.");
+    const QCommandLineOption bedsOption("beds", "Number of beds of the soak test (default 16).", "count", "16");
+    const QCommandLineOption durationOption("duration", "Length of the soak test in <seconds> (default 60).", "seconds", "60");
+    const QCommandLineOption reportOption("report-interval", "Soak progress line every <seconds>, 0 for none (default 10).", "seconds", "10");
+    const QCommandLineOption frameRateOption("frame-rate", "Display frames per second of the soak test (default 60).", "fps", "60");
+    const QCommandLineOption loadRateOption("load-rate", "Soak beds replay templates at <hz> per channel, 0 for the demo waveforms (default 0).", "hz", "0");
+    const QCommandLineOption loadChannelsOption("load-channels", "Channels per soak bed with --load-rate (default 9).", "count", "9");
+    const QCommandLineOption maxRateOption("max-rate", "Generate the --load-rate load as fast as possible instead of in real time.");
+    parser.addOptions({ filterOption, minTimeOption, soakOption, bedsOption, durationOption, reportOption, frameRateOption,
+                        loadRateOption, loadChannelsOption, maxRateOption });
+    parser.process(app);
+
+    if (!ConfigManager::GetInstance().Initialize(QApplication::organizationName(), QApplication::applicationName())) {
+        return 1;
+    }
+    Metrics::SetEnabled(true);
+
+    if (parser.isSet(soakOption)) {
+        SoakDriver::Options options;
+        options.beds = qMax(1, parser.value(bedsOption).toInt());
+        options.durationSeconds = qMax(1, parser.value(durationOption).toInt());
+        options.reportIntervalSeconds = qMax(0, parser.value(reportOption).toInt());
+        options.frameRate = qBound(1.0, parser.value(frameRateOption).toDouble(), 1000.0);
+        options.loadSampleRate = qMax(0, parser.value(loadRateOption).toInt());
+        options.loadChannels = qMax(1, parser.value(loadChannelsOption).toInt());
+        options.maxRate = parser.isSet(maxRateOption);
+
+        SoakDriver driver(options);
+        QObject::connect(&driver, &SoakDriver::finished, &app, &QApplication::quit);
+        if (!driver.Start()) {
+            return 1;
+        }
+        return app.exec();
+    }
+
+    BenchmarkRunner runner(qMax(0.01, parser.value(minTimeOption).toDouble()), parser.value(filterOption));
+    RegisterIngestBenchmarks(runner);
+    RegisterRenderBenchmarks(runner);
+    if (runner.GetCaseCount() == 0) {
+        qWarning() << "No benchmark case matches the filter" << parser.value(filterOption);
+        return 1;
+    }
+
+    runner.Run();
+    return 0;
+}
@@ -0,0 +1,222 @@
+/**
+ * @file benchmark_runner.cpp
+ * @brief Implementation of the BenchmarkRunner class
+ *
+ * This file implements the BenchmarkRunner class, which calibrates a batch
+ * size for every case, times batches of operations for a minimum time and
+ * prints the time per operation as mean and percentiles.
+ */
+#include "benchmark_runner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+/**
+ * @namespace Anonymous namespace for benchmark timing constants
+ * @brief Contains the batch sizing and warm-up settings of the runner
+ */
+namespace {
+    const double BATCH_TARGET_NS = 20000.0;     ///< Targeted duration of one timed batch (20 µs)
+    const qint64 MAX_BATCH_SIZE = 1 << 20;      ///< Upper bound of the operations per batch
+    const int WARMUP_OPERATIONS = 16;           ///< Untimed operations before calibration
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Get the nanoseconds elapsed since a clock reading
+     * @param start Earlier clock reading
+     * @return Elapsed nanoseconds
+     */
+    double elapsedNs(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+
+    /**
+     * @brief Get a percentile of sorted samples
+     * @param sorted Samples in ascending order, not empty
+     * @param fraction Percentile as a fraction
+     * @return Sample at the percentile, nearest-rank
+     */
+    double percentile(const QVector<double>& sorted, double fraction)
+    {
+        const qsizetype rank = static_cast<qsizetype>(std::ceil(fraction * sorted.size()));
+        return sorted[std::clamp<qsizetype>(rank - 1, 0, sorted.size() - 1)];
+    }
+}
+
+/**
+ * @brief Summarize samples
+ * @param samples Samples; sorted in place
+ * @return Statistics, all zero for no samples
+ */
+SampleStatistics SampleStatistics::FromSamples(QVector<double>& samples)
+{
+    SampleStatistics statistics;
+    if (samples.isEmpty()) {
+        return statistics;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    double sum = 0.0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+
+    statistics.count = samples.size();
+    statistics.mean = sum / samples.size();
+    statistics.p50 = percentile(samples, 0.50);
+    statistics.p90 = percentile(samples, 0.90);
+    statistics.p99 = percentile(samples, 0.99);
+    statistics.max = samples.last();
+    return statistics;
+}
+
+/**
+ * @brief Constructor
+ * @param minSeconds Minimum time spent timing each case
+ * @param filter Only cases whose name contains this text are run; empty for all
+ */
+BenchmarkRunner::BenchmarkRunner(double minSeconds, const QString& filter)
+    : min_seconds_(minSeconds)
+    , filter_(filter)
+{
+}
+
+/**
+ * @brief Add a case
+ * @param name Case name, "group/case/variant"
+ * @param operation Function performing one operation
+ * @param itemsPerOperation Items one operation processes, such as samples; 0 for none
+ *
+ * Cases not matching the filter are dropped right away, together with the
+ * state their function captured.
+ */
+void BenchmarkRunner::Add(const QString& name, Operation operation, qint64 itemsPerOperation)
+{
+    AddWithSetup(name, [operation = std::move(operation)]() { return operation; }, itemsPerOperation);
+}
+
+/**
+ * @brief Add a case whose state is created right before it runs
+ * @param name Case name, "group/case/variant"
+ * @param setup Function creating the state and returning the operation;
+ *              an empty operation skips the case
+ * @param itemsPerOperation Items one operation processes, such as samples; 0 for none
+ */
+void BenchmarkRunner::AddWithSetup(const QString& name, Setup setup, qint64 itemsPerOperation)
+{
+    if (!filter_.isEmpty() && !name.contains(filter_)) {
+        return;
+    }
+
+    cases_.append(Case{ name, std::move(setup), itemsPerOperation });
+}
+
+/**
+ * @brief Run all cases matching the filter and print a table of results
+ * @return Results in the order the cases ran
+ */
+QVector<BenchmarkRunner::Result> BenchmarkRunner::Run()
+{
+    std::printf("%-52s %12s %12s %12s %12s %14s\n",
+                "case", "mean ns/op", "p50 ns/op", "p99 ns/op", "operations", "items/s");
+
+    QVector<Result> results;
+    results.reserve(cases_.size());
+    for (const Case& benchmark : cases_) {
+        // The operation, and the state it holds, only lives while the case runs
+        const Operation operation = benchmark.setup();
+        if (!operation) {
+            std::printf("%-52s skipped\n", qPrintable(benchmark.name));
+            continue;
+        }
+
+        results.append(runCase(benchmark, operation));
+        printResult(results.last());
+        std::fflush(stdout);
+    }
+
+    return results;
+}
+
+/**
+ * @brief Get the number of cases matching the filter
+ * @return Number of cases
+ */
+int BenchmarkRunner::GetCaseCount() const
+{
+    return static_cast<int>(cases_.size());
+}
+
+/**
+ * @brief Time one case
+ * @param benchmark The case
+ * @param operation The operation of the case
+ * @return Its result
+ *
+ * The batch size doubles until one batch takes at least BATCH_TARGET_NS.
+ * Operations slower than that run one per batch, so every operation then
+ * gives its own sample and the percentiles show its jitter.
+ */
+BenchmarkRunner::Result BenchmarkRunner::runCase(const Case& benchmark, const Operation& operation) const
+{
+    for (int i = 0; i < WARMUP_OPERATIONS; ++i) {
+        operation();
+    }
+
+    qint64 batchSize = 1;
+    while (batchSize < MAX_BATCH_SIZE) {
+        const Clock::time_point start = Clock::now();
+        for (qint64 i = 0; i < batchSize; ++i) {
+            operation();
+        }
+        if (elapsedNs(start) >= BATCH_TARGET_NS) {
+            break;
+        }
+        batchSize *= 2;
+    }
+
+    Result result;
+    result.name = benchmark.name;
+
+    QVector<double> perOperation;
+    double totalNs = 0.0;
+    const double budgetNs = min_seconds_ * 1e9;
+    while (totalNs < budgetNs) {
+        const Clock::time_point start = Clock::now();
+        for (qint64 i = 0; i < batchSize; ++i) {
+            operation();
+        }
+        const double batchNs = elapsedNs(start);
+
+        perOperation.append(batchNs / batchSize);
+        totalNs += batchNs;
+        result.operations += batchSize;
+    }
+
+    result.perOperationNs = SampleStatistics::FromSamples(perOperation);
+    if (benchmark.itemsPerOperation > 0 && totalNs > 0.0) {
+        result.itemsPerSecond = result.operations * benchmark.itemsPerOperation * 1e9 / totalNs;
+    }
+    return result;
+}
+
+/**
+ * @brief Print one result row
+ * @param result The result
+ */
+void BenchmarkRunner::printResult(const Result& result)
+{
+    std::printf("%-52s %12.1f %12.1f %12.1f %12lld %14.0f\n",
+                qPrintable(result.name),
+                result.perOperationNs.mean,
+                result.perOperationNs.p50,
+                result.perOperationNs.p99,
+                static_cast<long long>(result.operations),
+                result.itemsPerSecond);
+}
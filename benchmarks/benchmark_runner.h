@@ -0,0 +1,132 @@
+/**
+ * @file benchmark_runner.h
+ * @brief Definition of the BenchmarkRunner class
+ *
+ * This file contains the definition of the BenchmarkRunner class, the small
+ * timing harness behind the benchmark target, and of the SampleStatistics
+ * helper that summarizes timing samples as percentiles.
+ */
+#ifndef BENCHMARK_RUNNER_H
+#define BENCHMARK_RUNNER_H
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include <functional>
+
+/**
+ * @brief Percentiles of a set of timing samples
+ */
+struct SampleStatistics {
+    qint64 count = 0;       ///< Number of samples
+    double mean = 0.0;      ///< Mean of the samples
+    double p50 = 0.0;       ///< Median
+    double p90 = 0.0;       ///< 90th percentile
+    double p99 = 0.0;       ///< 99th percentile
+    double max = 0.0;       ///< Largest sample
+
+    /**
+     * @brief Summarize samples
+     * @param samples Samples; sorted in place
+     * @return Statistics, all zero for no samples
+     */
+    static SampleStatistics FromSamples(QVector<double>& samples);
+};
+
+/**
+ * @brief Runs named benchmark cases and prints their timings
+ *
+ * A case is a function performing one operation. The runner first measures
+ * how many operations fit into a batch of about BATCH_TARGET_NS, so that
+ * clock overhead and resolution do not distort cheap operations, then runs
+ * batches until the minimum time is used up. Every batch gives one sample
+ * of the time per operation, from which the mean and the percentiles are
+ * reported.
+ *
+ * Cases are run in the order they were added. Cases with expensive state,
+ * such as views rendering into large images, are added with a setup function
+ * instead: it is only called when the case is about to run, and the state it
+ * creates is released as soon as the case is done.
+ */
+class BenchmarkRunner {
+public:
+    using Operation = std::function<void()>;    ///< Performs one operation
+    using Setup = std::function<Operation()>;   ///< Creates the state of a case and returns its operation
+
+    /**
+     * @brief Result of one case
+     */
+    struct Result {
+        QString name;               ///< Case name
+        qint64 operations = 0;      ///< Operations timed
+        SampleStatistics perOperationNs;    ///< Time per operation over the batches, in nanoseconds
+        double itemsPerSecond = 0.0;        ///< Items processed per second, 0 if the case has no items
+    };
+
+    /**
+     * @brief Constructor
+     * @param minSeconds Minimum time spent timing each case
+     * @param filter Only cases whose name contains this text are run; empty for all
+     */
+    explicit BenchmarkRunner(double minSeconds = 0.5, const QString& filter = QString());
+
+    /**
+     * @brief Add a case
+     * @param name Case name, "group/case/variant"
+     * @param operation Function performing one operation
+     * @param itemsPerOperation Items one operation processes, such as samples; 0 for none
+     */
+    void Add(const QString& name, Operation operation, qint64 itemsPerOperation = 0);
+
+    /**
+     * @brief Add a case whose state is created right before it runs
+     * @param name Case name, "group/case/variant"
+     * @param setup Function creating the state and returning the operation;
+     *              an empty operation skips the case
+     * @param itemsPerOperation Items one operation processes, such as samples; 0 for none
+     */
+    void AddWithSetup(const QString& name, Setup setup, qint64 itemsPerOperation = 0);
+
+    /**
+     * @brief Run all cases matching the filter and print a table of results
+     * @return Results in the order the cases ran
+     */
+    QVector<Result> Run();
+
+    /**
+     * @brief Get the number of cases matching the filter
+     * @return Number of cases
+     */
+    int GetCaseCount() const;
+
+private:
+    /**
+     * @brief A registered case
+     */
+    struct Case {
+        QString name;                       ///< Case name
+        Setup setup;                        ///< Function creating the operation
+        qint64 itemsPerOperation;           ///< Items per operation
+    };
+
+    /**
+     * @brief Time one case
+     * @param benchmark The case
+     * @param operation The operation of the case
+     * @return Its result
+     */
+    Result runCase(const Case& benchmark, const Operation& operation) const;
+
+    /**
+     * @brief Print one result row
+     * @param result The result
+     */
+    static void printResult(const Result& result);
+
+private:
+    double min_seconds_;        ///< Minimum time spent timing each case
+    QString filter_;            ///< Case name filter
+    QVector<Case> cases_;       ///< Cases matching the filter, in the order they were added
+};
+
+#endif // BENCHMARK_RUNNER_H
@@ -0,0 +1,32 @@
+/**
+ * @file benchmark_suites.h
+ * @brief Registration functions of the benchmark groups
+ *
+ * This file declares the functions that add the ingest and rendering
+ * benchmark cases to a BenchmarkRunner.
+ */
+#ifndef BENCHMARK_SUITES_H
+#define BENCHMARK_SUITES_H
+
+class BenchmarkRunner;
+
+/**
+ * @brief Add the ingest microbenchmarks
+ * @param runner Runner to add the cases to
+ *
+ * Covers WaveformModel::addWaveformData at several buffer sizes, the
+ * DataManager dispatch of provider signals, ParameterModel::UpdateValue and
+ * ConfigManager lookups.
+ */
+void RegisterIngestBenchmarks(BenchmarkRunner& runner);
+
+/**
+ * @brief Add the offscreen rendering benchmarks
+ * @param runner Runner to add the cases to
+ *
+ * Renders WaveformView in every render mode and ParameterView into images
+ * of 1920x1080 and 3840x2160 pixels. Needs a QApplication.
+ */
+void RegisterRenderBenchmarks(BenchmarkRunner& runner);
+
+#endif // BENCHMARK_SUITES_H
@@ -0,0 +1,215 @@
+/**
+ * @file ingest_benchmarks.cpp
+ * @brief Microbenchmarks of the acquisition path
+ *
+ * This file adds the ingest benchmark cases: appending chunks to a
+ * WaveformModel at several buffer sizes, dispatching provider signals through
+ * a DataManager, updating a ParameterModel and looking up settings in the
+ * ConfigManager.
+ */
+#include "benchmark_runner.h"
+#include "benchmark_suites.h"
+
+#include "../include/config_manager.h"
+#include "../include/i_data_provider.h"
+#include "../src/core/data_manager.h"
+#include "../src/core/parameter_model.h"
+#include "../src/core/waveform_model.h"
+
+#include <QDebug>
+#include <QtMath>
+#include <memory>
+
+/**
+ * @namespace Anonymous namespace for ingest benchmark settings
+ * @brief Contains the chunk shapes and buffer sizes the cases are run with
+ */
+namespace {
+    const int CHUNK_SAMPLES = 10;           ///< Samples per chunk, 40 ms at 250 Hz as the demo provider sends
+    const qint64 CHUNK_INTERVAL_MS = 40;    ///< Timestamp step between chunks
+    const int WAVEFORM_COUNT = 9;           ///< Waveforms of a full frame
+    const int FRAME_PARAMETERS = 4;         ///< Parameter values of a full frame
+
+    /**
+     * @brief Model buffer sizes, in samples
+     *
+     * 5 s, 30 s, 5 min and 50 min at 250 Hz, from a single sweep to a long
+     * review buffer.
+     */
+    const int BUFFER_SIZES[] = { 1250, 7500, 75000, 750000 };
+
+    /**
+     * @brief Make a chunk of synthetic samples
+     * @param count Number of samples
+     * @return A sine period spread over the chunk
+     */
+    QVector<float> makeChunk(int count)
+    {
+        QVector<float> chunk(count);
+        for (int i = 0; i < count; ++i) {
+            chunk[i] = static_cast<float>(qSin(2.0 * M_PI * i / count));
+        }
+        return chunk;
+    }
+
+    /**
+     * @brief Add the WaveformModel cases
+     * @param runner Runner to add the cases to
+     */
+    void addWaveformModelCases(BenchmarkRunner& runner)
+    {
+        const QVector<float> chunk = makeChunk(CHUNK_SAMPLES);
+
+        for (int bufferSize : BUFFER_SIZES) {
+            auto model = std::make_shared<WaveformModel>(VitalSync::WaveformType::ECG_II);
+            model->SetMaxBufferSize(bufferSize);
+            model->SetActive(true);
+
+            auto timestamp = std::make_shared<qint64>(0);
+            runner.Add(QString("waveform_model/add/buffer=%1").arg(bufferSize),
+                       [model, timestamp, chunk]() {
+                           *timestamp += CHUNK_INTERVAL_MS;
+                           model->addWaveformData(*timestamp, chunk.constData(), static_cast<int>(chunk.size()));
+                       },
+                       CHUNK_SAMPLES);
+        }
+    }
+
+    /**
+     * @brief Create a data manager with its provider selected but not started
+     * @return The manager with all models built and active, or nullptr if it has no provider
+     */
+    std::shared_ptr<DataManager> createDispatchManager()
+    {
+        // A bed identifier keeps the manager from storing its provider selection
+        auto manager = std::make_shared<DataManager>(QString("benchmark"));
+        if (!manager->initialize() || !manager->GetCurrentProvider()) {
+            qWarning() << "Skipping a dispatch benchmark: no data provider available";
+            return nullptr;
+        }
+        for (VitalSync::WaveformType type : VitalSync::WAVEFORM_TYPES) {
+            manager->GetWaveformModel(static_cast<int>(type))->SetActive(true);
+        }
+        for (const auto& model : manager->GetAllParameterModels()) {
+            model->SetActive(true);
+        }
+        return manager;
+    }
+
+    /**
+     * @brief Add the DataManager dispatch cases
+     * @param runner Runner to add the cases to
+     *
+     * The cases emit the data signals of the selected provider themselves.
+     * They are directly connected, so the manager's handlers run on the
+     * calling thread exactly as they would on the acquisition thread.
+     */
+    void addDispatchCases(BenchmarkRunner& runner)
+    {
+        runner.AddWithSetup("data_manager/dispatch/waveform", []() -> BenchmarkRunner::Operation {
+            auto manager = createDispatchManager();
+            if (!manager) {
+                return nullptr;
+            }
+            auto timestamp = std::make_shared<qint64>(0);
+            return [manager, provider = manager->GetCurrentProvider(), timestamp, chunk = makeChunk(CHUNK_SAMPLES)]() {
+                *timestamp += CHUNK_INTERVAL_MS;
+                emit provider->waveformDataReceived(
+                    static_cast<int>(VitalSync::WaveformType::ECG_II), *timestamp, chunk);
+            };
+        }, CHUNK_SAMPLES);
+
+        runner.AddWithSetup("data_manager/dispatch/parameter", []() -> BenchmarkRunner::Operation {
+            auto manager = createDispatchManager();
+            if (!manager) {
+                return nullptr;
+            }
+            auto timestamp = std::make_shared<qint64>(0);
+            return [manager, provider = manager->GetCurrentProvider(), timestamp]() {
+                *timestamp += CHUNK_INTERVAL_MS;
+                emit provider->parameterDataReceived(
+                    static_cast<int>(VitalSync::ParameterType::SPO2), *timestamp, 97.0f);
+            };
+        }, 1);
+
+        runner.AddWithSetup("data_manager/dispatch/frame", []() -> BenchmarkRunner::Operation {
+            auto manager = createDispatchManager();
+            if (!manager) {
+                return nullptr;
+            }
+            auto frame = std::make_shared<VitalSync::DataFrame>();
+            const QVector<float> chunk = makeChunk(CHUNK_SAMPLES);
+            for (int waveform = 0; waveform < WAVEFORM_COUNT; ++waveform) {
+                frame->AppendChannel(waveform, chunk);
+            }
+            for (int parameter = 0; parameter < FRAME_PARAMETERS; ++parameter) {
+                frame->AppendParameter(parameter, 60.0f + parameter);
+            }
+            return [manager, provider = manager->GetCurrentProvider(), frame]() {
+                frame->timestamp += CHUNK_INTERVAL_MS;
+                emit provider->dataFrameReceived(*frame);
+            };
+        }, WAVEFORM_COUNT * CHUNK_SAMPLES);
+    }
+
+    /**
+     * @brief Add the ParameterModel cases
+     * @param runner Runner to add the cases to
+     */
+    void addParameterModelCases(BenchmarkRunner& runner)
+    {
+        auto model = std::make_shared<ParameterModel>(VitalSync::ParameterType::HR);
+        model->SetActive(true);
+
+        auto timestamp = std::make_shared<qint64>(0);
+        runner.Add("parameter_model/update",
+                   [model, timestamp]() {
+                       *timestamp += CHUNK_INTERVAL_MS;
+                       // Alternate values so every update is a change
+                       model->UpdateValue(*timestamp, (*timestamp / CHUNK_INTERVAL_MS) % 2 ? 72.0f : 73.0f);
+                   },
+                   1);
+    }
+
+    /**
+     * @brief Add the ConfigManager lookup cases
+     * @param runner Runner to add the cases to
+     */
+    void addConfigManagerCases(BenchmarkRunner& runner)
+    {
+        ConfigManager& config = ConfigManager::GetInstance();
+
+        runner.Add("config_manager/get_int", [&config]() {
+            volatile int value = config.GetInt("metrics/reportIntervalSec", 60);
+            Q_UNUSED(value);
+        });
+        runner.Add("config_manager/get_double", [&config]() {
+            volatile double value = config.GetDouble("filters/ecgMainsHz", 0.0);
+            Q_UNUSED(value);
+        });
+        runner.Add("config_manager/get_waveform_config", [&config]() {
+            const QVariantMap value = config.GetWaveformConfig(VitalSync::WaveformType::ECG_II);
+            Q_UNUSED(value);
+        });
+        runner.Add("config_manager/get_provider_config", [&config]() {
+            const QVariantMap value = config.GetProviderConfig("Demo");
+            Q_UNUSED(value);
+        });
+        runner.Add("config_manager/get_snapshot", [&config]() {
+            const std::shared_ptr<const ConfigManager::Snapshot> snapshot = config.GetSnapshot();
+            Q_UNUSED(snapshot);
+        });
+    }
+}
+
+/**
+ * @brief Add the ingest microbenchmarks
+ * @param runner Runner to add the cases to
+ */
+void RegisterIngestBenchmarks(BenchmarkRunner& runner)
+{
+    addWaveformModelCases(runner);
+    addDispatchCases(runner);
+    addParameterModelCases(runner);
+    addConfigManagerCases(runner);
+}
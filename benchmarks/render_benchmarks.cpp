@@ -0,0 +1,193 @@
+/**
+ * @file render_benchmarks.cpp
+ * @brief Offscreen rendering benchmarks of the waveform and parameter views
+ *
+ * This file adds the rendering benchmark cases. Every case feeds its model
+ * one chunk, lets the view handle a display tick and renders the whole view
+ * into a QImage, which is the cost of a full repaint at that resolution.
+ */
+#include "benchmark_runner.h"
+#include "benchmark_suites.h"
+
+#include "../src/core/parameter_model.h"
+#include "../src/core/waveform_model.h"
+#include "../src/ui/parameters/parameter_view.h"
+#include "../src/ui/waveforms/waveform_view.h"
+
+#include <QDateTime>
+#include <QImage>
+#include <QtMath>
+#include <memory>
+
+/**
+ * @namespace Anonymous namespace for rendering benchmark settings
+ * @brief Contains the resolutions, render modes and data rates of the cases
+ */
+namespace {
+    const int SAMPLE_RATE = 250;                ///< Sample rate of the synthetic waveform
+    const int CHUNK_SAMPLES = 10;               ///< Samples added per rendered frame
+    const qint64 CHUNK_INTERVAL_MS = 40;        ///< Timestamp step between chunks
+    const int BUFFER_SECONDS = 300;             ///< Length of the model buffer
+    const int PREFILL_SECONDS = 60;             ///< Data written before timing starts
+    const qint64 OVERVIEW_SPAN_MS = 60000;      ///< Window of the Overview mode
+
+    /**
+     * @brief A target resolution
+     */
+    struct Resolution {
+        const char* name;   ///< Name used in the case names
+        int width;          ///< Width in pixels
+        int height;         ///< Height in pixels
+    };
+
+    const Resolution RESOLUTIONS[] = {
+        { "1080p", 1920, 1080 },
+        { "4k", 3840, 2160 },
+    };
+
+    /**
+     * @brief A waveform render mode
+     */
+    struct Mode {
+        const char* name;               ///< Name used in the case names
+        WaveformView::RenderMode mode;  ///< The render mode
+    };
+
+    const Mode MODES[] = {
+        { "pixel_step", WaveformView::RenderMode::PixelStep },
+        { "time_based", WaveformView::RenderMode::TimeBased },
+        { "sweep_canvas", WaveformView::RenderMode::SweepCanvas },
+        { "overview", WaveformView::RenderMode::Overview },
+    };
+
+    /**
+     * @brief State of one waveform rendering case
+     */
+    struct WaveformCase {
+        std::shared_ptr<WaveformModel> model;   ///< Model fed by the case
+        std::shared_ptr<WaveformView> view;     ///< View under test
+        QImage image;                           ///< Render target
+        QVector<float> chunk;                   ///< Chunk buffer
+        qint64 timestamp = 0;                   ///< Timestamp of the last chunk
+        qint64 frameTime = 0;                   ///< Display clock of the last tick
+        qint64 phase = 0;                       ///< Sample counter of the synthetic signal
+
+        /**
+         * @brief Add a chunk of a synthetic, ECG-like signal to the model
+         */
+        void AddChunk()
+        {
+            for (int i = 0; i < CHUNK_SAMPLES; ++i, ++phase) {
+                const double t = static_cast<double>(phase % SAMPLE_RATE) / SAMPLE_RATE;
+                chunk[i] = static_cast<float>(0.1 * qSin(2.0 * M_PI * t) + (t > 0.30 && t < 0.34 ? 1.0 : 0.0));
+            }
+            timestamp += CHUNK_INTERVAL_MS;
+            model->addWaveformData(timestamp, chunk.constData(), CHUNK_SAMPLES);
+        }
+    };
+
+    /**
+     * @brief Show a widget without putting a window on screen
+     * @param widget The widget
+     * @param size Size of the widget
+     *
+     * The views skip display ticks while they are not visible, so the widget
+     * is shown, but marked to never appear on screen.
+     */
+    void showOffscreen(QWidget* widget, const QSize& size)
+    {
+        widget->setAttribute(Qt::WA_DontShowOnScreen);
+        widget->resize(size);
+        widget->show();
+    }
+
+    /**
+     * @brief Add the WaveformView cases
+     * @param runner Runner to add the cases to
+     */
+    void addWaveformViewCases(BenchmarkRunner& runner)
+    {
+        for (const Resolution& resolution : RESOLUTIONS) {
+            for (const Mode& mode : MODES) {
+                const QSize size(resolution.width, resolution.height);
+                const WaveformView::RenderMode renderMode = mode.mode;
+                runner.AddWithSetup(QString("render/waveform_view/%1/%2").arg(QLatin1String(mode.name), QLatin1String(resolution.name)),
+                                    [size, renderMode]() -> BenchmarkRunner::Operation {
+                    auto state = std::make_shared<WaveformCase>();
+                    state->model = std::make_shared<WaveformModel>(VitalSync::WaveformType::ECG_II);
+                    state->model->SetMaxBufferSize(BUFFER_SECONDS * SAMPLE_RATE);
+                    state->model->SetActive(true);
+                    state->chunk.resize(CHUNK_SAMPLES);
+                    state->timestamp = QDateTime::currentMSecsSinceEpoch() - PREFILL_SECONDS * 1000;
+                    for (int i = 0; i < PREFILL_SECONDS * SAMPLE_RATE / CHUNK_SAMPLES; ++i) {
+                        state->AddChunk();
+                    }
+
+                    state->view = std::make_shared<WaveformView>();
+                    state->view->SetModel(state->model);
+                    state->view->SetRenderMode(renderMode);
+                    state->view->SetOverviewWindow(OVERVIEW_SPAN_MS);
+                    showOffscreen(state->view.get(), size);
+                    state->image = QImage(size, QImage::Format_ARGB32_Premultiplied);
+
+                    return [state]() {
+                        state->AddChunk();
+                        state->frameTime += CHUNK_INTERVAL_MS;
+                        state->view->OnFrame(state->frameTime);
+                        state->view->render(&state->image);
+                    };
+                }, 1);
+            }
+        }
+    }
+
+    /**
+     * @brief State of one parameter rendering case
+     */
+    struct ParameterCase {
+        std::shared_ptr<ParameterModel> model;  ///< Model updated by the case
+        std::shared_ptr<ParameterView> view;    ///< View under test
+        QImage image;                           ///< Render target
+        qint64 timestamp = 0;                   ///< Timestamp of the last value
+        int updates = 0;                        ///< Number of values sent
+    };
+
+    /**
+     * @brief Add the ParameterView cases
+     * @param runner Runner to add the cases to
+     */
+    void addParameterViewCases(BenchmarkRunner& runner)
+    {
+        for (const Resolution& resolution : RESOLUTIONS) {
+            const QSize size(resolution.width, resolution.height);
+            runner.AddWithSetup(QString("render/parameter_view/%1").arg(QLatin1String(resolution.name)),
+                                [size]() -> BenchmarkRunner::Operation {
+                auto state = std::make_shared<ParameterCase>();
+                state->model = std::make_shared<ParameterModel>(VitalSync::ParameterType::HR);
+                state->model->SetActive(true);
+                state->timestamp = QDateTime::currentMSecsSinceEpoch();
+
+                state->view = std::make_shared<ParameterView>();
+                state->view->SetModel(state->model);
+                showOffscreen(state->view.get(), size);
+                state->image = QImage(size, QImage::Format_ARGB32_Premultiplied);
+
+                return [state]() {
+                    state->timestamp += CHUNK_INTERVAL_MS;
+                    state->model->UpdateValue(state->timestamp, 60.0f + (state->updates++ % 40));
+                    state->view->render(&state->image);
+                };
+            }, 1);
+        }
+    }
+}
+
+/**
+ * @brief Add the offscreen rendering benchmarks
+ * @param runner Runner to add the cases to
+ */
+void RegisterRenderBenchmarks(BenchmarkRunner& runner)
+{
+    addWaveformViewCases(runner);
+    addParameterViewCases(runner);
+}
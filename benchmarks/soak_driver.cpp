@@ -0,0 +1,217 @@
+/**
+ * @file soak_driver.cpp
+ * @brief Implementation of the SoakDriver class
+ *
+ * This file implements the SoakDriver class, which drives a headless central
+ * station of demo beds, times the rendering of every display frame and
+ * prints throughput and frame-time percentiles.
+ */
+#include "soak_driver.h"
+
+#include "benchmark_runner.h"
+
+#include "../include/sample_block_pool.h"
+#include "../src/core/bed_manager.h"
+#include "../src/ui/bed_grid_view.h"
+#include "../src/ui/frame_scheduler.h"
+#include "../src/ui/waveforms/waveform_view.h"
+
+#include <QDebug>
+#include <cstdio>
+
+/**
+ * @namespace Anonymous namespace for soak report helpers
+ * @brief Contains the formatting of the soak progress and summary lines
+ */
+namespace {
+    /**
+     * @brief Print throughput and ingest latency of a metrics interval
+     * @param interval Difference of two snapshots
+     */
+    void printThroughput(const Metrics::Snapshot& interval)
+    {
+        const double seconds = interval.takenAt / 1e6;
+        const Metrics::HistogramData& latency = interval.Get(Metrics::Histogram::IngestLatency);
+        std::printf("  ingest: %.0f frames/s, %.0f samples/s, latency p50 %.2f ms, p99 %.2f ms; %llu samples dropped\n",
+                    seconds > 0.0 ? interval.Get(Metrics::Counter::FramesIngested) / seconds : 0.0,
+                    seconds > 0.0 ? interval.Get(Metrics::Counter::SamplesIngested) / seconds : 0.0,
+                    latency.Percentile(0.50) / 1000.0,
+                    latency.Percentile(0.99) / 1000.0,
+                    static_cast<unsigned long long>(interval.Get(Metrics::Counter::SamplesDropped)));
+    }
+
+    /**
+     * @brief Print frame-time percentiles
+     * @param frameTimesMs Frame times in milliseconds; sorted in place
+     */
+    void printFrameTimes(QVector<double>& frameTimesMs)
+    {
+        const SampleStatistics statistics = SampleStatistics::FromSamples(frameTimesMs);
+        std::printf("  frames: %lld, frame time mean %.2f ms, p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, max %.2f ms\n",
+                    static_cast<long long>(statistics.count), statistics.mean,
+                    statistics.p50, statistics.p90, statistics.p99, statistics.max);
+    }
+}
+
+/**
+ * @brief Constructor
+ * @param options Settings of the run
+ * @param parent Parent QObject
+ */
+SoakDriver::SoakDriver(const Options& options, QObject* parent)
+    : QObject(parent)
+    , options_(options)
+    , beds_(std::make_unique<BedManager>())
+    , scheduler_(std::make_unique<FrameScheduler>())
+    , frame_timer_(this)
+{
+    frame_timer_.setTimerType(Qt::PreciseTimer);
+    frame_timer_.setInterval(qMax(1, qRound(1000.0 / options_.frameRate)));
+    connect(&frame_timer_, &QTimer::timeout, this, &SoakDriver::HandleFrame);
+}
+
+/**
+ * @brief Destructor
+ *
+ * Stops all beds.
+ */
+SoakDriver::~SoakDriver()
+{
+    frame_timer_.stop();
+    beds_->stopAll();
+
+    // The grid holds views of the beds' models, so it goes first
+    grid_.reset();
+}
+
+/**
+ * @brief Create and start the beds and start the frame clock
+ * @return True if all beds started
+ */
+bool SoakDriver::Start()
+{
+    FrameScheduler* scheduler = scheduler_.get();
+    grid_ = std::make_unique<BedGridView>(beds_.get(), scheduler, [scheduler]() {
+        auto view = std::make_shared<WaveformView>();
+        view->AttachToScheduler(scheduler);
+        return std::static_pointer_cast<IWaveformView>(view);
+    });
+
+    QVariantMap loadConfig;
+    if (options_.loadSampleRate > 0) {
+        loadConfig["loadMode"] = true;
+        loadConfig["loadSampleRate"] = options_.loadSampleRate;
+        loadConfig["loadChannels"] = options_.loadChannels;
+        loadConfig["loadBeds"] = options_.beds;
+        loadConfig["loadMaxRate"] = options_.maxRate;
+    }
+
+    QStringList bedIds;
+    for (int i = 0; i < options_.beds; ++i) {
+        bedIds.append(QString("Bed %1").arg(i + 1, 2, 10, QChar('0')));
+    }
+    const QVector<std::shared_ptr<IDataManager>> beds = beds_->AddBeds(bedIds);
+    if (beds.size() != options_.beds) {
+        return false;
+    }
+    for (int i = 0; i < beds.size(); ++i) {
+        if (!loadConfig.isEmpty() && !beds[i]->configureCurrentProvider(loadConfig)) {
+            qWarning() << "SoakDriver: Failed to configure the load generator of bed" << i + 1;
+            return false;
+        }
+    }
+
+    // The views skip ticks while they are not visible, so the grid is shown,
+    // but never put on screen
+    grid_->setAttribute(Qt::WA_DontShowOnScreen);
+    grid_->resize(options_.width, options_.height);
+    grid_->show();
+    frame_image_ = QImage(grid_->size(), QImage::Format_ARGB32_Premultiplied);
+
+    const int started = beds_->startAll();
+    if (started != options_.beds) {
+        qWarning() << "SoakDriver: Only" << started << "of" << options_.beds << "beds started";
+        return false;
+    }
+
+    std::printf("Soak: %d beds, %d s, %.0f frames/s at %dx%d\n",
+                options_.beds, options_.durationSeconds, options_.frameRate, options_.width, options_.height);
+    if (options_.loadSampleRate > 0) {
+        std::printf("  load generator: %d channels at %d Hz per bed%s\n",
+                    options_.loadChannels, options_.loadSampleRate, options_.maxRate ? ", maximum rate" : "");
+    }
+    std::fflush(stdout);
+
+    start_snapshot_ = Metrics::TakeSnapshot();
+    report_snapshot_ = start_snapshot_;
+    next_report_ms_ = options_.reportIntervalSeconds * 1000LL;
+    clock_.start();
+    frame_timer_.start();
+    return true;
+}
+
+/**
+ * @brief Handles one display frame
+ *
+ * Times the tick the views handle plus the render of the whole grid. A frame
+ * that takes longer than the frame interval counts as missed.
+ */
+void SoakDriver::HandleFrame()
+{
+    QElapsedTimer frameTimer;
+    frameTimer.start();
+
+    emit scheduler_->frameTick(clock_.elapsed());
+    grid_->render(&frame_image_);
+
+    const double frameMs = frameTimer.nsecsElapsed() / 1e6;
+    frame_times_ms_.append(frameMs);
+    interval_frame_times_ms_.append(frameMs);
+    if (frameMs > frame_timer_.interval()) {
+        ++missed_frames_;
+    }
+
+    const qint64 elapsedMs = clock_.elapsed();
+    if (options_.reportIntervalSeconds > 0 && elapsedMs >= next_report_ms_) {
+        printReport();
+        next_report_ms_ += options_.reportIntervalSeconds * 1000LL;
+    }
+
+    if (elapsedMs >= options_.durationSeconds * 1000LL) {
+        frame_timer_.stop();
+        beds_->stopAll();
+        printSummary();
+        emit finished();
+    }
+}
+
+/**
+ * @brief Print the progress line of the interval that just ended
+ */
+void SoakDriver::printReport()
+{
+    const Metrics::Snapshot now = Metrics::TakeSnapshot();
+    std::printf("[%6.1f s]\n", clock_.elapsed() / 1000.0);
+    printThroughput(now.Since(report_snapshot_));
+    printFrameTimes(interval_frame_times_ms_);
+    std::fflush(stdout);
+
+    report_snapshot_ = now;
+    interval_frame_times_ms_.clear();
+}
+
+/**
+ * @brief Print the results of the whole run
+ */
+void SoakDriver::printSummary()
+{
+    const Metrics::Snapshot run = Metrics::TakeSnapshot().Since(start_snapshot_);
+    std::printf("Summary over %.1f s\n", run.takenAt / 1e6);
+    printThroughput(run);
+    printFrameTimes(frame_times_ms_);
+    std::printf("  missed frames: %lld (over %d ms)\n",
+                static_cast<long long>(missed_frames_), frame_timer_.interval());
+    std::printf("%s\n", qPrintable(Metrics::Format(run)));
+    std::printf("%s\n", qPrintable(VitalSync::SampleBlockPool::GetInstance().FormatStatistics()));
+    std::fflush(stdout);
+}
@@ -0,0 +1,120 @@
+/**
+ * @file soak_driver.h
+ * @brief Definition of the SoakDriver class
+ *
+ * This file contains the definition of the SoakDriver class, which runs a
+ * headless central station with many demo beds and reports the sustained
+ * ingest throughput and the frame times of rendering all of them.
+ */
+#ifndef SOAK_DRIVER_H
+#define SOAK_DRIVER_H
+
+#include <QElapsedTimer>
+#include <QImage>
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+#include <memory>
+
+#include "../src/utils/metrics.h"
+
+class BedGridView;
+class BedManager;
+class FrameScheduler;
+
+/**
+ * @brief Headless multi-bed soak test
+ *
+ * Adds the requested number of beds to a BedManager, each acquiring from its
+ * own DemoDataProvider on its own acquisition thread, and shows them in a
+ * BedGridView that never appears on screen. The driver is the display clock:
+ * on every frame it emits the FrameScheduler tick the views are attached to
+ * and then renders the whole grid into an image, and records how long that
+ * took. The FrameScheduler itself is never started.
+ *
+ * With a load sample rate set, the beds' providers replay templates at that
+ * rate through the demo provider's load generator mode, optionally at maximum
+ * rate to find the ingest ceiling.
+ *
+ * Throughput and latencies come from Metrics snapshots. A line is printed per
+ * report interval and a summary at the end, after which finished() is emitted.
+ */
+class SoakDriver : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Settings of a soak run
+     */
+    struct Options {
+        int beds = 16;                  ///< Number of demo beds
+        int durationSeconds = 60;       ///< Length of the run
+        int reportIntervalSeconds = 10; ///< Interval between progress lines
+        double frameRate = 60.0;        ///< Display frames per second
+        int width = 1920;               ///< Width of the grid in pixels
+        int height = 1080;              ///< Height of the grid in pixels
+        int loadSampleRate = 0;         ///< Sample rate of the demo load generator, 0 for the regular demo waveforms
+        int loadChannels = 9;           ///< Channels per bed of the load generator
+        bool maxRate = false;           ///< Run the load generator as fast as possible instead of in real time
+    };
+
+    /**
+     * @brief Constructor
+     * @param options Settings of the run
+     * @param parent Parent QObject
+     */
+    explicit SoakDriver(const Options& options, QObject* parent = nullptr);
+
+    /**
+     * @brief Destructor
+     *
+     * Stops all beds.
+     */
+    ~SoakDriver() override;
+
+    /**
+     * @brief Create and start the beds and start the frame clock
+     * @return True if all beds started
+     */
+    bool Start();
+
+signals:
+    /**
+     * @brief Signal emitted when the run is over and the summary was printed
+     */
+    void finished();
+
+private slots:
+    /**
+     * @brief Handles one display frame
+     */
+    void HandleFrame();
+
+private:
+    /**
+     * @brief Print the progress line of the interval that just ended
+     */
+    void printReport();
+
+    /**
+     * @brief Print the results of the whole run
+     */
+    void printSummary();
+
+private:
+    Options options_;                               ///< Settings of the run
+    std::unique_ptr<BedManager> beds_;              ///< Beds of the run
+    std::unique_ptr<FrameScheduler> scheduler_;     ///< Clock the views are attached to, ticked by the driver
+    std::unique_ptr<BedGridView> grid_;             ///< Offscreen grid of all beds
+    QImage frame_image_;                            ///< Render target of the grid
+    QTimer frame_timer_;                            ///< Display frame timer
+    QElapsedTimer clock_;                           ///< Time since the start of the run
+    qint64 next_report_ms_ = 0;                     ///< Run time of the next progress line
+    QVector<double> frame_times_ms_;                ///< Frame times of the whole run
+    QVector<double> interval_frame_times_ms_;       ///< Frame times since the last progress line
+    qint64 missed_frames_ = 0;                      ///< Frames that took longer than the frame interval
+    Metrics::Snapshot start_snapshot_;              ///< Metrics at the start of the run
+    Metrics::Snapshot report_snapshot_;             ///< Metrics at the last progress line
+};
+
+#endif // SOAK_DRIVER_H
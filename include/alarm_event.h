@@ -0,0 +1,31 @@
+/**
+ * @file alarm_event.h
+ * @brief Alarm state changes published by data managers
+ *
+ * This file defines the AlarmEvent records a data manager publishes through
+ * IDataManager::alarmsChanged(). All alarm changes of one acquisition frame
+ * are delivered together, so a bed raises at most one notification per frame
+ * however many of its parameters change state.
+ */
+
+#ifndef ALARM_EVENT_H
+#define ALARM_EVENT_H
+
+#include "i_parameter_model.h"
+#include <QMetaType>
+#include <QVector>
+
+/**
+ * @brief Change of the alarm state of one parameter
+ */
+struct AlarmEvent {
+    int parameterId = 0;                                                        ///< VitalSync::ParameterType of the parameter
+    IParameterModel::AlarmState previousState = IParameterModel::AlarmState::Normal; ///< State before the change
+    IParameterModel::AlarmState state = IParameterModel::AlarmState::Normal;         ///< State after the change
+    float value = 0.0f;                                                         ///< Value that caused the change
+    qint64 timestamp = 0;                                                       ///< Time of the change in milliseconds since epoch
+};
+
+Q_DECLARE_METATYPE(AlarmEvent)
+
+#endif // ALARM_EVENT_H
@@ -16,8 +16,13 @@
 #include <QSettings>
 #include <QVariant>
 #include <QColor>
+#include <QHash>
 #include <QMap>
+#include <QMutex>
+#include <QSet>
 #include <QString>
+#include <QTimer>
+#include <atomic>
 #include <memory>
 
 #include "vital_sync_types.h"
@@ -39,11 +44,33 @@
  * The class follows the Singleton pattern to ensure a single point of access
  * to configuration throughout the application, and emits signals when settings
  * are changed to allow components to react to configuration updates.
+ *
+ * All settings are held in memory in an immutable Snapshot that Initialize()
+ * fills from the settings store in one pass. Getters read the current
+ * snapshot without taking a lock; setters copy it, change the copy and
+ * publish it, so a reader keeps a consistent view for as long as it holds
+ * it. Setters only touch memory: changed keys and configuration sections are
+ * marked dirty and written by a flush on a pool thread FLUSH_DELAY_MS after
+ * the first change, so bursts of changes (a provider switch tearing down its
+ * models, a reset to defaults) cost one write. save() flushes right away and
+ * the application's shutdown flushes whatever is still pending.
  */
 class ConfigManager : public QObject {
     Q_OBJECT
 
 public:
+    static constexpr int FLUSH_DELAY_MS = 2000;     ///< Delay from the first unsaved change to the background flush
+
+    /**
+     * @brief Immutable view of all settings
+     */
+    struct Snapshot {
+        QHash<QString, QVariant> values;                ///< Basic settings by key
+        QMap<QString, QVariantMap> providerConfigs;     ///< Provider configurations by provider name
+        QMap<int, QVariantMap> waveformConfigs;         ///< Waveform configurations by waveform type
+        QMap<int, QVariantMap> parameterConfigs;        ///< Parameter configurations by parameter type
+    };
+
     /**
      * @brief Get the singleton instance of the configuration manager
      * @return Reference to the singleton instance
@@ -60,7 +87,8 @@ public:
      * @return True if initialization was successful
      * 
      * Creates the QSettings object with the provided organization and application names.
-     * Loads previously saved settings from persistent storage.
+     * Loads previously saved settings from persistent storage into the snapshot
+     * in a single pass.
      */
     bool Initialize(const QString& organization, const QString& application);
 
@@ -68,14 +96,26 @@ public:
      * @brief Save the current configuration
      * @return True if save was successful
      * 
-     * Writes all settings to persistent storage and clears the dirty flag.
+     * Writes the changed settings to persistent storage right away instead of
+     * waiting for the background flush, and clears the dirty state.
      */
     bool save();
 
+    /**
+     * @brief Get the current settings
+     * @return Snapshot of all settings, never null
+     *
+     * The snapshot does not change while it is held; later changes publish a
+     * new one. Reading it takes no lock, so it suits code that looks up
+     * several settings at once or runs off the GUI thread.
+     */
+    std::shared_ptr<const Snapshot> GetSnapshot() const;
+
     /**
      * @brief Reset all settings to default values
      * 
      * Clears all settings and restores default values for all configuration options.
+     * The store is cleared and rewritten by the next flush.
      * Emits the settingsChanged signal to notify listeners of the changes.
      */
     void resetToDefaults();
@@ -202,7 +242,7 @@ public:
      * 
      * Stores the configuration map for the specified provider.
      * Sets the dirty flag and emits the providerConfigChanged and
-     * settingsChanged signals.
+     * settingsChanged signals if the configuration changes.
      */
     void SetProviderConfig(const QString& providerName, const QVariantMap& config);
 
@@ -223,7 +263,7 @@ public:
      * 
      * Stores the configuration map for the specified waveform type.
      * Sets the dirty flag and emits the waveformConfigChanged and
-     * settingsChanged signals.
+     * settingsChanged signals if the configuration changes.
      */
     void SetWaveformConfig(VitalSync::WaveformType waveformType, const QVariantMap& config);
 
@@ -244,7 +284,7 @@ public:
      * 
      * Stores the configuration map for the specified parameter type.
      * Sets the dirty flag and emits the parameterConfigChanged and
-     * settingsChanged signals.
+     * settingsChanged signals if the configuration changes.
      */
     void SetParameterConfig(VitalSync::ParameterType parameterType, const QVariantMap& config);
 
@@ -365,16 +405,14 @@ private:
     /**
      * @brief Private constructor for singleton pattern
      * 
-     * Initializes the configuration manager with empty maps for provider,
-     * waveform, and parameter configurations. Sets the dirty flag to false
-     * to indicate no unsaved changes initially.
+     * Starts with an empty snapshot and no unsaved changes.
      */
     ConfigManager();
 
     /**
      * @brief Private destructor for singleton pattern
      * 
-     * Saves any unsaved configuration changes to persistent storage
+     * Writes any unsaved configuration changes to persistent storage
      * before destroying the configuration manager instance.
      */
     ~ConfigManager();
@@ -395,20 +433,57 @@ private:
      */
     ConfigManager& operator=(const ConfigManager&) = delete;
 
-    // Settings object for storing configuration
+    /**
+     * @brief Publish a snapshot with one basic setting changed
+     * @param key Setting key
+     * @param value New value
+     *
+     * Marks the key dirty and schedules a flush.
+     */
+    void storeValue(const QString& key, const QVariant& value);
+
+    /**
+     * @brief Make sure a flush runs FLUSH_DELAY_MS from now
+     *
+     * Does nothing while a flush is already scheduled. May be called from any
+     * thread.
+     */
+    void scheduleFlush();
+
+    /**
+     * @brief Write the dirty settings to persistent storage
+     * @return True if the store was written without error
+     */
+    bool flush();
+
+    // Settings object for storing configuration, guarded by settings_mutex_
     std::unique_ptr<QSettings> settings_;
 
-    // Cache of provider configurations
-    QMap<QString, QVariantMap> provider_configs_;
+    // Serializes the flushes
+    QMutex settings_mutex_;
+
+    // Current settings, replaced as a whole by the setters
+    std::atomic<std::shared_ptr<const Snapshot>> snapshot_;
+
+    // Guards the publishing of snapshots and the dirty state
+    QMutex mutex_;
+
+    // Basic setting keys changed since the last flush
+    QSet<QString> dirty_keys_;
+
+    // Configuration sections changed since the last flush
+    bool providers_dirty_;
+    bool waveforms_dirty_;
+    bool parameters_dirty_;
 
-    // Cache of waveform configurations
-    QMap<int, QVariantMap> waveform_configs_;
+    // Whether the store is to be cleared before the next write
+    bool clear_pending_;
 
-    // Cache of parameter configurations
-    QMap<int, QVariantMap> parameter_configs_;
+    // Whether a flush is scheduled
+    std::atomic<bool> flush_scheduled_;
 
-    // Flag indicating if configuration has been modified
-    bool dirty_;
+    // Fires the debounced background flush
+    QTimer flush_timer_;
 };
 
 #endif // CONFIG_MANAGER_H 
\ No newline at end of file
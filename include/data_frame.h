@@ -0,0 +1,132 @@
+/**
+ * @file data_frame.h
+ * @brief Batched multi-channel data frame exchanged between providers and the data manager
+ *
+ * This file defines the DataFrame type, which carries one acquisition tick worth
+ * of data from a provider: the samples of every waveform channel packed into a
+ * single planar block, plus the parameter values measured at the same time. A
+ * frame is delivered with one signal emission and dispatched to all models in a
+ * single pass, instead of one signal, slot and model lookup per channel.
+ */
+
+#ifndef DATA_FRAME_H
+#define DATA_FRAME_H
+
+#include <QMetaType>
+#include <QVector>
+#include <QtGlobal>
+#include <algorithm>
+#include "sample_block_pool.h"
+
+namespace VitalSync {
+
+/**
+ * @brief Location of one waveform channel inside a DataFrame sample block
+ */
+struct FrameChannel {
+    int waveformId = 0;     ///< VitalSync::WaveformType of the channel
+    int offset = 0;         ///< Index of the channel's first sample in DataFrame::samples
+    int count = 0;          ///< Number of samples of this channel in the frame
+    float sampleRate = 0.0f; ///< Nominal sample rate in samples per second, 0 if the source does not know it
+};
+
+/**
+ * @brief One parameter measurement inside a DataFrame
+ */
+struct FrameParameter {
+    int parameterId = 0;    ///< VitalSync::ParameterType of the value
+    float value = 0.0f;     ///< Measured value
+};
+
+/**
+ * @brief Batched multi-channel acquisition frame
+ *
+ * All channels share one timestamp and one contiguous, planar sample block:
+ * channel i occupies samples[channels[i].offset, channels[i].offset + channels[i].count).
+ * Channels may carry different numbers of samples, so waveforms acquired at
+ * different rates can travel in the same frame. The sample block comes from the
+ * SampleBlockPool and, like the QVectors, is shared between copies, which
+ * keeps passing frames through queued signal connections copy-free. A frame
+ * that is cleared and refilled for every emission allocates nothing once its
+ * vectors and block are large enough.
+ */
+struct DataFrame {
+    qint64 timestamp = 0;                   ///< Timestamp in milliseconds of the first sample of every channel
+    QVector<FrameChannel> channels;         ///< Channel directory
+    SampleBlock samples;                    ///< Planar sample block for all channels, from the SampleBlockPool
+    QVector<FrameParameter> parameters;     ///< Parameter values measured with this frame
+
+    /**
+     * @brief Remove all channels and parameters, keeping allocated capacity
+     */
+    void clear()
+    {
+        channels.clear();
+        samples.clear();
+        parameters.clear();
+    }
+
+    /**
+     * @brief Check if the frame carries neither samples nor parameters
+     * @return True if the frame is empty
+     */
+    bool isEmpty() const { return channels.isEmpty() && parameters.isEmpty(); }
+
+    /**
+     * @brief Reserve space in the sample block for a new channel
+     * @param waveformId VitalSync::WaveformType of the channel
+     * @param count Number of samples to reserve
+     * @param sampleRate Nominal sample rate of the channel, 0 if unknown
+     * @return Pointer to the reserved samples, to be filled in place
+     *
+     * The returned pointer is only valid until the next call that grows the frame.
+     */
+    float* AppendChannel(int waveformId, int count, float sampleRate = 0.0f)
+    {
+        FrameChannel channel;
+        channel.waveformId = waveformId;
+        channel.offset = static_cast<int>(samples.size());
+        channel.count = count;
+        channel.sampleRate = sampleRate;
+        channels.append(channel);
+        samples.resize(channel.offset + count);
+        return samples.data() + channel.offset;
+    }
+
+    /**
+     * @brief Append a channel by copying its samples
+     * @param waveformId VitalSync::WaveformType of the channel
+     * @param data Samples to copy
+     */
+    void AppendChannel(int waveformId, const QVector<float>& data)
+    {
+        float* target = AppendChannel(waveformId, static_cast<int>(data.size()));
+        std::copy(data.constBegin(), data.constEnd(), target);
+    }
+
+    /**
+     * @brief Append a parameter value
+     * @param parameterId VitalSync::ParameterType of the value
+     * @param value Measured value
+     */
+    void AppendParameter(int parameterId, float value)
+    {
+        parameters.append(FrameParameter{parameterId, value});
+    }
+
+    /**
+     * @brief Get the samples of a channel
+     * @param index Index into channels
+     * @return Pointer to the channel's first sample
+     */
+    const float* ChannelData(int index) const
+    {
+        return samples.constData() + channels[index].offset;
+    }
+};
+
+} // namespace VitalSync
+
+Q_DECLARE_METATYPE(VitalSync::DataFrame)
+
+#endif // DATA_FRAME_H
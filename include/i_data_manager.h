@@ -18,6 +18,7 @@
 #include <vector>
 #include <string>
 
+#include "alarm_event.h"
 #include "i_data_provider.h"
 #include "i_waveform_model.h"
 #include "i_parameter_model.h"
@@ -35,6 +36,8 @@ using namespace VitalSync;
  * - Routing data from providers to appropriate waveform and parameter models
  * - Providing access to all waveform and parameter models for the UI layer
  * - Handling provider switching and configuration
+ * - Recording ingested data for later replay
+ * - Streaming ingested data to remote viewers
  * - Emitting signals for connection status changes and error handling
  * 
  * Implementations of this interface serve as the bridge between data sources
@@ -133,6 +136,51 @@ public:
      */
     virtual bool configureCurrentProvider(const QVariantMap& params) = 0;
 
+    /**
+     * @brief Start recording all ingested data to a file
+     * @param filePath Path of the recording to create
+     * @return True if the recording was created
+     * 
+     * Every waveform block and parameter value that reaches the models is
+     * also appended to a full-disclosure recording, which the file provider
+     * can replay later. A recording already in progress is closed first.
+     */
+    virtual bool StartRecording(const QString& filePath) = 0;
+
+    /**
+     * @brief Stop recording and close the recording file
+     */
+    virtual void StopRecording() = 0;
+
+    /**
+     * @brief Check if ingested data is being recorded
+     * @return True if a recording is in progress
+     */
+    virtual bool IsRecording() const = 0;
+
+    /**
+     * @brief Start serving ingested data to remote viewers
+     * @param port TCP port to listen on, 0 for any free port
+     * @return True if the server is listening
+     * 
+     * Every frame that reaches the models is encoded once in the network
+     * frame format and sent to all connected viewers, which can receive it
+     * with the network provider. A stream already being served is stopped
+     * first.
+     */
+    virtual bool StartStreaming(quint16 port) = 0;
+
+    /**
+     * @brief Stop serving and disconnect all viewers
+     */
+    virtual void StopStreaming() = 0;
+
+    /**
+     * @brief Check if ingested data is being served
+     * @return True if the stream server is listening
+     */
+    virtual bool IsStreaming() const = 0;
+
     /**
      * @brief Get a waveform model by ID
      * @param waveformId ID of the waveform model to retrieve
@@ -140,6 +188,7 @@ public:
      * 
      * Retrieves a specific waveform model (ECG, respiration, etc.) by its
      * numeric identifier, which corresponds to a VitalSync::WaveformType value.
+     * Implementations may build the model on the first request.
      * Returns nullptr if the specified waveform ID is not found.
      */
     virtual std::shared_ptr<IWaveformModel> GetWaveformModel(int waveformId) const = 0;
@@ -148,8 +197,8 @@ public:
      * @brief Get all available waveform models
      * @return Vector of waveform model pointers
      * 
-     * Returns a collection of all waveform models managed by the
-     * data manager, regardless of their current state. This can be
+     * Returns a collection of all waveform models the data manager has
+     * built so far, regardless of their current state. This can be
      * used to iterate through all available waveforms for display
      * or configuration purposes.
      */
@@ -177,6 +226,21 @@ public:
      */
     virtual std::vector<std::shared_ptr<IParameterModel>> GetAllParameterModels() const = 0;
 
+    /**
+     * @brief Set the alarm limits of a parameter
+     * @param parameterId ID of the parameter
+     * @param lowCritical Low critical limit
+     * @param lowWarning Low warning limit
+     * @param highWarning High warning limit
+     * @param highCritical High critical limit
+     * @return True if the parameter exists
+     * 
+     * Updates both the limits stored by the parameter model and the limits
+     * the alarm evaluation of this manager applies from the next value on.
+     */
+    virtual bool SetAlarmLimits(int parameterId, float lowCritical, float lowWarning,
+                                float highWarning, float highCritical) = 0;
+
 signals:
     /**
      * @brief Signal emitted when the active provider changes
@@ -209,6 +273,17 @@ signals:
      * display error messages to the user or take corrective action.
      */
     void errorOccurred(int errorCode, const QString& errorMessage);
+
+    /**
+     * @brief Signal emitted when parameters enter, change or leave an alarm state
+     * @param events The alarm state changes of one frame
+     * 
+     * Alarms are evaluated for all parameters of an acquisition frame at once,
+     * and all resulting changes are delivered in a single emission, so a bed
+     * raises at most one notification per frame. The signal is emitted on the
+     * acquisition thread; receivers in the GUI thread get it queued.
+     */
+    void alarmsChanged(const QVector<AlarmEvent>& events);
 };
 
 #endif // I_DATA_MANAGER_H 
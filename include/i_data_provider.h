@@ -21,6 +21,7 @@
 #include <QVariantMap>
 #include <QObject>
 #include "vital_sync_types.h"
+#include "data_frame.h"
 
 /**
  * @brief Interface for physiological data providers
@@ -127,6 +128,17 @@ public:
      */
     virtual bool configure(const QVariantMap& params) = 0;
 
+    /**
+     * @brief Check if the provider only simulates a patient
+     * @return True if the views may draw their own demo trace
+     * 
+     * A demo provider's samples carry no timing of their own, so the views
+     * show the synthesized demo trace instead of rendering them. Providers
+     * that deliver a sampled stream, including recordings and generated load,
+     * return false, which is the default.
+     */
+    virtual bool IsDemo() const { return false; }
+
 signals:
     /**
      * @brief Signal emitted when connection status changes
@@ -163,6 +175,19 @@ signals:
      */
     void parameterDataReceived(int parameterType, qint64 timestamp, float value);
 
+    /**
+     * @brief Signal emitted when a batched multi-channel frame is available
+     * @param frame Samples of all waveform channels and the parameter values of one tick
+     * 
+     * This is the preferred data path for providers that acquire several channels
+     * at once. A single emission carries every channel in one planar sample block
+     * together with the parameter values, and the data manager dispatches the whole
+     * frame to the models in one pass. The per-channel waveformDataReceived and
+     * parameterDataReceived signals remain available for simple providers; a
+     * provider should not report the same samples through both paths.
+     */
+    void dataFrameReceived(const VitalSync::DataFrame& frame);
+
     /**
      * @brief Signal emitted when provider encounters an error
      * @param errorCode Numeric identifier for the error type
@@ -12,6 +12,7 @@
  * - Alarm limits and current alarm state
  * - Visual properties like display color
  * - Active/inactive state management
+ * - Trend history at several resolutions
  */
 
 #ifndef I_PARAMETER_MODEL_H
@@ -20,7 +21,10 @@
 #include <QObject>
 #include <QColor>
 #include <QDateTime>
+#include <QVector>
+#include <tuple>
 #include "vital_sync_types.h"
+#include "parameter_trend.h"
 
 /**
  * @brief Interface for parameter models
@@ -168,6 +172,17 @@ public:
      */
     virtual AlarmState GetAlarmState() const = 0;
 
+    /**
+     * @brief Set the alarm state decided by the alarm evaluation
+     * @param state New alarm state
+     * 
+     * Alarm states are decided centrally by the data manager, which applies
+     * alarm delays and hysteresis across all parameters of a frame. The model
+     * stores the result for its views, which pick it up when they poll; the
+     * change itself is announced by IDataManager::alarmsChanged().
+     */
+    virtual void SetAlarmState(AlarmState state) = 0;
+
     /**
      * @brief Set a new parameter value
      * @param timestamp Timestamp of the new value
@@ -187,12 +202,35 @@ public:
      * @param highWarning High warning limit
      * @param highCritical High critical limit
      * 
-     * Sets the four alarm thresholds for this parameter. When the parameter
-     * value crosses these thresholds, the alarm state changes accordingly,
-     * and the alarmStateChanged signal is emitted.
+     * Stores the four alarm thresholds for this parameter and persists them
+     * with its configuration. The thresholds are evaluated by the data
+     * manager, which reads them when it creates the model; change them at
+     * runtime through IDataManager::SetAlarmLimits().
      */
     virtual void SetAlarmLimits(float lowCritical, float lowWarning, float highWarning, float highCritical) = 0;
 
+    /**
+     * @brief Get the alarm limits of this parameter
+     * @return Low critical, low warning, high warning and high critical limit
+     */
+    virtual std::tuple<float, float, float, float> GetAlarmLimits() const = 0;
+
+    /**
+     * @brief Get the trend of this parameter over a time window
+     * @param resolution Resolution of the trend
+     * @param fromTimestamp Start of the window in milliseconds since epoch, inclusive
+     * @param toTimestamp End of the window in milliseconds since epoch, exclusive
+     * @return Trend points in time order
+     * 
+     * Returns the parameter's history for tabular and graphic trends. Raw
+     * resolution covers only recent measurements; the minute, quarter-hour
+     * and hour resolutions are rollups with the minimum, maximum and mean of
+     * each bucket that reach back further. Windows reaching beyond the
+     * retained history return the part that is retained, and buckets without
+     * measurements are left out.
+     */
+    virtual QVector<TrendPoint> GetTrend(TrendResolution resolution, qint64 fromTimestamp, qint64 toTimestamp) const = 0;
+
     /**
      * @brief Check if this parameter is currently active/enabled
      * @return True if this parameter is active
@@ -229,9 +267,9 @@ signals:
      * @brief Signal emitted when alarm state changes
      * @param state New alarm state
      * 
-     * This signal is emitted when the parameter's alarm state changes,
-     * such as when a value crosses an alarm threshold. Views can connect
-     * to this signal to update their appearance based on alarm state.
+     * Reserved for models that decide their alarm state themselves. States
+     * decided by the data manager are announced once per frame and bed through
+     * IDataManager::alarmsChanged() instead of per parameter.
      */
     void alarmStateChanged(AlarmState state);
 
@@ -21,6 +21,8 @@
 #include <QVector>
 #include <QColor>
 #include <QDateTime>
+#include "waveform_envelope.h"
+#include "waveform_snapshot.h"
 
 /**
  * @brief Interface for waveform data models
@@ -129,14 +131,18 @@ public:
     virtual void SetScalingRange(float min, float max) = 0;
     
     /**
-     * @brief Get the stored waveform data
-     * @return Vector of waveform data points
+     * @brief Take a snapshot of the stored waveform data
+     * @param fromSequence First sample sequence number of interest
+     * @return Read view over the retained samples, oldest first
      * 
-     * Returns the current buffer of waveform data points. This is typically
-     * called by views when rendering the waveform. The size of this buffer
-     * is limited by the maximum buffer size.
+     * Returns a consistent window of samples from fromSequence (or the oldest
+     * retained sample, whichever is newer) up to the newest sample. The snapshot
+     * references the model's storage instead of copying it and keeps that storage
+     * alive for as long as it exists. Any number of views may hold snapshots at
+     * the same time, and taking or reading one never blocks addWaveformData().
+     * The size of the window is limited by the maximum buffer size.
      */
-    virtual const QVector<float>& GetData() const = 0;
+    virtual WaveformSnapshot GetSnapshot(quint64 fromSequence = 0) const = 0;
     
     /**
      * @brief Get the maximum buffer size
@@ -170,7 +176,73 @@ public:
      * The model will emit the dataUpdated signal after processing the new data.
      */
     virtual void addWaveformData(qint64 timestamp, const QVector<float>& data) = 0;
-    
+
+    /**
+     * @brief Add new waveform data to the buffer from raw memory
+     * @param timestamp Timestamp in milliseconds when the data was captured
+     * @param data Pointer to the new data points
+     * @param count Number of data points
+     * 
+     * Same as the QVector overload, but lets callers hand over samples that live
+     * inside a larger block, such as one channel of a batched DataFrame, without
+     * first copying them into a vector of their own.
+     */
+    virtual void addWaveformData(qint64 timestamp, const float* data, int count) = 0;
+
+    /**
+     * @brief Get the current write sequence number
+     * @return Sequence number one past the newest sample
+     *
+     * Every sample added to the model is assigned a monotonically increasing
+     * sequence number. Views remember the last sequence they consumed and
+     * compare it with this value to find out whether new samples arrived.
+     */
+    virtual quint64 GetWriteSequence() const = 0;
+
+    /**
+     * @brief Read the samples added after a given sequence number
+     * @param sequence First sequence number of interest
+     * @param out Receives the samples, oldest first
+     * @return Sequence number of the first sample in out
+     *
+     * Returns every sample still retained from sequence onwards. If part of that
+     * range has already been overwritten, reading resumes at the oldest retained
+     * sample and the returned sequence number reflects the gap. This call does not
+     * take the model lock and never blocks the ingest path, so views may call it
+     * from the GUI thread while data is being added.
+     */
+    virtual quint64 ReadSamplesSince(quint64 sequence, QVector<float>& out) const = 0;
+
+    /**
+     * @brief Get the min/max envelope of a time range
+     * @param fromTimestamp Start of the range in milliseconds since epoch
+     * @param toTimestamp End of the range in milliseconds since epoch
+     * @param columns Number of columns to divide the range into, usually its width in pixels
+     * @param out Receives one envelope column per column
+     * @return Number of columns that hold data
+     *
+     * Divides the range into equal columns and reports the lowest and highest
+     * sample in each. The envelope is served from summaries maintained as data
+     * is added, so the cost depends on the number of columns only, and the
+     * range may reach far beyond the maximum buffer size. Columns without
+     * retained data are marked invalid.
+     */
+    virtual int GetEnvelope(qint64 fromTimestamp, qint64 toTimestamp, int columns,
+                            QVector<EnvelopeColumn>& out) const = 0;
+
+    /**
+     * @brief Get the sample rate of the incoming data
+     * @return Samples per second
+     *
+     * A provider that knows its rate reports it with the frame channels. Otherwise
+     * the rate is derived from the timestamps passed to addWaveformData() and the
+     * number of samples between them, so it follows whatever rate the provider
+     * actually delivers. Until enough data has arrived to measure it,
+     * VitalSync::DEFAULT_SAMPLE_RATE is returned. Views use it to place every
+     * sample at its point in time on a sweep of a given speed.
+     */
+    virtual double GetSampleRate() const = 0;
+
     /**
      * @brief Get the timestamp of the last update
      * @return Timestamp as QDateTime
@@ -179,6 +251,15 @@ public:
      * This can be used to determine the age of the data and handle stale waveforms.
      */
     virtual QDateTime GetLastUpdateTime() const = 0;
+
+    /**
+     * @brief Get when samples were last written, on the monotonic metrics clock
+     * @return Metrics::Now() at the end of the last write, 0 before the first
+     * 
+     * Views compare it with the time they paint the new samples to measure
+     * the display latency.
+     */
+    virtual qint64 GetLastWriteTime() const = 0;
     
     /**
      * @brief Check if this waveform is active
@@ -215,9 +296,10 @@ signals:
     /**
      * @brief Signal emitted when new data is available
      * 
-     * This signal is emitted whenever new waveform data is added to the model.
-     * Views can connect to this signal to update their display when new
-     * waveform samples are available.
+     * This signal is emitted whenever new waveform data is added to the model,
+     * on the thread that added the data (normally the acquisition thread).
+     * Consumers that run on the GUI thread should poll GetWriteSequence() at
+     * display rate instead of reacting to every emission.
      */
     void dataUpdated();
     
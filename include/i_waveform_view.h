@@ -39,6 +39,22 @@
  */
 class IWaveformView {
 public:
+    /**
+     * @brief Rendering effort a view may spend on its frames
+     *
+     * The defaults are full quality. Under load the quality governor hands
+     * out reduced settings; a view applies the fields its renderer has a use
+     * for and ignores the others.
+     */
+    struct RenderQuality {
+        bool antialiasing = true;       ///< Whether traces are drawn antialiased
+        int frameDivisor = 1;           ///< Only every n-th display tick is handled
+        bool simplifiedGrid = false;    ///< Whether only the major grid lines are drawn
+        int decimation = 1;             ///< Pixel columns merged into one trace line
+
+        bool operator==(const RenderQuality&) const = default;
+    };
+
     /**
      * @brief Virtual destructor
      * 
@@ -217,6 +233,23 @@ public:
      * This corresponds to the color set by SetBackgroundColor().
      */
     virtual QColor GetBackgroundColor() const = 0;
+
+    /**
+     * @brief Set the rendering effort of the view
+     * @param quality Rendering settings
+     * 
+     * Lets the view trade detail for time when the display cannot keep up.
+     * The trace stays correct at every setting: a lower frame rate updates it
+     * in larger steps, and decimation draws the min/max envelope of several
+     * columns as one wider line, so peaks are never lost.
+     */
+    virtual void SetRenderQuality(const RenderQuality& quality) = 0;
+
+    /**
+     * @brief Get the rendering effort of the view
+     * @return Rendering settings in use
+     */
+    virtual RenderQuality GetRenderQuality() const = 0;
 };
 
 #endif // I_WAVEFORM_VIEW_H 
\ No newline at end of file
@@ -0,0 +1,40 @@
+/**
+ * @file parameter_trend.h
+ * @brief Trend data returned by parameter models
+ *
+ * This file defines the resolutions at which a parameter's history can be
+ * queried through IParameterModel::GetTrend() and the TrendPoint records a
+ * query returns. Every resolution coarser than Raw is a rollup maintained as
+ * values arrive, so a query never revisits the individual measurements.
+ */
+
+#ifndef PARAMETER_TREND_H
+#define PARAMETER_TREND_H
+
+#include <QtGlobal>
+
+/**
+ * @brief Time resolution of a trend query
+ */
+enum class TrendResolution {
+    Raw,            ///< Individual measurements, recent history only
+    OneMinute,      ///< One point per minute
+    FifteenMinutes, ///< One point per 15 minutes
+    OneHour         ///< One point per hour
+};
+
+/**
+ * @brief One point of a parameter trend
+ *
+ * For rollups the point summarizes all values measured in its bucket; for
+ * raw trends min, max and mean are the measured value and count is 1.
+ */
+struct TrendPoint {
+    qint64 timestamp = 0;   ///< Bucket start, or measurement time for raw points, in milliseconds since epoch
+    float min = 0.0f;       ///< Lowest value in the bucket
+    float max = 0.0f;       ///< Highest value in the bucket
+    float mean = 0.0f;      ///< Average value in the bucket
+    int count = 0;          ///< Number of values in the bucket
+};
+
+#endif // PARAMETER_TREND_H
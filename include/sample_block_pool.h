@@ -0,0 +1,293 @@
+/**
+ * @file sample_block_pool.h
+ * @brief Pool of reusable sample blocks and the SampleBlock handle
+ *
+ * This file defines the SampleBlockPool, which hands out preallocated blocks
+ * of waveform samples and takes them back once their last user is done, and
+ * the SampleBlock handle that DataFrame carries its samples in. Providers fill
+ * a block in place and the block travels with the frame to the models, so a
+ * steady stream of frames allocates no sample memory at all.
+ */
+
+#ifndef SAMPLE_BLOCK_POOL_H
+#define SAMPLE_BLOCK_POOL_H
+
+#include <QMutex>
+#include <QString>
+#include <QtGlobal>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace VitalSync {
+
+/**
+ * @brief Process-wide pool of fixed-size sample blocks
+ *
+ * Every pooled block holds BLOCK_CAPACITY samples. The pool starts with
+ * INITIAL_BLOCKS of them and grows when all are in use, but never shrinks, so
+ * after warm-up acquiring and releasing a block is a pop and a push on a free
+ * list. Requests larger than a pooled block get a block of their own that is
+ * freed on release; they are counted, since a steady stream of them means the
+ * block size is too small.
+ *
+ * Blocks are normally used through SampleBlock, which keeps their reference
+ * count. The pool may be used from any thread.
+ */
+class SampleBlockPool {
+public:
+    static constexpr int BLOCK_CAPACITY = 4096;     ///< Samples per pooled block, 16 KiB
+    static constexpr int INITIAL_BLOCKS = 32;       ///< Blocks allocated when the pool is created
+
+    /**
+     * @brief A block of samples and its reference count
+     */
+    struct Block {
+        std::atomic<int> references{0};         ///< Number of SampleBlock handles sharing the block
+        int capacity = 0;                       ///< Number of samples the block holds
+        bool pooled = false;                    ///< True if the block returns to the pool, false if it is freed
+        std::unique_ptr<float[]> samples;       ///< The samples
+    };
+
+    /**
+     * @brief Usage of the pool
+     */
+    struct Statistics {
+        int blocks = 0;                 ///< Pooled blocks allocated so far
+        int inUse = 0;                  ///< Blocks currently handed out, pooled or not
+        int highWaterMark = 0;          ///< Largest number of blocks in use at the same time
+        quint64 oversizeBlocks = 0;     ///< Blocks allocated for requests larger than BLOCK_CAPACITY
+    };
+
+    /**
+     * @brief Get the pool of the process
+     * @return The pool
+     */
+    static SampleBlockPool& GetInstance();
+
+    SampleBlockPool(const SampleBlockPool&) = delete;
+    SampleBlockPool& operator=(const SampleBlockPool&) = delete;
+
+    /**
+     * @brief Take a block with room for at least a number of samples
+     * @param capacity Number of samples needed
+     * @return A block with a reference count of 1
+     */
+    Block* Acquire(int capacity);
+
+    /**
+     * @brief Give a block back once its reference count dropped to 0
+     * @param block Block returned by Acquire()
+     */
+    void Release(Block* block);
+
+    /**
+     * @brief Make sure a number of pooled blocks exists
+     * @param blocks Number of blocks the pool should hold at least
+     *
+     * Lets a provider allocate the blocks it is going to need up front
+     * instead of on its first frames.
+     */
+    void Reserve(int blocks);
+
+    /**
+     * @brief Get the usage of the pool
+     * @return Current statistics
+     */
+    Statistics GetStatistics() const;
+
+    /**
+     * @brief Format the usage of the pool as one line of text
+     * @return Blocks in use, high-water mark and allocations
+     */
+    QString FormatStatistics() const;
+
+private:
+    /**
+     * @brief Constructor
+     *
+     * Allocates the initial blocks.
+     */
+    SampleBlockPool();
+
+    /**
+     * @brief Allocate a pooled block and put it on the free list
+     *
+     * The mutex must be held.
+     */
+    void growLocked();
+
+    mutable QMutex mutex_;                          ///< Protects all members
+    std::vector<std::unique_ptr<Block>> blocks_;    ///< All pooled blocks
+    std::vector<Block*> free_;                      ///< Pooled blocks not in use
+    int in_use_ = 0;                                ///< Blocks handed out
+    int high_water_mark_ = 0;                       ///< Largest value of in_use_
+    quint64 oversize_blocks_ = 0;                   ///< Blocks allocated beyond the block size
+};
+
+/**
+ * @brief Shared handle to a pooled block of samples
+ *
+ * Behaves like a QVector<float> reduced to what DataFrame needs: copies share
+ * the block and the first write to a shared block copies it into a block of
+ * its own, so frames can still be passed through queued connections. The
+ * block goes back to the pool when the last handle is destroyed or cleared.
+ * clear() keeps a block that is not shared, so a frame reused for every
+ * emission keeps its block for good.
+ */
+class SampleBlock {
+public:
+    SampleBlock() = default;
+
+    /**
+     * @brief Copy constructor, shares the block
+     * @param other Handle to share the block of
+     */
+    SampleBlock(const SampleBlock& other)
+        : block_(other.block_)
+        , size_(other.size_)
+    {
+        if (block_) {
+            block_->references.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Move constructor
+     * @param other Handle to take the block from
+     */
+    SampleBlock(SampleBlock&& other) noexcept
+        : block_(std::exchange(other.block_, nullptr))
+        , size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    /**
+     * @brief Destructor, releases the block
+     */
+    ~SampleBlock() { release(); }
+
+    /**
+     * @brief Assignment, shares or takes the other handle's block
+     * @param other Handle to assign
+     * @return This handle
+     */
+    SampleBlock& operator=(SampleBlock other) noexcept
+    {
+        std::swap(block_, other.block_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+
+    /**
+     * @brief Get the number of samples
+     * @return Number of samples
+     */
+    qsizetype size() const { return size_; }
+
+    /**
+     * @brief Check if there are no samples
+     * @return True if the size is 0
+     */
+    bool isEmpty() const { return size_ == 0; }
+
+    /**
+     * @brief Get the number of samples the block holds
+     * @return Capacity, 0 without a block
+     */
+    qsizetype capacity() const { return block_ ? block_->capacity : 0; }
+
+    /**
+     * @brief Get the samples for reading
+     * @return Pointer to the first sample, nullptr without a block
+     */
+    const float* constData() const { return block_ ? block_->samples.get() : nullptr; }
+
+    /**
+     * @brief Get the samples for writing, copying a shared block first
+     * @return Pointer to the first sample, nullptr without a block
+     */
+    float* data()
+    {
+        if (!block_) {
+            return nullptr;
+        }
+        detach(size_);
+        return block_->samples.get();
+    }
+
+    /**
+     * @brief Make room for a number of samples without changing the size
+     * @param capacity Number of samples
+     */
+    void reserve(qsizetype capacity) { detach(capacity); }
+
+    /**
+     * @brief Change the number of samples, keeping the existing ones
+     * @param size New number of samples; new samples are uninitialized
+     */
+    void resize(qsizetype size)
+    {
+        detach(size);
+        size_ = size;
+    }
+
+    /**
+     * @brief Remove all samples, keeping the block if it is not shared
+     */
+    void clear()
+    {
+        if (block_ && block_->references.load(std::memory_order_acquire) > 1) {
+            release();
+        }
+        size_ = 0;
+    }
+
+private:
+    /**
+     * @brief Make sure the block is not shared and holds a number of samples
+     * @param capacity Number of samples needed
+     */
+    void detach(qsizetype capacity)
+    {
+        const bool shared = block_ && block_->references.load(std::memory_order_acquire) > 1;
+        if (!shared && capacity <= this->capacity()) {
+            return;
+        }
+
+        // Blocks larger than the pooled size grow geometrically, like a vector
+        qsizetype needed = std::max(capacity, size_);
+        if (capacity > this->capacity()) {
+            needed = std::max(needed, 2 * this->capacity());
+        }
+        SampleBlockPool::Block* block = SampleBlockPool::GetInstance().Acquire(static_cast<int>(needed));
+        if (block_ && size_ > 0) {
+            std::copy(block_->samples.get(), block_->samples.get() + size_, block->samples.get());
+        }
+        const qsizetype size = size_;
+        release();
+        block_ = block;
+        size_ = size;
+    }
+
+    /**
+     * @brief Drop the reference to the block
+     */
+    void release()
+    {
+        if (block_ && block_->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            SampleBlockPool::GetInstance().Release(block_);
+        }
+        block_ = nullptr;
+        size_ = 0;
+    }
+
+    SampleBlockPool::Block* block_ = nullptr;   ///< Shared block, nullptr until samples are added
+    qsizetype size_ = 0;                        ///< Number of samples in use
+};
+
+} // namespace VitalSync
+
+#endif // SAMPLE_BLOCK_POOL_H
@@ -8,9 +8,10 @@
  * The VitalSync namespace contains:
  * - Enumerations for waveform types and parameter types
  * - Connection status and error code definitions
- * - Utility functions for getting display names and units
- * - Functions that define default ranges, alarm limits, and other constants
- *   for different physiological signals
+ * - Constexpr trait tables with the display name, unit, default range, alarm
+ *   limits, color and display format of every waveform and parameter type
+ * - Utility functions for getting display names, units, default ranges and
+ *   alarm limits, which look the traits up
  */
 
 #ifndef VITAL_SYNC_TYPES_H
@@ -18,6 +19,7 @@
 
 #include <QString>
 #include <QColor>
+#include <array>
 #include <tuple>
 
 namespace VitalSync {
@@ -69,6 +71,80 @@ enum class ParameterType {
     IBP2_MAP = 14 // Invasive Blood Pressure 2 (Mean)
 };
 
+/**
+ * @brief Number of waveform types
+ * 
+ * Waveform types are numbered densely from 0, so the count is also the size
+ * of arrays indexed by waveform type. It follows the last enumerator and has
+ * to be kept in step with it.
+ */
+constexpr int WAVEFORM_TYPE_COUNT = static_cast<int>(WaveformType::EEG) + 1;
+
+/**
+ * @brief Number of parameter types
+ * 
+ * Parameter types are numbered densely from 0, so the count is also the size
+ * of arrays indexed by parameter type. It follows the last enumerator and has
+ * to be kept in step with it.
+ */
+constexpr int PARAMETER_TYPE_COUNT = static_cast<int>(ParameterType::IBP2_MAP) + 1;
+
+/**
+ * @brief All waveform types in index order
+ */
+constexpr std::array<WaveformType, WAVEFORM_TYPE_COUNT> WAVEFORM_TYPES = {
+    WaveformType::ECG_I, WaveformType::ECG_II, WaveformType::ECG_III,
+    WaveformType::RESP, WaveformType::PLETH, WaveformType::ABP,
+    WaveformType::CVP, WaveformType::CAPNO, WaveformType::EEG
+};
+
+/**
+ * @brief All parameter types in index order
+ */
+constexpr std::array<ParameterType, PARAMETER_TYPE_COUNT> PARAMETER_TYPES = {
+    ParameterType::HR, ParameterType::RR, ParameterType::SPO2,
+    ParameterType::NIBP_SYS, ParameterType::NIBP_DIA, ParameterType::NIBP_MAP,
+    ParameterType::TEMP1, ParameterType::TEMP2, ParameterType::ETCO2,
+    ParameterType::IBP1_SYS, ParameterType::IBP1_DIA, ParameterType::IBP1_MAP,
+    ParameterType::IBP2_SYS, ParameterType::IBP2_DIA, ParameterType::IBP2_MAP
+};
+
+/**
+ * @brief Check that a type table lists every index once, in order
+ * @param types Type table
+ * @return True if entry i has the value i
+ */
+template <typename Type, size_t Count>
+constexpr bool IsDenseTypeTable(const std::array<Type, Count>& types) {
+    for (size_t i = 0; i < Count; ++i) {
+        if (static_cast<size_t>(types[i]) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(IsDenseTypeTable(WAVEFORM_TYPES), "WAVEFORM_TYPES must list the waveform types in index order");
+static_assert(IsDenseTypeTable(PARAMETER_TYPES), "PARAMETER_TYPES must list the parameter types in index order");
+
+/**
+ * @brief Check if an identifier is a waveform type
+ * @param waveformId Numeric waveform identifier
+ * @return True if the identifier maps to a WaveformType
+ */
+constexpr bool IsValidWaveformType(int waveformId) {
+    return waveformId >= 0 && waveformId < WAVEFORM_TYPE_COUNT;
+}
+
+/**
+ * @brief Check if an identifier is a parameter type
+ * @param parameterId Numeric parameter identifier
+ * @return True if the identifier maps to a ParameterType
+ */
+constexpr bool IsValidParameterType(int parameterId) {
+    return parameterId >= 0 && parameterId < PARAMETER_TYPE_COUNT;
+}
+
 /**
  * @brief Connection status for data providers
  * 
@@ -100,6 +176,215 @@ enum class ErrorCode {
     UnknownError = 999
 };
 
+/**
+ * @brief Default sample rate for waveforms in samples per second
+ * 
+ * Defines the standard sampling rate for waveform data in the system.
+ * This value is used for buffer sizing, time calculations, and when
+ * generating demo data. A rate of 250 samples per second is sufficient
+ * for most physiological waveforms while maintaining reasonable performance.
+ */
+const int DEFAULT_SAMPLE_RATE = 250;
+
+/**
+ * @brief Default buffer size in seconds
+ * 
+ * Defines the default amount of waveform history to maintain in memory.
+ * This determines how far back in time waveform displays can show data
+ * and affects memory usage. Combined with the sample rate, this determines
+ * the total number of samples stored for each waveform.
+ */
+const int DEFAULT_BUFFER_SECONDS = 10;
+
+/**
+ * @brief Default sweep speed in pixels per second
+ * 
+ * Defines the default horizontal scrolling speed for waveform displays.
+ * This value determines how many horizontal pixels represent one second
+ * of waveform data. Higher values show more detail but less history on
+ * the screen at once.
+ */
+const double DEFAULT_SWEEP_SPEED = 25.0;
+
+/**
+ * @brief How a parameter value is formatted for display
+ */
+enum class ValueFormat {
+    WholeNumber,    ///< No decimals, such as 98 for SpO2
+    OneDecimal,     ///< One decimal, such as 36.8 for temperatures
+    Adaptive        ///< One decimal below 100, none from 100 on
+};
+
+/**
+ * @brief Static properties of a waveform type
+ * 
+ * All strings are UTF-8 literals with static storage duration, so looking
+ * traits up never allocates.
+ */
+struct WaveformTraits {
+    WaveformType type;          ///< Waveform type, the index in WAVEFORM_TRAITS
+    const char* displayName;    ///< Name shown in labels and menus
+    float minValue;             ///< Default lower end of the amplitude range
+    float maxValue;             ///< Default upper end of the amplitude range
+    QRgb color;                 ///< Conventional monitor color of the trace
+    bool conventionalColor;     ///< True if views always draw the trace in color, false to use the model's color
+    float traceScale;           ///< Share of the view height the pixel-step trace spans
+    int sampleRate;             ///< Nominal sample rate, used until the rate is measured
+    int ecgLead;                ///< Index of the ECG lead, -1 for other waveforms
+};
+
+/**
+ * @brief Static properties of a parameter type
+ * 
+ * All strings are UTF-8 literals with static storage duration, so looking
+ * traits up never allocates.
+ */
+struct ParameterTraits {
+    ParameterType type;         ///< Parameter type, the index in PARAMETER_TRAITS
+    const char* displayName;    ///< Abbreviated name, as standard on medical displays
+    const char* unit;           ///< Unit of measurement
+    float minValue;             ///< Default lower end of the display range
+    float maxValue;             ///< Default upper end of the display range
+    float lowCritical;          ///< Default low critical alarm limit
+    float lowWarning;           ///< Default low warning alarm limit
+    float highWarning;          ///< Default high warning alarm limit
+    float highCritical;         ///< Default high critical alarm limit
+    ValueFormat format;         ///< Display format of the values
+
+    /**
+     * @brief Get the number of decimals a value is shown with
+     * @param value The value
+     * @return Number of decimals
+     */
+    constexpr int GetPrecision(float value) const {
+        switch (format) {
+            case ValueFormat::WholeNumber:
+                return 0;
+            case ValueFormat::OneDecimal:
+                return 1;
+            case ValueFormat::Adaptive:
+            default:
+                return value >= 100.0f ? 0 : 1;
+        }
+    }
+};
+
+/**
+ * @brief Properties of every waveform type, in index order
+ * 
+ * Ranges are in mV for ECG, normalized for respiration, pleth, pressures and
+ * capnography, and in μV for EEG. Adding a waveform type means adding its
+ * enumerator and its row here; nothing else switches on the type.
+ */
+constexpr std::array<WaveformTraits, WAVEFORM_TYPE_COUNT> WAVEFORM_TRAITS = {{
+    // type                 name       min      max     color                     conv.  scale  rate                 lead
+    { WaveformType::ECG_I,   "ECG I",   -1.5f,   1.5f,   qRgb(0, 255, 0),         true,  0.7f, DEFAULT_SAMPLE_RATE,  0 },
+    { WaveformType::ECG_II,  "ECG II",  -1.5f,   1.5f,   qRgb(0, 255, 0),         true,  0.7f, DEFAULT_SAMPLE_RATE,  1 },
+    { WaveformType::ECG_III, "ECG III", -1.5f,   1.5f,   qRgb(0, 255, 0),         true,  0.7f, DEFAULT_SAMPLE_RATE,  2 },
+    { WaveformType::RESP,    "Resp",    -1.0f,   1.0f,   qRgb(255, 255, 0),       true,  0.8f, DEFAULT_SAMPLE_RATE, -1 },
+    { WaveformType::PLETH,   "SpO2",     0.0f,   1.0f,   qRgb(0, 255, 255),       true,  0.5f, DEFAULT_SAMPLE_RATE, -1 },
+    { WaveformType::ABP,     "ABP",      0.0f,   2.0f,   qRgb(255, 0, 0),         true,  0.5f, DEFAULT_SAMPLE_RATE, -1 },
+    { WaveformType::CVP,     "CVP",      0.0f,   2.0f,   qRgb(255, 255, 255),     false, 0.7f, DEFAULT_SAMPLE_RATE, -1 },
+    { WaveformType::CAPNO,   "ETCO2",    0.0f,   1.0f,   qRgb(255, 255, 255),     true,  0.8f, DEFAULT_SAMPLE_RATE, -1 },
+    { WaveformType::EEG,     "EEG",    -50.0f,  50.0f,   qRgb(255, 255, 255),     false, 0.7f, DEFAULT_SAMPLE_RATE, -1 },
+}};
+
+/**
+ * @brief Properties used for identifiers that are not a waveform type
+ */
+constexpr WaveformTraits UNKNOWN_WAVEFORM_TRAITS = {
+    WaveformType::ECG_I, "Unknown", -1.0f, 1.0f, qRgb(255, 255, 255), false, 0.7f, DEFAULT_SAMPLE_RATE, -1
+};
+
+/**
+ * @brief Properties of every parameter type, in index order
+ * 
+ * The alarm limits are based on typical clinical guidelines for adult
+ * patients and can be customized through the application's configuration.
+ * Adding a parameter type means adding its enumerator and its row here.
+ */
+constexpr std::array<ParameterTraits, PARAMETER_TYPE_COUNT> PARAMETER_TRAITS = {{
+    // type                    name      unit      min     max      low crit low warn high warn high crit format
+    { ParameterType::HR,       "HR",     "bpm",    30.0f, 240.0f,  40.0f, 50.0f, 120.0f, 150.0f, ValueFormat::Adaptive },
+    { ParameterType::RR,       "RR",     "br/min",  4.0f,  40.0f,   6.0f,  8.0f,  25.0f,  30.0f, ValueFormat::Adaptive },
+    { ParameterType::SPO2,     "SpO2",   "%",      70.0f, 100.0f,  85.0f, 90.0f, 100.0f, 100.0f, ValueFormat::WholeNumber },
+    { ParameterType::NIBP_SYS, "NIBP-S", "mmHg",   60.0f, 240.0f,  80.0f, 90.0f, 160.0f, 180.0f, ValueFormat::Adaptive },
+    { ParameterType::NIBP_DIA, "NIBP-D", "mmHg",   30.0f, 140.0f,  40.0f, 50.0f,  90.0f, 110.0f, ValueFormat::Adaptive },
+    { ParameterType::NIBP_MAP, "NIBP-M", "mmHg",   40.0f, 160.0f,  50.0f, 60.0f, 110.0f, 130.0f, ValueFormat::Adaptive },
+    { ParameterType::TEMP1,    "Temp",   "°C",     30.0f,  42.0f,  35.0f, 36.0f,  38.0f,  39.0f, ValueFormat::OneDecimal },
+    { ParameterType::TEMP2,    "Temp 2", "°C",     30.0f,  42.0f,  35.0f, 36.0f,  38.0f,  39.0f, ValueFormat::OneDecimal },
+    { ParameterType::ETCO2,    "ETCO2",  "mmHg",    0.0f, 100.0f,  20.0f, 25.0f,  45.0f,  50.0f, ValueFormat::Adaptive },
+    { ParameterType::IBP1_SYS, "ABP-S",  "mmHg",   60.0f, 240.0f,  80.0f, 90.0f, 160.0f, 180.0f, ValueFormat::Adaptive },
+    { ParameterType::IBP1_DIA, "ABP-D",  "mmHg",   30.0f, 140.0f,  40.0f, 50.0f,  90.0f, 110.0f, ValueFormat::Adaptive },
+    { ParameterType::IBP1_MAP, "ABP-M",  "mmHg",   40.0f, 160.0f,  50.0f, 60.0f, 110.0f, 130.0f, ValueFormat::Adaptive },
+    { ParameterType::IBP2_SYS, "CVP-S",  "mmHg",   60.0f, 240.0f,   0.0f,  2.0f,  15.0f,  20.0f, ValueFormat::Adaptive },
+    { ParameterType::IBP2_DIA, "CVP-D",  "mmHg",   30.0f, 140.0f,   0.0f,  0.0f,   8.0f,  12.0f, ValueFormat::Adaptive },
+    { ParameterType::IBP2_MAP, "CVP-M",  "mmHg",   40.0f, 160.0f,   0.0f,  1.0f,  10.0f,  15.0f, ValueFormat::Adaptive },
+}};
+
+/**
+ * @brief Properties used for identifiers that are not a parameter type
+ */
+constexpr ParameterTraits UNKNOWN_PARAMETER_TRAITS = {
+    ParameterType::HR, "Unknown", "", 0.0f, 100.0f, 0.0f, 0.0f, 100.0f, 100.0f, ValueFormat::Adaptive
+};
+
+/**
+ * @brief Check that a trait table has the row of type i at index i
+ * @param traits Trait table
+ * @return True if the rows are in index order
+ */
+template <typename Traits, size_t Count>
+constexpr bool IsDenseTraitTable(const std::array<Traits, Count>& traits) {
+    for (size_t i = 0; i < Count; ++i) {
+        if (static_cast<size_t>(traits[i].type) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(IsDenseTraitTable(WAVEFORM_TRAITS), "WAVEFORM_TRAITS must have one row per waveform type, in index order");
+static_assert(IsDenseTraitTable(PARAMETER_TRAITS), "PARAMETER_TRAITS must have one row per parameter type, in index order");
+
+/**
+ * @brief Get the properties of a waveform
+ * @param waveformId Numeric waveform identifier
+ * @return The waveform type's traits, or UNKNOWN_WAVEFORM_TRAITS
+ */
+constexpr const WaveformTraits& GetWaveformTraits(int waveformId) {
+    return IsValidWaveformType(waveformId) ? WAVEFORM_TRAITS[static_cast<size_t>(waveformId)]
+                                           : UNKNOWN_WAVEFORM_TRAITS;
+}
+
+/**
+ * @brief Get the properties of a waveform type
+ * @param type Waveform type
+ * @return The waveform type's traits
+ */
+constexpr const WaveformTraits& GetWaveformTraits(WaveformType type) {
+    return GetWaveformTraits(static_cast<int>(type));
+}
+
+/**
+ * @brief Get the properties of a parameter
+ * @param parameterId Numeric parameter identifier
+ * @return The parameter type's traits, or UNKNOWN_PARAMETER_TRAITS
+ */
+constexpr const ParameterTraits& GetParameterTraits(int parameterId) {
+    return IsValidParameterType(parameterId) ? PARAMETER_TRAITS[static_cast<size_t>(parameterId)]
+                                             : UNKNOWN_PARAMETER_TRAITS;
+}
+
+/**
+ * @brief Get the properties of a parameter type
+ * @param type Parameter type
+ * @return The parameter type's traits
+ */
+constexpr const ParameterTraits& GetParameterTraits(ParameterType type) {
+    return GetParameterTraits(static_cast<int>(type));
+}
+
 /**
  * @brief Get display name for a waveform type
  * @param type Waveform type
@@ -110,28 +395,7 @@ enum class ErrorCode {
  * in waveform labels and configuration menus.
  */
 inline QString GetWaveformDisplayName(WaveformType type) {
-    switch (type) {
-        case WaveformType::ECG_I:
-            return "ECG I";
-        case WaveformType::ECG_II:
-            return "ECG II";
-        case WaveformType::ECG_III:
-            return "ECG III";
-        case WaveformType::RESP:
-            return "Resp";
-        case WaveformType::PLETH:
-            return "SpO2";
-        case WaveformType::ABP:
-            return "ABP";
-        case WaveformType::CVP:
-            return "CVP";
-        case WaveformType::CAPNO:
-            return "ETCO2";
-        case WaveformType::EEG:
-            return "EEG";
-        default:
-            return "Unknown";
-    }
+    return QString::fromUtf8(GetWaveformTraits(type).displayName);
 }
 
 /**
@@ -145,40 +409,7 @@ inline QString GetWaveformDisplayName(WaveformType type) {
  * abbreviated forms that are standard in medical displays.
  */
 inline QString GetParameterDisplayName(ParameterType type) {
-    switch (type) {
-        case ParameterType::HR:
-            return "HR";
-        case ParameterType::RR:
-            return "RR";
-        case ParameterType::SPO2:
-            return "SpO2";
-        case ParameterType::NIBP_SYS:
-            return "NIBP-S";
-        case ParameterType::NIBP_DIA:
-            return "NIBP-D";
-        case ParameterType::NIBP_MAP:
-            return "NIBP-M";
-        case ParameterType::TEMP1:
-            return "Temp";
-        case ParameterType::TEMP2:
-            return "Temp 2";
-        case ParameterType::ETCO2:
-            return "ETCO2";
-        case ParameterType::IBP1_SYS:
-            return "ABP-S";
-        case ParameterType::IBP1_DIA:
-            return "ABP-D";
-        case ParameterType::IBP1_MAP:
-            return "ABP-M";
-        case ParameterType::IBP2_SYS:
-            return "CVP-S";
-        case ParameterType::IBP2_DIA:
-            return "CVP-D";
-        case ParameterType::IBP2_MAP:
-            return "CVP-M";
-        default:
-            return "Unknown";
-    }
+    return QString::fromUtf8(GetParameterTraits(type).displayName);
 }
 
 /**
@@ -192,31 +423,7 @@ inline QString GetParameterDisplayName(ParameterType type) {
  * per minute (bpm) and temperature in degrees Celsius (°C).
  */
 inline QString GetParameterUnit(ParameterType type) {
-    switch (type) {
-        case ParameterType::HR:
-            return "bpm";
-        case ParameterType::RR:
-            return "br/min";
-        case ParameterType::SPO2:
-            return "%";
-        case ParameterType::NIBP_SYS:
-        case ParameterType::NIBP_DIA:
-        case ParameterType::NIBP_MAP:
-        case ParameterType::IBP1_SYS:
-        case ParameterType::IBP1_DIA:
-        case ParameterType::IBP1_MAP:
-        case ParameterType::IBP2_SYS:
-        case ParameterType::IBP2_DIA:
-        case ParameterType::IBP2_MAP:
-            return "mmHg";
-        case ParameterType::TEMP1:
-        case ParameterType::TEMP2:
-            return "°C";
-        case ParameterType::ETCO2:
-            return "mmHg";
-        default:
-            return "";
-    }
+    return QString::fromUtf8(GetParameterTraits(type).unit);
 }
 
 /**
@@ -229,26 +436,9 @@ inline QString GetParameterUnit(ParameterType type) {
  * waveform type and are used for initial scaling when displaying waveforms.
  * The values represent the typical physiological range for each signal type.
  */
-inline std::pair<float, float> GetDefaultWaveformRange(WaveformType type) {
-    switch (type) {
-        case WaveformType::ECG_I:
-        case WaveformType::ECG_II:
-        case WaveformType::ECG_III:
-            return {-1.5f, 1.5f}; // mV
-        case WaveformType::RESP:
-            return {-1.0f, 1.0f}; // Arbitrary units
-        case WaveformType::PLETH:
-            return {0.0f, 1.0f};  // Normalized 0-1
-        case WaveformType::ABP:
-        case WaveformType::CVP:
-            return {0.0f, 2.0f};  // Normalized 0-2 (to handle pressure values)
-        case WaveformType::CAPNO:
-            return {0.0f, 1.0f};  // Normalized 0-1
-        case WaveformType::EEG:
-            return {-50.0f, 50.0f}; // μV
-        default:
-            return {-1.0f, 1.0f};  // Default range
-    }
+constexpr std::pair<float, float> GetDefaultWaveformRange(WaveformType type) {
+    const WaveformTraits& traits = GetWaveformTraits(type);
+    return {traits.minValue, traits.maxValue};
 }
 
 /**
@@ -261,34 +451,9 @@ inline std::pair<float, float> GetDefaultWaveformRange(WaveformType type) {
  * parameter type and are used for scaling parameter displays and trends.
  * The values represent the typical physiological range for each parameter.
  */
-inline std::pair<float, float> GetDefaultParameterRange(ParameterType type) {
-    switch (type) {
-        case ParameterType::HR:
-            return {30.0f, 240.0f}; // bpm
-        case ParameterType::RR:
-            return {4.0f, 40.0f};   // breaths/min
-        case ParameterType::SPO2:
-            return {70.0f, 100.0f}; // %
-        case ParameterType::NIBP_SYS:
-        case ParameterType::IBP1_SYS:
-        case ParameterType::IBP2_SYS:
-            return {60.0f, 240.0f}; // mmHg
-        case ParameterType::NIBP_DIA:
-        case ParameterType::IBP1_DIA:
-        case ParameterType::IBP2_DIA:
-            return {30.0f, 140.0f}; // mmHg
-        case ParameterType::NIBP_MAP:
-        case ParameterType::IBP1_MAP:
-        case ParameterType::IBP2_MAP:
-            return {40.0f, 160.0f}; // mmHg
-        case ParameterType::TEMP1:
-        case ParameterType::TEMP2:
-            return {30.0f, 42.0f};  // °C
-        case ParameterType::ETCO2:
-            return {0.0f, 100.0f};  // mmHg
-        default:
-            return {0.0f, 100.0f};  // Default range
-    }
+constexpr std::pair<float, float> GetDefaultParameterRange(ParameterType type) {
+    const ParameterTraits& traits = GetParameterTraits(type);
+    return {traits.minValue, traits.maxValue};
 }
 
 /**
@@ -302,69 +467,11 @@ inline std::pair<float, float> GetDefaultParameterRange(ParameterType type) {
  * typical clinical guidelines for adult patients but can be customized
  * through the application's configuration.
  */
-inline std::tuple<float, float, float, float> GetDefaultAlarmLimits(ParameterType type) {
-    switch (type) {
-        case ParameterType::HR:
-            return {40.0f, 50.0f, 120.0f, 150.0f}; // bpm
-        case ParameterType::RR:
-            return {6.0f, 8.0f, 25.0f, 30.0f};     // breaths/min
-        case ParameterType::SPO2:
-            return {85.0f, 90.0f, 100.0f, 100.0f}; // %
-        case ParameterType::NIBP_SYS:
-        case ParameterType::IBP1_SYS:
-            return {80.0f, 90.0f, 160.0f, 180.0f}; // mmHg
-        case ParameterType::NIBP_DIA:
-        case ParameterType::IBP1_DIA:
-            return {40.0f, 50.0f, 90.0f, 110.0f};  // mmHg
-        case ParameterType::NIBP_MAP:
-        case ParameterType::IBP1_MAP:
-            return {50.0f, 60.0f, 110.0f, 130.0f}; // mmHg
-        case ParameterType::IBP2_SYS:
-            return {0.0f, 2.0f, 15.0f, 20.0f};     // mmHg (CVP)
-        case ParameterType::IBP2_DIA:
-            return {0.0f, 0.0f, 8.0f, 12.0f};      // mmHg (CVP)
-        case ParameterType::IBP2_MAP:
-            return {0.0f, 1.0f, 10.0f, 15.0f};     // mmHg (CVP)
-        case ParameterType::TEMP1:
-        case ParameterType::TEMP2:
-            return {35.0f, 36.0f, 38.0f, 39.0f};   // °C
-        case ParameterType::ETCO2:
-            return {20.0f, 25.0f, 45.0f, 50.0f};   // mmHg
-        default:
-            return {0.0f, 0.0f, 100.0f, 100.0f};   // Default limits
-    }
+constexpr std::tuple<float, float, float, float> GetDefaultAlarmLimits(ParameterType type) {
+    const ParameterTraits& traits = GetParameterTraits(type);
+    return {traits.lowCritical, traits.lowWarning, traits.highWarning, traits.highCritical};
 }
 
-/**
- * @brief Default sample rate for waveforms in samples per second
- * 
- * Defines the standard sampling rate for waveform data in the system.
- * This value is used for buffer sizing, time calculations, and when
- * generating demo data. A rate of 250 samples per second is sufficient
- * for most physiological waveforms while maintaining reasonable performance.
- */
-const int DEFAULT_SAMPLE_RATE = 250;
-
-/**
- * @brief Default buffer size in seconds
- * 
- * Defines the default amount of waveform history to maintain in memory.
- * This determines how far back in time waveform displays can show data
- * and affects memory usage. Combined with the sample rate, this determines
- * the total number of samples stored for each waveform.
- */
-const int DEFAULT_BUFFER_SECONDS = 10;
-
-/**
- * @brief Default sweep speed in pixels per second
- * 
- * Defines the default horizontal scrolling speed for waveform displays.
- * This value determines how many horizontal pixels represent one second
- * of waveform data. Higher values show more detail but less history on
- * the screen at once.
- */
-const double DEFAULT_SWEEP_SPEED = 25.0;
-
 } // namespace VitalSync
 
 #endif // VITAL_SYNC_TYPES_H 
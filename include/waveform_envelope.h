@@ -0,0 +1,24 @@
+/**
+ * @file waveform_envelope.h
+ * @brief Min/max envelopes returned by waveform models
+ *
+ * This file defines the EnvelopeColumn records filled by
+ * IWaveformModel::GetEnvelope(). An envelope divides a time range into a fixed
+ * number of columns, usually one per pixel, and reports the lowest and highest
+ * sample of each, so a trace of any length can be drawn with one vertical line
+ * per column.
+ */
+
+#ifndef WAVEFORM_ENVELOPE_H
+#define WAVEFORM_ENVELOPE_H
+
+/**
+ * @brief Value range of the samples in one column of an envelope
+ */
+struct EnvelopeColumn {
+    float min = 0.0f;       ///< Lowest sample in the column
+    float max = 0.0f;       ///< Highest sample in the column
+    bool valid = false;     ///< Whether the column holds any retained data
+};
+
+#endif // WAVEFORM_ENVELOPE_H
@@ -0,0 +1,224 @@
+/**
+ * @file waveform_snapshot.h
+ * @brief Copy-free read views over waveform sample storage
+ *
+ * This file defines the SampleBlock storage shared between a waveform model and
+ * its readers, and the WaveformSnapshot read view handed out by
+ * IWaveformModel::GetSnapshot(). A snapshot pins a fixed window of sample
+ * sequence numbers and keeps the underlying block alive through reference
+ * counting, so any number of views can read it concurrently without copying the
+ * buffer and without ever blocking the ingest path.
+ */
+
+#ifndef WAVEFORM_SNAPSHOT_H
+#define WAVEFORM_SNAPSHOT_H
+
+#include <QtGlobal>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Reference-counted sample storage of a waveform ring buffer
+ *
+ * The producer publishes the end of the range it is about to overwrite in
+ * claim before touching the samples. Readers compare their window against
+ * claim to find out which samples are still intact.
+ */
+struct SampleBlock
+{
+    /**
+     * @brief Constructor
+     * @param capacity Number of sample slots
+     * @param baseSequence Sequence number of the first sample the block will hold
+     */
+    explicit SampleBlock(int capacity, quint64 baseSequence = 0)
+        : samples(static_cast<size_t>(std::max(capacity, 0)), 0.0f)
+        , base(baseSequence)
+        , claim(baseSequence)
+    {
+    }
+
+    std::vector<float> samples;       ///< Sample slots indexed by sequence modulo capacity
+    const quint64 base;               ///< No sample before this sequence number is held by the block
+    std::atomic<quint64> claim;       ///< End of the sequence range being written
+};
+
+/**
+ * @brief Consistent, copy-free window of waveform samples
+ *
+ * A snapshot covers the sample sequence numbers [GetFirstSequence(),
+ * GetEndSequence()). Samples are read in place from the shared block. Because the
+ * producer keeps writing, the oldest samples of a long-lived snapshot may be
+ * recycled; GetValidFirstSequence() reports the oldest sample that is still
+ * intact, and ForEachSpan() and CopyTo() only ever deliver intact samples.
+ * Snapshots are cheap to copy and safe to use from any thread.
+ */
+class WaveformSnapshot
+{
+public:
+    /**
+     * @brief Constructs an empty snapshot
+     */
+    WaveformSnapshot() = default;
+
+    /**
+     * @brief Constructs a snapshot over a block
+     * @param block Shared sample storage
+     * @param firstSequence Sequence number of the first sample
+     * @param endSequence Sequence number one past the last sample
+     * @param lastTimestamp Timestamp in milliseconds of the newest chunk
+     */
+    WaveformSnapshot(std::shared_ptr<const SampleBlock> block, quint64 firstSequence,
+                     quint64 endSequence, qint64 lastTimestamp = 0)
+        : block_(std::move(block))
+        , first_sequence_(firstSequence)
+        , end_sequence_(std::max(firstSequence, endSequence))
+        , last_timestamp_(lastTimestamp)
+    {
+    }
+
+    /**
+     * @brief Check whether the snapshot holds any samples
+     * @return True if empty
+     */
+    bool isEmpty() const { return !block_ || first_sequence_ == end_sequence_; }
+
+    /**
+     * @brief Get the number of samples in the window
+     * @return Sample count
+     */
+    int size() const { return block_ ? static_cast<int>(end_sequence_ - first_sequence_) : 0; }
+
+    /**
+     * @brief Get the sequence number of the first sample
+     * @return First sequence number
+     */
+    quint64 GetFirstSequence() const { return first_sequence_; }
+
+    /**
+     * @brief Get the sequence number one past the last sample
+     * @return End sequence number
+     */
+    quint64 GetEndSequence() const { return end_sequence_; }
+
+    /**
+     * @brief Get the timestamp of the newest chunk in the window
+     * @return Timestamp in milliseconds since epoch
+     */
+    qint64 GetLastTimestamp() const { return last_timestamp_; }
+
+    /**
+     * @brief Get the first sequence number that has not been overwritten
+     * @return Oldest intact sequence number within the window
+     */
+    quint64 GetValidFirstSequence() const
+    {
+        if (!block_) {
+            return end_sequence_;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const quint64 claim = block_->claim.load(std::memory_order_relaxed);
+        const quint64 capacity = block_->samples.size();
+        const quint64 oldest = claim > capacity ? claim - capacity : 0;
+        return std::min(std::max(first_sequence_, oldest), end_sequence_);
+    }
+
+    /**
+     * @brief Check whether every sample in the window is still intact
+     * @return True if no sample has been overwritten
+     */
+    bool isValid() const { return GetValidFirstSequence() == first_sequence_; }
+
+    /**
+     * @brief Read a single sample
+     * @param index Index within the window, 0 being the oldest
+     * @return Sample value
+     *
+     * Intended for sparse access. Callers iterating over many samples should use
+     * ForEachSpan(), which avoids the per-sample modulo.
+     */
+    float at(int index) const
+    {
+        const std::vector<float>& samples = block_->samples;
+        return samples[static_cast<size_t>((first_sequence_ + static_cast<quint64>(index)) % samples.size())];
+    }
+
+    /**
+     * @brief Get the newest sample in the window
+     * @return Sample value
+     */
+    float last() const { return at(size() - 1); }
+
+    /**
+     * @brief Visit the window as at most two contiguous spans
+     * @param fn Callable invoked as fn(const float* data, int count, quint64 firstSequence)
+     *
+     * Spans are delivered oldest first. Samples that were already recycled when
+     * the call starts are skipped.
+     */
+    template <typename Fn>
+    void ForEachSpan(Fn&& fn) const
+    {
+        if (isEmpty()) {
+            return;
+        }
+        const quint64 start = GetValidFirstSequence();
+        if (start >= end_sequence_) {
+            return;
+        }
+        const std::vector<float>& samples = block_->samples;
+        const quint64 capacity = samples.size();
+        const int count = static_cast<int>(end_sequence_ - start);
+        const int offset = static_cast<int>(start % capacity);
+        const int firstSpan = std::min(count, static_cast<int>(capacity) - offset);
+        fn(samples.data() + offset, firstSpan, start);
+        if (firstSpan < count) {
+            fn(samples.data(), count - firstSpan, start + static_cast<quint64>(firstSpan));
+        }
+    }
+
+    /**
+     * @brief Copy the intact part of the window into a buffer
+     * @param out Destination buffer, at least size() samples long
+     * @param firstSequence Receives the sequence number of out[0]
+     * @return Number of samples copied
+     *
+     * The copy is validated again once it is complete, so samples recycled
+     * while copying are trimmed from the front.
+     */
+    int CopyTo(float* out, quint64* firstSequence = nullptr) const
+    {
+        int count = 0;
+        quint64 start = end_sequence_;
+        ForEachSpan([&](const float* data, int n, quint64 sequence) {
+            if (count == 0) {
+                start = sequence;
+            }
+            std::memcpy(out + count, data, sizeof(float) * static_cast<size_t>(n));
+            count += n;
+        });
+
+        const quint64 validStart = GetValidFirstSequence();
+        if (validStart > start) {
+            const int torn = static_cast<int>(std::min<quint64>(validStart - start, static_cast<quint64>(count)));
+            std::memmove(out, out + torn, sizeof(float) * static_cast<size_t>(count - torn));
+            count -= torn;
+            start = validStart;
+        }
+        if (firstSequence) {
+            *firstSequence = start;
+        }
+        return count;
+    }
+
+private:
+    std::shared_ptr<const SampleBlock> block_;  ///< Shared sample storage
+    quint64 first_sequence_ = 0;                ///< First sequence number in the window
+    quint64 end_sequence_ = 0;                  ///< One past the last sequence number
+    qint64 last_timestamp_ = 0;                 ///< Timestamp of the newest chunk
+};
+
+#endif // WAVEFORM_SNAPSHOT_H
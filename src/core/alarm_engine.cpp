@@ -0,0 +1,182 @@
+/**
+ * @file alarm_engine.cpp
+ * @brief Implementation of the AlarmEngine class
+ *
+ * This file implements the table initialization and the branch-light frame
+ * evaluation of the AlarmEngine.
+ */
+#include "alarm_engine.h"
+#include <tuple>
+
+/**
+ * @namespace Anonymous namespace for constants and helper functions
+ * @brief Contains the defaults and level mapping used by the AlarmEngine implementation
+ */
+namespace {
+    const float DEFAULT_HYSTERESIS_FRACTION = 0.02f;   ///< Default hysteresis as a fraction of the critical band
+    const int LEVEL_OFFSET = 2;                         ///< Offset from a level to its STATE_BY_LEVEL index
+
+    /// Alarm state of each level, from low critical to high critical
+    const IParameterModel::AlarmState STATE_BY_LEVEL[] = {
+        IParameterModel::AlarmState::LowCritical,
+        IParameterModel::AlarmState::LowWarning,
+        IParameterModel::AlarmState::Normal,
+        IParameterModel::AlarmState::HighWarning,
+        IParameterModel::AlarmState::HighCritical,
+    };
+
+    /**
+     * @brief Get the severity of a level
+     * @param level Alarm level
+     * @return 0 for normal, 1 for warnings, 2 for critical alarms
+     */
+    int severity(int level)
+    {
+        return level < 0 ? -level : level;
+    }
+}
+
+/**
+ * @brief Constructs an engine with the default limits of every parameter
+ *
+ * The default hysteresis is a small fraction of the band between the two
+ * critical limits, and alarms are raised without delay.
+ */
+AlarmEngine::AlarmEngine()
+{
+    for (int i = 0; i < PARAMETER_COUNT; ++i) {
+        const auto [lowCritical, lowWarning, highWarning, highCritical] =
+            VitalSync::GetDefaultAlarmLimits(static_cast<VitalSync::ParameterType>(i));
+        limits_[static_cast<size_t>(i)] = Limits{ lowCritical, lowWarning, highWarning, highCritical,
+                                                  (highCritical - lowCritical) * DEFAULT_HYSTERESIS_FRACTION, 0 };
+    }
+    Reset();
+}
+
+/**
+ * @brief Sets the alarm limits of a parameter
+ * @param parameterId VitalSync::ParameterType of the parameter
+ * @param lowCritical Low critical limit
+ * @param lowWarning Low warning limit
+ * @param highWarning High warning limit
+ * @param highCritical High critical limit
+ *
+ * The new limits apply from the next evaluation on.
+ */
+void AlarmEngine::SetLimits(int parameterId, float lowCritical, float lowWarning, float highWarning, float highCritical)
+{
+    if (parameterId < 0 || parameterId >= PARAMETER_COUNT) {
+        return;
+    }
+    Limits& limits = limits_[static_cast<size_t>(parameterId)];
+    limits.low_critical = lowCritical;
+    limits.low_warning = lowWarning;
+    limits.high_warning = highWarning;
+    limits.high_critical = highCritical;
+}
+
+/**
+ * @brief Sets how far a value must return past a limit to clear its alarm
+ * @param parameterId VitalSync::ParameterType of the parameter
+ * @param hysteresis Hysteresis in the unit of the parameter, negative values are treated as zero
+ */
+void AlarmEngine::SetHysteresis(int parameterId, float hysteresis)
+{
+    if (parameterId < 0 || parameterId >= PARAMETER_COUNT) {
+        return;
+    }
+    limits_[static_cast<size_t>(parameterId)].hysteresis = qMax(hysteresis, 0.0f);
+}
+
+/**
+ * @brief Sets how long a condition must persist before it is raised
+ * @param parameterId VitalSync::ParameterType of the parameter
+ * @param delayMs Delay in milliseconds, negative values are treated as zero
+ */
+void AlarmEngine::SetDelay(int parameterId, int delayMs)
+{
+    if (parameterId < 0 || parameterId >= PARAMETER_COUNT) {
+        return;
+    }
+    limits_[static_cast<size_t>(parameterId)].delay_ms = qMax(delayMs, 0);
+}
+
+/**
+ * @brief Gets the raised alarm state of a parameter
+ * @param parameterId VitalSync::ParameterType of the parameter
+ * @return Alarm state, Normal for unknown parameters
+ */
+IParameterModel::AlarmState AlarmEngine::GetState(int parameterId) const
+{
+    if (parameterId < 0 || parameterId >= PARAMETER_COUNT) {
+        return IParameterModel::AlarmState::Normal;
+    }
+    return STATE_BY_LEVEL[states_[static_cast<size_t>(parameterId)].level + LEVEL_OFFSET];
+}
+
+/**
+ * @brief Evaluates the parameter values of one frame
+ * @param timestamp Frame time in milliseconds since epoch
+ * @param parameters Parameter values
+ * @param count Number of parameter values
+ * @param events Receives one event per state change, appended
+ * @return Number of state changes
+ *
+ * The level of a value is the number of high limits it exceeds minus the
+ * number of low limits it falls below. Each limit the raised level has
+ * crossed is moved toward normal by the hysteresis, so clearing needs a
+ * clear margin. Unknown parameters and NaN values are ignored.
+ */
+int AlarmEngine::Evaluate(qint64 timestamp, const VitalSync::FrameParameter* parameters, int count,
+                          QVector<AlarmEvent>& events)
+{
+    int changes = 0;
+    for (int i = 0; i < count; ++i) {
+        const int id = parameters[i].parameterId;
+        const float value = parameters[i].value;
+        if (id < 0 || id >= PARAMETER_COUNT || value != value) {
+            continue;
+        }
+
+        const Limits& limits = limits_[static_cast<size_t>(id)];
+        State& state = states_[static_cast<size_t>(id)];
+        const int raised = state.level;
+
+        const float highWarning = limits.high_warning - limits.hysteresis * (raised >= 1);
+        const float highCritical = limits.high_critical - limits.hysteresis * (raised >= 2);
+        const float lowWarning = limits.low_warning + limits.hysteresis * (raised <= -1);
+        const float lowCritical = limits.low_critical + limits.hysteresis * (raised <= -2);
+        const int level = (value > highWarning) + (value > highCritical) - (value < lowWarning) - (value < lowCritical);
+
+        if (level == raised) {
+            state.pending_level = static_cast<qint8>(level);
+            continue;
+        }
+        if (level != state.pending_level) {
+            state.pending_level = static_cast<qint8>(level);
+            state.pending_since = timestamp;
+        }
+
+        // Only conditions at least as severe as the raised one wait for the delay
+        const qint64 delay = severity(level) >= severity(raised) ? limits.delay_ms : 0;
+        if (timestamp - state.pending_since < delay) {
+            continue;
+        }
+
+        state.level = static_cast<qint8>(level);
+        events.append(AlarmEvent{ id, STATE_BY_LEVEL[raised + LEVEL_OFFSET], STATE_BY_LEVEL[level + LEVEL_OFFSET],
+                                  value, timestamp });
+        ++changes;
+    }
+    return changes;
+}
+
+/**
+ * @brief Clears all raised and pending alarms
+ *
+ * Limits, hysteresis and delays are kept.
+ */
+void AlarmEngine::Reset()
+{
+    states_.fill(State{ 0, 0, 0 });
+}
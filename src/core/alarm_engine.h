@@ -0,0 +1,121 @@
+/**
+ * @file alarm_engine.h
+ * @brief Definition of the AlarmEngine class
+ *
+ * This file contains the definition of the AlarmEngine class which decides the
+ * alarm states of all parameters of one bed from table-driven limits, with
+ * per-parameter hysteresis and alarm delays measured in data time.
+ */
+#ifndef ALARM_ENGINE_H
+#define ALARM_ENGINE_H
+
+#include "../../include/alarm_event.h"
+#include "../../include/data_frame.h"
+#include "../../include/vital_sync_types.h"
+#include <QVector>
+#include <array>
+
+/**
+ * @brief Alarm evaluation for the parameters of one bed
+ *
+ * Limits, hysteresis and delays live in flat tables indexed by parameter
+ * type, with the defaults taken from VitalSync::GetDefaultAlarmLimits().
+ * Evaluate() processes all parameters of a frame in one pass: each value is
+ * compared against its four limits without branching, the limits of the
+ * state currently raised being relaxed by the hysteresis so that a value
+ * hovering at a limit does not toggle the alarm.
+ *
+ * A new or more severe condition is only raised once it has persisted for the
+ * parameter's delay. The delay is measured between frame timestamps, so no
+ * timers are involved and replayed data alarms exactly as it did live. Less
+ * severe conditions are taken over immediately.
+ *
+ * Not thread-safe; the owning data manager serializes access.
+ */
+class AlarmEngine {
+public:
+    /// Number of parameter types covered by the tables
+    static constexpr int PARAMETER_COUNT = VitalSync::PARAMETER_TYPE_COUNT;
+
+    /**
+     * @brief Constructor
+     */
+    AlarmEngine();
+
+    /**
+     * @brief Set the alarm limits of a parameter
+     * @param parameterId VitalSync::ParameterType of the parameter
+     * @param lowCritical Low critical limit
+     * @param lowWarning Low warning limit
+     * @param highWarning High warning limit
+     * @param highCritical High critical limit
+     */
+    void SetLimits(int parameterId, float lowCritical, float lowWarning, float highWarning, float highCritical);
+
+    /**
+     * @brief Set how far a value must return past a limit to clear its alarm
+     * @param parameterId VitalSync::ParameterType of the parameter
+     * @param hysteresis Hysteresis in the unit of the parameter
+     */
+    void SetHysteresis(int parameterId, float hysteresis);
+
+    /**
+     * @brief Set how long a condition must persist before it is raised
+     * @param parameterId VitalSync::ParameterType of the parameter
+     * @param delayMs Delay in milliseconds
+     */
+    void SetDelay(int parameterId, int delayMs);
+
+    /**
+     * @brief Get the raised alarm state of a parameter
+     * @param parameterId VitalSync::ParameterType of the parameter
+     * @return Alarm state, Normal for unknown parameters
+     */
+    IParameterModel::AlarmState GetState(int parameterId) const;
+
+    /**
+     * @brief Evaluate the parameter values of one frame
+     * @param timestamp Frame time in milliseconds since epoch
+     * @param parameters Parameter values
+     * @param count Number of parameter values
+     * @param events Receives one event per state change, appended
+     * @return Number of state changes
+     */
+    int Evaluate(qint64 timestamp, const VitalSync::FrameParameter* parameters, int count,
+                 QVector<AlarmEvent>& events);
+
+    /**
+     * @brief Clear all raised and pending alarms
+     */
+    void Reset();
+
+private:
+    /**
+     * @brief Limits of one parameter
+     */
+    struct Limits {
+        float low_critical;             ///< Low critical limit
+        float low_warning;              ///< Low warning limit
+        float high_warning;             ///< High warning limit
+        float high_critical;            ///< High critical limit
+        float hysteresis;               ///< Distance a value must return past a limit
+        qint32 delay_ms;                ///< Time a condition must persist before it is raised
+    };
+
+    /**
+     * @brief Alarm progress of one parameter
+     *
+     * Levels run from -2 (low critical) over 0 (normal) to 2 (high critical).
+     */
+    struct State {
+        qint8 level;                    ///< Raised level
+        qint8 pending_level;            ///< Level waiting for its delay to elapse
+        qint64 pending_since;           ///< Frame time the pending level was first seen
+    };
+
+private:
+    std::array<Limits, PARAMETER_COUNT> limits_;    ///< Limits by parameter type
+    std::array<State, PARAMETER_COUNT> states_;     ///< Progress by parameter type
+};
+
+#endif // ALARM_ENGINE_H
@@ -0,0 +1,321 @@
+/**
+ * @file bed_manager.cpp
+ * @brief Implementation of the BedManager class
+ *
+ * This file implements the BedManager class, the registry of the beds of a
+ * central station. Each bed is an independent DataManager; the manager only
+ * creates, starts, stops and removes them.
+ */
+#include "bed_manager.h"
+#include "../utils/log_categories.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+#include <vector>
+
+/**
+ * @brief Constructs an empty BedManager
+ * @param parent The parent QObject for memory management
+ */
+BedManager::BedManager(QObject* parent)
+    : QObject(parent)
+{
+}
+
+/**
+ * @brief Destroys the BedManager
+ *
+ * Every bed stops its provider and joins its acquisition thread when its
+ * DataManager is destroyed.
+ */
+BedManager::~BedManager()
+{
+    QMap<QString, std::shared_ptr<DataManager>> beds;
+    {
+        QMutexLocker locker(&mutex_);
+        beds.swap(beds_);
+        bed_order_.clear();
+    }
+    beds.clear();
+}
+
+/**
+ * @brief Adds a bed and initializes its provider and models
+ * @param bedId Unique, non-empty identifier of the bed
+ * @return The data manager of the new bed, or nullptr on failure
+ *
+ * The bed is created stopped; call startAcquisition() on it or startAll().
+ */
+std::shared_ptr<IDataManager> BedManager::AddBed(const QString& bedId)
+{
+    if (!canAddBed(bedId)) {
+        return nullptr;
+    }
+
+    // Initialization starts the bed's thread and creates its provider, so it
+    // happens outside the registry lock
+    std::shared_ptr<DataManager> bed = createBed(bedId, thread());
+    return bed && registerBed(bedId, bed) ? bed : nullptr;
+}
+
+/**
+ * @brief Adds several beds, initializing them in parallel
+ * @param bedIds Unique, non-empty identifiers of the beds
+ * @return The data managers of the beds that were added, in the order given
+ *
+ * Every bed is built and initialized on a thread of a pool sized to the
+ * machine's cores and then handed over to the manager's thread, so that a
+ * station with dozens of beds comes up in the time of a few. Beds are
+ * registered and announced with bedAdded() in the order given, from the
+ * calling thread, which must be the manager's thread. The beds are created
+ * stopped.
+ */
+QVector<std::shared_ptr<IDataManager>> BedManager::AddBeds(const QStringList& bedIds)
+{
+    QStringList pending;
+    for (const QString& bedId : bedIds) {
+        if (pending.contains(bedId)) {
+            qWarning() << "BedManager: Bed listed twice:" << bedId;
+        } else if (canAddBed(bedId)) {
+            pending.append(bedId);
+        }
+    }
+    if (pending.isEmpty()) {
+        return {};
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    std::vector<std::shared_ptr<DataManager>> built(static_cast<size_t>(pending.size()));
+    QThread* target = thread();
+    {
+        // The pool's threads end with it, after every bed has been moved off them
+        QThreadPool pool;
+        pool.setMaxThreadCount(std::max(1, std::min(QThread::idealThreadCount(), static_cast<int>(pending.size()))));
+        for (int i = 0; i < pending.size(); ++i) {
+            pool.start([&built, &pending, i, target]() {
+                built[static_cast<size_t>(i)] = createBed(pending[i], target);
+            });
+        }
+        pool.waitForDone();
+        qCInfo(lcIngest) << "BedManager: Initialized" << pending.size() << "beds in" << timer.elapsed()
+                        << "ms on" << pool.maxThreadCount() << "threads";
+    }
+
+    QVector<std::shared_ptr<IDataManager>> added;
+    added.reserve(pending.size());
+    for (int i = 0; i < pending.size(); ++i) {
+        std::shared_ptr<DataManager>& bed = built[static_cast<size_t>(i)];
+        if (bed && registerBed(pending[i], bed)) {
+            added.append(bed);
+        }
+    }
+    return added;
+}
+/**
+ * @brief Stops and removes a bed
+ * @param bedId Identifier of the bed
+ * @return True if the bed existed
+ *
+ * The bed is destroyed once the last view releases its models.
+ */
+bool BedManager::RemoveBed(const QString& bedId)
+{
+    std::shared_ptr<DataManager> bed;
+    {
+        QMutexLocker locker(&mutex_);
+        bed = beds_.take(bedId);
+        bed_order_.removeAll(bedId);
+    }
+
+    if (!bed) {
+        return false;
+    }
+
+    bed->stopAcquisition();
+    disconnect(bed.get(), nullptr, this, nullptr);
+
+    qCInfo(lcIngest) << "BedManager: Removed bed" << bedId;
+    emit bedRemoved(bedId);
+    return true;
+}
+
+/**
+ * @brief Gets the data manager of a bed
+ * @param bedId Identifier of the bed
+ * @return The bed's data manager, or nullptr if not found
+ */
+std::shared_ptr<IDataManager> BedManager::GetBed(const QString& bedId) const
+{
+    QMutexLocker locker(&mutex_);
+    return beds_.value(bedId);
+}
+
+/**
+ * @brief Gets the identifiers of all beds
+ * @return Bed identifiers in the order the beds were added
+ */
+QStringList BedManager::GetBedIds() const
+{
+    QMutexLocker locker(&mutex_);
+    return bed_order_;
+}
+
+/**
+ * @brief Gets the number of beds
+ * @return Number of beds
+ */
+int BedManager::GetBedCount() const
+{
+    QMutexLocker locker(&mutex_);
+    return bed_order_.size();
+}
+
+/**
+ * @brief Starts acquisition on all beds
+ * @return Number of beds that started
+ *
+ * Each bed is started on its own acquisition thread; a bed that fails to
+ * start does not keep the others from running.
+ */
+int BedManager::startAll()
+{
+    int started = 0;
+    for (const auto& bed : bedList()) {
+        if (bed->startAcquisition()) {
+            ++started;
+        } else {
+            qWarning() << "BedManager: Failed to start bed" << bed->GetBedId();
+        }
+    }
+    return started;
+}
+
+/**
+ * @brief Stops acquisition on all beds
+ */
+void BedManager::stopAll()
+{
+    for (const auto& bed : bedList()) {
+        bed->stopAcquisition();
+    }
+}
+
+/**
+ * @brief Pins the acquisition threads of all beds and sets their scheduling priority
+ * @param options Processor affinity and real-time priority
+ * @return Number of beds whose thread was tuned
+ *
+ * All beds share the processors given, so the scheduler still spreads them
+ * across that set. Beds added later keep the default scheduling.
+ */
+int BedManager::SetAcquisitionThreadTuning(const ThreadTuning::Options& options)
+{
+    int tuned = 0;
+    for (const auto& bed : bedList()) {
+        if (bed->SetAcquisitionThreadTuning(options)) {
+            ++tuned;
+        } else {
+            qWarning() << "BedManager: Failed to tune the acquisition thread of bed" << bed->GetBedId();
+        }
+    }
+    return tuned;
+}
+
+/**
+ * @brief Gets a snapshot of all beds
+ * @return All bed data managers in the order they were added
+ *
+ * Lifecycle calls block until the bed's thread has run them, so they are
+ * made on the snapshot rather than with the registry lock held.
+ */
+QVector<std::shared_ptr<DataManager>> BedManager::bedList() const
+{
+    QMutexLocker locker(&mutex_);
+
+    QVector<std::shared_ptr<DataManager>> result;
+    result.reserve(bed_order_.size());
+    for (const QString& bedId : bed_order_) {
+        result.append(beds_.value(bedId));
+    }
+    return result;
+}
+
+/**
+ * @brief Checks if a bed can be added
+ * @param bedId Identifier of the bed
+ * @return True if the identifier is not empty and not in use
+ */
+bool BedManager::canAddBed(const QString& bedId) const
+{
+    if (bedId.isEmpty()) {
+        qWarning() << "BedManager: Cannot add a bed without an identifier";
+        return false;
+    }
+
+    QMutexLocker locker(&mutex_);
+    if (beds_.contains(bedId)) {
+        qWarning() << "BedManager: Bed already exists:" << bedId;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Creates and initializes the data manager of a bed
+ * @param bedId Identifier of the bed
+ * @param target Thread the data manager is to live on
+ * @return The initialized data manager, or nullptr on failure
+ *
+ * May run on any thread. The data manager, its models and its acquisition
+ * thread object are created on the calling thread and moved to the target
+ * thread once initialized.
+ */
+std::shared_ptr<DataManager> BedManager::createBed(const QString& bedId, QThread* target)
+{
+    auto bed = std::make_shared<DataManager>(bedId);
+    if (!bed->initialize()) {
+        qWarning() << "BedManager: Failed to initialize bed" << bedId;
+        return nullptr;
+    }
+
+    if (target && bed->thread() != target) {
+        bed->moveToThread(target);
+    }
+    return bed;
+}
+
+/**
+ * @brief Registers an initialized bed and announces it
+ * @param bedId Identifier of the bed
+ * @param bed Data manager of the bed, living on the manager's thread
+ * @return False if a bed of that identifier was added in the meantime
+ */
+bool BedManager::registerBed(const QString& bedId, const std::shared_ptr<DataManager>& bed)
+{
+    connect(bed.get(), &IDataManager::errorOccurred, this, [this, bedId](int errorCode, const QString& errorMessage) {
+        emit bedErrorOccurred(bedId, errorCode, errorMessage);
+    });
+    connect(bed.get(), &IDataManager::alarmsChanged, this, [this, bedId](const QVector<AlarmEvent>& events) {
+        emit bedAlarmsChanged(bedId, events);
+    });
+
+    {
+        QMutexLocker locker(&mutex_);
+        if (beds_.contains(bedId)) {
+            locker.unlock();
+            qWarning() << "BedManager: Bed already exists:" << bedId;
+            disconnect(bed.get(), nullptr, this, nullptr);
+            return false;
+        }
+        beds_.insert(bedId, bed);
+        bed_order_.append(bedId);
+    }
+
+    qCInfo(lcIngest) << "BedManager: Added bed" << bedId;
+    emit bedAdded(bedId);
+    return true;
+}
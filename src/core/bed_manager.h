@@ -0,0 +1,168 @@
+/**
+ * @file bed_manager.h
+ * @brief Definition of the BedManager class
+ *
+ * This file contains the definition of the BedManager class which manages the
+ * beds of a central station. Every bed is a DataManager of its own, with its own
+ * provider, models, acquisition thread and locks, so ingest for one bed never
+ * contends with another and the beds spread across all cores of the machine.
+ */
+#ifndef BED_MANAGER_H
+#define BED_MANAGER_H
+
+#include "data_manager.h"
+#include <QObject>
+#include <QMap>
+#include <QMutex>
+#include <QStringList>
+#include <QVector>
+#include <memory>
+
+/**
+ * @brief Registry of the beds shown on a central station
+ *
+ * The manager's own lock only guards the bed registry, which changes when
+ * beds are added or removed. It is never taken on the ingest path.
+ */
+class BedManager : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor
+     * @param parent Parent QObject
+     */
+    explicit BedManager(QObject* parent = nullptr);
+
+    /**
+     * @brief Destructor
+     *
+     * Stops and destroys all beds.
+     */
+    ~BedManager() override;
+
+    /**
+     * @brief Add a bed and initialize its provider and models
+     * @param bedId Unique, non-empty identifier of the bed
+     * @return The data manager of the new bed, or nullptr on failure
+     */
+    std::shared_ptr<IDataManager> AddBed(const QString& bedId);
+
+    /**
+     * @brief Add several beds, initializing them in parallel
+     * @param bedIds Unique, non-empty identifiers of the beds
+     * @return The data managers of the beds that were added, in the order given
+     */
+    QVector<std::shared_ptr<IDataManager>> AddBeds(const QStringList& bedIds);
+
+    /**
+     * @brief Stop and remove a bed
+     * @param bedId Identifier of the bed
+     * @return True if the bed existed
+     */
+    bool RemoveBed(const QString& bedId);
+
+    /**
+     * @brief Get the data manager of a bed
+     * @param bedId Identifier of the bed
+     * @return The bed's data manager, or nullptr if not found
+     */
+    std::shared_ptr<IDataManager> GetBed(const QString& bedId) const;
+
+    /**
+     * @brief Get the identifiers of all beds
+     * @return Bed identifiers in the order the beds were added
+     */
+    QStringList GetBedIds() const;
+
+    /**
+     * @brief Get the number of beds
+     * @return Number of beds
+     */
+    int GetBedCount() const;
+
+    /**
+     * @brief Start acquisition on all beds
+     * @return Number of beds that started
+     */
+    int startAll();
+
+    /**
+     * @brief Stop acquisition on all beds
+     */
+    void stopAll();
+
+    /**
+     * @brief Pin the acquisition threads of all beds and set their scheduling priority
+     * @param options Processor affinity and real-time priority
+     * @return Number of beds whose thread was tuned
+     */
+    int SetAcquisitionThreadTuning(const ThreadTuning::Options& options);
+
+signals:
+    /**
+     * @brief Signal emitted after a bed was added
+     * @param bedId Identifier of the bed
+     */
+    void bedAdded(const QString& bedId);
+
+    /**
+     * @brief Signal emitted after a bed was removed
+     * @param bedId Identifier of the bed
+     */
+    void bedRemoved(const QString& bedId);
+
+    /**
+     * @brief Signal emitted when a bed reports an error
+     * @param bedId Identifier of the bed
+     * @param errorCode Error code
+     * @param errorMessage Error message
+     */
+    void bedErrorOccurred(const QString& bedId, int errorCode, const QString& errorMessage);
+
+    /**
+     * @brief Signal emitted when alarm states of a bed change
+     * @param bedId Identifier of the bed
+     * @param events The alarm state changes of one frame of the bed
+     */
+    void bedAlarmsChanged(const QString& bedId, const QVector<AlarmEvent>& events);
+
+private:
+    /**
+     * @brief Check if a bed can be added
+     * @param bedId Identifier of the bed
+     * @return True if the identifier is not empty and not in use
+     */
+    bool canAddBed(const QString& bedId) const;
+
+    /**
+     * @brief Create and initialize the data manager of a bed
+     * @param bedId Identifier of the bed
+     * @param target Thread the data manager is to live on
+     * @return The initialized data manager, or nullptr on failure
+     *
+     * May run on any thread.
+     */
+    static std::shared_ptr<DataManager> createBed(const QString& bedId, QThread* target);
+
+    /**
+     * @brief Register an initialized bed and announce it
+     * @param bedId Identifier of the bed
+     * @param bed Data manager of the bed, living on the manager's thread
+     * @return False if a bed of that identifier was added in the meantime
+     */
+    bool registerBed(const QString& bedId, const std::shared_ptr<DataManager>& bed);
+
+    /**
+     * @brief Get a snapshot of all beds
+     * @return All bed data managers in the order they were added
+     */
+    QVector<std::shared_ptr<DataManager>> bedList() const;
+
+private:
+    QMap<QString, std::shared_ptr<DataManager>> beds_;  ///< Beds by identifier
+    QStringList bed_order_;                             ///< Bed identifiers in the order they were added
+    mutable QMutex mutex_;                              ///< Guards the bed registry
+};
+
+#endif // BED_MANAGER_H
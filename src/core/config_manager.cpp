@@ -11,10 +11,16 @@
  */
 #include "../../include/config_manager.h"
 
+#include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
 #include <QFile>
+#include <QMutexLocker>
 #include <QStandardPaths>
+#include <QStringList>
+#include <QThread>
+#include <QThreadPool>
+#include <utility>
 
 // Singleton instance
 static ConfigManager* s_instance = nullptr;
@@ -27,41 +33,94 @@ namespace {
     const QString KEY_DEFAULT_GRID_COLOR = "defaultGridColor";
     const QString KEY_DEFAULT_BG_COLOR = "defaultBackgroundColor";
     
+    // Configuration arrays
+    const QString ARRAY_PROVIDERS = "Providers";
+    const QString ARRAY_WAVEFORMS = "Waveforms";
+    const QString ARRAY_PARAMETERS = "Parameters";
+    
     // Default values
     const QString DEFAULT_PROVIDER = "Demo";
     const double DEFAULT_SWEEP_SPEED = VitalSync::DEFAULT_SWEEP_SPEED;
     const QColor DEFAULT_GRID_COLOR = QColor(0, 128, 0);  // Green
     const QColor DEFAULT_BG_COLOR = QColor(0, 0, 0);      // Black
+
+    /**
+     * @brief Reads a configuration array of the settings store
+     * @param settings Settings store
+     * @param array Name of the array
+     * @param keyName Name of the entry holding the map key
+     * @param configs Map to fill
+     */
+    template <typename Key>
+    void readConfigArray(QSettings& settings, const QString& array, const QString& keyName,
+                         QMap<Key, QVariantMap>& configs)
+    {
+        const int count = settings.beginReadArray(array);
+        for (int i = 0; i < count; ++i) {
+            settings.setArrayIndex(i);
+            configs.insert(settings.value(keyName).template value<Key>(), settings.value("Config").toMap());
+        }
+        settings.endArray();
+    }
+
+    /**
+     * @brief Replaces a configuration array of the settings store
+     * @param settings Settings store
+     * @param array Name of the array
+     * @param keyName Name of the entry holding the map key
+     * @param configs Configurations to write
+     *
+     * The old array is removed first, so no stale entries remain when the
+     * array shrinks.
+     */
+    template <typename Key>
+    void writeConfigArray(QSettings& settings, const QString& array, const QString& keyName,
+                          const QMap<Key, QVariantMap>& configs)
+    {
+        settings.remove(array);
+        settings.beginWriteArray(array, static_cast<int>(configs.size()));
+        int index = 0;
+        for (auto it = configs.constBegin(); it != configs.constEnd(); ++it, ++index) {
+            settings.setArrayIndex(index);
+            settings.setValue(keyName, it.key());
+            settings.setValue("Config", it.value());
+        }
+        settings.endArray();
+    }
 }
 
 /**
  * @brief Private constructor for singleton pattern
  * 
- * Initializes the configuration manager with empty maps for provider,
- * waveform, and parameter configurations. Sets the dirty flag to false
- * to indicate no unsaved changes initially.
+ * Starts with an empty snapshot and no unsaved changes, so the getters
+ * return their defaults until Initialize() has run.
  */
 ConfigManager::ConfigManager()
-    : dirty_(false)
+    : snapshot_(std::make_shared<const Snapshot>())
+    , providers_dirty_(false)
+    , waveforms_dirty_(false)
+    , parameters_dirty_(false)
+    , clear_pending_(false)
+    , flush_scheduled_(false)
 {
-    // Initialize maps
-    provider_configs_ = QMap<QString, QVariantMap>();
-    waveform_configs_ = QMap<int, QVariantMap>();
-    parameter_configs_ = QMap<int, QVariantMap>();
+    flush_timer_.setSingleShot(true);
+    flush_timer_.setInterval(FLUSH_DELAY_MS);
+    connect(&flush_timer_, &QTimer::timeout, this, [this]() {
+        // Changes arriving from now on schedule the next flush
+        flush_scheduled_.store(false);
+        QThreadPool::globalInstance()->start([this]() { flush(); });
+    });
 }
 
 /**
  * @brief Destructor
  * 
- * Saves any unsaved configuration changes to persistent storage
+ * Writes any unsaved configuration changes to persistent storage
  * before destroying the configuration manager instance.
  */
 ConfigManager::~ConfigManager()
 {
-    // Save if dirty
-    if (dirty_) {
-        save();
-    }
+    flush();
 }
 
 /**
@@ -87,101 +146,73 @@ ConfigManager& ConfigManager::GetInstance()
  * @return True if initialization was successful, false otherwise
  * 
  * Creates the QSettings object with the provided organization and application names.
- * Loads previously saved provider, waveform, and parameter configurations from
- * persistent storage into memory for access during the application session.
+ * Reads all basic settings and the provider, waveform, and parameter configurations
+ * in one pass into a snapshot, which serves all reads of the session. Registers a
+ * final flush for the application's shutdown, so changes made after the main
+ * window saved (the models write their configuration when they are destroyed)
+ * are not lost.
  */
 bool ConfigManager::Initialize(const QString& organization, const QString& application)
 {
-    try {
-        // Create settings object
-        settings_ = std::make_unique<QSettings>(organization, application);
-        
-        // Load provider configurations
-        int providerCount = settings_->beginReadArray("Providers");
-        for (int i = 0; i < providerCount; ++i) {
-            settings_->setArrayIndex(i);
-            QString name = settings_->value("Name").toString();
-            provider_configs_[name] = settings_->value("Config").toMap();
-        }
-        settings_->endArray();
-        
-        // Load waveform configurations
-        int waveformCount = settings_->beginReadArray("Waveforms");
-        for (int i = 0; i < waveformCount; ++i) {
-            settings_->setArrayIndex(i);
-            int type = settings_->value("Type").toInt();
-            waveform_configs_[type] = settings_->value("Config").toMap();
-        }
-        settings_->endArray();
-        
-        // Load parameter configurations
-        int parameterCount = settings_->beginReadArray("Parameters");
-        for (int i = 0; i < parameterCount; ++i) {
-            settings_->setArrayIndex(i);
-            int type = settings_->value("Type").toInt();
-            parameter_configs_[type] = settings_->value("Config").toMap();
+    QMutexLocker settingsLocker(&settings_mutex_);
+    
+    // Create settings object
+    settings_ = std::make_unique<QSettings>(organization, application);
+    if (settings_->status() != QSettings::NoError) {
+        qCritical() << "Failed to initialize ConfigManager: cannot read" << settings_->fileName();
+        return false;
+    }
+    
+    auto snapshot = std::make_shared<Snapshot>();
+    
+    // Load the basic settings; the configuration arrays are read below
+    const QStringList keys = settings_->allKeys();
+    for (const QString& key : keys) {
+        const QString group = key.section('/', 0, 0);
+        if (group == ARRAY_PROVIDERS || group == ARRAY_WAVEFORMS || group == ARRAY_PARAMETERS) {
+            continue;
         }
-        settings_->endArray();
-        
-        return true;
+        snapshot->values.insert(key, settings_->value(key));
     }
-    catch (const std::exception& e) {
-        qCritical() << "Failed to initialize ConfigManager: " << e.what();
-        return false;
+    
+    // Load provider, waveform, and parameter configurations
+    readConfigArray(*settings_, ARRAY_PROVIDERS, "Name", snapshot->providerConfigs);
+    readConfigArray(*settings_, ARRAY_WAVEFORMS, "Type", snapshot->waveformConfigs);
+    readConfigArray(*settings_, ARRAY_PARAMETERS, "Type", snapshot->parameterConfigs);
+    
+    {
+        QMutexLocker locker(&mutex_);
+        snapshot_.store(std::move(snapshot), std::memory_order_release);
+        dirty_keys_.clear();
+        providers_dirty_ = false;
+        waveforms_dirty_ = false;
+        parameters_dirty_ = false;
+        clear_pending_ = false;
     }
+    
+    qAddPostRoutine([]() { ConfigManager::GetInstance().save(); });
+    return true;
 }
 
 /**
  * @brief Saves the current configuration to persistent storage
  * @return True if the save operation was successful, false otherwise
  * 
- * Writes all provider, waveform, and parameter configurations to persistent
- * storage using the QSettings framework. Updates the dirty flag to indicate
- * all changes have been saved.
+ * Writes the pending changes right away on the calling thread instead of
+ * waiting for the background flush.
  */
 bool ConfigManager::save()
 {
-    try {
-        // Save provider configurations
-        settings_->beginWriteArray("Providers", provider_configs_.size());
-        int index = 0;
-        for (auto it = provider_configs_.begin(); it != provider_configs_.end(); ++it, ++index) {
-            settings_->setArrayIndex(index);
-            settings_->setValue("Name", it.key());
-            settings_->setValue("Config", it.value());
-        }
-        settings_->endArray();
-        
-        // Save waveform configurations
-        settings_->beginWriteArray("Waveforms", waveform_configs_.size());
-        index = 0;
-        for (auto it = waveform_configs_.begin(); it != waveform_configs_.end(); ++it, ++index) {
-            settings_->setArrayIndex(index);
-            settings_->setValue("Type", it.key());
-            settings_->setValue("Config", it.value());
-        }
-        settings_->endArray();
-        
-        // Save parameter configurations
-        settings_->beginWriteArray("Parameters", parameter_configs_.size());
-        index = 0;
-        for (auto it = parameter_configs_.begin(); it != parameter_configs_.end(); ++it, ++index) {
-            settings_->setArrayIndex(index);
-            settings_->setValue("Type", it.key());
-            settings_->setValue("Config", it.value());
-        }
-        settings_->endArray();
-        
-        // Sync to disk
-        settings_->sync();
-        dirty_ = false;
-        
-        return true;
-    }
-    catch (const std::exception& e) {
-        qCritical() << "Failed to save ConfigManager: " << e.what();
-        return false;
-    }
+    return flush();
+}
+
+/**
+ * @brief Gets the current settings
+ * @return Snapshot of all settings, never null
+ */
+std::shared_ptr<const ConfigManager::Snapshot> ConfigManager::GetSnapshot() const
+{
+    return snapshot_.load(std::memory_order_acquire);
 }
 
 /**
@@ -189,17 +220,21 @@ bool ConfigManager::save()
  * 
  * Clears all existing configurations and sets default values for provider,
  * waveform, and parameter settings. Activates a subset of waveforms and parameters
- * by default. Emits the settingsChanged signal to notify listeners of the reset.
+ * by default. The store is cleared and rewritten by the next flush. Emits the
+ * settingsChanged signal to notify listeners of the reset.
  */
 void ConfigManager::resetToDefaults()
 {
-    // Clear all settings
-    settings_->clear();
-    
-    // Clear caches
-    provider_configs_.clear();
-    waveform_configs_.clear();
-    parameter_configs_.clear();
+    // Clear all settings and caches
+    {
+        QMutexLocker locker(&mutex_);
+        snapshot_.store(std::make_shared<const Snapshot>(), std::memory_order_release);
+        dirty_keys_.clear();
+        providers_dirty_ = true;
+        waveforms_dirty_ = true;
+        parameters_dirty_ = true;
+        clear_pending_ = true;
+    }
     
     // Set default values
     SetLastProvider(DEFAULT_PROVIDER);
@@ -208,7 +243,7 @@ void ConfigManager::resetToDefaults()
     SetDefaultBackgroundColor(DEFAULT_BG_COLOR);
     
     // Initialize default waveform configurations
-    for (int i = 0; i < 13; ++i) {
+    for (int i = 0; i < VitalSync::WAVEFORM_TYPE_COUNT; ++i) {
         VitalSync::WaveformType type = static_cast<VitalSync::WaveformType>(i);
         auto range = VitalSync::GetDefaultWaveformRange(type);
         
@@ -223,7 +258,7 @@ void ConfigManager::resetToDefaults()
     }
     
     // Initialize default parameter configurations
-    for (int i = 0; i < 18; ++i) {
+    for (int i = 0; i < VitalSync::PARAMETER_TYPE_COUNT; ++i) {
         VitalSync::ParameterType type = static_cast<VitalSync::ParameterType>(i);
         auto range = VitalSync::GetDefaultParameterRange(type);
         auto alarmLimits = VitalSync::GetDefaultAlarmLimits(type);
@@ -241,8 +276,7 @@ void ConfigManager::resetToDefaults()
         SetParameterConfig(type, config);
     }
     
-    // Set dirty flag and emit signals
-    dirty_ = true;
+    scheduleFlush();
     emit settingsChanged();
 }
 
@@ -257,7 +291,7 @@ void ConfigManager::resetToDefaults()
  */
 QString ConfigManager::GetString(const QString& key, const QString& defaultValue) const
 {
-    return settings_->value(key, defaultValue).toString();
+    return GetSnapshot()->values.value(key, defaultValue).toString();
 }
 
 /**
@@ -271,8 +305,7 @@ QString ConfigManager::GetString(const QString& key, const QString& defaultValue
 void ConfigManager::SetString(const QString& key, const QString& value)
 {
     if (GetString(key) != value) {
-        settings_->setValue(key, value);
-        dirty_ = true;
+        storeValue(key, value);
         emit settingsChanged();
     }
 }
@@ -288,7 +321,7 @@ void ConfigManager::SetString(const QString& key, const QString& value)
  */
 int ConfigManager::GetInt(const QString& key, int defaultValue) const
 {
-    return settings_->value(key, defaultValue).toInt();
+    return GetSnapshot()->values.value(key, defaultValue).toInt();
 }
 
 /**
@@ -302,8 +335,7 @@ int ConfigManager::GetInt(const QString& key, int defaultValue) const
 void ConfigManager::SetInt(const QString& key, int value)
 {
     if (GetInt(key) != value) {
-        settings_->setValue(key, value);
-        dirty_ = true;
+        storeValue(key, value);
         emit settingsChanged();
     }
 }
@@ -319,7 +351,7 @@ void ConfigManager::SetInt(const QString& key, int value)
  */
 double ConfigManager::GetDouble(const QString& key, double defaultValue) const
 {
-    return settings_->value(key, defaultValue).toDouble();
+    return GetSnapshot()->values.value(key, defaultValue).toDouble();
 }
 
 /**
@@ -333,8 +365,7 @@ double ConfigManager::GetDouble(const QString& key, double defaultValue) const
 void ConfigManager::SetDouble(const QString& key, double value)
 {
     if (GetDouble(key) != value) {
-        settings_->setValue(key, value);
-        dirty_ = true;
+        storeValue(key, value);
         emit settingsChanged();
     }
 }
@@ -350,7 +381,7 @@ void ConfigManager::SetDouble(const QString& key, double value)
  */
 bool ConfigManager::GetBool(const QString& key, bool defaultValue) const
 {
-    return settings_->value(key, defaultValue).toBool();
+    return GetSnapshot()->values.value(key, defaultValue).toBool();
 }
 
 /**
@@ -364,8 +395,7 @@ bool ConfigManager::GetBool(const QString& key, bool defaultValue) const
 void ConfigManager::SetBool(const QString& key, bool value)
 {
     if (GetBool(key) != value) {
-        settings_->setValue(key, value);
-        dirty_ = true;
+        storeValue(key, value);
         emit settingsChanged();
     }
 }
@@ -381,7 +411,7 @@ void ConfigManager::SetBool(const QString& key, bool value)
  */
 QColor ConfigManager::GetColor(const QString& key, const QColor& defaultValue) const
 {
-    return settings_->value(key, defaultValue).value<QColor>();
+    return GetSnapshot()->values.value(key, defaultValue).value<QColor>();
 }
 
 /**
@@ -395,8 +425,7 @@ QColor ConfigManager::GetColor(const QString& key, const QColor& defaultValue) c
 void ConfigManager::setColor(const QString& key, const QColor& value)
 {
     if (GetColor(key) != value) {
-        settings_->setValue(key, value);
-        dirty_ = true;
+        storeValue(key, value);
         emit settingsChanged();
     }
 }
@@ -411,7 +440,7 @@ void ConfigManager::setColor(const QString& key, const QColor& value)
  */
 QVariantMap ConfigManager::GetProviderConfig(const QString& providerName) const
 {
-    return provider_configs_.value(providerName, QVariantMap());
+    return GetSnapshot()->providerConfigs.value(providerName, QVariantMap());
 }
 
 /**
@@ -421,12 +450,25 @@ QVariantMap ConfigManager::GetProviderConfig(const QString& providerName) const
  * 
  * Stores the configuration map for the specified provider.
  * Sets the dirty flag and emits the providerConfigChanged and
- * settingsChanged signals.
+ * settingsChanged signals if the configuration changes.
  */
 void ConfigManager::SetProviderConfig(const QString& providerName, const QVariantMap& config)
 {
-    provider_configs_[providerName] = config;
-    dirty_ = true;
+    {
+        QMutexLocker locker(&mutex_);
+        const std::shared_ptr<const Snapshot> current = snapshot_.load(std::memory_order_acquire);
+        const auto it = current->providerConfigs.constFind(providerName);
+        if (it != current->providerConfigs.constEnd() && it.value() == config) {
+            return;
+        }
+        
+        auto snapshot = std::make_shared<Snapshot>(*current);
+        snapshot->providerConfigs.insert(providerName, config);
+        snapshot_.store(std::move(snapshot), std::memory_order_release);
+        providers_dirty_ = true;
+    }
+    
+    scheduleFlush();
     emit providerConfigChanged(providerName);
     emit settingsChanged();
 }
@@ -441,7 +483,7 @@ void ConfigManager::SetProviderConfig(const QString& providerName, const QVarian
  */
 QVariantMap ConfigManager::GetWaveformConfig(VitalSync::WaveformType waveformType) const
 {
-    return waveform_configs_.value(static_cast<int>(waveformType), QVariantMap());
+    return GetSnapshot()->waveformConfigs.value(static_cast<int>(waveformType), QVariantMap());
 }
 
 /**
@@ -451,12 +493,25 @@ QVariantMap ConfigManager::GetWaveformConfig(VitalSync::WaveformType waveformTyp
  * 
  * Stores the configuration map for the specified waveform type.
  * Sets the dirty flag and emits the waveformConfigChanged and
- * settingsChanged signals.
+ * settingsChanged signals if the configuration changes.
  */
 void ConfigManager::SetWaveformConfig(VitalSync::WaveformType waveformType, const QVariantMap& config)
 {
-    waveform_configs_[static_cast<int>(waveformType)] = config;
-    dirty_ = true;
+    {
+        QMutexLocker locker(&mutex_);
+        const std::shared_ptr<const Snapshot> current = snapshot_.load(std::memory_order_acquire);
+        const auto it = current->waveformConfigs.constFind(static_cast<int>(waveformType));
+        if (it != current->waveformConfigs.constEnd() && it.value() == config) {
+            return;
+        }
+        
+        auto snapshot = std::make_shared<Snapshot>(*current);
+        snapshot->waveformConfigs.insert(static_cast<int>(waveformType), config);
+        snapshot_.store(std::move(snapshot), std::memory_order_release);
+        waveforms_dirty_ = true;
+    }
+    
+    scheduleFlush();
     emit waveformConfigChanged(waveformType);
     emit settingsChanged();
 }
@@ -471,7 +526,7 @@ void ConfigManager::SetWaveformConfig(VitalSync::WaveformType waveformType, cons
  */
 QVariantMap ConfigManager::GetParameterConfig(VitalSync::ParameterType parameterType) const
 {
-    return parameter_configs_.value(static_cast<int>(parameterType), QVariantMap());
+    return GetSnapshot()->parameterConfigs.value(static_cast<int>(parameterType), QVariantMap());
 }
 
 /**
@@ -481,12 +536,25 @@ QVariantMap ConfigManager::GetParameterConfig(VitalSync::ParameterType parameter
  * 
  * Stores the configuration map for the specified parameter type.
  * Sets the dirty flag and emits the parameterConfigChanged and
- * settingsChanged signals.
+ * settingsChanged signals if the configuration changes.
  */
 void ConfigManager::SetParameterConfig(VitalSync::ParameterType parameterType, const QVariantMap& config)
 {
-    parameter_configs_[static_cast<int>(parameterType)] = config;
-    dirty_ = true;
+    {
+        QMutexLocker locker(&mutex_);
+        const std::shared_ptr<const Snapshot> current = snapshot_.load(std::memory_order_acquire);
+        const auto it = current->parameterConfigs.constFind(static_cast<int>(parameterType));
+        if (it != current->parameterConfigs.constEnd() && it.value() == config) {
+            return;
+        }
+        
+        auto snapshot = std::make_shared<Snapshot>(*current);
+        snapshot->parameterConfigs.insert(static_cast<int>(parameterType), config);
+        snapshot_.store(std::move(snapshot), std::memory_order_release);
+        parameters_dirty_ = true;
+    }
+    
+    scheduleFlush();
     emit parameterConfigChanged(parameterType);
     emit settingsChanged();
 }
@@ -585,4 +653,109 @@ QColor ConfigManager::GetDefaultBackgroundColor() const
 void ConfigManager::SetDefaultBackgroundColor(const QColor& color)
 {
     setColor(KEY_DEFAULT_BG_COLOR, color);
-} 
\ No newline at end of file
+}
+
+/**
+ * @brief Publishes a snapshot with one basic setting changed
+ * @param key Setting key
+ * @param value New value
+ *
+ * Copying the snapshot is cheap: the containers are implicitly shared and
+ * only the changed one is detached.
+ */
+void ConfigManager::storeValue(const QString& key, const QVariant& value)
+{
+    {
+        QMutexLocker locker(&mutex_);
+        auto snapshot = std::make_shared<Snapshot>(*snapshot_.load(std::memory_order_acquire));
+        snapshot->values.insert(key, value);
+        snapshot_.store(std::move(snapshot), std::memory_order_release);
+        dirty_keys_.insert(key);
+    }
+    
+    scheduleFlush();
+}
+
+/**
+ * @brief Makes sure a flush runs FLUSH_DELAY_MS from now
+ *
+ * Only the first change after a flush starts the timer; the changes that
+ * follow within the delay are written by the same flush.
+ */
+void ConfigManager::scheduleFlush()
+{
+    if (flush_scheduled_.exchange(true)) {
+        return;
+    }
+    
+    // The timer belongs to the thread the manager lives on
+    QMetaObject::invokeMethod(this, [this]() { flush_timer_.start(); }, Qt::QueuedConnection);
+}
+
+/**
+ * @brief Writes the dirty settings to persistent storage
+ * @return True if the store was written without error
+ *
+ * Takes the dirty state together with the snapshot it belongs to and writes
+ * only the changed keys and configuration sections, followed by one sync.
+ * Changes made while the flush runs stay dirty for the next one.
+ */
+bool ConfigManager::flush()
+{
+    QMutexLocker settingsLocker(&settings_mutex_);
+    if (!settings_) {
+        return false;
+    }
+    
+    std::shared_ptr<const Snapshot> snapshot;
+    QSet<QString> keys;
+    bool providers = false;
+    bool waveforms = false;
+    bool parameters = false;
+    bool clear = false;
+    {
+        QMutexLocker locker(&mutex_);
+        snapshot = snapshot_.load(std::memory_order_acquire);
+        keys.swap(dirty_keys_);
+        providers = std::exchange(providers_dirty_, false);
+        waveforms = std::exchange(waveforms_dirty_, false);
+        parameters = std::exchange(parameters_dirty_, false);
+        clear = std::exchange(clear_pending_, false);
+    }
+    
+    if (keys.isEmpty() && !providers && !waveforms && !parameters && !clear) {
+        return true;
+    }
+    
+    if (clear) {
+        settings_->clear();
+    }
+    
+    for (const QString& key : std::as_const(keys)) {
+        const auto it = snapshot->values.constFind(key);
+        if (it != snapshot->values.constEnd()) {
+            settings_->setValue(key, it.value());
+        } else {
+            settings_->remove(key);
+        }
+    }
+    
+    if (providers) {
+        writeConfigArray(*settings_, ARRAY_PROVIDERS, "Name", snapshot->providerConfigs);
+    }
+    if (waveforms) {
+        writeConfigArray(*settings_, ARRAY_WAVEFORMS, "Type", snapshot->waveformConfigs);
+    }
+    if (parameters) {
+        writeConfigArray(*settings_, ARRAY_PARAMETERS, "Type", snapshot->parameterConfigs);
+    }
+    
+    // Sync to disk
+    settings_->sync();
+    if (settings_->status() != QSettings::NoError) {
+        qCritical() << "Failed to save ConfigManager to" << settings_->fileName();
+        return false;
+    }
+    
+    return true;
+}
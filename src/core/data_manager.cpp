@@ -7,41 +7,102 @@
  * It manages data providers (sources of data), routes data to the appropriate models,
  * handles provider switching and configuration, and maintains the collection of
  * waveform and parameter models that represent the patient's physiological state.
+ *
+ * All providers are moved to a dedicated acquisition thread. Their data signals
+ * are connected directly, so frames are dispatched into the lock-free model
+ * buffers on that thread and never pass through the GUI event loop. Provider
+ * lifecycle calls are marshalled onto the acquisition thread and waited for.
  */
 #include "data_manager.h"
 #include "waveform_model.h"
 #include "parameter_model.h"
+#include "pulse_analyzer.h"
+#include "qrs_detector.h"
 #include "../providers/demo_data_provider.h"
+#include "../providers/network_data_provider.h"
+#include "../providers/file_data_provider.h"
 #include "../../include/config_manager.h"
+#include "../utils/log_categories.h"
+#include "../utils/metrics.h"
+#include "../utils/startup_profile.h"
+#include <QDateTime>
 #include <QDebug>
+#include <QMetaObject>
+#include <QVarLengthArray>
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+/**
+ * @namespace Anonymous namespace for constants
+ * @brief Contains the derived-parameter settings used by the DataManager implementation
+ */
+namespace {
+    const qint64 SOURCE_TIMEOUT_MS = 5000;          ///< Silence after which a less trusted source takes over a parameter
+    const float ABP_MIN_PULSE_MMHG = 5.0f;          ///< Smallest arterial pulse reported
+    const float PLETH_MIN_PULSE = 0.02f;            ///< Smallest plethysmographic pulse reported, in waveform units
+    const int PLETH_PRIORITY = 2;                   ///< Pulse rate from the pleth only stands in for the ECG rate
+}
 
 /**
  * @brief Constructs a DataManager instance
  * @param parent The parent QObject for memory management
  * 
- * Initializes an empty DataManager without any providers or models.
+ * Initializes an empty DataManager without any providers or models and starts
+ * the acquisition thread that will host the providers.
  * The initialize method must be called to set up providers and models.
  */
 DataManager::DataManager(QObject* parent)
+    : DataManager(QString(), parent)
+{
+}
+
+/**
+ * @brief Constructs a DataManager for one bed of a central station
+ * @param bedId Identifier of the bed, empty for the primary bed
+ * @param parent The parent QObject for memory management
+ * 
+ * Only the primary bed persists its provider selection, so that the beds of
+ * a central station do not overwrite the settings of the bedside view.
+ */
+DataManager::DataManager(const QString& bedId, QObject* parent)
     : IDataManager(parent)
+    , bed_id_(bedId)
+    , demo_data_(false)
+    , acquisition_thread_(new QThread(this))
+    , acquisition_context_(new QObject())
 {
+    // Allow frames to travel through queued connections
+    qRegisterMetaType<VitalSync::DataFrame>("VitalSync::DataFrame");
+    qRegisterMetaType<QVector<AlarmEvent>>("QVector<AlarmEvent>");
+    
+    acquisition_thread_->setObjectName(bed_id_.isEmpty() ? QString("VitalSyncAcquisition")
+                                                         : QString("VitalSyncAcquisition-%1").arg(bed_id_));
+    acquisition_context_->moveToThread(acquisition_thread_);
+    acquisition_thread_->start();
+    
+    parameter_sources_.fill(ParameterSource{ std::numeric_limits<int>::max(), 0 });
 }
 
 /**
  * @brief Destroys the DataManager instance
  * 
- * Stops any active data acquisition and disconnects provider signals
- * before destroying the manager.
+ * Stops any active data acquisition, disconnects provider signals and shuts
+ * down the acquisition thread before destroying the manager.
  */
 DataManager::~DataManager()
 {
     // Stop acquisition if active
     stopAcquisition();
+    StopRecording();
+    StopStreaming();
     
     // Disconnect current provider signals
     if (current_provider_) {
-        disconnectProviderSignals();
+        disconnectProviderSignals(current_provider_.get());
     }
+    
+    shutdownAcquisitionThread();
 }
 
 /**
@@ -50,13 +111,21 @@ DataManager::~DataManager()
  * 
  * Creates and registers data providers, initializes waveform and parameter models,
  * and attempts to restore the last used provider from configuration.
+ * 
+ * Only the waveform models that are needed right away are built here; the
+ * others are built when a view first asks for them. Nothing in here touches
+ * the GUI, so the beds of a central station can be initialized in parallel
+ * on pool threads and moved to the GUI thread afterwards.
  */
 bool DataManager::initialize()
 {
     try {
         // Initialize the available providers
-        auto demoProvider = std::make_shared<DemoDataProvider>(this);
-        registerProvider(demoProvider);
+        // Providers have no parent so they can be moved to the acquisition thread
+        createProviders();
+        
+        // Initialize the derived-parameter stages, whose inputs need models
+        initializeWaveformProcessors();
         
         // Initialize waveform models
         initializeWaveformModels();
@@ -64,8 +133,12 @@ bool DataManager::initialize()
         // Initialize parameter models
         initializeParameterModels();
         
-        // Set the default provider from configuration
+        // ECG filters are off unless a cutoff or mains frequency is configured
         auto& config = ConfigManager::GetInstance();
+        ecg_filters_.Configure(config.GetDouble("filters/ecgBaselineHz", 0.0),
+                               config.GetDouble("filters/ecgMainsHz", 0.0));
+        
+        // Set the default provider from configuration
         std::string lastProvider = config.GetLastProvider().toStdString();
         
         if (!lastProvider.empty()) {
@@ -83,6 +156,15 @@ bool DataManager::initialize()
     }
 }
 
+/**
+ * @brief Gets the identifier of the bed this manager serves
+ * @return Bed identifier, empty for the primary bed
+ */
+QString DataManager::GetBedId() const
+{
+    return bed_id_;
+}
+
 /**
  * @brief Starts data acquisition using the current provider
  * @return True if acquisition was successfully started, false otherwise
@@ -97,34 +179,37 @@ bool DataManager::initialize()
  */
 bool DataManager::startAcquisition()
 {
-    QMutexLocker locker(&mutex_);
+    QMutexLocker lifecycle(&lifecycle_mutex_);
     
     qDebug() << "DataManager: Starting data acquisition...";
     
-    if (!current_provider_) {
+    std::shared_ptr<IDataProvider> provider = GetCurrentProvider();
+    if (!provider) {
         qWarning() << "Cannot start acquisition: No active provider";
         emit errorOccurred(static_cast<int>(VitalSync::ErrorCode::ConfigurationError),
                         "Cannot start acquisition: No active provider");
         return false;
     }
     
-    // Check if the provider is already active
-    if (current_provider_->isActive()) {
-        qDebug() << "DataManager: Provider already active, restarting it";
-        current_provider_->stop();
-    }
-    
     // Force active state for all parameter models
-    for (auto& model : parameter_models_) {
+    for (auto& model : GetAllParameterModels()) {
         if (!model->isActive()) {
             qDebug() << "DataManager: Activating parameter model" << model->GetDisplayName();
             model->SetActive(true);
         }
     }
     
-    // Start the provider
-    qDebug() << "DataManager: Starting provider:" << QString::fromStdString(current_provider_->GetName());
-    bool success = current_provider_->start();
+    // Start the provider in its own thread
+    qDebug() << "DataManager: Starting provider:" << QString::fromStdString(provider->GetName());
+    bool success = false;
+    invokeOnProviderThread(provider.get(), [&provider, &success]() {
+        // Check if the provider is already active
+        if (provider->isActive()) {
+            qDebug() << "DataManager: Provider already active, restarting it";
+            provider->stop();
+        }
+        success = provider->start();
+    });
     
     if (success) {
         qDebug() << "DataManager: Provider started successfully";
@@ -143,10 +228,11 @@ bool DataManager::startAcquisition()
  */
 void DataManager::stopAcquisition()
 {
-    QMutexLocker locker(&mutex_);
+    QMutexLocker lifecycle(&lifecycle_mutex_);
     
-    if (current_provider_) {
-        current_provider_->stop();
+    std::shared_ptr<IDataProvider> provider = GetCurrentProvider();
+    if (provider) {
+        invokeOnProviderThread(provider.get(), [&provider]() { provider->stop(); });
     }
 }
 
@@ -193,42 +279,50 @@ std::shared_ptr<IDataProvider> DataManager::GetCurrentProvider() const
  */
 bool DataManager::SetActiveProvider(const std::string& providerName)
 {
-    QMutexLocker locker(&mutex_);
+    QMutexLocker lifecycle(&lifecycle_mutex_);
     
-    if (providerName == "" && current_provider_) {
-        // Deactivate current provider
-        disconnectProviderSignals();
-        current_provider_->stop();
-        current_provider_ = nullptr;
+    std::shared_ptr<IDataProvider> previous;
+    std::shared_ptr<IDataProvider> next;
+    {
+        QMutexLocker locker(&mutex_);
         
-        // Save the setting
-        saveCurrentProviderToSettings();
-        
-        // Emit signal to inform UI and other components about provider change
-        emit activeProviderChanged(providerName);
+        if (!providerName.empty() || !current_provider_) {
+            if (!providers_.contains(providerName)) {
+                qWarning() << "Unknown provider: " << QString::fromStdString(providerName);
+                return false;
+            }
+            next = providers_[providerName];
+        }
         
-        return true;
+        previous = current_provider_;
+        current_provider_ = next;
     }
     
-    if (!providers_.contains(providerName)) {
-        qWarning() << "Unknown provider: " << QString::fromStdString(providerName);
-        return false;
+    // First, stop and disconnect old provider. The manager lock is not held
+    // here because the provider thread may be waiting for it in HandleDataFrame.
+    if (previous) {
+        disconnectProviderSignals(previous.get());
+        invokeOnProviderThread(previous.get(), [&previous]() { previous->stop(); });
     }
     
-    // First, stop and disconnect old provider
-    if (current_provider_) {
-        disconnectProviderSignals();
-        current_provider_->stop();
-    }
+    // The new provider's signals start from scratch
+    resetWaveformProcessors();
     
-    // Activate new provider
-    current_provider_ = providers_[providerName];
-    
-    // Connect new provider signals
-    connectProviderSignals();
+    if (next) {
+        // Connect new provider signals
+        connectProviderSignals(next.get());
+        
+        // Save the provider name in configuration
+        if (bed_id_.isEmpty()) {
+            ConfigManager::GetInstance().SetLastProvider(QString::fromStdString(providerName));
+        }
+    } else {
+        // Save the setting
+        saveCurrentProviderToSettings();
+    }
     
-    // Save the provider name in configuration
-    ConfigManager::GetInstance().SetLastProvider(QString::fromStdString(providerName));
+    // Views draw the demo trace only while the demo provider simulates
+    updateDemoState();
     
     // Emit signal to inform UI and other components about provider change
     emit activeProviderChanged(providerName);
@@ -243,18 +337,168 @@ bool DataManager::SetActiveProvider(const std::string& providerName)
  * 
  * Passes configuration parameters to the current provider to
  * modify its behavior. The specific parameters depend on the
- * provider type.
+ * provider type. The provider is configured in its own thread.
  */
 bool DataManager::configureCurrentProvider(const QVariantMap& params)
 {
-    QMutexLocker locker(&mutex_);
+    QMutexLocker lifecycle(&lifecycle_mutex_);
     
-    if (!current_provider_) {
+    std::shared_ptr<IDataProvider> provider = GetCurrentProvider();
+    if (!provider) {
         qWarning() << "Cannot configure provider: No active provider";
         return false;
     }
     
-    return current_provider_->configure(params);
+    bool success = false;
+    invokeOnProviderThread(provider.get(), [&provider, &params, &success]() {
+        success = provider->configure(params);
+    });
+    
+    // The demo provider's load generator turns the simulation into a sampled stream
+    updateDemoState();
+    return success;
+}
+
+/**
+ * @brief Starts recording all ingested data to a file
+ * @param filePath Path of the recording to create
+ * @return True if the recording was created
+ * 
+ * The recorder is set up from the "recording/" settings, swapped in under
+ * the manager lock and published to the acquisition thread, which starts
+ * recording with the next frame it ingests. Recording only stages data and queues finished chunks;
+ * the recorder's own thread does the writing. A recording already in
+ * progress is closed first.
+ */
+bool DataManager::StartRecording(const QString& filePath)
+{
+    auto& config = ConfigManager::GetInstance();
+    auto recorder = std::make_shared<DataRecorder>(bed_id_);
+    recorder->SetChunkDuration(config.GetInt("recording/chunkDurationMs", 2000));
+    recorder->SetSyncInterval(config.GetInt("recording/syncIntervalMs", 1000));
+    recorder->SetCompression(config.GetBool("recording/compression", false));
+    recorder->SetQueueCapacity(config.GetInt("recording/queueBlocks", 16));
+    if (!recorder->Open(filePath)) {
+        emit errorOccurred(static_cast<int>(VitalSync::ErrorCode::DataError),
+                           tr("Cannot create recording %1.").arg(filePath));
+        return false;
+    }
+    
+    std::shared_ptr<DataRecorder> previous;
+    {
+        QMutexLocker locker(&mutex_);
+        previous = std::exchange(recorder_, recorder);
+    }
+    publishIngestTaps();
+    
+    if (previous) {
+        previous->Close();
+    }
+    return true;
+}
+
+/**
+ * @brief Stops recording and closes the recording file
+ * 
+ * The acquisition thread lets go of the recorder before it is closed, so
+ * data it is recording at this moment completes first.
+ */
+void DataManager::StopRecording()
+{
+    std::shared_ptr<DataRecorder> recorder;
+    {
+        QMutexLocker locker(&mutex_);
+        recorder = std::move(recorder_);
+        recorder_.reset();
+    }
+    publishIngestTaps();
+    
+    if (recorder) {
+        recorder->Close();
+    }
+}
+
+/**
+ * @brief Checks if ingested data is being recorded
+ * @return True if a recording is in progress
+ */
+bool DataManager::IsRecording() const
+{
+    QMutexLocker locker(&mutex_);
+    return recorder_ && recorder_->IsOpen();
+}
+
+/**
+ * @brief Starts serving ingested data to remote viewers
+ * @param port TCP port to listen on, 0 for any free port
+ * @return True if the server is listening
+ * 
+ * The server is set up from the "streaming/" settings and swapped in and
+ * published like the recorder. Publishing a frame only encodes it
+ * once and queues it for the viewers; the server's own thread does the
+ * writing. A stream already being served is stopped first.
+ */
+bool DataManager::StartStreaming(quint16 port)
+{
+    auto& config = ConfigManager::GetInstance();
+    auto server = std::make_shared<StreamServer>(bed_id_);
+    server->SetQueueCapacity(config.GetInt("streaming/queueFrames", 64));
+    server->SetMaxSubscribers(config.GetInt("streaming/maxSubscribers", 256));
+    server->SetEncoding(config.GetString("streaming/encoding", "int16") == "float16"
+                            ? NetworkFrameCodec::SampleEncoding::Float16
+                            : NetworkFrameCodec::SampleEncoding::Int16);
+    
+    // The previous server has to release the port first
+    StopStreaming();
+    if (!server->Open(port)) {
+        emit errorOccurred(static_cast<int>(VitalSync::ErrorCode::ConnectionError),
+                           tr("Cannot stream on port %1.").arg(port));
+        return false;
+    }
+    
+    std::shared_ptr<StreamServer> previous;
+    {
+        QMutexLocker locker(&mutex_);
+        previous = std::exchange(stream_server_, server);
+    }
+    publishIngestTaps();
+    
+    // Only set if another thread started streaming at the same time
+    if (previous) {
+        previous->Close();
+    }
+    return true;
+}
+
+/**
+ * @brief Stops serving and disconnects all viewers
+ * 
+ * The acquisition thread lets go of the server before it is closed, so a
+ * frame it is publishing at this moment completes first.
+ */
+void DataManager::StopStreaming()
+{
+    std::shared_ptr<StreamServer> server;
+    {
+        QMutexLocker locker(&mutex_);
+        server = std::move(stream_server_);
+        stream_server_.reset();
+    }
+    publishIngestTaps();
+    
+    if (server) {
+        server->Close();
+    }
+}
+
+/**
+ * @brief Checks if ingested data is being served
+ * @return True if the stream server is listening
+ */
+bool DataManager::IsStreaming() const
+{
+    QMutexLocker locker(&mutex_);
+    return stream_server_ && stream_server_->IsOpen();
 }
 
 /**
@@ -264,35 +508,30 @@ bool DataManager::configureCurrentProvider(const QVariantMap& params)
  * 
  * Retrieves a specific waveform model (ECG, respiration, etc.) by its
  * numeric identifier, which corresponds to a VitalSync::WaveformType value.
+ * A model that initialize() did not build is built now if the caller is on
+ * the manager's thread; other threads only get models that exist already.
  */
 std::shared_ptr<IWaveformModel> DataManager::GetWaveformModel(int waveformId) const
 {
-    QMutexLocker locker(&mutex_);
-    
-    if (waveform_models_.contains(waveformId)) {
-        return waveform_models_[waveformId];
+    if (!waveform_models_.Get(waveformId) && waveformId >= 0 && waveformId < VitalSync::WAVEFORM_TYPE_COUNT
+        && QThread::currentThread() == thread()) {
+        // Building a model on demand does not change what the manager reports
+        const_cast<DataManager*>(this)->createWaveformModel(static_cast<VitalSync::WaveformType>(waveformId));
     }
-    
-    return nullptr;
+    return waveform_models_.GetShared(waveformId);
 }
 
 /**
  * @brief Gets all available waveform models
  * @return Vector containing all waveform model pointers
  * 
- * Returns a collection of all waveform models managed by the
- * DataManager, regardless of their current state.
+ * Returns a collection of all waveform models the DataManager has built,
+ * regardless of their current state. Models that are built on demand only
+ * appear once GetWaveformModel() has been asked for them.
  */
 std::vector<std::shared_ptr<IWaveformModel>> DataManager::GetAllWaveformModels() const
 {
-    QMutexLocker locker(&mutex_);
-    
-    std::vector<std::shared_ptr<IWaveformModel>> result;
-    for (auto it = waveform_models_.begin(); it != waveform_models_.end(); ++it) {
-        result.push_back(it.value());
-    }
-    
-    return result;
+    return waveform_models_.GetAll();
 }
 
 /**
@@ -305,13 +544,7 @@ std::vector<std::shared_ptr<IWaveformModel>> DataManager::GetAllWaveformModels()
  */
 std::shared_ptr<IParameterModel> DataManager::GetParameterModel(int parameterId) const
 {
-    QMutexLocker locker(&mutex_);
-    
-    if (parameter_models_.contains(parameterId)) {
-        return parameter_models_[parameterId];
-    }
-    
-    return nullptr;
+    return parameter_models_.GetShared(parameterId);
 }
 
 /**
@@ -323,14 +556,79 @@ std::shared_ptr<IParameterModel> DataManager::GetParameterModel(int parameterId)
  */
 std::vector<std::shared_ptr<IParameterModel>> DataManager::GetAllParameterModels() const
 {
-    QMutexLocker locker(&mutex_);
+    return parameter_models_.GetAll();
+}
+
+/**
+ * @brief Sets the alarm limits of a parameter
+ * @param parameterId ID of the parameter
+ * @param lowCritical Low critical limit
+ * @param lowWarning Low warning limit
+ * @param highWarning High warning limit
+ * @param highCritical High critical limit
+ * @return True if the parameter exists
+ * 
+ * The model keeps the limits for its configuration, the alarm engine applies
+ * them from the next frame on. The engine belongs to the acquisition thread,
+ * so the limits are handed to it there.
+ */
+bool DataManager::SetAlarmLimits(int parameterId, float lowCritical, float lowWarning,
+                                 float highWarning, float highCritical)
+{
+    IParameterModel* model = parameter_models_.Get(parameterId);
+    if (!model) {
+        return false;
+    }
+    
+    model->SetAlarmLimits(lowCritical, lowWarning, highWarning, highCritical);
     
-    std::vector<std::shared_ptr<IParameterModel>> result;
-    for (auto it = parameter_models_.begin(); it != parameter_models_.end(); ++it) {
-        result.push_back(it.value());
+    runOnAcquisitionThread([this, parameterId, lowCritical, lowWarning, highWarning, highCritical]() {
+        alarm_engine_.SetLimits(parameterId, lowCritical, lowWarning, highWarning, highCritical);
+    });
+    return true;
+}
+
+/**
+ * @brief Adds a stage deriving parameters from a waveform
+ * @param processor Processor to run on every chunk of its waveform
+ * 
+ * Processors stay registered for the manager's lifetime. They run on the
+ * acquisition thread and may be registered while acquisition is running;
+ * the handlers pick them up from the next chunk on.
+ */
+void DataManager::RegisterWaveformProcessor(std::shared_ptr<WaveformProcessor> processor)
+{
+    if (!processor) {
+        return;
     }
     
-    return result;
+    {
+        QMutexLocker locker(&mutex_);
+        processors_.push_back(std::move(processor));
+    }
+    publishIngestTaps();
+}
+
+/**
+ * @brief Pins the acquisition thread and sets its scheduling priority
+ * @param options Processor affinity and real-time priority
+ * @return True if all options were applied
+ * 
+ * Affinity and priority can only be set by the thread itself, so the options
+ * are applied from a task run on the acquisition thread; the caller waits for
+ * it. They stay in effect for the manager's lifetime, across provider switches.
+ */
+bool DataManager::SetAcquisitionThreadTuning(const ThreadTuning::Options& options)
+{
+    if (options.IsEmpty() || !acquisition_thread_->isRunning()) {
+        return options.IsEmpty();
+    }
+    
+    bool success = false;
+    runOnAcquisitionThread([&options, &success]() {
+        success = ThreadTuning::ApplyToCurrentThread(options);
+    });
+    return success;
 }
 
 /**
@@ -340,17 +638,53 @@ std::vector<std::shared_ptr<IParameterModel>> DataManager::GetAllParameterModels
  * @param data Vector of floating-point values representing the waveform samples
  * 
  * This slot receives waveform data from the active provider and routes it
- * to the appropriate waveform model for processing and display.
+ * to the appropriate waveform model for processing and display. The model is
+ * an index into the registry and the recorder and processors come from the
+ * ingest taps, so nothing here takes a lock or a reference.
  */
 void DataManager::HandleWaveformData(int waveformType, qint64 timestamp, const QVector<float>& data)
 {
-    // Get the waveform model for this type
-    auto model = GetWaveformModel(waveformType);
+    // Get the waveform model and processors for this type
+    IWaveformModel* model = waveform_models_.Get(waveformType);
+    
+    DataRecorder* recorder = ingest_taps_.recorder;
+    if (recorder) {
+        recorder->RecordWaveform(waveformType, timestamp, data.constData(), static_cast<int>(data.size()),
+                                 model ? model->GetSampleRate() : 0.0);
+    }
     
     if (model && model->isActive()) {
+        const float* samples = data.constData();
+        const int count = static_cast<int>(data.size());
+        
+        // Filter ECG leads in the filter bank's block, leaving the recorded data untouched
+        const int lead = EcgFilterBank::GetLeadIndex(waveformType);
+        if (lead >= 0 && ecg_filters_.IsEnabled() && count > 0) {
+            float* filtered = ecg_filters_.GetLeadBlock(count);
+            std::copy_n(samples, count, filtered);
+            ecg_filters_.ProcessLead(lead, filtered, count, model->GetSampleRate());
+            samples = filtered;
+        }
+        
         // Update the model with the new data
-        model->addWaveformData(timestamp, data);
+        model->addWaveformData(timestamp, samples, count);
+        
+        const bool known = waveformType >= 0 && waveformType < VitalSync::WAVEFORM_TYPE_COUNT;
+        if (known && !ingest_taps_.processors[static_cast<size_t>(waveformType)].isEmpty()) {
+            const auto& processors = ingest_taps_.processors[static_cast<size_t>(waveformType)];
+            QVarLengthArray<VitalSync::FrameParameter, 16> monitored;
+            runWaveformProcessors(processors.constData(), static_cast<int>(processors.size()), timestamp,
+                                  samples, count, model->GetSampleRate(), monitored);
+            if (!monitored.isEmpty()) {
+                evaluateAlarms(timestamp, monitored.constData(), static_cast<int>(monitored.size()));
+            }
+        }
     }
+    
+    Metrics::Add(Metrics::Counter::FramesIngested);
+    Metrics::Add(Metrics::Counter::SamplesIngested, static_cast<quint64>(data.size()));
+    StartupProfile::MarkFirstFrame();
+    Metrics::Record(Metrics::Histogram::IngestLatency, Metrics::WallClock() - timestamp * 1000);
 }
 
 /**
@@ -365,23 +699,318 @@ void DataManager::HandleWaveformData(int waveformType, qint64 timestamp, const Q
 void DataManager::HandleParameterData(int parameterType, qint64 timestamp, float value)
 {
     // Get the parameter model for this type
-    auto model = GetParameterModel(parameterType);
+    IParameterModel* model = parameter_models_.Get(parameterType);
+    
+    DataRecorder* recorder = ingest_taps_.recorder;
+    if (recorder) {
+        recorder->RecordParameter(parameterType, timestamp, value);
+    }
     
     if (model && model->isActive()) {
-        // Debug output
-        qDebug() << "DataManager: Updating parameter" << model->GetDisplayName() 
-                 << "with value" << value << model->GetUnit()
-                 << "at timestamp" << QDateTime::fromMSecsSinceEpoch(timestamp).toString("hh:mm:ss.zzz");
+        VITALSYNC_TRACE(lcIngest) << "DataManager: Updating parameter" << model->GetDisplayName()
+                                  << "with value" << value << model->GetUnit()
+                                  << "at timestamp" << QDateTime::fromMSecsSinceEpoch(timestamp).toString("hh:mm:ss.zzz");
         
         // Update the model with the new value
+        claimParameterSource(parameterType, 0, timestamp);
         model->UpdateValue(timestamp, value);
+        
+        const VitalSync::FrameParameter parameter{parameterType, value};
+        evaluateAlarms(timestamp, &parameter, 1);
     } else if (model) {
-        qDebug() << "DataManager: Parameter" << model->GetDisplayName() << "is inactive, not updating";
+        VITALSYNC_TRACE(lcIngest) << "DataManager: Parameter" << model->GetDisplayName() << "is inactive, not updating";
     } else {
-        qDebug() << "DataManager: No model found for parameter type" << parameterType;
+        VITALSYNC_TRACE(lcIngest) << "DataManager: No model found for parameter type" << parameterType;
     }
 }
 
+/**
+ * @brief Handles a batched multi-channel frame from the active provider
+ * @param frame Waveform samples and parameter values of one acquisition tick
+ * 
+ * Resolves the target models of every channel and parameter in the frame by
+ * indexing the model registries and the channels' processors by indexing the
+ * ingest taps, then feeds each model straight from the frame's planar sample
+ * block. Models stay in the registries for the manager's whole lifetime and
+ * the taps only change between two frames, so the raw pointers stay valid
+ * during dispatch, which takes no lock and no reference.
+ * 
+ * While recording, the frame's sample block is handed to the recorder as is,
+ * before the models see it, and while streaming the frame is published to
+ * the remote viewers just as unchanged. ECG leads then pass the ECG filters, which
+ * work on a copy so the recording keeps the raw signal. Values derived by
+ * the waveform processors are
+ * shown and alarmed together with the frame's own values but not recorded,
+ * since replaying the recording derives them again.
+ */
+void DataManager::HandleDataFrame(const VitalSync::DataFrame& frame)
+{
+    QVarLengthArray<IWaveformModel*, 16> waveformTargets;
+    QVarLengthArray<IParameterModel*, 16> parameterTargets;
+    DataRecorder* recorder = ingest_taps_.recorder;
+    StreamServer* streamServer = ingest_taps_.stream_server;
+    
+    for (const VitalSync::FrameChannel& channel : frame.channels) {
+        IWaveformModel* model = waveform_models_.Get(channel.waveformId);
+        if (model && channel.sampleRate > 0.0f) {
+            // Before anything reads the rate, so filters and processors use the source's rate
+            static_cast<WaveformModel*>(model)->SetNominalSampleRate(channel.sampleRate);
+        }
+        waveformTargets.append(model);
+    }
+    for (const VitalSync::FrameParameter& parameter : frame.parameters) {
+        parameterTargets.append(parameter_models_.Get(parameter.parameterId));
+    }
+    
+    // Record the frame
+    if (recorder) {
+        for (int i = 0; i < frame.channels.size(); ++i) {
+            IWaveformModel* model = waveformTargets[i];
+            recorder->RecordWaveform(frame.channels[i].waveformId, frame.timestamp, frame.ChannelData(i),
+                                     frame.channels[i].count, model ? model->GetSampleRate() : 0.0);
+        }
+        for (const VitalSync::FrameParameter& parameter : frame.parameters) {
+            recorder->RecordParameter(parameter.parameterId, frame.timestamp, parameter.value);
+        }
+    }
+    
+    // Serve the frame to remote viewers, raw like the recording
+    if (streamServer) {
+        streamServer->Publish(frame);
+    }
+    
+    // Dispatch all parameter values first, so the provider keeps the parameters it measures
+    QVarLengthArray<VitalSync::FrameParameter, 16> monitored;
+    for (int i = 0; i < frame.parameters.size(); ++i) {
+        IParameterModel* model = parameterTargets[i];
+        if (model && model->isActive()) {
+            claimParameterSource(frame.parameters[i].parameterId, 0, frame.timestamp);
+            model->UpdateValue(frame.timestamp, frame.parameters[i].value);
+            monitored.append(frame.parameters[i]);
+        }
+    }
+    
+    // Filter the ECG leads
+    QVarLengthArray<const float*, 16> channelSamples;
+    for (int i = 0; i < frame.channels.size(); ++i) {
+        channelSamples.append(frame.ChannelData(i));
+    }
+    if (ecg_filters_.IsEnabled()) {
+        filterEcgLeads(frame, waveformTargets.constData(), channelSamples);
+    }
+    
+    // Dispatch all waveform channels and derive parameters from them
+    for (int i = 0; i < frame.channels.size(); ++i) {
+        IWaveformModel* model = waveformTargets[i];
+        if (model && model->isActive()) {
+            model->addWaveformData(frame.timestamp, channelSamples[i], frame.channels[i].count);
+            
+            // A model exists, so the waveform ID indexes the processor table
+            const auto& processors = ingest_taps_.processors[static_cast<size_t>(frame.channels[i].waveformId)];
+            if (!processors.isEmpty()) {
+                runWaveformProcessors(processors.constData(), static_cast<int>(processors.size()), frame.timestamp,
+                                      channelSamples[i], frame.channels[i].count, model->GetSampleRate(),
+                                      monitored);
+            }
+        }
+    }
+    
+    if (!monitored.isEmpty()) {
+        evaluateAlarms(frame.timestamp, monitored.constData(), static_cast<int>(monitored.size()));
+    }
+    
+    Metrics::Add(Metrics::Counter::FramesIngested);
+    Metrics::Add(Metrics::Counter::SamplesIngested, static_cast<quint64>(frame.samples.size()));
+    StartupProfile::MarkFirstFrame();
+    Metrics::Record(Metrics::Histogram::IngestLatency, Metrics::WallClock() - frame.timestamp * 1000);
+}
+
+/**
+ * @brief Filters the ECG leads of a frame into the filter bank's lead block
+ * @param frame Frame being ingested
+ * @param models Waveform model of each channel, null where there is none
+ * @param samples Sample pointer of each channel, redirected to the filtered leads
+ * 
+ * When the frame carries every lead with the same number of samples, as
+ * ECG front ends deliver them, all leads are filtered in one vectorized pass
+ * over the planar lead block. Otherwise each lead present is filtered on its
+ * own. Either way the frame itself is not modified.
+ */
+void DataManager::filterEcgLeads(const VitalSync::DataFrame& frame, IWaveformModel* const* models,
+                                 QVarLengthArray<const float*, 16>& samples)
+{
+    std::array<int, EcgFilterBank::LEAD_COUNT> leadChannels;
+    leadChannels.fill(-1);
+    int stride = 0;
+    for (int i = 0; i < frame.channels.size(); ++i) {
+        const int lead = EcgFilterBank::GetLeadIndex(frame.channels[i].waveformId);
+        if (lead >= 0 && models[i] && models[i]->isActive() && frame.channels[i].count > 0) {
+            leadChannels[static_cast<size_t>(lead)] = i;
+            stride = std::max(stride, frame.channels[i].count);
+        }
+    }
+    if (stride == 0) {
+        return;
+    }
+    
+    float* block = ecg_filters_.GetLeadBlock(stride);
+    bool aligned = true;
+    for (int lead = 0; lead < EcgFilterBank::LEAD_COUNT; ++lead) {
+        const int channel = leadChannels[static_cast<size_t>(lead)];
+        if (channel < 0) {
+            aligned = false;
+            continue;
+        }
+        float* row = block + static_cast<qsizetype>(lead) * stride;
+        std::copy_n(samples[channel], frame.channels[channel].count, row);
+        samples[channel] = row;
+        aligned = aligned && frame.channels[channel].count == stride;
+    }
+    
+    if (aligned) {
+        ecg_filters_.ProcessLeadBlock(stride, models[leadChannels[0]]->GetSampleRate());
+        return;
+    }
+    for (int lead = 0; lead < EcgFilterBank::LEAD_COUNT; ++lead) {
+        const int channel = leadChannels[static_cast<size_t>(lead)];
+        if (channel >= 0) {
+            ecg_filters_.ProcessLead(lead, block + static_cast<qsizetype>(lead) * stride,
+                                     frame.channels[channel].count, models[channel]->GetSampleRate());
+        }
+    }
+}
+
+/**
+ * @brief Runs the processors of a waveform chunk and dispatches the values they derive
+ * @param processors Processors registered for the waveform
+ * @param count Number of processors
+ * @param timestamp Chunk time in milliseconds since epoch
+ * @param samples Pointer to the samples
+ * @param sampleCount Number of samples
+ * @param sampleRate Measured sample rate of the waveform
+ * @param monitored Receives the dispatched values for alarm evaluation
+ * 
+ * Derived values only reach a parameter model while no more trusted source
+ * feeds that parameter.
+ */
+void DataManager::runWaveformProcessors(WaveformProcessor* const* processors, int count, qint64 timestamp,
+                                        const float* samples, int sampleCount, double sampleRate,
+                                        QVarLengthArray<VitalSync::FrameParameter, 16>& monitored)
+{
+    for (int i = 0; i < count; ++i) {
+        WaveformProcessor::Output derived;
+        processors[i]->Process(samples, sampleCount, sampleRate, derived);
+        if (derived.isEmpty()) {
+            continue;
+        }
+        
+        const int priority = processors[i]->GetPriority();
+        for (int j = 0; j < derived.size(); ++j) {
+            IParameterModel* model = parameter_models_.Get(derived[j].parameterId);
+            if (model && model->isActive() && claimParameterSource(derived[j].parameterId, priority, timestamp)) {
+                model->UpdateValue(timestamp, derived[j].value);
+                monitored.append(derived[j]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Decides whether a source may update a parameter
+ * @param parameterId ID of the parameter
+ * @param priority Priority of the source, 0 for the provider
+ * @param timestamp Time of the value in milliseconds since epoch
+ * @return True if the value is to be shown
+ * 
+ * A source takes over a parameter if it is at least as trusted as the
+ * current one, or if the current one has been silent for SOURCE_TIMEOUT_MS.
+ * Time running backwards, as when a replay restarts, also hands the
+ * parameter over. Only called on the acquisition thread.
+ */
+bool DataManager::claimParameterSource(int parameterId, int priority, qint64 timestamp)
+{
+    if (parameterId < 0 || parameterId >= AlarmEngine::PARAMETER_COUNT) {
+        return true;
+    }
+    
+    ParameterSource& source = parameter_sources_[static_cast<size_t>(parameterId)];
+    if (priority > source.priority && timestamp >= source.last_timestamp
+        && timestamp - source.last_timestamp < SOURCE_TIMEOUT_MS) {
+        return false;
+    }
+    
+    source.priority = priority;
+    source.last_timestamp = timestamp;
+    return true;
+}
+
+/**
+ * @brief Restarts all processors, ECG filters and alarms and forgets which source fed each parameter
+ * 
+ * Called while no provider is connected, so the acquisition thread does not
+ * touch the processors, the filters, the alarm engine, the source table or
+ * the models' timing concurrently. The waveform models forget the timestamps
+ * and sample rate of the previous provider. Alarms raised by the previous provider are cleared in the
+ * models as well and announced with one alarmsChanged(), so no stale alarm
+ * or delay timer carries over into the new session.
+ */
+void DataManager::resetWaveformProcessors()
+{
+    {
+        QMutexLocker locker(&mutex_);
+        for (const auto& processor : processors_) {
+            processor->Reset();
+        }
+    }
+    parameter_sources_.fill(ParameterSource{ std::numeric_limits<int>::max(), 0 });
+    ecg_filters_.Reset();
+    alarm_engine_.Reset();
+    for (const auto& model : waveform_models_.GetAll()) {
+        static_cast<WaveformModel*>(model.get())->ResetTiming();
+    }
+    
+    QVector<AlarmEvent> events;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (int id = 0; id < VitalSync::PARAMETER_TYPE_COUNT; ++id) {
+        IParameterModel* model = parameter_models_.Get(id);
+        if (!model || model->GetAlarmState() == IParameterModel::AlarmState::Normal) {
+            continue;
+        }
+        events.append(AlarmEvent{ id, model->GetAlarmState(), IParameterModel::AlarmState::Normal, model->GetValue(), now });
+        model->SetAlarmState(IParameterModel::AlarmState::Normal);
+    }
+    if (!events.isEmpty()) {
+        emit alarmsChanged(events);
+    }
+}
+
+/**
+ * @brief Evaluates alarms for the values of one frame and publishes the changes
+ * @param timestamp Frame time in milliseconds since epoch
+ * @param parameters Values of the monitored parameters
+ * @param count Number of values
+ * 
+ * The engine belongs to the acquisition thread and runs without a lock.
+ * The new states are stored in the models whose state changed, and all
+ * changes of the frame are announced with a single alarmsChanged()
+ * emission. Frames without changes emit nothing.
+ */
+void DataManager::evaluateAlarms(qint64 timestamp, const VitalSync::FrameParameter* parameters, int count)
+{
+    QVector<AlarmEvent> events;
+    if (alarm_engine_.Evaluate(timestamp, parameters, count, events) == 0) {
+        return;
+    }
+    
+    for (const AlarmEvent& event : events) {
+        if (IParameterModel* model = parameter_models_.Get(event.parameterId)) {
+            model->SetAlarmState(event.state);
+        }
+    }
+    
+    emit alarmsChanged(events);
+}
+
 /**
  * @brief Handles connection status changes from the active provider
  * @param status The new connection status
@@ -413,8 +1042,9 @@ void DataManager::HandleProviderError(int errorCode, const QString& errorMessage
  * @brief Registers a data provider in the providers collection
  * @param provider Shared pointer to the provider instance to register
  * 
- * Adds the provided data provider to the providers_ map, indexed by its name.
- * This makes the provider available for use in the application.
+ * Adds the provided data provider to the providers_ map, indexed by its name,
+ * and moves it to the acquisition thread. This makes the provider available
+ * for use in the application. The provider must not have a parent.
  */
 void DataManager::registerProvider(std::shared_ptr<IDataProvider> provider)
 {
@@ -422,26 +1052,81 @@ void DataManager::registerProvider(std::shared_ptr<IDataProvider> provider)
         return;
     }
     
+    provider->moveToThread(acquisition_thread_);
+    
     std::string name = provider->GetName();
-    providers_[name] = provider;
+    {
+        QMutexLocker locker(&mutex_);
+        providers_[name] = provider;
+    }
     
     qDebug() << "Registered provider: " << QString::fromStdString(name);
 }
 
 /**
- * @brief Initializes waveform models for all supported waveform types
+ * @brief Initializes the waveform models needed from the start
  * 
- * Creates a WaveformModel instance for each supported waveform type
- * (ECG, respiration, etc.) and stores it in the waveform_models_ map
- * indexed by its numeric type identifier.
+ * Creates a WaveformModel instance for each waveform type that feeds a
+ * derived-parameter stage and, for the primary bed, each type configured
+ * active, and stores it in the waveform_models_ registry at its numeric type
+ * identifier. Ingest skips channels without a model, so the models of the
+ * other types, with their buffers, are only built once a view asks for them.
+ * A bed of a central station thus only pays for the waveforms its tile shows.
  */
 void DataManager::initializeWaveformModels()
 {
-    // Create models for all waveform types
-    for (int i = 0; i < 13; ++i) {
-        VitalSync::WaveformType type = static_cast<VitalSync::WaveformType>(i);
+    std::array<bool, VitalSync::WAVEFORM_TYPE_COUNT> needed = {};
+    {
+        QMutexLocker locker(&mutex_);
+        for (const auto& processor : processors_) {
+            const int id = processor->GetWaveformId();
+            if (id >= 0 && id < VitalSync::WAVEFORM_TYPE_COUNT) {
+                needed[id] = true;
+            }
+        }
+    }
+    
+    auto& config = ConfigManager::GetInstance();
+    for (VitalSync::WaveformType type : VitalSync::WAVEFORM_TYPES) {
+        const int id = static_cast<int>(type);
+        if (needed[id] || (bed_id_.isEmpty() && config.GetWaveformConfig(type).value("active", false).toBool())) {
+            createWaveformModel(type);
+        }
+    }
+}
+
+/**
+ * @brief Creates the waveform model of a type if it does not exist yet
+ * @param type Waveform type
+ * 
+ * Registry slots are filled only once, so an existing model is kept. Models
+ * are only created on the manager's thread, which keeps the registry's
+ * writes on one thread at a time.
+ */
+void DataManager::createWaveformModel(VitalSync::WaveformType type)
+{
+    const int id = static_cast<int>(type);
+    if (!waveform_models_.Get(id)) {
         auto model = std::make_shared<WaveformModel>(type, this);
-        waveform_models_[i] = model;
+        model->SetIsDemo(demo_data_);
+        waveform_models_.Add(id, model);
+    }
+}
+
+/**
+ * @brief Marks the waveform models as demo data while the active provider only simulates
+ * 
+ * Views draw their synthesized demo trace for demo models and render the
+ * ingested samples for all others, so every model follows the provider
+ * whenever it changes. Models built later take the state from demo_data_.
+ */
+void DataManager::updateDemoState()
+{
+    std::shared_ptr<IDataProvider> provider = GetCurrentProvider();
+    demo_data_ = provider && provider->IsDemo();
+    
+    for (const auto& model : waveform_models_.GetAll()) {
+        static_cast<WaveformModel*>(model.get())->SetIsDemo(demo_data_);
     }
 }
 
@@ -450,73 +1135,242 @@ void DataManager::initializeWaveformModels()
  * 
  * Creates a ParameterModel instance for each supported parameter type
  * (heart rate, blood pressure, etc.) and stores it in the parameter_models_
- * map indexed by its numeric type identifier.
+ * registry at its numeric type identifier, then loads the alarm engine with
+ * the models' limits. Existing models are kept, as for the waveform models.
  */
 void DataManager::initializeParameterModels()
 {
     // Create models for all parameter types
-    for (int i = 0; i < 18; ++i) {
-        VitalSync::ParameterType type = static_cast<VitalSync::ParameterType>(i);
-        auto model = std::make_shared<ParameterModel>(type, this);
-        parameter_models_[i] = model;
+    for (VitalSync::ParameterType type : VitalSync::PARAMETER_TYPES) {
+        const int id = static_cast<int>(type);
+        if (!parameter_models_.Get(id)) {
+            parameter_models_.Add(id, std::make_shared<ParameterModel>(type, this));
+        }
     }
+    
+    // Evaluate the limits each model was configured with, and the optional
+    // per-parameter delay and hysteresis from the "alarms/" settings, in the
+    // engine on the acquisition thread
+    runOnAcquisitionThread([this]() {
+        auto& config = ConfigManager::GetInstance();
+        for (int i = 0; i < AlarmEngine::PARAMETER_COUNT; ++i) {
+            IParameterModel* model = parameter_models_.Get(i);
+            if (!model) {
+                continue;
+            }
+            const auto [lowCritical, lowWarning, highWarning, highCritical] = model->GetAlarmLimits();
+            alarm_engine_.SetLimits(i, lowCritical, lowWarning, highWarning, highCritical);
+            alarm_engine_.SetDelay(i, config.GetInt(QString("alarms/%1/delayMs").arg(i), 0));
+            
+            const double hysteresis = config.GetDouble(QString("alarms/%1/hysteresis").arg(i), -1.0);
+            if (hysteresis >= 0.0) {
+                alarm_engine_.SetHysteresis(i, static_cast<float>(hysteresis));
+            }
+        }
+    });
 }
 
 /**
- * @brief Connects signals from the current provider to data manager slots
+ * @brief Registers the default derived-parameter stages enabled in the settings
  * 
- * Establishes signal-slot connections between the current data provider
- * and the DataManager to enable data flow from the provider to the models.
- * This includes connections for waveform data, parameter data, connection
- * status updates, and error reports.
+ * With "derivedParameters/enabled" set, which is the default, ECG lead II
+ * yields the heart rate, the arterial pressure waveform the IBP1 pressures,
+ * and the plethysmogram a pulse rate that stands in for the heart rate when
+ * no ECG is available. "derivedParameters/abpScale" converts ABP samples to
+ * mmHg for sources that deliver them in other units.
  */
-void DataManager::connectProviderSignals()
+void DataManager::initializeWaveformProcessors()
 {
-    if (!current_provider_) {
+    auto& config = ConfigManager::GetInstance();
+    if (!config.GetBool("derivedParameters/enabled", true)) {
+        return;
+    }
+    
+    RegisterWaveformProcessor(std::make_shared<QrsDetector>(
+        static_cast<int>(VitalSync::WaveformType::ECG_II), static_cast<int>(VitalSync::ParameterType::HR)));
+    
+    PulseAnalyzer::Outputs pressure;
+    pressure.maximum = static_cast<int>(VitalSync::ParameterType::IBP1_SYS);
+    pressure.minimum = static_cast<int>(VitalSync::ParameterType::IBP1_DIA);
+    pressure.mean = static_cast<int>(VitalSync::ParameterType::IBP1_MAP);
+    const float abpScale = static_cast<float>(config.GetDouble("derivedParameters/abpScale", 1.0));
+    RegisterWaveformProcessor(std::make_shared<PulseAnalyzer>(
+        static_cast<int>(VitalSync::WaveformType::ABP), 1, pressure, abpScale, ABP_MIN_PULSE_MMHG));
+    
+    PulseAnalyzer::Outputs pulse;
+    pulse.rate = static_cast<int>(VitalSync::ParameterType::HR);
+    RegisterWaveformProcessor(std::make_shared<PulseAnalyzer>(
+        static_cast<int>(VitalSync::WaveformType::PLETH), PLETH_PRIORITY, pulse, 1.0f, PLETH_MIN_PULSE));
+}
+
+/**
+ * @brief Connects signals from a provider to data manager slots
+ * @param provider Provider to connect
+ * 
+ * Establishes signal-slot connections between a data provider and the
+ * DataManager to enable data flow from the provider to the models.
+ * This includes connections for per-channel waveform data, parameter data,
+ * batched data frames, connection status updates, and error reports.
+ * 
+ * Data signals use direct connections, so they are handled in the acquisition
+ * thread that emits them. Status and error signals keep the automatic
+ * connection type and are therefore delivered in the manager's (GUI) thread.
+ */
+void DataManager::connectProviderSignals(IDataProvider* provider)
+{
+    if (!provider) {
         return;
     }
     
     // Connect signals from provider to data manager slots
-    connect(current_provider_.get(), &IDataProvider::waveformDataReceived,
-            this, &DataManager::HandleWaveformData);
+    connect(provider, &IDataProvider::waveformDataReceived,
+            this, &DataManager::HandleWaveformData, Qt::DirectConnection);
+    
+    connect(provider, &IDataProvider::parameterDataReceived,
+            this, &DataManager::HandleParameterData, Qt::DirectConnection);
     
-    connect(current_provider_.get(), &IDataProvider::parameterDataReceived,
-            this, &DataManager::HandleParameterData);
+    connect(provider, &IDataProvider::dataFrameReceived,
+            this, &DataManager::HandleDataFrame, Qt::DirectConnection);
     
-    connect(current_provider_.get(), &IDataProvider::connectionStatusChanged,
+    connect(provider, &IDataProvider::connectionStatusChanged,
             this, &DataManager::HandleConnectionStatusChanged);
     
-    connect(current_provider_.get(), &IDataProvider::errorOccurred,
+    connect(provider, &IDataProvider::errorOccurred,
             this, &DataManager::HandleProviderError);
 }
 
 /**
- * @brief Disconnects signals from the current provider
+ * @brief Disconnects signals from a provider
+ * @param provider Provider to disconnect
  * 
- * Removes signal-slot connections between the current data provider and
- * the DataManager. This is called when changing providers or shutting down
+ * Removes signal-slot connections between a data provider and the
+ * DataManager. This is called when changing providers or shutting down
  * to prevent dangling signal connections.
  */
-void DataManager::disconnectProviderSignals()
+void DataManager::disconnectProviderSignals(IDataProvider* provider)
 {
-    if (!current_provider_) {
+    if (!provider) {
         return;
     }
     
     // Disconnect signals from provider to data manager slots
-    disconnect(current_provider_.get(), &IDataProvider::waveformDataReceived,
+    disconnect(provider, &IDataProvider::waveformDataReceived,
                this, &DataManager::HandleWaveformData);
     
-    disconnect(current_provider_.get(), &IDataProvider::parameterDataReceived,
+    disconnect(provider, &IDataProvider::parameterDataReceived,
                this, &DataManager::HandleParameterData);
     
-    disconnect(current_provider_.get(), &IDataProvider::connectionStatusChanged,
+    disconnect(provider, &IDataProvider::dataFrameReceived,
+               this, &DataManager::HandleDataFrame);
+    
+    disconnect(provider, &IDataProvider::connectionStatusChanged,
                this, &DataManager::HandleConnectionStatusChanged);
     
-    disconnect(current_provider_.get(), &IDataProvider::errorOccurred,
+    disconnect(provider, &IDataProvider::errorOccurred,
                this, &DataManager::HandleProviderError);
 }
 
+/**
+ * @brief Runs a task in the thread that owns a provider
+ * @param provider Provider whose thread runs the task
+ * @param task Task to run
+ * 
+ * Providers own timers and sockets that may only be touched from their own
+ * thread. The task runs immediately if the caller already is in that thread
+ * or the thread is not running; otherwise the caller blocks until the
+ * acquisition thread has executed it. Callers must not hold mutex_.
+ */
+void DataManager::invokeOnProviderThread(IDataProvider* provider, const std::function<void()>& task)
+{
+    if (!provider || !task) {
+        return;
+    }
+    
+    QThread* providerThread = provider->thread();
+    if (providerThread == QThread::currentThread() || !providerThread || !providerThread->isRunning()) {
+        task();
+        return;
+    }
+    
+    QMetaObject::invokeMethod(provider, task, Qt::BlockingQueuedConnection);
+}
+
+/**
+ * @brief Runs a task on the acquisition thread and waits for it
+ * @param task Task to run
+ * 
+ * State that only the acquisition thread reads, such as the ingest taps and
+ * the alarm engine, is changed through here, between two frames. The task
+ * runs immediately if the caller already is on the acquisition thread or the
+ * thread is not running. Callers must not hold mutex_.
+ */
+void DataManager::runOnAcquisitionThread(const std::function<void()>& task)
+{
+    if (QThread::currentThread() == acquisition_thread_ || !acquisition_thread_->isRunning()) {
+        task();
+        return;
+    }
+    
+    QMetaObject::invokeMethod(acquisition_context_, task, Qt::BlockingQueuedConnection);
+}
+
+/**
+ * @brief Publishes the current recorder, stream server and processors to the handlers
+ * 
+ * Builds new taps from the members under mutex_ and swaps them in on the
+ * acquisition thread. Once this returns, the handlers no longer use a
+ * recorder or server that was removed before the call, so it may be closed.
+ * Publishing is serialized, so the taps always end up matching the members.
+ */
+void DataManager::publishIngestTaps()
+{
+    QMutexLocker publishing(&taps_mutex_);
+    
+    IngestTaps taps;
+    {
+        QMutexLocker locker(&mutex_);
+        taps.recorder = recorder_.get();
+        taps.stream_server = stream_server_.get();
+        for (const auto& processor : processors_) {
+            const int id = processor->GetWaveformId();
+            if (id >= 0 && id < VitalSync::WAVEFORM_TYPE_COUNT) {
+                taps.processors[static_cast<size_t>(id)].append(processor.get());
+            }
+        }
+    }
+    
+    runOnAcquisitionThread([this, &taps]() { ingest_taps_ = std::move(taps); });
+}
+
+/**
+ * @brief Moves all providers back to this thread and stops the acquisition thread
+ * 
+ * Providers are handed back before the thread exits so that their timers are
+ * destroyed in a thread that is still able to process them.
+ */
+void DataManager::shutdownAcquisitionThread()
+{
+    QVector<std::shared_ptr<IDataProvider>> providers;
+    {
+        QMutexLocker locker(&mutex_);
+        for (const auto& provider : providers_) {
+            providers.append(provider);
+        }
+    }
+    
+    QThread* ownerThread = thread();
+    for (const auto& provider : providers) {
+        invokeOnProviderThread(provider.get(), [&provider, ownerThread]() {
+            provider->moveToThread(ownerThread);
+        });
+    }
+    
+    acquisition_thread_->quit();
+    acquisition_thread_->wait();
+    delete acquisition_context_;
+    acquisition_context_ = nullptr;
+}
+
 /**
  * @brief Creates and initializes data providers
  * 
@@ -531,22 +1385,21 @@ void DataManager::createProviders()
     registerProvider(demoProvider);
     
     // Create the network provider
-    // TODO: Implement NetworkDataProvider
-    // auto networkProvider = std::make_shared<NetworkDataProvider>();
-    // registerProvider(networkProvider);
+    auto networkProvider = std::make_shared<NetworkDataProvider>();
+    registerProvider(networkProvider);
     
     // Create the file provider
-    // TODO: Implement FileDataProvider
-    // auto fileProvider = std::make_shared<FileDataProvider>();
-    // registerProvider(fileProvider);
+    auto fileProvider = std::make_shared<FileDataProvider>();
+    registerProvider(fileProvider);
 }
 
 /**
  * @brief Creates and initializes waveform and parameter models
  * 
- * Instantiates models for all supported waveforms (ECG, respiration, etc.) and
- * physiological parameters (heart rate, blood pressure, etc.). These models
- * will be updated with data from the active provider during acquisition.
+ * Instantiates the waveform models needed from the start (ECG, respiration,
+ * etc.) and the models of all physiological parameters (heart rate, blood
+ * pressure, etc.). These models will be updated with data from the active
+ * provider during acquisition.
  */
 void DataManager::createModels()
 {
@@ -564,7 +1417,7 @@ void DataManager::createModels()
  */
 void DataManager::saveCurrentProviderToSettings()
 {
-    if (current_provider_) {
+    if (current_provider_ && bed_id_.isEmpty()) {
         ConfigManager::GetInstance().SetLastProvider(
             QString::fromStdString(current_provider_->GetName()));
     }
@@ -8,18 +8,36 @@
  * data), waveform models (for ECG, respiration, etc.), and parameter models
  * (for heart rate, blood pressure, etc.). It handles data routing between
  * providers and models, and provides access to all data models for the UI layer.
+ * Providers live on a dedicated acquisition thread, so generating, receiving
+ * and ingesting data never competes with painting on the GUI thread.
+ *
+ * One DataManager holds the provider and models of one bed. A central station
+ * runs several of them side by side through the BedManager; since every bed
+ * has its own thread, models and locks, the beds never contend with each other.
  */
 #ifndef DATA_MANAGER_H
 #define DATA_MANAGER_H
 
 #include "../../include/i_data_manager.h"
 #include "../../include/i_data_provider.h"
+#include "../../include/data_frame.h"
 #include "../../include/i_waveform_model.h"
 #include "../../include/i_parameter_model.h"
 #include "../../include/vital_sync_types.h"
+#include "alarm_engine.h"
+#include "data_recorder.h"
+#include "ecg_filter_bank.h"
+#include "model_registry.h"
+#include "stream_server.h"
+#include "waveform_processor.h"
+#include "../utils/thread_tuning.h"
 #include <QObject>
 #include <QMap>
 #include <QMutex>
+#include <QThread>
+#include <QVarLengthArray>
+#include <array>
+#include <functional>
 #include <memory>
 #include <vector>
 #include <string>
@@ -40,6 +58,13 @@ public:
      */
     explicit DataManager(QObject* parent = nullptr);
 
+    /**
+     * @brief Constructor for one bed of a central station
+     * @param bedId Identifier of the bed, empty for the primary bed
+     * @param parent Parent QObject
+     */
+    explicit DataManager(const QString& bedId, QObject* parent = nullptr);
+
     /**
      * @brief Destructor
      */
@@ -51,6 +76,12 @@ public:
      */
     bool initialize() override;
 
+    /**
+     * @brief Get the identifier of the bed this manager serves
+     * @return Bed identifier, empty for the primary bed
+     */
+    QString GetBedId() const;
+
     /**
      * @brief Start data acquisition using the current provider
      * @return True if successfully started
@@ -89,14 +120,50 @@ public:
     bool configureCurrentProvider(const QVariantMap& params) override;
 
     /**
-     * @brief Get a waveform model by ID
+     * @brief Start recording all ingested data to a file
+     * @param filePath Path of the recording to create
+     * @return True if the recording was created
+     */
+    bool StartRecording(const QString& filePath) override;
+
+    /**
+     * @brief Stop recording and close the recording file
+     */
+    void StopRecording() override;
+
+    /**
+     * @brief Check if ingested data is being recorded
+     * @return True if a recording is in progress
+     */
+    bool IsRecording() const override;
+
+    /**
+     * @brief Start serving ingested data to remote viewers
+     * @param port TCP port to listen on, 0 for any free port
+     * @return True if the server is listening
+     */
+    bool StartStreaming(quint16 port) override;
+
+    /**
+     * @brief Stop serving and disconnect all viewers
+     */
+    void StopStreaming() override;
+
+    /**
+     * @brief Check if ingested data is being served
+     * @return True if the stream server is listening
+     */
+    bool IsStreaming() const override;
+
+    /**
+     * @brief Get a waveform model by ID, building it on first use
      * @param waveformId ID of the waveform model to retrieve
      * @return Shared pointer to the waveform model or nullptr if not found
      */
     std::shared_ptr<IWaveformModel> GetWaveformModel(int waveformId) const override;
 
     /**
-     * @brief Get all available waveform models
+     * @brief Get all waveform models built so far
      * @return Vector of waveform model pointers
      */
     std::vector<std::shared_ptr<IWaveformModel>> GetAllWaveformModels() const override;
@@ -114,6 +181,31 @@ public:
      */
     std::vector<std::shared_ptr<IParameterModel>> GetAllParameterModels() const override;
 
+    /**
+     * @brief Set the alarm limits of a parameter
+     * @param parameterId ID of the parameter
+     * @param lowCritical Low critical limit
+     * @param lowWarning Low warning limit
+     * @param highWarning High warning limit
+     * @param highCritical High critical limit
+     * @return True if the parameter exists
+     */
+    bool SetAlarmLimits(int parameterId, float lowCritical, float lowWarning,
+                        float highWarning, float highCritical) override;
+
+    /**
+     * @brief Add a stage deriving parameters from a waveform
+     * @param processor Processor to run on every chunk of its waveform
+     */
+    void RegisterWaveformProcessor(std::shared_ptr<WaveformProcessor> processor);
+
+    /**
+     * @brief Pin the acquisition thread and set its scheduling priority
+     * @param options Processor affinity and real-time priority
+     * @return True if all options were applied
+     */
+    bool SetAcquisitionThreadTuning(const ThreadTuning::Options& options);
+
 private slots:
     /**
      * @brief Handle waveform data received from a provider
@@ -130,6 +222,12 @@ private slots:
      * @param value Parameter value
      */
     void HandleParameterData(int parameterType, qint64 timestamp, float value);
+    
+    /**
+     * @brief Handle a batched multi-channel frame received from a provider
+     * @param frame Waveform samples and parameter values of one acquisition tick
+     */
+    void HandleDataFrame(const VitalSync::DataFrame& frame);
 
     /**
      * @brief Handle provider connection status changes
@@ -152,24 +250,110 @@ private:
     void registerProvider(std::shared_ptr<IDataProvider> provider);
 
     /**
-     * @brief Initialize waveform models
+     * @brief Initialize the waveform models needed from the start
      */
     void initializeWaveformModels();
 
+    /**
+     * @brief Create the waveform model of a type if it does not exist yet
+     * @param type Waveform type
+     */
+    void createWaveformModel(VitalSync::WaveformType type);
+
+    /**
+     * @brief Mark the waveform models as demo data while the active provider only simulates
+     */
+    void updateDemoState();
+
     /**
      * @brief Initialize parameter models
      */
     void initializeParameterModels();
 
     /**
-     * @brief Connect signals from the current provider to the data manager slots
+     * @brief Register the default derived-parameter stages enabled in the settings
+     */
+    void initializeWaveformProcessors();
+
+    /**
+     * @brief Filter the ECG leads of a frame into the filter bank's lead block
+     * @param frame Frame being ingested
+     * @param models Waveform model of each channel, null where there is none
+     * @param samples Sample pointer of each channel, redirected to the filtered leads
      */
-    void connectProviderSignals();
+    void filterEcgLeads(const VitalSync::DataFrame& frame, IWaveformModel* const* models,
+                        QVarLengthArray<const float*, 16>& samples);
 
     /**
-     * @brief Disconnect signals from the current provider to the data manager slots
+     * @brief Run the processors of a waveform chunk and dispatch the values they derive
+     * @param processors Processors registered for the waveform
+     * @param count Number of processors
+     * @param timestamp Chunk time in milliseconds since epoch
+     * @param samples Pointer to the samples
+     * @param sampleCount Number of samples
+     * @param sampleRate Measured sample rate of the waveform
+     * @param monitored Receives the dispatched values for alarm evaluation
      */
-    void disconnectProviderSignals();
+    void runWaveformProcessors(WaveformProcessor* const* processors, int count, qint64 timestamp,
+                               const float* samples, int sampleCount, double sampleRate,
+                               QVarLengthArray<VitalSync::FrameParameter, 16>& monitored);
+
+    /**
+     * @brief Decide whether a source may update a parameter
+     * @param parameterId ID of the parameter
+     * @param priority Priority of the source, 0 for the provider
+     * @param timestamp Time of the value in milliseconds since epoch
+     * @return True if the value is to be shown
+     */
+    bool claimParameterSource(int parameterId, int priority, qint64 timestamp);
+
+    /**
+     * @brief Restart all processors, ECG filters and alarms and forget which source fed each parameter
+     */
+    void resetWaveformProcessors();
+
+    /**
+     * @brief Evaluate alarms for the values of one frame and publish the changes
+     * @param timestamp Frame time in milliseconds since epoch
+     * @param parameters Values of the monitored parameters
+     * @param count Number of values
+     */
+    void evaluateAlarms(qint64 timestamp, const VitalSync::FrameParameter* parameters, int count);
+
+    /**
+     * @brief Connect signals from a provider to the data manager slots
+     * @param provider Provider to connect
+     */
+    void connectProviderSignals(IDataProvider* provider);
+
+    /**
+     * @brief Disconnect signals from a provider from the data manager slots
+     * @param provider Provider to disconnect
+     */
+    void disconnectProviderSignals(IDataProvider* provider);
+
+    /**
+     * @brief Run a task in the thread that owns a provider and wait for it
+     * @param provider Provider whose thread runs the task
+     * @param task Task to run
+     */
+    void invokeOnProviderThread(IDataProvider* provider, const std::function<void()>& task);
+
+    /**
+     * @brief Run a task on the acquisition thread and wait for it
+     * @param task Task to run
+     */
+    void runOnAcquisitionThread(const std::function<void()>& task);
+
+    /**
+     * @brief Publish the current recorder, stream server and processors to the handlers
+     */
+    void publishIngestTaps();
+
+    /**
+     * @brief Move all providers back to this thread and stop the acquisition thread
+     */
+    void shutdownAcquisitionThread();
 
     /**
      * @brief Create all available data providers
@@ -193,14 +377,62 @@ private:
     // Current provider
     std::shared_ptr<IDataProvider> current_provider_;  ///< Currently active data provider
 
-    // Waveform models (mapped by type)
-    QMap<int, std::shared_ptr<IWaveformModel>> waveform_models_;  ///< Map of waveform models by waveform type ID
+    // Waveform models (indexed by type)
+    ModelRegistry<IWaveformModel, VitalSync::WAVEFORM_TYPE_COUNT> waveform_models_;  ///< Waveform models by waveform type ID, read without mutex_
 
-    // Parameter models (mapped by type)
-    QMap<int, std::shared_ptr<IParameterModel>> parameter_models_;  ///< Map of parameter models by parameter type ID
+    // Parameter models (indexed by type)
+    ModelRegistry<IParameterModel, VitalSync::PARAMETER_TYPE_COUNT> parameter_models_;  ///< Parameter models by parameter type ID, read without mutex_
+
+    // Bed identity
+    const QString bed_id_;  ///< Bed served by this manager, empty for the primary bed
+
+    // Demo state
+    bool demo_data_;  ///< Whether the active provider only simulates a patient, manager's thread only
+
+    // Recording
+    std::shared_ptr<DataRecorder> recorder_;  ///< Recorder tapping ingested data, null when not recording, guarded by mutex_
+
+    // Streaming
+    std::shared_ptr<StreamServer> stream_server_;  ///< Server fanning ingested frames out to viewers, null when not streaming, guarded by mutex_
+
+    AlarmEngine alarm_engine_;  ///< Alarm evaluation of all parameters of the bed, acquisition thread only
+
+    // Derived parameters
+    /**
+     * @brief Source currently feeding a parameter
+     */
+    struct ParameterSource {
+        int priority;               ///< Priority of the source, 0 for the provider
+        qint64 last_timestamp;      ///< Time of the source's last value
+    };
+    std::vector<std::shared_ptr<WaveformProcessor>> processors_;  ///< Derived-parameter stages, guarded by mutex_
+    std::array<ParameterSource, AlarmEngine::PARAMETER_COUNT> parameter_sources_;  ///< Source of each parameter, acquisition thread only
+    EcgFilterBank ecg_filters_;  ///< Baseline and mains filters of the ECG leads, acquisition thread only
+
+    // Ingest taps
+    /**
+     * @brief What the handlers tap ingested data with
+     *
+     * A copy of the recorder, the stream server and the processors owned by
+     * recorder_, stream_server_ and processors_, published to the acquisition
+     * thread by publishIngestTaps(). The handlers read it without a lock and
+     * without touching a reference count.
+     */
+    struct IngestTaps {
+        DataRecorder* recorder = nullptr;       ///< Recorder, null when not recording
+        StreamServer* stream_server = nullptr;  ///< Stream server, null when not streaming
+        std::array<QVarLengthArray<WaveformProcessor*, 4>, VitalSync::WAVEFORM_TYPE_COUNT> processors;  ///< Processors of each waveform type
+    };
+    IngestTaps ingest_taps_;  ///< Taps of the handlers, acquisition thread only
+    QMutex taps_mutex_;  ///< Serializes publishing ingest_taps_; never taken by the acquisition thread
+
+    // Acquisition thread
+    QThread* acquisition_thread_;  ///< Thread that runs the providers and feeds the models
+    QObject* acquisition_context_;  ///< Object living on the acquisition thread that runs tasks there
 
     // Thread safety
     mutable QMutex mutex_;  ///< Mutex for thread-safe access to manager state
+    QMutex lifecycle_mutex_;  ///< Serializes starting, stopping, switching and configuring providers
 };
 
 #endif // DATA_MANAGER_H 
\ No newline at end of file
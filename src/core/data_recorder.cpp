@@ -0,0 +1,648 @@
+/**
+ * @file data_recorder.cpp
+ * @brief Implementation of the DataRecorder class
+ *
+ * This file implements the DataRecorder class which stages ingested data per
+ * channel, hands finished chunks to a writer thread through lock-free queues
+ * and appends them to a recording in large batches.
+ */
+#include "data_recorder.h"
+#include "../utils/metrics.h"
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace VitalSync::Recording;
+
+/**
+ * @namespace Anonymous namespace for constants and helper functions
+ * @brief Contains constants used by the DataRecorder implementation
+ */
+namespace {
+    const int DEFAULT_CHUNK_DURATION_MS = 2000;     ///< Default time span of one chunk
+    const int MIN_CHUNK_DURATION_MS = 100;          ///< Shortest accepted chunk duration
+    const int DEFAULT_SYNC_INTERVAL_MS = 1000;      ///< Default time between syncs
+    const int DEFAULT_QUEUE_CAPACITY = 16;          ///< Default number of chunk blocks
+    const int MIN_QUEUE_CAPACITY = 2;               ///< Fewest chunk blocks
+    const int WRITE_BATCH_SIZE = 256 * 1024;        ///< Batch size that triggers a write
+    const int MAX_WRITE_DELAY_MS = 500;             ///< Longest a chunk waits in the batch
+    const int WRITER_WAKE_INTERVAL_MS = 100;        ///< Writer wake-up interval without new chunks
+    const int CLOSE_WAIT_MS = 2000;                 ///< Longest Close() waits for a free block
+
+    /**
+     * @brief Append bytes to a buffer
+     * @param out Buffer
+     * @param data Bytes to append
+     * @param size Number of bytes
+     */
+    void appendBytes(QVector<char>& out, const void* data, qint64 size)
+    {
+        const qsizetype offset = out.size();
+        out.resize(offset + size);
+        std::memcpy(out.data() + offset, data, static_cast<size_t>(size));
+    }
+
+    /**
+     * @brief Pad a buffer with zero bytes up to the next block boundary
+     * @param out Buffer starting at a block boundary
+     */
+    void appendPadding(QVector<char>& out)
+    {
+        out.resize(AlignedSize(out.size()));
+    }
+}
+
+/**
+ * @brief Constructs a closed recorder
+ * @param bedId Bed stored in the recording header, empty for the primary bed
+ */
+DataRecorder::DataRecorder(const QString& bedId)
+    : bed_id_(bedId)
+    , chunk_duration_ms_(DEFAULT_CHUNK_DURATION_MS)
+    , sync_interval_ms_(DEFAULT_SYNC_INTERVAL_MS)
+    , compression_(false)
+    , queue_capacity_(DEFAULT_QUEUE_CAPACITY)
+    , open_(false)
+    , chunk_open_(false)
+    , chunk_start_(0)
+    , chunk_end_(0)
+    , channel_mask_(0)
+    , stopping_(false)
+    , dropped_blocks_(0)
+    , write_compressed_(false)
+    , write_sync_interval_ms_(DEFAULT_SYNC_INTERVAL_MS)
+    , file_offset_(0)
+    , write_failed_(false)
+    , bytes_written_(0)
+{
+}
+
+/**
+ * @brief Destroys the recorder, closing the recording if needed
+ */
+DataRecorder::~DataRecorder()
+{
+    Close();
+}
+
+/**
+ * @brief Creates a recording and starts its writer thread
+ * @param filePath Path of the recording; an existing file is replaced
+ * @return True if the recording was created
+ */
+bool DataRecorder::Open(const QString& filePath)
+{
+    Close();
+
+#if Q_BYTE_ORDER != Q_LITTLE_ENDIAN
+    qWarning() << "DataRecorder: Recordings can only be written on little-endian hosts";
+    return false;
+#endif
+
+    // The writer is not running, so its state can be set up here
+    file_.setFileName(filePath);
+    if (!file_.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "DataRecorder: Cannot create" << filePath << ":" << file_.errorString();
+        return false;
+    }
+
+    FileHeader header = {};
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = FORMAT_VERSION;
+    header.headerSize = sizeof(FileHeader);
+    header.createdTimestamp = QDateTime::currentMSecsSinceEpoch();
+    const QByteArray bedId = bed_id_.toUtf8().left(BED_ID_SIZE - 1);
+    std::memcpy(header.bedId, bedId.constData(), static_cast<size_t>(bedId.size()));
+
+    batch_.resize(0);
+    appendBytes(batch_, &header, sizeof(header));
+    file_offset_ = sizeof(header);
+    index_.clear();
+    write_failed_.store(false, std::memory_order_relaxed);
+    bytes_written_.store(0, std::memory_order_relaxed);
+    dropped_blocks_.store(0, std::memory_order_relaxed);
+    stopping_.store(false, std::memory_order_relaxed);
+    pending_signal_.tryAcquire(pending_signal_.available());
+
+    {
+        QMutexLocker locker(&mutex_);
+        write_compressed_ = compression_;
+        write_sync_interval_ms_ = sync_interval_ms_;
+
+        // Allocate every block up front so recording never allocates one
+        blocks_.clear();
+        pending_.Reset(queue_capacity_);
+        free_.Reset(queue_capacity_);
+        for (int i = 0; i < queue_capacity_; ++i) {
+            blocks_.push_back(std::make_unique<Block>());
+            free_.TryPush(blocks_.back().get());
+        }
+
+        chunk_open_ = false;
+        channel_mask_ = 0;
+        parameters_.clear();
+        file_path_ = filePath;
+        open_ = true;
+    }
+
+    writer_thread_.reset(QThread::create([this]() { writerLoop(); }));
+    writer_thread_->setObjectName("VitalSyncRecorder");
+    writer_thread_->start();
+
+    qDebug() << "DataRecorder: Recording to" << filePath << (write_compressed_ ? "with" : "without")
+             << "compression";
+    return true;
+}
+
+/**
+ * @brief Queues the pending chunk and waits for the writer to finish the file
+ *
+ * Recording calls are only held up while the last chunk is queued; waiting
+ * for the writer to drain the queue and write the index happens without the
+ * lock.
+ */
+void DataRecorder::Close()
+{
+    {
+        QMutexLocker locker(&mutex_);
+        if (!open_) {
+            return;
+        }
+        flushChunk(true);
+        open_ = false;
+        file_path_.clear();
+    }
+
+    stopping_.store(true, std::memory_order_release);
+    pending_signal_.release();
+    writer_thread_->wait();
+    writer_thread_.reset();
+    blocks_.clear();
+
+    qDebug() << "DataRecorder: Closed" << file_.fileName() << "after" << GetBytesWritten() << "bytes in"
+             << index_.size() << "chunks," << GetDroppedBlockCount() << "chunks dropped";
+}
+
+/**
+ * @brief Checks if a recording is open
+ * @return True if recording and the recording can still be written
+ */
+bool DataRecorder::IsOpen() const
+{
+    QMutexLocker locker(&mutex_);
+    return open_ && !write_failed_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the path of the current recording
+ * @return File path, empty if not recording
+ */
+QString DataRecorder::GetFilePath() const
+{
+    QMutexLocker locker(&mutex_);
+    return file_path_;
+}
+
+/**
+ * @brief Sets the time span covered by one chunk
+ * @param durationMs Chunk duration in milliseconds
+ *
+ * Longer chunks mean fewer, larger writes and a smaller index; shorter chunks
+ * lose less data if the process dies.
+ */
+void DataRecorder::SetChunkDuration(int durationMs)
+{
+    QMutexLocker locker(&mutex_);
+    chunk_duration_ms_ = std::max(MIN_CHUNK_DURATION_MS, durationMs);
+}
+
+/**
+ * @brief Sets how often written data is synced to storage
+ * @param intervalMs Minimum time between syncs in milliseconds,
+ *                   0 to sync after every write, negative to sync only on close
+ */
+void DataRecorder::SetSyncInterval(int intervalMs)
+{
+    QMutexLocker locker(&mutex_);
+    sync_interval_ms_ = intervalMs;
+}
+
+/**
+ * @brief Enables compression of the waveform channels
+ * @param enabled True to compress channels with the SampleCodec
+ */
+void DataRecorder::SetCompression(bool enabled)
+{
+    QMutexLocker locker(&mutex_);
+    compression_ = enabled;
+}
+
+/**
+ * @brief Sets how many chunks may wait for the writer
+ * @param blocks Number of chunk blocks allocated when opening
+ *
+ * Together with the chunk duration this bounds both the memory held by the
+ * recorder and how long storage may stall before chunks are dropped.
+ */
+void DataRecorder::SetQueueCapacity(int blocks)
+{
+    QMutexLocker locker(&mutex_);
+    queue_capacity_ = std::max(MIN_QUEUE_CAPACITY, blocks);
+}
+
+/**
+ * @brief Records a block of waveform samples
+ * @param waveformId VitalSync::WaveformType of the samples
+ * @param timestamp Timestamp of the first sample in milliseconds
+ * @param data Samples
+ * @param count Number of samples
+ * @param sampleRate Current sample rate estimate in Hz, 0 if unknown
+ *
+ * The samples are appended to the channel's staging buffer; at most a
+ * finished chunk is serialized and queued, nothing is written here.
+ */
+void DataRecorder::RecordWaveform(int waveformId, qint64 timestamp, const float* data, int count, double sampleRate)
+{
+    if (waveformId < 0 || waveformId >= MAX_CHANNELS || count <= 0) {
+        return;
+    }
+
+    QMutexLocker locker(&mutex_);
+    if (!open_) {
+        return;
+    }
+
+    advanceChunk(timestamp);
+
+    ChannelStage& stage = channels_[waveformId];
+    if (!(channel_mask_ & (1u << waveformId))) {
+        channel_mask_ |= 1u << waveformId;
+        stage.first_timestamp = timestamp;
+        stage.samples.clear();
+    }
+    if (sampleRate > 0.0) {
+        stage.sample_rate = sampleRate;
+    }
+
+    const qsizetype offset = stage.samples.size();
+    stage.samples.resize(offset + count);
+    std::memcpy(stage.samples.data() + offset, data, static_cast<size_t>(count) * sizeof(float));
+
+    // The last sample of the block, when the rate is known
+    const qint64 lastSample = stage.sample_rate > 0.0
+        ? timestamp + std::llround((count - 1) * 1000.0 / stage.sample_rate) : timestamp;
+    chunk_end_ = std::max(chunk_end_, lastSample);
+}
+
+/**
+ * @brief Records a parameter value
+ * @param parameterId VitalSync::ParameterType of the value
+ * @param timestamp Timestamp in milliseconds
+ * @param value Measured value
+ */
+void DataRecorder::RecordParameter(int parameterId, qint64 timestamp, float value)
+{
+    QMutexLocker locker(&mutex_);
+    if (!open_) {
+        return;
+    }
+
+    advanceChunk(timestamp);
+
+    ParameterRecord record = {};
+    record.timestamp = timestamp;
+    record.parameterId = static_cast<quint16>(parameterId);
+    record.value = value;
+    parameters_.append(record);
+    chunk_end_ = std::max(chunk_end_, timestamp);
+}
+
+/**
+ * @brief Gets the number of bytes written to the current recording
+ * @return Bytes written
+ */
+quint64 DataRecorder::GetBytesWritten() const
+{
+    return bytes_written_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the number of chunks waiting for the writer
+ * @return Queue depth in chunks
+ */
+int DataRecorder::GetQueueDepth() const
+{
+    QMutexLocker locker(&mutex_);
+    return open_ ? pending_.GetSize() : 0;
+}
+
+/**
+ * @brief Gets the number of chunks dropped because the writer fell behind
+ * @return Dropped chunk count of the current or last recording
+ */
+quint64 DataRecorder::GetDroppedBlockCount() const
+{
+    return dropped_blocks_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Queues the staged chunk if the timestamp falls outside it, then extends it
+ * @param timestamp Timestamp of incoming data
+ *
+ * A timestamp before the chunk start, for example after a clock change,
+ * also starts a new chunk.
+ */
+void DataRecorder::advanceChunk(qint64 timestamp)
+{
+    if (chunk_open_ && (timestamp < chunk_start_ || timestamp - chunk_start_ >= chunk_duration_ms_)) {
+        flushChunk(false);
+    }
+
+    if (!chunk_open_) {
+        chunk_open_ = true;
+        chunk_start_ = timestamp;
+        chunk_end_ = timestamp;
+    }
+}
+
+/**
+ * @brief Serializes the staged data as one chunk and queues it for the writer
+ * @param wait True to wait a while for a free block instead of dropping the chunk
+ *
+ * Channels are serialized in ascending waveform type order, each as a block
+ * header followed by its samples, then the parameter records. The staged
+ * buffers are cleared but keep their capacity. Every block is either free or
+ * queued, so a free block always fits into the queue.
+ */
+void DataRecorder::flushChunk(bool wait)
+{
+    if (!chunk_open_) {
+        return;
+    }
+
+    Block* block = nullptr;
+    bool haveBlock = free_.TryPop(block);
+    if (!haveBlock && wait) {
+        QElapsedTimer waited;
+        waited.start();
+        while (!haveBlock && waited.elapsed() < CLOSE_WAIT_MS) {
+            QThread::msleep(1);
+            haveBlock = free_.TryPop(block);
+        }
+    }
+
+    if (haveBlock) {
+        QVector<char>& out = block->data;
+        out.resize(0);
+
+        int channelCount = 0;
+        for (int id = 0; id < MAX_CHANNELS; ++id) {
+            channelCount += (channel_mask_ >> id) & 1u;
+        }
+
+        ChunkHeader header = {};
+        header.magic = CHUNK_MAGIC;
+        header.type = static_cast<quint16>(ChunkType::Data);
+        header.channelCount = static_cast<quint16>(channelCount);
+        header.parameterCount = static_cast<quint32>(parameters_.size());
+        header.startTimestamp = chunk_start_;
+        header.endTimestamp = chunk_end_;
+        appendBytes(out, &header, sizeof(header));
+
+        for (int id = 0; id < MAX_CHANNELS; ++id) {
+            if (!(channel_mask_ & (1u << id))) {
+                continue;
+            }
+            const ChannelStage& stage = channels_[id];
+            const qint64 sampleBytes = stage.samples.size() * static_cast<qint64>(sizeof(float));
+
+            ChannelBlockHeader channel = {};
+            channel.waveformId = static_cast<quint16>(id);
+            channel.encoding = static_cast<quint16>(BlockEncoding::Raw);
+            channel.sampleCount = static_cast<quint32>(stage.samples.size());
+            channel.firstTimestamp = stage.first_timestamp;
+            channel.sampleRate = static_cast<float>(stage.sample_rate);
+            channel.payloadSize = static_cast<quint32>(sampleBytes);
+
+            appendBytes(out, &channel, sizeof(channel));
+            appendBytes(out, stage.samples.constData(), sampleBytes);
+            appendPadding(out);
+        }
+
+        appendBytes(out, parameters_.constData(), parameters_.size() * static_cast<qint64>(sizeof(ParameterRecord)));
+
+        // Patch the size in now that it is known
+        header.chunkSize = static_cast<quint32>(out.size());
+        std::memcpy(out.data(), &header, sizeof(header));
+
+        pending_.TryPush(block);
+        pending_signal_.release();
+        Metrics::Record(Metrics::Histogram::RecorderQueueDepth, pending_.GetSize());
+    } else {
+        dropped_blocks_.fetch_add(1, std::memory_order_relaxed);
+        Metrics::Add(Metrics::Counter::RecordingChunksDropped);
+    }
+
+    for (int id = 0; id < MAX_CHANNELS; ++id) {
+        if (channel_mask_ & (1u << id)) {
+            channels_[id].samples.clear();
+        }
+    }
+    channel_mask_ = 0;
+    parameters_.clear();
+    chunk_open_ = false;
+}
+
+/**
+ * @brief Body of the writer thread
+ *
+ * Drains queued chunks into the batch and returns their blocks, writes the
+ * batch once it is large or old enough, and syncs on the configured cadence.
+ * Dropped chunks are reported from here so that recording never logs. Once
+ * stopping, the remaining chunks, the index and the trailer are written and
+ * the file is synced and closed.
+ */
+void DataRecorder::writerLoop()
+{
+    QElapsedTimer sinceWrite;
+    QElapsedTimer sinceSync;
+    sinceWrite.start();
+    sinceSync.start();
+    bool unsynced = false;
+    quint64 reportedDrops = 0;
+
+    for (;;) {
+        pending_signal_.tryAcquire(1, WRITER_WAKE_INTERVAL_MS);
+
+        // Read before draining: the last chunk is queued before stopping is set
+        const bool stopping = stopping_.load(std::memory_order_acquire);
+
+        Block* block = nullptr;
+        while (pending_.TryPop(block)) {
+            appendChunk(*block);
+            free_.TryPush(block);
+        }
+
+        if (!batch_.isEmpty()
+            && (stopping || batch_.size() >= WRITE_BATCH_SIZE || sinceWrite.elapsed() >= MAX_WRITE_DELAY_MS)) {
+            unsynced = writeBatch() || unsynced;
+            sinceWrite.restart();
+        }
+
+        if (unsynced && write_sync_interval_ms_ >= 0 && sinceSync.elapsed() >= write_sync_interval_ms_) {
+            syncFile();
+            unsynced = false;
+            sinceSync.restart();
+        }
+
+        const quint64 drops = dropped_blocks_.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            qWarning() << "DataRecorder: Storage too slow for" << file_.fileName() << "-"
+                       << drops - reportedDrops << "chunks dropped";
+            reportedDrops = drops;
+        }
+
+        if (stopping) {
+            break;
+        }
+    }
+
+    appendIndex();
+    writeBatch();
+    syncFile();
+    file_.close();
+}
+
+/**
+ * @brief Appends a queued chunk to the write batch, compressing it if enabled
+ * @param block Serialized chunk
+ *
+ * Channels whose compressed form is not smaller are kept raw, so they
+ * remain readable in place.
+ */
+void DataRecorder::appendChunk(const Block& block)
+{
+    const char* data = block.data.constData();
+    const qint64 size = block.data.size();
+
+    ChunkHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    index_.append(IndexEntry{ header.startTimestamp, header.endTimestamp, static_cast<quint64>(file_offset_) });
+
+    const qsizetype chunkStart = batch_.size();
+    if (!write_compressed_) {
+        appendBytes(batch_, data, size);
+        file_offset_ += size;
+        return;
+    }
+
+    appendBytes(batch_, &header, sizeof(header));
+
+    qint64 offset = sizeof(ChunkHeader);
+    for (int i = 0; i < header.channelCount; ++i) {
+        ChannelBlockHeader channel;
+        std::memcpy(&channel, data + offset, sizeof(channel));
+        offset += sizeof(ChannelBlockHeader);
+
+        const qint64 rawBytes = static_cast<qint64>(channel.sampleCount) * sizeof(float);
+        codec_.Encode(data + offset, static_cast<int>(channel.sampleCount), encoded_);
+
+        if (encoded_.size() < rawBytes) {
+            channel.encoding = static_cast<quint16>(BlockEncoding::DeltaLz);
+            channel.payloadSize = static_cast<quint32>(encoded_.size());
+            appendBytes(batch_, &channel, sizeof(channel));
+            appendBytes(batch_, encoded_.constData(), encoded_.size());
+            appendPadding(batch_);
+        } else {
+            appendBytes(batch_, &channel, sizeof(channel));
+            appendBytes(batch_, data + offset, AlignedSize(rawBytes));
+        }
+        offset += AlignedSize(rawBytes);
+    }
+
+    // Parameter records are copied as they are
+    appendBytes(batch_, data + offset, size - offset);
+
+    header.chunkSize = static_cast<quint32>(batch_.size() - chunkStart);
+    std::memcpy(batch_.data() + chunkStart, &header, sizeof(header));
+    file_offset_ += batch_.size() - chunkStart;
+}
+
+/**
+ * @brief Appends the time index chunk and the trailer to the write batch
+ */
+void DataRecorder::appendIndex()
+{
+    const qint64 entriesSize = index_.size() * static_cast<qint64>(sizeof(IndexEntry));
+
+    ChunkHeader header = {};
+    header.magic = CHUNK_MAGIC;
+    header.chunkSize = static_cast<quint32>(sizeof(ChunkHeader) + entriesSize);
+    header.type = static_cast<quint16>(ChunkType::Index);
+    if (!index_.isEmpty()) {
+        header.startTimestamp = index_.first().startTimestamp;
+        header.endTimestamp = index_.last().endTimestamp;
+    }
+
+    IndexTrailer trailer = {};
+    trailer.magic = TRAILER_MAGIC;
+    trailer.entryCount = static_cast<quint32>(index_.size());
+    trailer.indexOffset = static_cast<quint64>(file_offset_);
+
+    appendBytes(batch_, &header, sizeof(header));
+    appendBytes(batch_, index_.constData(), entriesSize);
+    appendBytes(batch_, &trailer, sizeof(trailer));
+    file_offset_ += sizeof(header) + entriesSize + sizeof(trailer);
+}
+
+/**
+ * @brief Writes the batch to the file
+ * @return True if the batch was written
+ *
+ * After a failed write the recording is abandoned: later batches are
+ * discarded so queued blocks keep being recycled.
+ */
+bool DataRecorder::writeBatch()
+{
+    const qint64 size = batch_.size();
+    bool written = false;
+
+    if (!write_failed_.load(std::memory_order_relaxed) && size > 0) {
+        if (file_.write(batch_.constData(), size) == size) {
+            bytes_written_.fetch_add(static_cast<quint64>(size), std::memory_order_relaxed);
+            written = true;
+        } else {
+            qWarning() << "DataRecorder: Write to" << file_.fileName() << "failed:" << file_.errorString()
+                       << "- recording stopped";
+            write_failed_.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    batch_.resize(0);
+    return written;
+}
+
+/**
+ * @brief Flushes the file and syncs it to storage
+ */
+void DataRecorder::syncFile()
+{
+    if (!file_.isOpen() || write_failed_.load(std::memory_order_relaxed) || !file_.flush()) {
+        return;
+    }
+
+#ifdef Q_OS_WIN
+    _commit(file_.handle());
+#else
+    ::fsync(file_.handle());
+#endif
+}
@@ -0,0 +1,250 @@
+/**
+ * @file data_recorder.h
+ * @brief Definition of the DataRecorder class
+ *
+ * This file contains the definition of the DataRecorder class which writes the
+ * data ingested by a DataManager to a full-disclosure recording (.vsr).
+ */
+#ifndef DATA_RECORDER_H
+#define DATA_RECORDER_H
+
+#include "recording_format.h"
+#include "sample_codec.h"
+#include "spsc_queue.h"
+#include <QFile>
+#include <QMutex>
+#include <QSemaphore>
+#include <QString>
+#include <QThread>
+#include <QVector>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Writer of full-disclosure recordings
+ *
+ * The data manager hands every ingested waveform block and parameter value to
+ * the recorder, which appends them to per-channel staging buffers. Once a
+ * chunk spans the chunk duration it is serialized into a preallocated block,
+ * one contiguous run per channel, and queued for a writer thread. The writer
+ * optionally compresses the channels, batches chunks into large writes,
+ * syncs the file on a configurable cadence and keeps the time index, which
+ * it writes when the recorder is closed so the recording opens without a scan.
+ *
+ * Recording never waits for storage: when the writer falls behind and all
+ * blocks are queued, the chunk is dropped and counted instead.
+ *
+ * Recording calls may come from the acquisition thread while the recorder is
+ * opened or closed from another thread.
+ */
+class DataRecorder {
+public:
+    /**
+     * @brief Constructor
+     * @param bedId Bed stored in the recording header, empty for the primary bed
+     */
+    explicit DataRecorder(const QString& bedId = QString());
+
+    /**
+     * @brief Destructor
+     *
+     * Closes the recording if it is still open.
+     */
+    ~DataRecorder();
+
+    DataRecorder(const DataRecorder&) = delete;
+    DataRecorder& operator=(const DataRecorder&) = delete;
+
+    /**
+     * @brief Create a recording
+     * @param filePath Path of the recording; an existing file is replaced
+     * @return True if the recording was created
+     */
+    bool Open(const QString& filePath);
+
+    /**
+     * @brief Write the pending chunk and the time index and close the file
+     */
+    void Close();
+
+    /**
+     * @brief Check if a recording is open
+     * @return True if recording
+     */
+    bool IsOpen() const;
+
+    /**
+     * @brief Get the path of the current recording
+     * @return File path, empty if not recording
+     */
+    QString GetFilePath() const;
+
+    /**
+     * @brief Set the time span covered by one chunk
+     * @param durationMs Chunk duration in milliseconds
+     */
+    void SetChunkDuration(int durationMs);
+
+    /**
+     * @brief Set how often written data is synced to storage
+     * @param intervalMs Minimum time between syncs in milliseconds,
+     *                   0 to sync after every write, negative to sync only on close
+     *
+     * Takes effect with the next Open().
+     */
+    void SetSyncInterval(int intervalMs);
+
+    /**
+     * @brief Enable compression of the waveform channels
+     * @param enabled True to compress channels with the SampleCodec
+     *
+     * Takes effect with the next Open().
+     */
+    void SetCompression(bool enabled);
+
+    /**
+     * @brief Set how many chunks may wait for the writer
+     * @param blocks Number of chunk blocks allocated when opening
+     *
+     * Takes effect with the next Open().
+     */
+    void SetQueueCapacity(int blocks);
+
+    /**
+     * @brief Record a block of waveform samples
+     * @param waveformId VitalSync::WaveformType of the samples
+     * @param timestamp Timestamp of the first sample in milliseconds
+     * @param data Samples
+     * @param count Number of samples
+     * @param sampleRate Current sample rate estimate in Hz, 0 if unknown
+     */
+    void RecordWaveform(int waveformId, qint64 timestamp, const float* data, int count, double sampleRate);
+
+    /**
+     * @brief Record a parameter value
+     * @param parameterId VitalSync::ParameterType of the value
+     * @param timestamp Timestamp in milliseconds
+     * @param value Measured value
+     */
+    void RecordParameter(int parameterId, qint64 timestamp, float value);
+
+    /**
+     * @brief Get the number of bytes written to the current recording
+     * @return Bytes written
+     */
+    quint64 GetBytesWritten() const;
+
+    /**
+     * @brief Get the number of chunks waiting for the writer
+     * @return Queue depth in chunks
+     */
+    int GetQueueDepth() const;
+
+    /**
+     * @brief Get the number of chunks dropped because the writer fell behind
+     * @return Dropped chunk count of the current or last recording
+     */
+    quint64 GetDroppedBlockCount() const;
+
+private:
+    /**
+     * @brief Samples of one channel waiting for the next chunk write
+     */
+    struct ChannelStage {
+        qint64 first_timestamp = 0;     ///< Time of the first staged sample
+        double sample_rate = 0.0;       ///< Latest sample rate estimate in Hz
+        QVector<float> samples;         ///< Staged samples, capacity kept between chunks
+    };
+
+    /**
+     * @brief A serialized chunk on its way to the writer
+     */
+    struct Block {
+        QVector<char> data;             ///< Uncompressed chunk, capacity kept between chunks
+    };
+
+    /**
+     * @brief Queue the staged chunk if the timestamp falls outside it, then extend it
+     * @param timestamp Timestamp of incoming data
+     */
+    void advanceChunk(qint64 timestamp);
+
+    /**
+     * @brief Serialize the staged data as one chunk and queue it for the writer
+     * @param wait True to wait a while for a free block instead of dropping the chunk
+     */
+    void flushChunk(bool wait);
+
+    /**
+     * @brief Body of the writer thread
+     */
+    void writerLoop();
+
+    /**
+     * @brief Append a queued chunk to the write batch, compressing it if enabled
+     * @param block Serialized chunk
+     */
+    void appendChunk(const Block& block);
+
+    /**
+     * @brief Append the time index chunk and the trailer to the write batch
+     */
+    void appendIndex();
+
+    /**
+     * @brief Write the batch to the file
+     * @return True if the batch was written
+     */
+    bool writeBatch();
+
+    /**
+     * @brief Flush the file and sync it to storage
+     */
+    void syncFile();
+
+private:
+    static constexpr int MAX_CHANNELS = 32;     ///< Waveform types that can be recorded
+
+    const QString bed_id_;                      ///< Bed stored in the recording header
+    mutable QMutex mutex_;                      ///< Guards the settings and the staged chunk
+
+    // Settings
+    int chunk_duration_ms_;                     ///< Time span of one chunk
+    int sync_interval_ms_;                      ///< Minimum time between syncs
+    bool compression_;                          ///< Whether channels are compressed
+    int queue_capacity_;                        ///< Chunk blocks allocated when opening
+
+    // Staging, owned by the recording threads
+    bool open_;                                 ///< Whether a recording is open
+    QString file_path_;                         ///< Path of the open recording
+    bool chunk_open_;                           ///< Whether data is staged for a chunk
+    qint64 chunk_start_;                        ///< Time of the first staged data
+    qint64 chunk_end_;                          ///< Time of the last staged data
+    ChannelStage channels_[MAX_CHANNELS];       ///< Staged samples by waveform type
+    quint32 channel_mask_;                      ///< Waveform types with staged samples
+    QVector<VitalSync::Recording::ParameterRecord> parameters_;  ///< Staged parameter values
+
+    // Hand-off between the recording threads and the writer
+    std::vector<std::unique_ptr<Block>> blocks_;  ///< All chunk blocks of the recording
+    SpscQueue<Block*> pending_;                 ///< Chunks waiting for the writer
+    SpscQueue<Block*> free_;                    ///< Blocks returned by the writer
+    QSemaphore pending_signal_;                 ///< Wakes the writer when a chunk is queued
+    std::atomic<bool> stopping_;                ///< Tells the writer to finish the recording
+    std::atomic<quint64> dropped_blocks_;       ///< Chunks dropped because no block was free
+    std::unique_ptr<QThread> writer_thread_;    ///< Thread writing the recording
+
+    // Writer state, owned by the writer thread while it runs
+    QFile file_;                                ///< Recording being written
+    bool write_compressed_;                     ///< Compression setting of the recording
+    int write_sync_interval_ms_;                ///< Sync setting of the recording
+    QVector<char> batch_;                       ///< Bytes not yet written to the file
+    qint64 file_offset_;                        ///< File offset of the end of the batch
+    QVector<VitalSync::Recording::IndexEntry> index_;  ///< Time index of the queued chunks
+    SampleCodec codec_;                         ///< Compressor of the channels
+    QVector<uchar> encoded_;                    ///< Compressed samples of one channel
+    std::atomic<bool> write_failed_;            ///< Whether writing to the file failed
+    std::atomic<quint64> bytes_written_;        ///< Bytes written to the recording
+};
+
+#endif // DATA_RECORDER_H
@@ -0,0 +1,230 @@
+/**
+ * @file decimation_pyramid.cpp
+ * @brief Implementation of the DecimationPyramid class
+ *
+ * This file implements the incremental maintenance of the min/max levels of a
+ * DecimationPyramid and envelope queries that pick the coarsest level that
+ * still resolves the requested columns.
+ */
+#include "decimation_pyramid.h"
+#include "../utils/signal_kernels.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @namespace Anonymous namespace for constants and helper functions
+ * @brief Contains the level geometry used by the DecimationPyramid implementation
+ */
+namespace {
+    const int BASE_SHIFT = 4;       ///< log2 of the level 0 bucket size
+    const int FACTOR_SHIFT = 2;     ///< log2 of the level factor
+
+    /**
+     * @brief Widen an extent by another one
+     * @param extent Extent to widen
+     * @param other Extent to include
+     */
+    template <typename Extent>
+    void fold(Extent& extent, const Extent& other)
+    {
+        extent.min = std::min(extent.min, other.min);
+        extent.max = std::max(extent.max, other.max);
+    }
+}
+
+/**
+ * @brief Constructs an empty pyramid
+ *
+ * The rings are allocated when the first samples arrive.
+ */
+DecimationPyramid::DecimationPyramid()
+    : write_sequence_(0)
+{
+    static_assert(BASE_BUCKET_SIZE == 1 << BASE_SHIFT, "Bucket size matches its shift");
+    static_assert(LEVEL_FACTOR == 1 << FACTOR_SHIFT, "Level factor matches its shift");
+    static_assert((BUCKETS_PER_LEVEL & (BUCKETS_PER_LEVEL - 1)) == 0, "Ring size is a power of two");
+}
+
+/**
+ * @brief Appends samples
+ * @param data Pointer to the samples
+ * @param count Number of samples
+ *
+ * Level 0 is updated from the samples with the vectorized min/max kernel;
+ * every coarser level then recomputes only the buckets the chunk touched
+ * from their at most LEVEL_FACTOR children, so the cost above level 0
+ * shrinks by LEVEL_FACTOR per level.
+ */
+void DecimationPyramid::Write(const float* data, int count)
+{
+    if (!data || count <= 0) {
+        return;
+    }
+    if (levels_[0].empty()) {
+        allocate();
+    }
+
+    const quint64 first = write_sequence_;
+    const quint64 end = first + static_cast<quint64>(count);
+    const quint64 mask = BUCKETS_PER_LEVEL - 1;
+
+    std::vector<Extent>& base = levels_[0];
+    quint64 sequence = first;
+    while (sequence < end) {
+        const quint64 id = sequence >> BASE_SHIFT;
+        const quint64 bucketEnd = std::min(end, (id + 1) << BASE_SHIFT);
+        const float* samples = data + (sequence - first);
+
+        // A bucket begun by an earlier chunk is extended, otherwise it starts over
+        Extent extent;
+        SignalKernels::MinMax(samples, static_cast<int>(bucketEnd - sequence), extent.min, extent.max);
+        if ((sequence & (BASE_BUCKET_SIZE - 1)) != 0) {
+            fold(extent, base[id & mask]);
+        }
+        base[id & mask] = extent;
+        sequence = bucketEnd;
+    }
+    write_sequence_ = end;
+
+    quint64 firstId = first >> BASE_SHIFT;
+    quint64 lastId = (end - 1) >> BASE_SHIFT;
+    for (int level = 1; level < LEVEL_COUNT; ++level) {
+        const std::vector<Extent>& children = levels_[level - 1];
+        std::vector<Extent>& buckets = levels_[level];
+        const quint64 newestChild = lastId;
+        firstId >>= FACTOR_SHIFT;
+        lastId >>= FACTOR_SHIFT;
+
+        for (quint64 id = firstId; id <= lastId; ++id) {
+            const quint64 childBegin = id << FACTOR_SHIFT;
+            const quint64 childEnd = std::min(childBegin + LEVEL_FACTOR, newestChild + 1);
+            Extent extent = children[childBegin & mask];
+            for (quint64 child = childBegin + 1; child < childEnd; ++child) {
+                fold(extent, children[child & mask]);
+            }
+            buckets[id & mask] = extent;
+        }
+    }
+}
+
+/**
+ * @brief Gets the sequence number of the oldest summarized sample
+ * @return Oldest sequence number covered by the top level
+ */
+quint64 DecimationPyramid::GetOldestSequence() const
+{
+    if (write_sequence_ == 0) {
+        return 0;
+    }
+    return static_cast<quint64>(oldestBucket(LEVEL_COUNT - 1)) << levelShift(LEVEL_COUNT - 1);
+}
+
+/**
+ * @brief Builds the envelope of a range of samples
+ * @param fromSequence First sequence number of the range, may be negative
+ * @param toSequence Sequence number one past the range
+ * @param columns Number of columns to divide the range into
+ * @param out Receives columns envelope columns
+ * @return Number of columns that hold data
+ *
+ * Each column reads the coarsest level whose buckets are no larger than the
+ * column, which is at most 2 * LEVEL_FACTOR buckets, so the cost is O(columns)
+ * for a range of any length. Columns older than that level's reach use the
+ * finest level that still covers them. Buckets straddling a column boundary
+ * count toward both columns, so the envelope never misses a peak. Columns
+ * outside the summarized history are left invalid.
+ */
+int DecimationPyramid::Query(qint64 fromSequence, qint64 toSequence, int columns, EnvelopeColumn* out) const
+{
+    if (!out || columns <= 0) {
+        return 0;
+    }
+    std::fill(out, out + columns, EnvelopeColumn());
+    if (write_sequence_ == 0 || toSequence <= fromSequence) {
+        return 0;
+    }
+
+    const double samplesPerColumn = static_cast<double>(toSequence - fromSequence) / columns;
+    int finest = 0;
+    while (finest + 1 < LEVEL_COUNT && static_cast<double>(1ULL << levelShift(finest + 1)) <= samplesPerColumn) {
+        ++finest;
+    }
+
+    const qint64 end = static_cast<qint64>(write_sequence_);
+    const qint64 mask = BUCKETS_PER_LEVEL - 1;
+    int filled = 0;
+    for (int column = 0; column < columns; ++column) {
+        const qint64 begin = fromSequence + static_cast<qint64>(std::floor(column * samplesPerColumn));
+        if (begin >= end) {
+            break;
+        }
+        const qint64 next = fromSequence + static_cast<qint64>(std::floor((column + 1) * samplesPerColumn));
+        const qint64 last = std::min(std::max(begin, next - 1), end - 1);
+        if (last < 0) {
+            continue;
+        }
+
+        int level = finest;
+        while (level + 1 < LEVEL_COUNT && (std::max<qint64>(begin, 0) >> levelShift(level)) < oldestBucket(level)) {
+            ++level;
+        }
+        const int shift = levelShift(level);
+        const qint64 firstBucket = std::max(std::max<qint64>(begin, 0) >> shift, oldestBucket(level));
+        const qint64 lastBucket = last >> shift;
+        if (lastBucket < firstBucket) {
+            continue;
+        }
+
+        const std::vector<Extent>& buckets = levels_[level];
+        Extent extent = buckets[static_cast<size_t>(firstBucket & mask)];
+        for (qint64 id = firstBucket + 1; id <= lastBucket; ++id) {
+            fold(extent, buckets[static_cast<size_t>(id & mask)]);
+        }
+        out[column] = EnvelopeColumn{ extent.min, extent.max, true };
+        ++filled;
+    }
+    return filled;
+}
+
+/**
+ * @brief Removes all summaries, releases the storage and restarts the numbering
+ */
+void DecimationPyramid::Clear()
+{
+    for (std::vector<Extent>& buckets : levels_) {
+        buckets.clear();
+        buckets.shrink_to_fit();
+    }
+    write_sequence_ = 0;
+}
+
+/**
+ * @brief Gets the bucket size of a level
+ * @param level Level index
+ * @return Samples per bucket as a power of two exponent
+ */
+int DecimationPyramid::levelShift(int level)
+{
+    return BASE_SHIFT + level * FACTOR_SHIFT;
+}
+
+/**
+ * @brief Gets the oldest retained bucket of a level
+ * @param level Level index
+ * @return Bucket id
+ */
+qint64 DecimationPyramid::oldestBucket(int level) const
+{
+    const qint64 newest = static_cast<qint64>((write_sequence_ - 1) >> levelShift(level));
+    return std::max<qint64>(0, newest - BUCKETS_PER_LEVEL + 1);
+}
+
+/**
+ * @brief Allocates the rings
+ */
+void DecimationPyramid::allocate()
+{
+    for (std::vector<Extent>& buckets : levels_) {
+        buckets.assign(BUCKETS_PER_LEVEL, Extent{ 0.0f, 0.0f });
+    }
+}
@@ -0,0 +1,114 @@
+/**
+ * @file decimation_pyramid.h
+ * @brief Definition of the DecimationPyramid class
+ *
+ * This file contains the definition of the DecimationPyramid class which keeps
+ * fixed-size rings of min/max summaries of a waveform at successively coarser
+ * resolutions, so an envelope of any stretch of history can be built without
+ * visiting the individual samples.
+ */
+#ifndef DECIMATION_PYRAMID_H
+#define DECIMATION_PYRAMID_H
+
+#include "../../include/waveform_envelope.h"
+#include <QtGlobal>
+#include <array>
+#include <vector>
+
+/**
+ * @brief Incrementally maintained min/max pyramid of one waveform
+ *
+ * Level 0 summarizes every BASE_BUCKET_SIZE consecutive samples by their
+ * lowest and highest value, and each further level summarizes LEVEL_FACTOR
+ * buckets of the level below. Buckets are addressed by sample sequence number,
+ * the same numbering the model's SampleRingBuffer uses, and every level keeps
+ * the newest BUCKETS_PER_LEVEL buckets. Fine levels therefore cover recent
+ * history and coarse levels reach far back: at 500 samples per second level 0
+ * spans about two minutes and the top level six days, in 224 KB.
+ *
+ * Write() costs O(chunk) and the partially filled newest buckets are always
+ * up to date. Query() reads at most a few buckets per output column, whatever
+ * the length of the range.
+ *
+ * Not thread-safe; the owning model serializes access.
+ */
+class DecimationPyramid {
+public:
+    static constexpr int BASE_BUCKET_SIZE = 16;         ///< Samples per level 0 bucket
+    static constexpr int LEVEL_FACTOR = 4;              ///< Buckets of a level per bucket of the next
+    static constexpr int LEVEL_COUNT = 7;               ///< Number of levels
+    static constexpr int BUCKETS_PER_LEVEL = 4096;      ///< Retained buckets per level
+
+    /**
+     * @brief Constructor
+     */
+    DecimationPyramid();
+
+    /**
+     * @brief Append samples
+     * @param data Pointer to the samples
+     * @param count Number of samples
+     */
+    void Write(const float* data, int count);
+
+    /**
+     * @brief Get the sequence number one past the newest sample
+     * @return Total number of samples ever written
+     */
+    quint64 GetWriteSequence() const { return write_sequence_; }
+
+    /**
+     * @brief Get the sequence number of the oldest summarized sample
+     * @return Oldest sequence number covered by the top level
+     */
+    quint64 GetOldestSequence() const;
+
+    /**
+     * @brief Build the envelope of a range of samples
+     * @param fromSequence First sequence number of the range, may be negative
+     * @param toSequence Sequence number one past the range
+     * @param columns Number of columns to divide the range into
+     * @param out Receives columns envelope columns
+     * @return Number of columns that hold data
+     */
+    int Query(qint64 fromSequence, qint64 toSequence, int columns, EnvelopeColumn* out) const;
+
+    /**
+     * @brief Remove all summaries and restart the numbering at zero
+     */
+    void Clear();
+
+private:
+    /**
+     * @brief Lowest and highest value of one bucket
+     */
+    struct Extent {
+        float min;                      ///< Lowest value
+        float max;                      ///< Highest value
+    };
+
+    /**
+     * @brief Get the bucket size of a level
+     * @param level Level index
+     * @return Samples per bucket as a power of two exponent
+     */
+    static int levelShift(int level);
+
+    /**
+     * @brief Get the oldest retained bucket of a level
+     * @param level Level index
+     * @return Bucket id
+     */
+    qint64 oldestBucket(int level) const;
+
+    /**
+     * @brief Allocate the rings
+     */
+    void allocate();
+
+private:
+    std::array<std::vector<Extent>, LEVEL_COUNT> levels_;   ///< Buckets indexed by id modulo BUCKETS_PER_LEVEL
+    quint64 write_sequence_;                                ///< Sequence number of the next sample
+};
+
+#endif // DECIMATION_PYRAMID_H
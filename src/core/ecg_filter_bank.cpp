@@ -0,0 +1,141 @@
+/**
+ * @file ecg_filter_bank.cpp
+ * @brief Implementation of the EcgFilterBank class
+ *
+ * This file implements the filter design and the per-lead and planar
+ * filtering of the ECG filter bank.
+ */
+#include "ecg_filter_bank.h"
+#include <QtMath>
+#include <algorithm>
+
+/**
+ * @namespace Anonymous namespace for constants
+ * @brief Contains the filter settings used by the EcgFilterBank implementation
+ */
+namespace {
+    const int PADDED_LEADS = (EcgFilterBank::LEAD_COUNT + 3) / 4 * 4;  ///< Lead channels rounded up to a register width
+    const double NOTCH_Q = 30.0;                ///< Notch quality, about 2 Hz wide at 50/60 Hz
+    const double RATE_TOLERANCE = 0.1;          ///< Relative rate change that redesigns the sections
+}
+
+/**
+ * @brief Constructs a filter bank with all filters disabled
+ */
+EcgFilterBank::EcgFilterBank()
+    : baseline_hz_(0.0)
+    , mains_hz_(0.0)
+    , sample_rate_(0.0)
+    , cascade_(PADDED_LEADS)
+{
+}
+
+/**
+ * @brief Gets the lead index of a waveform
+ * @param waveformId VitalSync::WaveformType of the waveform
+ * @return Lead index, or -1 if the waveform is not an ECG lead
+ */
+int EcgFilterBank::GetLeadIndex(int waveformId)
+{
+    const int lead = VitalSync::GetWaveformTraits(waveformId).ecgLead;
+    return lead < LEAD_COUNT ? lead : -1;
+}
+
+/**
+ * @brief Chooses the filters
+ * @param baselineHz Cutoff of the baseline wander high-pass, 0 to disable it
+ * @param mainsHz Mains frequency to remove, 0 to disable the notch
+ *
+ * The sections are designed on the next chunk, once its sample rate is known.
+ */
+void EcgFilterBank::Configure(double baselineHz, double mainsHz)
+{
+    baseline_hz_ = std::max(baselineHz, 0.0);
+    mains_hz_ = std::max(mainsHz, 0.0);
+    sample_rate_ = 0.0;
+    cascade_.ClearStages();
+}
+
+/**
+ * @brief Checks if any filter is enabled
+ * @return True if samples are filtered
+ */
+bool EcgFilterBank::IsEnabled() const
+{
+    return baseline_hz_ > 0.0 || mains_hz_ > 0.0;
+}
+
+/**
+ * @brief Filters the samples of one lead in place
+ * @param lead Lead index
+ * @param samples Samples
+ * @param count Number of samples
+ * @param sampleRate Measured sample rate in samples per second
+ */
+void EcgFilterBank::ProcessLead(int lead, float* samples, int count, double sampleRate)
+{
+    if (lead < 0 || lead >= LEAD_COUNT || count <= 0 || !prepare(sampleRate)) {
+        return;
+    }
+    cascade_.ProcessChannel(lead, samples, count);
+}
+
+/**
+ * @brief Gets the planar block the leads of one frame are filtered in
+ * @param count Number of samples per lead
+ * @return Block of LEAD_COUNT rows of count samples
+ *
+ * The padding channels after the last lead are zeroed, so their filter
+ * memory stays at rest. The block is valid until the next call.
+ */
+float* EcgFilterBank::GetLeadBlock(int count)
+{
+    lead_block_.assign(static_cast<size_t>(PADDED_LEADS) * std::max(count, 0), 0.0f);
+    return lead_block_.data();
+}
+
+/**
+ * @brief Filters all leads of the lead block in place
+ * @param count Number of samples per lead, as passed to GetLeadBlock()
+ * @param sampleRate Measured sample rate in samples per second
+ */
+void EcgFilterBank::ProcessLeadBlock(int count, double sampleRate)
+{
+    if (count <= 0 || lead_block_.size() < static_cast<size_t>(PADDED_LEADS) * count || !prepare(sampleRate)) {
+        return;
+    }
+    cascade_.Process(lead_block_.data(), count, count);
+}
+
+/**
+ * @brief Clears the filter memory of all leads
+ */
+void EcgFilterBank::Reset()
+{
+    cascade_.Reset();
+}
+
+/**
+ * @brief Designs the sections for a sample rate if it changed noticeably
+ * @param sampleRate Measured sample rate in samples per second
+ * @return False if no filter is enabled or the rate cannot carry the notch
+ */
+bool EcgFilterBank::prepare(double sampleRate)
+{
+    if (!IsEnabled() || sampleRate <= 2.0 * mains_hz_ || sampleRate <= 2.0 * baseline_hz_) {
+        return false;
+    }
+    if (sample_rate_ > 0.0 && qAbs(sampleRate - sample_rate_) <= sample_rate_ * RATE_TOLERANCE) {
+        return true;
+    }
+
+    sample_rate_ = sampleRate;
+    cascade_.ClearStages();
+    if (baseline_hz_ > 0.0) {
+        cascade_.AddStage(BiquadCascade::HighPass(sampleRate, baseline_hz_));
+    }
+    if (mains_hz_ > 0.0) {
+        cascade_.AddStage(BiquadCascade::Notch(sampleRate, mains_hz_, NOTCH_Q));
+    }
+    return true;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file ecg_filter_bank.h
+ * @brief Definition of the EcgFilterBank class
+ *
+ * This file contains the definition of the EcgFilterBank class which removes
+ * baseline wander and mains interference from all ECG leads of a bed.
+ */
+#ifndef ECG_FILTER_BANK_H
+#define ECG_FILTER_BANK_H
+
+#include "../../include/vital_sync_types.h"
+#include "../utils/biquad_cascade.h"
+#include <vector>
+
+/**
+ * @brief Baseline wander and mains notch filters for the ECG leads
+ *
+ * Every lead passes a second-order high-pass against baseline wander and a
+ * notch at the mains frequency. The leads share one BiquadCascade with a
+ * channel per lead, padded to a multiple of four so that the vectorized
+ * kernel covers all of them. The leads of one frame are copied into the
+ * bank's lead block and filtered together; a lead arriving on its own is
+ * filtered by itself with the same filter memory.
+ *
+ * The sections are designed for the measured sample rate and redesigned,
+ * with cleared memory, when it changes by more than 10 percent. Not
+ * thread-safe; used on the acquisition thread.
+ */
+class EcgFilterBank {
+public:
+    /// Number of ECG leads the bank filters
+    static constexpr int LEAD_COUNT = static_cast<int>(VitalSync::WaveformType::ECG_III)
+                                    - static_cast<int>(VitalSync::WaveformType::ECG_I) + 1;
+
+    /**
+     * @brief Constructor, with all filters disabled
+     */
+    EcgFilterBank();
+
+    /**
+     * @brief Get the lead index of a waveform
+     * @param waveformId VitalSync::WaveformType of the waveform
+     * @return Lead index, or -1 if the waveform is not an ECG lead
+     */
+    static int GetLeadIndex(int waveformId);
+
+    /**
+     * @brief Choose the filters
+     * @param baselineHz Cutoff of the baseline wander high-pass, 0 to disable it
+     * @param mainsHz Mains frequency to remove, 0 to disable the notch
+     */
+    void Configure(double baselineHz, double mainsHz);
+
+    /**
+     * @brief Check if any filter is enabled
+     * @return True if samples are filtered
+     */
+    bool IsEnabled() const;
+
+    /**
+     * @brief Filter the samples of one lead in place
+     * @param lead Lead index
+     * @param samples Samples
+     * @param count Number of samples
+     * @param sampleRate Measured sample rate in samples per second
+     */
+    void ProcessLead(int lead, float* samples, int count, double sampleRate);
+
+    /**
+     * @brief Get the planar block the leads of one frame are filtered in
+     * @param count Number of samples per lead
+     * @return Block of LEAD_COUNT rows of count samples, lead l starting at l * count
+     */
+    float* GetLeadBlock(int count);
+
+    /**
+     * @brief Filter all leads of the lead block in place
+     * @param count Number of samples per lead, as passed to GetLeadBlock()
+     * @param sampleRate Measured sample rate in samples per second
+     */
+    void ProcessLeadBlock(int count, double sampleRate);
+
+    /**
+     * @brief Clear the filter memory of all leads
+     */
+    void Reset();
+
+private:
+    /**
+     * @brief Design the sections for a sample rate if it changed noticeably
+     * @param sampleRate Measured sample rate in samples per second
+     * @return False if the rate is too low for the configured filters
+     */
+    bool prepare(double sampleRate);
+
+private:
+    double baseline_hz_;                ///< High-pass cutoff, 0 when disabled
+    double mains_hz_;                   ///< Notch frequency, 0 when disabled
+    double sample_rate_;                ///< Rate the sections are designed for, 0 until designed
+    BiquadCascade cascade_;             ///< Sections with one padded channel per lead
+    std::vector<float> lead_block_;     ///< Planar block of all lead and padding channels
+};
+
+#endif // ECG_FILTER_BANK_H
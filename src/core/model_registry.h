@@ -0,0 +1,107 @@
+/**
+ * @file model_registry.h
+ * @brief Definition of the ModelRegistry class template
+ *
+ * This file contains a fixed-size table of models indexed directly by their
+ * waveform or parameter type, which the ingest path reads without locks or
+ * reference counting.
+ */
+#ifndef MODEL_REGISTRY_H
+#define MODEL_REGISTRY_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Dense, type-indexed table of models
+ *
+ * Every slot is filled at most once and its model stays in place until the
+ * registry is destroyed. That is what makes Get() safe without a lock: it is
+ * a bounds check and an acquire load of a raw pointer, and the pointer stays
+ * valid for the registry's lifetime. Models are owned by the registry;
+ * GetShared() hands out additional owners for views and other long-lived
+ * users.
+ *
+ * Add() is meant for initialization and must not be called by several
+ * threads at once; Get() and GetShared() may be called from any thread.
+ *
+ * @tparam Model Model interface type
+ * @tparam Count Number of slots, the number of types of the enumeration
+ */
+template <typename Model, int Count>
+class ModelRegistry
+{
+public:
+    static constexpr int SIZE = Count;  ///< Number of slots
+
+    ModelRegistry() = default;
+    ModelRegistry(const ModelRegistry&) = delete;
+    ModelRegistry& operator=(const ModelRegistry&) = delete;
+
+    /**
+     * @brief Put a model into an empty slot
+     * @param id Type identifier, the slot index
+     * @param model Model to own
+     * @return False if the identifier is out of range, the model is null or
+     *         the slot is already filled
+     */
+    bool Add(int id, std::shared_ptr<Model> model)
+    {
+        if (!model || id < 0 || id >= Count || owners_[id]) {
+            return false;
+        }
+
+        // The owner is in place before the pointer is published
+        owners_[id] = std::move(model);
+        models_[id].store(owners_[id].get(), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Get the model of a type without taking ownership
+     * @param id Type identifier
+     * @return The model, or nullptr if the identifier is out of range or has no model
+     */
+    Model* Get(int id) const
+    {
+        if (id < 0 || id >= Count) {
+            return nullptr;
+        }
+        return models_[id].load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get the model of a type as an additional owner
+     * @param id Type identifier
+     * @return The model, or nullptr if the identifier is out of range or has no model
+     */
+    std::shared_ptr<Model> GetShared(int id) const
+    {
+        // A published pointer means the owner was written and never changes again
+        return Get(id) ? owners_[id] : nullptr;
+    }
+
+    /**
+     * @brief Get all models
+     * @return The models of all filled slots, in type order
+     */
+    std::vector<std::shared_ptr<Model>> GetAll() const
+    {
+        std::vector<std::shared_ptr<Model>> result;
+        result.reserve(Count);
+        for (int id = 0; id < Count; ++id) {
+            if (Get(id)) {
+                result.push_back(owners_[id]);
+            }
+        }
+        return result;
+    }
+
+private:
+    std::array<std::shared_ptr<Model>, Count> owners_;      ///< Owners of the models, written once per slot
+    std::array<std::atomic<Model*>, Count> models_ = {};    ///< Published models, null for empty slots
+};
+
+#endif // MODEL_REGISTRY_H
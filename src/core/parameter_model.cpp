@@ -10,6 +10,7 @@
  */
 #include "parameter_model.h"
 #include "../../include/config_manager.h"
+#include "../utils/log_categories.h"
 #include <QDebug>
 
 /**
@@ -24,21 +25,20 @@
 ParameterModel::ParameterModel(VitalSync::ParameterType parameterType, QObject* parent)
     : IParameterModel(parent)
     , parameter_type_(parameterType)
+    , display_name_(VitalSync::GetParameterDisplayName(parameterType))
+    , unit_(VitalSync::GetParameterUnit(parameterType))
     , value_(0.0f)
     , alarm_state_(AlarmState::Normal)
     , active_(false)
 {
-    // Get default range for this parameter type
-    auto range = VitalSync::GetDefaultParameterRange(parameterType);
-    min_value_ = range.first;
-    max_value_ = range.second;
-    
-    // Get default alarm limits
-    auto limits = VitalSync::GetDefaultAlarmLimits(parameterType);
-    low_critical_ = std::get<0>(limits);
-    low_warning_ = std::get<1>(limits);
-    high_warning_ = std::get<2>(limits);
-    high_critical_ = std::get<3>(limits);
+    // Get default range and alarm limits for this parameter type
+    const VitalSync::ParameterTraits& traits = VitalSync::GetParameterTraits(parameterType);
+    min_value_ = traits.minValue;
+    max_value_ = traits.maxValue;
+    low_critical_ = traits.lowCritical;
+    low_warning_ = traits.lowWarning;
+    high_warning_ = traits.highWarning;
+    high_critical_ = traits.highCritical;
     
     // Default color is yellow
     color_ = Qt::yellow;
@@ -127,7 +127,7 @@ int ParameterModel::GetParameterId() const
  */
 QString ParameterModel::GetDisplayName() const
 {
-    return VitalSync::GetParameterDisplayName(parameter_type_);
+    return display_name_;
 }
 
 /**
@@ -138,7 +138,7 @@ QString ParameterModel::GetDisplayName() const
  */
 QString ParameterModel::GetUnit() const
 {
-    return VitalSync::GetParameterUnit(parameter_type_);
+    return unit_;
 }
 
 /**
@@ -226,7 +226,7 @@ float ParameterModel::GetMaxValue() const
  * @return Current alarm state
  * 
  * Returns the current alarm state (Normal, LowWarning, LowCritical,
- * HighWarning, HighCritical) based on the parameter value and thresholds.
+ * HighWarning, HighCritical) last set by the alarm evaluation.
  */
 IParameterModel::AlarmState ParameterModel::GetAlarmState() const
 {
@@ -234,6 +234,36 @@ IParameterModel::AlarmState ParameterModel::GetAlarmState() const
     return alarm_state_;
 }
 
+/**
+ * @brief Sets the alarm state decided by the alarm evaluation
+ * @param state New alarm state
+ * 
+ * Called by the data manager on the acquisition thread. No signal is
+ * emitted; views poll the state and the data manager announces all changes
+ * of a frame together.
+ */
+void ParameterModel::SetAlarmState(AlarmState state)
+{
+    QWriteLocker locker(&lock_);
+    alarm_state_ = state;
+}
+
+/**
+ * @brief Gets the trend of this parameter over a time window
+ * @param resolution Resolution of the trend
+ * @param fromTimestamp Start of the window in milliseconds since epoch, inclusive
+ * @param toTimestamp End of the window in milliseconds since epoch, exclusive
+ * @return Trend points in time order
+ * 
+ * Reads only the rollup buckets of the window, so even a 30 day trend of
+ * hours costs a few hundred bucket reads under the read lock.
+ */
+QVector<TrendPoint> ParameterModel::GetTrend(TrendResolution resolution, qint64 fromTimestamp, qint64 toTimestamp) const
+{
+    QReadLocker locker(&lock_);
+    return trend_.Query(resolution, fromTimestamp, toTimestamp);
+}
+
 /**
  * @brief Checks if this parameter is active
  * @return True if the parameter is active
@@ -248,55 +278,53 @@ bool ParameterModel::isActive() const
 }
 
 /**
- * @brief Updates the parameter value and recalculates the alarm state
+ * @brief Updates the parameter value
  * @param timestamp Timestamp of the new value in milliseconds since epoch
  * @param new_value The new parameter value
  * 
- * Updates the parameter with a new value, calculates the appropriate alarm state
- * based on the current alarm thresholds, and emits signals if the value or alarm
- * state has changed.
+ * Updates the parameter with a new value and emits signals if the value has
+ * changed. The alarm state is decided by the data manager's alarm evaluation.
  */
 void ParameterModel::UpdateValue(qint64 timestamp, float new_value)
 {
     // Store old values for comparison
-    float old_value = value_;
-    AlarmState old_alarm_state = alarm_state_;
+    float old_value;
+    AlarmState alarm_state;
+    bool active;
     
-    // Check limits and update alarm state
-    if (new_value > high_critical_) {
-        alarm_state_ = AlarmState::HighCritical;
-    } else if (new_value > high_warning_) {
-        alarm_state_ = AlarmState::HighWarning;
-    } else if (new_value < low_critical_) {
-        alarm_state_ = AlarmState::LowCritical;
-    } else if (new_value < low_warning_) {
-        alarm_state_ = AlarmState::LowWarning;
-    } else {
-        alarm_state_ = AlarmState::Normal;
+    {
+        // Updates may arrive on the acquisition thread while views read
+        QWriteLocker locker(&lock_);
+        old_value = value_;
+        
+        // Update value and timestamp
+        value_ = new_value;
+        timestamp_ = (timestamp > 0) ? 
+            QDateTime::fromMSecsSinceEpoch(timestamp) : 
+            QDateTime::currentDateTime();
+        
+        // Fold the value into the trend rollups
+        trend_.Add(timestamp > 0 ? timestamp : timestamp_.toMSecsSinceEpoch(), new_value);
+        
+        alarm_state = alarm_state_;
+        active = active_;
     }
     
-    // Update value and timestamp
-    value_ = new_value;
-    timestamp_ = (timestamp > 0) ? 
-        QDateTime::fromMSecsSinceEpoch(timestamp) : 
-        QDateTime::currentDateTime();
-    
     // Log the update with more details
-    qDebug() << "ParameterModel: " << GetDisplayName() 
-             << "UPDATED from" << old_value << "to" << value_ << GetUnit()
-             << "at" << GetTimestamp().toString("hh:mm:ss.zzz")
-             << "- Alarm state:" << static_cast<int>(alarm_state_)
-             << "- Active:" << active_;
+    VITALSYNC_TRACE(lcIngest) << "ParameterModel: " << GetDisplayName()
+                              << "UPDATED from" << old_value << "to" << new_value << GetUnit()
+                              << "at" << GetTimestamp().toString("hh:mm:ss.zzz")
+                              << "- Alarm state:" << static_cast<int>(alarm_state)
+                              << "- Active:" << active;
     
-    // Emit signal if value or alarm state changed
-    bool value_changed = (old_value != value_);
-    bool alarm_changed = (old_alarm_state != alarm_state_);
+    // Emit signal if the value changed
+    bool value_changed = (old_value != new_value);
     
-    if (value_changed || alarm_changed) {
-        qDebug() << "ParameterModel: Emitting propertiesChanged for" << GetDisplayName();
+    if (value_changed) {
+        VITALSYNC_TRACE(lcIngest) << "ParameterModel: Emitting propertiesChanged for" << GetDisplayName();
         emit propertiesChanged();
     } else {
-        qDebug() << "ParameterModel: No change in value or alarm state for" << GetDisplayName();
+        VITALSYNC_TRACE(lcIngest) << "ParameterModel: No change in value for" << GetDisplayName();
     }
 }
 
@@ -307,30 +335,31 @@ void ParameterModel::UpdateValue(qint64 timestamp, float new_value)
  * @param highWarning Warning high threshold that triggers a medium-priority alarm
  * @param highCritical Critical high threshold that triggers a high-priority alarm
  * 
- * Sets the alarm threshold limits and recalculates the current alarm state based
- * on the new thresholds. Emits signals if the alarm state changes.
+ * Stores the alarm threshold limits, which are saved with the configuration.
+ * The alarm evaluation of the data manager applies them; the current alarm
+ * state is left to the next evaluation.
  */
 void ParameterModel::SetAlarmLimits(float lowCritical, float lowWarning, float highWarning, float highCritical)
 {
-    AlarmState oldState;
-    
     {
         QWriteLocker locker(&lock_);
-        oldState = alarm_state_;
-        
         low_critical_ = lowCritical;
         low_warning_ = lowWarning;
         high_warning_ = highWarning;
         high_critical_ = highCritical;
-        
-        UpdateAlarmState();
     }
     
     emit propertiesChanged();
-    
-    if (oldState != alarm_state_) {
-        emit alarmStateChanged(alarm_state_);
-    }
+}
+
+/**
+ * @brief Gets the alarm threshold limits of the parameter
+ * @return Low critical, low warning, high warning and high critical limit
+ */
+std::tuple<float, float, float, float> ParameterModel::GetAlarmLimits() const
+{
+    QReadLocker locker(&lock_);
+    return { low_critical_, low_warning_, high_warning_, high_critical_ };
 }
 
 /**
@@ -353,30 +382,4 @@ void ParameterModel::SetActive(bool active)
     
     emit activeStateChanged(active);
     emit propertiesChanged();
-}
-
-/**
- * @brief Recalculates the alarm state based on current value and thresholds
- * 
- * Internal method that determines the appropriate alarm state
- * (Normal, LowWarning, LowCritical, HighWarning, HighCritical)
- * based on the current parameter value and the configured alarm thresholds.
- * Called after value updates or when alarm thresholds change.
- */
-void ParameterModel::UpdateAlarmState()
-{
-    // Determine the alarm state based on the current value and limits
-    AlarmState newState = AlarmState::Normal;
-    
-    if (value_ <= low_critical_) {
-        newState = AlarmState::LowCritical;
-    } else if (value_ <= low_warning_) {
-        newState = AlarmState::LowWarning;
-    } else if (value_ >= high_critical_) {
-        newState = AlarmState::HighCritical;
-    } else if (value_ >= high_warning_) {
-        newState = AlarmState::HighWarning;
-    }
-    
-    alarm_state_ = newState;
 } 
\ No newline at end of file
@@ -13,6 +13,7 @@
 
 #include "../../include/i_parameter_model.h"
 #include "../../include/vital_sync_types.h"
+#include "trend_store.h"
 #include <QReadWriteLock>
 #include <QDateTime>
 
@@ -99,6 +100,12 @@ public:
      */
     AlarmState GetAlarmState() const override;
 
+    /**
+     * @brief Set the alarm state decided by the alarm evaluation
+     * @param state New alarm state
+     */
+    void SetAlarmState(AlarmState state) override;
+
     /**
      * @brief Update the parameter value
      * @param timestamp Timestamp of the new value
@@ -115,6 +122,21 @@ public:
      */
     void SetAlarmLimits(float lowCritical, float lowWarning, float highWarning, float highCritical) override;
 
+    /**
+     * @brief Get the alarm limits of this parameter
+     * @return Low critical, low warning, high warning and high critical limit
+     */
+    std::tuple<float, float, float, float> GetAlarmLimits() const override;
+
+    /**
+     * @brief Get the trend of this parameter over a time window
+     * @param resolution Resolution of the trend
+     * @param fromTimestamp Start of the window in milliseconds since epoch, inclusive
+     * @param toTimestamp End of the window in milliseconds since epoch, exclusive
+     * @return Trend points in time order
+     */
+    QVector<TrendPoint> GetTrend(TrendResolution resolution, qint64 fromTimestamp, qint64 toTimestamp) const override;
+
     /**
      * @brief Check if this parameter is active
      * @return True if the parameter is active
@@ -163,29 +185,22 @@ signals:
      */
     void onActiveStateChanged(bool active);
 
-private:
-    /**
-     * @brief Updates the alarm state based on current value and thresholds
-     * 
-     * Evaluates the current parameter value against the defined alarm thresholds
-     * and updates the alarm state accordingly. Emits the onAlarmStateChanged signal
-     * if the state changes as a result of this evaluation.
-     */
-    void UpdateAlarmState();
-
 private:
     VitalSync::ParameterType parameter_type_;  ///< Type of physiological parameter this model represents
+    const QString display_name_;              ///< Display name, fixed by the parameter type
+    const QString unit_;                      ///< Unit of measurement, fixed by the parameter type
     float value_;                             ///< Current parameter value
     QDateTime timestamp_;                     ///< Timestamp of the most recent value update
     QColor color_;                            ///< Display color for this parameter
     float min_value_;                         ///< Minimum expected value in normal range
     float max_value_;                         ///< Maximum expected value in normal range
-    AlarmState alarm_state_;                  ///< Current alarm state based on thresholds
+    AlarmState alarm_state_;                  ///< Current alarm state as decided by the alarm evaluation
     float low_critical_;                      ///< Low critical alarm threshold
     float low_warning_;                       ///< Low warning alarm threshold
     float high_warning_;                      ///< High warning alarm threshold
     float high_critical_;                     ///< High critical alarm threshold
     bool active_;                             ///< Whether this parameter is active and being monitored
+    TrendStore trend_;                        ///< History of the values at several resolutions
     
     mutable QReadWriteLock lock_;             ///< Thread safety lock for concurrent read/write access
 };
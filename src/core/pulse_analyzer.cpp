@@ -0,0 +1,204 @@
+/**
+ * @file pulse_analyzer.cpp
+ * @brief Implementation of the PulseAnalyzer class
+ *
+ * This file implements the envelope tracking, beat segmentation and beat
+ * measurements of the streaming pulse analyzer.
+ */
+#include "pulse_analyzer.h"
+#include <QtMath>
+#include <limits>
+
+/**
+ * @namespace Anonymous namespace for constants
+ * @brief Contains the tuning constants used by the PulseAnalyzer implementation
+ */
+namespace {
+    const double SMOOTHING_CUTOFF_HZ = 10.0;       ///< Cutoff of the smoothing stage
+    const double ENVELOPE_TIME_CONSTANT_S = 1.5;   ///< Time for the envelope to relax toward the signal
+    const double MIN_SAMPLE_RATE = 20.0;           ///< Lowest sample rate analyzed
+    const double RATE_TOLERANCE = 0.1;             ///< Relative rate change that restarts analysis
+    const int REFRACTORY_MS = 250;                 ///< Shortest time between two beats
+    const int MAX_INTERVAL_MS = 3000;              ///< Longest beat interval counted, 20 bpm
+    const float UPPER_CROSSING = 0.6f;             ///< Envelope fraction a rising signal must pass to start a beat
+    const float LOWER_CROSSING = 0.4f;             ///< Envelope fraction a falling signal must pass to rearm
+}
+
+/**
+ * @brief Constructs an analyzer for one pulsatile waveform
+ * @param waveformId VitalSync::WaveformType to analyze
+ * @param priority Precedence of the derived values
+ * @param outputs Parameters the measurements are reported as
+ * @param scale Factor converting samples to the unit of the outputs
+ * @param minimumAmplitude Smallest beat reported, in the unit of the outputs
+ */
+PulseAnalyzer::PulseAnalyzer(int waveformId, int priority, const Outputs& outputs, float scale, float minimumAmplitude)
+    : waveform_id_(waveformId)
+    , priority_(priority)
+    , outputs_(outputs)
+    , scale_(scale)
+    , minimum_amplitude_(minimumAmplitude)
+{
+    Reset();
+}
+
+/**
+ * @brief Processes one chunk of samples
+ * @param samples Pointer to the samples
+ * @param count Number of samples
+ * @param sampleRate Measured sample rate in samples per second
+ * @param out Receives the measurements if the chunk completed a beat
+ *
+ * Only the most recent beat of the chunk is reported. The pulse rate is
+ * reported once an interval has been measured.
+ */
+void PulseAnalyzer::Process(const float* samples, int count, double sampleRate, Output& out)
+{
+    if (!samples || count <= 0 || sampleRate < MIN_SAMPLE_RATE) {
+        return;
+    }
+    if (sample_rate_ <= 0.0 || qAbs(sampleRate - sample_rate_) > sample_rate_ * RATE_TOLERANCE) {
+        configure(sampleRate);
+    }
+
+    bool beat = false;
+    for (int i = 0; i < count; ++i) {
+        const float x = samples[i] * scale_;
+        if (!primed_) {
+            smoothed_ = envelope_max_ = envelope_min_ = x;
+            primed_ = true;
+        }
+        smoothed_ += smoothing_alpha_ * (x - smoothed_);
+
+        // Envelope following the extremes and relaxing toward each other otherwise
+        const float span = envelope_max_ - envelope_min_;
+        envelope_max_ = smoothed_ > envelope_max_ ? smoothed_ : envelope_max_ - span * envelope_decay_;
+        envelope_min_ = smoothed_ < envelope_min_ ? smoothed_ : envelope_min_ + span * envelope_decay_;
+
+        // Beat measurements use the raw samples so peaks are not flattened
+        beat_max_ = qMax(beat_max_, x);
+        beat_min_ = qMin(beat_min_, x);
+        beat_sum_ += x;
+        ++beat_samples_;
+
+        const float amplitude = envelope_max_ - envelope_min_;
+        if (!above_ && smoothed_ > envelope_min_ + UPPER_CROSSING * amplitude) {
+            above_ = true;
+            beat |= closeBeat(sample_index_);
+        } else if (above_ && smoothed_ < envelope_min_ + LOWER_CROSSING * amplitude) {
+            above_ = false;
+        }
+        ++sample_index_;
+    }
+
+    if (!beat) {
+        return;
+    }
+    if (outputs_.maximum >= 0) {
+        out.append(VitalSync::FrameParameter{ outputs_.maximum, last_max_ });
+    }
+    if (outputs_.minimum >= 0) {
+        out.append(VitalSync::FrameParameter{ outputs_.minimum, last_min_ });
+    }
+    if (outputs_.mean >= 0) {
+        out.append(VitalSync::FrameParameter{ outputs_.mean, last_mean_ });
+    }
+    if (outputs_.rate >= 0 && interval_count_ > 0) {
+        const float rate = static_cast<float>(60.0 * sample_rate_ * interval_count_ / interval_sum_);
+        out.append(VitalSync::FrameParameter{ outputs_.rate, rate });
+    }
+}
+
+/**
+ * @brief Forgets all signal history
+ *
+ * The analyzer is tuned again on the next chunk.
+ */
+void PulseAnalyzer::Reset()
+{
+    sample_rate_ = 0.0;
+    smoothing_alpha_ = 1.0f;
+    envelope_decay_ = 0.0f;
+    refractory_samples_ = 0;
+    max_interval_samples_ = 0;
+    configure(0.0);
+}
+
+/**
+ * @brief Tunes the smoothing and windows to a sample rate and restarts analysis
+ * @param sampleRate Sample rate in samples per second, 0 to only clear the state
+ */
+void PulseAnalyzer::configure(double sampleRate)
+{
+    if (sampleRate > 0.0) {
+        sample_rate_ = sampleRate;
+        smoothing_alpha_ = static_cast<float>(1.0 - qExp(-2.0 * M_PI * SMOOTHING_CUTOFF_HZ / sampleRate));
+        envelope_decay_ = static_cast<float>(1.0 / (2.0 * ENVELOPE_TIME_CONSTANT_S * sampleRate));
+        refractory_samples_ = qRound64(sampleRate * REFRACTORY_MS / 1000.0);
+        max_interval_samples_ = qRound64(sampleRate * MAX_INTERVAL_MS / 1000.0);
+    }
+
+    primed_ = false;
+    smoothed_ = 0.0f;
+    envelope_max_ = 0.0f;
+    envelope_min_ = 0.0f;
+    above_ = false;
+
+    sample_index_ = 0;
+    beat_start_ = -1;
+    beat_max_ = -std::numeric_limits<float>::max();
+    beat_min_ = std::numeric_limits<float>::max();
+    beat_sum_ = 0.0;
+    beat_samples_ = 0;
+
+    last_max_ = 0.0f;
+    last_min_ = 0.0f;
+    last_mean_ = 0.0f;
+
+    intervals_.fill(0);
+    interval_count_ = 0;
+    interval_position_ = 0;
+    interval_sum_ = 0;
+}
+
+/**
+ * @brief Closes the current beat at the start of the next one
+ * @param index Sample index of the new beat
+ * @return True if the closed beat was complete and large enough
+ *
+ * Crossings within the refractory period continue the current beat. A beat
+ * longer than the plausible maximum, or the partial beat before the first
+ * crossing, only starts a new measurement and restarts the rate.
+ */
+bool PulseAnalyzer::closeBeat(qint64 index)
+{
+    const qint64 interval = beat_start_ >= 0 ? index - beat_start_ : -1;
+    if (interval >= 0 && interval < refractory_samples_) {
+        return false;
+    }
+
+    const bool complete = interval >= 0 && interval <= max_interval_samples_;
+    const bool large = beat_max_ - beat_min_ >= minimum_amplitude_;
+    if (complete && large) {
+        last_max_ = beat_max_;
+        last_min_ = beat_min_;
+        last_mean_ = static_cast<float>(beat_sum_ / beat_samples_);
+
+        interval_sum_ += interval - intervals_[static_cast<size_t>(interval_position_)];
+        intervals_[static_cast<size_t>(interval_position_)] = interval;
+        interval_position_ = (interval_position_ + 1) % INTERVAL_HISTORY;
+        interval_count_ = qMin(interval_count_ + 1, INTERVAL_HISTORY);
+    } else if (!complete) {
+        intervals_.fill(0);
+        interval_count_ = 0;
+        interval_position_ = 0;
+        interval_sum_ = 0;
+    }
+
+    beat_start_ = index;
+    beat_max_ = -std::numeric_limits<float>::max();
+    beat_min_ = std::numeric_limits<float>::max();
+    beat_sum_ = 0.0;
+    beat_samples_ = 0;
+    return complete && large;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file pulse_analyzer.h
+ * @brief Definition of the PulseAnalyzer class
+ *
+ * This file contains the definition of the PulseAnalyzer class, a streaming
+ * beat analyzer for pulsatile waveforms such as arterial pressure and
+ * plethysmography.
+ */
+#ifndef PULSE_ANALYZER_H
+#define PULSE_ANALYZER_H
+
+#include "waveform_processor.h"
+#include <array>
+
+/**
+ * @brief Streaming beat analyzer for pulsatile waveforms
+ *
+ * The signal is lightly smoothed and followed by a slowly decaying minimum
+ * and maximum envelope. A beat starts where the signal rises through the
+ * middle of the envelope, with hysteresis and a 250 ms refractory period.
+ * For every complete beat the analyzer knows the peak, the trough and the
+ * mean of the samples in between, which for arterial pressure are the
+ * systolic, diastolic and mean pressure, and the beat-to-beat interval,
+ * averaged over the last four beats, gives the pulse rate.
+ *
+ * Each output can be mapped to a parameter or disabled, so one class covers
+ * both pressure and plethysmography channels. Beats smaller than the minimum
+ * amplitude, such as a flushed or disconnected line, are not reported. State
+ * is fixed-size and the work per sample is constant.
+ */
+class PulseAnalyzer : public WaveformProcessor {
+public:
+    /**
+     * @brief Parameters the beat measurements are reported as, -1 to disable one
+     */
+    struct Outputs {
+        int rate = -1;          ///< Pulse rate in beats per minute
+        int maximum = -1;       ///< Peak of the beat, systolic pressure
+        int minimum = -1;       ///< Trough of the beat, diastolic pressure
+        int mean = -1;          ///< Mean over the beat, mean arterial pressure
+    };
+
+    /**
+     * @brief Constructor
+     * @param waveformId VitalSync::WaveformType to analyze
+     * @param priority Precedence of the derived values
+     * @param outputs Parameters the measurements are reported as
+     * @param scale Factor converting samples to the unit of the outputs
+     * @param minimumAmplitude Smallest beat reported, in the unit of the outputs
+     */
+    PulseAnalyzer(int waveformId, int priority, const Outputs& outputs, float scale, float minimumAmplitude);
+
+    /**
+     * @brief Get the waveform this processor analyzes
+     * @return VitalSync::WaveformType of the input
+     */
+    int GetWaveformId() const override { return waveform_id_; }
+
+    /**
+     * @brief Get the precedence of the derived values
+     * @return Priority given at construction
+     */
+    int GetPriority() const override { return priority_; }
+
+    /**
+     * @brief Process one chunk of samples
+     * @param samples Pointer to the samples
+     * @param count Number of samples
+     * @param sampleRate Measured sample rate in samples per second
+     * @param out Receives the measurements if the chunk completed a beat
+     */
+    void Process(const float* samples, int count, double sampleRate, Output& out) override;
+
+    /**
+     * @brief Forget all signal history
+     */
+    void Reset() override;
+
+private:
+    static constexpr int INTERVAL_HISTORY = 4;      ///< Beat intervals averaged for the rate
+
+    /**
+     * @brief Tune the smoothing and windows to a sample rate and restart analysis
+     * @param sampleRate Sample rate in samples per second, 0 to only clear the state
+     */
+    void configure(double sampleRate);
+
+    /**
+     * @brief Close the current beat at the start of the next one
+     * @param index Sample index of the new beat
+     * @return True if the closed beat was complete and large enough
+     */
+    bool closeBeat(qint64 index);
+
+private:
+    const int waveform_id_;                         ///< Waveform analyzed
+    const int priority_;                            ///< Precedence of the derived values
+    const Outputs outputs_;                         ///< Parameters the measurements are reported as
+    const float scale_;                             ///< Sample to output unit factor
+    const float minimum_amplitude_;                 ///< Smallest beat reported
+
+    // Tuning
+    double sample_rate_;                            ///< Rate the analyzer is tuned to, 0 until configured
+    float smoothing_alpha_;                         ///< Smoothing factor of the low-pass stage
+    float envelope_decay_;                          ///< Per-sample relaxation of the envelope
+    qint64 refractory_samples_;                     ///< Shortest time between two beats
+    qint64 max_interval_samples_;                   ///< Longest plausible beat interval
+
+    // Envelope
+    bool primed_;                                   ///< Whether the first sample has been seen
+    float smoothed_;                                ///< Smoothed signal
+    float envelope_max_;                            ///< Decaying maximum
+    float envelope_min_;                            ///< Decaying minimum
+    bool above_;                                    ///< Whether the signal is in the upper half of the envelope
+
+    // Current beat
+    qint64 sample_index_;                           ///< Samples processed since the last restart
+    qint64 beat_start_;                             ///< Sample index the current beat started at, -1 before the first
+    float beat_max_;                                ///< Peak of the current beat
+    float beat_min_;                                ///< Trough of the current beat
+    double beat_sum_;                               ///< Sum of the samples of the current beat
+    qint64 beat_samples_;                           ///< Samples in the current beat
+
+    // Last complete beat
+    float last_max_;                                ///< Peak of the last complete beat
+    float last_min_;                                ///< Trough of the last complete beat
+    float last_mean_;                               ///< Mean of the last complete beat
+
+    // Rate
+    std::array<qint64, INTERVAL_HISTORY> intervals_; ///< Recent beat intervals in samples
+    int interval_count_;                            ///< Number of valid intervals
+    int interval_position_;                         ///< Slot of the next interval
+    qint64 interval_sum_;                           ///< Sum of the valid intervals
+};
+
+#endif // PULSE_ANALYZER_H
@@ -0,0 +1,219 @@
+/**
+ * @file qrs_detector.cpp
+ * @brief Implementation of the QrsDetector class
+ *
+ * This file implements the filter stages, the adaptive peak classification
+ * and the RR averaging of the streaming QRS detector.
+ */
+#include "qrs_detector.h"
+#include <QtMath>
+
+/**
+ * @namespace Anonymous namespace for constants
+ * @brief Contains the tuning constants used by the QrsDetector implementation
+ */
+namespace {
+    const double LOW_PASS_CUTOFF_HZ = 15.0;        ///< Upper edge of the QRS band
+    const double HIGH_PASS_CUTOFF_HZ = 5.0;        ///< Lower edge of the QRS band
+    const double MIN_SAMPLE_RATE = 50.0;           ///< Lowest sample rate analyzed
+    const double RATE_TOLERANCE = 0.1;             ///< Relative rate change that restarts detection
+    const int MWI_WINDOW_MS = 150;                 ///< Moving window integration length
+    const int REFRACTORY_MS = 200;                 ///< Shortest time between two beats
+    const int MIN_RR_MS = 250;                     ///< Shortest RR interval counted, 240 bpm
+    const int MAX_RR_MS = 3000;                    ///< Longest RR interval counted, 20 bpm
+    const int LEARNING_MS = 2000;                  ///< Learning phase seeding the thresholds
+    const float PEAK_WEIGHT = 0.125f;              ///< Weight of a new peak in the running peak levels
+    const float THRESHOLD_FRACTION = 0.25f;        ///< Position of the threshold between noise and signal level
+    const float MISSED_BEAT_FACTOR = 1.66f;        ///< RR multiple after which a beat counts as overdue
+}
+
+/**
+ * @brief Constructs a detector for one ECG lead
+ * @param waveformId VitalSync::WaveformType of the ECG lead to analyze
+ * @param heartRateId VitalSync::ParameterType the heart rate is reported as
+ *
+ * The stages are tuned on the first chunk, once the sample rate is known.
+ */
+QrsDetector::QrsDetector(int waveformId, int heartRateId)
+    : waveform_id_(waveformId)
+    , heart_rate_id_(heartRateId)
+{
+    Reset();
+}
+
+/**
+ * @brief Processes one chunk of ECG samples
+ * @param samples Pointer to the samples
+ * @param count Number of samples
+ * @param sampleRate Measured sample rate in samples per second
+ * @param out Receives the heart rate if the chunk contained a beat
+ *
+ * Only the most recent rate of the chunk is reported, so a burst of samples
+ * yields at most one value.
+ */
+void QrsDetector::Process(const float* samples, int count, double sampleRate, Output& out)
+{
+    if (!samples || count <= 0 || sampleRate < MIN_SAMPLE_RATE) {
+        return;
+    }
+    if (sample_rate_ <= 0.0 || qAbs(sampleRate - sample_rate_) > sample_rate_ * RATE_TOLERANCE) {
+        configure(sampleRate);
+    }
+
+    bool beat = false;
+    for (int i = 0; i < count; ++i) {
+        // Band-pass: two low-pass stages followed by a high-pass stage
+        const float x = samples[i];
+        low_pass_1_ += low_pass_alpha_ * (x - low_pass_1_);
+        low_pass_2_ += low_pass_alpha_ * (low_pass_1_ - low_pass_2_);
+        high_pass_ = high_pass_alpha_ * (high_pass_ + low_pass_2_ - high_pass_input_);
+        high_pass_input_ = low_pass_2_;
+
+        // Five-point derivative and squaring
+        const float slope = (2.0f * high_pass_ + derivative_history_[0]
+                             - derivative_history_[2] - 2.0f * derivative_history_[3]) * 0.125f;
+        derivative_history_[3] = derivative_history_[2];
+        derivative_history_[2] = derivative_history_[1];
+        derivative_history_[1] = derivative_history_[0];
+        derivative_history_[0] = high_pass_;
+        const float squared = slope * slope;
+
+        // Moving window integration over a running sum
+        mwi_sum_ += squared - mwi_window_[static_cast<size_t>(mwi_position_)];
+        mwi_window_[static_cast<size_t>(mwi_position_)] = squared;
+        if (++mwi_position_ == mwi_length_) {
+            mwi_position_ = 0;
+        }
+        const float mwi = static_cast<float>(qMax(mwi_sum_, 0.0) / mwi_length_);
+
+        if (sample_index_ < learning_samples_) {
+            learning_max_ = qMax(learning_max_, mwi);
+            learning_sum_ += mwi;
+            if (sample_index_ + 1 == learning_samples_) {
+                signal_peak_ = learning_max_ / 3.0f;
+                noise_peak_ = static_cast<float>(learning_sum_ / learning_samples_) * 0.5f;
+            }
+        } else if (rising_ && mwi < previous_mwi_) {
+            beat |= classifyPeak(previous_mwi_, sample_index_ - 1);
+        }
+
+        rising_ = mwi > previous_mwi_;
+        previous_mwi_ = mwi;
+        ++sample_index_;
+    }
+
+    if (beat && rr_count_ > 0) {
+        const float heartRate = static_cast<float>(60.0 * sample_rate_ * rr_count_ / rr_sum_);
+        out.append(VitalSync::FrameParameter{ heart_rate_id_, heartRate });
+    }
+}
+
+/**
+ * @brief Forgets all signal history
+ *
+ * The stages are tuned again on the next chunk.
+ */
+void QrsDetector::Reset()
+{
+    sample_rate_ = 0.0;
+    low_pass_alpha_ = 0.0f;
+    high_pass_alpha_ = 0.0f;
+    mwi_length_ = 1;
+    refractory_samples_ = 0;
+    min_rr_samples_ = 0;
+    max_rr_samples_ = 0;
+    learning_samples_ = 0;
+    configure(0.0);
+}
+
+/**
+ * @brief Tunes the filters and windows to a sample rate and restarts detection
+ * @param sampleRate Sample rate in samples per second, 0 to only clear the state
+ *
+ * Rates above MAX_SAMPLE_RATE keep working with the integrator window
+ * capped at the buffer size.
+ */
+void QrsDetector::configure(double sampleRate)
+{
+    if (sampleRate > 0.0) {
+        sample_rate_ = sampleRate;
+        low_pass_alpha_ = static_cast<float>(1.0 - qExp(-2.0 * M_PI * LOW_PASS_CUTOFF_HZ / sampleRate));
+        high_pass_alpha_ = static_cast<float>(1.0 / (1.0 + 2.0 * M_PI * HIGH_PASS_CUTOFF_HZ / sampleRate));
+        mwi_length_ = qBound(1, qRound(sampleRate * MWI_WINDOW_MS / 1000.0), MWI_CAPACITY);
+        refractory_samples_ = qRound64(sampleRate * REFRACTORY_MS / 1000.0);
+        min_rr_samples_ = qRound64(sampleRate * MIN_RR_MS / 1000.0);
+        max_rr_samples_ = qRound64(sampleRate * MAX_RR_MS / 1000.0);
+        learning_samples_ = qRound64(sampleRate * LEARNING_MS / 1000.0);
+    }
+
+    low_pass_1_ = 0.0f;
+    low_pass_2_ = 0.0f;
+    high_pass_ = 0.0f;
+    high_pass_input_ = 0.0f;
+    derivative_history_.fill(0.0f);
+    mwi_window_.fill(0.0f);
+    mwi_sum_ = 0.0;
+    mwi_position_ = 0;
+
+    sample_index_ = 0;
+    previous_mwi_ = 0.0f;
+    rising_ = false;
+    signal_peak_ = 0.0f;
+    noise_peak_ = 0.0f;
+    learning_max_ = 0.0f;
+    learning_sum_ = 0.0;
+    last_qrs_index_ = -1;
+
+    rr_intervals_.fill(0);
+    rr_count_ = 0;
+    rr_position_ = 0;
+    rr_sum_ = 0;
+}
+
+/**
+ * @brief Classifies a peak of the integrated signal
+ * @param value Height of the peak
+ * @param index Sample index of the peak
+ * @return True if the peak completed an RR interval
+ *
+ * Peaks within the refractory period of the last beat belong to the same
+ * complex and are ignored. The threshold is halved once the beat is overdue
+ * by MISSED_BEAT_FACTOR times the mean RR interval, which recovers beats of
+ * lower amplitude without a search-back buffer. Intervals outside the
+ * plausible range restart the rate measurement but still mark the beat.
+ */
+bool QrsDetector::classifyPeak(float value, qint64 index)
+{
+    const qint64 sinceLast = last_qrs_index_ >= 0 ? index - last_qrs_index_ : -1;
+    if (sinceLast >= 0 && sinceLast < refractory_samples_) {
+        return false;
+    }
+
+    float threshold = noise_peak_ + THRESHOLD_FRACTION * (signal_peak_ - noise_peak_);
+    if (rr_count_ > 0 && sinceLast * rr_count_ > MISSED_BEAT_FACTOR * rr_sum_) {
+        threshold *= 0.5f;
+    }
+
+    if (value <= threshold) {
+        noise_peak_ += PEAK_WEIGHT * (value - noise_peak_);
+        return false;
+    }
+
+    signal_peak_ += PEAK_WEIGHT * (value - signal_peak_);
+    last_qrs_index_ = index;
+    if (sinceLast < min_rr_samples_ || sinceLast > max_rr_samples_) {
+        if (sinceLast > max_rr_samples_) {
+            rr_intervals_.fill(0);
+            rr_count_ = 0;
+            rr_position_ = 0;
+            rr_sum_ = 0;
+        }
+        return false;
+    }
+
+    rr_sum_ += sinceLast - rr_intervals_[static_cast<size_t>(rr_position_)];
+    rr_intervals_[static_cast<size_t>(rr_position_)] = sinceLast;
+    rr_position_ = (rr_position_ + 1) % RR_HISTORY;
+    rr_count_ = qMin(rr_count_ + 1, RR_HISTORY);
+    return true;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file qrs_detector.h
+ * @brief Definition of the QrsDetector class
+ *
+ * This file contains the definition of the QrsDetector class, a streaming
+ * Pan-Tompkins style QRS detector that derives the heart rate from ECG
+ * samples as they are ingested.
+ */
+#ifndef QRS_DETECTOR_H
+#define QRS_DETECTOR_H
+
+#include "waveform_processor.h"
+#include <array>
+
+/**
+ * @brief Streaming QRS detector and heart rate meter
+ *
+ * Each sample passes the stages of the Pan-Tompkins algorithm: a 5-15 Hz
+ * band-pass made of one-pole filters, a five-point derivative, squaring and
+ * a 150 ms moving window integrator. Peaks of the integrated signal are
+ * classified as QRS complexes or noise against an adaptive threshold between
+ * the running signal and noise peak levels, with a 200 ms refractory period
+ * and a lowered threshold once a beat is overdue. The heart rate is reported
+ * after each chunk that contained a beat, from the mean of the last eight RR
+ * intervals.
+ *
+ * All buffers are sized for MAX_SAMPLE_RATE and the work per sample is
+ * constant. Filters are tuned to the measured sample rate; a change of more
+ * than 10 percent restarts detection, including the two-second learning
+ * phase that seeds the thresholds.
+ */
+class QrsDetector : public WaveformProcessor {
+public:
+    static constexpr int MAX_SAMPLE_RATE = 1000;    ///< Highest sample rate the buffers are sized for
+
+    /**
+     * @brief Constructor
+     * @param waveformId VitalSync::WaveformType of the ECG lead to analyze
+     * @param heartRateId VitalSync::ParameterType the heart rate is reported as
+     */
+    QrsDetector(int waveformId, int heartRateId);
+
+    /**
+     * @brief Get the waveform this processor analyzes
+     * @return VitalSync::WaveformType of the ECG lead
+     */
+    int GetWaveformId() const override { return waveform_id_; }
+
+    /**
+     * @brief Get the precedence of the derived heart rate
+     * @return 1, ECG derived rates are the most trusted
+     */
+    int GetPriority() const override { return 1; }
+
+    /**
+     * @brief Process one chunk of ECG samples
+     * @param samples Pointer to the samples
+     * @param count Number of samples
+     * @param sampleRate Measured sample rate in samples per second
+     * @param out Receives the heart rate if the chunk contained a beat
+     */
+    void Process(const float* samples, int count, double sampleRate, Output& out) override;
+
+    /**
+     * @brief Forget all signal history
+     */
+    void Reset() override;
+
+private:
+    static constexpr int MWI_CAPACITY = MAX_SAMPLE_RATE * 150 / 1000;  ///< Integrator window at the highest rate
+    static constexpr int RR_HISTORY = 8;                                ///< RR intervals averaged for the rate
+
+    /**
+     * @brief Tune the filters and windows to a sample rate and restart detection
+     * @param sampleRate Sample rate in samples per second
+     */
+    void configure(double sampleRate);
+
+    /**
+     * @brief Classify a peak of the integrated signal
+     * @param value Height of the peak
+     * @param index Sample index of the peak
+     * @return True if the peak completed an RR interval
+     */
+    bool classifyPeak(float value, qint64 index);
+
+private:
+    const int waveform_id_;                         ///< ECG lead analyzed
+    const int heart_rate_id_;                       ///< Parameter the rate is reported as
+
+    // Tuning
+    double sample_rate_;                            ///< Rate the stages are tuned to, 0 until configured
+    float low_pass_alpha_;                          ///< Smoothing factor of the 15 Hz low-pass stages
+    float high_pass_alpha_;                         ///< Feedback factor of the 5 Hz high-pass stage
+    int mwi_length_;                                ///< Integrator window in samples
+    qint64 refractory_samples_;                     ///< Shortest time between two beats
+    qint64 min_rr_samples_;                         ///< Shortest plausible RR interval
+    qint64 max_rr_samples_;                         ///< Longest plausible RR interval
+    qint64 learning_samples_;                       ///< Length of the learning phase
+
+    // Filter state
+    float low_pass_1_;                              ///< First low-pass stage
+    float low_pass_2_;                              ///< Second low-pass stage
+    float high_pass_;                               ///< High-pass output
+    float high_pass_input_;                         ///< Previous high-pass input
+    std::array<float, 4> derivative_history_;       ///< Previous four band-passed samples, newest first
+    std::array<float, MWI_CAPACITY> mwi_window_;    ///< Squared slopes in the integrator window
+    double mwi_sum_;                                ///< Sum over the integrator window
+    int mwi_position_;                              ///< Slot of the oldest squared slope
+
+    // Peak detection
+    qint64 sample_index_;                           ///< Samples processed since the last restart
+    float previous_mwi_;                            ///< Previous integrated value
+    bool rising_;                                   ///< Whether the integrated signal is rising
+    float signal_peak_;                             ///< Running QRS peak level (SPKI)
+    float noise_peak_;                              ///< Running noise peak level (NPKI)
+    float learning_max_;                            ///< Highest integrated value in the learning phase
+    double learning_sum_;                           ///< Sum of the integrated values in the learning phase
+    qint64 last_qrs_index_;                         ///< Sample index of the last beat, -1 before the first
+
+    // Rate
+    std::array<qint64, RR_HISTORY> rr_intervals_;   ///< Recent RR intervals in samples
+    int rr_count_;                                  ///< Number of valid RR intervals
+    int rr_position_;                               ///< Slot of the next RR interval
+    qint64 rr_sum_;                                 ///< Sum of the valid RR intervals
+};
+
+#endif // QRS_DETECTOR_H
@@ -0,0 +1,137 @@
+/**
+ * @file recording_format.h
+ * @brief On-disk layout of VitalSync full-disclosure recordings
+ *
+ * This file defines the chunked, append-only recording format (.vsr) shared by
+ * the DataRecorder and the RecordingReader. A recording is a FileHeader
+ * followed by chunks. Every data chunk covers a span of time and holds one
+ * block per waveform channel with the channel's samples stored contiguously,
+ * followed by the parameter values measured in that span. A cleanly closed
+ * recording ends with an index chunk listing all data chunks and an
+ * IndexTrailer pointing at it; a recording cut short by a crash is indexed by
+ * walking the chunk headers instead.
+ *
+ * All records are little-endian, naturally aligned and padded to
+ * BLOCK_ALIGNMENT, so a memory-mapped recording can be read in place.
+ */
+#ifndef RECORDING_FORMAT_H
+#define RECORDING_FORMAT_H
+
+#include <QtGlobal>
+
+namespace VitalSync {
+namespace Recording {
+
+constexpr char FILE_MAGIC[8] = { 'V', 'S', 'R', 'E', 'C', 'O', 'R', 'D' };  ///< First bytes of every recording
+constexpr quint32 FORMAT_VERSION = 1;           ///< Current format version
+constexpr quint32 CHUNK_MAGIC = 0x4B435356;     ///< "VSCK" read as a little-endian u32
+constexpr quint32 TRAILER_MAGIC = 0x58495356;   ///< "VSIX" read as a little-endian u32
+constexpr int BLOCK_ALIGNMENT = 8;              ///< Alignment of every block in the file
+constexpr int BED_ID_SIZE = 40;                 ///< Bytes reserved for the UTF-8 bed identifier
+
+/**
+ * @brief Kinds of chunks in a recording
+ */
+enum class ChunkType : quint16 {
+    Data = 1,       ///< Waveform and parameter data
+    Index = 2       ///< Time index of all data chunks
+};
+
+/**
+ * @brief Storage of the samples of a channel block
+ */
+enum class BlockEncoding : quint16 {
+    Raw = 0,        ///< Little-endian floats, readable in place
+    DeltaLz = 1     ///< Compressed by the SampleCodec
+};
+
+/**
+ * @brief Header at the start of a recording
+ */
+struct FileHeader {
+    char magic[8];                  ///< FILE_MAGIC
+    quint32 version;                ///< FORMAT_VERSION
+    quint32 headerSize;             ///< Size of this header, where the first chunk starts
+    qint64 createdTimestamp;        ///< Creation time in milliseconds since the epoch
+    char bedId[BED_ID_SIZE];        ///< Bed identifier, zero padded
+};
+
+/**
+ * @brief Header at the start of every chunk
+ *
+ * A data chunk is made of this header, channelCount ChannelBlockHeader blocks
+ * each followed by its sample payload padded to BLOCK_ALIGNMENT, and parameterCount
+ * ParameterRecord entries. An index chunk is made of this header and
+ * IndexEntry records filling the rest of the chunk.
+ */
+struct ChunkHeader {
+    quint32 magic;                  ///< CHUNK_MAGIC
+    quint32 chunkSize;              ///< Size of the whole chunk including this header
+    quint16 type;                   ///< ChunkType
+    quint16 channelCount;           ///< Number of waveform channel blocks
+    quint32 parameterCount;         ///< Number of parameter records
+    qint64 startTimestamp;          ///< Time of the first data in the chunk, in milliseconds since the epoch
+    qint64 endTimestamp;            ///< Time of the last data in the chunk, in milliseconds since the epoch
+};
+
+/**
+ * @brief Header of the sample block of one waveform channel
+ */
+struct ChannelBlockHeader {
+    quint16 waveformId;             ///< VitalSync::WaveformType of the channel
+    quint16 encoding;               ///< BlockEncoding of the payload
+    quint32 sampleCount;            ///< Number of samples in the payload
+    qint64 firstTimestamp;          ///< Time of the first sample in milliseconds since the epoch
+    float sampleRate;               ///< Sample rate in Hz, 0 if unknown
+    quint32 payloadSize;            ///< Size of a compressed payload in bytes; raw payloads are sampleCount floats
+};
+
+/**
+ * @brief One recorded parameter value
+ */
+struct ParameterRecord {
+    qint64 timestamp;               ///< Time of the value in milliseconds since the epoch
+    quint16 parameterId;            ///< VitalSync::ParameterType of the value
+    quint16 reserved;               ///< Zero
+    float value;                    ///< Measured value
+};
+
+/**
+ * @brief Entry of the time index
+ */
+struct IndexEntry {
+    qint64 startTimestamp;          ///< Start time of the data chunk
+    qint64 endTimestamp;            ///< End time of the data chunk
+    quint64 offset;                 ///< File offset of the data chunk
+};
+
+/**
+ * @brief Last bytes of a cleanly closed recording
+ */
+struct IndexTrailer {
+    quint32 magic;                  ///< TRAILER_MAGIC
+    quint32 entryCount;             ///< Number of entries in the index chunk
+    quint64 indexOffset;            ///< File offset of the index chunk
+};
+
+static_assert(sizeof(FileHeader) == 64, "FileHeader layout changed");
+static_assert(sizeof(ChunkHeader) == 32, "ChunkHeader layout changed");
+static_assert(sizeof(ChannelBlockHeader) == 24, "ChannelBlockHeader layout changed");
+static_assert(sizeof(ParameterRecord) == 16, "ParameterRecord layout changed");
+static_assert(sizeof(IndexEntry) == 24, "IndexEntry layout changed");
+static_assert(sizeof(IndexTrailer) == 16, "IndexTrailer layout changed");
+
+/**
+ * @brief Round a size up to BLOCK_ALIGNMENT
+ * @param size Size in bytes
+ * @return Aligned size in bytes
+ */
+constexpr qint64 AlignedSize(qint64 size)
+{
+    return (size + BLOCK_ALIGNMENT - 1) & ~qint64(BLOCK_ALIGNMENT - 1);
+}
+
+} // namespace Recording
+} // namespace VitalSync
+
+#endif // RECORDING_FORMAT_H
@@ -0,0 +1,322 @@
+/**
+ * @file recording_reader.cpp
+ * @brief Implementation of the RecordingReader class
+ *
+ * This file implements memory-mapped reading of VitalSync recordings: header
+ * validation, loading or rebuilding the time index, and chunk parsing.
+ * Headers are copied out of the mapping before use; raw samples and parameter
+ * records are returned in place, compressed samples are decoded.
+ */
+#include "recording_reader.h"
+#include <QDebug>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+using namespace VitalSync::Recording;
+
+/**
+ * @namespace Anonymous namespace for helper functions
+ * @brief Contains helpers used by the RecordingReader implementation
+ */
+namespace {
+    /**
+     * @brief Copy a record out of the mapping
+     * @param data Start of the mapping
+     * @param offset Offset of the record
+     * @return The record
+     */
+    template <typename T>
+    T readRecord(const uchar* data, qint64 offset)
+    {
+        T record;
+        std::memcpy(&record, data + offset, sizeof(T));
+        return record;
+    }
+}
+
+/**
+ * @brief Constructs a closed reader
+ */
+RecordingReader::RecordingReader()
+    : data_(nullptr)
+    , size_(0)
+    , first_chunk_offset_(0)
+{
+}
+
+/**
+ * @brief Destroys the reader and unmaps the recording
+ */
+RecordingReader::~RecordingReader()
+{
+    Close();
+}
+
+/**
+ * @brief Opens and maps a recording
+ * @param filePath Path of the recording
+ * @return True if the file is a valid recording with at least a header
+ *
+ * The recording may still be growing; only chunks complete at the time of
+ * opening are visible.
+ */
+bool RecordingReader::Open(const QString& filePath)
+{
+    Close();
+
+#if Q_BYTE_ORDER != Q_LITTLE_ENDIAN
+    qWarning() << "RecordingReader: Recordings can only be read on little-endian hosts";
+    return false;
+#endif
+
+    file_.setFileName(filePath);
+    if (!file_.open(QIODevice::ReadOnly)) {
+        qWarning() << "RecordingReader: Cannot open" << filePath << ":" << file_.errorString();
+        return false;
+    }
+
+    const qint64 size = file_.size();
+    if (size < static_cast<qint64>(sizeof(FileHeader))) {
+        qWarning() << "RecordingReader: Not a recording:" << filePath;
+        file_.close();
+        return false;
+    }
+
+    const uchar* data = file_.map(0, size);
+    if (!data) {
+        qWarning() << "RecordingReader: Cannot map" << filePath << ":" << file_.errorString();
+        file_.close();
+        return false;
+    }
+
+    const FileHeader header = readRecord<FileHeader>(data, 0);
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0
+        || header.version != FORMAT_VERSION
+        || header.headerSize < sizeof(FileHeader) || header.headerSize > size) {
+        qWarning() << "RecordingReader: Unsupported recording:" << filePath;
+        file_.unmap(const_cast<uchar*>(data));
+        file_.close();
+        return false;
+    }
+
+    data_ = data;
+    size_ = size;
+    first_chunk_offset_ = AlignedSize(header.headerSize);
+    bed_id_ = QString::fromUtf8(header.bedId, static_cast<int>(qstrnlen(header.bedId, BED_ID_SIZE)));
+
+    if (!loadIndex()) {
+        scanChunks();
+    }
+
+    qDebug() << "RecordingReader: Opened" << filePath << "with" << index_.size() << "chunks";
+    return true;
+}
+
+/**
+ * @brief Unmaps and closes the recording
+ */
+void RecordingReader::Close()
+{
+    if (data_) {
+        file_.unmap(const_cast<uchar*>(data_));
+    }
+    if (file_.isOpen()) {
+        file_.close();
+    }
+
+    data_ = nullptr;
+    size_ = 0;
+    first_chunk_offset_ = 0;
+    bed_id_.clear();
+    index_.clear();
+}
+
+/**
+ * @brief Gets the time of the first recorded data
+ * @return Timestamp in milliseconds since the epoch, 0 if empty
+ */
+qint64 RecordingReader::GetStartTimestamp() const
+{
+    return index_.isEmpty() ? 0 : index_.first().startTimestamp;
+}
+
+/**
+ * @brief Gets the time of the last recorded data
+ * @return Timestamp in milliseconds since the epoch, 0 if empty
+ */
+qint64 RecordingReader::GetEndTimestamp() const
+{
+    return index_.isEmpty() ? 0 : index_.last().endTimestamp;
+}
+
+/**
+ * @brief Finds the chunk to replay a timestamp from
+ * @param timestamp Timestamp in milliseconds since the epoch
+ * @return Index of the first chunk that ends at or after the timestamp,
+ *         or GetChunkCount() if the recording ends before it
+ */
+int RecordingReader::FindChunk(qint64 timestamp) const
+{
+    auto it = std::lower_bound(index_.constBegin(), index_.constEnd(), timestamp,
+                               [](const IndexEntry& entry, qint64 value) { return entry.endTimestamp < value; });
+    return static_cast<int>(it - index_.constBegin());
+}
+
+/**
+ * @brief Gets the contents of a data chunk
+ * @param index Chunk index
+ * @param view Receives the chunk contents
+ * @return True if the chunk exists and is well formed
+ */
+bool RecordingReader::ReadChunk(int index, ChunkView& view) const
+{
+    if (!data_ || index < 0 || index >= index_.size()) {
+        return false;
+    }
+
+    // The index was validated when it was loaded; check again before touching the mapping
+    const quint64 entryOffset = index_[index].offset;
+    if (entryOffset + sizeof(ChunkHeader) > static_cast<quint64>(size_)) {
+        return false;
+    }
+    const qint64 chunkOffset = static_cast<qint64>(entryOffset);
+    const ChunkHeader header = readRecord<ChunkHeader>(data_, chunkOffset);
+    const qint64 chunkEnd = chunkOffset + header.chunkSize;
+    if (header.chunkSize < sizeof(ChunkHeader) || chunkEnd > size_) {
+        return false;
+    }
+
+    view.startTimestamp = header.startTimestamp;
+    view.endTimestamp = header.endTimestamp;
+    view.channels.clear();
+    view.parameters = nullptr;
+    view.parameterCount = 0;
+    view.decoded.resize(0);
+
+    // Offsets of decoded channels in view.decoded, which may still grow
+    QVarLengthArray<qsizetype, 16> decodedOffsets;
+
+    qint64 offset = chunkOffset + sizeof(ChunkHeader);
+    for (int i = 0; i < header.channelCount; ++i) {
+        if (offset + static_cast<qint64>(sizeof(ChannelBlockHeader)) > chunkEnd) {
+            return false;
+        }
+        const ChannelBlockHeader block = readRecord<ChannelBlockHeader>(data_, offset);
+        offset += sizeof(ChannelBlockHeader);
+
+        const bool raw = block.encoding == static_cast<quint16>(BlockEncoding::Raw);
+        const qint64 payloadBytes = raw ? static_cast<qint64>(block.sampleCount) * sizeof(float) : block.payloadSize;
+        if (offset + payloadBytes > chunkEnd || block.sampleCount > static_cast<quint32>(INT_MAX / sizeof(float))) {
+            return false;
+        }
+
+        ChannelView channel;
+        channel.waveformId = block.waveformId;
+        channel.firstTimestamp = block.firstTimestamp;
+        channel.sampleRate = block.sampleRate;
+        channel.sampleCount = static_cast<int>(block.sampleCount);
+
+        if (raw) {
+            channel.samples = reinterpret_cast<const float*>(data_ + offset);
+            decodedOffsets.append(-1);
+        } else if (block.encoding == static_cast<quint16>(BlockEncoding::DeltaLz)) {
+            const qsizetype decodedOffset = view.decoded.size();
+            view.decoded.resize(decodedOffset + channel.sampleCount);
+            if (!codec_.Decode(data_ + offset, payloadBytes, channel.sampleCount, view.decoded.data() + decodedOffset)) {
+                return false;
+            }
+            decodedOffsets.append(decodedOffset);
+        } else {
+            return false;
+        }
+        view.channels.append(channel);
+
+        offset += AlignedSize(payloadBytes);
+    }
+
+    for (int i = 0; i < view.channels.size(); ++i) {
+        if (decodedOffsets[i] >= 0) {
+            view.channels[i].samples = view.decoded.constData() + decodedOffsets[i];
+        }
+    }
+
+    if (offset + static_cast<qint64>(header.parameterCount) * sizeof(ParameterRecord) > chunkEnd) {
+        return false;
+    }
+    view.parameters = reinterpret_cast<const ParameterRecord*>(data_ + offset);
+    view.parameterCount = static_cast<int>(header.parameterCount);
+    return true;
+}
+
+/**
+ * @brief Loads the time index written when the recording was closed
+ * @return True if a valid index was found
+ *
+ * The trailer is not trusted on its own: every entry must point, in file
+ * order, at a complete data chunk before the index. A damaged or foreign
+ * index is discarded and the caller falls back to scanChunks().
+ */
+bool RecordingReader::loadIndex()
+{
+    if (size_ < first_chunk_offset_ + static_cast<qint64>(sizeof(ChunkHeader) + sizeof(IndexTrailer))) {
+        return false;
+    }
+
+    const IndexTrailer trailer = readRecord<IndexTrailer>(data_, size_ - sizeof(IndexTrailer));
+    if (trailer.magic != TRAILER_MAGIC || trailer.indexOffset < static_cast<quint64>(first_chunk_offset_)
+        || trailer.indexOffset + sizeof(ChunkHeader) > static_cast<quint64>(size_)) {
+        return false;
+    }
+
+    const qint64 indexOffset = static_cast<qint64>(trailer.indexOffset);
+    const ChunkHeader header = readRecord<ChunkHeader>(data_, indexOffset);
+    const qint64 entriesSize = static_cast<qint64>(trailer.entryCount) * sizeof(IndexEntry);
+    if (header.magic != CHUNK_MAGIC || header.type != static_cast<quint16>(ChunkType::Index)
+        || header.chunkSize != sizeof(ChunkHeader) + entriesSize
+        || indexOffset + header.chunkSize > size_ - static_cast<qint64>(sizeof(IndexTrailer))) {
+        return false;
+    }
+
+    index_.resize(trailer.entryCount);
+    std::memcpy(index_.data(), data_ + indexOffset + sizeof(ChunkHeader), static_cast<size_t>(entriesSize));
+
+    quint64 previousEnd = static_cast<quint64>(first_chunk_offset_);
+    for (const IndexEntry& entry : std::as_const(index_)) {
+        if (entry.offset < previousEnd || entry.offset + sizeof(ChunkHeader) > static_cast<quint64>(indexOffset)) {
+            index_.clear();
+            return false;
+        }
+        const ChunkHeader chunk = readRecord<ChunkHeader>(data_, static_cast<qint64>(entry.offset));
+        if (chunk.magic != CHUNK_MAGIC || chunk.type != static_cast<quint16>(ChunkType::Data)
+            || chunk.chunkSize < sizeof(ChunkHeader)
+            || entry.offset + chunk.chunkSize > static_cast<quint64>(indexOffset)) {
+            index_.clear();
+            return false;
+        }
+        previousEnd = entry.offset + chunk.chunkSize;
+    }
+    return true;
+}
+
+/**
+ * @brief Builds the time index by walking the chunk headers
+ */
+void RecordingReader::scanChunks()
+{
+    index_.clear();
+
+    qint64 offset = first_chunk_offset_;
+    while (offset + static_cast<qint64>(sizeof(ChunkHeader)) <= size_) {
+        const ChunkHeader header = readRecord<ChunkHeader>(data_, offset);
+        if (header.magic != CHUNK_MAGIC || header.chunkSize < sizeof(ChunkHeader)
+            || offset + header.chunkSize > size_) {
+            break;
+        }
+
+        if (header.type == static_cast<quint16>(ChunkType::Data)) {
+            index_.append(IndexEntry{ header.startTimestamp, header.endTimestamp, static_cast<quint64>(offset) });
+        }
+        offset += AlignedSize(header.chunkSize);
+    }
+}
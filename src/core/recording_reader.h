@@ -0,0 +1,150 @@
+/**
+ * @file recording_reader.h
+ * @brief Definition of the RecordingReader class
+ *
+ * This file contains the definition of the RecordingReader class which maps a
+ * VitalSync recording (.vsr) into memory and gives direct, copy-free access to
+ * its chunks, together with a time index for seeking.
+ */
+#ifndef RECORDING_READER_H
+#define RECORDING_READER_H
+
+#include "recording_format.h"
+#include "sample_codec.h"
+#include <QFile>
+#include <QString>
+#include <QVarLengthArray>
+#include <QVector>
+
+/**
+ * @brief Read-only, memory-mapped access to a recording
+ *
+ * The whole file is mapped once; chunk views point straight into the mapping,
+ * so reading samples costs no copies and the operating system pages data in
+ * only as it is replayed. Only compressed channels are decoded, into the
+ * chunk view. Seeking is a binary search over the time index.
+ */
+class RecordingReader {
+public:
+    /**
+     * @brief Samples of one waveform channel inside a chunk
+     */
+    struct ChannelView {
+        int waveformId = 0;             ///< VitalSync::WaveformType of the channel
+        qint64 firstTimestamp = 0;      ///< Time of the first sample in milliseconds since the epoch
+        float sampleRate = 0.0f;        ///< Sample rate in Hz, 0 if unknown
+        int sampleCount = 0;            ///< Number of samples
+        const float* samples = nullptr; ///< Samples, pointing into the mapping or the chunk's decoded samples
+    };
+
+    /**
+     * @brief Contents of one data chunk
+     */
+    struct ChunkView {
+        qint64 startTimestamp = 0;                              ///< Time of the first data in the chunk
+        qint64 endTimestamp = 0;                                ///< Time of the last data in the chunk
+        QVarLengthArray<ChannelView, 16> channels;              ///< Waveform channels of the chunk
+        const VitalSync::Recording::ParameterRecord* parameters = nullptr;  ///< Parameter values, pointing into the mapping
+        int parameterCount = 0;                                 ///< Number of parameter values
+        QVector<float> decoded;                                 ///< Samples of compressed channels, capacity kept between chunks
+    };
+
+    /**
+     * @brief Constructor
+     */
+    RecordingReader();
+
+    /**
+     * @brief Destructor
+     */
+    ~RecordingReader();
+
+    RecordingReader(const RecordingReader&) = delete;
+    RecordingReader& operator=(const RecordingReader&) = delete;
+
+    /**
+     * @brief Open and map a recording
+     * @param filePath Path of the recording
+     * @return True if the file is a valid recording with at least a header
+     */
+    bool Open(const QString& filePath);
+
+    /**
+     * @brief Unmap and close the recording
+     */
+    void Close();
+
+    /**
+     * @brief Check if a recording is open
+     * @return True if a recording is open
+     */
+    bool IsOpen() const { return data_ != nullptr; }
+
+    /**
+     * @brief Get the bed the recording was made for
+     * @return Bed identifier, empty for the primary bed
+     */
+    QString GetBedId() const { return bed_id_; }
+
+    /**
+     * @brief Get the number of data chunks
+     * @return Number of data chunks
+     */
+    int GetChunkCount() const { return static_cast<int>(index_.size()); }
+
+    /**
+     * @brief Get the time of the first recorded data
+     * @return Timestamp in milliseconds since the epoch, 0 if empty
+     */
+    qint64 GetStartTimestamp() const;
+
+    /**
+     * @brief Get the time of the last recorded data
+     * @return Timestamp in milliseconds since the epoch, 0 if empty
+     */
+    qint64 GetEndTimestamp() const;
+
+    /**
+     * @brief Find the chunk to replay a timestamp from
+     * @param timestamp Timestamp in milliseconds since the epoch
+     * @return Index of the first chunk that ends at or after the timestamp,
+     *         or GetChunkCount() if the recording ends before it
+     *
+     * Runs in O(log n) over the time index.
+     */
+    int FindChunk(qint64 timestamp) const;
+
+    /**
+     * @brief Get the contents of a data chunk
+     * @param index Chunk index
+     * @param view Receives the chunk contents
+     * @return True if the chunk exists and is well formed
+     */
+    bool ReadChunk(int index, ChunkView& view) const;
+
+private:
+    /**
+     * @brief Load the time index written when the recording was closed
+     * @return True if a valid index was found
+     */
+    bool loadIndex();
+
+    /**
+     * @brief Build the time index by walking the chunk headers
+     *
+     * Used for recordings that were not closed cleanly. A truncated last chunk
+     * is ignored.
+     */
+    void scanChunks();
+
+private:
+    QFile file_;                                        ///< Mapped recording
+    const uchar* data_;                                 ///< Start of the mapping
+    qint64 size_;                                       ///< Size of the mapping
+    qint64 first_chunk_offset_;                         ///< Offset of the first chunk
+    QString bed_id_;                                    ///< Bed identifier from the file header
+    QVector<VitalSync::Recording::IndexEntry> index_;   ///< Time index of all data chunks
+    mutable SampleCodec codec_;                         ///< Decoder of compressed channels
+};
+
+#endif // RECORDING_READER_H
@@ -0,0 +1,153 @@
+/**
+ * @file sample_block_pool.cpp
+ * @brief Implementation of the SampleBlockPool class
+ *
+ * This file implements the SampleBlockPool class, which keeps the sample
+ * blocks of all data frames on a free list for reuse.
+ */
+#include "../../include/sample_block_pool.h"
+#include "../utils/metrics.h"
+
+#include <QMutexLocker>
+
+namespace VitalSync {
+
+/**
+ * @brief Gets the pool of the process
+ * @return The pool
+ *
+ * The pool is never destroyed, so frames that are still alive while static
+ * objects are torn down at exit can still give their blocks back.
+ */
+SampleBlockPool& SampleBlockPool::GetInstance()
+{
+    static SampleBlockPool* instance = new SampleBlockPool();
+    return *instance;
+}
+
+/**
+ * @brief Constructor
+ *
+ * Allocates the initial blocks.
+ */
+SampleBlockPool::SampleBlockPool()
+{
+    Reserve(INITIAL_BLOCKS);
+}
+
+/**
+ * @brief Takes a block with room for at least a number of samples
+ * @param capacity Number of samples needed
+ * @return A block with a reference count of 1
+ *
+ * Pops a pooled block off the free list, allocating one if the list is
+ * empty. Requests larger than BLOCK_CAPACITY get a block of their own.
+ */
+SampleBlockPool::Block* SampleBlockPool::Acquire(int capacity)
+{
+    Block* block = nullptr;
+    if (capacity > BLOCK_CAPACITY) {
+        block = new Block();
+        block->capacity = capacity;
+        block->pooled = false;
+        block->samples = std::make_unique<float[]>(static_cast<size_t>(capacity));
+        Metrics::Add(Metrics::Counter::SampleBlocksAllocated);
+
+        QMutexLocker locker(&mutex_);
+        ++oversize_blocks_;
+        high_water_mark_ = std::max(high_water_mark_, ++in_use_);
+    } else {
+        QMutexLocker locker(&mutex_);
+        if (free_.empty()) {
+            growLocked();
+            Metrics::Add(Metrics::Counter::SampleBlocksAllocated);
+        }
+        block = free_.back();
+        free_.pop_back();
+        high_water_mark_ = std::max(high_water_mark_, ++in_use_);
+    }
+
+    block->references.store(1, std::memory_order_relaxed);
+    return block;
+}
+
+/**
+ * @brief Gives a block back once its reference count dropped to 0
+ * @param block Block returned by Acquire()
+ *
+ * Pooled blocks go back on the free list, oversize blocks are freed.
+ */
+void SampleBlockPool::Release(Block* block)
+{
+    if (!block) {
+        return;
+    }
+
+    QMutexLocker locker(&mutex_);
+    --in_use_;
+    if (block->pooled) {
+        free_.push_back(block);
+        return;
+    }
+
+    locker.unlock();
+    delete block;
+}
+
+/**
+ * @brief Makes sure a number of pooled blocks exists
+ * @param blocks Number of blocks the pool should hold at least
+ */
+void SampleBlockPool::Reserve(int blocks)
+{
+    QMutexLocker locker(&mutex_);
+    while (static_cast<int>(blocks_.size()) < blocks) {
+        growLocked();
+    }
+}
+
+/**
+ * @brief Gets the usage of the pool
+ * @return Current statistics
+ */
+SampleBlockPool::Statistics SampleBlockPool::GetStatistics() const
+{
+    QMutexLocker locker(&mutex_);
+    Statistics statistics;
+    statistics.blocks = static_cast<int>(blocks_.size());
+    statistics.inUse = in_use_;
+    statistics.highWaterMark = high_water_mark_;
+    statistics.oversizeBlocks = oversize_blocks_;
+    return statistics;
+}
+
+/**
+ * @brief Formats the usage of the pool as one line of text
+ * @return Blocks in use, high-water mark and allocations
+ */
+QString SampleBlockPool::FormatStatistics() const
+{
+    const Statistics statistics = GetStatistics();
+    return QStringLiteral("Sample blocks: %1 in use, high-water mark %2, %3 pooled, %4 oversize")
+        .arg(statistics.inUse)
+        .arg(statistics.highWaterMark)
+        .arg(statistics.blocks)
+        .arg(statistics.oversizeBlocks);
+}
+
+/**
+ * @brief Allocates a pooled block and puts it on the free list
+ *
+ * The mutex must be held.
+ */
+void SampleBlockPool::growLocked()
+{
+    auto block = std::make_unique<Block>();
+    block->capacity = BLOCK_CAPACITY;
+    block->pooled = true;
+    block->samples = std::make_unique<float[]>(BLOCK_CAPACITY);
+    free_.push_back(block.get());
+    blocks_.push_back(std::move(block));
+}
+
+} // namespace VitalSync
@@ -0,0 +1,277 @@
+/**
+ * @file sample_codec.cpp
+ * @brief Implementation of the SampleCodec class
+ *
+ * This file implements the delta and byte plane transform of sample blocks and
+ * a greedy LZ77 compressor and a bounds-checked decompressor for the LZ4 block
+ * layout.
+ */
+#include "sample_codec.h"
+#include <cstring>
+
+/**
+ * @namespace Anonymous namespace for constants and helper functions
+ * @brief Contains compression parameters used by the SampleCodec implementation
+ */
+namespace {
+    const int MIN_MATCH = 4;                ///< Shortest match worth encoding
+    const int HASH_BITS = 12;               ///< Size of the match table as a power of two
+    const int MATCH_SEARCH_LIMIT = 12;      ///< Matches start at least this many bytes before the end
+    const int LAST_LITERALS = 5;            ///< The last bytes of a block are always literals
+    const int MAX_OFFSET = 0xFFFF;          ///< Farthest a match may reach back
+    const int LENGTH_MASK = 15;             ///< Token value announcing extra length bytes
+    const int MAX_EXPANSION = 255;          ///< Upper bound of the compression ratio of the layout
+
+    /**
+     * @brief Read four bytes without alignment requirements
+     * @param data Bytes
+     * @return Value in host byte order
+     */
+    quint32 read32(const uchar* data)
+    {
+        quint32 value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    /**
+     * @brief Hash four bytes into a match table slot
+     * @param value Four bytes
+     * @return Slot index
+     */
+    quint32 hashSequence(quint32 value)
+    {
+        return (value * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    /**
+     * @brief Append the extra bytes of a literal or match length
+     * @param out Compressed output
+     * @param length Length beyond LENGTH_MASK
+     */
+    void appendLength(QVector<uchar>& out, int length)
+    {
+        while (length >= 255) {
+            out.append(255);
+            length -= 255;
+        }
+        out.append(static_cast<uchar>(length));
+    }
+
+    /**
+     * @brief Append one sequence of literals and an optional match
+     * @param out Compressed output
+     * @param literals First literal byte
+     * @param literalCount Number of literal bytes
+     * @param offset Distance back to the match source
+     * @param matchLength Length of the match, 0 for the last sequence
+     */
+    void appendSequence(QVector<uchar>& out, const uchar* literals, int literalCount, int offset, int matchLength)
+    {
+        const int matchCode = matchLength > 0 ? matchLength - MIN_MATCH : 0;
+        out.append(static_cast<uchar>((qMin(literalCount, LENGTH_MASK) << 4) | qMin(matchCode, LENGTH_MASK)));
+        if (literalCount >= LENGTH_MASK) {
+            appendLength(out, literalCount - LENGTH_MASK);
+        }
+
+        const qsizetype literalStart = out.size();
+        out.resize(literalStart + literalCount);
+        std::memcpy(out.data() + literalStart, literals, static_cast<size_t>(literalCount));
+
+        if (matchLength > 0) {
+            out.append(static_cast<uchar>(offset & 0xFF));
+            out.append(static_cast<uchar>(offset >> 8));
+            if (matchCode >= LENGTH_MASK) {
+                appendLength(out, matchCode - LENGTH_MASK);
+            }
+        }
+    }
+
+    /**
+     * @brief Read the extra bytes of a literal or match length
+     * @param data Compressed bytes
+     * @param size Number of compressed bytes
+     * @param position Position of the first extra byte, advanced past the last one
+     * @param length Length to add the extra bytes to
+     * @return False if the data ends within the length
+     */
+    bool readLength(const uchar* data, qint64 size, qint64& position, qint64& length)
+    {
+        uchar byte;
+        do {
+            if (position >= size) {
+                return false;
+            }
+            byte = data[position++];
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+}
+
+/**
+ * @brief Compresses a block of samples
+ * @param samples Samples; need not be aligned
+ * @param count Number of samples
+ * @param out Receives the compressed bytes, replacing its contents
+ */
+void SampleCodec::Encode(const void* samples, int count, QVector<uchar>& out)
+{
+    out.resize(0);
+    const int size = qMax(count, 0) * static_cast<int>(sizeof(float));
+    planes_.resize(size);
+
+    const uchar* bytes = static_cast<const uchar*>(samples);
+    uchar* planes = planes_.data();
+    quint32 previous = 0;
+    for (int i = 0; i < count; ++i) {
+        const quint32 bits = read32(bytes + i * sizeof(float));
+        const quint32 delta = bits - previous;
+        previous = bits;
+
+        planes[i] = static_cast<uchar>(delta);
+        planes[count + i] = static_cast<uchar>(delta >> 8);
+        planes[2 * count + i] = static_cast<uchar>(delta >> 16);
+        planes[3 * count + i] = static_cast<uchar>(delta >> 24);
+    }
+
+    compress(planes, size, out);
+}
+
+/**
+ * @brief Decompresses a block of samples
+ * @param data Compressed bytes
+ * @param size Number of compressed bytes
+ * @param count Number of samples the block holds
+ * @param out Receives count samples
+ * @return False if the data is malformed or does not hold count samples
+ */
+bool SampleCodec::Decode(const uchar* data, qint64 size, int count, float* out)
+{
+    const qint64 planeBytes = static_cast<qint64>(count) * sizeof(float);
+    if (count < 0 || size <= 0 || planeBytes > size * MAX_EXPANSION) {
+        return false;
+    }
+
+    planes_.resize(planeBytes);
+    const uchar* planes = planes_.constData();
+    if (!decompress(data, size, planes_.data(), static_cast<int>(planeBytes))) {
+        return false;
+    }
+
+    quint32 previous = 0;
+    for (int i = 0; i < count; ++i) {
+        previous += static_cast<quint32>(planes[i])
+            | static_cast<quint32>(planes[count + i]) << 8
+            | static_cast<quint32>(planes[2 * count + i]) << 16
+            | static_cast<quint32>(planes[3 * count + i]) << 24;
+        std::memcpy(out + i, &previous, sizeof(float));
+    }
+    return true;
+}
+
+/**
+ * @brief Compresses bytes in the LZ4 block layout
+ * @param data Bytes to compress
+ * @param size Number of bytes
+ * @param out Receives the compressed bytes, appended
+ *
+ * Greedy single pass: every position is hashed, and the first earlier
+ * occurrence of its four bytes within reach is extended as far as it goes.
+ */
+void SampleCodec::compress(const uchar* data, int size, QVector<uchar>& out)
+{
+    match_table_.fill(-1, 1 << HASH_BITS);
+
+    int position = 0;
+    int anchor = 0;
+    if (size > MATCH_SEARCH_LIMIT) {
+        const int searchEnd = size - MATCH_SEARCH_LIMIT;
+        const int matchEnd = size - LAST_LITERALS;
+
+        while (position <= searchEnd) {
+            const quint32 sequence = read32(data + position);
+            int& slot = match_table_[hashSequence(sequence)];
+            const int candidate = slot;
+            slot = position;
+
+            if (candidate < 0 || position - candidate > MAX_OFFSET || read32(data + candidate) != sequence) {
+                ++position;
+                continue;
+            }
+
+            int length = MIN_MATCH;
+            while (position + length < matchEnd && data[candidate + length] == data[position + length]) {
+                ++length;
+            }
+
+            appendSequence(out, data + anchor, position - anchor, position - candidate, length);
+            position += length;
+            anchor = position;
+        }
+    }
+
+    appendSequence(out, data + anchor, size - anchor, 0, 0);
+}
+
+/**
+ * @brief Decompresses bytes in the LZ4 block layout
+ * @param data Compressed bytes
+ * @param size Number of compressed bytes
+ * @param out Receives the decompressed bytes
+ * @param outSize Exact number of decompressed bytes expected
+ * @return False if the data is malformed
+ *
+ * Every length and offset is checked against both buffers, so malformed
+ * input fails instead of reading or writing out of bounds.
+ */
+bool SampleCodec::decompress(const uchar* data, qint64 size, uchar* out, int outSize)
+{
+    qint64 position = 0;
+    qint64 written = 0;
+
+    while (position < size) {
+        const uchar token = data[position++];
+
+        qint64 literalCount = token >> 4;
+        if (literalCount == LENGTH_MASK && !readLength(data, size, position, literalCount)) {
+            return false;
+        }
+        if (position + literalCount > size || written + literalCount > outSize) {
+            return false;
+        }
+        std::memcpy(out + written, data + position, static_cast<size_t>(literalCount));
+        position += literalCount;
+        written += literalCount;
+
+        // The last sequence has no match
+        if (position == size) {
+            break;
+        }
+
+        if (position + 2 > size) {
+            return false;
+        }
+        const qint64 offset = data[position] | (data[position + 1] << 8);
+        position += 2;
+        if (offset == 0 || offset > written) {
+            return false;
+        }
+
+        qint64 matchLength = token & LENGTH_MASK;
+        if (matchLength == LENGTH_MASK && !readLength(data, size, position, matchLength)) {
+            return false;
+        }
+        matchLength += MIN_MATCH;
+        if (written + matchLength > outSize) {
+            return false;
+        }
+
+        // Byte by byte, since a match may overlap the bytes it produces
+        for (qint64 i = 0; i < matchLength; ++i, ++written) {
+            out[written] = out[written - offset];
+        }
+    }
+
+    return written == outSize;
+}
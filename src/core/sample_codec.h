@@ -0,0 +1,71 @@
+/**
+ * @file sample_codec.h
+ * @brief Definition of the SampleCodec class
+ *
+ * This file contains the definition of the SampleCodec class which compresses
+ * blocks of waveform samples for recordings.
+ */
+#ifndef SAMPLE_CODEC_H
+#define SAMPLE_CODEC_H
+
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * @brief Lossless compressor for blocks of float samples
+ *
+ * Waveforms change little from one sample to the next, so the bit pattern of
+ * each sample is replaced by its difference to the previous one and the
+ * differences are split into byte planes, which turns the mostly unchanged
+ * high bytes into long runs. The planes are then compressed with an LZ77 pass
+ * laid out like an LZ4 block: tokens of literal and match lengths, literals,
+ * and 16-bit match offsets.
+ *
+ * A codec keeps its scratch buffers between calls and must not be shared
+ * between threads.
+ */
+class SampleCodec {
+public:
+    /**
+     * @brief Compress a block of samples
+     * @param samples Samples; need not be aligned
+     * @param count Number of samples
+     * @param out Receives the compressed bytes, replacing its contents
+     */
+    void Encode(const void* samples, int count, QVector<uchar>& out);
+
+    /**
+     * @brief Decompress a block of samples
+     * @param data Compressed bytes
+     * @param size Number of compressed bytes
+     * @param count Number of samples the block holds
+     * @param out Receives count samples
+     * @return False if the data is malformed or does not hold count samples
+     */
+    bool Decode(const uchar* data, qint64 size, int count, float* out);
+
+private:
+    /**
+     * @brief Compress bytes in the LZ4 block layout
+     * @param data Bytes to compress
+     * @param size Number of bytes
+     * @param out Receives the compressed bytes, appended
+     */
+    void compress(const uchar* data, int size, QVector<uchar>& out);
+
+    /**
+     * @brief Decompress bytes in the LZ4 block layout
+     * @param data Compressed bytes
+     * @param size Number of compressed bytes
+     * @param out Receives the decompressed bytes
+     * @param outSize Exact number of decompressed bytes expected
+     * @return False if the data is malformed
+     */
+    static bool decompress(const uchar* data, qint64 size, uchar* out, int outSize);
+
+private:
+    QVector<uchar> planes_;                     ///< Byte planes of the sample differences
+    QVector<int> match_table_;                  ///< Last position of each hashed 4-byte sequence
+};
+
+#endif // SAMPLE_CODEC_H
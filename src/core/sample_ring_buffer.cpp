@@ -0,0 +1,192 @@
+/**
+ * @file sample_ring_buffer.cpp
+ * @brief Implementation of the SampleRingBuffer class
+ *
+ * This file implements the lock-free single-producer ring buffer used as the
+ * storage backend of WaveformModel. Writes and reads are performed as at most two
+ * contiguous copies, so their cost depends only on the number of samples moved
+ * and never on the capacity of the buffer.
+ */
+#include "sample_ring_buffer.h"
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @brief Constructs a ring buffer with the given capacity
+ * @param capacity Maximum number of samples retained
+ */
+SampleRingBuffer::SampleRingBuffer(int capacity)
+    : block_(std::make_shared<SampleBlock>(capacity))
+    , write_block_(block_.load(std::memory_order_relaxed).get())
+    , capacity_(std::max(capacity, 0))
+    , write_sequence_(0)
+    , read_sequence_(0)
+    , overrun_count_(0)
+{
+}
+
+/**
+ * @brief Gets the number of samples the buffer can retain
+ * @return Capacity in samples
+ */
+int SampleRingBuffer::GetCapacity() const
+{
+    return static_cast<int>(block_.load(std::memory_order_acquire)->samples.size());
+}
+
+/**
+ * @brief Reallocates the buffer with a new capacity
+ * @param capacity New capacity in samples
+ *
+ * All retained samples are discarded. The sequence counters are not rewound so
+ * that sequence numbers stay monotonic for the lifetime of the buffer; the
+ * consumer position is moved to the current write position. The new block
+ * starts at that position and is fully initialized before it is published,
+ * and snapshots taken before the reset keep referencing the previous block.
+ */
+void SampleRingBuffer::Reset(int capacity)
+{
+    const quint64 end = write_sequence_.load(std::memory_order_relaxed);
+
+    auto block = std::make_shared<SampleBlock>(capacity, end);
+    write_block_ = block.get();
+    capacity_ = std::max(capacity, 0);
+    block_.store(std::move(block), std::memory_order_release);
+    read_sequence_.store(end, std::memory_order_release);
+}
+
+/**
+ * @brief Appends samples to the buffer
+ * @param data Pointer to the samples
+ * @param count Number of samples
+ *
+ * If the chunk is larger than the buffer only its newest samples are stored, but
+ * the write sequence still advances by the full chunk length so that sequence
+ * numbers keep matching the number of samples produced. The claim sequence is
+ * published before the copy and the write sequence after it, which allows
+ * readers to detect slots that were recycled while they were reading.
+ */
+void SampleRingBuffer::Write(const float* data, int count)
+{
+    if (!data || count <= 0 || capacity_ == 0) {
+        return;
+    }
+
+    const quint64 end = write_sequence_.load(std::memory_order_relaxed) + static_cast<quint64>(count);
+    if (count > capacity_) {
+        data += count - capacity_;
+        count = capacity_;
+    }
+    const quint64 start = end - static_cast<quint64>(count);
+
+    write_block_->claim.store(end, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    float* storage = write_block_->samples.data();
+    const int offset = static_cast<int>(start % static_cast<quint64>(capacity_));
+    const int firstSpan = std::min(count, capacity_ - offset);
+    std::memcpy(storage + offset, data, sizeof(float) * firstSpan);
+    if (firstSpan < count) {
+        std::memcpy(storage, data + firstSpan, sizeof(float) * (count - firstSpan));
+    }
+
+    write_sequence_.store(end, std::memory_order_release);
+}
+
+/**
+ * @brief Gets the sequence number of the oldest retained sample
+ * @return Oldest readable sequence number
+ */
+quint64 SampleRingBuffer::GetOldestSequence() const
+{
+    return snapshotOf(block_.load(std::memory_order_acquire), 0, 0).GetFirstSequence();
+}
+
+/**
+ * @brief Takes a copy-free snapshot of the retained samples
+ * @param fromSequence First sequence number of interest
+ * @param lastTimestamp Timestamp to attach to the snapshot
+ * @return Snapshot covering the requested window
+ *
+ * Only the block reference is copied; the samples stay in place.
+ */
+WaveformSnapshot SampleRingBuffer::GetSnapshot(quint64 fromSequence, qint64 lastTimestamp) const
+{
+    return snapshotOf(block_.load(std::memory_order_acquire), fromSequence, lastTimestamp);
+}
+
+/**
+ * @brief Copies the samples written after a given sequence number
+ * @param sequence First sequence number the caller is interested in
+ * @param out Destination buffer
+ * @param maxCount Capacity of the destination buffer
+ * @param firstSequence Receives the sequence number of out[0]
+ * @return Number of samples copied
+ *
+ * The copy is validated after the fact: any leading samples whose slots the
+ * producer has claimed in the meantime are dropped and *firstSequence is moved
+ * forward accordingly.
+ */
+int SampleRingBuffer::ReadSince(quint64 sequence, float* out, int maxCount, quint64* firstSequence) const
+{
+    std::shared_ptr<const SampleBlock> block = block_.load(std::memory_order_acquire);
+    WaveformSnapshot snapshot = snapshotOf(block, sequence, 0);
+    if (!out || maxCount <= 0 || snapshot.isEmpty()) {
+        if (firstSequence) {
+            *firstSequence = snapshot.GetFirstSequence();
+        }
+        return 0;
+    }
+
+    // Limit the window to the oldest maxCount samples so the caller can resume
+    if (snapshot.size() > maxCount) {
+        snapshot = WaveformSnapshot(std::move(block), snapshot.GetFirstSequence(),
+                                    snapshot.GetFirstSequence() + static_cast<quint64>(maxCount));
+    }
+    return snapshot.CopyTo(out, firstSequence);
+}
+
+/**
+ * @brief Consumes samples from the shared read position
+ * @param out Destination buffer
+ * @param maxCount Capacity of the destination buffer
+ * @return Number of samples consumed
+ *
+ * Samples that were overwritten before the consumer got to them are skipped and
+ * added to the overrun counter.
+ */
+int SampleRingBuffer::Consume(float* out, int maxCount)
+{
+    const quint64 position = read_sequence_.load(std::memory_order_relaxed);
+    quint64 first = position;
+    const int count = ReadSince(position, out, maxCount, &first);
+
+    if (first > position) {
+        overrun_count_.fetch_add(first - position, std::memory_order_relaxed);
+    }
+    read_sequence_.store(first + static_cast<quint64>(count), std::memory_order_release);
+    return count;
+}
+
+/**
+ * @brief Takes a snapshot of a block the caller has loaded
+ * @param block Block to read
+ * @param fromSequence First sequence number of interest
+ * @param lastTimestamp Timestamp to attach to the snapshot
+ * @return Snapshot covering the samples of the block from fromSequence on
+ *
+ * The window is bounded by the block alone: by its base and capacity at the
+ * start, and at the end by its claim as well as the write sequence. A block
+ * replaced by Reset() keeps the claim it had then, so a reader that loaded it
+ * just before the reset never reaches samples that only the new block holds.
+ */
+WaveformSnapshot SampleRingBuffer::snapshotOf(std::shared_ptr<const SampleBlock> block, quint64 fromSequence,
+                                              qint64 lastTimestamp) const
+{
+    const quint64 written = GetWriteSequence();
+    const quint64 end = std::min(written, block->claim.load(std::memory_order_acquire));
+    const quint64 capacity = block->samples.size();
+    const quint64 oldest = std::max(block->base, end > capacity ? end - capacity : 0);
+    const quint64 start = std::min(std::max(fromSequence, oldest), end);
+    return WaveformSnapshot(std::move(block), start, end, lastTimestamp);
+}
@@ -0,0 +1,148 @@
+/**
+ * @file sample_ring_buffer.h
+ * @brief Definition of the SampleRingBuffer class
+ *
+ * This file contains the definition of the SampleRingBuffer class, a fixed-capacity
+ * single-producer/single-consumer ring buffer for waveform samples. Every sample
+ * written is assigned a monotonically increasing sequence number, which lets
+ * readers ask for "all samples since sequence N" without taking a lock and lets
+ * the producer ingest a chunk in O(chunk) instead of shifting the whole buffer.
+ */
+#ifndef SAMPLE_RING_BUFFER_H
+#define SAMPLE_RING_BUFFER_H
+
+#include "../../include/waveform_snapshot.h"
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+
+/**
+ * @brief Lock-free ring buffer of waveform samples
+ *
+ * The buffer is written by exactly one producer (the ingest path of a
+ * WaveformModel) and may be read concurrently without locks. The producer never
+ * waits for readers: once the buffer is full the oldest samples are overwritten.
+ *
+ * Three kinds of readers are supported:
+ * - Snapshot readers call GetSnapshot() and read the samples in place through a
+ *   reference-counted WaveformSnapshot, without copying.
+ * - Windowed readers (views) call ReadSince() with the last sequence they saw and
+ *   receive a copy of every sample that is still retained after it.
+ * - The single consuming reader calls Consume(), which advances the shared read
+ *   sequence and counts any samples lost to overruns.
+ *
+ * Readers validate the range they read against the producer's claim sequence
+ * afterwards, in the manner of a seqlock, so samples that were overwritten while being
+ * copied are discarded rather than returned torn. Every read loads the current block
+ * once and takes its capacity and bounds from that block, so a concurrent Reset()
+ * can never pair one block with the geometry of another.
+ */
+class SampleRingBuffer
+{
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Maximum number of samples retained
+     */
+    explicit SampleRingBuffer(int capacity = 0);
+
+    /**
+     * @brief Get the number of samples the buffer can retain
+     * @return Capacity in samples
+     */
+    int GetCapacity() const;
+
+    /**
+     * @brief Reallocate the buffer with a new capacity
+     * @param capacity New capacity in samples
+     *
+     * Discards all retained samples but keeps the sequence counters running, so
+     * readers holding an old sequence simply observe a gap. A new block is
+     * published atomically, so concurrent readers see either the old block or the
+     * new one, and outstanding snapshots keep the old one alive. Must not run
+     * concurrently with Write().
+     */
+    void Reset(int capacity);
+
+    /**
+     * @brief Append samples to the buffer (producer only)
+     * @param data Pointer to the samples
+     * @param count Number of samples
+     */
+    void Write(const float* data, int count);
+
+    /**
+     * @brief Get the sequence number one past the newest sample
+     * @return Total number of samples ever written
+     */
+    quint64 GetWriteSequence() const { return write_sequence_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Get the sequence number of the oldest retained sample
+     * @return Oldest readable sequence number
+     */
+    quint64 GetOldestSequence() const;
+
+    /**
+     * @brief Take a copy-free snapshot of the retained samples
+     * @param fromSequence First sequence number of interest
+     * @param lastTimestamp Timestamp to attach to the snapshot
+     * @return Snapshot covering [max(fromSequence, oldest), write sequence)
+     */
+    WaveformSnapshot GetSnapshot(quint64 fromSequence = 0, qint64 lastTimestamp = 0) const;
+
+    /**
+     * @brief Copy the samples written after a given sequence number
+     * @param sequence First sequence number the caller is interested in
+     * @param out Destination buffer
+     * @param maxCount Capacity of the destination buffer
+     * @param firstSequence Receives the sequence number of out[0]
+     * @return Number of samples copied
+     *
+     * Copies at most maxCount samples starting at sequence, or at the oldest
+     * retained sample if sequence has already been overwritten. The caller can
+     * resume with *firstSequence + the returned count.
+     */
+    int ReadSince(quint64 sequence, float* out, int maxCount, quint64* firstSequence) const;
+
+    /**
+     * @brief Consume samples from the shared read position (single consumer only)
+     * @param out Destination buffer
+     * @param maxCount Capacity of the destination buffer
+     * @return Number of samples consumed
+     */
+    int Consume(float* out, int maxCount);
+
+    /**
+     * @brief Get the sequence number of the next sample Consume() will return
+     * @return Read sequence number
+     */
+    quint64 GetReadSequence() const { return read_sequence_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Get the number of samples overwritten before the consumer read them
+     * @return Overrun sample count
+     */
+    quint64 GetOverrunCount() const { return overrun_count_.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief Take a snapshot of a block the caller has loaded
+     * @param block Block to read
+     * @param fromSequence First sequence number of interest
+     * @param lastTimestamp Timestamp to attach to the snapshot
+     * @return Snapshot covering the samples of the block from fromSequence on
+     */
+    WaveformSnapshot snapshotOf(std::shared_ptr<const SampleBlock> block, quint64 fromSequence,
+                                qint64 lastTimestamp) const;
+
+private:
+    std::atomic<std::shared_ptr<SampleBlock>> block_;   ///< Sample storage shared with snapshots, replaced by Reset()
+    SampleBlock* write_block_;                    ///< Producer's view of block_
+    int capacity_;                                ///< Number of slots of write_block_ (producer only)
+    std::atomic<quint64> write_sequence_;         ///< End of the range that is fully published
+    std::atomic<quint64> read_sequence_;          ///< Consumer read position
+    std::atomic<quint64> overrun_count_;          ///< Samples lost by the consumer
+};
+
+#endif // SAMPLE_RING_BUFFER_H
@@ -0,0 +1,113 @@
+/**
+ * @file spsc_queue.h
+ * @brief Definition of the SpscQueue class template
+ *
+ * This file contains a bounded single-producer/single-consumer queue used to
+ * hand work between two threads without locks. Unlike the SampleRingBuffer it
+ * never overwrites: a push into a full queue fails, so the producer decides
+ * what to do with data the consumer cannot keep up with.
+ */
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <vector>
+
+/**
+ * @brief Bounded lock-free single-producer/single-consumer queue
+ *
+ * TryPush() is called by one producer thread and TryPop() by one consumer
+ * thread at a time; neither ever waits. Several threads may take turns in one
+ * role if they serialize among themselves, for example behind a mutex.
+ *
+ * @tparam T Copyable element type, typically a pointer
+ */
+template <typename T>
+class SpscQueue
+{
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Maximum number of queued elements
+     */
+    explicit SpscQueue(int capacity = 0)
+        : head_(0)
+        , tail_(0)
+    {
+        Reset(capacity);
+    }
+
+    /**
+     * @brief Empty the queue and change its capacity
+     * @param capacity Maximum number of queued elements
+     *
+     * Not thread-safe; neither the producer nor the consumer may be active.
+     */
+    void Reset(int capacity)
+    {
+        // One slot stays free to tell a full queue from an empty one
+        slots_.assign(static_cast<size_t>(qMax(capacity, 0)) + 1, T());
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Append an element (producer only)
+     * @param value Element to append
+     * @return False if the queue is full
+     */
+    bool TryPush(const T& value)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t next = tail + 1 == slots_.size() ? 0 : tail + 1;
+        if (next == head_.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        slots_[tail] = value;
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element (consumer only)
+     * @param value Receives the element
+     * @return False if the queue is empty
+     */
+    bool TryPop(T& value)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        value = slots_[head];
+        head_.store(head + 1 == slots_.size() ? 0 : head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Get the number of queued elements
+     * @return Element count; only a snapshot while either side is active
+     */
+    int GetSize() const
+    {
+        const size_t head = head_.load(std::memory_order_acquire);
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        return static_cast<int>(tail >= head ? tail - head : tail + slots_.size() - head);
+    }
+
+    /**
+     * @brief Get the maximum number of queued elements
+     * @return Capacity
+     */
+    int GetCapacity() const { return static_cast<int>(slots_.size()) - 1; }
+
+private:
+    std::vector<T> slots_;                      ///< Element storage
+    alignas(64) std::atomic<size_t> head_;      ///< Next slot to pop, owned by the consumer
+    alignas(64) std::atomic<size_t> tail_;      ///< Next slot to push, owned by the producer
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,374 @@
+/**
+ * @file stream_server.cpp
+ * @brief Implementation of the StreamServer class
+ *
+ * This file implements the StreamServer class which encodes every ingested
+ * frame once and fans the encoded buffer out to the bounded queues of all
+ * connected viewers, writing them from a thread of its own.
+ */
+#include "stream_server.h"
+#include "../utils/log_categories.h"
+#include "../utils/metrics.h"
+#include <QDebug>
+#include <QMutexLocker>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <algorithm>
+
+/**
+ * @namespace Anonymous namespace for constants
+ * @brief Contains constants used by the StreamServer implementation
+ */
+namespace {
+    const int DEFAULT_QUEUE_CAPACITY = 64;          ///< Default frames queued per subscriber, about 2.5 s at 25 frames/s
+    const int MIN_QUEUE_CAPACITY = 2;               ///< Fewest frames queued per subscriber
+    const int DEFAULT_MAX_SUBSCRIBERS = 256;        ///< Default largest number of subscribers
+}
+
+/**
+ * @brief Constructor
+ * @param bedId Bed named in the log, empty for the primary bed
+ */
+StreamServer::StreamServer(const QString& bedId)
+    : bed_id_(bedId)
+    , queue_capacity_(DEFAULT_QUEUE_CAPACITY)
+    , max_subscribers_(DEFAULT_MAX_SUBSCRIBERS)
+    , encoding_(NetworkFrameCodec::SampleEncoding::Int16)
+    , open_(false)
+    , flush_pending_(false)
+    , subscriber_count_(0)
+    , sequence_(0)
+    , dropped_frames_(0)
+    , port_(0)
+    , context_(nullptr)
+    , server_(nullptr)
+{
+}
+
+/**
+ * @brief Destructor
+ *
+ * Closes the server if it is still open.
+ */
+StreamServer::~StreamServer()
+{
+    Close();
+}
+
+/**
+ * @brief Sets how many frames may wait for a subscriber
+ * @param frames Queue capacity per subscriber
+ */
+void StreamServer::SetQueueCapacity(int frames)
+{
+    QMutexLocker locker(&mutex_);
+    queue_capacity_ = std::max(MIN_QUEUE_CAPACITY, frames);
+}
+
+/**
+ * @brief Sets the largest number of subscribers
+ * @param subscribers Connections beyond this number are refused
+ */
+void StreamServer::SetMaxSubscribers(int subscribers)
+{
+    QMutexLocker locker(&mutex_);
+    max_subscribers_ = std::max(1, subscribers);
+}
+
+/**
+ * @brief Sets the packing of the waveform samples
+ * @param encoding Sample encoding of the frames sent
+ */
+void StreamServer::SetEncoding(NetworkFrameCodec::SampleEncoding encoding)
+{
+    QMutexLocker locker(&mutex_);
+    encoding_ = encoding;
+}
+
+/**
+ * @brief Starts the server's thread and listens for subscribers
+ * @param port TCP port, 0 for any free port
+ * @param address Address to listen on
+ * @return True if the server is listening
+ */
+bool StreamServer::Open(quint16 port, const QHostAddress& address)
+{
+    Close();
+
+    thread_ = std::make_unique<QThread>();
+    thread_->setObjectName(bed_id_.isEmpty() ? QString("VitalSyncStream") : QString("VitalSyncStream %1").arg(bed_id_));
+    context_ = new QObject();
+    context_->moveToThread(thread_.get());
+    thread_->start();
+
+    // Sockets are created and used on the server's thread only
+    bool listening = false;
+    QString error;
+    QMetaObject::invokeMethod(context_, [this, port, &address, &listening, &error]() {
+        server_ = new QTcpServer(context_);
+        QObject::connect(server_, &QTcpServer::newConnection, context_, [this]() { acceptConnections(); });
+        listening = server_->listen(address, port);
+        if (listening) {
+            port_.store(server_->serverPort(), std::memory_order_relaxed);
+        } else {
+            error = server_->errorString();
+        }
+    }, Qt::BlockingQueuedConnection);
+
+    if (!listening) {
+        qWarning() << "StreamServer: Cannot listen on port" << port << ":" << error;
+        Close();
+        return false;
+    }
+
+    {
+        QMutexLocker locker(&mutex_);
+        sequence_.store(0, std::memory_order_relaxed);
+        dropped_frames_.store(0, std::memory_order_relaxed);
+        flush_pending_ = false;
+        open_ = true;
+    }
+
+    qCInfo(lcIngest) << "StreamServer: Streaming" << (bed_id_.isEmpty() ? QString("primary bed") : bed_id_)
+                    << "on port" << GetPort();
+    return true;
+}
+
+/**
+ * @brief Disconnects all subscribers, stops listening and stops the server's thread
+ *
+ * Publishing stops before the sockets go away, so a frame the acquisition
+ * thread is publishing at this moment completes first.
+ */
+void StreamServer::Close()
+{
+    if (!thread_) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&mutex_);
+        open_ = false;
+    }
+
+    QMetaObject::invokeMethod(context_, [this]() {
+        std::vector<std::unique_ptr<Subscriber>> subscribers;
+        {
+            QMutexLocker locker(&mutex_);
+            subscribers.swap(subscribers_);
+            subscriber_count_.store(0, std::memory_order_relaxed);
+        }
+        for (const auto& subscriber : subscribers) {
+            QObject::disconnect(subscriber->socket, nullptr, context_, nullptr);
+            subscriber->socket->abort();
+        }
+
+        // Deletes the connections with it
+        delete server_;
+        server_ = nullptr;
+    }, Qt::BlockingQueuedConnection);
+
+    thread_->quit();
+    thread_->wait();
+    delete context_;
+    context_ = nullptr;
+    thread_.reset();
+
+    port_.store(0, std::memory_order_relaxed);
+    qCInfo(lcIngest) << "StreamServer: Closed after" << GetDroppedFrameCount() << "frames dropped for slow subscribers";
+}
+
+/**
+ * @brief Checks if the server is listening
+ * @return True if open
+ */
+bool StreamServer::IsOpen() const
+{
+    QMutexLocker locker(&mutex_);
+    return open_;
+}
+
+/**
+ * @brief Gets the port the server listens on
+ * @return Port, 0 if not open
+ */
+quint16 StreamServer::GetPort() const
+{
+    return port_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the number of connected subscribers
+ * @return Subscriber count
+ */
+int StreamServer::GetSubscriberCount() const
+{
+    return subscriber_count_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the number of frames dropped for slow subscribers
+ * @return Frames dropped since Open(), summed over all subscribers
+ */
+quint64 StreamServer::GetDroppedFrameCount() const
+{
+    return dropped_frames_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Encodes a frame once and queues it for every subscriber
+ * @param frame Ingested frame
+ *
+ * The frame is encoded outside the lock into a buffer that all queues share;
+ * under the lock every subscriber only gets a reference to it, and a full
+ * queue loses its oldest frame. One flush per batch of frames is posted to
+ * the server's thread.
+ */
+void StreamServer::Publish(const VitalSync::DataFrame& frame)
+{
+    if (subscriber_count_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+
+    NetworkFrameCodec::SampleEncoding encoding;
+    {
+        QMutexLocker locker(&mutex_);
+        encoding = encoding_;
+    }
+
+    QByteArray encoded;
+    if (!NetworkFrameCodec::Encode(frame, sequence_.fetch_add(1, std::memory_order_relaxed), encoding, encoded)) {
+        return;
+    }
+
+    QMutexLocker locker(&mutex_);
+    if (!open_) {
+        return;
+    }
+
+    for (const auto& subscriber : subscribers_) {
+        if (static_cast<int>(subscriber->queue.size()) >= queue_capacity_) {
+            subscriber->queue.pop_front();
+            ++subscriber->dropped;
+            dropped_frames_.fetch_add(1, std::memory_order_relaxed);
+            Metrics::Add(Metrics::Counter::StreamFramesDropped);
+        }
+        subscriber->queue.push_back(encoded);
+    }
+
+    if (!flush_pending_) {
+        flush_pending_ = true;
+        QMetaObject::invokeMethod(context_, [this]() { flush(); }, Qt::QueuedConnection);
+    }
+}
+
+/**
+ * @brief Takes the pending connections as subscribers
+ *
+ * Connections beyond the subscriber limit are closed right away. A new
+ * subscriber starts with the next published frame.
+ */
+void StreamServer::acceptConnections()
+{
+    while (server_ && server_->hasPendingConnections()) {
+        QTcpSocket* socket = server_->nextPendingConnection();
+
+        QMutexLocker locker(&mutex_);
+        if (static_cast<int>(subscribers_.size()) >= max_subscribers_) {
+            locker.unlock();
+            qWarning() << "StreamServer: Refusing" << socket->peerAddress().toString() << "- subscriber limit reached";
+            socket->abort();
+            socket->deleteLater();
+            continue;
+        }
+
+        auto subscriber = std::make_unique<Subscriber>();
+        subscriber->socket = socket;
+        subscribers_.push_back(std::move(subscriber));
+        subscriber_count_.store(static_cast<int>(subscribers_.size()), std::memory_order_relaxed);
+        locker.unlock();
+
+        // Viewers only listen; what they send is discarded
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        QObject::connect(socket, &QTcpSocket::readyRead, context_, [socket]() { socket->readAll(); });
+        QObject::connect(socket, &QTcpSocket::bytesWritten, context_, [this]() { flush(); });
+        QObject::connect(socket, &QTcpSocket::disconnected, context_, [this, socket]() { removeSubscriber(socket); });
+
+        qCInfo(lcIngest) << "StreamServer: Subscriber" << socket->peerAddress().toString() << "connected,"
+                        << GetSubscriberCount() << "in total";
+    }
+}
+
+/**
+ * @brief Removes the subscriber of a closed connection
+ * @param socket Connection
+ */
+void StreamServer::removeSubscriber(QTcpSocket* socket)
+{
+    quint64 dropped = 0;
+    {
+        QMutexLocker locker(&mutex_);
+        auto it = std::find_if(subscribers_.begin(), subscribers_.end(),
+                               [socket](const std::unique_ptr<Subscriber>& subscriber) {
+                                   return subscriber->socket == socket;
+                               });
+        if (it == subscribers_.end()) {
+            return;
+        }
+        dropped = (*it)->dropped;
+        subscribers_.erase(it);
+        subscriber_count_.store(static_cast<int>(subscribers_.size()), std::memory_order_relaxed);
+    }
+
+    qCInfo(lcIngest) << "StreamServer: Subscriber" << socket->peerAddress().toString() << "disconnected after"
+                    << dropped << "dropped frames";
+    socket->deleteLater();
+}
+
+/**
+ * @brief Writes queued frames to the sockets that have room
+ *
+ * Frames are taken from the front of each queue under the lock, only as long
+ * as the socket's write buffer stays below the high-water mark, and written
+ * without it, so publishing is never held up by the sockets. The rest stay
+ * queued, still subject to the queue's drop policy, until the socket drains
+ * and bytesWritten() flushes again.
+ */
+void StreamServer::flush()
+{
+    struct Pending {
+        QTcpSocket* socket;
+        std::deque<QByteArray> frames;
+    };
+    std::vector<Pending> pending;
+    quint64 sent = 0;
+
+    {
+        QMutexLocker locker(&mutex_);
+        flush_pending_ = false;
+        for (const auto& subscriber : subscribers_) {
+            qint64 buffered = subscriber->socket->bytesToWrite();
+            if (subscriber->queue.empty() || buffered >= SOCKET_HIGH_WATER_BYTES) {
+                continue;
+            }
+            pending.push_back({ subscriber->socket, {} });
+            while (!subscriber->queue.empty() && buffered < SOCKET_HIGH_WATER_BYTES) {
+                buffered += subscriber->queue.front().size();
+                pending.back().frames.push_back(std::move(subscriber->queue.front()));
+                subscriber->queue.pop_front();
+            }
+            sent += pending.back().frames.size();
+        }
+    }
+
+    // Sockets are only removed on this thread, so they are still alive here
+    for (Pending& entry : pending) {
+        for (const QByteArray& frame : entry.frames) {
+            entry.socket->write(frame);
+        }
+    }
+
+    if (sent > 0) {
+        Metrics::Add(Metrics::Counter::StreamFramesSent, sent);
+    }
+}
@@ -0,0 +1,185 @@
+/**
+ * @file stream_server.h
+ * @brief Definition of the StreamServer class
+ *
+ * This file contains the definition of the StreamServer class which serves
+ * the data ingested by a DataManager to remote viewers over TCP, in the frame
+ * format the NetworkDataProvider reads.
+ */
+#ifndef STREAM_SERVER_H
+#define STREAM_SERVER_H
+
+#include "../../include/data_frame.h"
+#include "../providers/network_frame_codec.h"
+#include <QByteArray>
+#include <QHostAddress>
+#include <QMutex>
+#include <QString>
+#include <QThread>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+class QTcpServer;
+class QTcpSocket;
+
+/**
+ * @brief Fan-out server of live frames
+ *
+ * The data manager hands every ingested frame to the server once. The server
+ * encodes it once with NetworkFrameCodec and queues the same implicitly
+ * shared buffer for every subscriber, so the cost of a frame grows with the
+ * number of viewers only by a reference count and a queue slot each.
+ *
+ * Each subscriber has a bounded queue. A writer thread moves queued frames
+ * into the subscriber's socket while the socket has less than
+ * SOCKET_HIGH_WATER_BYTES waiting; a viewer that reads slower than the data
+ * arrives stops taking frames, its queue fills up and its oldest frames are
+ * dropped. Frames are always dropped whole, so the viewer sees a gap in the
+ * sequence numbers, never a broken frame, and other viewers are unaffected.
+ *
+ * Nothing is encoded while no viewer is connected. Publish() may be called
+ * from the acquisition thread while the server is opened or closed from
+ * another thread.
+ */
+class StreamServer {
+public:
+    static constexpr qint64 SOCKET_HIGH_WATER_BYTES = 256 * 1024;  ///< Socket backlog above which a subscriber takes no frames
+
+    /**
+     * @brief Constructor
+     * @param bedId Bed named in the log, empty for the primary bed
+     */
+    explicit StreamServer(const QString& bedId = QString());
+
+    /**
+     * @brief Destructor
+     *
+     * Closes the server if it is still open.
+     */
+    ~StreamServer();
+
+    StreamServer(const StreamServer&) = delete;
+    StreamServer& operator=(const StreamServer&) = delete;
+
+    /**
+     * @brief Set how many frames may wait for a subscriber
+     * @param frames Queue capacity per subscriber
+     *
+     * Takes effect with the next Open().
+     */
+    void SetQueueCapacity(int frames);
+
+    /**
+     * @brief Set the largest number of subscribers
+     * @param subscribers Connections beyond this number are refused
+     */
+    void SetMaxSubscribers(int subscribers);
+
+    /**
+     * @brief Set the packing of the waveform samples
+     * @param encoding Sample encoding of the frames sent
+     */
+    void SetEncoding(NetworkFrameCodec::SampleEncoding encoding);
+
+    /**
+     * @brief Start listening for subscribers
+     * @param port TCP port, 0 for any free port
+     * @param address Address to listen on
+     * @return True if the server is listening
+     */
+    bool Open(quint16 port, const QHostAddress& address = QHostAddress::Any);
+
+    /**
+     * @brief Disconnect all subscribers and stop listening
+     */
+    void Close();
+
+    /**
+     * @brief Check if the server is listening
+     * @return True if open
+     */
+    bool IsOpen() const;
+
+    /**
+     * @brief Get the port the server listens on
+     * @return Port, 0 if not open
+     */
+    quint16 GetPort() const;
+
+    /**
+     * @brief Get the number of connected subscribers
+     * @return Subscriber count
+     */
+    int GetSubscriberCount() const;
+
+    /**
+     * @brief Get the number of frames dropped for slow subscribers
+     * @return Frames dropped since Open(), summed over all subscribers
+     */
+    quint64 GetDroppedFrameCount() const;
+
+    /**
+     * @brief Encode a frame once and queue it for every subscriber
+     * @param frame Ingested frame
+     */
+    void Publish(const VitalSync::DataFrame& frame);
+
+private:
+    /**
+     * @brief A connected viewer
+     */
+    struct Subscriber {
+        QTcpSocket* socket = nullptr;   ///< Connection, owned by the server's thread
+        std::deque<QByteArray> queue;   ///< Encoded frames not yet written, shared with the other subscribers
+        quint64 dropped = 0;            ///< Frames dropped for this subscriber
+    };
+
+    /**
+     * @brief Take the pending connections as subscribers
+     *
+     * Runs on the server's thread.
+     */
+    void acceptConnections();
+
+    /**
+     * @brief Remove the subscriber of a closed connection
+     * @param socket Connection
+     *
+     * Runs on the server's thread.
+     */
+    void removeSubscriber(QTcpSocket* socket);
+
+    /**
+     * @brief Write queued frames to the sockets that have room
+     *
+     * Runs on the server's thread.
+     */
+    void flush();
+
+private:
+    const QString bed_id_;                      ///< Bed named in the log
+    mutable QMutex mutex_;                      ///< Guards the settings and the subscriber queues
+
+    // Settings
+    int queue_capacity_;                        ///< Frames queued per subscriber
+    int max_subscribers_;                       ///< Largest number of subscribers
+    NetworkFrameCodec::SampleEncoding encoding_;  ///< Packing of the waveform samples
+
+    // Shared state
+    bool open_;                                 ///< Whether the server is listening
+    bool flush_pending_;                        ///< Whether a flush is posted to the server's thread
+    std::vector<std::unique_ptr<Subscriber>> subscribers_;  ///< Connected viewers, added and removed on the server's thread
+    std::atomic<int> subscriber_count_;         ///< Size of subscribers_, read without the lock
+    std::atomic<quint32> sequence_;             ///< Sequence number of the next frame
+    std::atomic<quint64> dropped_frames_;       ///< Frames dropped for slow subscribers
+    std::atomic<quint16> port_;                 ///< Port listened on
+
+    // Server thread
+    std::unique_ptr<QThread> thread_;           ///< Thread owning the sockets
+    QObject* context_;                          ///< Lives on the server's thread, parent of the listening socket
+    QTcpServer* server_;                        ///< Listening socket, parent of the connections
+};
+
+#endif // STREAM_SERVER_H
@@ -0,0 +1,215 @@
+/**
+ * @file trend_store.cpp
+ * @brief Implementation of the TrendStore class
+ *
+ * This file implements the raw measurement ring and the incremental rollups
+ * of the TrendStore, and queries that visit only the buckets of the window.
+ */
+#include "trend_store.h"
+#include <algorithm>
+#include <iterator>
+
+/**
+ * @namespace Anonymous namespace for constants and helper functions
+ * @brief Contains the retention settings used by the TrendStore implementation
+ */
+namespace {
+    const int RAW_CAPACITY = 1024;                      ///< Retained raw measurements
+    const qint64 MINUTE_MS = 60 * 1000;                 ///< One minute
+    const qint64 HOUR_MS = 60 * MINUTE_MS;              ///< One hour
+    const qint64 DAY_MS = 24 * HOUR_MS;                 ///< One day
+
+    /**
+     * @brief Bucket duration and retention of a rollup level
+     */
+    struct LevelSpec {
+        TrendResolution resolution;     ///< Resolution served by the level
+        qint64 duration_ms;             ///< Time span of one bucket
+        qint64 retention_ms;            ///< Time span of the ring
+    };
+
+    const LevelSpec LEVEL_SPECS[] = {
+        { TrendResolution::OneMinute, MINUTE_MS, DAY_MS },
+        { TrendResolution::FifteenMinutes, 15 * MINUTE_MS, 7 * DAY_MS },
+        { TrendResolution::OneHour, HOUR_MS, 30 * DAY_MS },
+    };
+
+    /**
+     * @brief Get the level index of a rollup resolution
+     * @param resolution Trend resolution
+     * @return Level index, -1 for raw
+     */
+    int levelIndex(TrendResolution resolution)
+    {
+        for (int i = 0; i < static_cast<int>(std::size(LEVEL_SPECS)); ++i) {
+            if (LEVEL_SPECS[i].resolution == resolution) {
+                return i;
+            }
+        }
+        return -1;
+    }
+}
+
+/**
+ * @brief Constructs an empty trend store
+ *
+ * No storage is allocated until the first measurement arrives, so parameters
+ * that are never measured cost nothing.
+ */
+TrendStore::TrendStore()
+    : raw_head_(0)
+    , raw_count_(0)
+{
+    static_assert(std::size(LEVEL_SPECS) == LEVEL_COUNT, "One spec per rollup level");
+}
+
+/**
+ * @brief Adds a measurement
+ * @param timestamp Measurement time in milliseconds since epoch
+ * @param value Measured value
+ *
+ * Values older than the current bucket of a level that has moved on are not
+ * folded into that level, since their bucket may already be recycled.
+ */
+void TrendStore::Add(qint64 timestamp, float value)
+{
+    if (timestamp < 0) {
+        return;
+    }
+    if (raw_.empty()) {
+        allocate();
+    }
+
+    raw_[static_cast<size_t>(raw_head_)] = RawSample{ timestamp, value };
+    raw_head_ = (raw_head_ + 1) % RAW_CAPACITY;
+    raw_count_ = std::min(raw_count_ + 1, RAW_CAPACITY);
+
+    for (Level& level : levels_) {
+        const qint32 id = static_cast<qint32>(timestamp / level.duration_ms);
+        if (level.newest_id >= 0 && id <= level.newest_id - level.capacity) {
+            continue;
+        }
+
+        Bucket& bucket = level.buckets[static_cast<size_t>(id % level.capacity)];
+        if (bucket.id != id) {
+            if (bucket.id > id) {
+                continue;
+            }
+            bucket = Bucket{ id, value, value, value, 1 };
+        } else {
+            bucket.min = std::min(bucket.min, value);
+            bucket.max = std::max(bucket.max, value);
+            bucket.sum += value;
+            ++bucket.count;
+        }
+        level.newest_id = std::max(level.newest_id, id);
+    }
+}
+
+/**
+ * @brief Gets the trend over a time window
+ * @param resolution Resolution of the trend
+ * @param fromTimestamp Start of the window in milliseconds since epoch, inclusive
+ * @param toTimestamp End of the window in milliseconds since epoch, exclusive
+ * @return Points in time order; empty buckets are left out
+ *
+ * Rollup queries visit each bucket of the window once, limited to the
+ * retained ones; a 24 hour trend at one minute reads at most 1440 buckets.
+ */
+QVector<TrendPoint> TrendStore::Query(TrendResolution resolution, qint64 fromTimestamp, qint64 toTimestamp) const
+{
+    QVector<TrendPoint> points;
+    if (raw_.empty() || toTimestamp <= fromTimestamp) {
+        return points;
+    }
+
+    const int index = levelIndex(resolution);
+    if (index < 0) {
+        // Raw measurements, oldest first
+        const int oldest = (raw_head_ - raw_count_ + RAW_CAPACITY) % RAW_CAPACITY;
+        for (int i = 0; i < raw_count_; ++i) {
+            const RawSample& sample = raw_[static_cast<size_t>((oldest + i) % RAW_CAPACITY)];
+            if (sample.timestamp >= fromTimestamp && sample.timestamp < toTimestamp) {
+                points.append(TrendPoint{ sample.timestamp, sample.value, sample.value, sample.value, 1 });
+            }
+        }
+        return points;
+    }
+
+    const Level& level = levels_[static_cast<size_t>(index)];
+    if (level.newest_id < 0) {
+        return points;
+    }
+
+    const qint64 firstRetained = std::max<qint64>(0, level.newest_id - level.capacity + 1);
+    const qint64 first = std::max(std::max<qint64>(fromTimestamp, 0) / level.duration_ms, firstRetained);
+    const qint64 last = std::min<qint64>((toTimestamp - 1) / level.duration_ms, level.newest_id);
+    if (last < first) {
+        return points;
+    }
+
+    points.reserve(static_cast<qsizetype>(last - first + 1));
+    for (qint64 id = first; id <= last; ++id) {
+        const Bucket& bucket = level.buckets[static_cast<size_t>(id % level.capacity)];
+        if (bucket.id == id) {
+            points.append(TrendPoint{ id * level.duration_ms, bucket.min, bucket.max,
+                                      bucket.sum / static_cast<float>(bucket.count),
+                                      static_cast<int>(bucket.count) });
+        }
+    }
+    return points;
+}
+
+/**
+ * @brief Removes all history and releases the storage
+ */
+void TrendStore::Clear()
+{
+    raw_.clear();
+    raw_.shrink_to_fit();
+    raw_head_ = 0;
+    raw_count_ = 0;
+    for (Level& level : levels_) {
+        level = Level();
+    }
+}
+
+/**
+ * @brief Gets the time span of one bucket
+ * @param resolution Rollup resolution
+ * @return Bucket duration in milliseconds, 0 for raw
+ */
+qint64 TrendStore::GetBucketDuration(TrendResolution resolution)
+{
+    const int index = levelIndex(resolution);
+    return index < 0 ? 0 : LEVEL_SPECS[index].duration_ms;
+}
+
+/**
+ * @brief Gets how far back a resolution reaches
+ * @param resolution Trend resolution
+ * @return Retention in milliseconds, 0 for raw whose reach depends on the measurement rate
+ */
+qint64 TrendStore::GetRetention(TrendResolution resolution)
+{
+    const int index = levelIndex(resolution);
+    return index < 0 ? 0 : LEVEL_SPECS[index].retention_ms;
+}
+
+/**
+ * @brief Allocates the rings
+ */
+void TrendStore::allocate()
+{
+    raw_.assign(RAW_CAPACITY, RawSample{ 0, 0.0f });
+    raw_head_ = 0;
+    raw_count_ = 0;
+
+    for (int i = 0; i < LEVEL_COUNT; ++i) {
+        Level& level = levels_[static_cast<size_t>(i)];
+        level.duration_ms = LEVEL_SPECS[i].duration_ms;
+        level.capacity = static_cast<int>(LEVEL_SPECS[i].retention_ms / LEVEL_SPECS[i].duration_ms);
+        level.newest_id = -1;
+        level.buckets.assign(static_cast<size_t>(level.capacity), Bucket{ -1, 0.0f, 0.0f, 0.0f, 0 });
+    }
+}
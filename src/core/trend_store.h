@@ -0,0 +1,116 @@
+/**
+ * @file trend_store.h
+ * @brief Definition of the TrendStore class
+ *
+ * This file contains the definition of the TrendStore class which keeps the
+ * history of one parameter as a short ring of raw measurements and
+ * fixed-size rings of minute, quarter-hour and hour rollups.
+ */
+#ifndef TREND_STORE_H
+#define TREND_STORE_H
+
+#include "../../include/parameter_trend.h"
+#include <QVector>
+#include <array>
+#include <vector>
+
+/**
+ * @brief Multi-resolution history of one parameter
+ *
+ * Every value is added to the raw ring and folded into the current bucket of
+ * each rollup level in O(1), so the rollups are always up to date and queries
+ * only read buckets. A bucket's slot in its ring follows from its start time,
+ * so queries address buckets directly and gaps in the data cost nothing to
+ * store. Storage is allocated when the first value arrives and stays fixed:
+ * about 70 KB per parameter for 24 hours of minutes, 7 days of quarter hours
+ * and 30 days of hours.
+ *
+ * Not thread-safe; the owning model serializes access.
+ */
+class TrendStore {
+public:
+    /**
+     * @brief Constructor
+     */
+    TrendStore();
+
+    /**
+     * @brief Add a measurement
+     * @param timestamp Measurement time in milliseconds since epoch
+     * @param value Measured value
+     */
+    void Add(qint64 timestamp, float value);
+
+    /**
+     * @brief Get the trend over a time window
+     * @param resolution Resolution of the trend
+     * @param fromTimestamp Start of the window in milliseconds since epoch, inclusive
+     * @param toTimestamp End of the window in milliseconds since epoch, exclusive
+     * @return Points in time order; empty buckets are left out
+     */
+    QVector<TrendPoint> Query(TrendResolution resolution, qint64 fromTimestamp, qint64 toTimestamp) const;
+
+    /**
+     * @brief Remove all history
+     */
+    void Clear();
+
+    /**
+     * @brief Get the time span of one bucket
+     * @param resolution Rollup resolution
+     * @return Bucket duration in milliseconds, 0 for raw
+     */
+    static qint64 GetBucketDuration(TrendResolution resolution);
+
+    /**
+     * @brief Get how far back a resolution reaches
+     * @param resolution Trend resolution
+     * @return Retention in milliseconds, 0 for raw whose reach depends on the measurement rate
+     */
+    static qint64 GetRetention(TrendResolution resolution);
+
+private:
+    /**
+     * @brief One raw measurement
+     */
+    struct RawSample {
+        qint64 timestamp;               ///< Measurement time
+        float value;                    ///< Measured value
+    };
+
+    /**
+     * @brief Rollup of the values in one bucket
+     */
+    struct Bucket {
+        qint32 id;                      ///< Bucket start divided by the bucket duration, -1 if unused
+        float min;                      ///< Lowest value
+        float max;                      ///< Highest value
+        float sum;                      ///< Sum of the values
+        quint32 count;                  ///< Number of values
+    };
+
+    /**
+     * @brief Ring of buckets of one resolution
+     */
+    struct Level {
+        qint64 duration_ms = 0;         ///< Time span of one bucket
+        int capacity = 0;               ///< Number of retained buckets
+        qint32 newest_id = -1;          ///< Newest bucket id, -1 if empty
+        std::vector<Bucket> buckets;    ///< Buckets indexed by id modulo capacity
+    };
+
+    /**
+     * @brief Allocate the rings
+     */
+    void allocate();
+
+private:
+    static constexpr int LEVEL_COUNT = 3;   ///< Rollup resolutions
+
+    std::vector<RawSample> raw_;            ///< Ring of recent measurements
+    int raw_head_;                          ///< Slot the next measurement goes to
+    int raw_count_;                         ///< Number of retained measurements
+    std::array<Level, LEVEL_COUNT> levels_; ///< Minute, quarter-hour and hour rollups
+};
+
+#endif // TREND_STORE_H
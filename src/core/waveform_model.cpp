@@ -11,9 +11,12 @@
 #include "waveform_model.h"
 #include "../../include/config_manager.h"
 #include "../../include/vital_sync_types.h"
+#include "../utils/log_categories.h"
+#include "../utils/metrics.h"
 #include <QDebug>
 #include <QDateTime>
 #include <QMutexLocker>
+#include <algorithm>
 #include <cmath>
 
 /**
@@ -21,6 +24,8 @@
  */
 namespace {
     const int DEFAULT_BUFFER_SIZE = 1000;  ///< Default number of samples to store in the waveform buffer
+    const double SAMPLE_RATE_SMOOTHING = 0.05;  ///< Weight of each new chunk in the sample rate estimate
+    const double MAX_CHUNK_GAP_PERIODS = 4.0;   ///< Chunk gaps longer than this many expected chunk periods are pauses, not measurements
 }
 
 /**
@@ -38,49 +43,21 @@ WaveformModel::WaveformModel(VitalSync::WaveformType waveformType, QObject* pare
     , display_name_(VitalSync::GetWaveformDisplayName(waveformType))
     , max_buffer_size_(DEFAULT_BUFFER_SIZE)
     , active_(true)
-    , is_demo_(true)  // Default to using demo data
+    , is_demo_(false)  // Show the ingested samples until told otherwise
     , last_update_timestamp_(0)
+    , ring_(DEFAULT_BUFFER_SIZE)
     , last_timestamp_(0)
+    , last_write_time_(0)
+    , sample_rate_(VitalSync::GetWaveformTraits(waveformType).sampleRate)
+    , nominal_sample_rate_(0.0)
+    , last_chunk_count_(0)
+    , sample_rate_measured_(false)
 {
-    // Set default min/max based on waveform type
-    auto [min, max] = VitalSync::GetDefaultWaveformRange(waveformType);
-    min_value_ = min;
-    max_value_ = max;
-    
-    // Set default color based on waveform type
-    switch (waveformType) {
-        case VitalSync::WaveformType::ECG_I:
-        case VitalSync::WaveformType::ECG_II:
-        case VitalSync::WaveformType::ECG_III:
-            color_ = QColor(0, 255, 0);  // Bright Green for ECG
-            break;
-        case VitalSync::WaveformType::RESP:
-            color_ = QColor(255, 255, 0);  // Bright Yellow for respiration
-            break;
-        case VitalSync::WaveformType::PLETH:
-            color_ = QColor(0, 255, 255);  // Bright Cyan for pleth
-            break;
-        case VitalSync::WaveformType::ABP:
-            color_ = QColor(255, 0, 0);  // Bright Red for arterial blood pressure
-            break;
-        case VitalSync::WaveformType::CAPNO:
-            color_ = QColor(255, 255, 255);  // White for capnography
-            break;
-        default:
-            color_ = QColor(255, 255, 255);  // White for default
-            break;
-    }
-    
-    // Reserve space for data buffer
-    data_.reserve(max_buffer_size_);
-
-    // Initialize with a sinusoidal pattern rather than flatline to ensure visibility
-    data_.resize(max_buffer_size_);
-    for (int i = 0; i < max_buffer_size_; ++i) {
-        // Create a simple sine wave pattern for initial display
-        double phase = (double)i / max_buffer_size_ * 2 * M_PI;
-        data_[i] = 0.5f * sinf(phase); // Small amplitude sine wave
-    }
+    // Set default range and color based on waveform type
+    const VitalSync::WaveformTraits& traits = VitalSync::GetWaveformTraits(waveformType);
+    min_value_ = traits.minValue;
+    max_value_ = traits.maxValue;
+    color_ = QColor(traits.color);
     
     // Load configuration if available
     auto& config = ConfigManager::GetInstance();
@@ -88,7 +65,7 @@ WaveformModel::WaveformModel(VitalSync::WaveformType waveformType, QObject* pare
     
     if (!waveformConfig.isEmpty()) {
         if (waveformConfig.contains("active")) {
-            active_ = waveformConfig["active"].toBool();
+            active_.store(waveformConfig["active"].toBool(), std::memory_order_relaxed);
         }
         
         if (waveformConfig.contains("color")) {
@@ -105,9 +82,19 @@ WaveformModel::WaveformModel(VitalSync::WaveformType waveformType, QObject* pare
         
         if (waveformConfig.contains("bufferSize")) {
             max_buffer_size_ = waveformConfig["bufferSize"].toInt();
-            data_.resize(max_buffer_size_);
+            ring_.Reset(max_buffer_size_);
         }
     }
+
+    // Initialize with a sinusoidal pattern rather than flatline to ensure visibility
+    QVector<float> initialData(max_buffer_size_);
+    for (int i = 0; i < max_buffer_size_; ++i) {
+        // Create a simple sine wave pattern for initial display
+        double phase = (double)i / max_buffer_size_ * 2 * M_PI;
+        initialData[i] = 0.5f * sinf(phase); // Small amplitude sine wave
+    }
+    ring_.Write(initialData.constData(), static_cast<int>(initialData.size()));
+    pyramid_.Write(initialData.constData(), static_cast<int>(initialData.size())); // Keep both sequence numberings in step
 }
 
 /**
@@ -120,7 +107,7 @@ WaveformModel::~WaveformModel()
 {
     // Save configuration
     QVariantMap config;
-    config["active"] = active_;
+    config["active"] = active_.load(std::memory_order_relaxed);
     config["color"] = color_;
     config["minValue"] = min_value_;
     config["maxValue"] = max_value_;
@@ -224,16 +211,168 @@ float WaveformModel::GetMaxValue() const
 }
 
 /**
- * @brief Gets the stored waveform data
- * @return Vector of waveform data points
+ * @brief Takes a copy-free snapshot of the stored waveform data
+ * @param fromSequence First sample sequence number of interest
+ * @return Read view over the retained samples
+ * 
+ * Returns a reference-counted view over the ring buffer covering every retained
+ * sample from fromSequence onwards. No samples are copied and mutex_ is not
+ * taken, so any number of views can read concurrently without ever blocking
+ * addWaveformData().
+ */
+WaveformSnapshot WaveformModel::GetSnapshot(quint64 fromSequence) const
+{
+    return ring_.GetSnapshot(fromSequence, last_timestamp_.load(std::memory_order_relaxed));
+}
+
+/**
+ * @brief Gets the current write sequence number
+ * @return Sequence number one past the newest sample
+ * 
+ * Returns the total number of samples written to this model, including the
+ * initial display pattern.
+ */
+quint64 WaveformModel::GetWriteSequence() const
+{
+    return ring_.GetWriteSequence();
+}
+
+/**
+ * @brief Reads the samples added after a given sequence number
+ * @param sequence First sequence number of interest
+ * @param out Receives the samples, oldest first
+ * @return Sequence number of the first sample in out
+ * 
+ * Copies only the samples written since sequence straight out of the ring
+ * buffer, without taking mutex_. The amount of work is proportional to the
+ * number of new samples rather than to the buffer size.
+ */
+quint64 WaveformModel::ReadSamplesSince(quint64 sequence, QVector<float>& out) const
+{
+    WaveformSnapshot snapshot = ring_.GetSnapshot(sequence);
+    out.resize(snapshot.size());
+    quint64 first = snapshot.GetFirstSequence();
+    int count = snapshot.CopyTo(out.data(), &first);
+    out.resize(count);
+    return first;
+}
+
+/**
+ * @brief Gets the min/max envelope of a time range
+ * @param fromTimestamp Start of the range in milliseconds since epoch
+ * @param toTimestamp End of the range in milliseconds since epoch
+ * @param columns Number of columns to divide the range into
+ * @param out Receives one envelope column per column
+ * @return Number of columns that hold data
+ *
+ * Timestamps are mapped to sample sequence numbers by counting back from the
+ * newest chunk at the measured sample rate. Ranges with fewer samples than a
+ * pyramid bucket per column are folded from the ring buffer while it still
+ * holds them, so zoomed-in envelopes keep their full detail; all others are
+ * served by the decimation pyramid in O(columns).
+ *
+ * mutex_ is not taken: the ring buffer is read lock-free and the pyramid
+ * under pyramid_mutex_, which the producer only holds while it summarizes a
+ * chunk, so envelope queries do not stall ingest.
+ */
+int WaveformModel::GetEnvelope(qint64 fromTimestamp, qint64 toTimestamp, int columns, QVector<EnvelopeColumn>& out) const
+{
+    out.fill(EnvelopeColumn(), std::max(columns, 0));
+    if (columns <= 0 || toTimestamp <= fromTimestamp) {
+        return 0;
+    }
+
+    QMutexLocker locker(&pyramid_mutex_);
+
+    // Read under pyramid_mutex_, which the producer also holds while advancing both
+    const qint64 lastTimestamp = last_timestamp_.load(std::memory_order_relaxed);
+    const qint64 end = static_cast<qint64>(pyramid_.GetWriteSequence());
+    if (lastTimestamp == 0 || end == 0) {
+        return 0;
+    }
+
+    // The newest sample belongs to the newest chunk timestamp
+    const double samplesPerMs = sample_rate_.load(std::memory_order_relaxed) / 1000.0;
+    auto toSequence = [&](qint64 timestamp) {
+        return end - 1 - std::llround(static_cast<double>(lastTimestamp - timestamp) * samplesPerMs);
+    };
+    const qint64 fromSequence = toSequence(fromTimestamp);
+    const qint64 toSequenceEnd = std::max(toSequence(toTimestamp), fromSequence + 1);
+    const double samplesPerColumn = static_cast<double>(toSequenceEnd - fromSequence) / columns;
+
+    if (samplesPerColumn >= DecimationPyramid::BASE_BUCKET_SIZE
+        || fromSequence < static_cast<qint64>(ring_.GetOldestSequence())) {
+        return pyramid_.Query(fromSequence, toSequenceEnd, columns, out.data());
+    }
+    locker.unlock();
+
+    int filled = 0;
+    const WaveformSnapshot snapshot = ring_.GetSnapshot(static_cast<quint64>(fromSequence));
+    snapshot.ForEachSpan([&](const float* samples, int count, quint64 firstSequence) {
+        for (int i = 0; i < count; ++i) {
+            const qint64 sequence = static_cast<qint64>(firstSequence) + i;
+            if (sequence >= toSequenceEnd) {
+                return;
+            }
+            const int column = std::min(static_cast<int>((sequence - fromSequence) / samplesPerColumn), columns - 1);
+            EnvelopeColumn& extent = out[column];
+            if (!extent.valid) {
+                extent = EnvelopeColumn{ samples[i], samples[i], true };
+                ++filled;
+            } else {
+                extent.min = std::min(extent.min, samples[i]);
+                extent.max = std::max(extent.max, samples[i]);
+            }
+        }
+    });
+    return filled;
+}
+
+/**
+ * @brief Gets the sample rate of the incoming data
+ * @return Samples per second
+ * 
+ * Returns the rate the source reported through SetNominalSampleRate(), or
+ * else the smoothed rate measured in addWaveformData(), or the system
+ * default rate before the second chunk has arrived.
+ */
+double WaveformModel::GetSampleRate() const
+{
+    return sample_rate_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Uses the sample rate the source reports instead of measuring it
+ * @param sampleRate Samples per second, ignored unless positive
  * 
- * Returns a reference to the vector containing the waveform
- * data points.
+ * Called by the ingest path for every chunk that carries a rate, before the
+ * chunk is filtered and added, so it only stores when the rate changes.
  */
-const QVector<float>& WaveformModel::GetData() const
+void WaveformModel::SetNominalSampleRate(double sampleRate)
+{
+    if (sampleRate > 0.0 && nominal_sample_rate_.exchange(sampleRate, std::memory_order_relaxed) != sampleRate) {
+        sample_rate_.store(sampleRate, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Forgets the timestamps and the sample rate of the previous source
+ * 
+ * The next source starts a timeline of its own, so its first chunk is not
+ * compared against the last timestamp of the previous one, and its rate is
+ * reported or measured afresh from the default rate of the waveform type.
+ * The sample sequence numbers keep running.
+ */
+void WaveformModel::ResetTiming()
 {
     QMutexLocker locker(&mutex_);
-    return data_;
+    last_chunk_count_ = 0;
+    sample_rate_measured_ = false;
+    nominal_sample_rate_.store(0.0, std::memory_order_relaxed);
+    sample_rate_.store(VitalSync::GetWaveformTraits(waveform_type_).sampleRate, std::memory_order_relaxed);
+    
+    QMutexLocker pyramidLocker(&pyramid_mutex_);
+    last_timestamp_.store(0, std::memory_order_relaxed);
 }
 
 /**
@@ -275,7 +414,7 @@ void WaveformModel::SetMaxBufferSize(int size)
         }
         
         max_buffer_size_ = size;
-        data_.resize(size);
+        ring_.Reset(size);
     }
     
     emit propertiesChanged();
@@ -286,13 +425,28 @@ void WaveformModel::SetMaxBufferSize(int size)
  * @param timestamp Timestamp of the data
  * @param data Vector of new data points
  * 
- * Adds new waveform data points to the circular buffer, handling
- * timestamp validation and buffer management. When data is added,
- * the dataUpdated signal is emitted to notify views.
+ * Convenience overload that forwards the vector's storage to the raw
+ * pointer overload without copying it.
  */
 void WaveformModel::addWaveformData(qint64 timestamp, const QVector<float>& data)
 {
-    if (data.isEmpty() || !active_) {
+    addWaveformData(timestamp, data.constData(), static_cast<int>(data.size()));
+}
+
+/**
+ * @brief Adds new waveform data to the buffer from raw memory
+ * @param timestamp Timestamp of the data
+ * @param data Pointer to the new data points
+ * @param count Number of data points
+ * 
+ * Adds new waveform data points to the ring buffer, handling
+ * timestamp validation. The cost is proportional to the chunk size only:
+ * no existing samples are moved and no memory is allocated. When data is
+ * added, the dataUpdated signal is emitted to notify views.
+ */
+void WaveformModel::addWaveformData(qint64 timestamp, const float* data, int count)
+{
+    if (!data || count <= 0 || !active_.load(std::memory_order_relaxed)) {
         return;
     }
     
@@ -300,40 +454,49 @@ void WaveformModel::addWaveformData(qint64 timestamp, const QVector<float>& data
         QMutexLocker locker(&mutex_);
         
         // Ensure timestamp is increasing (keeping this check for data integrity)
-        if (timestamp <= last_timestamp_ && last_timestamp_ != 0) {
-            qWarning() << "Received out-of-order waveform data for " << GetDisplayName()
-                       << ". Expected timestamp > " << last_timestamp_
-                       << ", got " << timestamp << ". Ignoring.";
+        const qint64 lastTimestamp = last_timestamp_.load(std::memory_order_relaxed);
+        if (timestamp <= lastTimestamp && lastTimestamp != 0) {
+            Metrics::Add(Metrics::Counter::OutOfOrderRejects);
+            qCWarning(lcIngest) << "Received out-of-order waveform data for " << GetDisplayName()
+                                << ". Expected timestamp > " << lastTimestamp
+                                << ", got " << timestamp << ". Ignoring.";
             return;
         }
         
-        last_timestamp_ = timestamp;
-        
-        // Add new data to the buffer, shifting out old data if necessary
-        int numToAdd = data.size();
-        int bufferSize = data_.size();
+        // Estimate the sample rate from the spacing of the chunk timestamps unless
+        // the source reports it. Smoothing absorbs the jitter of timer-driven
+        // providers; a gap far longer than the previous chunk should have taken
+        // is a pause of the source and is not measured.
+        const double current = sample_rate_.load(std::memory_order_relaxed);
+        if (lastTimestamp != 0 && last_chunk_count_ > 0 && nominal_sample_rate_.load(std::memory_order_relaxed) <= 0.0) {
+            const double gap = static_cast<double>(timestamp - lastTimestamp);
+            const double expectedGap = last_chunk_count_ * 1000.0 / current;
+            if (gap <= MAX_CHUNK_GAP_PERIODS * expectedGap || !sample_rate_measured_) {
+                const double measured = last_chunk_count_ * 1000.0 / gap;
+                sample_rate_.store(sample_rate_measured_ ? current + SAMPLE_RATE_SMOOTHING * (measured - current)
+                                                         : measured,
+                                   std::memory_order_relaxed);
+                sample_rate_measured_ = true;
+            }
+        }
+        last_chunk_count_ = count;
         
-        // Print actual data for debugging
-        qDebug() << "WaveformModel::addWaveformData - ID:" << GetWaveformId() 
-                 << "Type:" << static_cast<int>(waveform_type_)
-                 << "Data size:" << data.size() 
-                 << "First 3 values:" << (data.size() > 0 ? data[0] : 0.0)
-                 << (data.size() > 1 ? data[1] : 0.0)
-                 << (data.size() > 2 ? data[2] : 0.0);
+        VITALSYNC_TRACE(lcIngest) << "WaveformModel::addWaveformData - ID:" << GetWaveformId()
+                                  << "Type:" << static_cast<int>(waveform_type_)
+                                  << "Data size:" << count
+                                  << "First 3 values:" << (count > 0 ? data[0] : 0.0)
+                                  << (count > 1 ? data[1] : 0.0)
+                                  << (count > 2 ? data[2] : 0.0);
         
-        if (numToAdd >= bufferSize) {
-            // If new data is larger than buffer, just take the most recent points
-            data_ = data.mid(data.size() - bufferSize);
-        } else {
-            // Shift existing data and add new data
-            for (int i = 0; i < bufferSize - numToAdd; ++i) {
-                data_[i] = data_[i + numToAdd];
-            }
-            
-            for (int i = 0; i < numToAdd; ++i) {
-                data_[bufferSize - numToAdd + i] = data[i];
-            }
+        // Append to the ring buffer; the oldest samples are overwritten in place
+        ring_.Write(data, count);
+        {
+            // The timestamp is published with the pyramid so envelopes map time to sequence consistently
+            QMutexLocker pyramidLocker(&pyramid_mutex_);
+            pyramid_.Write(data, count);
+            last_timestamp_.store(timestamp, std::memory_order_relaxed);
         }
+        last_write_time_.store(Metrics::Now(), std::memory_order_relaxed);
     }
     
     emit dataUpdated();
@@ -348,8 +511,7 @@ void WaveformModel::addWaveformData(qint64 timestamp, const QVector<float>& data
  */
 bool WaveformModel::isActive() const
 {
-    QMutexLocker locker(&mutex_);
-    return active_;
+    return active_.load(std::memory_order_relaxed);
 }
 
 /**
@@ -361,12 +523,8 @@ bool WaveformModel::isActive() const
  */
 void WaveformModel::SetActive(bool active)
 {
-    {
-        QMutexLocker locker(&mutex_);
-        if (active_ == active) {
-            return;
-        }
-        active_ = active;
+    if (active_.exchange(active, std::memory_order_relaxed) == active) {
+        return;
     }
     
     emit activeStateChanged(active);
@@ -382,7 +540,18 @@ void WaveformModel::SetActive(bool active)
 QDateTime WaveformModel::GetLastUpdateTime() const
 {
     QMutexLocker locker(&mutex_);
-    return QDateTime::fromMSecsSinceEpoch(last_timestamp_);
+    return QDateTime::fromMSecsSinceEpoch(last_timestamp_.load(std::memory_order_relaxed));
+}
+
+/**
+ * @brief Gets when samples were last written, on the monotonic metrics clock
+ * @return Metrics::Now() at the end of the last write, 0 before the first
+ * 
+ * Read without taking mutex_, so views can call it on every frame.
+ */
+qint64 WaveformModel::GetLastWriteTime() const
+{
+    return last_write_time_.load(std::memory_order_relaxed);
 }
 
 /**
@@ -390,12 +559,12 @@ QDateTime WaveformModel::GetLastUpdateTime() const
  * @return True if using demo data, false otherwise
  * 
  * Returns whether this waveform is using simulated demo data
- * rather than real patient data.
+ * rather than real patient data. The data manager sets the flag while the
+ * demo provider is active; models start out showing their samples.
  */
 bool WaveformModel::GetIsDemo() const
 {
-    QMutexLocker locker(&mutex_);
-    return is_demo_;
+    return is_demo_.load(std::memory_order_relaxed);
 }
 
 /**
@@ -408,10 +577,7 @@ bool WaveformModel::GetIsDemo() const
  */
 void WaveformModel::SetIsDemo(bool isDemo)
 {
-    QMutexLocker locker(&mutex_);
-    
-    if (is_demo_ != isDemo) {
-        is_demo_ = isDemo;
+    if (is_demo_.exchange(isDemo, std::memory_order_relaxed) != isDemo) {
         emit propertiesChanged();
     }
 } 
\ No newline at end of file
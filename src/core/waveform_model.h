@@ -13,12 +13,15 @@
 
 #include "../../include/i_waveform_model.h"
 #include "../../include/vital_sync_types.h"
+#include "decimation_pyramid.h"
+#include "sample_ring_buffer.h"
 #include <QObject>
 #include <QVector>
 #include <QColor>
 #include <QDateTime>
 #include <QMutex>
 #include <QString>
+#include <atomic>
 
 /**
  * @brief Model for waveform data
@@ -93,10 +96,11 @@ public:
     void SetScalingRange(float min, float max) override;
     
     /**
-     * @brief Get the stored waveform data
-     * @return Vector of waveform data points
+     * @brief Take a copy-free snapshot of the stored waveform data
+     * @param fromSequence First sample sequence number of interest
+     * @return Read view over the retained samples
      */
-    const QVector<float>& GetData() const override;
+    WaveformSnapshot GetSnapshot(quint64 fromSequence = 0) const override;
     
     /**
      * @brief Get the maximum buffer size
@@ -116,12 +120,69 @@ public:
      * @param data Vector of new data points
      */
     void addWaveformData(qint64 timestamp, const QVector<float>& data) override;
-    
+
+    /**
+     * @brief Add new waveform data to the buffer from raw memory
+     * @param timestamp Timestamp of the data
+     * @param data Pointer to the new data points
+     * @param count Number of data points
+     */
+    void addWaveformData(qint64 timestamp, const float* data, int count) override;
+
+    /**
+     * @brief Get the current write sequence number
+     * @return Sequence number one past the newest sample
+     */
+    quint64 GetWriteSequence() const override;
+
+    /**
+     * @brief Read the samples added after a given sequence number
+     * @param sequence First sequence number of interest
+     * @param out Receives the samples, oldest first
+     * @return Sequence number of the first sample in out
+     */
+    quint64 ReadSamplesSince(quint64 sequence, QVector<float>& out) const override;
+
+    /**
+     * @brief Get the min/max envelope of a time range
+     * @param fromTimestamp Start of the range in milliseconds since epoch
+     * @param toTimestamp End of the range in milliseconds since epoch
+     * @param columns Number of columns to divide the range into
+     * @param out Receives one envelope column per column
+     * @return Number of columns that hold data
+     */
+    int GetEnvelope(qint64 fromTimestamp, qint64 toTimestamp, int columns, QVector<EnvelopeColumn>& out) const override;
+
+    /**
+     * @brief Get the sample rate of the incoming data
+     * @return Samples per second, nominal if the source reports it, measured otherwise
+     */
+    double GetSampleRate() const override;
+
+    /**
+     * @brief Use the sample rate the source reports instead of measuring it
+     * @param sampleRate Samples per second, ignored unless positive
+     */
+    void SetNominalSampleRate(double sampleRate);
+
+    /**
+     * @brief Forget the timestamps and the sample rate of the previous source
+     *
+     * Must not run concurrently with addWaveformData().
+     */
+    void ResetTiming();
+
     /**
      * @brief Get the timestamp of the last update
      * @return Timestamp as QDateTime
      */
     QDateTime GetLastUpdateTime() const override;
+
+    /**
+     * @brief Get when samples were last written, on the monotonic metrics clock
+     * @return Metrics::Now() at the end of the last write, 0 before the first
+     */
+    qint64 GetLastWriteTime() const override;
     
     /**
      * @brief Check if this waveform is active
@@ -154,12 +215,19 @@ private:
     float min_value_;                        ///< Minimum expected value
     float max_value_;                        ///< Maximum expected value
     int max_buffer_size_;                     ///< Maximum buffer size
-    bool active_;                           ///< Active state
-    bool is_demo_;                           ///< Whether using demo data
+    std::atomic<bool> active_;               ///< Active state, read by the ingest path without mutex_
+    std::atomic<bool> is_demo_;              ///< Whether views draw the demo trace, read by views every frame without mutex_
     qint64 last_update_timestamp_;            ///< Last update timestamp
-    QVector<float> data_;                   ///< Waveform data buffer
+    SampleRingBuffer ring_;                  ///< Lock-free sample storage
+    DecimationPyramid pyramid_;              ///< Min/max summaries of the history, guarded by pyramid_mutex_
     mutable QMutex mutex_;                  ///< Mutex for thread safety
-    qint64 last_timestamp_;                  ///< Last timestamp
+    mutable QMutex pyramid_mutex_;          ///< Guards pyramid_ for envelope readers, taken inside mutex_ by the producer
+    std::atomic<qint64> last_timestamp_;     ///< Last timestamp
+    std::atomic<qint64> last_write_time_;    ///< Metrics::Now() of the last write
+    std::atomic<double> sample_rate_;        ///< Smoothed sample rate estimate in samples per second
+    std::atomic<double> nominal_sample_rate_; ///< Sample rate reported by the source, 0 to measure it
+    int last_chunk_count_;                   ///< Number of samples in the previous chunk
+    bool sample_rate_measured_;              ///< Whether sample_rate_ holds a measurement
 };
 
 #endif // WAVEFORM_MODEL_H 
\ No newline at end of file
@@ -0,0 +1,67 @@
+/**
+ * @file waveform_processor.h
+ * @brief Definition of the WaveformProcessor interface
+ *
+ * This file contains the definition of the WaveformProcessor interface for
+ * streaming signal processing stages that derive parameter values, such as
+ * heart rate or blood pressures, from the samples of one waveform as they are
+ * ingested.
+ */
+#ifndef WAVEFORM_PROCESSOR_H
+#define WAVEFORM_PROCESSOR_H
+
+#include "../../include/data_frame.h"
+#include <QVarLengthArray>
+
+/**
+ * @brief Streaming stage deriving parameters from one waveform
+ *
+ * The DataManager hands every chunk of a waveform to the processors
+ * registered for it, on the acquisition thread, right after the chunk has
+ * reached the waveform model. Processors keep fixed-size state, do a constant
+ * amount of work per sample, and report derived values through the output
+ * list; the manager feeds them to the parameter models and the alarm
+ * evaluation like values sent by the provider.
+ *
+ * A parameter measured by the provider is preferred over a derived one, and
+ * a derived source with a lower priority number over one with a higher
+ * number, as long as the preferred source keeps producing values.
+ */
+class WaveformProcessor {
+public:
+    /// Values derived from one chunk
+    using Output = QVarLengthArray<VitalSync::FrameParameter, 4>;
+
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~WaveformProcessor() = default;
+
+    /**
+     * @brief Get the waveform this processor analyzes
+     * @return VitalSync::WaveformType of the input
+     */
+    virtual int GetWaveformId() const = 0;
+
+    /**
+     * @brief Get the precedence of the derived values
+     * @return Priority, 1 for the most trusted derived source; the provider has 0
+     */
+    virtual int GetPriority() const = 0;
+
+    /**
+     * @brief Process one chunk of samples
+     * @param samples Pointer to the samples
+     * @param count Number of samples
+     * @param sampleRate Measured sample rate in samples per second
+     * @param out Receives the derived values, appended
+     */
+    virtual void Process(const float* samples, int count, double sampleRate, Output& out) = 0;
+
+    /**
+     * @brief Forget all signal history, for example after a change of source
+     */
+    virtual void Reset() = 0;
+};
+
+#endif // WAVEFORM_PROCESSOR_H
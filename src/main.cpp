@@ -17,15 +17,21 @@
 
 #include <QApplication>
 #include <QSettings>
+#include <QTimer>
 
 #include "../include/config_manager.h"
 #include "ui/main_window.h"
+#include "utils/startup_profile.h"
 
 
 int main(int argc, char *argv[])
 {
+    // Time the launch up to the first pass of the event loop
+    StartupProfile::Start();
+    
     // Create the application
     QApplication app(argc, argv);
+    StartupProfile::Mark("Qt application");
     
     // Set application information
     QApplication::setApplicationName("VitalSync");
@@ -38,10 +44,18 @@ int main(int argc, char *argv[])
         // Show error message?
         return 1;
     }
+    StartupProfile::Mark("Configuration");
     
     // Create and show the main window
     MainWindow main_window;
     main_window.show();
+    StartupProfile::Mark("Window shown");
+    
+    // Report once the first events, including the first paint, are processed
+    QTimer::singleShot(0, []() {
+        StartupProfile::Mark("First event loop pass");
+        StartupProfile::Report();
+    });
     
     // Run the application
     return app.exec();
@@ -10,9 +10,11 @@
  */
 #include "demo_data_provider.h"
 #include "../../include/config_manager.h"
+#include "../utils/log_categories.h"
 #include <QDateTime>
 #include <QDebug>
 #include <QtMath>
+#include <algorithm>
 #include <cmath>
 
 /**
@@ -65,6 +67,12 @@ namespace {
     // Default waveform update interval in milliseconds
     const int DEFAULT_WAVEFORM_UPDATE_MS = 40;      ///< Default waveform update interval (40ms = 25Hz)
     
+    // Load generator mode
+    const int DEFAULT_LOAD_SAMPLE_RATE = 500;       ///< Default samples per second per channel
+    const int DEFAULT_LOAD_BEDS = 16;               ///< Default number of simulated beds
+    const int MAX_LOAD_BEDS = 64;                   ///< Largest number of simulated beds, as on the central station
+    const int MAX_LOAD_BACKLOG_MS = 100;            ///< Longest backlog caught up after a stall; older samples are skipped
+    
     /**
      * @brief Generate a random double value within a bounded range
      * @param generator Reference to the random number generator
@@ -100,6 +108,8 @@ DemoDataProvider::DemoDataProvider(QObject* parent)
     : IDataProvider(parent)
     , active_(false)
     , status_(VitalSync::ConnectionStatus::Disconnected)
+    , waveform_timer_(this)   // Parented so the timers follow moveToThread()
+    , parameter_timer_(this)
     , heart_rate_(70)
     , respiration_rate_(15)
     , spo2_(98)
@@ -121,6 +131,12 @@ DemoDataProvider::DemoDataProvider(QObject* parent)
     , frequency_(1.0)
     , noise_(0.02)  // Reduced noise for cleaner waveforms
     , artifacts_(false)
+    , load_mode_(false)
+    , load_sample_rate_(DEFAULT_LOAD_SAMPLE_RATE)
+    , load_channels_(VitalSync::WAVEFORM_TYPE_COUNT)
+    , load_beds_(DEFAULT_LOAD_BEDS)
+    , load_max_rate_(false)
+    , load_start_ms_(0)
 {
     random_.seed(QDateTime::currentMSecsSinceEpoch());
     
@@ -223,9 +239,33 @@ bool DemoDataProvider::configure(const QVariantMap& params)
     if (params.contains("artifacts"))
         artifacts_ = params["artifacts"].toBool();
     
+    // Load generator mode
+    if (params.contains("loadMode"))
+        load_mode_ = params["loadMode"].toBool();
+        
+    if (params.contains("loadSampleRate"))
+        load_sample_rate_ = qBound(SyntheticLoadGenerator::MIN_SAMPLE_RATE, params["loadSampleRate"].toInt(),
+                                   SyntheticLoadGenerator::MAX_SAMPLE_RATE);
+        
+    if (params.contains("loadChannels"))
+        load_channels_ = qBound(1, params["loadChannels"].toInt(), VitalSync::WAVEFORM_TYPE_COUNT);
+        
+    if (params.contains("loadBeds"))
+        load_beds_ = qBound(1, params["loadBeds"].toInt(), MAX_LOAD_BEDS);
+        
+    if (params.contains("loadMaxRate"))
+        load_max_rate_ = params["loadMaxRate"].toBool();
+    
+    // The templates depend on the vital signs, so they are rebuilt on every change
+    if (load_mode_) {
+        createLoadGenerator();
+    } else {
+        load_generator_.reset();
+    }
+    
     // Update timers if running
     if (waveform_timer_.isActive()) {
-        waveform_timer_.setInterval(waveform_update_interval_ms_);
+        waveform_timer_.setInterval(waveformTimerInterval());
     }
     
     // Save configuration
@@ -247,6 +287,11 @@ bool DemoDataProvider::configure(const QVariantMap& params)
     config["frequency"] = frequency_;
     config["noise"] = noise_;
     config["artifacts"] = artifacts_;
+    config["loadMode"] = load_mode_;
+    config["loadSampleRate"] = load_sample_rate_;
+    config["loadChannels"] = load_channels_;
+    config["loadBeds"] = load_beds_;
+    config["loadMaxRate"] = load_max_rate_;
     
     ConfigManager::GetInstance().SetProviderConfig("Demo", config);
     
@@ -264,25 +309,25 @@ void DemoDataProvider::initialize()
 {
     // Map waveform types to generator functions
     waveform_generators_[static_cast<int>(VitalSync::WaveformType::ECG_I)] =
-        [this](double time, int points) { return generateECG(time, points); };
+        [this](double time, int points, float* out) { generateECG(time, points, out); };
     
     waveform_generators_[static_cast<int>(VitalSync::WaveformType::ECG_II)] =
-        [this](double time, int points) { return generateECG(time, points); };
+        [this](double time, int points, float* out) { generateECG(time, points, out); };
     
     waveform_generators_[static_cast<int>(VitalSync::WaveformType::ECG_III)] =
-        [this](double time, int points) { return generateECG(time, points); };
+        [this](double time, int points, float* out) { generateECG(time, points, out); };
     
     waveform_generators_[static_cast<int>(VitalSync::WaveformType::RESP)] =
-        [this](double time, int points) { return generateRespiration(time, points); };
+        [this](double time, int points, float* out) { generateRespiration(time, points, out); };
     
     waveform_generators_[static_cast<int>(VitalSync::WaveformType::PLETH)] =
-        [this](double time, int points) { return generatePlethysmograph(time, points); };
+        [this](double time, int points, float* out) { generatePlethysmograph(time, points, out); };
     
     waveform_generators_[static_cast<int>(VitalSync::WaveformType::ABP)] =
-        [this](double time, int points) { return generateArterialPressure(time, points); };
+        [this](double time, int points, float* out) { generateArterialPressure(time, points, out); };
     
     waveform_generators_[static_cast<int>(VitalSync::WaveformType::CAPNO)] =
-        [this](double time, int points) { return generateCapnograph(time, points); };
+        [this](double time, int points, float* out) { generateCapnograph(time, points, out); };
 }
 
 /**
@@ -314,6 +359,11 @@ bool DemoDataProvider::start()
     QTimer::singleShot(500, this, [this]() {
         qDebug() << "DemoDataProvider: Connection delay completed, starting data generation";
         
+        {
+            QMutexLocker innerLocker(&mutex_);
+            waveform_timer_.setInterval(waveformTimerInterval());
+        }
+        
         // Start timers - do not hold mutex while starting timers to avoid potential deadlock
         elapsed_timer_.start();
         waveform_timer_.start();
@@ -323,6 +373,12 @@ bool DemoDataProvider::start()
             QMutexLocker innerLocker(&mutex_);
             active_ = true;
             status_ = VitalSync::ConnectionStatus::Connected;
+            
+            // The load generator's sample clock starts with the timers
+            if (load_generator_) {
+                load_generator_->Reset(QDateTime::currentMSecsSinceEpoch());
+                load_start_ms_ = 0;
+            }
         } // Release mutex before emitting signals
         
         qDebug() << "DemoDataProvider: Status changed to Connected";
@@ -416,11 +472,24 @@ bool DemoDataProvider::isActive() const
     return active_;
 }
 
+/**
+ * @brief Checks if the provider only simulates a patient
+ * @return True unless the load generator produces a sampled stream
+ * 
+ * The load generator stamps every frame from its sample count, so its
+ * samples are rendered like those of any other stream.
+ */
+bool DemoDataProvider::IsDemo() const
+{
+    QMutexLocker locker(&mutex_);
+    return !load_mode_;
+}
+
 /**
  * @brief Generates and emits simulated waveform data
  * 
  * This function generates simulated waveform data for all configured waveform types
- * and emits the data to connected slots. It uses the current elapsed time to 
+ * and emits them together as one batched DataFrame. It uses the current elapsed time to 
  * determine the phase in each waveform and creates a specified number of data points
  * for each update cycle.
  */
@@ -432,6 +501,11 @@ void DemoDataProvider::generateWaveformData()
         return;
     }
     
+    if (load_generator_) {
+        generateLoadData();
+        return;
+    }
+    
     // Calculate elapsed time in seconds
     double elapsedTimeSeconds = elapsed_timer_.elapsed() / 1000.0;
     
@@ -441,26 +515,109 @@ void DemoDataProvider::generateWaveformData()
     // Get current timestamp
     qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
     
-    // Generate and emit data for each waveform type
+    // Collect all waveform channels of this tick into one frame, generated
+    // straight into the frame's pooled sample block
+    frame_.clear();
+    frame_.timestamp = timestamp;
+    frame_.channels.reserve(static_cast<int>(waveform_generators_.size()));
+    frame_.samples.reserve(static_cast<int>(waveform_generators_.size()) * pointsPerUpdate);
+    
     for (auto it = waveform_generators_.begin(); it != waveform_generators_.end(); ++it) {
         int waveformId = it->first;
-        auto generatorFunc = it->second;
         
         // Generate waveform data
-        QVector<float> data = generatorFunc(elapsedTimeSeconds, pointsPerUpdate);
-        
-        // Active debug output to see what's being generated
-        qDebug() << "DemoDataProvider: Generated waveform" << waveformId
-                 << "Points:" << data.size() 
-                 << "First 3 values:" << (data.size() > 0 ? data[0] : 0.0)
-                 << (data.size() > 1 ? data[1] : 0.0)
-                 << (data.size() > 2 ? data[2] : 0.0);
-            
-        // Emit waveform data
-        emit waveformDataReceived(waveformId, timestamp, data);
+        float* data = frame_.AppendChannel(waveformId, pointsPerUpdate);
+        it->second(elapsedTimeSeconds, pointsPerUpdate, data);
+        
+        VITALSYNC_TRACE(lcProvider) << "DemoDataProvider: Generated waveform" << waveformId
+                                    << "Points:" << pointsPerUpdate
+                                    << "First 3 values:" << (pointsPerUpdate > 0 ? data[0] : 0.0)
+                                    << (pointsPerUpdate > 1 ? data[1] : 0.0)
+                                    << (pointsPerUpdate > 2 ? data[2] : 0.0);
+    }
+    
+    // Emit all channels at once
+    emit dataFrameReceived(frame_);
+}
+
+/**
+ * @brief Generates and emits the frames of the load generator that are due
+ * 
+ * Paced, it generates the samples the wall clock says are due since the
+ * generator was reset, so the long-term rate is exact whatever the timer
+ * jitter; a backlog longer than MAX_LOAD_BACKLOG_MS is skipped rather than
+ * replayed all at once. At maximum rate every call generates one update
+ * interval worth of samples and the sample clock runs ahead of the wall
+ * clock as fast as the pipeline takes the frames. Frames are split so that
+ * each fits into one pooled sample block.
+ * 
+ * The mutex must be held.
+ */
+void DemoDataProvider::generateLoadData()
+{
+    const int sampleRate = load_generator_->GetSampleRate();
+    qint64 samples = 0;
+    if (load_max_rate_) {
+        samples = std::max<qint64>(1, static_cast<qint64>(sampleRate) * waveform_update_interval_ms_ / 1000);
+    } else {
+        samples = load_generator_->GetDueSamples(elapsed_timer_.elapsed() - load_start_ms_);
+        const qint64 maxBacklog = static_cast<qint64>(sampleRate) * MAX_LOAD_BACKLOG_MS / 1000;
+        if (samples > maxBacklog) {
+            VITALSYNC_TRACE(lcProvider) << "DemoDataProvider: Skipping" << samples - maxBacklog
+                                        << "samples of load generator backlog";
+            load_generator_->Skip(samples - maxBacklog);
+            samples = maxBacklog;
+        }
+    }
+    
+    const int maxChunk = std::max(1, VitalSync::SampleBlockPool::BLOCK_CAPACITY / load_generator_->GetChannelCount());
+    while (samples > 0) {
+        const int chunk = static_cast<int>(std::min<qint64>(samples, maxChunk));
+        load_generator_->FillFrame(frame_, chunk);
+        emit dataFrameReceived(frame_);
+        samples -= chunk;
+    }
+}
+
+/**
+ * @brief Builds the load generator from the current settings
+ * 
+ * Takes the vital signs of the demo provider for the templates. A generator
+ * rebuilt while running continues from the current time.
+ * 
+ * The mutex must be held.
+ */
+void DemoDataProvider::createLoadGenerator()
+{
+    SyntheticLoadGenerator::Settings settings;
+    settings.sampleRate = load_sample_rate_;
+    settings.channels = load_channels_;
+    settings.heartRate = heart_rate_;
+    settings.respirationRate = respiration_rate_;
+    settings.systolic = ibp1_systolic_;
+    settings.diastolic = ibp1_diastolic_;
+    settings.cvpSystolic = ibp2_systolic_;
+    settings.cvpDiastolic = ibp2_diastolic_;
+    settings.etco2 = etco2_;
+    settings.spo2 = spo2_;
+    settings.amplitude = amplitude_;
+    load_generator_ = std::make_unique<SyntheticLoadGenerator>(settings);
+    
+    if (active_) {
+        load_generator_->Reset(QDateTime::currentMSecsSinceEpoch());
+        load_start_ms_ = elapsed_timer_.elapsed();
     }
 }
 
+/**
+ * @brief Gets the interval of the waveform timer for the current mode
+ * @return Interval in milliseconds, 0 for maximum rate load generation
+ */
+int DemoDataProvider::waveformTimerInterval() const
+{
+    return load_mode_ && load_max_rate_ ? 0 : waveform_update_interval_ms_;
+}
+
 /**
  * @brief Occasionally generates parameter values outside normal range
  * @param baseValue Base parameter value
@@ -714,37 +871,42 @@ void DemoDataProvider::generateParameterData()
         qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
         
         // Debug output with improved formatting
-        qDebug() << "=== DemoDataProvider: Generated parameters at" << QDateTime::fromMSecsSinceEpoch(timestamp).toString("hh:mm:ss.zzz") << "===";
-        qDebug() << "  HR:" << heartRate << "bpm (base:" << heart_rate << ")";
-        qDebug() << "  RR:" << respirationRate << "br/min (base:" << respiration_rate << ")";
-        qDebug() << "  SpO2:" << spo2 << "% (base:" << spo2_value << ")";
-        qDebug() << "  NIBP:" << systolicBP << "/" << diastolicBP << "(" << meanBP << ") mmHg (base:" << systolic_bp << "/" << diastolic_bp << ")";
-        qDebug() << "  IBP1:" << ibp1Systolic << "/" << ibp1Diastolic << "(" << ibp1Mean << ") mmHg";
-        qDebug() << "  IBP2:" << ibp2Systolic << "/" << ibp2Diastolic << "(" << ibp2Mean << ") mmHg (base:" << ibp2_sys << "/" << ibp2_dia << ")";
-        qDebug() << "  TEMP:" << temperature << "°C TEMP2:" << temperature2 << "°C (base:" << temperature_value << "/" << temperature2_value << ")";
-        qDebug() << "  ETCO2:" << etco2 << "mmHg (base:" << etco2_value << ")";
-        qDebug() << "==============================================";
-        
-        // Emit parameter data
-        emit parameterDataReceived(static_cast<int>(VitalSync::ParameterType::HR), timestamp, heartRate);
-        emit parameterDataReceived(static_cast<int>(VitalSync::ParameterType::RR), timestamp, respirationRate);
-        emit parameterDataReceived(static_cast<int>(VitalSync::ParameterType::SPO2), timestamp, spo2);
-        emit parameterDataReceived(static_cast<int>(VitalSync::ParameterType::NIBP_SYS), timestamp, systolicBP);
-        emit parameterDataReceived(static_cast<int>(VitalSync::ParameterType::NIBP_DIA), timestamp, diastolicBP);
-        emit parameterDataReceived(static_cast<int>(VitalSync::ParameterType::NIBP_MAP), timestamp, meanBP);
-        emit parameterDataReceived(static_cast<int>(VitalSync::ParameterType::ETCO2), timestamp, etco2);
-        emit parameterDataReceived(static_cast<int>(VitalSync::ParameterType::TEMP1), timestamp, temperature);
-        emit parameterDataReceived(static_cast<int>(VitalSync::ParameterType::TEMP2), timestamp, temperature2);
-        
-        // Emit IBP1 (Arterial) parameters
-        emit parameterDataReceived(static_cast<int>(VitalSync::ParameterType::IBP1_SYS), timestamp, ibp1Systolic);
-        emit parameterDataReceived(static_cast<int>(VitalSync::ParameterType::IBP1_DIA), timestamp, ibp1Diastolic);
-        emit parameterDataReceived(static_cast<int>(VitalSync::ParameterType::IBP1_MAP), timestamp, ibp1Mean);
-        
-        // Emit IBP2 (CVP) parameters
-        emit parameterDataReceived(static_cast<int>(VitalSync::ParameterType::IBP2_SYS), timestamp, ibp2Systolic);
-        emit parameterDataReceived(static_cast<int>(VitalSync::ParameterType::IBP2_DIA), timestamp, ibp2Diastolic);
-        emit parameterDataReceived(static_cast<int>(VitalSync::ParameterType::IBP2_MAP), timestamp, ibp2Mean);
+        VITALSYNC_TRACE(lcProvider) << "=== DemoDataProvider: Generated parameters at" << QDateTime::fromMSecsSinceEpoch(timestamp).toString("hh:mm:ss.zzz") << "===";
+        VITALSYNC_TRACE(lcProvider) << "  HR:" << heartRate << "bpm (base:" << heart_rate << ")";
+        VITALSYNC_TRACE(lcProvider) << "  RR:" << respirationRate << "br/min (base:" << respiration_rate << ")";
+        VITALSYNC_TRACE(lcProvider) << "  SpO2:" << spo2 << "% (base:" << spo2_value << ")";
+        VITALSYNC_TRACE(lcProvider) << "  NIBP:" << systolicBP << "/" << diastolicBP << "(" << meanBP << ") mmHg (base:" << systolic_bp << "/" << diastolic_bp << ")";
+        VITALSYNC_TRACE(lcProvider) << "  IBP1:" << ibp1Systolic << "/" << ibp1Diastolic << "(" << ibp1Mean << ") mmHg";
+        VITALSYNC_TRACE(lcProvider) << "  IBP2:" << ibp2Systolic << "/" << ibp2Diastolic << "(" << ibp2Mean << ") mmHg (base:" << ibp2_sys << "/" << ibp2_dia << ")";
+        VITALSYNC_TRACE(lcProvider) << "  TEMP:" << temperature << "°C TEMP2:" << temperature2 << "°C (base:" << temperature_value << "/" << temperature2_value << ")";
+        VITALSYNC_TRACE(lcProvider) << "  ETCO2:" << etco2 << "mmHg (base:" << etco2_value << ")";
+        VITALSYNC_TRACE(lcProvider) << "==============================================";
+        
+        // Emit all parameter values in a single frame
+        VitalSync::DataFrame frame;
+        frame.timestamp = timestamp;
+        frame.parameters.reserve(15);
+        frame.AppendParameter(static_cast<int>(VitalSync::ParameterType::HR), heartRate);
+        frame.AppendParameter(static_cast<int>(VitalSync::ParameterType::RR), respirationRate);
+        frame.AppendParameter(static_cast<int>(VitalSync::ParameterType::SPO2), spo2);
+        frame.AppendParameter(static_cast<int>(VitalSync::ParameterType::NIBP_SYS), systolicBP);
+        frame.AppendParameter(static_cast<int>(VitalSync::ParameterType::NIBP_DIA), diastolicBP);
+        frame.AppendParameter(static_cast<int>(VitalSync::ParameterType::NIBP_MAP), meanBP);
+        frame.AppendParameter(static_cast<int>(VitalSync::ParameterType::ETCO2), etco2);
+        frame.AppendParameter(static_cast<int>(VitalSync::ParameterType::TEMP1), temperature);
+        frame.AppendParameter(static_cast<int>(VitalSync::ParameterType::TEMP2), temperature2);
+        
+        // IBP1 (Arterial) parameters
+        frame.AppendParameter(static_cast<int>(VitalSync::ParameterType::IBP1_SYS), ibp1Systolic);
+        frame.AppendParameter(static_cast<int>(VitalSync::ParameterType::IBP1_DIA), ibp1Diastolic);
+        frame.AppendParameter(static_cast<int>(VitalSync::ParameterType::IBP1_MAP), ibp1Mean);
+        
+        // IBP2 (CVP) parameters
+        frame.AppendParameter(static_cast<int>(VitalSync::ParameterType::IBP2_SYS), ibp2Systolic);
+        frame.AppendParameter(static_cast<int>(VitalSync::ParameterType::IBP2_DIA), ibp2Diastolic);
+        frame.AppendParameter(static_cast<int>(VitalSync::ParameterType::IBP2_MAP), ibp2Mean);
+        
+        emit dataFrameReceived(frame);
     } catch (const std::exception& e) {
         qCritical() << "Exception in generateParameterData:" << e.what();
     } catch (...) {
@@ -756,16 +918,13 @@ void DemoDataProvider::generateParameterData()
  * @brief Generates ECG waveform data
  * @param time Current time in seconds
  * @param points Number of points to generate
- * @return Vector of generated ECG data points
+ * @param out Receives the points
  * 
  * Creates a realistic ECG waveform with P, Q, R, S, and T waves.
  * The waveform's timing is based on the current heart rate.
  */
-QVector<float> DemoDataProvider::generateECG(double time, int points)
+void DemoDataProvider::generateECG(double time, int points, float* out)
 {
-    QVector<float> result;
-    result.reserve(points);
-    
     // Calculate time step based on heart rate (in seconds)
     double cycleTime = 60.0 / heart_rate_;
     double timeStep = 1.0 / (1000.0 / waveform_update_interval_ms_);
@@ -830,27 +989,22 @@ QVector<float> DemoDataProvider::generateECG(double time, int points)
         // Multiply by amplitude factor for better visibility
         value *= amplitudeMultiplier * amplitude_;
         
-        result.append(value);
+        out[i] = static_cast<float>(value);
     }
-    
-    return result;
 }
 
 /**
  * @brief Generates respiration waveform data
  * @param time Current time in seconds
  * @param points Number of points to generate
- * @return Vector of generated respiration data points
+ * @param out Receives the points
  * 
  * Creates a realistic respiration waveform using sinusoidal
  * patterns that simulate inhalation and exhalation phases.
  * The waveform's frequency is based on the current respiration rate.
  */
-QVector<float> DemoDataProvider::generateRespiration(double time, int points)
+void DemoDataProvider::generateRespiration(double time, int points, float* out)
 {
-    QVector<float> result;
-    result.reserve(points);
-    
     // Calculate time step based on respiration rate (in seconds)
     double cycleTime = 60.0 / respiration_rate_;
     double timeStep = 1.0 / (1000.0 / waveform_update_interval_ms_);
@@ -880,27 +1034,22 @@ QVector<float> DemoDataProvider::generateRespiration(double time, int points)
         // Scale by amplitude
         value *= amplitude_ * 0.5; // Make respiration smaller than ECG by default
         
-        result.append(value);
+        out[i] = static_cast<float>(value);
     }
-    
-    return result;
 }
 
 /**
  * @brief Generates plethysmograph (SpO2) waveform data
  * @param time Current time in seconds
  * @param points Number of points to generate
- * @return Vector of generated plethysmograph data points
+ * @param out Receives the points
  * 
  * Creates a realistic plethysmograph waveform simulating the
  * pulsatile blood flow detected by an SpO2 sensor, including
  * the characteristic systolic peak and dicrotic notch.
  */
-QVector<float> DemoDataProvider::generatePlethysmograph(double time, int points)
+void DemoDataProvider::generatePlethysmograph(double time, int points, float* out)
 {
-    QVector<float> result;
-    result.reserve(points);
-    
     // Calculate time step based on heart rate
     double cycleTime = 60.0 / heart_rate_;
     double timeStep = 1.0 / (1000.0 / waveform_update_interval_ms_);
@@ -965,27 +1114,22 @@ QVector<float> DemoDataProvider::generatePlethysmograph(double time, int points)
         // Apply final amplitude scaling
         value *= amplitudeMultiplier;
         
-        result.append(value);
+        out[i] = static_cast<float>(value);
     }
-    
-    return result;
 }
 
 /**
  * @brief Generates arterial blood pressure waveform data
  * @param time Current time in seconds
  * @param points Number of points to generate
- * @return Vector of generated arterial pressure data points
+ * @param out Receives the points
  * 
  * Creates a realistic arterial blood pressure waveform with
  * appropriate systolic peak, dicrotic notch, and diastolic
  * decay based on current blood pressure values.
  */
-QVector<float> DemoDataProvider::generateArterialPressure(double time, int points)
+void DemoDataProvider::generateArterialPressure(double time, int points, float* out)
 {
-    QVector<float> result;
-    result.reserve(points);
-    
     // Calculate time step based on heart rate
     double cycleTime = 60.0 / heart_rate_;
     double timeStep = 1.0 / (1000.0 / waveform_update_interval_ms_);
@@ -1089,27 +1233,22 @@ QVector<float> DemoDataProvider::generateArterialPressure(double time, int point
         // Apply overall amplitude scaling
         value *= amplitudeMultiplier * amplitude_ / 100.0;
         
-        result.append(value);
+        out[i] = static_cast<float>(value);
     }
-    
-    return result;
 }
 
 /**
  * @brief Generates capnograph (CO2) waveform data
  * @param time Current time in seconds
  * @param points Number of points to generate
- * @return Vector of generated capnograph data points
+ * @param out Receives the points
  * 
  * Creates a realistic capnograph waveform showing the 
  * characteristic CO2 levels during the respiratory cycle,
  * with baseline, rapid rise, plateau, and rapid fall.
  */
-QVector<float> DemoDataProvider::generateCapnograph(double time, int points)
+void DemoDataProvider::generateCapnograph(double time, int points, float* out)
 {
-    QVector<float> result;
-    result.reserve(points);
-    
     // Calculate time step based on respiration rate (in seconds)
     double cycleTime = 60.0 / respiration_rate_;
     double timeStep = 1.0 / (1000.0 / waveform_update_interval_ms_);
@@ -1164,10 +1303,8 @@ QVector<float> DemoDataProvider::generateCapnograph(double time, int points)
         // Amplify overall for better display
         value *= 1.5;
         
-        result.append(value);
+        out[i] = static_cast<float>(value);
     }
-    
-    return result;
 }
 
 /**
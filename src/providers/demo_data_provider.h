@@ -12,7 +12,9 @@
 #define DEMO_DATA_PROVIDER_H
 
 #include "../../include/i_data_provider.h"
+#include "../../include/data_frame.h"
 #include "../../include/vital_sync_types.h"
+#include "synthetic_load_generator.h"
 #include <QTimer>
 #include <QElapsedTimer>
 #include <QRandomGenerator>
@@ -20,6 +22,7 @@
 #include <QMutex>
 #include <unordered_map>
 #include <functional>
+#include <memory>
 #include <QMap>
 #include <QObject>
 #include <QString>
@@ -30,6 +33,13 @@
  *
  * This provider generates simulated waveform and parameter data
  * for testing and demonstration purposes.
+ *
+ * In load mode ("loadMode") the waveforms come from a SyntheticLoadGenerator
+ * instead, at "loadSampleRate" samples per second on each of "loadChannels"
+ * channels, with timestamps taken from the sample count. Paced, it keeps up
+ * with the wall clock; with "loadMaxRate" it emits a frame whenever the
+ * event loop is idle, to drive the pipeline as fast as it can take data.
+ * "loadBeds" is the number of central station beds to simulate.
  */
 class DemoDataProvider : public IDataProvider {
     Q_OBJECT
@@ -82,6 +92,12 @@ public:
      */
     bool configure(const QVariantMap& params) override;
 
+    /**
+     * @brief Check if the provider only simulates a patient
+     * @return True unless the load generator produces a sampled stream
+     */
+    bool IsDemo() const override;
+
 private slots:
     /**
      * @brief Generate and emit waveform data
@@ -103,41 +119,41 @@ private:
      * @brief Generate ECG waveform
      * @param time Current time in seconds
      * @param points Number of points to generate
-     * @return Vector of generated data points
+     * @param out Receives the points
      */
-    QVector<float> generateECG(double time, int points);
+    void generateECG(double time, int points, float* out);
 
     /**
      * @brief Generate respiration waveform
      * @param time Current time in seconds
      * @param points Number of points to generate
-     * @return Vector of generated data points
+     * @param out Receives the points
      */
-    QVector<float> generateRespiration(double time, int points);
+    void generateRespiration(double time, int points, float* out);
 
     /**
      * @brief Generate SPO2 plethysmograph waveform
      * @param time Current time in seconds
      * @param points Number of points to generate
-     * @return Vector of generated data points
+     * @param out Receives the points
      */
-    QVector<float> generatePlethysmograph(double time, int points);
+    void generatePlethysmograph(double time, int points, float* out);
 
     /**
      * @brief Generate arterial blood pressure waveform
      * @param time Current time in seconds
      * @param points Number of points to generate
-     * @return Vector of generated data points
+     * @param out Receives the points
      */
-    QVector<float> generateArterialPressure(double time, int points);
+    void generateArterialPressure(double time, int points, float* out);
 
     /**
      * @brief Generate CO2 capnograph waveform
      * @param time Current time in seconds
      * @param points Number of points to generate
-     * @return Vector of generated data points
+     * @param out Receives the points
      */
-    QVector<float> generateCapnograph(double time, int points);
+    void generateCapnograph(double time, int points, float* out);
 
     /**
      * @brief Add normal variation to a parameter
@@ -167,6 +183,26 @@ private:
      */
     double generateCriticalExtremeValue(double baseValue, double minValue, double maxValue, int cycleCount);
 
+    /**
+     * @brief Generate and emit the frames of the load generator that are due
+     *
+     * The mutex must be held.
+     */
+    void generateLoadData();
+
+    /**
+     * @brief Build the load generator from the current settings
+     *
+     * The mutex must be held.
+     */
+    void createLoadGenerator();
+
+    /**
+     * @brief Get the interval of the waveform timer for the current mode
+     * @return Interval in milliseconds, 0 for maximum rate load generation
+     */
+    int waveformTimerInterval() const;
+
 private:
     // Connection status
     VitalSync::ConnectionStatus status_;
@@ -219,7 +255,19 @@ private:
     mutable QMutex mutex_;
     
     // Map of waveform generator functions
-    std::unordered_map<int, std::function<QVector<float>(double, int)>> waveform_generators_;
+    std::unordered_map<int, std::function<void(double, int, float*)>> waveform_generators_;
+    
+    // Frame reused for every waveform tick, so its sample block is reused too
+    VitalSync::DataFrame frame_;
+    
+    // Load generator mode
+    bool load_mode_;                    // Whether waveforms come from the load generator
+    int load_sample_rate_;              // Samples per second per channel in load mode
+    int load_channels_;                 // Number of waveform channels in load mode
+    int load_beds_;                     // Number of central station beds to simulate in load mode
+    bool load_max_rate_;                // Whether load mode runs as fast as possible instead of in real time
+    qint64 load_start_ms_;              // Elapsed time at the last reset of the load generator
+    std::unique_ptr<SyntheticLoadGenerator> load_generator_;  // Template-replay generator of the load mode
 };
 
 #endif // DEMO_DATA_PROVIDER_H 
\ No newline at end of file
@@ -0,0 +1,459 @@
+/**
+ * @file file_data_provider.cpp
+ * @brief Implementation of the FileDataProvider class
+ *
+ * This file implements replay of memory-mapped recordings. Every tick emits the
+ * samples and parameter values recorded since the previous tick as one
+ * DataFrame, copied straight from the mapping into the frame and stamped
+ * with the time they were recorded.
+ */
+#include "file_data_provider.h"
+#include "../../include/config_manager.h"
+#include <QDateTime>
+#include <QFileInfo>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+/**
+ * @namespace Anonymous namespace for constants and helper functions
+ * @brief Contains replay settings used by the FileDataProvider implementation
+ */
+namespace {
+    const int REPLAY_INTERVAL_MS = 20;              ///< Tick interval of timed replay
+    const int MAX_SPEED_CHUNKS_PER_TICK = 4;        ///< Chunks emitted per tick at maximum speed
+    const qint64 MAX_REPLAY_GAP_MS = 2000;          ///< Longer gaps in the recording are skipped
+    const double MIN_PLAYBACK_SPEED = 0.1;          ///< Slowest replay
+    const double MAX_PLAYBACK_SPEED = 100.0;        ///< Fastest timed replay
+    const qint64 END_OF_TIME = std::numeric_limits<qint64>::max();  ///< Replay everything
+
+    /**
+     * @brief Get the sample rate of a channel
+     * @param channel Channel of a chunk
+     * @param chunkEnd End time of the chunk
+     * @return Recorded sample rate, or the rate that spreads the samples evenly
+     *         up to the chunk end if it was unknown; 0 if neither is known
+     */
+    double channelRate(const RecordingReader::ChannelView& channel, qint64 chunkEnd)
+    {
+        if (channel.sampleRate > 0.0f) {
+            return channel.sampleRate;
+        }
+        if (chunkEnd > channel.firstTimestamp && channel.sampleCount > 1) {
+            return (channel.sampleCount - 1) * 1000.0 / static_cast<double>(chunkEnd - channel.firstTimestamp);
+        }
+        return 0.0;
+    }
+
+    /**
+     * @brief Get the recorded time of a sample of a channel
+     * @param channel Channel of a chunk
+     * @param chunkEnd End time of the chunk
+     * @param index Index of the sample in the channel
+     * @return Time in milliseconds since the epoch
+     */
+    qint64 sampleTimestamp(const RecordingReader::ChannelView& channel, qint64 chunkEnd, int index)
+    {
+        const double rate = channelRate(channel, chunkEnd);
+        return rate > 0.0 ? channel.firstTimestamp + static_cast<qint64>(std::floor(index * 1000.0 / rate))
+                          : channel.firstTimestamp;
+    }
+
+    /**
+     * @brief Get the number of samples of a channel recorded before a time
+     * @param channel Channel of a chunk
+     * @param chunkEnd End time of the chunk
+     * @param timestamp Recorded time in milliseconds since the epoch
+     * @return Number of samples, between 0 and the channel's sample count
+     *
+     * Samples are spaced by the recorded sample rate, or spread evenly up to
+     * the chunk end if the rate was unknown.
+     */
+    int samplesBefore(const RecordingReader::ChannelView& channel, qint64 chunkEnd, qint64 timestamp)
+    {
+        if (timestamp == END_OF_TIME) {
+            return channel.sampleCount;
+        }
+
+        const double rate = channelRate(channel, chunkEnd);
+        if (rate <= 0.0) {
+            return timestamp > channel.firstTimestamp ? channel.sampleCount : 0;
+        }
+
+        const double due = std::ceil(static_cast<double>(timestamp - channel.firstTimestamp) * rate / 1000.0);
+        return static_cast<int>(std::clamp(due, 0.0, static_cast<double>(channel.sampleCount)));
+    }
+}
+
+/**
+ * @brief Constructs the FileDataProvider
+ * @param parent Parent QObject for memory management
+ *
+ * Loads the saved "File" provider configuration. The recording is only opened
+ * when the provider starts.
+ */
+FileDataProvider::FileDataProvider(QObject* parent)
+    : IDataProvider(parent)
+    , status_(VitalSync::ConnectionStatus::Disconnected)
+    , active_(false)
+    , position_(0)
+    , playback_speed_(1.0)
+    , max_speed_(false)
+    , loop_(true)
+    , replay_timer_(this)   // Parented so the timer follows moveToThread()
+    , pending_ms_(0.0)
+    , chunk_index_(0)
+    , parameter_cursor_(0)
+    , last_emit_timestamp_(0)
+    , time_offset_(0)
+    , rebase_(false)
+{
+    connect(&replay_timer_, &QTimer::timeout, this, &FileDataProvider::replayTick);
+
+    // Load configuration
+    QVariantMap providerConfig = ConfigManager::GetInstance().GetProviderConfig("File");
+    if (!providerConfig.isEmpty()) {
+        configure(providerConfig);
+    }
+}
+
+FileDataProvider::~FileDataProvider()
+{
+    stop();
+}
+
+/**
+ * @brief Opens the configured recording and starts replaying it
+ * @return True if the recording could be opened
+ */
+bool FileDataProvider::start()
+{
+    if (isActive()) {
+        qDebug() << "FileDataProvider: Already started, ignoring start request";
+        return true;
+    }
+
+    if (file_path_.isEmpty()) {
+        emit errorOccurred(static_cast<int>(VitalSync::ErrorCode::ConfigurationError),
+                           tr("No recording selected for replay."));
+        return false;
+    }
+
+    if (!reader_.Open(file_path_) || reader_.GetChunkCount() == 0) {
+        reader_.Close();
+        setStatus(VitalSync::ConnectionStatus::Error);
+        emit errorOccurred(static_cast<int>(VitalSync::ErrorCode::DataError),
+                           tr("Cannot replay recording %1.").arg(file_path_));
+        return false;
+    }
+
+    {
+        QMutexLocker locker(&mutex_);
+        active_ = true;
+    }
+
+    Seek(reader_.GetStartTimestamp());
+    replay_clock_.start();
+    replay_timer_.start(max_speed_ ? 0 : REPLAY_INTERVAL_MS);
+
+    qDebug() << "FileDataProvider: Replaying" << file_path_ << "from"
+             << QDateTime::fromMSecsSinceEpoch(reader_.GetStartTimestamp()).toString(Qt::ISODate)
+             << "at" << (max_speed_ ? QString("maximum speed") : QString("%1x").arg(playback_speed_));
+    setStatus(VitalSync::ConnectionStatus::Connected);
+    return true;
+}
+
+/**
+ * @brief Stops replaying and closes the recording
+ */
+void FileDataProvider::stop()
+{
+    replay_timer_.stop();
+    reader_.Close();
+    chunk_.channels.clear();
+
+    {
+        QMutexLocker locker(&mutex_);
+        active_ = false;
+        position_ = 0;
+    }
+    setStatus(VitalSync::ConnectionStatus::Disconnected);
+}
+
+/**
+ * @brief Gets the current connection status
+ * @return Current connection status
+ */
+VitalSync::ConnectionStatus FileDataProvider::GetConnectionStatus() const
+{
+    QMutexLocker locker(&mutex_);
+    return status_;
+}
+
+/**
+ * @brief Gets the provider name
+ * @return Name of the provider ("File")
+ */
+std::string FileDataProvider::GetName() const
+{
+    return "File";
+}
+
+/**
+ * @brief Checks if this provider is currently in use
+ * @return True if replay is running
+ */
+bool FileDataProvider::isActive() const
+{
+    QMutexLocker locker(&mutex_);
+    return active_;
+}
+
+/**
+ * @brief Applies replay settings
+ * @param params "filePath", "playbackSpeed", "maxSpeed" and "loop"
+ * @return True if configuration was successful
+ *
+ * Selecting another recording while replaying restarts replay with it; speed
+ * and loop changes apply immediately.
+ */
+bool FileDataProvider::configure(const QVariantMap& params)
+{
+    const QString filePath = params.value("filePath", file_path_).toString();
+    if (!filePath.isEmpty() && !QFileInfo::exists(filePath)) {
+        qWarning() << "FileDataProvider: Recording not found:" << filePath;
+        return false;
+    }
+
+    const bool fileChanged = filePath != file_path_;
+    file_path_ = filePath;
+    playback_speed_ = std::clamp(params.value("playbackSpeed", playback_speed_).toDouble(),
+                                 MIN_PLAYBACK_SPEED, MAX_PLAYBACK_SPEED);
+    max_speed_ = params.value("maxSpeed", max_speed_).toBool();
+    loop_ = params.value("loop", loop_).toBool();
+
+    if (isActive()) {
+        if (fileChanged) {
+            stop();
+            return start();
+        }
+        pending_ms_ = 0.0;
+        replay_clock_.restart();
+        replay_timer_.start(max_speed_ ? 0 : REPLAY_INTERVAL_MS);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Continues replay from a recorded time
+ * @param timestamp Recorded time in milliseconds since the epoch
+ * @return True if the recording is open and contains data at or after the time
+ */
+bool FileDataProvider::Seek(qint64 timestamp)
+{
+    if (!reader_.IsOpen()) {
+        return false;
+    }
+
+    chunk_index_ = reader_.FindChunk(timestamp);
+    if (!loadChunk(timestamp)) {
+        return false;
+    }
+
+    pending_ms_ = 0.0;
+    rebase_ = true;
+    QMutexLocker locker(&mutex_);
+    position_ = std::max(timestamp, reader_.GetStartTimestamp());
+    return true;
+}
+
+/**
+ * @brief Gets the recorded time replay has reached
+ * @return Timestamp in milliseconds since the epoch, 0 if not replaying
+ */
+qint64 FileDataProvider::GetPosition() const
+{
+    QMutexLocker locker(&mutex_);
+    return position_;
+}
+
+/**
+ * @brief Emits the data due since the previous tick
+ *
+ * Timed replay advances the recorded time by the elapsed wall time times the
+ * playback speed. Maximum speed replay emits a few whole chunks per tick and
+ * yields to the event loop in between.
+ */
+void FileDataProvider::replayTick()
+{
+    bool more = false;
+
+    if (max_speed_) {
+        more = replayUntil(END_OF_TIME, MAX_SPEED_CHUNKS_PER_TICK);
+    } else {
+        pending_ms_ += replay_clock_.restart() * playback_speed_;
+        const qint64 step = static_cast<qint64>(pending_ms_);
+        pending_ms_ -= static_cast<double>(step);
+        more = replayUntil(GetPosition() + step, std::numeric_limits<int>::max());
+    }
+
+    if (more) {
+        return;
+    }
+
+    if (loop_ && Seek(reader_.GetStartTimestamp())) {
+        qDebug() << "FileDataProvider: End of recording, looping";
+        return;
+    }
+
+    qDebug() << "FileDataProvider: End of recording";
+    replay_timer_.stop();
+    setStatus(VitalSync::ConnectionStatus::Disconnected);
+}
+
+/**
+ * @brief Emits all data recorded before a time
+ * @param until Recorded time in milliseconds since the epoch
+ * @param maxChunks Number of chunks after which to stop early
+ * @return False once the end of the recording was reached
+ */
+bool FileDataProvider::replayUntil(qint64 until, int maxChunks)
+{
+    int chunksDone = 0;
+    qint64 reached = until;
+
+    while (chunk_index_ < reader_.GetChunkCount()) {
+        if (chunk_.startTimestamp > until) {
+            // Nothing due yet; skip long pauses in the recording rather than wait them out
+            reached = chunk_.startTimestamp - until > MAX_REPLAY_GAP_MS ? chunk_.startTimestamp : until;
+            break;
+        }
+
+        frame_.clear();
+        bool chunkDone = true;
+        qint64 recordedTime = END_OF_TIME;
+
+        for (int i = 0; i < chunk_.channels.size(); ++i) {
+            const RecordingReader::ChannelView& channel = chunk_.channels[i];
+            const int due = samplesBefore(channel, chunk_.endTimestamp, until);
+            int& cursor = channel_cursors_[i];
+            if (due > cursor) {
+                recordedTime = std::min(recordedTime, sampleTimestamp(channel, chunk_.endTimestamp, cursor));
+                float* target = frame_.AppendChannel(channel.waveformId, due - cursor, channel.sampleRate);
+                std::memcpy(target, channel.samples + cursor, static_cast<size_t>(due - cursor) * sizeof(float));
+                cursor = due;
+            }
+            chunkDone = chunkDone && cursor >= channel.sampleCount;
+        }
+
+        while (parameter_cursor_ < chunk_.parameterCount
+               && (until == END_OF_TIME || chunk_.parameters[parameter_cursor_].timestamp < until)) {
+            const VitalSync::Recording::ParameterRecord& record = chunk_.parameters[parameter_cursor_];
+            recordedTime = std::min(recordedTime, record.timestamp);
+            frame_.AppendParameter(record.parameterId, record.value);
+            ++parameter_cursor_;
+        }
+        chunkDone = chunkDone && parameter_cursor_ >= chunk_.parameterCount;
+
+        if (!frame_.isEmpty()) {
+            frame_.timestamp = emitTimestamp(recordedTime);
+            emit dataFrameReceived(frame_);
+        }
+
+        if (!chunkDone) {
+            break;
+        }
+
+        // Continue with the next chunk from its start
+        reached = std::min(until, chunk_.endTimestamp);
+        ++chunk_index_;
+        if (!loadChunk(std::numeric_limits<qint64>::min())) {
+            break;
+        }
+        if (++chunksDone >= maxChunks) {
+            break;
+        }
+    }
+
+    {
+        QMutexLocker locker(&mutex_);
+        position_ = reached;
+    }
+    return chunk_index_ < reader_.GetChunkCount();
+}
+
+/**
+ * @brief Makes the chunk at chunk_index_ current, positioned at a time
+ * @param timestamp Recorded time to start the chunk from
+ * @return False if there is no such chunk
+ *
+ * Malformed chunks are skipped.
+ */
+bool FileDataProvider::loadChunk(qint64 timestamp)
+{
+    while (chunk_index_ < reader_.GetChunkCount()) {
+        if (reader_.ReadChunk(chunk_index_, chunk_)) {
+            channel_cursors_.resize(chunk_.channels.size());
+            for (int i = 0; i < chunk_.channels.size(); ++i) {
+                channel_cursors_[i] = samplesBefore(chunk_.channels[i], chunk_.endTimestamp, timestamp);
+            }
+
+            parameter_cursor_ = 0;
+            while (parameter_cursor_ < chunk_.parameterCount
+                   && chunk_.parameters[parameter_cursor_].timestamp < timestamp) {
+                ++parameter_cursor_;
+            }
+            return true;
+        }
+
+        qWarning() << "FileDataProvider: Skipping malformed chunk" << chunk_index_;
+        ++chunk_index_;
+    }
+    return false;
+}
+
+/**
+ * @brief Gets the timestamp to stamp an emitted frame with
+ * @param recordedTime Recorded time of the frame's first sample or value
+ * @return Recorded time plus the replay offset, strictly increasing
+ *
+ * Frames carry the time they were recorded, so sample rates, heart rates
+ * and alarm delays come out as in the recorded session whatever the playback
+ * speed. Models ignore data that is not newer than what they already hold:
+ * after a loop or a backward seek the offset grows so that replay continues
+ * one tick after the last emitted frame, and frames that would still not be
+ * newer push the offset forward by the difference. The offset never shrinks.
+ */
+qint64 FileDataProvider::emitTimestamp(qint64 recordedTime)
+{
+    if (rebase_ && last_emit_timestamp_ != 0 && recordedTime + time_offset_ <= last_emit_timestamp_) {
+        time_offset_ = last_emit_timestamp_ + REPLAY_INTERVAL_MS - recordedTime;
+    }
+    rebase_ = false;
+
+    if (recordedTime + time_offset_ <= last_emit_timestamp_) {
+        time_offset_ = last_emit_timestamp_ + 1 - recordedTime;
+    }
+    last_emit_timestamp_ = recordedTime + time_offset_;
+    return last_emit_timestamp_;
+}
+
+/**
+ * @brief Updates the connection status and notifies listeners on change
+ * @param status New connection status
+ */
+void FileDataProvider::setStatus(VitalSync::ConnectionStatus status)
+{
+    {
+        QMutexLocker locker(&mutex_);
+        if (status_ == status) {
+            return;
+        }
+        status_ = status;
+    } // Release the mutex before emitting signals
+
+    emit connectionStatusChanged(status);
+}
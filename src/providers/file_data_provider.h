@@ -0,0 +1,162 @@
+/**
+ * @file file_data_provider.h
+ * @brief Definition of the FileDataProvider class
+ *
+ * This file contains the definition of the FileDataProvider class which
+ * replays full-disclosure recordings written by the DataRecorder.
+ */
+#ifndef FILE_DATA_PROVIDER_H
+#define FILE_DATA_PROVIDER_H
+
+#include "../../include/i_data_provider.h"
+#include "../../include/data_frame.h"
+#include "../../include/vital_sync_types.h"
+#include "../core/recording_reader.h"
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QString>
+#include <QTimer>
+#include <QVarLengthArray>
+#include <QVariantMap>
+
+/**
+ * @brief Provider replaying a recording
+ *
+ * The recording is memory-mapped and replayed in recorded time at a
+ * configurable speed, or as fast as the models accept it. Replayed data is
+ * stamped with the time it was recorded and carries the recorded sample
+ * rates, so the models, processors and alarms see the recorded session at
+ * any speed. An offset that only grows is added to the recorded times, so
+ * looping and seeking never look like time running backwards to the models.
+ */
+class FileDataProvider : public IDataProvider {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor
+     * @param parent Parent QObject
+     */
+    explicit FileDataProvider(QObject* parent = nullptr);
+
+    /**
+     * @brief Destructor
+     */
+    ~FileDataProvider() override;
+
+    /**
+     * @brief Open the configured recording and start replaying it
+     * @return True if the recording could be opened
+     */
+    bool start() override;
+
+    /**
+     * @brief Stop replaying and close the recording
+     */
+    void stop() override;
+
+    /**
+     * @brief Get the current connection status
+     * @return Current connection status
+     */
+    VitalSync::ConnectionStatus GetConnectionStatus() const override;
+
+    /**
+     * @brief Get provider name
+     * @return Name of the provider
+     */
+    std::string GetName() const override;
+
+    /**
+     * @brief Check if this provider is currently in use
+     * @return True if this provider is active
+     */
+    bool isActive() const override;
+
+    /**
+     * @brief Configure the provider
+     * @param params "filePath", "playbackSpeed" (multiple of real time),
+     *               "maxSpeed" (replay as fast as possible) and "loop"
+     * @return True if configuration was successful
+     */
+    bool configure(const QVariantMap& params) override;
+
+    /**
+     * @brief Continue replay from a recorded time
+     * @param timestamp Recorded time in milliseconds since the epoch
+     * @return True if the recording is open and contains data at or after the time
+     *
+     * Must be called in the provider's thread.
+     */
+    bool Seek(qint64 timestamp);
+
+    /**
+     * @brief Get the recorded time replay has reached
+     * @return Timestamp in milliseconds since the epoch, 0 if not replaying
+     */
+    qint64 GetPosition() const;
+
+private slots:
+    /**
+     * @brief Emit the data due since the previous tick
+     */
+    void replayTick();
+
+private:
+    /**
+     * @brief Emit all data recorded before a time
+     * @param until Recorded time in milliseconds since the epoch
+     * @param maxChunks Number of chunks after which to stop early
+     * @return False once the end of the recording was reached
+     */
+    bool replayUntil(qint64 until, int maxChunks);
+
+    /**
+     * @brief Make the chunk at chunk_index_ current, positioned at a time
+     * @param timestamp Recorded time to start the chunk from
+     * @return False if there is no such chunk
+     */
+    bool loadChunk(qint64 timestamp);
+
+    /**
+     * @brief Get the timestamp to stamp an emitted frame with
+     * @param recordedTime Recorded time of the frame's first sample or value
+     * @return Recorded time plus the replay offset, strictly increasing
+     */
+    qint64 emitTimestamp(qint64 recordedTime);
+
+    /**
+     * @brief Update the connection status and notify listeners on change
+     * @param status New connection status
+     */
+    void setStatus(VitalSync::ConnectionStatus status);
+
+private:
+    // Connection state, shared with callers on other threads
+    VitalSync::ConnectionStatus status_;    ///< Current connection status
+    bool active_;                           ///< Whether replay is running
+    qint64 position_;                       ///< Recorded time replay has reached
+    mutable QMutex mutex_;                  ///< Guards status_, active_ and position_
+
+    // Configuration
+    QString file_path_;                     ///< Recording to replay
+    double playback_speed_;                 ///< Multiple of real time
+    bool max_speed_;                        ///< Replay as fast as possible
+    bool loop_;                             ///< Restart at the end of the recording
+
+    // Replay state, owned by the provider's thread
+    RecordingReader reader_;                ///< Mapped recording
+    QTimer replay_timer_;                   ///< Drives the replay
+    QElapsedTimer replay_clock_;            ///< Wall time since the previous tick
+    double pending_ms_;                     ///< Recorded time due but not yet replayed
+    int chunk_index_;                       ///< Chunk being replayed
+    RecordingReader::ChunkView chunk_;      ///< Contents of the chunk being replayed
+    QVarLengthArray<int, 16> channel_cursors_;  ///< Next sample to replay per channel of the chunk
+    int parameter_cursor_;                  ///< Next parameter to replay in the chunk
+    qint64 last_emit_timestamp_;            ///< Timestamp of the last emitted frame
+    qint64 time_offset_;                    ///< Added to recorded times, grows on loops and backward seeks
+    bool rebase_;                           ///< Whether replay was repositioned since the last frame
+    VitalSync::DataFrame frame_;            ///< Frame reused for every emission
+};
+
+#endif // FILE_DATA_PROVIDER_H
@@ -0,0 +1,524 @@
+/**
+ * @file network_data_provider.cpp
+ * @brief Implementation of the NetworkDataProvider class
+ *
+ * This file implements the NetworkDataProvider class which receives bedside
+ * data streams over TCP or UDP, decodes NetworkFrameCodec frames and keeps the
+ * connection alive with reconnects, a stall watchdog and stream resync.
+ */
+#include "network_data_provider.h"
+#include "network_frame_codec.h"
+#include "../../include/config_manager.h"
+#include "../utils/log_categories.h"
+#include "../utils/metrics.h"
+#include <QHostAddress>
+#include <QTcpSocket>
+#include <QUdpSocket>
+#include <QDebug>
+#include <algorithm>
+
+/**
+ * @namespace Anonymous namespace for constants
+ * @brief Contains default connection settings of the network provider
+ */
+namespace {
+    const QString DEFAULT_HOST = "localhost";           ///< Default host
+    const quint16 DEFAULT_PORT = 5000;                  ///< Default port
+    const QString DEFAULT_PROTOCOL = "tcp";             ///< Default transport
+    const int DEFAULT_RECONNECT_INTERVAL_MS = 500;      ///< First reconnect delay
+    const int MAX_RECONNECT_DELAY_MS = 5000;            ///< Longest reconnect delay
+    const int DEFAULT_DATA_TIMEOUT_MS = 3000;           ///< Silence after which the stream counts as lost
+    const int MIN_TIMEOUT_MS = 100;                     ///< Smallest accepted interval or timeout
+    const int MIN_WATCHDOG_INTERVAL_MS = 250;           ///< Shortest watchdog period
+    const int UDP_RECEIVE_BUFFER_SIZE = 1 << 20;        ///< Socket receive buffer for bursts of datagrams
+    const int MAGIC_SIZE = 4;                           ///< Length of the frame magic number
+}
+
+/**
+ * @brief Constructs the NetworkDataProvider
+ * @param parent Parent QObject for memory management
+ *
+ * Loads the saved "Network" provider configuration. Sockets are only created
+ * when the provider starts, in the thread that runs it.
+ */
+NetworkDataProvider::NetworkDataProvider(QObject* parent)
+    : IDataProvider(parent)
+    , status_(VitalSync::ConnectionStatus::Disconnected)
+    , active_(false)
+    , host_(DEFAULT_HOST)
+    , port_(DEFAULT_PORT)
+    , protocol_(DEFAULT_PROTOCOL)
+    , reconnect_interval_ms_(DEFAULT_RECONNECT_INTERVAL_MS)
+    , data_timeout_ms_(DEFAULT_DATA_TIMEOUT_MS)
+    , tcp_socket_(nullptr)
+    , udp_socket_(nullptr)
+    , reconnect_timer_(this)   // Parented so the timers follow moveToThread()
+    , watchdog_timer_(this)
+    , reconnect_delay_ms_(DEFAULT_RECONNECT_INTERVAL_MS)
+    , error_reported_(false)
+    , synchronized_(true)
+    , expected_sequence_(0)
+    , have_sequence_(false)
+    , frames_received_(0)
+    , frames_lost_(0)
+    , resync_count_(0)
+{
+    reconnect_timer_.setSingleShot(true);
+    connect(&reconnect_timer_, &QTimer::timeout, this, &NetworkDataProvider::openSocket);
+    connect(&watchdog_timer_, &QTimer::timeout, this, &NetworkDataProvider::HandleWatchdogTimeout);
+
+    // Load configuration
+    QVariantMap providerConfig = ConfigManager::GetInstance().GetProviderConfig("Network");
+    if (!providerConfig.isEmpty()) {
+        configure(providerConfig);
+    }
+}
+
+NetworkDataProvider::~NetworkDataProvider()
+{
+    stop();
+}
+
+/**
+ * @brief Starts receiving data
+ * @return True if the connection attempt was started
+ *
+ * Connecting is asynchronous: the provider reports Connecting right away and
+ * Connected once the connection is up (TCP) or data arrives (UDP).
+ */
+bool NetworkDataProvider::start()
+{
+    {
+        QMutexLocker locker(&mutex_);
+        if (active_) {
+            qDebug() << "NetworkDataProvider: Already started, ignoring start request";
+            return true;
+        }
+        active_ = true;
+    }
+
+    frames_received_ = 0;
+    frames_lost_ = 0;
+    resync_count_ = 0;
+    reconnect_delay_ms_ = reconnect_interval_ms_;
+    error_reported_ = false;
+
+    qDebug() << "NetworkDataProvider: Starting" << protocol_ << "stream from" << host_ << "port" << port_;
+    openSocket();
+
+    watchdog_timer_.start(std::max(MIN_WATCHDOG_INTERVAL_MS, data_timeout_ms_ / 4));
+    return true;
+}
+
+/**
+ * @brief Stops receiving data and closes the connection
+ */
+void NetworkDataProvider::stop()
+{
+    bool wasActive = false;
+    {
+        QMutexLocker locker(&mutex_);
+        wasActive = active_;
+        active_ = false;
+    }
+
+    reconnect_timer_.stop();
+    watchdog_timer_.stop();
+    closeSocket();
+
+    if (wasActive) {
+        qDebug() << "NetworkDataProvider: Stopped after" << frames_received_ << "frames,"
+                 << frames_lost_ << "lost," << resync_count_ << "resyncs";
+    }
+    setStatus(VitalSync::ConnectionStatus::Disconnected);
+}
+
+/**
+ * @brief Gets the current connection status
+ * @return Current connection status
+ */
+VitalSync::ConnectionStatus NetworkDataProvider::GetConnectionStatus() const
+{
+    QMutexLocker locker(&mutex_);
+    return status_;
+}
+
+/**
+ * @brief Gets the provider name
+ * @return Name of the provider ("Network")
+ */
+std::string NetworkDataProvider::GetName() const
+{
+    return "Network";
+}
+
+/**
+ * @brief Checks if this provider is currently in use
+ * @return True if the provider was started and not stopped since
+ */
+bool NetworkDataProvider::isActive() const
+{
+    QMutexLocker locker(&mutex_);
+    return active_;
+}
+
+/**
+ * @brief Applies connection settings
+ * @param params "host", "port", "protocol", "reconnectIntervalMs" and "dataTimeoutMs"
+ * @return True if configuration was successful
+ *
+ * Invalid settings are rejected as a whole. An active connection is reopened
+ * with the new settings.
+ */
+bool NetworkDataProvider::configure(const QVariantMap& params)
+{
+    QString host = params.value("host", host_).toString().trimmed();
+    int port = params.value("port", port_).toInt();
+    QString protocol = params.value("protocol", protocol_).toString().toLower();
+    int reconnectInterval = params.value("reconnectIntervalMs", reconnect_interval_ms_).toInt();
+    int dataTimeout = params.value("dataTimeoutMs", data_timeout_ms_).toInt();
+
+    if (port < 1 || port > 65535) {
+        qWarning() << "NetworkDataProvider: Invalid port" << port;
+        return false;
+    }
+    if (protocol != "tcp" && protocol != "udp") {
+        qWarning() << "NetworkDataProvider: Unsupported protocol" << protocol;
+        return false;
+    }
+    if (host.isEmpty() && protocol == "tcp") {
+        qWarning() << "NetworkDataProvider: No host configured";
+        return false;
+    }
+
+    host_ = host;
+    port_ = static_cast<quint16>(port);
+    protocol_ = protocol;
+    reconnect_interval_ms_ = std::max(MIN_TIMEOUT_MS, reconnectInterval);
+    data_timeout_ms_ = std::max(MIN_TIMEOUT_MS, dataTimeout);
+
+    if (isActive()) {
+        qDebug() << "NetworkDataProvider: Reconnecting with new settings";
+        reconnect_timer_.stop();
+        reconnect_delay_ms_ = reconnect_interval_ms_;
+        error_reported_ = false;
+        openSocket();
+        watchdog_timer_.start(std::max(MIN_WATCHDOG_INTERVAL_MS, data_timeout_ms_ / 4));
+    }
+
+    return true;
+}
+
+/**
+ * @brief Handles an established TCP connection
+ */
+void NetworkDataProvider::HandleConnected()
+{
+    qDebug() << "NetworkDataProvider: Connected to" << host_ << "port" << port_;
+    reconnect_delay_ms_ = reconnect_interval_ms_;
+    error_reported_ = false;
+    last_data_timer_.restart();
+    setStatus(VitalSync::ConnectionStatus::Connected);
+}
+
+/**
+ * @brief Handles a TCP connection closed by the peer
+ */
+void NetworkDataProvider::HandleDisconnected()
+{
+    scheduleReconnect(tr("Connection closed"));
+}
+
+/**
+ * @brief Handles socket errors
+ * @param error Socket error
+ *
+ * A closed connection is handled by HandleDisconnected(); every other error
+ * drops the socket and retries.
+ */
+void NetworkDataProvider::HandleSocketError(QAbstractSocket::SocketError error)
+{
+    if (error == QAbstractSocket::RemoteHostClosedError) {
+        return;
+    }
+
+    QAbstractSocket* socket = qobject_cast<QAbstractSocket*>(sender());
+    scheduleReconnect(socket ? socket->errorString() : tr("Socket error %1").arg(static_cast<int>(error)));
+}
+
+/**
+ * @brief Reads and decodes the bytes available on the TCP socket
+ *
+ * Bytes are read straight into the tail of the receive buffer, complete frames
+ * are decoded in place and only the start of an incomplete frame is kept for
+ * the next read. The buffer keeps its capacity, so steady streaming does not
+ * allocate.
+ */
+void NetworkDataProvider::HandleReadyRead()
+{
+    if (!tcp_socket_) {
+        return;
+    }
+
+    const qint64 available = tcp_socket_->bytesAvailable();
+    if (available <= 0) {
+        return;
+    }
+
+    const qsizetype previousSize = receive_buffer_.size();
+    receive_buffer_.resize(previousSize + available);
+    const qint64 bytesRead = tcp_socket_->read(receive_buffer_.data() + previousSize, available);
+    receive_buffer_.resize(previousSize + std::max<qint64>(0, bytesRead));
+    if (bytesRead <= 0) {
+        return;
+    }
+    last_data_timer_.restart();
+
+    const qsizetype consumed = decodeFrames(receive_buffer_.constData(), receive_buffer_.size());
+    if (consumed > 0) {
+        receive_buffer_.remove(0, consumed);
+    }
+}
+
+/**
+ * @brief Reads and decodes the datagrams available on the UDP socket
+ *
+ * Each datagram holds whole frames; bytes left over at the end of a datagram
+ * are dropped.
+ */
+void NetworkDataProvider::HandleDatagramsReady()
+{
+    while (udp_socket_ && udp_socket_->hasPendingDatagrams()) {
+        const qint64 datagramSize = udp_socket_->pendingDatagramSize();
+        if (datagramSize < 0) {
+            break;
+        }
+
+        receive_buffer_.resize(datagramSize);
+        const qint64 bytesRead = udp_socket_->readDatagram(receive_buffer_.data(), datagramSize);
+        if (bytesRead <= 0) {
+            continue;
+        }
+
+        last_data_timer_.restart();
+        if (GetConnectionStatus() != VitalSync::ConnectionStatus::Connected) {
+            reconnect_delay_ms_ = reconnect_interval_ms_;
+            error_reported_ = false;
+            setStatus(VitalSync::ConnectionStatus::Connected);
+        }
+
+        synchronized_ = true;
+        decodeFrames(receive_buffer_.constData(), bytesRead);
+    }
+    receive_buffer_.resize(0);
+}
+
+/**
+ * @brief Checks that data is still arriving
+ *
+ * A TCP stream that stays silent, or a connection attempt that hangs, for
+ * longer than the data timeout is dropped and reopened. A silent UDP stream
+ * keeps its socket and reports Connecting until datagrams arrive again.
+ */
+void NetworkDataProvider::HandleWatchdogTimeout()
+{
+    if (!isActive() || reconnect_timer_.isActive() || last_data_timer_.elapsed() < data_timeout_ms_) {
+        return;
+    }
+
+    if (tcp_socket_) {
+        scheduleReconnect(tr("No data for %1 ms").arg(data_timeout_ms_));
+    } else if (udp_socket_ && GetConnectionStatus() == VitalSync::ConnectionStatus::Connected) {
+        qWarning() << "NetworkDataProvider: No datagrams for" << data_timeout_ms_ << "ms";
+        setStatus(VitalSync::ConnectionStatus::Connecting);
+    }
+}
+
+/**
+ * @brief Creates the socket for the configured protocol and connects or binds it
+ *
+ * Any previous socket is dropped and the stream state is reset, so a new
+ * connection resynchronizes from its first frame.
+ */
+void NetworkDataProvider::openSocket()
+{
+    if (!isActive()) {
+        return;
+    }
+
+    closeSocket();
+    receive_buffer_.resize(0);
+    synchronized_ = true;
+    have_sequence_ = false;
+    last_data_timer_.start();
+    setStatus(VitalSync::ConnectionStatus::Connecting);
+
+    if (protocol_ == "udp") {
+        udp_socket_ = new QUdpSocket(this);
+        udp_socket_->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, UDP_RECEIVE_BUFFER_SIZE);
+        connect(udp_socket_, &QUdpSocket::readyRead, this, &NetworkDataProvider::HandleDatagramsReady);
+        connect(udp_socket_, &QAbstractSocket::errorOccurred, this, &NetworkDataProvider::HandleSocketError);
+
+        const QHostAddress group(host_);
+        const bool multicast = group.isMulticast();
+        const QHostAddress bindAddress = multicast && group.protocol() == QAbstractSocket::IPv6Protocol
+            ? QHostAddress(QHostAddress::AnyIPv6) : QHostAddress(QHostAddress::AnyIPv4);
+
+        if (!udp_socket_->bind(bindAddress, port_, QAbstractSocket::ShareAddress | QAbstractSocket::ReuseAddressHint)) {
+            scheduleReconnect(tr("Cannot bind UDP port %1: %2").arg(port_).arg(udp_socket_->errorString()));
+            return;
+        }
+        if (multicast && !udp_socket_->joinMulticastGroup(group)) {
+            qWarning() << "NetworkDataProvider: Cannot join multicast group" << host_ << udp_socket_->errorString();
+        }
+        qDebug() << "NetworkDataProvider: Listening for datagrams on port" << port_;
+        return;
+    }
+
+    tcp_socket_ = new QTcpSocket(this);
+    tcp_socket_->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    connect(tcp_socket_, &QTcpSocket::connected, this, &NetworkDataProvider::HandleConnected);
+    connect(tcp_socket_, &QTcpSocket::disconnected, this, &NetworkDataProvider::HandleDisconnected);
+    connect(tcp_socket_, &QTcpSocket::readyRead, this, &NetworkDataProvider::HandleReadyRead);
+    connect(tcp_socket_, &QAbstractSocket::errorOccurred, this, &NetworkDataProvider::HandleSocketError);
+    tcp_socket_->connectToHost(host_, port_);
+}
+
+/**
+ * @brief Closes and destroys the socket
+ *
+ * The socket may be the sender of the signal being handled, so it is
+ * disconnected first and deleted later.
+ */
+void NetworkDataProvider::closeSocket()
+{
+    if (tcp_socket_) {
+        tcp_socket_->disconnect(this);
+        tcp_socket_->abort();
+        tcp_socket_->deleteLater();
+        tcp_socket_ = nullptr;
+    }
+    if (udp_socket_) {
+        udp_socket_->disconnect(this);
+        udp_socket_->close();
+        udp_socket_->deleteLater();
+        udp_socket_ = nullptr;
+    }
+}
+
+/**
+ * @brief Closes the socket and retries after the current reconnect delay
+ * @param reason Reason reported to the log and, once per outage, to the user
+ *
+ * The delay doubles with every failed attempt up to MAX_RECONNECT_DELAY_MS and
+ * is reset once data flows again.
+ */
+void NetworkDataProvider::scheduleReconnect(const QString& reason)
+{
+    if (!isActive() || reconnect_timer_.isActive()) {
+        return;
+    }
+
+    closeSocket();
+    qWarning() << "NetworkDataProvider:" << reason << "- reconnecting in" << reconnect_delay_ms_ << "ms";
+
+    if (!error_reported_) {
+        error_reported_ = true;
+        emit errorOccurred(static_cast<int>(VitalSync::ErrorCode::ConnectionError),
+                           tr("Network stream lost: %1. Reconnecting...").arg(reason));
+    }
+
+    setStatus(VitalSync::ConnectionStatus::Connecting);
+    reconnect_timer_.start(reconnect_delay_ms_);
+    reconnect_delay_ms_ = std::min(reconnect_delay_ms_ * 2, MAX_RECONNECT_DELAY_MS);
+}
+
+/**
+ * @brief Updates the connection status and notifies listeners on change
+ * @param status New connection status
+ */
+void NetworkDataProvider::setStatus(VitalSync::ConnectionStatus status)
+{
+    {
+        QMutexLocker locker(&mutex_);
+        if (status_ == status) {
+            return;
+        }
+        status_ = status;
+    } // Release the mutex before emitting signals
+
+    emit connectionStatusChanged(status);
+}
+
+/**
+ * @brief Decodes and emits all complete frames in a buffer
+ * @param data Received bytes
+ * @param size Number of received bytes
+ * @return Number of bytes consumed; the rest is the start of an incomplete frame
+ *
+ * Invalid bytes are skipped up to the next frame start. When no frame start
+ * is found, the last bytes are kept in case they begin the next magic number.
+ */
+qsizetype NetworkDataProvider::decodeFrames(const char* data, qsizetype size)
+{
+    qsizetype position = 0;
+
+    while (position < size) {
+        quint32 sequence = 0;
+        qsizetype frameSize = 0;
+        const auto status = NetworkFrameCodec::Decode(data + position, size - position, frame_, &sequence, &frameSize);
+
+        if (status == NetworkFrameCodec::DecodeStatus::Incomplete) {
+            break;
+        }
+
+        if (status == NetworkFrameCodec::DecodeStatus::Frame) {
+            synchronized_ = true;
+            position += frameSize;
+            ++frames_received_;
+            trackSequence(sequence);
+            emit dataFrameReceived(frame_);
+            continue;
+        }
+
+        // Invalid: skip to the next frame start
+        if (synchronized_) {
+            synchronized_ = false;
+            ++resync_count_;
+            qWarning() << "NetworkDataProvider: Invalid frame data, resynchronizing";
+        }
+
+        const qsizetype next = NetworkFrameCodec::FindFrameStart(data + position + 1, size - position - 1);
+        if (next < 0) {
+            position = std::max(position + 1, size - (MAGIC_SIZE - 1));
+            break;
+        }
+        position += 1 + next;
+    }
+
+    return position;
+}
+
+/**
+ * @brief Accounts for the sequence number of a received frame
+ * @param sequence Sequence number
+ *
+ * Sequence numbers wrap around. A jump backwards means the sender restarted
+ * and is not counted as loss.
+ */
+void NetworkDataProvider::trackSequence(quint32 sequence)
+{
+    if (have_sequence_ && sequence != expected_sequence_) {
+        const quint32 gap = sequence - expected_sequence_;
+        if (gap < 0x80000000u) {
+            frames_lost_ += gap;
+            Metrics::Add(Metrics::Counter::NetworkFramesLost, gap);
+            qCDebug(lcProvider) << "NetworkDataProvider: Lost" << gap << "frames before sequence" << sequence;
+        } else {
+            qCDebug(lcProvider) << "NetworkDataProvider: Sequence restarted at" << sequence;
+        }
+    }
+
+    expected_sequence_ = sequence + 1;
+    have_sequence_ = true;
+}
@@ -0,0 +1,198 @@
+/**
+ * @file network_data_provider.h
+ * @brief Definition of the NetworkDataProvider class
+ *
+ * This file contains the definition of the NetworkDataProvider class which
+ * receives live bedside data streams over TCP or UDP. The stream is made of
+ * NetworkFrameCodec frames, each carrying all waveform channels and parameter
+ * values of one acquisition tick.
+ */
+#ifndef NETWORK_DATA_PROVIDER_H
+#define NETWORK_DATA_PROVIDER_H
+
+#include "../../include/i_data_provider.h"
+#include "../../include/data_frame.h"
+#include "../../include/vital_sync_types.h"
+#include <QAbstractSocket>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QString>
+#include <QTimer>
+#include <QVariantMap>
+
+class QTcpSocket;
+class QUdpSocket;
+
+/**
+ * @brief Provider for data streamed over the network
+ *
+ * In TCP mode the provider connects to a bedside device or gateway and reads a
+ * continuous stream of frames. In UDP mode it binds the configured port, joins
+ * the configured group if the host is a multicast address, and expects whole
+ * frames in each datagram.
+ *
+ * The provider runs on the data manager's acquisition thread, so sockets,
+ * reconnects and decoding never block the GUI thread. Frames are decoded into
+ * one reused DataFrame and emitted through dataFrameReceived(), which copies
+ * the samples straight into the model ring buffers. A lost connection is
+ * retried with an increasing delay, and a stream that is corrupt or starts mid
+ * frame is resynchronized on the next frame start.
+ */
+class NetworkDataProvider : public IDataProvider {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor
+     * @param parent Parent QObject
+     */
+    explicit NetworkDataProvider(QObject* parent = nullptr);
+
+    /**
+     * @brief Destructor
+     */
+    ~NetworkDataProvider() override;
+
+    /**
+     * @brief Start receiving data
+     * @return True if the connection attempt was started
+     */
+    bool start() override;
+
+    /**
+     * @brief Stop receiving data and close the connection
+     */
+    void stop() override;
+
+    /**
+     * @brief Get the current connection status
+     * @return Current connection status
+     */
+    VitalSync::ConnectionStatus GetConnectionStatus() const override;
+
+    /**
+     * @brief Get provider name
+     * @return Name of the provider
+     */
+    std::string GetName() const override;
+
+    /**
+     * @brief Check if this provider is currently in use
+     * @return True if this provider is active
+     */
+    bool isActive() const override;
+
+    /**
+     * @brief Configure the provider with connection parameters
+     * @param params "host", "port", "protocol" ("tcp" or "udp"),
+     *               "reconnectIntervalMs" and "dataTimeoutMs"
+     * @return True if configuration was successful
+     *
+     * An active connection is reopened with the new settings.
+     */
+    bool configure(const QVariantMap& params) override;
+
+private slots:
+    /**
+     * @brief Handle an established TCP connection
+     */
+    void HandleConnected();
+
+    /**
+     * @brief Handle a closed TCP connection
+     */
+    void HandleDisconnected();
+
+    /**
+     * @brief Handle socket errors
+     * @param error Socket error
+     */
+    void HandleSocketError(QAbstractSocket::SocketError error);
+
+    /**
+     * @brief Read and decode the bytes available on the TCP socket
+     */
+    void HandleReadyRead();
+
+    /**
+     * @brief Read and decode the datagrams available on the UDP socket
+     */
+    void HandleDatagramsReady();
+
+    /**
+     * @brief Check that data is still arriving
+     */
+    void HandleWatchdogTimeout();
+
+private:
+    /**
+     * @brief Create the socket for the configured protocol and connect or bind it
+     */
+    void openSocket();
+
+    /**
+     * @brief Close and destroy the socket
+     */
+    void closeSocket();
+
+    /**
+     * @brief Close the socket and retry after the current reconnect delay
+     * @param reason Reason reported to the log and, once per outage, to the user
+     */
+    void scheduleReconnect(const QString& reason);
+
+    /**
+     * @brief Update the connection status and notify listeners on change
+     * @param status New connection status
+     */
+    void setStatus(VitalSync::ConnectionStatus status);
+
+    /**
+     * @brief Decode and emit all complete frames in a buffer
+     * @param data Received bytes
+     * @param size Number of received bytes
+     * @return Number of bytes consumed; the rest is the start of an incomplete frame
+     */
+    qsizetype decodeFrames(const char* data, qsizetype size);
+
+    /**
+     * @brief Account for the sequence number of a received frame
+     * @param sequence Sequence number
+     */
+    void trackSequence(quint32 sequence);
+
+private:
+    // Connection state, shared with callers on other threads
+    VitalSync::ConnectionStatus status_;    ///< Current connection status
+    bool active_;                           ///< Whether the provider was started
+    mutable QMutex mutex_;                  ///< Guards status_ and active_
+
+    // Configuration
+    QString host_;                          ///< Host to connect to, or multicast group in UDP mode
+    quint16 port_;                          ///< Port to connect to or bind
+    QString protocol_;                      ///< "tcp" or "udp"
+    int reconnect_interval_ms_;             ///< Initial delay before reconnecting
+    int data_timeout_ms_;                   ///< Silence after which the stream counts as lost
+
+    // Transport, owned by the provider's thread
+    QTcpSocket* tcp_socket_;                ///< TCP socket, when connected over TCP
+    QUdpSocket* udp_socket_;                ///< UDP socket, when receiving datagrams
+    QTimer reconnect_timer_;                ///< Fires the next connection attempt
+    QTimer watchdog_timer_;                 ///< Periodically checks for a stalled stream
+    QElapsedTimer last_data_timer_;         ///< Time since the last received bytes
+    int reconnect_delay_ms_;                ///< Delay before the next reconnect, grows while failing
+    bool error_reported_;                   ///< Whether the current outage was reported
+
+    // Receive path
+    QByteArray receive_buffer_;             ///< Received bytes not yet decoded
+    bool synchronized_;                     ///< Whether the stream is aligned on frame boundaries
+    VitalSync::DataFrame frame_;            ///< Decoded frame, reused for every frame
+    quint32 expected_sequence_;             ///< Sequence number of the next frame
+    bool have_sequence_;                    ///< Whether a frame was received since connecting
+    quint64 frames_received_;               ///< Frames decoded since start
+    quint64 frames_lost_;                   ///< Frames missing from the sequence since start
+    quint64 resync_count_;                  ///< Times the stream had to be resynchronized
+};
+
+#endif // NETWORK_DATA_PROVIDER_H
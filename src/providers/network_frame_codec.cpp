@@ -0,0 +1,369 @@
+/**
+ * @file network_frame_codec.cpp
+ * @brief Implementation of the NetworkFrameCodec class
+ *
+ * This file implements encoding and decoding of the binary network frame
+ * format. All multi-byte fields are read and written unaligned and in
+ * little-endian order, so frames can be decoded in place at any offset of a
+ * receive buffer.
+ */
+#include "network_frame_codec.h"
+#include <QtEndian>
+#include <QFloat16>
+#include <QtAlgorithms>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/**
+ * @namespace Anonymous namespace for constants and helper functions
+ * @brief Contains wire format details used by the NetworkFrameCodec implementation
+ */
+namespace {
+    const int MASK_BITS = 32;                       ///< Number of types a channel mask can address
+    const int CHANNEL_HEADER_SIZE = 4;              ///< Sample count, encoding and reserved byte
+    const int INT16_SCALING_SIZE = 8;               ///< Scale and offset of an Int16 channel
+    const int PARAMETER_SIZE = 4;                   ///< One f32 parameter value
+    const float INT16_RANGE = 32767.0f;             ///< Largest magnitude of a packed Int16 sample
+    const char MAGIC_BYTES[] = { 'V', 'S', 'Y', 'N' };  ///< FRAME_MAGIC as it appears on the wire
+
+    /**
+     * @brief Unpack half precision samples
+     * @param in Packed little-endian samples
+     * @param count Number of samples
+     * @param out Unpacked samples
+     *
+     * Aligned input on little-endian hosts is converted in bulk, which Qt
+     * vectorizes where the CPU supports it.
+     */
+    void unpackFloat16(const uchar* in, int count, float* out)
+    {
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+        if (reinterpret_cast<quintptr>(in) % alignof(qfloat16) == 0) {
+            qFloatFromFloat16(out, reinterpret_cast<const qfloat16*>(in), count);
+            return;
+        }
+#endif
+        for (int i = 0; i < count; ++i) {
+            const quint16 bits = qFromLittleEndian<quint16>(in + 2 * i);
+            qfloat16 half;
+            std::memcpy(&half, &bits, sizeof(half));
+            out[i] = static_cast<float>(half);
+        }
+    }
+
+    /**
+     * @brief Pack samples as half precision floats
+     * @param in Samples
+     * @param count Number of samples
+     * @param out Packed little-endian samples
+     */
+    void packFloat16(const float* in, int count, uchar* out)
+    {
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+        if (reinterpret_cast<quintptr>(out) % alignof(qfloat16) == 0) {
+            qFloatToFloat16(reinterpret_cast<qfloat16*>(out), in, count);
+            return;
+        }
+#endif
+        for (int i = 0; i < count; ++i) {
+            const qfloat16 half(in[i]);
+            quint16 bits;
+            std::memcpy(&bits, &half, sizeof(bits));
+            qToLittleEndian<quint16>(bits, out + 2 * i);
+        }
+    }
+
+    /**
+     * @brief Unpack scaled 16-bit integer samples
+     * @param in Packed little-endian samples
+     * @param count Number of samples
+     * @param scale Value of one integer step
+     * @param offset Value of integer zero
+     * @param out Unpacked samples
+     */
+    void unpackInt16(const uchar* in, int count, float scale, float offset, float* out)
+    {
+        for (int i = 0; i < count; ++i) {
+            out[i] = static_cast<float>(qFromLittleEndian<qint16>(in + 2 * i)) * scale + offset;
+        }
+    }
+
+    /**
+     * @brief Pack samples as scaled 16-bit integers
+     * @param in Samples
+     * @param count Number of samples
+     * @param out Receives the scale, offset and packed little-endian samples
+     *
+     * The scale and offset map the channel's value range onto the full integer
+     * range. Non-finite samples are sent as the center of the range.
+     */
+    void packInt16(const float* in, int count, uchar* out)
+    {
+        float minValue = 0.0f;
+        float maxValue = 0.0f;
+        bool haveValue = false;
+        for (int i = 0; i < count; ++i) {
+            if (!std::isfinite(in[i])) {
+                continue;
+            }
+            minValue = haveValue ? std::min(minValue, in[i]) : in[i];
+            maxValue = haveValue ? std::max(maxValue, in[i]) : in[i];
+            haveValue = true;
+        }
+
+        const float offset = (minValue + maxValue) * 0.5f;
+        const float halfRange = (maxValue - minValue) * 0.5f;
+        const float scale = halfRange > 0.0f ? halfRange / INT16_RANGE : 1.0f;
+
+        qToLittleEndian<float>(scale, out);
+        qToLittleEndian<float>(offset, out + 4);
+        out += INT16_SCALING_SIZE;
+
+        const float inverseScale = 1.0f / scale;
+        for (int i = 0; i < count; ++i) {
+            float step = std::isfinite(in[i]) ? (in[i] - offset) * inverseScale : 0.0f;
+            step = std::clamp(step, -INT16_RANGE, INT16_RANGE);
+            qToLittleEndian<qint16>(static_cast<qint16>(std::lround(step)), out + 2 * i);
+        }
+    }
+
+    /**
+     * @brief Get the payload size of one waveform channel
+     * @param count Number of samples
+     * @param encoding Packing of the samples
+     * @return Size in bytes
+     */
+    int channelPayloadSize(int count, NetworkFrameCodec::SampleEncoding encoding)
+    {
+        const int scalingSize = encoding == NetworkFrameCodec::SampleEncoding::Int16 ? INT16_SCALING_SIZE : 0;
+        return CHANNEL_HEADER_SIZE + scalingSize + 2 * count;
+    }
+}
+
+/**
+ * @brief Decodes the frame at the start of a buffer
+ * @param data Received bytes
+ * @param size Number of received bytes
+ * @param frame Frame to decode into; untouched unless a frame is decoded, capacity is kept
+ * @param sequence Receives the sequence number of the frame
+ * @param consumed Receives the size of the frame in bytes
+ * @return Decode status; frame, sequence and consumed are only set for Frame
+ *
+ * A buffer that does not start with the magic number, or whose header or
+ * payload is inconsistent, is reported as Invalid so that the caller can
+ * resynchronize on the next frame start. The whole layout is checked before
+ * the frame is cleared, so the frame is left untouched unless a frame is
+ * decoded.
+ */
+NetworkFrameCodec::DecodeStatus NetworkFrameCodec::Decode(const char* data, qsizetype size,
+                                                          VitalSync::DataFrame& frame,
+                                                          quint32* sequence, qsizetype* consumed)
+{
+    if (size < static_cast<qsizetype>(sizeof(MAGIC_BYTES))) {
+        // Wait for the rest of the magic number if what we have matches it so far
+        return std::memcmp(data, MAGIC_BYTES, static_cast<size_t>(size)) == 0
+            ? DecodeStatus::Incomplete : DecodeStatus::Invalid;
+    }
+
+    const uchar* bytes = reinterpret_cast<const uchar*>(data);
+    if (qFromLittleEndian<quint32>(bytes) != FRAME_MAGIC) {
+        return DecodeStatus::Invalid;
+    }
+    if (size < HEADER_SIZE) {
+        return DecodeStatus::Incomplete;
+    }
+
+    const quint8 version = bytes[4];
+    const quint16 headerSize = qFromLittleEndian<quint16>(bytes + 6);
+    const quint32 payloadSize = qFromLittleEndian<quint32>(bytes + 8);
+    if (version != PROTOCOL_VERSION || headerSize < HEADER_SIZE || payloadSize > MAX_PAYLOAD_SIZE) {
+        return DecodeStatus::Invalid;
+    }
+
+    const qsizetype frameSize = static_cast<qsizetype>(headerSize) + payloadSize;
+    if (size < frameSize) {
+        return DecodeStatus::Incomplete;
+    }
+
+    const quint32 frameSequence = qFromLittleEndian<quint32>(bytes + 12);
+    const qint64 timestamp = qFromLittleEndian<qint64>(bytes + 16);
+    const quint32 waveformMask = qFromLittleEndian<quint32>(bytes + 24);
+    const quint32 parameterMask = qFromLittleEndian<quint32>(bytes + 28);
+
+    const uchar* const payload = bytes + headerSize;
+    const uchar* const end = bytes + frameSize;
+
+    // Validate the layout before touching the frame, so an Invalid frame leaves it as it was
+    const uchar* cursor = payload;
+    for (int id = 0; id < MASK_BITS; ++id) {
+        if (!(waveformMask & (1u << id))) {
+            continue;
+        }
+        if (end - cursor < CHANNEL_HEADER_SIZE) {
+            return DecodeStatus::Invalid;
+        }
+        const auto encoding = static_cast<SampleEncoding>(cursor[2]);
+        if (encoding != SampleEncoding::Int16 && encoding != SampleEncoding::Float16) {
+            return DecodeStatus::Invalid;
+        }
+        const int channelSize = channelPayloadSize(qFromLittleEndian<quint16>(cursor), encoding);
+        if (end - cursor < channelSize) {
+            return DecodeStatus::Invalid;
+        }
+        cursor += channelSize;
+    }
+
+    // Parameter values fill the rest of the payload exactly
+    if (end - cursor != static_cast<qsizetype>(qPopulationCount(parameterMask)) * PARAMETER_SIZE) {
+        return DecodeStatus::Invalid;
+    }
+
+    frame.clear();
+    frame.timestamp = timestamp;
+
+    // Waveform channels, in ascending type order
+    cursor = payload;
+    for (int id = 0; id < MASK_BITS; ++id) {
+        if (!(waveformMask & (1u << id))) {
+            continue;
+        }
+
+        const int count = qFromLittleEndian<quint16>(cursor);
+        const auto encoding = static_cast<SampleEncoding>(cursor[2]);
+        cursor += CHANNEL_HEADER_SIZE;
+
+        if (encoding == SampleEncoding::Int16) {
+            const float scale = qFromLittleEndian<float>(cursor);
+            const float offset = qFromLittleEndian<float>(cursor + 4);
+            cursor += INT16_SCALING_SIZE;
+            unpackInt16(cursor, count, scale, offset, frame.AppendChannel(id, count));
+        } else {
+            unpackFloat16(cursor, count, frame.AppendChannel(id, count));
+        }
+        cursor += 2 * count;
+    }
+
+    for (int id = 0; id < MASK_BITS; ++id) {
+        if (parameterMask & (1u << id)) {
+            frame.AppendParameter(id, qFromLittleEndian<float>(cursor));
+            cursor += PARAMETER_SIZE;
+        }
+    }
+
+    *sequence = frameSequence;
+    *consumed = frameSize;
+    return DecodeStatus::Frame;
+}
+
+/**
+ * @brief Finds the next frame start in a buffer
+ * @param data Received bytes
+ * @param size Number of received bytes
+ * @return Offset of the next magic number, or -1 if there is none
+ */
+qsizetype NetworkFrameCodec::FindFrameStart(const char* data, qsizetype size)
+{
+    const char* end = data + size;
+    const char* found = std::search(data, end, std::begin(MAGIC_BYTES), std::end(MAGIC_BYTES));
+    return found != end ? found - data : -1;
+}
+
+/**
+ * @brief Encodes a frame and appends it to a buffer
+ * @param frame Frame to encode
+ * @param sequence Sequence number of the frame
+ * @param encoding Packing of the waveform samples
+ * @param out Buffer the encoded frame is appended to
+ * @return True if the frame could be encoded; out is unchanged otherwise
+ */
+bool NetworkFrameCodec::Encode(const VitalSync::DataFrame& frame, quint32 sequence,
+                               SampleEncoding encoding, QByteArray& out)
+{
+    // The masks order channels and parameters by type, so index them by type
+    int channelIndex[MASK_BITS];
+    int parameterIndex[MASK_BITS];
+    std::fill(std::begin(channelIndex), std::end(channelIndex), -1);
+    std::fill(std::begin(parameterIndex), std::end(parameterIndex), -1);
+
+    quint32 waveformMask = 0;
+    quint32 parameterMask = 0;
+    qsizetype payloadSize = 0;
+
+    for (int i = 0; i < frame.channels.size(); ++i) {
+        const VitalSync::FrameChannel& channel = frame.channels[i];
+        if (channel.waveformId < 0 || channel.waveformId >= MASK_BITS || channelIndex[channel.waveformId] >= 0
+            || channel.count < 0 || channel.count > MAX_CHANNEL_SAMPLES) {
+            qWarning() << "NetworkFrameCodec: Cannot encode waveform channel" << channel.waveformId;
+            return false;
+        }
+        channelIndex[channel.waveformId] = i;
+        waveformMask |= 1u << channel.waveformId;
+        payloadSize += channelPayloadSize(channel.count, encoding);
+    }
+
+    for (int i = 0; i < frame.parameters.size(); ++i) {
+        const int id = frame.parameters[i].parameterId;
+        if (id < 0 || id >= MASK_BITS || parameterIndex[id] >= 0) {
+            qWarning() << "NetworkFrameCodec: Cannot encode parameter" << id;
+            return false;
+        }
+        parameterIndex[id] = i;
+        parameterMask |= 1u << id;
+        payloadSize += PARAMETER_SIZE;
+    }
+
+    if (payloadSize > static_cast<qsizetype>(MAX_PAYLOAD_SIZE)) {
+        qWarning() << "NetworkFrameCodec: Frame too large to encode:" << payloadSize << "bytes";
+        return false;
+    }
+
+    const qsizetype start = out.size();
+    out.resize(start + HEADER_SIZE + payloadSize);
+    uchar* cursor = reinterpret_cast<uchar*>(out.data()) + start;
+
+    // Header
+    qToLittleEndian<quint32>(FRAME_MAGIC, cursor);
+    cursor[4] = PROTOCOL_VERSION;
+    cursor[5] = 0;
+    qToLittleEndian<quint16>(HEADER_SIZE, cursor + 6);
+    qToLittleEndian<quint32>(static_cast<quint32>(payloadSize), cursor + 8);
+    qToLittleEndian<quint32>(sequence, cursor + 12);
+    qToLittleEndian<qint64>(frame.timestamp, cursor + 16);
+    qToLittleEndian<quint32>(waveformMask, cursor + 24);
+    qToLittleEndian<quint32>(parameterMask, cursor + 28);
+    cursor += HEADER_SIZE;
+
+    // Waveform channels
+    for (int id = 0; id < MASK_BITS; ++id) {
+        const int index = channelIndex[id];
+        if (index < 0) {
+            continue;
+        }
+        const int count = frame.channels[index].count;
+        qToLittleEndian<quint16>(static_cast<quint16>(count), cursor);
+        cursor[2] = static_cast<quint8>(encoding);
+        cursor[3] = 0;
+        cursor += CHANNEL_HEADER_SIZE;
+
+        if (encoding == SampleEncoding::Int16) {
+            packInt16(frame.ChannelData(index), count, cursor);
+            cursor += INT16_SCALING_SIZE;
+        } else {
+            packFloat16(frame.ChannelData(index), count, cursor);
+        }
+        cursor += 2 * count;
+    }
+
+    // Parameter values
+    for (int id = 0; id < MASK_BITS; ++id) {
+        const int index = parameterIndex[id];
+        if (index >= 0) {
+            qToLittleEndian<float>(frame.parameters[index].value, cursor);
+            cursor += PARAMETER_SIZE;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file network_frame_codec.h
+ * @brief Definition of the NetworkFrameCodec class
+ *
+ * This file contains the definition of the NetworkFrameCodec class which
+ * encodes and decodes the compact binary frames used to stream bedside data
+ * over the network. A frame carries one DataFrame: a fixed header with a
+ * sequence number, timestamp and channel masks, followed by the packed samples
+ * of every waveform channel in the mask and the values of every parameter in
+ * the mask.
+ *
+ * Wire layout, all fields little-endian:
+ *
+ * | Offset | Size | Field                                        |
+ * |--------|------|----------------------------------------------|
+ * | 0      | 4    | Magic "VSYN"                                 |
+ * | 4      | 1    | Protocol version                             |
+ * | 5      | 1    | Flags, reserved (0)                          |
+ * | 6      | 2    | Header size in bytes (32 for version 1)      |
+ * | 8      | 4    | Payload size in bytes                        |
+ * | 12     | 4    | Sequence number                              |
+ * | 16     | 8    | Timestamp in milliseconds since the epoch    |
+ * | 24     | 4    | Waveform mask, bit n = WaveformType n        |
+ * | 28     | 4    | Parameter mask, bit n = ParameterType n      |
+ *
+ * The payload holds one block per waveform bit in ascending order, made of a
+ * sample count (u16), a SampleEncoding (u8), a reserved byte, for Int16 a
+ * scale and offset (f32 each), and the samples. It ends with one f32 per
+ * parameter bit in ascending order.
+ */
+#ifndef NETWORK_FRAME_CODEC_H
+#define NETWORK_FRAME_CODEC_H
+
+#include "../../include/data_frame.h"
+#include <QByteArray>
+#include <QtGlobal>
+
+/**
+ * @brief Encoder and decoder of the network frame format
+ *
+ * Decoding writes the samples of all channels straight into the planar sample
+ * block of a caller-owned DataFrame, so a receiver that reuses one frame does
+ * not allocate per frame or per channel.
+ */
+class NetworkFrameCodec {
+public:
+    static constexpr quint32 FRAME_MAGIC = 0x4E595356;      ///< "VSYN" read as a little-endian u32
+    static constexpr quint8 PROTOCOL_VERSION = 1;           ///< Current protocol version
+    static constexpr int HEADER_SIZE = 32;                  ///< Size of the version 1 header in bytes
+    static constexpr quint32 MAX_PAYLOAD_SIZE = 1u << 20;   ///< Largest accepted payload, guards against garbage lengths
+    static constexpr int MAX_CHANNEL_SAMPLES = 0xFFFF;      ///< Largest number of samples per channel in one frame
+
+    /**
+     * @brief Packing of the samples of one channel
+     */
+    enum class SampleEncoding : quint8 {
+        Int16 = 0,      ///< Signed 16-bit integers with a per-channel scale and offset
+        Float16 = 1     ///< IEEE 754 half precision floats
+    };
+
+    /**
+     * @brief Result of decoding the start of a buffer
+     */
+    enum class DecodeStatus {
+        Frame,          ///< A complete frame was decoded
+        Incomplete,     ///< The buffer holds the start of a frame but not all of it
+        Invalid         ///< The buffer does not start with a valid frame
+    };
+
+    /**
+     * @brief Decode the frame at the start of a buffer
+     * @param data Received bytes
+     * @param size Number of received bytes
+     * @param frame Frame to decode into; untouched unless a frame is decoded, capacity is kept
+     * @param sequence Receives the sequence number of the frame
+     * @param consumed Receives the size of the frame in bytes
+     * @return Decode status; frame, sequence and consumed are only set for Frame
+     */
+    static DecodeStatus Decode(const char* data, qsizetype size, VitalSync::DataFrame& frame,
+                               quint32* sequence, qsizetype* consumed);
+
+    /**
+     * @brief Find the next frame start in a buffer
+     * @param data Received bytes
+     * @param size Number of received bytes
+     * @return Offset of the next magic number, or -1 if there is none
+     */
+    static qsizetype FindFrameStart(const char* data, qsizetype size);
+
+    /**
+     * @brief Encode a frame and append it to a buffer
+     * @param frame Frame to encode
+     * @param sequence Sequence number of the frame
+     * @param encoding Packing of the waveform samples
+     * @param out Buffer the encoded frame is appended to
+     * @return True if the frame could be encoded
+     *
+     * Channels and parameters whose type does not fit in the masks, duplicates
+     * and channels longer than MAX_CHANNEL_SAMPLES are rejected.
+     */
+    static bool Encode(const VitalSync::DataFrame& frame, quint32 sequence,
+                       SampleEncoding encoding, QByteArray& out);
+};
+
+#endif // NETWORK_FRAME_CODEC_H
@@ -0,0 +1,348 @@
+/**
+ * @file synthetic_load_generator.cpp
+ * @brief Implementation of the SyntheticLoadGenerator class
+ *
+ * This file implements the SyntheticLoadGenerator class: the one-cycle
+ * templates of every waveform type and their playback at an arbitrary
+ * sample rate.
+ */
+#include "synthetic_load_generator.h"
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @namespace Anonymous namespace for the waveform templates
+ * @brief Contains the one-cycle shapes the templates are sampled from
+ *
+ * The shapes follow the regular demo generators without their noise, wander
+ * and beat-to-beat variation, so load-test traces look like the demo traces.
+ */
+namespace {
+    const double EEG_CYCLE_SECONDS = 1.0;   ///< Length of the EEG template
+
+    /**
+     * @brief Gaussian bump inside a window around its center
+     * @param phase Position in the cycle
+     * @param amplitude Peak value
+     * @param center Position of the peak
+     * @param width Half width of the window; the bump's scale is half of it
+     * @return Value of the bump, 0 outside the window
+     */
+    double wave(double phase, double amplitude, double center, double width)
+    {
+        if (phase <= center - width || phase >= center + width) {
+            return 0.0;
+        }
+        const double x = (phase - center) / (width / 2.0);
+        return amplitude * std::exp(-x * x);
+    }
+
+    /**
+     * @brief One ECG beat, the PQRST complex
+     * @param phase Position in the beat, 0 to 1
+     * @return Value in mV before the lead scale
+     */
+    double ecgBeat(double phase)
+    {
+        double value = 0.0;
+        value += wave(phase, 0.25 * 1.2, 0.16, 0.08);    // P
+        value += wave(phase, -0.1 * 1.3, 0.31, 0.03);    // Q
+        value += wave(phase, 1.0 * 1.4, 0.34, 0.05);     // R
+        value += wave(phase, -0.25 * 1.2, 0.37, 0.03);   // S
+        value += wave(phase, 0.35 * 1.3, 0.5, 0.1);      // T
+        return value * 2.2;
+    }
+
+    /**
+     * @brief Relative amplitude of an ECG lead
+     * @param type ECG lead
+     * @return Scale of the lead, with lead II as reference
+     */
+    double ecgLeadScale(VitalSync::WaveformType type)
+    {
+        switch (type) {
+            case VitalSync::WaveformType::ECG_I:
+                return 0.6;
+            case VitalSync::WaveformType::ECG_III:
+                return 0.45;
+            default:
+                return 1.0;
+        }
+    }
+
+    /**
+     * @brief One breath of the impedance respiration signal
+     * @param phase Position in the breath, 0 to 1
+     * @return Normalized value
+     */
+    double respirationBreath(double phase)
+    {
+        const double value = phase < 0.4 ? std::sin(phase * M_PI / 0.4)
+                                         : std::sin((phase - 0.4) * M_PI / 0.6 + M_PI);
+        return value * 0.5;
+    }
+
+    /**
+     * @brief One beat of the plethysmograph
+     * @param phase Position in the beat, 0 to 1
+     * @return Normalized value
+     */
+    double plethBeat(double phase)
+    {
+        double value = 0.0;
+        if (phase <= 0.35) {
+            // Systolic upstroke
+            const double x = (phase - 0.15) / 0.08;
+            value = 0.95 * std::exp(-x * x);
+        } else {
+            // Diastolic runoff
+            const double fall = 1.0 - std::pow((phase - 0.35) / 0.65, 0.7);
+            value = 0.4 * fall * fall;
+        }
+
+        // Dicrotic notch and wave
+        if (phase > 0.35 && phase < 0.5) {
+            value -= wave(phase, 0.2, 0.42, 0.06);
+            if (phase > 0.48 && phase < 0.56) {
+                const double x = (phase - 0.51) / 0.04;
+                value += 0.1 * std::exp(-x * x);
+            }
+        }
+        return value * 2.5;
+    }
+
+    /**
+     * @brief One beat of an invasive pressure
+     * @param phase Position in the beat, 0 to 1
+     * @param systolic Systolic pressure in mmHg
+     * @param diastolic Diastolic pressure in mmHg
+     * @return Pressure in mmHg
+     */
+    double pressureBeat(double phase, double systolic, double diastolic)
+    {
+        const double range = systolic - diastolic;
+        if (phase < 0.15) {
+            // Systolic upstroke
+            const double x = phase / 0.15;
+            return diastolic + range * std::pow(x, 1.8) * (3.0 - 2.0 * x);
+        }
+        if (phase < 0.2) {
+            // Systolic peak
+            return diastolic + range * (1.0 - 0.05 * (phase - 0.15) / 0.05);
+        }
+        if (phase < 0.3) {
+            // Initial decline
+            return diastolic + range * (1.0 - 0.8 * (phase - 0.2) / 0.1);
+        }
+        if (phase < 0.4) {
+            // Dicrotic notch and wave
+            const double x = (phase - 0.3) / 0.1;
+            const double base = diastolic + range * 0.2 * (1.0 - x);
+            return x < 0.5 ? base - range * 0.10 * std::sin(x / 0.5 * M_PI)
+                           : base + range * 0.08 * std::sin((x - 0.5) / 0.5 * M_PI);
+        }
+        // Diastolic decay
+        const double x = (phase - 0.4) / 0.6;
+        return diastolic + range * (1.0 - x) * (1.0 - x) * 0.28;
+    }
+
+    /**
+     * @brief One breath of the capnogram
+     * @param phase Position in the breath, 0 to 1
+     * @param etco2 End-tidal CO2 in mmHg
+     * @return Normalized value
+     */
+    double capnoBreath(double phase, double etco2)
+    {
+        const double maxCO2 = etco2 / 50.0;
+        double value = 0.0;
+        if (phase < 0.3) {
+            value = 0.0;
+        } else if (phase < 0.5) {
+            value = maxCO2 * (1.0 - std::exp(-5.0 * (phase - 0.3) / 0.2));
+        } else if (phase < 0.8) {
+            const double x = (phase - 0.5) / 0.3;
+            value = maxCO2 * (1.0 + 0.05 * x + 0.02 * std::sin(x * 3.0 * M_PI));
+        } else if (phase < 0.9) {
+            value = maxCO2 * 1.05 * std::exp(-3.0 * (phase - 0.8) / 0.1);
+        }
+        return value * 1.5;
+    }
+
+    /**
+     * @brief One second of EEG: alpha with some theta and beta
+     * @param phase Position in the second, 0 to 1
+     * @return Value in μV
+     */
+    double eegSecond(double phase)
+    {
+        return 20.0 * std::sin(2.0 * M_PI * 10.0 * phase)
+             + 10.0 * std::sin(2.0 * M_PI * 4.0 * phase + 0.5)
+             + 5.0 * std::sin(2.0 * M_PI * 22.0 * phase + 1.3);
+    }
+}
+
+/**
+ * @brief Constructor
+ * @param settings Signal settings; rates and counts are clamped to the supported ranges
+ *
+ * Builds the templates of all channels in use.
+ */
+SyntheticLoadGenerator::SyntheticLoadGenerator(const Settings& settings)
+    : settings_(settings)
+{
+    settings_.sampleRate = qBound(MIN_SAMPLE_RATE, settings_.sampleRate, MAX_SAMPLE_RATE);
+    settings_.channels = qBound(1, settings_.channels, VitalSync::WAVEFORM_TYPE_COUNT);
+    settings_.heartRate = qBound(20.0, settings_.heartRate, 300.0);
+    settings_.respirationRate = qBound(2.0, settings_.respirationRate, 60.0);
+
+    channels_.resize(static_cast<size_t>(settings_.channels));
+    for (int i = 0; i < settings_.channels; ++i) {
+        const VitalSync::WaveformType type = VitalSync::WAVEFORM_TYPES[static_cast<size_t>(i)];
+        templates_[static_cast<size_t>(i)] = buildTemplate(type);
+
+        Channel& channel = channels_[static_cast<size_t>(i)];
+        channel.waveformId = static_cast<int>(type);
+        channel.table = templates_[static_cast<size_t>(i)].data();
+        channel.phaseStep = 1.0 / (cycleSeconds(type) * settings_.sampleRate);
+    }
+}
+
+/**
+ * @brief Restarts the sample clock
+ * @param startTimestamp Timestamp in milliseconds of the next sample
+ */
+void SyntheticLoadGenerator::Reset(qint64 startTimestamp)
+{
+    start_timestamp_ = startTimestamp;
+    generated_ = 0;
+}
+
+/**
+ * @brief Gets the number of samples per channel due after some time
+ * @param elapsedMs Time since Reset() in milliseconds
+ * @return Samples per channel that should have been generated by then,
+ *         minus those already generated
+ */
+qint64 SyntheticLoadGenerator::GetDueSamples(qint64 elapsedMs) const
+{
+    return std::max<qint64>(0, elapsedMs * settings_.sampleRate / 1000 - generated_);
+}
+
+/**
+ * @brief Skips samples without generating them
+ * @param samples Samples per channel to skip
+ */
+void SyntheticLoadGenerator::Skip(qint64 samples)
+{
+    if (samples <= 0) {
+        return;
+    }
+
+    for (Channel& channel : channels_) {
+        channel.phase = std::fmod(channel.phase + channel.phaseStep * static_cast<double>(samples), 1.0);
+    }
+    generated_ += samples;
+}
+
+/**
+ * @brief Fills a frame with the next samples of every channel
+ * @param frame Frame to fill; it is cleared first
+ * @param samplesPerChannel Number of samples per channel
+ *
+ * The frame's timestamp is that of its first sample, derived from the number
+ * of samples generated since Reset(). Every channel carries the generator's
+ * sample rate.
+ */
+void SyntheticLoadGenerator::FillFrame(VitalSync::DataFrame& frame, int samplesPerChannel)
+{
+    frame.clear();
+    frame.timestamp = start_timestamp_ + generated_ * 1000 / settings_.sampleRate;
+    if (samplesPerChannel <= 0) {
+        return;
+    }
+
+    frame.channels.reserve(settings_.channels);
+    frame.samples.reserve(static_cast<qsizetype>(settings_.channels) * samplesPerChannel);
+    for (Channel& channel : channels_) {
+        float* out = frame.AppendChannel(channel.waveformId, samplesPerChannel, static_cast<float>(settings_.sampleRate));
+        double phase = channel.phase;
+        for (int i = 0; i < samplesPerChannel; ++i) {
+            // Linear interpolation between the two nearest template points
+            const double position = phase * TEMPLATE_POINTS;
+            const int index = std::min(static_cast<int>(position), TEMPLATE_POINTS - 1);
+            const float fraction = static_cast<float>(position - index);
+            out[i] = channel.table[index] + fraction * (channel.table[index + 1] - channel.table[index]);
+
+            phase += channel.phaseStep;
+            if (phase >= 1.0) {
+                phase -= 1.0;
+            }
+        }
+        channel.phase = phase;
+    }
+    generated_ += samplesPerChannel;
+}
+
+/**
+ * @brief Builds the template of a waveform type
+ * @param type Waveform type
+ * @return Template values, TEMPLATE_POINTS + 1 samples
+ */
+std::vector<float> SyntheticLoadGenerator::buildTemplate(VitalSync::WaveformType type) const
+{
+    std::vector<float> table(TEMPLATE_POINTS + 1);
+    for (int i = 0; i < TEMPLATE_POINTS; ++i) {
+        const double phase = static_cast<double>(i) / TEMPLATE_POINTS;
+        double value = 0.0;
+        switch (type) {
+            case VitalSync::WaveformType::ECG_I:
+            case VitalSync::WaveformType::ECG_II:
+            case VitalSync::WaveformType::ECG_III:
+                value = ecgBeat(phase) * ecgLeadScale(type);
+                break;
+            case VitalSync::WaveformType::RESP:
+                value = respirationBreath(phase);
+                break;
+            case VitalSync::WaveformType::PLETH:
+                value = plethBeat(phase) * settings_.spo2 / 100.0;
+                break;
+            case VitalSync::WaveformType::ABP:
+                value = pressureBeat(phase, settings_.systolic, settings_.diastolic) * 1.5 / 100.0;
+                break;
+            case VitalSync::WaveformType::CVP:
+                value = pressureBeat(phase, settings_.cvpSystolic, settings_.cvpDiastolic) * 1.5 / 100.0;
+                break;
+            case VitalSync::WaveformType::CAPNO:
+                value = capnoBreath(phase, settings_.etco2);
+                break;
+            case VitalSync::WaveformType::EEG:
+                value = eegSecond(phase);
+                break;
+        }
+        table[static_cast<size_t>(i)] = static_cast<float>(value * settings_.amplitude);
+    }
+
+    // The cycle wraps, so the last interpolation interval ends at the first point
+    table[TEMPLATE_POINTS] = table[0];
+    return table;
+}
+
+/**
+ * @brief Gets the length of a waveform type's template cycle
+ * @param type Waveform type
+ * @return Seconds per cycle
+ */
+double SyntheticLoadGenerator::cycleSeconds(VitalSync::WaveformType type) const
+{
+    switch (type) {
+        case VitalSync::WaveformType::RESP:
+        case VitalSync::WaveformType::CAPNO:
+            return 60.0 / settings_.respirationRate;
+        case VitalSync::WaveformType::EEG:
+            return EEG_CYCLE_SECONDS;
+        default:
+            return 60.0 / settings_.heartRate;
+    }
+}
@@ -0,0 +1,156 @@
+/**
+ * @file synthetic_load_generator.h
+ * @brief Definition of the SyntheticLoadGenerator class
+ *
+ * This file contains the definition of the SyntheticLoadGenerator class, which
+ * produces waveform frames at clinical sample rates for load testing. Every
+ * channel replays a precomputed one-cycle template, so generating a sample is
+ * a table lookup and an interpolation instead of the per-sample shape math of
+ * the regular demo generators.
+ */
+#ifndef SYNTHETIC_LOAD_GENERATOR_H
+#define SYNTHETIC_LOAD_GENERATOR_H
+
+#include "../../include/data_frame.h"
+#include "../../include/vital_sync_types.h"
+#include <QtGlobal>
+#include <array>
+#include <vector>
+
+/**
+ * @brief Template-replay waveform source for load tests
+ *
+ * Channels are the first GetChannelCount() waveform types in index order.
+ * Each has a template of TEMPLATE_POINTS samples covering one heart beat,
+ * one breath or, for EEG, one second, built once from the vital signs in the
+ * settings. Playback advances a phase per channel, so any sample rate can be
+ * produced from the same tables.
+ *
+ * Timestamps come from the sample counter rather than the wall clock: the
+ * first sample of a frame is stamped with the start timestamp plus the exact
+ * time of all samples generated before it, so chunks line up without gaps or
+ * jitter however the calls are scheduled.
+ *
+ * The generator is not thread-safe; the provider that owns it serializes the
+ * calls.
+ */
+class SyntheticLoadGenerator {
+public:
+    static constexpr int TEMPLATE_POINTS = 1024;        ///< Samples per template cycle
+    static constexpr int MIN_SAMPLE_RATE = 50;          ///< Lowest supported sample rate in Hz
+    static constexpr int MAX_SAMPLE_RATE = 4000;        ///< Highest supported sample rate in Hz
+
+    /**
+     * @brief Signal settings the templates are built from
+     */
+    struct Settings {
+        int sampleRate = 500;                                   ///< Samples per second of every channel
+        int channels = VitalSync::WAVEFORM_TYPE_COUNT;          ///< Number of channels
+        double heartRate = 70.0;                                ///< Beats per minute of the cardiac channels
+        double respirationRate = 15.0;                          ///< Breaths per minute of the respiratory channels
+        double systolic = 120.0;                                ///< Arterial systolic pressure in mmHg
+        double diastolic = 80.0;                                ///< Arterial diastolic pressure in mmHg
+        double cvpSystolic = 15.0;                              ///< Central venous systolic pressure in mmHg
+        double cvpDiastolic = 5.0;                              ///< Central venous diastolic pressure in mmHg
+        double etco2 = 35.0;                                    ///< End-tidal CO2 in mmHg
+        double spo2 = 98.0;                                     ///< SpO2 in percent, scales the pleth amplitude
+        double amplitude = 1.0;                                 ///< Overall amplitude factor
+    };
+
+    /**
+     * @brief Constructor
+     * @param settings Signal settings; rates and counts are clamped to the supported ranges
+     */
+    explicit SyntheticLoadGenerator(const Settings& settings);
+
+    SyntheticLoadGenerator(const SyntheticLoadGenerator&) = delete;
+    SyntheticLoadGenerator& operator=(const SyntheticLoadGenerator&) = delete;
+
+    /**
+     * @brief Get the settings in use
+     * @return Settings after clamping
+     */
+    const Settings& GetSettings() const { return settings_; }
+
+    /**
+     * @brief Get the number of channels
+     * @return Number of channels of every frame
+     */
+    int GetChannelCount() const { return settings_.channels; }
+
+    /**
+     * @brief Get the sample rate
+     * @return Samples per second of every channel
+     */
+    int GetSampleRate() const { return settings_.sampleRate; }
+
+    /**
+     * @brief Restart the sample clock
+     * @param startTimestamp Timestamp in milliseconds of the next sample
+     */
+    void Reset(qint64 startTimestamp);
+
+    /**
+     * @brief Get the number of samples generated per channel since Reset()
+     * @return Samples per channel
+     */
+    qint64 GetGeneratedSamples() const { return generated_; }
+
+    /**
+     * @brief Get the number of samples per channel due after some time
+     * @param elapsedMs Time since Reset() in milliseconds
+     * @return Samples per channel that should have been generated by then,
+     *         minus those already generated
+     */
+    qint64 GetDueSamples(qint64 elapsedMs) const;
+
+    /**
+     * @brief Skip samples without generating them
+     * @param samples Samples per channel to skip
+     *
+     * Used to drop a backlog after a stall; the timestamps of later frames
+     * still reflect the time that passed.
+     */
+    void Skip(qint64 samples);
+
+    /**
+     * @brief Fill a frame with the next samples of every channel
+     * @param frame Frame to fill; it is cleared first
+     * @param samplesPerChannel Number of samples per channel
+     */
+    void FillFrame(VitalSync::DataFrame& frame, int samplesPerChannel);
+
+private:
+    /**
+     * @brief Playback state of one channel
+     */
+    struct Channel {
+        int waveformId = 0;             ///< VitalSync::WaveformType of the channel
+        const float* table = nullptr;   ///< Template, TEMPLATE_POINTS + 1 samples with the first repeated at the end
+        double phase = 0.0;             ///< Position in the cycle, 0 to 1
+        double phaseStep = 0.0;         ///< Phase advance per sample
+    };
+
+    /**
+     * @brief Build the template of a waveform type
+     * @param type Waveform type
+     * @return Template values, TEMPLATE_POINTS + 1 samples
+     */
+    std::vector<float> buildTemplate(VitalSync::WaveformType type) const;
+
+    /**
+     * @brief Get the length of a waveform type's template cycle
+     * @param type Waveform type
+     * @return Seconds per cycle
+     */
+    double cycleSeconds(VitalSync::WaveformType type) const;
+
+private:
+    Settings settings_;                                                         ///< Settings after clamping
+    std::array<std::vector<float>, VitalSync::WAVEFORM_TYPE_COUNT> templates_;  ///< Templates of the channels in use
+    std::vector<Channel> channels_;                                             ///< Playback state per channel
+    qint64 start_timestamp_ = 0;                                                ///< Timestamp of the first sample after Reset()
+    qint64 generated_ = 0;                                                      ///< Samples per channel since Reset()
+};
+
+#endif // SYNTHETIC_LOAD_GENERATOR_H
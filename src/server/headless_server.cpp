@@ -0,0 +1,215 @@
+/**
+ * @file headless_server.cpp
+ * @brief Implementation of the HeadlessServer class
+ *
+ * This file implements the HeadlessServer class, which creates the beds of a
+ * gateway or recording node and runs them without a user interface.
+ */
+#include "headless_server.h"
+#include "../core/bed_manager.h"
+#include "../../include/config_manager.h"
+#include "../../include/vital_sync_types.h"
+#include "../utils/log_categories.h"
+#include "../utils/metrics.h"
+#include "../utils/metrics_reporter.h"
+
+#include <QDateTime>
+#include <QDir>
+
+/**
+ * @namespace Anonymous namespace for helpers
+ * @brief Contains helpers used by the HeadlessServer implementation
+ */
+namespace {
+    /**
+     * @brief Gets the name of an alarm state for the log
+     * @param state Alarm state
+     * @return Name
+     */
+    QString alarmStateName(IParameterModel::AlarmState state)
+    {
+        switch (state) {
+            case IParameterModel::AlarmState::Normal:       return QStringLiteral("normal");
+            case IParameterModel::AlarmState::HighWarning:  return QStringLiteral("high warning");
+            case IParameterModel::AlarmState::HighCritical: return QStringLiteral("high critical");
+            case IParameterModel::AlarmState::LowWarning:   return QStringLiteral("low warning");
+            case IParameterModel::AlarmState::LowCritical:  return QStringLiteral("low critical");
+            case IParameterModel::AlarmState::Technical:    return QStringLiteral("technical");
+            default:                                        return QStringLiteral("unknown");
+        }
+    }
+}
+
+/**
+ * @brief Constructs the server
+ * @param parent Parent QObject
+ *
+ * Nothing runs until Start() is called.
+ */
+HeadlessServer::HeadlessServer(QObject* parent)
+    : QObject(parent)
+    , bed_manager_(nullptr)
+    , metrics_reporter_(new MetricsReporter(this))
+{
+}
+
+/**
+ * @brief Destroys the server
+ *
+ * Stops the server if it is still running.
+ */
+HeadlessServer::~HeadlessServer()
+{
+    Stop();
+}
+
+/**
+ * @brief Creates the beds and starts acquisition, recording and streaming
+ * @param options What to run
+ * @return True if at least one bed is acquiring
+ *
+ * The beds are initialized in parallel. A bed that cannot be configured is
+ * removed again and the others still run; the acquisition threads are tuned
+ * before acquisition starts, so the first frame already arrives on the
+ * pinned processors.
+ */
+bool HeadlessServer::Start(const Options& options)
+{
+    Stop();
+
+    if (options.bedIds.isEmpty()) {
+        qCWarning(lcServer) << "No beds to run";
+        return false;
+    }
+
+    Metrics::SetEnabled(ConfigManager::GetInstance().GetBool("metrics/enabled", true));
+    metrics_reporter_->Start(ConfigManager::GetInstance().GetInt("metrics/reportIntervalSec", 60) * 1000);
+
+    bed_manager_ = new BedManager(this);
+    connect(bed_manager_, &BedManager::bedAlarmsChanged, this, &HeadlessServer::HandleBedAlarmsChanged);
+    connect(bed_manager_, &BedManager::bedErrorOccurred, this, &HeadlessServer::HandleBedError);
+
+    bed_manager_->AddBeds(options.bedIds);
+    for (int i = 0; i < options.bedIds.size(); ++i) {
+        const QString& bedId = options.bedIds[i];
+        if (bed_manager_->GetBed(bedId) && !configureBed(bedId, i, options)) {
+            bed_manager_->RemoveBed(bedId);
+        }
+    }
+
+    if (!options.tuning.IsEmpty()) {
+        bed_manager_->SetAcquisitionThreadTuning(options.tuning);
+    }
+
+    const int started = bed_manager_->startAll();
+    qCInfo(lcServer) << "Acquiring" << started << "of" << options.bedIds.size() << "beds";
+    if (started == 0) {
+        Stop();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Stops acquisition, closes the recordings and disconnects all viewers
+ *
+ * Recordings are closed after acquisition stops, so they end with the last
+ * frame ingested.
+ */
+void HeadlessServer::Stop()
+{
+    if (!bed_manager_) {
+        return;
+    }
+
+    bed_manager_->stopAll();
+    for (const QString& bedId : bed_manager_->GetBedIds()) {
+        std::shared_ptr<IDataManager> bed = bed_manager_->GetBed(bedId);
+        bed->StopRecording();
+        bed->StopStreaming();
+    }
+
+    delete bed_manager_;
+    bed_manager_ = nullptr;
+    metrics_reporter_->Stop();
+    qCInfo(lcServer) << "Stopped";
+}
+
+/**
+ * @brief Checks if the server is running
+ * @return True between a successful Start() and Stop()
+ */
+bool HeadlessServer::IsRunning() const
+{
+    return bed_manager_ != nullptr;
+}
+
+/**
+ * @brief Logs the alarm state changes of a bed
+ * @param bedId Identifier of the bed
+ * @param events The alarm state changes of one frame of the bed
+ */
+void HeadlessServer::HandleBedAlarmsChanged(const QString& bedId, const QVector<AlarmEvent>& events)
+{
+    for (const AlarmEvent& event : events) {
+        qCInfo(lcServer).noquote() << QStringLiteral("Bed %1: %2 %3 -> %4 at %5 %6")
+                                          .arg(bedId,
+                                               GetParameterDisplayName(static_cast<ParameterType>(event.parameterId)),
+                                               alarmStateName(event.previousState),
+                                               alarmStateName(event.state))
+                                          .arg(event.value)
+                                          .arg(GetParameterUnit(static_cast<ParameterType>(event.parameterId)));
+    }
+}
+
+/**
+ * @brief Logs an error of a bed
+ * @param bedId Identifier of the bed
+ * @param errorCode Error code
+ * @param errorMessage Error message
+ */
+void HeadlessServer::HandleBedError(const QString& bedId, int errorCode, const QString& errorMessage)
+{
+    qCWarning(lcServer).noquote() << QStringLiteral("Bed %1: error %2: %3").arg(bedId).arg(errorCode).arg(errorMessage);
+}
+
+/**
+ * @brief Configures a bed that was just added
+ * @param bedId Identifier of the bed
+ * @param index Position of the bed in the options, for its stream port
+ * @param options What to run
+ * @return False if the bed cannot run as configured
+ *
+ * Bed i is served on the stream port plus i. Recordings are named after the
+ * bed and the time they were started.
+ */
+bool HeadlessServer::configureBed(const QString& bedId, int index, const Options& options)
+{
+    std::shared_ptr<IDataManager> bed = bed_manager_->GetBed(bedId);
+
+    if (!options.provider.isEmpty() && !bed->SetActiveProvider(options.provider.toStdString())) {
+        qCWarning(lcServer) << "Bed" << bedId << "has no provider" << options.provider;
+        return false;
+    }
+
+    if (options.streamPort >= 0) {
+        const int port = options.streamPort > 0 ? options.streamPort + index : 0;
+        if (port > 65535 || !bed->StartStreaming(static_cast<quint16>(port))) {
+            qCWarning(lcServer) << "Bed" << bedId << "cannot stream on port" << port;
+            return false;
+        }
+    }
+
+    if (!options.recordingDirectory.isEmpty()) {
+        const QString filePath = QDir(options.recordingDirectory).filePath(
+            QString("VitalSync_%1_%2.vsr").arg(bedId, QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss")));
+        if (!QDir().mkpath(options.recordingDirectory) || !bed->StartRecording(filePath)) {
+            qCWarning(lcServer) << "Bed" << bedId << "cannot record to" << filePath;
+            bed->StopStreaming();
+            return false;
+        }
+        qCInfo(lcServer) << "Recording bed" << bedId << "to" << filePath;
+    }
+
+    return true;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file headless_server.h
+ * @brief Definition of the HeadlessServer class
+ *
+ * This file contains the definition of the HeadlessServer class, which runs
+ * the ingest pipeline of a set of beds without any user interface: providers,
+ * alarm evaluation, recording and the fan-out stream server.
+ */
+#ifndef HEADLESS_SERVER_H
+#define HEADLESS_SERVER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "../../include/alarm_event.h"
+#include "../utils/thread_tuning.h"
+
+class BedManager;
+class MetricsReporter;
+
+/**
+ * @brief Ingest node for gateways and recording servers
+ *
+ * Every bed is a DataManager of a BedManager with its own acquisition
+ * thread, exactly as on a central station; only the views are missing.
+ * The models of a bed are built lazily and no view asks for them, so a
+ * headless bed only runs its provider, the derived-parameter stages, the
+ * alarm engine and whatever recording and streaming is configured.
+ *
+ * Alarm state changes and provider errors are written to the log in the
+ * "vitalsync.server" category.
+ */
+class HeadlessServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief What the server runs
+     */
+    struct Options {
+        QStringList bedIds;             ///< Beds to run
+        QString provider;               ///< Provider of every bed, empty for the default provider
+        int streamPort = -1;            ///< Port of the first bed, the others follow; 0 for free ports, -1 to not stream
+        QString recordingDirectory;     ///< Directory the beds are recorded to, empty to not record
+        ThreadTuning::Options tuning;   ///< Affinity and priority of the acquisition threads
+    };
+
+    /**
+     * @brief Constructor
+     * @param parent Parent QObject
+     */
+    explicit HeadlessServer(QObject* parent = nullptr);
+
+    /**
+     * @brief Destructor
+     *
+     * Stops the server if it is still running.
+     */
+    ~HeadlessServer() override;
+
+    /**
+     * @brief Create the beds and start acquisition, recording and streaming
+     * @param options What to run
+     * @return True if at least one bed is acquiring
+     */
+    bool Start(const Options& options);
+
+    /**
+     * @brief Stop acquisition, close the recordings and disconnect all viewers
+     */
+    void Stop();
+
+    /**
+     * @brief Check if the server is running
+     * @return True between a successful Start() and Stop()
+     */
+    bool IsRunning() const;
+
+private slots:
+    /**
+     * @brief Log the alarm state changes of a bed
+     * @param bedId Identifier of the bed
+     * @param events The alarm state changes of one frame of the bed
+     */
+    void HandleBedAlarmsChanged(const QString& bedId, const QVector<AlarmEvent>& events);
+
+    /**
+     * @brief Log an error of a bed
+     * @param bedId Identifier of the bed
+     * @param errorCode Error code
+     * @param errorMessage Error message
+     */
+    void HandleBedError(const QString& bedId, int errorCode, const QString& errorMessage);
+
+private:
+    /**
+     * @brief Configure a bed that was just added
+     * @param bedId Identifier of the bed
+     * @param index Position of the bed in the options, for its stream port
+     * @param options What to run
+     * @return False if the bed cannot run as configured
+     */
+    bool configureBed(const QString& bedId, int index, const Options& options);
+
+private:
+    BedManager* bed_manager_;               ///< Beds of the server, null while stopped
+    MetricsReporter* metrics_reporter_;     ///< Periodic metrics reports
+};
+
+#endif // HEADLESS_SERVER_H
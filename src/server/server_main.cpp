@@ -0,0 +1,162 @@
+/**
+ * @file server_main.cpp
+ * @brief Headless server entry point
+ *
+ * This file contains the entry point of VitalSyncServer, the ingest node
+ * without a user interface. It parses the command line, initializes the
+ * configuration manager, starts a HeadlessServer and runs the event loop
+ * until the process is asked to terminate.
+ *
+ * SIGINT and SIGTERM quit the event loop instead of killing the process, so
+ * the recordings are closed and the viewers disconnected before it exits.
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+
+#include "../../include/config_manager.h"
+#include "headless_server.h"
+#include "../utils/thread_tuning.h"
+
+#if defined(Q_OS_UNIX)
+#include <QSocketNotifier>
+#include <csignal>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @namespace Anonymous namespace for the termination signals
+ * @brief Contains the handling of SIGINT and SIGTERM
+ */
+namespace {
+#if defined(Q_OS_UNIX)
+    int signal_fds[2] = { -1, -1 };     ///< Socket pair the signal handler wakes the event loop through
+
+    /**
+     * @brief Forwards a termination signal to the event loop
+     * @param signal Signal number
+     *
+     * Only writes one byte, the one thing a handler may safely do here.
+     */
+    void handleTerminationSignal(int signal)
+    {
+        const char byte = static_cast<char>(signal);
+        [[maybe_unused]] const ssize_t written = ::write(signal_fds[0], &byte, sizeof(byte));
+    }
+
+    /**
+     * @brief Quits the application on SIGINT and SIGTERM
+     * @param app The application
+     */
+    void quitOnTerminationSignals(QCoreApplication& app)
+    {
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, signal_fds) != 0) {
+            qWarning() << "VitalSyncServer: Cannot watch for termination signals";
+            return;
+        }
+
+        auto* notifier = new QSocketNotifier(signal_fds[1], QSocketNotifier::Read, &app);
+        QObject::connect(notifier, &QSocketNotifier::activated, &app, [&app]() {
+            char byte = 0;
+            [[maybe_unused]] const ssize_t received = ::read(signal_fds[1], &byte, sizeof(byte));
+            app.quit();
+        });
+
+        struct sigaction action {};
+        action.sa_handler = handleTerminationSignal;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+    }
+#else
+    /**
+     * @brief Leaves termination to the platform's default handling
+     * @param app The application
+     */
+    void quitOnTerminationSignals(QCoreApplication& app)
+    {
+        Q_UNUSED(app);
+    }
+#endif
+}
+
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    // Set application information; the server keeps its own settings
+    QCoreApplication::setApplicationName("VitalSyncServer");
+    QCoreApplication::setOrganizationName("VitalSyncTech");
+    QCoreApplication::setOrganizationDomain("vitalsynctech.com");
+    QCoreApplication::setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Runs the VitalSync ingest pipeline without a user interface.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    const QCommandLineOption bedsOption({ "b", "beds" },
+        "Comma-separated identifiers of the beds to run.", "ids", "bed1");
+    const QCommandLineOption providerOption({ "p", "provider" },
+        "Provider of every bed, such as Demo, Network or File.", "name");
+    const QCommandLineOption streamOption({ "s", "stream-port" },
+        "Serve bed i to remote viewers on <port> + i; 0 picks free ports.", "port");
+    const QCommandLineOption recordOption({ "r", "record-dir" },
+        "Record every bed to a file in <directory>.", "directory");
+    const QCommandLineOption cpusOption("cpus",
+        "Pin the acquisition threads to processors such as 2,3 or 0-3.", "list");
+    const QCommandLineOption priorityOption("rt-priority",
+        "Run the acquisition threads with SCHED_FIFO <priority> (1-99).", "priority");
+    parser.addOptions({ bedsOption, providerOption, streamOption, recordOption, cpusOption, priorityOption });
+    parser.process(app);
+
+    HeadlessServer::Options options;
+    options.bedIds = parser.value(bedsOption).split(',', Qt::SkipEmptyParts);
+    for (QString& bedId : options.bedIds) {
+        bedId = bedId.trimmed();
+    }
+    options.provider = parser.value(providerOption);
+    options.recordingDirectory = parser.value(recordOption);
+
+    if (parser.isSet(streamOption)) {
+        bool ok = false;
+        options.streamPort = parser.value(streamOption).toInt(&ok);
+        if (!ok || options.streamPort < 0 || options.streamPort > 65535) {
+            qCritical() << "VitalSyncServer: Invalid stream port" << parser.value(streamOption);
+            return 1;
+        }
+    }
+    if (parser.isSet(cpusOption) && !ThreadTuning::ParseCpuList(parser.value(cpusOption), options.tuning.cpus)) {
+        qCritical() << "VitalSyncServer: Invalid processor list" << parser.value(cpusOption);
+        return 1;
+    }
+    if (parser.isSet(priorityOption)) {
+        bool ok = false;
+        options.tuning.realtimePriority = parser.value(priorityOption).toInt(&ok);
+        if (!ok || options.tuning.realtimePriority < 1 || options.tuning.realtimePriority > 99) {
+            qCritical() << "VitalSyncServer: Invalid real-time priority" << parser.value(priorityOption);
+            return 1;
+        }
+    }
+
+    // Initialize the configuration manager
+    if (!ConfigManager::GetInstance().Initialize(QCoreApplication::organizationName(), QCoreApplication::applicationName())) {
+        qCritical() << "VitalSyncServer: Cannot initialize the configuration";
+        return 1;
+    }
+
+    HeadlessServer server;
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, &server, &HeadlessServer::Stop);
+    quitOnTerminationSignals(app);
+
+    if (!server.Start(options)) {
+        return 1;
+    }
+
+    // Run the application
+    return app.exec();
+}
@@ -0,0 +1,367 @@
+/**
+ * @file bed_grid_view.cpp
+ * @brief Implementation of the BedGridView class
+ *
+ * This file implements the central station overview: one tile per bed with
+ * the bed's key waveforms and numerics, laid out in a grid.
+ */
+#include "bed_grid_view.h"
+#include "frame_scheduler.h"
+#include "quality_governor.h"
+#include "parameters/parameter_view.h"
+#include "../core/bed_manager.h"
+#include "../../include/vital_sync_types.h"
+#include <QFrame>
+#include <QGridLayout>
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QSignalBlocker>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @namespace Anonymous namespace for constants
+ * @brief Contains constants used by the BedGridView implementation
+ */
+namespace {
+    const int TILE_SPACING = 4;                 ///< Spacing between tiles in pixels
+    const int TILE_WAVEFORM_HEIGHT = 100;       ///< Minimum height of a tile waveform in pixels
+
+    /**
+     * @brief Waveforms shown on every tile
+     */
+    const VitalSync::WaveformType TILE_WAVEFORMS[] = {
+        VitalSync::WaveformType::ECG_II,
+        VitalSync::WaveformType::PLETH
+    };
+
+    /**
+     * @brief Parameters shown on every tile
+     */
+    const VitalSync::ParameterType TILE_PARAMETERS[] = {
+        VitalSync::ParameterType::HR,
+        VitalSync::ParameterType::SPO2,
+        VitalSync::ParameterType::NIBP_MAP
+    };
+}
+
+/**
+ * @brief Constructs the bed grid
+ * @param beds Beds to show
+ * @param scheduler Display clock driving the parameter views
+ * @param waveformViewFactory Creates the waveform views of each tile
+ * @param governor Rendering quality of the waveform views, nullptr for full quality
+ * @param parent Parent widget
+ *
+ * Creates tiles for the beds that already exist and follows the BedManager
+ * for beds added or removed later, and for their alarms.
+ */
+BedGridView::BedGridView(BedManager* beds, FrameScheduler* scheduler, WaveformViewFactory waveformViewFactory,
+                         QualityGovernor* governor, QWidget* parent)
+    : QWidget(parent)
+    , beds_(beds)
+    , scheduler_(scheduler)
+    , waveform_view_factory_(std::move(waveformViewFactory))
+    , governor_(governor)
+    , grid_layout_(new QGridLayout(this))
+    , sweep_speed_(VitalSync::DEFAULT_SWEEP_SPEED)
+    , grid_color_(Qt::darkGray)
+    , background_color_(Qt::black)
+{
+    grid_layout_->setContentsMargins(TILE_SPACING, TILE_SPACING, TILE_SPACING, TILE_SPACING);
+    grid_layout_->setSpacing(TILE_SPACING);
+
+    if (beds_) {
+        connect(beds_, &BedManager::bedAdded, this, &BedGridView::HandleBedAdded);
+        connect(beds_, &BedManager::bedRemoved, this, &BedGridView::HandleBedRemoved);
+        connect(beds_, &BedManager::bedAlarmsChanged, this, &BedGridView::HandleBedAlarmsChanged);
+    }
+    if (governor_) {
+        connect(governor_, &QualityGovernor::levelChanged, this, &BedGridView::HandleQualityChanged);
+    }
+    Rebuild();
+}
+
+/**
+ * @brief Destroys the bed grid
+ *
+ * The views are released before the tile frames that contain them.
+ */
+BedGridView::~BedGridView()
+{
+    const QStringList bedIds = tiles_.keys();
+    for (const QString& bedId : bedIds) {
+        removeTile(bedId);
+    }
+}
+
+/**
+ * @brief Applies display settings to all tiles
+ * @param sweepSpeed Sweep speed in mm per second
+ * @param gridColor Grid color of the waveform views
+ * @param backgroundColor Background color of all views
+ */
+void BedGridView::ApplyDisplaySettings(double sweepSpeed, const QColor& gridColor, const QColor& backgroundColor)
+{
+    sweep_speed_ = sweepSpeed;
+    grid_color_ = gridColor;
+    background_color_ = backgroundColor;
+
+    for (auto& tile : tiles_) {
+        applyDisplaySettings(tile);
+    }
+}
+
+/**
+ * @brief Recreates the tiles of all beds
+ */
+void BedGridView::Rebuild()
+{
+    const QStringList existing = tiles_.keys();
+    for (const QString& bedId : existing) {
+        removeTile(bedId);
+    }
+
+    if (beds_) {
+        for (const QString& bedId : beds_->GetBedIds()) {
+            addTile(bedId);
+        }
+    }
+    relayout();
+}
+
+/**
+ * @brief Adds the tile of a new bed
+ * @param bedId Identifier of the bed
+ */
+void BedGridView::HandleBedAdded(const QString& bedId)
+{
+    addTile(bedId);
+    relayout();
+}
+
+/**
+ * @brief Removes the tile of a removed bed
+ * @param bedId Identifier of the bed
+ */
+void BedGridView::HandleBedRemoved(const QString& bedId)
+{
+    removeTile(bedId);
+    relayout();
+}
+
+/**
+ * @brief Rechecks whether a bed is in alarm
+ * @param bedId Identifier of the bed
+ *
+ * The alarm states are read from the bed's parameter models rather than
+ * from the events, so a bed stays in alarm until its last parameter is
+ * back to normal.
+ */
+void BedGridView::HandleBedAlarmsChanged(const QString& bedId)
+{
+    auto it = tiles_.find(bedId);
+    if (it == tiles_.end()) {
+        return;
+    }
+
+    const bool alarming = isBedAlarming(bedId);
+    if (it.value().alarming != alarming) {
+        it.value().alarming = alarming;
+        applyRenderQuality(it.value());
+    }
+}
+
+/**
+ * @brief Applies a new rendering quality level to all tiles
+ */
+void BedGridView::HandleQualityChanged()
+{
+    for (auto& tile : tiles_) {
+        applyRenderQuality(tile);
+    }
+}
+
+/**
+ * @brief Creates the tile of a bed
+ * @param bedId Identifier of the bed
+ *
+ * A tile shows the bed name with a start/stop button, the tile waveforms
+ * and a row of numerics, all bound to the bed's own models.
+ */
+void BedGridView::addTile(const QString& bedId)
+{
+    std::shared_ptr<IDataManager> bed = beds_ ? beds_->GetBed(bedId) : nullptr;
+    if (!bed || tiles_.contains(bedId) || !waveform_view_factory_) {
+        return;
+    }
+
+    BedTile tile;
+    tile.frame = new QFrame(this);
+    tile.frame->setFrameShape(QFrame::Box);
+    QVBoxLayout* tileLayout = new QVBoxLayout(tile.frame);
+    tileLayout->setContentsMargins(2, 2, 2, 2);
+    tileLayout->setSpacing(1);
+
+    // Header with the bed name and its own start/stop control
+    QHBoxLayout* headerLayout = new QHBoxLayout();
+    QLabel* nameLabel = new QLabel(bedId, tile.frame);
+    QFont nameFont = nameLabel->font();
+    nameFont.setBold(true);
+    nameLabel->setFont(nameFont);
+    tile.start_stop_button = new QPushButton(tr("Start"), tile.frame);
+    tile.start_stop_button->setCheckable(true);
+    headerLayout->addWidget(nameLabel);
+    headerLayout->addStretch();
+    headerLayout->addWidget(tile.start_stop_button);
+    tileLayout->addLayout(headerLayout);
+
+    QPushButton* button = tile.start_stop_button;
+    connect(button, &QPushButton::toggled, this, [this, bedId, button](bool running) {
+        std::shared_ptr<IDataManager> bed = beds_ ? beds_->GetBed(bedId) : nullptr;
+        if (!bed) {
+            return;
+        }
+        if (running && !bed->startAcquisition()) {
+            qWarning() << "BedGridView: Failed to start bed" << bedId;
+            QSignalBlocker blocker(button);
+            button->setChecked(false);
+            return;
+        }
+        if (!running) {
+            bed->stopAcquisition();
+        }
+        button->setText(running ? tr("Stop") : tr("Start"));
+    });
+
+    // Waveforms
+    for (const auto type : TILE_WAVEFORMS) {
+        std::shared_ptr<IWaveformView> view = waveform_view_factory_();
+        if (!view) {
+            continue;
+        }
+        view->GetWidget()->setMinimumHeight(TILE_WAVEFORM_HEIGHT);
+        view->SetModel(bed->GetWaveformModel(static_cast<int>(type)));
+        tileLayout->addWidget(view->GetWidget(), 1);
+        tile.waveform_views.push_back(view);
+    }
+
+    // Numerics
+    QHBoxLayout* parameterLayout = new QHBoxLayout();
+    parameterLayout->setSpacing(1);
+    for (const auto type : TILE_PARAMETERS) {
+        auto view = std::make_shared<ParameterView>();
+        view->AttachToScheduler(scheduler_);
+        view->SetModel(bed->GetParameterModel(static_cast<int>(type)));
+        parameterLayout->addWidget(view->GetWidget());
+        tile.parameter_views.push_back(view);
+    }
+    tileLayout->addLayout(parameterLayout);
+
+    applyDisplaySettings(tile);
+    tile.alarming = isBedAlarming(bedId);
+    applyRenderQuality(tile);
+    tiles_.insert(bedId, tile);
+}
+
+/**
+ * @brief Destroys the tile of a bed
+ * @param bedId Identifier of the bed
+ *
+ * The views are owned by the tile's shared pointers, so they are released
+ * before the frame that parents them is deleted.
+ */
+void BedGridView::removeTile(const QString& bedId)
+{
+    auto it = tiles_.find(bedId);
+    if (it == tiles_.end()) {
+        return;
+    }
+
+    BedTile tile = it.value();
+    tiles_.erase(it);
+
+    grid_layout_->removeWidget(tile.frame);
+    tile.waveform_views.clear();
+    tile.parameter_views.clear();
+    delete tile.frame;
+}
+
+/**
+ * @brief Places all tiles on the grid in bed order
+ *
+ * Uses the smallest number of columns that keeps the grid at least as wide
+ * as it is tall.
+ */
+void BedGridView::relayout()
+{
+    for (auto& tile : tiles_) {
+        grid_layout_->removeWidget(tile.frame);
+    }
+
+    const QStringList bedIds = beds_ ? beds_->GetBedIds() : QStringList();
+    const int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(tiles_.size())))));
+
+    int index = 0;
+    for (const QString& bedId : bedIds) {
+        auto it = tiles_.find(bedId);
+        if (it == tiles_.end()) {
+            continue;
+        }
+        grid_layout_->addWidget(it.value().frame, index / columns, index % columns);
+        ++index;
+    }
+}
+
+/**
+ * @brief Applies the current display settings to one tile
+ * @param tile The tile
+ */
+void BedGridView::applyDisplaySettings(BedTile& tile)
+{
+    for (auto& view : tile.waveform_views) {
+        view->SetSweepSpeed(sweep_speed_);
+        view->SetGridColor(grid_color_);
+        view->SetBackgroundColor(background_color_);
+    }
+    for (auto& view : tile.parameter_views) {
+        view->SetBackgroundColor(background_color_);
+        view->SetTextColor(Qt::white);
+    }
+}
+
+/**
+ * @brief Applies the governor's rendering quality to one tile
+ * @param tile The tile
+ */
+void BedGridView::applyRenderQuality(BedTile& tile)
+{
+    const IWaveformView::RenderQuality quality =
+        governor_ ? governor_->GetRenderQuality(true, tile.alarming) : IWaveformView::RenderQuality();
+    for (auto& view : tile.waveform_views) {
+        view->SetRenderQuality(quality);
+    }
+}
+
+/**
+ * @brief Checks whether a bed has a parameter in an alarm state
+ * @param bedId Identifier of the bed
+ * @return True if any parameter model of the bed is not Normal
+ */
+bool BedGridView::isBedAlarming(const QString& bedId) const
+{
+    std::shared_ptr<IDataManager> bed = beds_ ? beds_->GetBed(bedId) : nullptr;
+    if (!bed) {
+        return false;
+    }
+
+    for (const auto& model : bed->GetAllParameterModels()) {
+        if (model && model->GetAlarmState() != IParameterModel::AlarmState::Normal) {
+            return true;
+        }
+    }
+    return false;
+}
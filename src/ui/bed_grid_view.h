@@ -0,0 +1,164 @@
+/**
+ * @file bed_grid_view.h
+ * @brief Definition of the BedGridView class
+ *
+ * This file contains the definition of the BedGridView class, the central
+ * station overview. It lays out one compact tile per bed of a BedManager, each
+ * with the bed's key waveforms and numerics and its own start/stop control.
+ */
+#ifndef BED_GRID_VIEW_H
+#define BED_GRID_VIEW_H
+
+#include <QWidget>
+#include <QMap>
+#include <QColor>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "../../include/i_waveform_view.h"
+#include "../../include/i_parameter_view.h"
+
+class BedManager;
+class FrameScheduler;
+class QualityGovernor;
+class QFrame;
+class QGridLayout;
+class QPushButton;
+
+/**
+ * @brief Grid of bed tiles for a central station
+ *
+ * Tiles are added and removed as beds come and go in the BedManager. The grid
+ * keeps roughly square, filling rows first. All views are driven by the shared
+ * FrameScheduler, so tiles scrolled out of sight cost no painting.
+ *
+ * Tiles count as background beds for the QualityGovernor. A tile whose bed
+ * has a parameter in an alarm state keeps full rendering quality.
+ */
+class BedGridView : public QWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Factory creating a waveform view with the configured renderer
+     */
+    using WaveformViewFactory = std::function<std::shared_ptr<IWaveformView>()>;
+
+    /**
+     * @brief Constructor
+     * @param beds Beds to show
+     * @param scheduler Display clock driving the parameter views
+     * @param waveformViewFactory Creates the waveform views of each tile
+     * @param governor Rendering quality of the waveform views, nullptr for full quality
+     * @param parent Parent widget
+     */
+    BedGridView(BedManager* beds, FrameScheduler* scheduler, WaveformViewFactory waveformViewFactory,
+                QualityGovernor* governor = nullptr, QWidget* parent = nullptr);
+
+    /**
+     * @brief Destructor
+     */
+    ~BedGridView() override;
+
+    /**
+     * @brief Apply display settings to all tiles
+     * @param sweepSpeed Sweep speed in mm per second
+     * @param gridColor Grid color of the waveform views
+     * @param backgroundColor Background color of all views
+     */
+    void ApplyDisplaySettings(double sweepSpeed, const QColor& gridColor, const QColor& backgroundColor);
+
+    /**
+     * @brief Recreate the tiles of all beds
+     *
+     * Used when the waveform renderer changes.
+     */
+    void Rebuild();
+
+private slots:
+    /**
+     * @brief Adds the tile of a new bed
+     * @param bedId Identifier of the bed
+     */
+    void HandleBedAdded(const QString& bedId);
+
+    /**
+     * @brief Removes the tile of a removed bed
+     * @param bedId Identifier of the bed
+     */
+    void HandleBedRemoved(const QString& bedId);
+
+    /**
+     * @brief Rechecks whether a bed is in alarm
+     * @param bedId Identifier of the bed
+     */
+    void HandleBedAlarmsChanged(const QString& bedId);
+
+    /**
+     * @brief Applies a new rendering quality level to all tiles
+     */
+    void HandleQualityChanged();
+
+private:
+    /**
+     * @brief View and controls of one bed
+     */
+    struct BedTile {
+        QFrame* frame = nullptr;                                    /**< Container of the tile */
+        QPushButton* start_stop_button = nullptr;                   /**< Starts or stops the bed */
+        std::vector<std::shared_ptr<IWaveformView>> waveform_views; /**< Waveform views of the tile */
+        std::vector<std::shared_ptr<IParameterView>> parameter_views; /**< Parameter views of the tile */
+        bool alarming = false;                                      /**< Whether a parameter of the bed is in an alarm state */
+    };
+
+    /**
+     * @brief Creates the tile of a bed
+     * @param bedId Identifier of the bed
+     */
+    void addTile(const QString& bedId);
+
+    /**
+     * @brief Destroys the tile of a bed
+     * @param bedId Identifier of the bed
+     */
+    void removeTile(const QString& bedId);
+
+    /**
+     * @brief Places all tiles on the grid in bed order
+     */
+    void relayout();
+
+    /**
+     * @brief Applies the current display settings to one tile
+     * @param tile The tile
+     */
+    void applyDisplaySettings(BedTile& tile);
+
+    /**
+     * @brief Applies the governor's rendering quality to one tile
+     * @param tile The tile
+     */
+    void applyRenderQuality(BedTile& tile);
+
+    /**
+     * @brief Checks whether a bed has a parameter in an alarm state
+     * @param bedId Identifier of the bed
+     * @return True if any parameter model of the bed is not Normal
+     */
+    bool isBedAlarming(const QString& bedId) const;
+
+private:
+    BedManager* beds_;                          ///< Beds shown by the grid
+    FrameScheduler* scheduler_;                 ///< Display clock driving the views
+    WaveformViewFactory waveform_view_factory_; ///< Creates the waveform views
+    QualityGovernor* governor_;                 ///< Rendering quality of the waveform views, may be nullptr
+    QGridLayout* grid_layout_;                  ///< Layout holding the tiles
+    QMap<QString, BedTile> tiles_;              ///< Tiles by bed identifier
+
+    double sweep_speed_;                        ///< Sweep speed of the waveform views
+    QColor grid_color_;                         ///< Grid color of the waveform views
+    QColor background_color_;                   ///< Background color of all views
+};
+
+#endif // BED_GRID_VIEW_H
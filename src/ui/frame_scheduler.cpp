@@ -0,0 +1,163 @@
+/**
+ * @file frame_scheduler.cpp
+ * @brief Implementation of the FrameScheduler class
+ *
+ * This file implements the shared display clock. The tick interval is derived
+ * from the refresh rate of the primary screen and follows it when it changes.
+ */
+#include "frame_scheduler.h"
+#include "../utils/metrics.h"
+#include <QGuiApplication>
+#include <QScreen>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @namespace Anonymous namespace for constants
+ * @brief Contains constants used by the FrameScheduler implementation
+ */
+namespace {
+    const double DEFAULT_REFRESH_RATE = 60.0;       ///< Refresh rate assumed when no screen reports one
+    const double DEFAULT_TARGET_FRAME_RATE = 60.0;  ///< Default highest frame rate
+}
+
+/**
+ * @brief Constructs a FrameScheduler
+ * @param parent The parent QObject
+ *
+ * The scheduler does not tick until Start() is called.
+ */
+FrameScheduler::FrameScheduler(QObject* parent)
+    : QObject(parent)
+    , timer_(this)
+    , screen_(QGuiApplication::primaryScreen())
+    , target_frame_rate_(DEFAULT_TARGET_FRAME_RATE)
+    , frame_time_(0)
+    , last_tick_us_(-1)
+    , last_interval_us_(0)
+{
+    clock_.start();
+
+    timer_.setTimerType(Qt::PreciseTimer);
+    connect(&timer_, &QTimer::timeout, this, &FrameScheduler::HandleTimeout);
+
+    if (screen_) {
+        connect(screen_, &QScreen::refreshRateChanged, this, &FrameScheduler::UpdateFrameInterval);
+    }
+    UpdateFrameInterval();
+}
+
+/**
+ * @brief Starts ticking
+ */
+void FrameScheduler::Start()
+{
+    if (!timer_.isActive()) {
+        timer_.start();
+    }
+}
+
+/**
+ * @brief Stops ticking
+ */
+void FrameScheduler::Stop()
+{
+    timer_.stop();
+    last_tick_us_ = -1;
+}
+
+/**
+ * @brief Checks if the scheduler is ticking
+ * @return True if running
+ */
+bool FrameScheduler::isRunning() const
+{
+    return timer_.isActive();
+}
+
+/**
+ * @brief Sets the highest frame rate the scheduler may tick at
+ * @param framesPerSecond Target frame rate
+ */
+void FrameScheduler::SetTargetFrameRate(double framesPerSecond)
+{
+    if (framesPerSecond <= 0.0) {
+        qWarning() << "FrameScheduler: Ignoring invalid target frame rate" << framesPerSecond;
+        return;
+    }
+
+    target_frame_rate_ = framesPerSecond;
+    UpdateFrameInterval();
+}
+
+/**
+ * @brief Gets the interval between two ticks
+ * @return Frame interval in milliseconds
+ */
+int FrameScheduler::GetFrameInterval() const
+{
+    return timer_.interval();
+}
+
+/**
+ * @brief Gets the time of the current frame
+ * @return Milliseconds since the scheduler was created
+ *
+ * All views handling the same tick see the same frame time.
+ */
+qint64 FrameScheduler::GetFrameTime() const
+{
+    return frame_time_;
+}
+
+/**
+ * @brief Gets the measured time since the previous tick
+ * @return Interval in microseconds, 0 for the first tick after Start()
+ */
+qint64 FrameScheduler::GetLastFrameInterval() const
+{
+    return last_interval_us_;
+}
+
+/**
+ * @brief Handles a timer tick and emits frameTick()
+ *
+ * The time since the previous tick is recorded in the frame interval
+ * histogram. A tick arrives late when the previous frame's work together
+ * with everything else on the GUI thread took longer than the interval.
+ */
+void FrameScheduler::HandleTimeout()
+{
+    const qint64 now = clock_.nsecsElapsed() / 1000;
+    last_interval_us_ = last_tick_us_ >= 0 ? now - last_tick_us_ : 0;
+    last_tick_us_ = now;
+    if (last_interval_us_ > 0) {
+        Metrics::Record(Metrics::Histogram::FrameInterval, last_interval_us_);
+    }
+
+    frame_time_ = now / 1000;
+    emit frameTick(frame_time_);
+}
+
+/**
+ * @brief Recomputes the frame interval from the screen refresh rate
+ *
+ * Uses the largest integer fraction of the refresh rate that does not exceed
+ * the target frame rate, so that ticks fall on every n-th refresh.
+ */
+void FrameScheduler::UpdateFrameInterval()
+{
+    double refreshRate = screen_ ? screen_->refreshRate() : 0.0;
+    if (refreshRate <= 0.0) {
+        refreshRate = DEFAULT_REFRESH_RATE;
+    }
+
+    const double divisor = std::max(1.0, std::ceil(refreshRate / target_frame_rate_ - 1e-6));
+    const int interval = std::max(1, static_cast<int>(std::lround(1000.0 * divisor / refreshRate)));
+
+    if (timer_.interval() != interval) {
+        timer_.setInterval(interval);
+        qDebug() << "FrameScheduler: Refresh rate" << refreshRate << "Hz, ticking every" << interval << "ms";
+    }
+}
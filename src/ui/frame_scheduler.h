@@ -0,0 +1,115 @@
+/**
+ * @file frame_scheduler.h
+ * @brief Definition of the FrameScheduler class
+ *
+ * This file contains the definition of the FrameScheduler class, the single
+ * display clock shared by all views of a window. Instead of every view running
+ * its own timers at unrelated intervals, views connect to the scheduler and do
+ * their per-frame work when it ticks, so all of them update in the same pass.
+ */
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+
+class QScreen;
+
+/**
+ * @brief Shared display clock for all views
+ *
+ * Ticks at the screen refresh rate, or at an integer fraction of it when a
+ * lower target frame rate is set, so that frames stay aligned with the display
+ * refresh as closely as a timer allows. Every tick emits frameTick() once; all
+ * views handle it back to back and only mark their dirty regions, which Qt
+ * then coalesces into a single repaint and flush of the window.
+ *
+ * Views are expected to skip ticks cheaply when they are paused, not visible,
+ * or their model has not changed since the previous frame. The actual time
+ * between ticks is recorded in the Metrics::Histogram::FrameInterval
+ * histogram; ticks arriving late mean that the GUI thread cannot keep up.
+ */
+class FrameScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor
+     * @param parent Parent QObject
+     */
+    explicit FrameScheduler(QObject* parent = nullptr);
+
+    /**
+     * @brief Start ticking
+     */
+    void Start();
+
+    /**
+     * @brief Stop ticking
+     */
+    void Stop();
+
+    /**
+     * @brief Check if the scheduler is ticking
+     * @return True if running
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Set the highest frame rate the scheduler may tick at
+     * @param framesPerSecond Target frame rate
+     *
+     * The effective rate is the screen refresh rate divided by the smallest
+     * integer that brings it to or below the target.
+     */
+    void SetTargetFrameRate(double framesPerSecond);
+
+    /**
+     * @brief Get the interval between two ticks
+     * @return Frame interval in milliseconds
+     */
+    int GetFrameInterval() const;
+
+    /**
+     * @brief Get the time of the current frame
+     * @return Milliseconds since the scheduler was created
+     */
+    qint64 GetFrameTime() const;
+
+    /**
+     * @brief Get the measured time since the previous tick
+     * @return Interval in microseconds, 0 for the first tick after Start()
+     */
+    qint64 GetLastFrameInterval() const;
+
+signals:
+    /**
+     * @brief Signal emitted once per frame
+     * @param frameTimeMs Monotonic frame time in milliseconds
+     */
+    void frameTick(qint64 frameTimeMs);
+
+private slots:
+    /**
+     * @brief Handles a timer tick and emits frameTick()
+     */
+    void HandleTimeout();
+
+    /**
+     * @brief Recomputes the frame interval from the screen refresh rate
+     */
+    void UpdateFrameInterval();
+
+private:
+    QTimer timer_;                    ///< Precise timer driving the frames
+    QElapsedTimer clock_;             ///< Monotonic time base
+    QScreen* screen_;                 ///< Screen whose refresh rate is followed
+    double target_frame_rate_;        ///< Highest allowed frame rate
+    qint64 frame_time_;               ///< Time of the current frame in milliseconds
+    qint64 last_tick_us_;             ///< Time of the previous tick in microseconds, -1 after Stop()
+    qint64 last_interval_us_;         ///< Measured time between the last two ticks in microseconds
+};
+
+#endif // FRAME_SCHEDULER_H
@@ -19,12 +19,26 @@
 #include <QMessageBox>
 #include <QCloseEvent>
 #include <QSplitter>
+#include <QSignalBlocker>
+#include <QDateTime>
+#include <QDir>
+#include <QStandardPaths>
 #include <QVariantMap>
 #include <QDebug>
+#include <QTimer>
 
 #include "../../include/config_manager.h"
 #include "../core/data_manager.h"
+#include "../core/bed_manager.h"
+#include "bed_grid_view.h"
+#include "frame_scheduler.h"
+#include "metrics_overlay.h"
+#include "quality_governor.h"
+#include "../utils/metrics.h"
+#include "../utils/metrics_reporter.h"
+#include "../utils/startup_profile.h"
 #include "waveforms/waveform_view.h"
+#include "waveforms/gl_waveform_view.h"
 #include "parameters/parameter_view.h"
 #include "settings_dialog.h"
 #include "provider_config_dialog.h"
@@ -38,6 +52,21 @@ namespace {
     const int DEFAULT_WINDOW_HEIGHT = 800;    /**< Default window height in pixels */
     const int PARAMETER_VIEW_WIDTH = 150;     /**< Default parameter view width in pixels */
     const int PARAMETER_VIEW_HEIGHT = 100;    /**< Default parameter view height in pixels */
+    const int DEFAULT_CENTRAL_STATION_BEDS = 16; /**< Default number of central station beds */
+    const int MAX_CENTRAL_STATION_BEDS = 64;  /**< Maximum number of central station beds */
+    const int DEFAULT_STREAMING_PORT = 5100;  /**< Default port of the stream server, next to the network provider's 5000 */
+
+    /**
+     * @brief Checks if a waveform gets a view on the patient display
+     * @param type Waveform type
+     * @return False if the waveform is configured inactive
+     *
+     * An inactive waveform gets no view, so its model is never built either.
+     */
+    bool isWaveformShown(VitalSync::WaveformType type)
+    {
+        return ConfigManager::GetInstance().GetWaveformConfig(type).value("active", true).toBool();
+    }
 }
 
 /**
@@ -50,6 +79,13 @@ namespace {
  */
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent)
+    , frame_scheduler_(new FrameScheduler(this))
+    , quality_governor_(new QualityGovernor(frame_scheduler_, this))
+    , bed_manager_(new BedManager(this))
+    , bed_grid_(nullptr)
+    , bed_grid_scroll_area_(nullptr)
+    , metrics_reporter_(new MetricsReporter(this))
+    , metrics_overlay_(nullptr)
     , is_acquiring_(false)
     , connection_status_(VitalSync::ConnectionStatus::Disconnected)
 {
@@ -58,18 +94,29 @@ MainWindow::MainWindow(QWidget* parent)
 
     // Set up the UI
     SetupUi();
+    StartupProfile::Mark("Main window layout");
     SetupWaveformViews();
     SetupParameterViews();
     connectSignals();
+    StartupProfile::Mark("Waveform and parameter views");
+    
+    // All views are driven by one display clock
+    frame_scheduler_->Start();
+    
+    // Metrics are recorded from the start and dumped to the log periodically
+    Metrics::SetEnabled(ConfigManager::GetInstance().GetBool("metrics/enabled", true));
+    metrics_reporter_->Start(ConfigManager::GetInstance().GetInt("metrics/reportIntervalSec", 60) * 1000);
     
     // Initialize with default settings
     ApplyDefaultSettings();
+    StartupProfile::Mark("Display settings and metrics");
     
     // Initialize the data manager
     if (!data_manager_->initialize()) {
         QMessageBox::critical(this, tr("Initialization Error"),
                             tr("Failed to initialize the data manager."));
     }
+    StartupProfile::Mark("Data manager and providers");
     
     // Populate provider selector with available providers
     std::vector<std::string> providers = data_manager_->GetAvailableProviders();
@@ -84,9 +131,16 @@ MainWindow::MainWindow(QWidget* parent)
         provider_selector_->setCurrentIndex(lastIndex);
     }
     
-    // Connect models to views
+    // Connect models to views, building the models the views show
     connectWaveformModels();
     connectParameterModels();
+    StartupProfile::Mark("Models of the shown channels");
+    
+    // Serve the primary bed to remote viewers if configured
+    if (ConfigManager::GetInstance().GetBool("streaming/enabled", false)) {
+        const int port = ConfigManager::GetInstance().GetInt("streaming/port", DEFAULT_STREAMING_PORT);
+        data_manager_->StartStreaming(static_cast<quint16>(qBound(0, port, 65535)));
+    }
     
     // Auto-start the demo provider
     if (providers.size() > 0) {
@@ -108,6 +162,13 @@ MainWindow::MainWindow(QWidget* parent)
     
     // Update connection status display
     UpdateConnectionStatus(connection_status_);
+    StartupProfile::Mark("Acquisition start");
+    
+    // A central station comes back up showing its beds
+    if (ConfigManager::GetInstance().GetBool("ui/startInCentralStation", false)) {
+        central_station_button_->setChecked(true);
+        StartupProfile::Mark("Central station");
+    }
 }
 
 /**
@@ -121,6 +182,11 @@ MainWindow::~MainWindow()
     if (is_acquiring_) {
         data_manager_->stopAcquisition();
     }
+    
+    // Release the bed views before the beds they display
+    delete bed_grid_scroll_area_;
+    bed_grid_scroll_area_ = nullptr;
+    bed_grid_ = nullptr;
 }
 
 /**
@@ -137,6 +203,8 @@ void MainWindow::closeEvent(QCloseEvent* event)
     if (is_acquiring_) {
         data_manager_->stopAcquisition();
     }
+    bed_manager_->stopAll();
+    data_manager_->StopRecording();
     
     // Save current configuration
     ConfigManager::GetInstance().save();
@@ -145,6 +213,22 @@ void MainWindow::closeEvent(QCloseEvent* event)
     event->accept();
 }
 
+/**
+ * @brief Handles window state changes
+ * 
+ * Re-applies the rendering quality when the window gains or loses the
+ * focus, since an inactive patient display is a background bed.
+ * 
+ * @param event The change event
+ */
+void MainWindow::changeEvent(QEvent* event)
+{
+    QMainWindow::changeEvent(event);
+    if (event->type() == QEvent::ActivationChange) {
+        applyRenderQuality();
+    }
+}
+
 /**
  * @brief Sets up the user interface components
  * 
@@ -183,11 +267,26 @@ void MainWindow::SetupUi()
     start_stop_button_ = new QPushButton(tr("Start"), this);
     controlBar->addWidget(start_stop_button_);
     
+    // Record button
+    record_button_ = new QPushButton(tr("Record"), this);
+    record_button_->setCheckable(true);
+    controlBar->addWidget(record_button_);
+    
     // Add spacer
     QWidget* spacer = new QWidget(this);
     spacer->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
     controlBar->addWidget(spacer);
     
+    // Central station button
+    central_station_button_ = new QPushButton(tr("Central Station"), this);
+    central_station_button_->setCheckable(true);
+    controlBar->addWidget(central_station_button_);
+    
+    // Metrics overlay button
+    metrics_button_ = new QPushButton(tr("Metrics"), this);
+    metrics_button_->setCheckable(true);
+    controlBar->addWidget(metrics_button_);
+    
     // Settings button
     settings_button_ = new QPushButton(tr("Settings"), this);
     controlBar->addWidget(settings_button_);
@@ -241,6 +340,9 @@ void MainWindow::SetupUi()
     // Set central widget
     setCentralWidget(centralWidget);
     
+    // The metrics overlay floats above the displays, hidden until requested
+    metrics_overlay_ = new MetricsOverlay(centralWidget);
+    
     // Store layout pointers for later use when adding views
     waveformContainer->setProperty("layout", QVariant::fromValue(waveformLayout));
     parameterContainer->setProperty("layout", QVariant::fromValue(parameterLayout));
@@ -251,6 +353,7 @@ void MainWindow::SetupUi()
  * 
  * Creates visualization components for each supported waveform type,
  * configures their initial appearance, and arranges them in the layout.
+ * Any existing views are replaced, so this is also used to switch renderers.
  */
 void MainWindow::SetupWaveformViews()
 {
@@ -261,6 +364,12 @@ void MainWindow::SetupWaveformViews()
     QWidget* waveformContainer = waveformScrollArea->widget();
     QVBoxLayout* waveformLayout = qobject_cast<QVBoxLayout*>(waveformContainer->layout());
     
+    // Remove the views of a previous renderer
+    for (auto& view : waveform_views_) {
+        waveformLayout->removeWidget(view->GetWidget());
+    }
+    waveform_views_.clear();
+    
     // Create waveform views for each waveform type we want to display
     // We'll use an array of waveform types we want to show
     const VitalSync::WaveformType waveformTypes[] = {
@@ -271,10 +380,14 @@ void MainWindow::SetupWaveformViews()
         VitalSync::WaveformType::CAPNO
     };
     
-    // Create a view for each waveform type
+    // Create a view for each waveform type that is shown
     for (const auto& type : waveformTypes) {
+        if (!isWaveformShown(type)) {
+            continue;
+        }
+        
         // Create waveform view
-        auto waveformView = std::make_shared<WaveformView>();
+        auto waveformView = createWaveformView();
         
         // Set initial properties
         QString displayName = VitalSync::GetWaveformDisplayName(type);
@@ -288,6 +401,25 @@ void MainWindow::SetupWaveformViews()
     }
 }
 
+/**
+ * @brief Creates a waveform view with the configured renderer
+ * @return The new waveform view, attached to the frame scheduler
+ */
+std::shared_ptr<IWaveformView> MainWindow::createWaveformView()
+{
+    const QString renderer = ConfigManager::GetInstance().GetString("ui/waveformRenderer", "raster");
+    
+    if (renderer == "opengl") {
+        auto view = std::make_shared<GLWaveformView>();
+        view->AttachToScheduler(frame_scheduler_);
+        return view;
+    }
+    
+    auto view = std::make_shared<WaveformView>();
+    view->AttachToScheduler(frame_scheduler_);
+    return view;
+}
+
 /**
  * @brief Sets up the parameter view components
  * 
@@ -323,6 +455,7 @@ void MainWindow::SetupParameterViews()
         
         // Create parameter view
         auto parameterView = std::make_shared<ParameterView>();
+        parameterView->AttachToScheduler(frame_scheduler_);
         
         // Add to layout
         int row = i / numColumns;
@@ -349,6 +482,9 @@ void MainWindow::connectSignals()
     connect(start_stop_button_, &QPushButton::clicked, this, &MainWindow::OnStartStopButtonClicked);
     connect(configure_button_, &QPushButton::clicked, this, &MainWindow::OnConfigureProviderClicked);
     connect(settings_button_, &QPushButton::clicked, this, &MainWindow::OnSettingsButtonClicked);
+    connect(central_station_button_, &QPushButton::toggled, this, &MainWindow::OnCentralStationToggled);
+    connect(record_button_, &QPushButton::toggled, this, &MainWindow::OnRecordToggled);
+    connect(metrics_button_, &QPushButton::toggled, metrics_overlay_, &QWidget::setVisible);
     connect(provider_selector_, QOverload<int>::of(&QComboBox::currentIndexChanged), 
             this, &MainWindow::OnProviderSelectionChanged);
     
@@ -357,6 +493,10 @@ void MainWindow::connectSignals()
             this, &MainWindow::OnConnectionStatusChanged);
     connect(data_manager_.get(), &IDataManager::errorOccurred, 
             this, &MainWindow::OnErrorOccurred);
+    
+    // Degrade and restore the rendering with the load and the alarms
+    connect(quality_governor_, &QualityGovernor::levelChanged, this, &MainWindow::applyRenderQuality);
+    connect(data_manager_.get(), &IDataManager::alarmsChanged, this, &MainWindow::applyRenderQuality);
 }
 
 /**
@@ -599,39 +739,150 @@ void MainWindow::OnConfigureProviderClicked()
  */
 void MainWindow::OnSettingsButtonClicked()
 {
+    ConfigManager& config = ConfigManager::GetInstance();
+    const QString renderer = config.GetString("ui/waveformRenderer", "raster");
+    
     // Show settings dialog
     SettingsDialog dialog(this);
     if (dialog.exec() == QDialog::Accepted) {
+        // Recreate the waveform views if another renderer was selected
+        if (config.GetString("ui/waveformRenderer", "raster") != renderer) {
+            SetupWaveformViews();
+            connectWaveformModels();
+            for (auto& view : waveform_views_) {
+                view->SetPaused(!is_acquiring_);
+            }
+            if (bed_grid_) {
+                bed_grid_->Rebuild();
+            }
+        }
+        
         // Apply settings to views
         ApplyDefaultSettings();
         statusBar()->showMessage(tr("Settings updated"), 3000);
     }
 }
 
+/**
+ * @brief Handles the central station button toggle
+ * 
+ * Swaps the patient display for the bed grid. All beds start when the
+ * grid is shown and stop when it is hidden; each tile can also start or
+ * stop its own bed.
+ * 
+ * @param checked True to show the central station grid
+ */
+void MainWindow::OnCentralStationToggled(bool checked)
+{
+    if (checked && !bed_grid_) {
+        setupCentralStation();
+    }
+    
+    QSplitter* splitter = qobject_cast<QSplitter*>(centralWidget()->layout()->itemAt(0)->widget());
+    splitter->setVisible(!checked);
+    bed_grid_scroll_area_->setVisible(checked);
+    
+    if (checked) {
+        const int started = bed_manager_->startAll();
+        statusBar()->showMessage(tr("Central station: %1 of %2 beds running")
+                                     .arg(started).arg(bed_manager_->GetBedCount()), 3000);
+    } else {
+        bed_manager_->stopAll();
+    }
+    
+    // Keep the tile buttons in step with the beds
+    for (QPushButton* button : bed_grid_->findChildren<QPushButton*>()) {
+        QSignalBlocker blocker(button);
+        button->setChecked(checked);
+        button->setText(checked ? tr("Stop") : tr("Start"));
+    }
+}
+
+/**
+ * @brief Handles the record button toggle
+ * 
+ * Recordings are named after the time they were started and written to the
+ * "recording/directory" setting, by default a folder in the application data
+ * location.
+ * 
+ * @param checked True to start recording
+ */
+void MainWindow::OnRecordToggled(bool checked)
+{
+    if (!checked) {
+        data_manager_->StopRecording();
+        record_button_->setText(tr("Record"));
+        statusBar()->showMessage(tr("Recording stopped"), 3000);
+        return;
+    }
+    
+    const QString defaultDirectory =
+        QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/recordings";
+    const QString directory = ConfigManager::GetInstance().GetString("recording/directory", defaultDirectory);
+    const QString filePath = QDir(directory).filePath(
+        QString("VitalSync_%1.vsr").arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss")));
+    
+    if (!QDir().mkpath(directory) || !data_manager_->StartRecording(filePath)) {
+        QSignalBlocker blocker(record_button_);
+        record_button_->setChecked(false);
+        QMessageBox::warning(this, tr("Recording Failed"),
+                             tr("Failed to create the recording %1.").arg(filePath));
+        return;
+    }
+    
+    record_button_->setText(tr("Stop Recording"));
+    statusBar()->showMessage(tr("Recording to %1").arg(filePath), 3000);
+}
+
+/**
+ * @brief Creates the central station beds and grid
+ * 
+ * Every bed is an independent DataManager with its own provider, models and
+ * acquisition thread. The beds are initialized in parallel on a thread pool.
+ */
+void MainWindow::setupCentralStation()
+{
+    // With the demo provider's load generator on, its bed count sizes the station
+    int bedCount = ConfigManager::GetInstance().GetInt("ui/centralStationBeds", DEFAULT_CENTRAL_STATION_BEDS);
+    const QVariantMap demoConfig = ConfigManager::GetInstance().GetProviderConfig("Demo");
+    if (demoConfig.value("loadMode", false).toBool()) {
+        bedCount = demoConfig.value("loadBeds", bedCount).toInt();
+    }
+    bedCount = qBound(1, bedCount, MAX_CENTRAL_STATION_BEDS);
+    QStringList bedIds;
+    for (int i = 1; i <= bedCount; ++i) {
+        bedIds.append(tr("Bed %1").arg(i));
+    }
+    
+    bed_manager_->AddBeds(bedIds);
+    
+    bed_grid_ = new BedGridView(bed_manager_, frame_scheduler_,
+                                [this]() { return createWaveformView(); }, quality_governor_);
+    
+    bed_grid_scroll_area_ = new QScrollArea(centralWidget());
+    bed_grid_scroll_area_->setWidgetResizable(true);
+    bed_grid_scroll_area_->setFrameShape(QFrame::NoFrame);
+    bed_grid_scroll_area_->setWidget(bed_grid_);
+    bed_grid_scroll_area_->hide();
+    
+    // The patient display splitter stays the first item of the central layout
+    centralWidget()->layout()->addWidget(bed_grid_scroll_area_);
+    
+    ApplyDefaultSettings();
+}
+
 /**
  * @brief Connects waveform models to their corresponding views
  * 
  * Establishes signal-slot connections between waveform data models and
- * their visualization components to enable real-time updates.
+ * their visualization components to enable real-time updates. Only the
+ * waveforms that have a view get a model.
  */
 void MainWindow::connectWaveformModels()
 {
-    // Get all waveform models from the data manager
-    auto allWaveformModels = data_manager_->GetAllWaveformModels();
-    
-    // Connect each model to the corresponding view
-    for (const auto& model : allWaveformModels) {
-        if (model) {
-            // Get waveform ID
-            VitalSync::WaveformType type = static_cast<VitalSync::WaveformType>(model->GetWaveformId());
-            
-            // Find the corresponding view
-            auto viewIt = waveform_views_.find(type);
-            if (viewIt != waveform_views_.end()) {
-                // Connect model to view
-                viewIt.value()->SetModel(model);
-            }
-        }
+    // Asking for the model of a shown waveform builds it if needed
+    for (auto it = waveform_views_.begin(); it != waveform_views_.end(); ++it) {
+        it.value()->SetModel(data_manager_->GetWaveformModel(static_cast<int>(it.key())));
     }
 }
 
@@ -643,22 +894,8 @@ void MainWindow::connectWaveformModels()
  */
 void MainWindow::connectParameterModels()
 {
-    // Get all parameter models from the data manager
-    auto allParameterModels = data_manager_->GetAllParameterModels();
-    
-    // Connect each model to the corresponding view
-    for (const auto& model : allParameterModels) {
-        if (model) {
-            // Get parameter ID
-            VitalSync::ParameterType type = static_cast<VitalSync::ParameterType>(model->GetParameterId());
-            
-            // Find the corresponding view
-            auto viewIt = parameter_views_.find(type);
-            if (viewIt != parameter_views_.end()) {
-                // Connect model to view
-                viewIt.value()->SetModel(model);
-            }
-        }
+    for (auto it = parameter_views_.begin(); it != parameter_views_.end(); ++it) {
+        it.value()->SetModel(data_manager_->GetParameterModel(static_cast<int>(it.key())));
     }
 }
 
@@ -695,6 +932,37 @@ void MainWindow::ApplyDefaultSettings()
         view->SetLabelVisible(true);
         view->SetUnitVisible(true);
     }
+    
+    // Apply settings to the central station grid
+    if (bed_grid_) {
+        bed_grid_->ApplyDisplaySettings(sweepSpeed, gridColor, backgroundColor);
+    }
+    
+    // Rendering quality follows the load unless switched off
+    quality_governor_->SetEnabled(config.GetBool("ui/qualityGovernor", true));
+    applyRenderQuality();
+}
+
+/**
+ * @brief Applies the governor's rendering quality to the patient display
+ * 
+ * The primary bed is in the foreground while the window is active. Any of
+ * its parameters in an alarm state keeps its waveforms at full quality.
+ */
+void MainWindow::applyRenderQuality()
+{
+    bool alarming = false;
+    for (const auto& model : data_manager_->GetAllParameterModels()) {
+        if (model && model->GetAlarmState() != IParameterModel::AlarmState::Normal) {
+            alarming = true;
+            break;
+        }
+    }
+    
+    const IWaveformView::RenderQuality quality = quality_governor_->GetRenderQuality(!isActiveWindow(), alarming);
+    for (auto& view : waveform_views_) {
+        view->SetRenderQuality(quality);
+    }
 }
 
 /**
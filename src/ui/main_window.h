@@ -25,6 +25,14 @@ namespace Ui {
 class MainWindow;
 }
 
+class FrameScheduler;
+class BedManager;
+class BedGridView;
+class QScrollArea;
+class MetricsOverlay;
+class MetricsReporter;
+class QualityGovernor;
+
 /**
  * @class MainWindow
  * @brief Main application window that displays the patient monitor UI
@@ -74,6 +82,16 @@ protected:
      */
     void closeEvent(QCloseEvent* event) override;
 
+    /**
+     * @brief Handle window state changes
+     * 
+     * The patient display counts as a background bed for the quality
+     * governor while the window is not active.
+     * 
+     * @param event Change event
+     */
+    void changeEvent(QEvent* event) override;
+
 private slots:
     /**
      * @brief Handle start/stop acquisition button click
@@ -132,6 +150,28 @@ private slots:
      */
     void OnSettingsButtonClicked();
 
+    /**
+     * @brief Handle central station button toggle
+     * 
+     * Switches between the single-patient display and the central station
+     * grid of beds. The beds are created the first time the grid is shown,
+     * run while it is shown and stop when returning to the patient display.
+     * 
+     * @param checked True to show the central station grid
+     */
+    void OnCentralStationToggled(bool checked);
+
+    /**
+     * @brief Handle record button toggle
+     * 
+     * Starts recording the patient's data to a new file in the recordings
+     * directory, or closes the recording in progress. Recordings can be
+     * replayed with the File data source.
+     * 
+     * @param checked True to start recording
+     */
+    void OnRecordToggled(bool checked);
+
 private:
     /**
      * @brief Initialize the user interface
@@ -150,6 +190,15 @@ private:
      */
     void SetupWaveformViews();
 
+    /**
+     * @brief Create a waveform view with the configured renderer
+     * @return The new waveform view, attached to the frame scheduler
+     * 
+     * Creates a GLWaveformView when the "ui/waveformRenderer" setting is
+     * "opengl" and the raster WaveformView otherwise.
+     */
+    std::shared_ptr<IWaveformView> createWaveformView();
+
     /**
      * @brief Create and add parameter views
      * 
@@ -203,6 +252,14 @@ private:
      */
     void ApplyDefaultSettings();
 
+    /**
+     * @brief Apply the governor's rendering quality to the patient display
+     * 
+     * The waveform views keep full quality while a parameter of the primary
+     * bed is in an alarm state.
+     */
+    void applyRenderQuality();
+
     /**
      * @brief Get view for a waveform type
      * 
@@ -223,13 +280,24 @@ private:
      */
     std::shared_ptr<IParameterView> GetParameterView(VitalSync::ParameterType type) const;
 
+    /**
+     * @brief Create the central station beds and grid
+     * 
+     * Adds "ui/centralStationBeds" beds to the bed manager, initializing them
+     * in parallel, and places the bed grid below the patient display, hidden.
+     */
+    void setupCentralStation();
+
     /**
      * @brief UI elements for provider control and status display
      */
     QComboBox* provider_selector_;     /**< Dropdown for selecting the data provider */
     QPushButton* start_stop_button_;   /**< Button to start/stop data acquisition */
+    QPushButton* record_button_;       /**< Button to start/stop recording */
     QPushButton* configure_button_;    /**< Button to open provider configuration dialog */
     QPushButton* settings_button_;     /**< Button to open application settings dialog */
+    QPushButton* central_station_button_; /**< Button to toggle the central station grid */
+    QPushButton* metrics_button_;      /**< Button to toggle the metrics overlay */
     QLabel* status_label_;             /**< Label for displaying status messages */
     QLabel* connection_status_label_;  /**< Label for displaying connection status */
 
@@ -237,6 +305,13 @@ private:
      * @brief Core components for data management
      */
     std::shared_ptr<IDataManager> data_manager_;  /**< Manager for handling data providers and models */
+    FrameScheduler* frame_scheduler_;             /**< Shared display clock driving all views */
+    QualityGovernor* quality_governor_;           /**< Lowers the rendering quality while the display falls behind */
+    BedManager* bed_manager_;                     /**< Beds of the central station */
+    BedGridView* bed_grid_;                       /**< Central station grid, created on first use */
+    QScrollArea* bed_grid_scroll_area_;           /**< Scroll area holding the central station grid */
+    MetricsReporter* metrics_reporter_;           /**< Periodic metrics dump to the log */
+    MetricsOverlay* metrics_overlay_;             /**< Live metrics panel over the displays */
 
     /**
      * @brief View component collections
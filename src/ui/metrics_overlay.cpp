@@ -0,0 +1,119 @@
+/**
+ * @file metrics_overlay.cpp
+ * @brief Implementation of the MetricsOverlay class
+ *
+ * This file implements the sampling, layout and drawing of the metrics
+ * overlay.
+ */
+#include "metrics_overlay.h"
+#include "../../include/sample_block_pool.h"
+#include <QEvent>
+#include <QFontDatabase>
+#include <QFontMetrics>
+#include <QPainter>
+
+/**
+ * @namespace Anonymous namespace for constants
+ * @brief Contains constants used by the MetricsOverlay implementation
+ */
+namespace {
+    const int REFRESH_INTERVAL_MS = 1000;   ///< Interval the metrics are sampled and shown for
+    const int MARGIN = 8;                   ///< Distance from the parent's corner in pixels
+    const int PADDING = 6;                  ///< Space between the panel border and the text in pixels
+}
+
+/**
+ * @brief Constructs a hidden metrics overlay
+ * @param parent Widget the overlay is placed on
+ */
+MetricsOverlay::MetricsOverlay(QWidget* parent)
+    : QWidget(parent)
+    , timer_(this)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    connect(&timer_, &QTimer::timeout, this, &MetricsOverlay::Refresh);
+    if (parent) {
+        parent->installEventFilter(this);
+    }
+    hide();
+}
+
+/**
+ * @brief Draws the panel and the metrics text
+ * @param event The paint event
+ */
+void MetricsOverlay::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(0, 0, 0, 180));
+    painter.setPen(Qt::white);
+    painter.drawText(rect().adjusted(PADDING, PADDING, -PADDING, -PADDING), Qt::AlignLeft | Qt::AlignTop, text_);
+}
+
+/**
+ * @brief Starts sampling when the overlay is shown
+ * @param event The show event
+ *
+ * The first refresh covers the time from now on, so the overlay is filled
+ * after one interval.
+ */
+void MetricsOverlay::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    previous_ = Metrics::TakeSnapshot();
+    text_ = tr("Collecting metrics...");
+    reposition();
+    raise();
+    timer_.start(REFRESH_INTERVAL_MS);
+}
+
+/**
+ * @brief Stops sampling when the overlay is hidden
+ * @param event The hide event
+ */
+void MetricsOverlay::hideEvent(QHideEvent* event)
+{
+    timer_.stop();
+    QWidget::hideEvent(event);
+}
+
+/**
+ * @brief Follows resizes of the parent
+ * @param watched Object the event is for
+ * @param event The event
+ * @return Always false, so the parent handles the event as usual
+ */
+bool MetricsOverlay::eventFilter(QObject* watched, QEvent* event)
+{
+    if (watched == parentWidget() && event->type() == QEvent::Resize && isVisible()) {
+        reposition();
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+/**
+ * @brief Takes a new snapshot and shows the interval since the previous one
+ */
+void MetricsOverlay::Refresh()
+{
+    const Metrics::Snapshot current = Metrics::TakeSnapshot();
+    text_ = Metrics::Format(current.Since(previous_)) + QLatin1Char('\n')
+            + VitalSync::SampleBlockPool::GetInstance().FormatStatistics();
+    previous_ = current;
+    reposition();
+    update();
+}
+
+/**
+ * @brief Sizes the overlay to its text and moves it to the parent's corner
+ */
+void MetricsOverlay::reposition()
+{
+    const QSize textSize = QFontMetrics(font()).size(0, text_);
+    resize(textSize + QSize(2 * PADDING, 2 * PADDING));
+    if (parentWidget()) {
+        move(parentWidget()->width() - width() - MARGIN, MARGIN);
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * @file metrics_overlay.h
+ * @brief Definition of the MetricsOverlay class
+ *
+ * This file contains the definition of the MetricsOverlay class, a
+ * translucent panel that shows the live metrics on top of the displays.
+ */
+#ifndef METRICS_OVERLAY_H
+#define METRICS_OVERLAY_H
+
+#include "../utils/metrics.h"
+#include <QTimer>
+#include <QWidget>
+
+/**
+ * @brief Live metrics panel in the corner of a widget
+ *
+ * Shows the counter rates and histogram percentiles of the last second in
+ * the top right corner of its parent and follows the parent's size. The
+ * overlay ignores mouse input and only samples the metrics while it is
+ * visible.
+ */
+class MetricsOverlay : public QWidget
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor, hidden until shown
+     * @param parent Widget the overlay is placed on
+     */
+    explicit MetricsOverlay(QWidget* parent);
+
+protected:
+    /**
+     * @brief Draw the panel and the metrics text
+     * @param event The paint event
+     */
+    void paintEvent(QPaintEvent* event) override;
+
+    /**
+     * @brief Start sampling when the overlay is shown
+     * @param event The show event
+     */
+    void showEvent(QShowEvent* event) override;
+
+    /**
+     * @brief Stop sampling when the overlay is hidden
+     * @param event The hide event
+     */
+    void hideEvent(QHideEvent* event) override;
+
+    /**
+     * @brief Follow resizes of the parent
+     * @param watched Object the event is for
+     * @param event The event
+     * @return Always false, so the parent handles the event as usual
+     */
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private slots:
+    /**
+     * @brief Takes a new snapshot and shows the interval since the previous one
+     */
+    void Refresh();
+
+private:
+    /**
+     * @brief Size the overlay to its text and move it to the parent's corner
+     */
+    void reposition();
+
+private:
+    QTimer timer_;                      ///< Refresh timer, running while visible
+    Metrics::Snapshot previous_;        ///< Totals at the previous refresh
+    QString text_;                      ///< Formatted metrics of the last interval
+};
+
+#endif // METRICS_OVERLAY_H
@@ -8,14 +8,17 @@
  * visual feedback for alarm states such as high or low values.
  */
 #include "parameter_view.h"
+#include "../frame_scheduler.h"
 #include "../../../include/config_manager.h"
+#include "../../utils/log_categories.h"
+#include "../../utils/metrics.h"
 #include <QPainter>
 #include <QPaintEvent>
 #include <QResizeEvent>
 #include <QDebug>
-#include <QVBoxLayout>
-#include <QHBoxLayout>
-#include <QFont>
+#include <QFontMetrics>
+#include <QTransform>
+#include <cmath>
 
 /**
  * @namespace Anonymous namespace for constants
@@ -24,8 +27,43 @@
 // Constants
 namespace {
     const int DEFAULT_BLINK_INTERVAL_MS = 500;      /**< Blink interval for alarms in ms */
+    const int DEFAULT_POLL_INTERVAL_MS = 100;       /**< Model polling interval in ms */
     const int DEFAULT_VALUE_FONT_SIZE = 24;         /**< Default font size for value */
     const int DEFAULT_LABEL_FONT_SIZE = 12;         /**< Default font size for label */
+    const int CONTENT_MARGIN = 5;                   /**< Margin around the content in pixels */
+    const int CONTENT_SPACING = 2;                  /**< Space between header and value in pixels */
+    const qint64 PRECISION_SCALES[] = { 1, 10, 100, 1000 };  /**< Scale of a value rounded to 0 to 3 decimals */
+    
+    /**
+     * @brief Set the text of a static text and lay it out for a font
+     * @param staticText Static text to update
+     * @param text New text
+     * @param font Font the text is painted with
+     */
+    void prepareStaticText(QStaticText& staticText, const QString& text, const QFont& font)
+    {
+        staticText.setText(text);
+        staticText.prepare(QTransform(), font);
+    }
+    
+    /**
+     * @brief Position a static text in an area, centered vertically
+     * @param rect Area of the text
+     * @param staticText Laid-out text
+     * @param alignment Horizontal alignment in the area
+     * @return Top left corner to draw the text at
+     */
+    QPointF alignedPosition(const QRect& rect, const QStaticText& staticText, Qt::Alignment alignment)
+    {
+        const QSizeF size = staticText.size();
+        qreal x = rect.left();
+        if (alignment & Qt::AlignRight) {
+            x = rect.right() + 1 - size.width();
+        } else if (alignment & Qt::AlignHCenter) {
+            x = rect.left() + (rect.width() - size.width()) / 2.0;
+        }
+        return QPointF(x, rect.top() + (rect.height() - size.height()) / 2.0);
+    }
 }
 
 /**
@@ -37,65 +75,47 @@ namespace {
  */
 ParameterView::ParameterView(QWidget* parent)
     : QWidget(parent)
-    , label_widget_(nullptr)
-    , value_widget_(nullptr)
-    , unit_widget_(nullptr)
+    , value_key_(0)
+    , value_precision_(0)
+    , value_key_valid_(false)
     , label_visible_(true)
     , unit_visible_(true)
     , value_font_size_(DEFAULT_VALUE_FONT_SIZE)
     , label_font_size_(DEFAULT_LABEL_FONT_SIZE)
     , background_color_(Qt::black)
     , text_color_(Qt::white)
+    , current_text_color_(Qt::white)
     , current_alarm_state_(IParameterModel::AlarmState::Normal)
     , alarm_blink_state_(false)
-    , update_timer_(nullptr)
+    , last_poll_time_(0)
+    , last_blink_time_(0)
+    , polling_(false)
+    , attached_(false)
 {
     // Set up default widget
     setMinimumSize(100, 60);
     
-    // Create UI components
-    label_widget_ = new QLabel(this);
-    value_widget_ = new QLabel(this);
-    unit_widget_ = new QLabel(this);
-    
     // Set up fonts
-    QFont valueFont = value_widget_->font();
-    valueFont.setPointSize(value_font_size_);
-    valueFont.setBold(true);
-    value_widget_->setFont(valueFont);
+    value_font_ = font();
+    value_font_.setPointSize(value_font_size_);
+    value_font_.setBold(true);
     
-    QFont labelFont = label_widget_->font();
-    labelFont.setPointSize(label_font_size_);
-    label_widget_->setFont(labelFont);
-    unit_widget_->setFont(labelFont);
+    label_font_ = font();
+    label_font_.setPointSize(label_font_size_);
     
-    // Set alignments
-    label_widget_->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-    value_widget_->setAlignment(Qt::AlignCenter);
-    unit_widget_->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    // The texts are painted over the background, never through it
+    label_text_.setTextFormat(Qt::PlainText);
+    unit_text_.setTextFormat(Qt::PlainText);
+    value_text_.setTextFormat(Qt::PlainText);
+    prepareStaticText(label_text_, "--", label_font_);
+    prepareStaticText(unit_text_, QString(), label_font_);
+    setValueText("--");
     
     // Set background and colors
     SetBackgroundColor(background_color_);
     SetTextColor(text_color_);
     
-    // Set up layout
-    QVBoxLayout* mainLayout = new QVBoxLayout(this);
-    mainLayout->setContentsMargins(5, 5, 5, 5);
-    mainLayout->setSpacing(2);
-    
-    QHBoxLayout* headerLayout = new QHBoxLayout();
-    headerLayout->addWidget(label_widget_, 3);
-    headerLayout->addStretch(1);
-    headerLayout->addWidget(unit_widget_, 1);
-    
-    mainLayout->addLayout(headerLayout, 1);
-    mainLayout->addWidget(value_widget_, 3);
-    
-    setLayout(mainLayout);
-    
-    // Set up blink timer
-    blink_timer_.setInterval(DEFAULT_BLINK_INTERVAL_MS);
-    connect(&blink_timer_, &QTimer::timeout, this, &ParameterView::UpdateDisplay);
+    updateLayout();
     
     // Set up default alarm colors
     alarm_background_colors_[IParameterModel::AlarmState::Normal] = Qt::black;
@@ -116,15 +136,10 @@ ParameterView::ParameterView(QWidget* parent)
 /**
  * @brief Destroys the ParameterView widget
  *
- * Stops the blink timer and disconnects any model signals.
+ * Disconnects any model signals.
  */
 ParameterView::~ParameterView()
 {
-    // Stop the timer
-    if (blink_timer_.isActive()) {
-        blink_timer_.stop();
-    }
-    
     // Disconnect model signals
     if (model_) {
         disconnectModelSignals();
@@ -148,22 +163,14 @@ void ParameterView::SetModel(std::shared_ptr<IParameterModel> model)
     // Set new model
     model_ = model;
     
+    // The value of a different model is always laid out anew
+    value_key_valid_ = false;
+    
     if (model_) {
         // Update UI with model data
-        label_widget_->setText(model_->GetDisplayName());
-        
-        // Format the initial value properly using the same logic as HandleValueChanged
-        float value = model_->GetValue();
-        if (model_->GetUnit() == "%") {
-            value_widget_->setText(QString::number(static_cast<int>(value)));
-        } else if (model_->GetUnit().contains("°C")) {
-            value_widget_->setText(QString::number(value, 'f', 1));
-        } else {
-            int precision = (value >= 100.0) ? 0 : 1;
-            value_widget_->setText(QString::number(value, 'f', precision));
-        }
-        
-        unit_widget_->setText(model_->GetUnit());
+        prepareStaticText(label_text_, model_->GetDisplayName(), label_font_);
+        prepareStaticText(unit_text_, model_->GetUnit(), label_font_);
+        HandleValueChanged(model_->GetValue());
         
         // Get current alarm state
         current_alarm_state_ = model_->GetAlarmState();
@@ -173,18 +180,11 @@ void ParameterView::SetModel(std::shared_ptr<IParameterModel> model)
         
         // Update appearance
         UpdateAlarmAppearance();
-        
-        // Force initial update to ensure everything is displayed correctly
-        QTimer::singleShot(100, this, [this]() {
-            if (model_) {
-                HandleValueChanged(model_->GetValue());
-            }
-        });
     } else {
         // Clear UI
-        label_widget_->setText("--");
-        value_widget_->setText("--");
-        unit_widget_->setText("");
+        prepareStaticText(label_text_, "--", label_font_);
+        prepareStaticText(unit_text_, QString(), label_font_);
+        setValueText("--");
         
         // Reset alarm state
         current_alarm_state_ = IParameterModel::AlarmState::Normal;
@@ -225,8 +225,7 @@ void ParameterView::SetLabelVisible(bool visible)
     
     if (label_visible_ != visible) {
         label_visible_ = visible;
-        label_widget_->setVisible(visible);
-        this->QWidget::update();
+        this->QWidget::update(label_rect_);
     }
 }
 
@@ -240,8 +239,7 @@ void ParameterView::SetUnitVisible(bool visible)
     
     if (unit_visible_ != visible) {
         unit_visible_ = visible;
-        unit_widget_->setVisible(visible);
-        this->QWidget::update();
+        this->QWidget::update(unit_rect_);
     }
 }
 
@@ -255,9 +253,9 @@ void ParameterView::SetValueFontSize(int size)
     
     if (value_font_size_ != size) {
         value_font_size_ = size;
-        QFont font = value_widget_->font();
-        font.setPointSize(size);
-        value_widget_->setFont(font);
+        value_font_.setPointSize(size);
+        value_text_.prepare(QTransform(), value_font_);
+        updateLayout();
         this->QWidget::update();
     }
 }
@@ -272,14 +270,10 @@ void ParameterView::SetLabelFontSize(int size)
     
     if (label_font_size_ != size) {
         label_font_size_ = size;
-        QFont font = label_widget_->font();
-        font.setPointSize(size);
-        label_widget_->setFont(font);
-        
-        font = unit_widget_->font();
-        font.setPointSize(size);
-        unit_widget_->setFont(font);
-        
+        label_font_.setPointSize(size);
+        label_text_.prepare(QTransform(), label_font_);
+        unit_text_.prepare(QTransform(), label_font_);
+        updateLayout();
         this->QWidget::update();
     }
 }
@@ -316,13 +310,9 @@ void ParameterView::SetTextColor(const QColor& color)
         // Update alarm colors for normal state
         alarm_text_colors_[IParameterModel::AlarmState::Normal] = color;
         
-        // If currently in normal state, update the text colors
+        // If currently in normal state, update the text color
         if (current_alarm_state_ == IParameterModel::AlarmState::Normal) {
-            QPalette pal = label_widget_->palette();
-            pal.setColor(QPalette::WindowText, color);
-            label_widget_->setPalette(pal);
-            value_widget_->setPalette(pal);
-            unit_widget_->setPalette(pal);
+            current_text_color_ = color;
         }
         
         this->QWidget::update();
@@ -378,11 +368,34 @@ void ParameterView::update()
 /**
  * @brief Handles paint events for the widget
  * @param event The paint event
+ *
+ * The background is filled by the widget itself. Only the texts whose areas
+ * need repainting are drawn, from their cached layouts; the value is clipped
+ * to its area, so a value change never touches name or unit.
  */
 void ParameterView::paintEvent(QPaintEvent* event)
 {
-    // Just use the default implementation
-    QWidget::paintEvent(event);
+    ScopedMetricsTimer paintTimer(Metrics::Histogram::ParameterPaint);
+    
+    QPainter painter(this);
+    painter.setPen(current_text_color_);
+    
+    const QRect& dirty = event->rect();
+    if (label_visible_ && dirty.intersects(label_rect_)) {
+        painter.setFont(label_font_);
+        painter.drawStaticText(alignedPosition(label_rect_, label_text_, Qt::AlignLeft), label_text_);
+    }
+    
+    if (unit_visible_ && dirty.intersects(unit_rect_)) {
+        painter.setFont(label_font_);
+        painter.drawStaticText(alignedPosition(unit_rect_, unit_text_, Qt::AlignRight), unit_text_);
+    }
+    
+    if (dirty.intersects(value_rect_)) {
+        painter.setFont(value_font_);
+        painter.setClipRect(value_rect_);
+        painter.drawStaticText(alignedPosition(value_rect_, value_text_, Qt::AlignHCenter), value_text_);
+    }
 }
 
 /**
@@ -391,8 +404,8 @@ void ParameterView::paintEvent(QPaintEvent* event)
  */
 void ParameterView::resizeEvent(QResizeEvent* event)
 {
-    // Just use the default implementation
     QWidget::resizeEvent(event);
+    updateLayout();
 }
 
 /**
@@ -400,41 +413,38 @@ void ParameterView::resizeEvent(QResizeEvent* event)
  * @param value New value
  *
  * Formats the value based on the parameter type and updates the display.
+ * Called at the polling rate, so the value is first rounded the way it is
+ * shown and compared as an integer; only a change of the shown digits formats
+ * and lays out the text and repaints the value area.
  */
 void ParameterView::HandleValueChanged(float value)
 {
-    // Format the value depending on the parameter type
-    // Example: 98% for SpO2, 120/80 for BP, etc.
     if (!model_) {
         qWarning() << "ParameterView: Cannot handle value change - model is null";
         return;
     }
     
-    QString unit = model_->GetUnit();
-    
-    qDebug() << "ParameterView: Handling value change for" << model_->GetDisplayName() 
-             << "to" << value << unit;
-    
-    QString formatted_value;
-    
-    // Google style: Use clear if-else chains for readability
-    if (unit == "%") {
-        // Display whole numbers for percentages
-        formatted_value = QString::number(static_cast<int>(value));
-    } else if (unit.contains("°C")) {
-        // Display one decimal place for temperature
-        formatted_value = QString::number(value, 'f', 1);
-    } else {
-        // For other values, display one decimal place if < 100, otherwise whole number
-        int precision = (value >= 100.0) ? 0 : 1;
-        formatted_value = QString::number(value, 'f', precision);
+    VITALSYNC_TRACE(lcDisplay) << "ParameterView: Handling value change for" << model_->GetDisplayName()
+                               << "to" << value << model_->GetUnit();
+    
+    const VitalSync::ParameterTraits& traits = VitalSync::GetParameterTraits(model_->GetParameterId());
+    const int precision = qBound(0, traits.GetPrecision(value), 3);
+    const bool finite = std::isfinite(value);
+    qint64 key = 0;
+    if (finite) {
+        // Percentages are truncated, see formatValue()
+        key = traits.format == VitalSync::ValueFormat::WholeNumber
+            ? static_cast<qint64>(value)
+            : std::llround(static_cast<double>(value) * PRECISION_SCALES[precision]);
+    }
+    if (value_key_valid_ && key == value_key_ && precision == value_precision_) {
+        return;
     }
     
-    // Update the display
-    value_widget_->setText(formatted_value);
-    
-    // Force a repaint to ensure the new value is shown
-    this->QWidget::update();
+    value_key_ = key;
+    value_precision_ = precision;
+    value_key_valid_ = finite;
+    setValueText(formatValue(value));
 }
 
 /**
@@ -464,49 +474,104 @@ void ParameterView::HandlePropertiesChanged()
         return;
     }
     
-    qDebug() << "ParameterView: Properties changed for" << model_->GetDisplayName();
+    VITALSYNC_TRACE(lcDisplay) << "ParameterView: Properties changed for" << model_->GetDisplayName();
     
     // Update display name (label)
-    label_widget_->setText(model_->GetDisplayName());
+    prepareStaticText(label_text_, model_->GetDisplayName(), label_font_);
     
-    // Update value directly
+    // Update value directly; the parameter type and with it the format may have changed
     float value = model_->GetValue();
-    qDebug() << "ParameterView: Updating value to" << value << model_->GetUnit() << "due to properties change";
+    VITALSYNC_TRACE(lcDisplay) << "ParameterView: Updating value to" << value << model_->GetUnit() << "due to properties change";
+    value_key_valid_ = false;
     HandleValueChanged(value);
     
     // Update alarm state
     HandleAlarmStateChanged(model_->GetAlarmState());
     
     // Update the unit
-    unit_widget_->setText(model_->GetUnit());
+    prepareStaticText(unit_text_, model_->GetUnit(), label_font_);
+    requestRepaint(rect());
     
-    // Force update to ensure UI is refreshed
-    this->update();
-    
-    qDebug() << "ParameterView: Completed properties update for" << model_->GetDisplayName();
+    VITALSYNC_TRACE(lcDisplay) << "ParameterView: Completed properties update for" << model_->GetDisplayName();
 }
 
 /**
- * @brief Updates the display timer - used for blinking in alarm states
+ * @brief Connects this view to the shared display clock
+ * @param scheduler The frame scheduler that drives the view
+ */
+void ParameterView::AttachToScheduler(FrameScheduler* scheduler)
+{
+    if (scheduler) {
+        connect(scheduler, &FrameScheduler::frameTick, this, &ParameterView::OnFrame);
+        attached_ = true;
+    }
+}
+
+/**
+ * @brief Handles a tick of the shared display clock
+ * @param frameTimeMs Monotonic frame time in milliseconds
  *
- * Toggles the blink state for alarm states that need blinking.
+ * Numeric values change far slower than the frame rate, so the model is only
+ * polled every DEFAULT_POLL_INTERVAL_MS, and the alarm blink is only toggled
+ * every DEFAULT_BLINK_INTERVAL_MS while a blinking alarm is active. Views that
+ * are not visible, or have no model, skip the tick altogether; they are
+ * painted in full when they are shown again anyway.
+ *
+ * The areas invalidated since the last tick are repainted last. Every view of
+ * a bed handles the same tick, so the changes of all of them are painted in
+ * the same pass of the window.
+ */
+void ParameterView::OnFrame(qint64 frameTimeMs)
+{
+    if (!polling_ || !model_ || visibleRegion().isEmpty()) {
+        pending_region_ = QRegion();
+        return;
+    }
+    
+    if (frameTimeMs - last_poll_time_ >= DEFAULT_POLL_INTERVAL_MS) {
+        last_poll_time_ = frameTimeMs;
+        HandleValueChanged(model_->GetValue());
+        HandleAlarmStateChanged(model_->GetAlarmState());
+    }
+    
+    if (isBlinkingAlarmState() && frameTimeMs - last_blink_time_ >= DEFAULT_BLINK_INTERVAL_MS) {
+        last_blink_time_ = frameTimeMs;
+        UpdateDisplay();
+    }
+    
+    if (!pending_region_.isEmpty()) {
+        this->QWidget::update(pending_region_);
+        pending_region_ = QRegion();
+    }
+}
+
+/**
+ * @brief Toggles the blink state for alarm states that need blinking
  */
 void ParameterView::UpdateDisplay()
 {
-    // Toggle blink state for alarm states that need blinking
-    if (current_alarm_state_ == IParameterModel::AlarmState::HighCritical ||
-        current_alarm_state_ == IParameterModel::AlarmState::LowCritical ||
-        current_alarm_state_ == IParameterModel::AlarmState::Technical) {
+    if (isBlinkingAlarmState()) {
         alarm_blink_state_ = !alarm_blink_state_;
         UpdateAlarmAppearance();
     }
 }
 
+/**
+ * @brief Checks if the current alarm state blinks
+ * @return True for critical and technical alarms
+ */
+bool ParameterView::isBlinkingAlarmState() const
+{
+    return current_alarm_state_ == IParameterModel::AlarmState::HighCritical ||
+           current_alarm_state_ == IParameterModel::AlarmState::LowCritical ||
+           current_alarm_state_ == IParameterModel::AlarmState::Technical;
+}
+
 /**
  * @brief Connects signals from the model
  *
- * Sets up connections for property changes and creates a timer
- * for periodic updates of value and alarm state.
+ * Sets up connections for property changes and enables polling of value and
+ * alarm state on the ticks of the shared display clock.
  */
 void ParameterView::connectModelSignals()
 {
@@ -521,49 +586,16 @@ void ParameterView::connectModelSignals()
     connect(model_.get(), &IParameterModel::propertiesChanged,
             this, &ParameterView::HandlePropertiesChanged);
             
-    // Create and start update timer for value and alarm updates
-    if (update_timer_ == nullptr) {
-        constexpr int kUpdateIntervalMs = 100;  // 100ms = 10 updates per second
-        
-        update_timer_ = new QTimer(this);
-        update_timer_->setInterval(kUpdateIntervalMs);
-        
-        connect(update_timer_, &QTimer::timeout, this, [this]() {
-            if (!model_) {
-                return;  // Early return if model is invalid
-            }
-            
-            // Update value
-            float current_value = model_->GetValue();
-            qDebug() << "ParameterView Timer: Updating" << model_->GetDisplayName() 
-                     << "value to" << current_value << model_->GetUnit();
-            HandleValueChanged(current_value);
-            
-            // Update alarm state
-            IParameterModel::AlarmState current_state = model_->GetAlarmState();
-            HandleAlarmStateChanged(current_state);
-        });
-        
-        qDebug() << "ParameterView: Started update timer for" << model_->GetDisplayName();
-        update_timer_->start();
-    }
-    
-    // Initial update to ensure values are displayed immediately
-    QTimer::singleShot(0, this, [this]() {
-        if (!model_) {
-            return;  // Early return if model is invalid
-        }
-        
-        HandleValueChanged(model_->GetValue());
-        HandleAlarmStateChanged(model_->GetAlarmState());
-        qDebug() << "ParameterView: Performed initial update for" << model_->GetDisplayName();
-    });
+    // Poll value and alarm state on the frame ticks; SetModel() showed the
+    // current ones already
+    polling_ = true;
+    last_poll_time_ = 0;
 }
 
 /**
  * @brief Disconnects signals from the model
  *
- * Stops and clears the update timer and disconnects all connections.
+ * Stops polling the model and disconnects all connections.
  */
 void ParameterView::disconnectModelSignals()
 {
@@ -571,16 +603,12 @@ void ParameterView::disconnectModelSignals()
         return;
     }
 
-    // Stop and clear update timer if exists
-    if (update_timer_) {
-        update_timer_->stop();
-        delete update_timer_;
-        update_timer_ = nullptr;
-    }
+    // Stop polling on the frame ticks
+    polling_ = false;
     
     // Disconnect all connections
     disconnect(model_.get(), &IParameterModel::propertiesChanged, this, &ParameterView::HandlePropertiesChanged);
-    // Old connections commented out as we're now using timer-based updates
+    // Old connections commented out as we're now using polled updates
     // disconnect(model_.get(), &IParameterModel::valueChanged, this, &ParameterView::HandleValueChanged);
     // disconnect(model_.get(), &IParameterModel::alarmStateChanged, this, &ParameterView::HandleAlarmStateChanged);
 }
@@ -614,24 +642,78 @@ void ParameterView::UpdateAlarmAppearance()
     pal.setColor(QPalette::Window, bgColor);
     setPalette(pal);
     
-    // Update text colors
-    pal = label_widget_->palette();
-    pal.setColor(QPalette::WindowText, textColor);
-    label_widget_->setPalette(pal);
-    value_widget_->setPalette(pal);
-    unit_widget_->setPalette(pal);
-    
-    // Start or stop blink timer as needed
-    if (current_alarm_state_ == IParameterModel::AlarmState::HighCritical ||
-        current_alarm_state_ == IParameterModel::AlarmState::LowCritical ||
-        current_alarm_state_ == IParameterModel::AlarmState::Technical) {
-        if (!blink_timer_.isActive()) {
-            blink_timer_.start();
-        }
+    // Update text color
+    if (current_text_color_ != textColor) {
+        current_text_color_ = textColor;
+        requestRepaint(rect());
+    }
+    
+    // Blinking is driven by OnFrame(); end it with the blinking alarm
+    if (!isBlinkingAlarmState()) {
+        alarm_blink_state_ = false;
+    }
+}
+
+/**
+ * @brief Format a value of the model for display
+ * @param value The value
+ * @return The value with the precision of the model's parameter type
+ *
+ * Percentages are shown as whole numbers, temperatures with one decimal and
+ * everything else with one decimal below 100 and none from 100 on.
+ */
+QString ParameterView::formatValue(float value) const
+{
+    const VitalSync::ParameterTraits& traits = VitalSync::GetParameterTraits(model_->GetParameterId());
+    if (traits.format == VitalSync::ValueFormat::WholeNumber) {
+        // Percentages are truncated, not rounded
+        return QString::number(static_cast<int>(value));
+    }
+    return QString::number(value, 'f', traits.GetPrecision(value));
+}
+
+/**
+ * @brief Set the value text and lay it out
+ * @param text Text to show
+ *
+ * Only the value area is repainted.
+ */
+void ParameterView::setValueText(const QString& text)
+{
+    prepareStaticText(value_text_, text, value_font_);
+    requestRepaint(value_rect_);
+}
+
+/**
+ * @brief Compute the areas of name, unit and value from the widget size and fonts
+ *
+ * The header with name and unit takes a quarter of the content height, but
+ * at least one line of the label font; the name has the left three fifths of
+ * it and the unit the right fifth. The value takes the rest.
+ */
+void ParameterView::updateLayout()
+{
+    const QRect content = rect().adjusted(CONTENT_MARGIN, CONTENT_MARGIN, -CONTENT_MARGIN, -CONTENT_MARGIN);
+    const int headerHeight = qMin(content.height(),
+                                  qMax(QFontMetrics(label_font_).height(), (content.height() - CONTENT_SPACING) / 4));
+    
+    label_rect_ = QRect(content.left(), content.top(), content.width() * 3 / 5, headerHeight);
+    unit_rect_ = QRect(content.left() + content.width() * 4 / 5, content.top(),
+                       content.width() - content.width() * 4 / 5, headerHeight);
+    
+    const int valueTop = content.top() + headerHeight + CONTENT_SPACING;
+    value_rect_ = QRect(content.left(), valueTop, content.width(), qMax(0, content.bottom() + 1 - valueTop));
+}
+
+/**
+ * @brief Repaint an area on the next frame tick
+ * @param rect Area to repaint
+ */
+void ParameterView::requestRepaint(const QRect& rect)
+{
+    if (attached_) {
+        pending_region_ += rect;
     } else {
-        if (blink_timer_.isActive()) {
-            blink_timer_.stop();
-            alarm_blink_state_ = false;
-        }
+        this->QWidget::update(rect);
     }
-} 
\ No newline at end of file
+}
@@ -13,18 +13,28 @@
 #include "../../../include/i_parameter_view.h"
 #include "../../../include/i_parameter_model.h"
 #include <QWidget>
-#include <QLabel>
-#include <QTimer>
+#include <QFont>
 #include <QMutex>
+#include <QRegion>
+#include <QStaticText>
 #include <memory>
 #include <QMap>
 
+class FrameScheduler;
+
 /**
  * @brief Basic implementation of the IParameterView interface
  * 
  * This class provides a standard implementation of the IParameterView interface
  * that displays a vital sign parameter with customizable appearance and alarm
  * state visualization.
+ *
+ * The view paints its name, unit and value itself from QStaticText layouts
+ * that are only rebuilt when their text or font changes. The value is only
+ * re-laid out when the rounded value it shows changes, and then only the value
+ * area is invalidated. Repaints are requested on the ticks of the frame
+ * scheduler the view is attached to, so all views of a bed that changed
+ * during a frame are painted together in one pass.
  */
 class ParameterView : public QWidget, public IParameterView {
     Q_OBJECT
@@ -114,6 +124,19 @@ public:
      */
     void update() override;
 
+    /**
+     * @brief Connect this view to the shared display clock
+     * @param scheduler The frame scheduler that drives the view
+     */
+    void AttachToScheduler(FrameScheduler* scheduler);
+
+public slots:
+    /**
+     * @brief Handle a tick of the shared display clock
+     * @param frameTimeMs Monotonic frame time in milliseconds
+     */
+    void OnFrame(qint64 frameTimeMs);
+
 protected:
     /**
      * @brief Paint event handler for rendering the parameter
@@ -145,12 +168,18 @@ private slots:
      */
     void HandlePropertiesChanged();
 
+private:
     /**
-     * @brief Update the display timer - used for blinking in alarm states
+     * @brief Toggle the blink state for alarm states that need blinking
      */
     void UpdateDisplay();
 
-private:
+    /**
+     * @brief Check if the current alarm state blinks
+     * @return True for critical and technical alarms
+     */
+    bool isBlinkingAlarmState() const;
+
     /**
      * @brief Set up the user interface
      */
@@ -171,12 +200,45 @@ private:
      */
     void disconnectModelSignals();
 
+    /**
+     * @brief Format a value of the model for display
+     * @param value The value
+     * @return The value with the precision of the model's parameter type
+     */
+    QString formatValue(float value) const;
+
+    /**
+     * @brief Set the value text and lay it out
+     * @param text Text to show
+     */
+    void setValueText(const QString& text);
+
+    /**
+     * @brief Compute the areas of name, unit and value from the widget size and fonts
+     */
+    void updateLayout();
+
+    /**
+     * @brief Repaint an area on the next frame tick
+     * @param rect Area to repaint
+     *
+     * Without a frame scheduler the area is repainted right away.
+     */
+    void requestRepaint(const QRect& rect);
+
 private:
     std::shared_ptr<IParameterModel> model_;  /**< Parameter model */
-    QLabel* label_widget_;                    /**< Label showing parameter name */
-    QLabel* value_widget_;                    /**< Label showing parameter value */
-    QLabel* unit_widget_;                     /**< Label showing parameter unit */
-    QWidget* main_widget_;                    /**< Main widget container */
+    QStaticText label_text_;                  /**< Cached layout of the parameter name */
+    QStaticText unit_text_;                   /**< Cached layout of the unit */
+    QStaticText value_text_;                  /**< Cached layout of the shown value */
+    QFont label_font_;                        /**< Font of name and unit */
+    QFont value_font_;                        /**< Font of the value */
+    QRect label_rect_;                        /**< Area of the parameter name */
+    QRect unit_rect_;                         /**< Area of the unit */
+    QRect value_rect_;                        /**< Area of the value, the only one repainted on value changes */
+    qint64 value_key_;                        /**< Shown value rounded to its precision, as an integer */
+    int value_precision_;                     /**< Decimals of the shown value */
+    bool value_key_valid_;                    /**< Whether value_key_ describes the shown text */
     
     bool label_visible_;                      /**< Whether label is visible */
     bool unit_visible_;                       /**< Whether unit is visible */
@@ -184,6 +246,7 @@ private:
     int label_font_size_;                     /**< Font size for label display */
     QColor background_color_;                 /**< Background color */
     QColor text_color_;                       /**< Text color */
+    QColor current_text_color_;               /**< Text color of the current alarm and blink state */
     
     IParameterModel::AlarmState current_alarm_state_; /**< Current alarm state */
     bool alarm_blink_state_;                  /**< Current blink state for alarms */
@@ -194,8 +257,11 @@ private:
     QColor default_background_color_;         /**< Default background color */
     QColor default_text_color_;               /**< Default text color */
     
-    QTimer blink_timer_;                      /**< Timer for blinking in alarm states */
-    QTimer* update_timer_;                    /**< Timer for periodic updates */
+    qint64 last_poll_time_;                   /**< Frame time of the last model poll */
+    qint64 last_blink_time_;                  /**< Frame time of the last blink toggle */
+    bool polling_;                            /**< Whether the model is polled on frame ticks */
+    bool attached_;                           /**< Whether a frame scheduler drives the view */
+    QRegion pending_region_;                  /**< Areas to repaint on the next frame tick */
     
     mutable QMutex mutex_;                    /**< Thread safety */
 };
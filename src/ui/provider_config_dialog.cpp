@@ -21,6 +21,7 @@
 #include <QDialogButtonBox>
 #include <QMessageBox>
 #include "../../include/config_manager.h"
+#include "../../include/vital_sync_types.h"
 #include <QTabWidget>
 #include <QPushButton>
 #include <QFileDialog>
@@ -133,6 +134,11 @@ void ProviderConfigDialog::CreateControls()
     frequency_spin_box_ = nullptr;
     noise_spin_box_ = nullptr;
     artifacts_check_box_ = nullptr;
+    load_mode_check_box_ = nullptr;
+    load_sample_rate_spin_box_ = nullptr;
+    load_channels_spin_box_ = nullptr;
+    load_beds_spin_box_ = nullptr;
+    load_max_rate_check_box_ = nullptr;
     
     host_line_edit_ = nullptr;
     port_spin_box_ = nullptr;
@@ -142,6 +148,7 @@ void ProviderConfigDialog::CreateControls()
     
     file_path_line_edit_ = nullptr;
     playback_speed_spin_box_ = nullptr;
+    max_speed_check_box_ = nullptr;
     loop_check_box_ = nullptr;
 }
 
@@ -251,10 +258,35 @@ QWidget* ProviderConfigDialog::CreateDemoProviderControls()
             this, &ProviderConfigDialog::OnDemoUpdateIntervalChanged);
     timingLayout->addRow(tr("Update Interval:"), update_interval_spin_box_);
     
+    // Load tab
+    QWidget* loadTab = new QWidget();
+    QFormLayout* loadLayout = new QFormLayout(loadTab);
+    
+    load_mode_check_box_ = new QCheckBox(tr("Generate Synthetic Load"));
+    loadLayout->addRow("", load_mode_check_box_);
+    
+    load_sample_rate_spin_box_ = new QSpinBox();
+    load_sample_rate_spin_box_->setRange(50, 4000);
+    load_sample_rate_spin_box_->setSingleStep(50);
+    load_sample_rate_spin_box_->setSuffix(tr(" Hz"));
+    loadLayout->addRow(tr("Sample Rate:"), load_sample_rate_spin_box_);
+    
+    load_channels_spin_box_ = new QSpinBox();
+    load_channels_spin_box_->setRange(1, VitalSync::WAVEFORM_TYPE_COUNT);
+    loadLayout->addRow(tr("Channels:"), load_channels_spin_box_);
+    
+    load_beds_spin_box_ = new QSpinBox();
+    load_beds_spin_box_->setRange(1, 64);
+    loadLayout->addRow(tr("Simulated Beds:"), load_beds_spin_box_);
+    
+    load_max_rate_check_box_ = new QCheckBox(tr("Run at Maximum Rate"));
+    loadLayout->addRow("", load_max_rate_check_box_);
+    
     // Add tabs to tab widget
     tabWidget->addTab(parametersTab, tr("Parameters"));
     tabWidget->addTab(waveformTab, tr("Waveform"));
     tabWidget->addTab(timingTab, tr("Timing"));
+    tabWidget->addTab(loadTab, tr("Load"));
     
     layout->addWidget(tabWidget);
     
@@ -338,7 +370,7 @@ QWidget* ProviderConfigDialog::CreateFileProviderControls()
     
     connect(browseButton, &QPushButton::clicked, [this]() {
         QString filePath = QFileDialog::getOpenFileName(this, tr("Select Data File"), 
-                                                      "", tr("Data Files (*.dat *.bin *.csv);;All Files (*.*)"));
+                                                      "", tr("Recordings (*.vsr);;All Files (*.*)"));
         if (!filePath.isEmpty()) {
             file_path_line_edit_->setText(filePath);
         }
@@ -354,6 +386,10 @@ QWidget* ProviderConfigDialog::CreateFileProviderControls()
     playback_speed_spin_box_->setSuffix(tr("x"));
     playbackLayout->addRow(tr("Playback Speed:"), playback_speed_spin_box_);
     
+    max_speed_check_box_ = new QCheckBox(tr("Maximum Speed"));
+    playbackLayout->addRow("", max_speed_check_box_);
+    connect(max_speed_check_box_, &QCheckBox::toggled, playback_speed_spin_box_, &QWidget::setDisabled);
+    
     loop_check_box_ = new QCheckBox(tr("Loop Playback"));
     playbackLayout->addRow("", loop_check_box_);
     
@@ -514,6 +550,22 @@ void ProviderConfigDialog::UpdateConfigFromControls()
         if (artifacts_check_box_)
             config_["artifacts"] = artifacts_check_box_->isChecked();
         
+        // Get load generator values
+        if (load_mode_check_box_)
+            config_["loadMode"] = load_mode_check_box_->isChecked();
+        
+        if (load_sample_rate_spin_box_)
+            config_["loadSampleRate"] = load_sample_rate_spin_box_->value();
+        
+        if (load_channels_spin_box_)
+            config_["loadChannels"] = load_channels_spin_box_->value();
+        
+        if (load_beds_spin_box_)
+            config_["loadBeds"] = load_beds_spin_box_->value();
+        
+        if (load_max_rate_check_box_)
+            config_["loadMaxRate"] = load_max_rate_check_box_->isChecked();
+        
     } else if (provider_name_ == "Network") {
         // Get network provider values
         if (host_line_edit_)
@@ -539,6 +591,9 @@ void ProviderConfigDialog::UpdateConfigFromControls()
         if (playback_speed_spin_box_)
             config_["playbackSpeed"] = playback_speed_spin_box_->value();
         
+        if (max_speed_check_box_)
+            config_["maxSpeed"] = max_speed_check_box_->isChecked();
+        
         if (loop_check_box_)
             config_["loop"] = loop_check_box_->isChecked();
     }
@@ -599,6 +654,22 @@ void ProviderConfigDialog::ApplyConfigToControls()
         if (artifacts_check_box_)
             artifacts_check_box_->setChecked(config_.value("artifacts", false).toBool());
         
+        // Set load generator values
+        if (load_mode_check_box_)
+            load_mode_check_box_->setChecked(config_.value("loadMode", false).toBool());
+        
+        if (load_sample_rate_spin_box_)
+            load_sample_rate_spin_box_->setValue(config_.value("loadSampleRate", 500).toInt());
+        
+        if (load_channels_spin_box_)
+            load_channels_spin_box_->setValue(config_.value("loadChannels", VitalSync::WAVEFORM_TYPE_COUNT).toInt());
+        
+        if (load_beds_spin_box_)
+            load_beds_spin_box_->setValue(config_.value("loadBeds", 16).toInt());
+        
+        if (load_max_rate_check_box_)
+            load_max_rate_check_box_->setChecked(config_.value("loadMaxRate", false).toBool());
+        
     } else if (provider_name_ == "Network") {
         // Set network provider values
         if (host_line_edit_)
@@ -629,6 +700,9 @@ void ProviderConfigDialog::ApplyConfigToControls()
         if (playback_speed_spin_box_)
             playback_speed_spin_box_->setValue(config_.value("playbackSpeed", 1.0).toDouble());
         
+        if (max_speed_check_box_)
+            max_speed_check_box_->setChecked(config_.value("maxSpeed", false).toBool());
+        
         if (loop_check_box_)
             loop_check_box_->setChecked(config_.value("loop", true).toBool());
     }
@@ -206,6 +206,11 @@ private:
     QDoubleSpinBox* frequency_spin_box_;     /**< Control for waveform frequency */
     QDoubleSpinBox* noise_spin_box_;         /**< Control for simulated noise level */
     QCheckBox* artifacts_check_box_;         /**< Control for enabling simulated artifacts */
+    QCheckBox* load_mode_check_box_;         /**< Control for enabling the synthetic load generator */
+    QSpinBox* load_sample_rate_spin_box_;    /**< Control for the load generator sample rate */
+    QSpinBox* load_channels_spin_box_;       /**< Control for the number of load generator channels */
+    QSpinBox* load_beds_spin_box_;           /**< Control for the number of simulated beds */
+    QCheckBox* load_max_rate_check_box_;     /**< Control for running the load generator at maximum rate */
     
     /**
      * @brief Network provider controls
@@ -221,6 +226,7 @@ private:
      */
     QLineEdit* file_path_line_edit_;         /**< Control for data file path */
     QDoubleSpinBox* playback_speed_spin_box_; /**< Control for playback speed multiplier */
+    QCheckBox* max_speed_check_box_;         /**< Control for replaying as fast as possible */
     QCheckBox* loop_check_box_;              /**< Control for enabling loop playback */
 };
 
@@ -0,0 +1,216 @@
+/**
+ * @file quality_governor.cpp
+ * @brief Implementation of the QualityGovernor class
+ *
+ * This file implements the QualityGovernor class, which moves the rendering
+ * quality of a window up and down with the punctuality of its display clock.
+ */
+#include "quality_governor.h"
+#include "frame_scheduler.h"
+#include "../utils/log_categories.h"
+
+/**
+ * @brief Constructs the governor
+ * @param scheduler Display clock whose ticks are watched
+ * @param parent Parent QObject
+ *
+ * The governor starts enabled at full quality.
+ */
+QualityGovernor::QualityGovernor(FrameScheduler* scheduler, QObject* parent)
+    : QObject(parent)
+    , scheduler_(scheduler)
+    , enabled_(true)
+    , level_(Level::Full)
+    , window_start_(-1)
+    , window_ticks_(0)
+    , late_ticks_(0)
+    , calm_windows_(0)
+{
+    if (scheduler_) {
+        connect(scheduler_, &FrameScheduler::frameTick, this, &QualityGovernor::HandleFrameTick);
+    }
+}
+
+/**
+ * @brief Enables or disables the governor
+ * @param enabled False returns to full quality and keeps it
+ */
+void QualityGovernor::SetEnabled(bool enabled)
+{
+    if (enabled_ == enabled) {
+        return;
+    }
+
+    enabled_ = enabled;
+    window_start_ = -1;
+    calm_windows_ = 0;
+    if (!enabled_) {
+        setLevel(Level::Full);
+    }
+}
+
+/**
+ * @brief Checks if the governor is enabled
+ * @return True if the level follows the load
+ */
+bool QualityGovernor::IsEnabled() const
+{
+    return enabled_;
+}
+
+/**
+ * @brief Gets the current level
+ * @return Degradation step in effect
+ */
+QualityGovernor::Level QualityGovernor::GetLevel() const
+{
+    return level_;
+}
+
+/**
+ * @brief Gets the rendering settings of a view at the current level
+ * @param background True for views of a bed that is not in focus
+ * @param alarming True for views of a bed with an active alarm
+ * @return Settings to pass to IWaveformView::SetRenderQuality()
+ *
+ * A bed in alarm is exempt at every level, so its waveforms stay exactly as
+ * the clinician expects them while other beds give up detail.
+ */
+IWaveformView::RenderQuality QualityGovernor::GetRenderQuality(bool background, bool alarming) const
+{
+    IWaveformView::RenderQuality quality;
+    if (alarming) {
+        return quality;
+    }
+
+    if (level_ >= Level::NoAntialiasing) {
+        quality.antialiasing = false;
+    }
+    if (level_ >= Level::ReducedBackgroundRate && background) {
+        quality.frameDivisor = BACKGROUND_FRAME_DIVISOR;
+    }
+    if (level_ >= Level::SimplifiedGrid) {
+        quality.simplifiedGrid = true;
+    }
+    if (level_ >= Level::CoarseDecimation) {
+        quality.decimation = COARSE_DECIMATION;
+    }
+    return quality;
+}
+
+/**
+ * @brief Gets the display name of a level
+ * @param level Level
+ * @return Name
+ */
+QString QualityGovernor::GetName(Level level)
+{
+    switch (level) {
+        case Level::Full:                   return QStringLiteral("Full");
+        case Level::NoAntialiasing:         return QStringLiteral("No antialiasing");
+        case Level::ReducedBackgroundRate:  return QStringLiteral("Reduced background rate");
+        case Level::SimplifiedGrid:         return QStringLiteral("Simplified grid");
+        case Level::CoarseDecimation:       return QStringLiteral("Coarse decimation");
+        default:                            return QStringLiteral("Unknown");
+    }
+}
+
+/**
+ * @brief Counts a tick and closes the evaluation window when it is over
+ * @param frameTimeMs Monotonic frame time in milliseconds
+ *
+ * The first tick after the scheduler starts has no interval and begins a
+ * new window, so time spent stopped is never mistaken for load.
+ */
+void QualityGovernor::HandleFrameTick(qint64 frameTimeMs)
+{
+    if (!enabled_) {
+        return;
+    }
+
+    const qint64 intervalUs = scheduler_->GetLastFrameInterval();
+    if (window_start_ < 0 || intervalUs <= 0) {
+        restartWindow(frameTimeMs);
+        return;
+    }
+
+    ++window_ticks_;
+    if (intervalUs > LATE_TICK_FACTOR * 1000.0 * scheduler_->GetFrameInterval()) {
+        ++late_ticks_;
+    }
+
+    const qint64 windowMs = frameTimeMs - window_start_;
+    if (windowMs >= EVALUATION_WINDOW_MS) {
+        evaluateWindow(windowMs);
+        restartWindow(frameTimeMs);
+    }
+}
+
+/**
+ * @brief Judges a closed evaluation window and moves the level
+ * @param windowMs Length of the window in milliseconds
+ *
+ * Late ticks show that the GUI thread as a whole falls behind; the paint
+ * share shows how much of that the views cause, and is only known while
+ * metrics are recorded. Under pressure the level rises by one step per
+ * window, so each step gets a window to show its effect before the next.
+ */
+void QualityGovernor::evaluateWindow(qint64 windowMs)
+{
+    const double lateShare = window_ticks_ > 0 ? static_cast<double>(late_ticks_) / window_ticks_ : 0.0;
+
+    double paintShare = 0.0;
+    if (Metrics::IsEnabled() && window_metrics_.takenAt != 0) {
+        const Metrics::Snapshot interval = Metrics::TakeSnapshot().Since(window_metrics_);
+        const quint64 paintUs = interval.Get(Metrics::Histogram::WaveformPaint).sum
+                                + interval.Get(Metrics::Histogram::GlWaveformPaint).sum
+                                + interval.Get(Metrics::Histogram::ParameterPaint).sum;
+        paintShare = static_cast<double>(paintUs) / (1000.0 * windowMs);
+    }
+
+    if (lateShare >= PRESSURE_LATE_SHARE || paintShare >= PRESSURE_PAINT_SHARE) {
+        calm_windows_ = 0;
+        if (level_ != Level::CoarseDecimation) {
+            qCInfo(lcDisplay).nospace() << "Display under load: " << qRound(lateShare * 100.0) << "% late frames, "
+                                        << qRound(paintShare * 100.0) << "% painting";
+            setLevel(static_cast<Level>(static_cast<int>(level_) + 1));
+        }
+        return;
+    }
+
+    if (lateShare < CALM_LATE_SHARE && paintShare < CALM_PAINT_SHARE) {
+        if (++calm_windows_ >= RECOVERY_WINDOWS && level_ != Level::Full) {
+            calm_windows_ = 0;
+            setLevel(static_cast<Level>(static_cast<int>(level_) - 1));
+        }
+    } else {
+        calm_windows_ = 0;
+    }
+}
+
+/**
+ * @brief Starts a new evaluation window
+ * @param frameTimeMs Frame time the window starts at
+ */
+void QualityGovernor::restartWindow(qint64 frameTimeMs)
+{
+    window_start_ = frameTimeMs;
+    window_ticks_ = 0;
+    late_ticks_ = 0;
+    window_metrics_ = Metrics::IsEnabled() ? Metrics::TakeSnapshot() : Metrics::Snapshot();
+}
+
+/**
+ * @brief Changes the level and announces it
+ * @param level New level
+ */
+void QualityGovernor::setLevel(Level level)
+{
+    if (level_ == level) {
+        return;
+    }
+
+    level_ = level;
+    qCInfo(lcDisplay) << "Render quality:" << GetName(level_);
+    emit levelChanged(level_);
+}
@@ -0,0 +1,157 @@
+/**
+ * @file quality_governor.h
+ * @brief Definition of the QualityGovernor class
+ *
+ * This file contains the definition of the QualityGovernor class, which
+ * watches how punctually the display clock ticks and lowers the rendering
+ * effort of the views step by step while the GUI thread cannot keep up.
+ */
+#ifndef QUALITY_GOVERNOR_H
+#define QUALITY_GOVERNOR_H
+
+#include <QObject>
+#include <QString>
+
+#include "../../include/i_waveform_view.h"
+#include "../utils/metrics.h"
+
+class FrameScheduler;
+
+/**
+ * @brief Adaptive rendering quality of a window
+ *
+ * Every tick the governor reads the measured interval from the
+ * FrameScheduler. Over an evaluation window of EVALUATION_WINDOW_MS it counts
+ * the ticks that arrived later than LATE_TICK_FACTOR times the nominal
+ * interval and, while metrics are recorded, the share of the window spent
+ * painting views. A window with too many late ticks or too much painting
+ * raises the level by one step, so the cost drops in this order:
+ *
+ * 1. NoAntialiasing: traces are drawn without antialiasing.
+ * 2. ReducedBackgroundRate: background beds update at a fraction of the
+ *    frame rate.
+ * 3. SimplifiedGrid: the minor grid lines are left out.
+ * 4. CoarseDecimation: neighbouring pixel columns are merged into one line.
+ *
+ * Each step applies to all levels above it. The level only drops again
+ * after RECOVERY_WINDOWS calm windows in a row, so quality comes back once
+ * the load is gone without flapping at the threshold.
+ *
+ * Views of a bed with an active alarm always get full quality; who is in
+ * alarm and who is in the background is decided by the owner of the views,
+ * which asks GetRenderQuality() for their settings whenever the level or
+ * their state changes.
+ */
+class QualityGovernor : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Degradation steps, from full quality to the cheapest rendering
+     */
+    enum class Level {
+        Full,                   ///< Everything at full quality
+        NoAntialiasing,         ///< Antialiasing off
+        ReducedBackgroundRate,  ///< Background beds at a lower frame rate
+        SimplifiedGrid,         ///< Major grid lines only
+        CoarseDecimation        ///< Pixel columns merged into wider trace lines
+    };
+
+    static constexpr int EVALUATION_WINDOW_MS = 1000;       ///< Length of one evaluation window
+    static constexpr double LATE_TICK_FACTOR = 1.5;         ///< A tick is late beyond this multiple of the nominal interval
+    static constexpr double PRESSURE_LATE_SHARE = 0.2;      ///< Share of late ticks that raises the level
+    static constexpr double CALM_LATE_SHARE = 0.05;         ///< Share of late ticks a calm window stays below
+    static constexpr double PRESSURE_PAINT_SHARE = 0.6;     ///< Share of the window spent painting that raises the level
+    static constexpr double CALM_PAINT_SHARE = 0.3;         ///< Share of the window spent painting a calm window stays below
+    static constexpr int RECOVERY_WINDOWS = 3;              ///< Calm windows in a row that lower the level
+    static constexpr int BACKGROUND_FRAME_DIVISOR = 2;      ///< Frame divisor of background beds from ReducedBackgroundRate on
+    static constexpr int COARSE_DECIMATION = 2;             ///< Columns per trace line at CoarseDecimation
+
+    /**
+     * @brief Constructor
+     * @param scheduler Display clock whose ticks are watched
+     * @param parent Parent QObject
+     */
+    explicit QualityGovernor(FrameScheduler* scheduler, QObject* parent = nullptr);
+
+    /**
+     * @brief Enable or disable the governor
+     * @param enabled False returns to full quality and keeps it
+     */
+    void SetEnabled(bool enabled);
+
+    /**
+     * @brief Check if the governor is enabled
+     * @return True if the level follows the load
+     */
+    bool IsEnabled() const;
+
+    /**
+     * @brief Get the current level
+     * @return Degradation step in effect
+     */
+    Level GetLevel() const;
+
+    /**
+     * @brief Get the rendering settings of a view at the current level
+     * @param background True for views of a bed that is not in focus
+     * @param alarming True for views of a bed with an active alarm
+     * @return Settings to pass to IWaveformView::SetRenderQuality()
+     */
+    IWaveformView::RenderQuality GetRenderQuality(bool background, bool alarming) const;
+
+    /**
+     * @brief Get the display name of a level
+     * @param level Level
+     * @return Name
+     */
+    static QString GetName(Level level);
+
+signals:
+    /**
+     * @brief Signal emitted when the level changes
+     * @param level New level
+     */
+    void levelChanged(QualityGovernor::Level level);
+
+private slots:
+    /**
+     * @brief Counts a tick and closes the evaluation window when it is over
+     * @param frameTimeMs Monotonic frame time in milliseconds
+     */
+    void HandleFrameTick(qint64 frameTimeMs);
+
+private:
+    /**
+     * @brief Judges a closed evaluation window and moves the level
+     * @param windowMs Length of the window in milliseconds
+     */
+    void evaluateWindow(qint64 windowMs);
+
+    /**
+     * @brief Starts a new evaluation window
+     * @param frameTimeMs Frame time the window starts at
+     */
+    void restartWindow(qint64 frameTimeMs);
+
+    /**
+     * @brief Changes the level and announces it
+     * @param level New level
+     */
+    void setLevel(Level level);
+
+private:
+    FrameScheduler* scheduler_;         ///< Display clock whose ticks are watched
+    bool enabled_;                      ///< Whether the level follows the load
+    Level level_;                       ///< Degradation step in effect
+
+    // Evaluation window
+    qint64 window_start_;               ///< Frame time the window started at, -1 before the first tick
+    int window_ticks_;                  ///< Ticks in the window
+    int late_ticks_;                    ///< Late ticks in the window
+    int calm_windows_;                  ///< Calm windows in a row
+    Metrics::Snapshot window_metrics_;  ///< Metrics at the start of the window, empty while metrics are off
+};
+
+#endif // QUALITY_GOVERNOR_H
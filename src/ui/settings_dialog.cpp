@@ -18,9 +18,11 @@
 #include <QTabWidget>
 #include <QPushButton>
 #include <QCheckBox>
+#include <QComboBox>
 #include <QColorDialog>
 #include <QPixmap>
 #include <QIcon>
+#include <algorithm>
 #include "../../include/config_manager.h"
 
 /**
@@ -143,6 +145,13 @@ QWidget* SettingsDialog::CreateGeneralTab()
     sweep__speed_spin_box->setToolTip(tr("Waveform sweep speed in mm per second"));
     formLayout->addRow(tr("Sweep Speed:"), sweep__speed_spin_box);
     
+    // Waveform renderer
+    waveform_renderer_combo_box_ = new QComboBox();
+    waveform_renderer_combo_box_->addItem(tr("Raster (CPU)"), QStringLiteral("raster"));
+    waveform_renderer_combo_box_->addItem(tr("OpenGL (GPU)"), QStringLiteral("opengl"));
+    waveform_renderer_combo_box_->setToolTip(tr("How waveforms are drawn. OpenGL offloads the traces to the graphics card."));
+    formLayout->addRow(tr("Waveform Renderer:"), waveform_renderer_combo_box_);
+    
     // Grid options
     QGroupBox* gridGroup = new QGroupBox(tr("Grid Options"));
     QVBoxLayout* gridLayout = new QVBoxLayout(gridGroup);
@@ -542,9 +551,11 @@ void SettingsDialog::LoadSettings()
     bool showGrid = config.GetBool("ui/showGrid", true);
     bool showTimeScale = config.GetBool("ui/showTimeScale", true);
     bool showAmplitudeScale = config.GetBool("ui/showAmplitudeScale", true);
+    QString renderer = config.GetString("ui/waveformRenderer", "raster");
     
     // Set general UI values
     sweep__speed_spin_box->setValue(sweepSpeed);
+    waveform_renderer_combo_box_->setCurrentIndex(std::max(waveform_renderer_combo_box_->findData(renderer), 0));
     UpdateButtonColor(grid__color_button, grid_color_);
     UpdateButtonColor(background__color_button, background_color_);
     
@@ -616,6 +627,7 @@ void SettingsDialog::SaveSettings()
     
     // Save general settings
     config.SetDouble("ui/defaultSweepSpeed", sweep__speed_spin_box->value());
+    config.SetString("ui/waveformRenderer", waveform_renderer_combo_box_->currentData().toString());
     config.setColor("ui/defaultGridColor", grid_color_);
     config.setColor("ui/defaultBackgroundColor", background_color_);
     
@@ -10,6 +10,7 @@
 #include <QMap>
 #include <QColor>
 #include <QCheckBox>
+#include <QComboBox>
 #include <QColorDialog>
 #include <QDoubleSpinBox>
 #include <QGroupBox>
@@ -263,6 +264,7 @@ private:
      * @brief UI elements for general settings
      */
     QDoubleSpinBox* sweep__speed_spin_box;      /**< Control for setting waveform sweep speed */
+    QComboBox* waveform_renderer_combo_box_;    /**< Selects the raster or OpenGL waveform view */
     QPushButton* background__color_button;      /**< Button for selecting background color */
     QPushButton* grid__color_button;            /**< Button for selecting grid color */
     QCheckBox* show__grid_checkBox;             /**< Option to show/hide the grid on waveforms */
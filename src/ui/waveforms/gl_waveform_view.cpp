@@ -0,0 +1,904 @@
+/**
+ * @file gl_waveform_view.cpp
+ * @brief Implementation of the GLWaveformView class
+ *
+ * This file contains the implementation of the GLWaveformView class, which
+ * draws physiological waveforms with OpenGL. The sweep lives in a ring of
+ * vertex buffer slots on the GPU and is drawn with a small line shader; grid
+ * and labels are drawn with QPainter into cached layers.
+ */
+#include "gl_waveform_view.h"
+#include "../frame_scheduler.h"
+#include "../../../include/vital_sync_types.h"
+#include "../../utils/metrics.h"
+#include <QOpenGLContext>
+#include <QPainter>
+#include <QVector2D>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+/**
+ * @namespace Anonymous namespace for constants
+ * @brief Contains constants used by the GLWaveformView implementation
+ */
+namespace {
+    const int DEFAULT_GRID_MAJOR_X = 50;    /**< Default major grid spacing in X direction */
+    const int DEFAULT_GRID_MAJOR_Y = 50;    /**< Default major grid spacing in Y direction */
+    const int DEFAULT_GRID_MINOR_X = 10;    /**< Default minor grid spacing in X direction */
+    const int DEFAULT_GRID_MINOR_Y = 10;    /**< Default minor grid spacing in Y direction */
+    const int LABEL_MARGIN = 5;             /**< Margin for labels in pixels */
+    const int WAVEFORM_MARGIN = 20;         /**< Margin around waveform in pixels */
+    const double MM_PER_INCH = 25.4;        /**< Millimetres per inch, for converting the sweep speed */
+    const int ERASE_BAR_WIDTH = 12;         /**< Width of the blank bar ahead of the sweep cursor in pixels */
+    const float TRACE_LINE_WIDTH = 1.5f;    /**< Trace line width in pixels */
+    const int MAX_RING_SLOTS = 1 << 20;     /**< Upper bound for the slots of one sweep */
+    const double RING_RESIZE_TOLERANCE = 0.05; /**< Relative sample rate change that resizes the ring */
+
+    const int SLOT_ATTRIBUTE = 0;           /**< Attribute location of the slot index */
+    const int VALUE_ATTRIBUTE = 1;          /**< Attribute location of the sample value */
+
+    /**
+     * @brief Vertex shader placing each ring slot on the sweep
+     *
+     * The slot index maps linearly to x, the sample value maps linearly to y
+     * and is clamped to the plot area.
+     */
+    const char* const TRACE_VERTEX_SHADER =
+        "attribute float a_slot;\n"
+        "attribute float a_value;\n"
+        "uniform vec2 u_slotToX;\n"
+        "uniform vec2 u_valueToY;\n"
+        "uniform vec2 u_yLimits;\n"
+        "void main() {\n"
+        "    float x = a_slot * u_slotToX.x + u_slotToX.y;\n"
+        "    float y = clamp(a_value * u_valueToY.x + u_valueToY.y, u_yLimits.x, u_yLimits.y);\n"
+        "    gl_Position = vec4(x, y, 0.0, 1.0);\n"
+        "}\n";
+
+    /**
+     * @brief Fragment shader filling the trace with a flat color
+     */
+    const char* const TRACE_FRAGMENT_SHADER =
+        "#ifdef GL_ES\n"
+        "precision mediump float;\n"
+        "#endif\n"
+        "uniform vec4 u_color;\n"
+        "void main() {\n"
+        "    gl_FragColor = u_color;\n"
+        "}\n";
+}
+
+/**
+ * @brief Constructs a GLWaveformView widget
+ * @param parent The parent widget
+ *
+ * GL resources are created later in initializeGL(), once the widget has a
+ * context.
+ */
+GLWaveformView::GLWaveformView(QWidget* parent)
+    : QOpenGLWidget(parent)
+    , model_(nullptr)
+    , read_sequence_(0)
+    , last_sample_(0.0f)
+    , has_sample_(false)
+    , unpainted_write_time_(0)
+    , slot_buffer_(QOpenGLBuffer::VertexBuffer)
+    , value_buffer_(QOpenGLBuffer::VertexBuffer)
+    , ring_capacity_(0)
+    , write_slot_(0)
+    , ring_wrapped_(false)
+    , ring_reset_(true)
+    , sweep_speed_(25.0)
+    , grid_visible_(true)
+    , time_scale_visible_(true)
+    , amplitude_scale_visible_(true)
+    , grid_color_(Qt::darkGray)
+    , background_color_(Qt::black)
+    , is_paused_(false)
+    , frame_count_(0)
+{
+    setMinimumSize(300, 100);
+
+    slot_buffer_.setUsagePattern(QOpenGLBuffer::StaticDraw);
+    value_buffer_.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+}
+
+/**
+ * @brief Destroys the GLWaveformView widget
+ *
+ * Disconnects any model signals and releases the GL resources.
+ */
+GLWaveformView::~GLWaveformView()
+{
+    if (model_) {
+        disconnectModelSignals();
+    }
+    cleanupGL();
+}
+
+/**
+ * @brief Gets the widget for this view
+ * @return Pointer to this widget
+ */
+QWidget* GLWaveformView::GetWidget()
+{
+    return this;
+}
+
+/**
+ * @brief Sets the waveform model for this view
+ * @param model The shared pointer to the waveform model
+ *
+ * Disconnects signals from any previous model, sets the new model, restarts
+ * the sweep and connects signals from the new model.
+ */
+void GLWaveformView::SetModel(std::shared_ptr<IWaveformModel> model)
+{
+    QMutexLocker locker(&mutex_);
+
+    if (model_) {
+        disconnectModelSignals();
+    }
+
+    model_ = model;
+    read_sequence_ = 0;
+    has_sample_ = false;
+    unpainted_write_time_ = 0;
+    resetSweep();
+    invalidateStaticLayers();
+
+    if (model_) {
+        connectModelSignals();
+    }
+
+    update();
+}
+
+/**
+ * @brief Gets the current waveform model
+ * @return Shared pointer to the current waveform model or nullptr if none set
+ */
+std::shared_ptr<IWaveformModel> GLWaveformView::GetModel() const
+{
+    QMutexLocker locker(&mutex_);
+    return model_;
+}
+
+/**
+ * @brief Sets the sweep speed
+ * @param pixelsPerSecond The new sweep speed in mm per second
+ *
+ * The number of samples in one sweep changes with the speed, so the GPU ring
+ * is reallocated and the sweep restarts.
+ */
+void GLWaveformView::SetSweepSpeed(double pixelsPerSecond)
+{
+    QMutexLocker locker(&mutex_);
+
+    if (!qFuzzyCompare(sweep_speed_, pixelsPerSecond)) {
+        sweep_speed_ = pixelsPerSecond;
+        resetSweep();
+        invalidateStaticLayers();
+        update();
+    }
+}
+
+/**
+ * @brief Gets the current sweep speed
+ * @return The current sweep speed in mm per second
+ */
+double GLWaveformView::GetSweepSpeed() const
+{
+    QMutexLocker locker(&mutex_);
+    return sweep_speed_;
+}
+
+/**
+ * @brief Sets whether the grid is visible
+ * @param visible True if the grid should be visible, false otherwise
+ */
+void GLWaveformView::SetGridVisible(bool visible)
+{
+    QMutexLocker locker(&mutex_);
+
+    if (grid_visible_ != visible) {
+        grid_visible_ = visible;
+        invalidateStaticLayers();
+        update();
+    }
+}
+
+/**
+ * @brief Gets whether the grid is visible
+ * @return True if the grid is visible, false otherwise
+ */
+bool GLWaveformView::isGridVisible() const
+{
+    QMutexLocker locker(&mutex_);
+    return grid_visible_;
+}
+
+/**
+ * @brief Sets whether the time scale is visible
+ * @param visible True if the time scale should be visible, false otherwise
+ */
+void GLWaveformView::SetTimeScaleVisible(bool visible)
+{
+    QMutexLocker locker(&mutex_);
+
+    if (time_scale_visible_ != visible) {
+        time_scale_visible_ = visible;
+        invalidateStaticLayers();
+        update();
+    }
+}
+
+/**
+ * @brief Gets whether the time scale is visible
+ * @return True if the time scale is visible, false otherwise
+ */
+bool GLWaveformView::isTimeScaleVisible() const
+{
+    QMutexLocker locker(&mutex_);
+    return time_scale_visible_;
+}
+
+/**
+ * @brief Sets whether the amplitude scale is visible
+ * @param visible True if the amplitude scale should be visible, false otherwise
+ */
+void GLWaveformView::SetAmplitudeScaleVisible(bool visible)
+{
+    QMutexLocker locker(&mutex_);
+
+    if (amplitude_scale_visible_ != visible) {
+        amplitude_scale_visible_ = visible;
+        invalidateStaticLayers();
+        update();
+    }
+}
+
+/**
+ * @brief Gets whether the amplitude scale is visible
+ * @return True if the amplitude scale is visible, false otherwise
+ */
+bool GLWaveformView::isAmplitudeScaleVisible() const
+{
+    QMutexLocker locker(&mutex_);
+    return amplitude_scale_visible_;
+}
+
+/**
+ * @brief Sets the grid color
+ * @param color The new grid color
+ */
+void GLWaveformView::SetGridColor(const QColor& color)
+{
+    QMutexLocker locker(&mutex_);
+
+    if (grid_color_ != color) {
+        grid_color_ = color;
+        invalidateStaticLayers();
+        update();
+    }
+}
+
+/**
+ * @brief Gets the grid color
+ * @return The current grid color
+ */
+QColor GLWaveformView::GetGridColor() const
+{
+    QMutexLocker locker(&mutex_);
+    return grid_color_;
+}
+
+/**
+ * @brief Sets the background color
+ * @param color The new background color
+ */
+void GLWaveformView::SetBackgroundColor(const QColor& color)
+{
+    QMutexLocker locker(&mutex_);
+
+    if (background_color_ != color) {
+        background_color_ = color;
+        invalidateStaticLayers();
+        update();
+    }
+}
+
+/**
+ * @brief Gets the background color
+ * @return The current background color
+ */
+QColor GLWaveformView::GetBackgroundColor() const
+{
+    QMutexLocker locker(&mutex_);
+    return background_color_;
+}
+
+/**
+ * @brief Updates the widget
+ *
+ * Calls the base QOpenGLWidget::update() method.
+ */
+void GLWaveformView::update()
+{
+    this->QOpenGLWidget::update();
+}
+
+/**
+ * @brief Sets whether the waveform display is paused
+ * @param paused True to pause the display, false to resume
+ *
+ * When paused, frame ticks are ignored and a "PAUSED" indicator is shown.
+ */
+void GLWaveformView::SetPaused(bool paused)
+{
+    QMutexLocker locker(&mutex_);
+
+    if (is_paused_ != paused) {
+        is_paused_ = paused;
+        update();
+    }
+}
+
+/**
+ * @brief Gets whether the waveform display is paused
+ * @return True if the display is paused, false otherwise
+ */
+bool GLWaveformView::isPaused() const
+{
+    QMutexLocker locker(&mutex_);
+    return is_paused_;
+}
+
+/**
+ * @brief Sets the rendering effort of the view
+ * @param quality Rendering settings
+ *
+ * A new grid setting rebuilds the static layer; the frame divisor applies
+ * from the next frame.
+ */
+void GLWaveformView::SetRenderQuality(const RenderQuality& quality)
+{
+    QMutexLocker locker(&mutex_);
+
+    RenderQuality applied = quality;
+    applied.frameDivisor = std::max(1, quality.frameDivisor);
+    applied.decimation = std::max(1, quality.decimation);
+    if (quality_ == applied) {
+        return;
+    }
+
+    const bool gridChanged = quality_.simplifiedGrid != applied.simplifiedGrid;
+    quality_ = applied;
+    if (gridChanged) {
+        invalidateStaticLayers();
+        update();
+    }
+}
+
+/**
+ * @brief Gets the rendering effort of the view
+ * @return Rendering settings in use
+ */
+IWaveformView::RenderQuality GLWaveformView::GetRenderQuality() const
+{
+    QMutexLocker locker(&mutex_);
+    return quality_;
+}
+
+/**
+ * @brief Connects this view to the shared display clock
+ * @param scheduler The frame scheduler that drives the view
+ */
+void GLWaveformView::AttachToScheduler(FrameScheduler* scheduler)
+{
+    if (scheduler) {
+        connect(scheduler, &FrameScheduler::frameTick, this, &GLWaveformView::OnFrame);
+    }
+}
+
+/**
+ * @brief Handles a tick of the shared display clock
+ * @param frameTimeMs Monotonic frame time in milliseconds
+ *
+ * Ticks are skipped while the view is paused, scrolled out of sight, or the
+ * model has not received samples since the previous frame. With a frame
+ * divisor of n only every n-th tick is handled; the ring then takes the
+ * samples of several frames in one upload.
+ */
+void GLWaveformView::OnFrame(qint64 frameTimeMs)
+{
+    Q_UNUSED(frameTimeMs);
+
+    if (is_paused_ || !model_ || visibleRegion().isEmpty()) {
+        return;
+    }
+    if (++frame_count_ % quality_.frameDivisor != 0) {
+        return;
+    }
+    if (model_->GetWriteSequence() == read_sequence_) {
+        return;
+    }
+
+    ingestSamples();
+    update();
+}
+
+/**
+ * @brief Creates the shader program and the ring buffers
+ *
+ * Also called again when the widget gets a new context, e.g. after being
+ * reparented into another window, so the ring restarts empty.
+ */
+void GLWaveformView::initializeGL()
+{
+    initializeOpenGLFunctions();
+    connect(context(), &QOpenGLContext::aboutToBeDestroyed, this, &GLWaveformView::cleanupGL,
+            Qt::UniqueConnection);
+
+    auto program = std::make_unique<QOpenGLShaderProgram>();
+    if (!program->addShaderFromSourceCode(QOpenGLShader::Vertex, TRACE_VERTEX_SHADER) ||
+        !program->addShaderFromSourceCode(QOpenGLShader::Fragment, TRACE_FRAGMENT_SHADER)) {
+        qWarning() << "GLWaveformView: Failed to compile trace shader:" << program->log();
+        return;
+    }
+    program->bindAttributeLocation("a_slot", SLOT_ATTRIBUTE);
+    program->bindAttributeLocation("a_value", VALUE_ATTRIBUTE);
+    if (!program->link()) {
+        qWarning() << "GLWaveformView: Failed to link trace shader:" << program->log();
+        return;
+    }
+
+    if (!slot_buffer_.create() || !value_buffer_.create()) {
+        qWarning() << "GLWaveformView: Failed to create vertex buffers";
+        slot_buffer_.destroy();
+        value_buffer_.destroy();
+        return;
+    }
+
+    program_ = std::move(program);
+
+    QMutexLocker locker(&mutex_);
+    resetSweep();
+}
+
+/**
+ * @brief Handles a resize of the GL surface
+ * @param w New width in pixels
+ * @param h New height in pixels
+ *
+ * Ring slots map to x positions across the width, so a new width restarts
+ * the sweep.
+ */
+void GLWaveformView::resizeGL(int w, int h)
+{
+    Q_UNUSED(w);
+    Q_UNUSED(h);
+
+    QMutexLocker locker(&mutex_);
+    resetSweep();
+    invalidateStaticLayers();
+}
+
+/**
+ * @brief Uploads new samples and draws the view
+ *
+ * Composites the cached background and grid, draws the trace from the GPU
+ * ring, and composites the cached labels and the pause indicator on top.
+ * The paint duration and the display latency of newly uploaded samples are
+ * recorded in the metrics.
+ */
+void GLWaveformView::paintGL()
+{
+    ScopedMetricsTimer paintTimer(Metrics::Histogram::GlWaveformPaint);
+    QMutexLocker locker(&mutex_);
+    ensureStaticLayers();
+
+    QPainter painter(this);
+    painter.drawImage(0, 0, static_layer_);
+
+    if (model_ && program_) {
+        painter.beginNativePainting();
+        uploadPending();
+        drawTrace();
+        painter.endNativePainting();
+        if (unpainted_write_time_ != 0) {
+            Metrics::RecordSince(Metrics::Histogram::DisplayLatency, unpainted_write_time_);
+            unpainted_write_time_ = 0;
+        }
+    }
+
+    painter.drawImage(0, 0, label_layer_);
+
+    if (is_paused_) {
+        painter.setPen(QPen(Qt::white, 2));
+        QFont pauseFont = painter.font();
+        pauseFont.setBold(true);
+        pauseFont.setPointSize(14);
+        painter.setFont(pauseFont);
+        painter.drawText(rect(), Qt::AlignCenter, tr("PAUSED"));
+    }
+}
+
+/**
+ * @brief Handles property changes in the model
+ *
+ * The name and scaling range shown in the labels may have changed. The trace
+ * picks up a new scaling range through the shader uniforms on the next paint.
+ */
+void GLWaveformView::HandlePropertiesChanged()
+{
+    QMutexLocker locker(&mutex_);
+    invalidateStaticLayers();
+    update();
+}
+
+/**
+ * @brief Releases all GL resources before the context goes away
+ */
+void GLWaveformView::cleanupGL()
+{
+    if (!program_ && !slot_buffer_.isCreated() && !value_buffer_.isCreated()) {
+        return;
+    }
+
+    makeCurrent();
+    slot_buffer_.destroy();
+    value_buffer_.destroy();
+    program_.reset();
+    doneCurrent();
+}
+
+/**
+ * @brief Connects signals from the model
+ *
+ * Only propertiesChanged is connected. New samples are picked up on the next
+ * tick of the shared display clock, as in WaveformView.
+ */
+void GLWaveformView::connectModelSignals()
+{
+    if (model_) {
+        connect(model_.get(), &IWaveformModel::propertiesChanged, this, &GLWaveformView::HandlePropertiesChanged);
+    }
+}
+
+/**
+ * @brief Disconnects signals from the model
+ */
+void GLWaveformView::disconnectModelSignals()
+{
+    if (model_) {
+        disconnect(model_.get(), &IWaveformModel::propertiesChanged, this, &GLWaveformView::HandlePropertiesChanged);
+    }
+}
+
+/**
+ * @brief Reads all samples that arrived since the last frame for upload
+ *
+ * Samples lost to an overrun are filled in with the last value so the sweep
+ * keeps its time axis. The number of slots follows the measured sample rate,
+ * but only restarts the sweep on a change larger than RING_RESIZE_TOLERANCE,
+ * so the jitter of the estimate does not clear the screen.
+ */
+void GLWaveformView::ingestSamples()
+{
+    QMutexLocker locker(&mutex_);
+
+    if (!model_) {
+        return;
+    }
+
+    const int capacity = ringCapacity();
+    if (std::abs(capacity - ring_capacity_) > ring_capacity_ * RING_RESIZE_TOLERANCE) {
+        resetSweep();
+    }
+    if (ring_capacity_ < 2) {
+        return;
+    }
+
+    // Start at the live edge rather than replaying the whole buffer
+    if (!has_sample_ && read_sequence_ == 0) {
+        read_sequence_ = model_->GetWriteSequence();
+    }
+
+    const quint64 firstSequence = model_->ReadSamplesSince(read_sequence_, read_buffer_);
+    if (has_sample_ && firstSequence > read_sequence_) {
+        const quint64 lost = std::min<quint64>(firstSequence - read_sequence_, ring_capacity_);
+        pending_.insert(pending_.size(), static_cast<int>(lost), last_sample_);
+        Metrics::Add(Metrics::Counter::SamplesDropped, firstSequence - read_sequence_);
+    }
+    if (!read_buffer_.isEmpty()) {
+        pending_.append(read_buffer_);
+        last_sample_ = read_buffer_.last();
+        has_sample_ = true;
+        if (unpainted_write_time_ == 0) {
+            unpainted_write_time_ = model_->GetLastWriteTime();
+        }
+    }
+    read_sequence_ = firstSequence + read_buffer_.size();
+
+    // Only the newest sweep can be shown; older samples just move the cursor
+    if (pending_.size() > ring_capacity_) {
+        const int dropped = pending_.size() - ring_capacity_;
+        pending_.remove(0, dropped);
+        write_slot_ = (write_slot_ + dropped) % ring_capacity_;
+        ring_wrapped_ = true;
+    }
+}
+
+/**
+ * @brief Computes the number of ring slots that make up one sweep
+ * @return Number of slots, or 0 if there is nothing to draw
+ *
+ * One sweep spans the widget width at the configured speed, so it holds as
+ * many samples as arrive in the time the sweep takes. The caller must hold
+ * mutex_.
+ */
+int GLWaveformView::ringCapacity() const
+{
+    if (!model_ || width() <= 0) {
+        return 0;
+    }
+
+    const double samplesPerPixel = std::max(model_->GetSampleRate(), 1.0) / std::max(pixelsPerSecond(), 1.0);
+    return std::clamp(static_cast<int>(std::ceil(width() * samplesPerPixel)), 2, MAX_RING_SLOTS);
+}
+
+/**
+ * @brief Clears the sweep and restarts it at the left edge
+ *
+ * The GPU buffers are reallocated on the next paint. The caller must hold
+ * mutex_.
+ */
+void GLWaveformView::resetSweep()
+{
+    ring_capacity_ = ringCapacity();
+    write_slot_ = 0;
+    ring_wrapped_ = false;
+    ring_reset_ = true;
+    pending_.clear();
+}
+
+/**
+ * @brief Writes the pending samples into the GPU ring
+ *
+ * The pending samples start at the write cursor and wrap around the end of
+ * the ring at most once, so they take at most two partial buffer updates.
+ * Called with the context current and mutex_ held.
+ */
+void GLWaveformView::uploadPending()
+{
+    if (ring_capacity_ < 2) {
+        return;
+    }
+
+    if (ring_reset_) {
+        QVector<float> slots(ring_capacity_);
+        std::iota(slots.begin(), slots.end(), 0.0f);
+        slot_buffer_.bind();
+        slot_buffer_.allocate(slots.constData(), ring_capacity_ * static_cast<int>(sizeof(float)));
+
+        const QVector<float> values(ring_capacity_, 0.0f);
+        value_buffer_.bind();
+        value_buffer_.allocate(values.constData(), ring_capacity_ * static_cast<int>(sizeof(float)));
+        value_buffer_.release();
+        ring_reset_ = false;
+    }
+
+    const int count = pending_.size();
+    if (count == 0) {
+        return;
+    }
+
+    const int head = std::min(count, ring_capacity_ - write_slot_);
+    value_buffer_.bind();
+    value_buffer_.write(write_slot_ * static_cast<int>(sizeof(float)), pending_.constData(),
+                        head * static_cast<int>(sizeof(float)));
+    if (count > head) {
+        value_buffer_.write(0, pending_.constData() + head, (count - head) * static_cast<int>(sizeof(float)));
+    }
+    value_buffer_.release();
+
+    if (write_slot_ + count >= ring_capacity_) {
+        ring_wrapped_ = true;
+    }
+    write_slot_ = (write_slot_ + count) % ring_capacity_;
+    pending_.clear();
+}
+
+/**
+ * @brief Draws the ring with the line shader
+ *
+ * The slots behind the write cursor hold the current sweep. Once the sweep
+ * has wrapped, the slots after the erase bar still hold the previous one.
+ * Called with the context current and mutex_ held.
+ */
+void GLWaveformView::drawTrace()
+{
+    if (ring_capacity_ < 2 || ring_reset_ || (write_slot_ == 0 && !ring_wrapped_)) {
+        return;
+    }
+
+    const qreal ratio = devicePixelRatioF();
+    glViewport(0, 0, static_cast<GLsizei>(width() * ratio), static_cast<GLsizei>(height() * ratio));
+
+    // Map values into the plot area between the top and bottom margins
+    const float minValue = model_->GetMinValue();
+    double valueRange = model_->GetMaxValue() - minValue;
+    if (qFuzzyCompare(valueRange, 0.0)) {
+        valueRange = 1.0; // Prevent division by zero
+    }
+    const float margin = 2.0f * WAVEFORM_MARGIN / std::max(height(), 1);
+    const float bottom = std::min(-1.0f + margin, 0.0f);
+    const float top = std::max(1.0f - margin, 0.0f);
+    const float valueScale = static_cast<float>((top - bottom) / valueRange);
+
+    program_->bind();
+    program_->setUniformValue("u_slotToX", QVector2D(2.0f / ring_capacity_, -1.0f + 1.0f / ring_capacity_));
+    program_->setUniformValue("u_valueToY", QVector2D(valueScale, bottom - minValue * valueScale));
+    program_->setUniformValue("u_yLimits", QVector2D(bottom, top));
+    program_->setUniformValue("u_color", traceColor());
+
+    slot_buffer_.bind();
+    program_->enableAttributeArray(SLOT_ATTRIBUTE);
+    program_->setAttributeBuffer(SLOT_ATTRIBUTE, GL_FLOAT, 0, 1);
+    value_buffer_.bind();
+    program_->enableAttributeArray(VALUE_ATTRIBUTE);
+    program_->setAttributeBuffer(VALUE_ATTRIBUTE, GL_FLOAT, 0, 1);
+
+    glLineWidth(TRACE_LINE_WIDTH * static_cast<float>(ratio));
+
+    if (write_slot_ >= 2) {
+        glDrawArrays(GL_LINE_STRIP, 0, write_slot_);
+    }
+    if (ring_wrapped_) {
+        const int eraseSlots = static_cast<int>(std::ceil(ERASE_BAR_WIDTH * static_cast<double>(ring_capacity_) /
+                                                          std::max(width(), 1)));
+        const int first = write_slot_ + eraseSlots;
+        if (ring_capacity_ - first >= 2) {
+            glDrawArrays(GL_LINE_STRIP, first, ring_capacity_ - first);
+        }
+    }
+
+    program_->disableAttributeArray(SLOT_ATTRIBUTE);
+    program_->disableAttributeArray(VALUE_ATTRIBUTE);
+    value_buffer_.release();
+    program_->release();
+}
+
+/**
+ * @brief Rebuilds the cached background and label layers if they are stale
+ *
+ * The layers are plain images, which the OpenGL paint engine uploads as
+ * textures once and reuses until they are rebuilt. The caller must hold
+ * mutex_.
+ */
+void GLWaveformView::ensureStaticLayers()
+{
+    const qreal ratio = devicePixelRatioF();
+    const QSize deviceSize = size() * ratio;
+
+    if (static_layer_.size() != deviceSize) {
+        static_layer_ = QImage(deviceSize, QImage::Format_ARGB32_Premultiplied);
+        static_layer_.setDevicePixelRatio(ratio);
+        static_layer_.fill(background_color_);
+        if (grid_visible_) {
+            QPainter layerPainter(&static_layer_);
+            drawGrid(layerPainter);
+        }
+    }
+
+    if (label_layer_.size() != deviceSize) {
+        label_layer_ = QImage(deviceSize, QImage::Format_ARGB32_Premultiplied);
+        label_layer_.setDevicePixelRatio(ratio);
+        label_layer_.fill(Qt::transparent);
+        QPainter layerPainter(&label_layer_);
+        layerPainter.setFont(font());
+        drawLabels(layerPainter);
+    }
+}
+
+/**
+ * @brief Marks the cached background and label layers as stale
+ *
+ * The caller must hold mutex_.
+ */
+void GLWaveformView::invalidateStaticLayers()
+{
+    static_layer_ = QImage();
+    label_layer_ = QImage();
+}
+
+/**
+ * @brief Draws the grid
+ * @param painter The painter to use
+ *
+ * Draws the same minor and major grid as WaveformView, or the major lines
+ * only when the grid is simplified.
+ */
+void GLWaveformView::drawGrid(QPainter& painter)
+{
+    QRect gridRect = rect().adjusted(WAVEFORM_MARGIN, WAVEFORM_MARGIN,
+                                     -WAVEFORM_MARGIN, -WAVEFORM_MARGIN);
+
+    QPen gridPen(QColor(grid_color_.red(), grid_color_.green(), grid_color_.blue(), 100), 0.7, Qt::DotLine);
+    QPen majorGridPen(grid_color_, 0.9, Qt::SolidLine);
+
+    if (!quality_.simplifiedGrid) {
+        painter.setPen(gridPen);
+        for (int x = gridRect.left(); x <= gridRect.right(); x += DEFAULT_GRID_MINOR_X) {
+            painter.drawLine(x, gridRect.top(), x, gridRect.bottom());
+        }
+        for (int y = gridRect.top(); y <= gridRect.bottom(); y += DEFAULT_GRID_MINOR_Y) {
+            painter.drawLine(gridRect.left(), y, gridRect.right(), y);
+        }
+    }
+
+    painter.setPen(majorGridPen);
+    for (int x = gridRect.left(); x <= gridRect.right(); x += DEFAULT_GRID_MAJOR_X) {
+        painter.drawLine(x, gridRect.top(), x, gridRect.bottom());
+    }
+    for (int y = gridRect.top(); y <= gridRect.bottom(); y += DEFAULT_GRID_MAJOR_Y) {
+        painter.drawLine(gridRect.left(), y, gridRect.right(), y);
+    }
+}
+
+/**
+ * @brief Draws the labels
+ * @param painter The painter to use
+ *
+ * Draws the waveform name, min/max values, and time scale.
+ */
+void GLWaveformView::drawLabels(QPainter& painter)
+{
+    if (!model_) return;
+
+    QRect drawRect = rect();
+    painter.setPen(QPen(Qt::white));
+
+    QFont nameFont = painter.font();
+    nameFont.setBold(true);
+    painter.setFont(nameFont);
+    painter.drawText(drawRect.adjusted(LABEL_MARGIN, LABEL_MARGIN, 0, 0),
+                     Qt::AlignLeft | Qt::AlignTop, model_->GetDisplayName());
+
+    if (amplitude_scale_visible_) {
+        QString minMaxText = QString::number(model_->GetMaxValue(), 'f', 1) + "\n" +
+                             QString::number(model_->GetMinValue(), 'f', 1);
+        painter.drawText(drawRect.adjusted(0, LABEL_MARGIN, -LABEL_MARGIN, 0),
+                         Qt::AlignRight | Qt::AlignTop, minMaxText);
+    }
+
+    if (time_scale_visible_) {
+        QString timeText = QString::number(sweep_speed_, 'f', 1) + " mm/s";
+        painter.drawText(drawRect.adjusted(0, 0, -LABEL_MARGIN, -LABEL_MARGIN),
+                         Qt::AlignRight | Qt::AlignBottom, timeText);
+    }
+}
+
+/**
+ * @brief Gets the trace color of the current model
+ * @return The trace color
+ *
+ * Uses the same conventional monitor colors as WaveformView.
+ */
+QColor GLWaveformView::traceColor() const
+{
+    const VitalSync::WaveformTraits& traits = VitalSync::GetWaveformTraits(model_->GetWaveformId());
+    return traits.conventionalColor ? QColor(traits.color) : model_->GetColor();
+}
+
+/**
+ * @brief Gets the sweep speed converted to screen pixels
+ * @return Sweep speed in pixels per second
+ */
+double GLWaveformView::pixelsPerSecond() const
+{
+    return sweep_speed_ * logicalDpiX() / MM_PER_INCH;
+}
@@ -0,0 +1,334 @@
+/**
+ * @file gl_waveform_view.h
+ * @brief Defines the GLWaveformView class that displays waveform data with OpenGL
+ *
+ * This file contains the GLWaveformView class, a GPU-backed implementation of the
+ * IWaveformView interface. It is a drop-in alternative to the raster WaveformView
+ * for hosts that display many waveforms at once, such as central monitors on thin
+ * clients, where rasterizing every trace on the CPU limits the number of views.
+ */
+#ifndef GL_WAVEFORM_VIEW_H
+#define GL_WAVEFORM_VIEW_H
+
+#include <QOpenGLWidget>
+#include <QOpenGLFunctions>
+#include <QOpenGLBuffer>
+#include <QOpenGLShaderProgram>
+#include <QMutex>
+#include <QColor>
+#include <QImage>
+#include <QVector>
+#include <memory>
+
+#include <i_waveform_model.h>
+#include <i_waveform_view.h>
+
+class FrameScheduler;
+
+/**
+ * @class GLWaveformView
+ * @brief OpenGL widget for displaying physiological waveform data
+ *
+ * The sweep is kept in a ring of vertex buffer slots on the GPU, one slot per
+ * sample of a full sweep, so a slot's index is also its position on screen.
+ * New samples are written into the ring with a partial buffer update at the
+ * write cursor, which then advances and wraps like the sweep of a bedside
+ * monitor. A line shader places every slot at its x position and scales its
+ * value into the plot area, and the slots just ahead of the cursor are left
+ * out of the draw to form the erase bar. Per frame the CPU therefore only
+ * copies the new samples; it never touches trace pixels.
+ *
+ * Background, grid and labels are drawn with QPainter into cached images,
+ * which the OpenGL paint engine keeps as textures until they change.
+ *
+ * Demo models are drawn from the samples they receive like any other model;
+ * the synthesized pixel-step demo traces of WaveformView are not reproduced.
+ */
+class GLWaveformView : public QOpenGLWidget, protected QOpenGLFunctions, public IWaveformView {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor
+     * @param parent The parent widget
+     */
+    explicit GLWaveformView(QWidget* parent = nullptr);
+
+    /**
+     * @brief Destructor
+     */
+    ~GLWaveformView() override;
+
+    /**
+     * @brief Gets the widget for this view
+     * @return Pointer to this widget
+     */
+    QWidget* GetWidget() override;
+
+    /**
+     * @brief Sets the model for this view
+     * @param model The waveform model to display
+     */
+    void SetModel(std::shared_ptr<IWaveformModel> model) override;
+
+    /**
+     * @brief Gets the current model
+     * @return The current waveform model
+     */
+    std::shared_ptr<IWaveformModel> GetModel() const override;
+
+    /**
+     * @brief Sets the sweep speed
+     * @param pixelsPerSecond The sweep speed in mm per second
+     */
+    void SetSweepSpeed(double pixelsPerSecond) override;
+
+    /**
+     * @brief Gets the current sweep speed
+     * @return The sweep speed in mm per second
+     */
+    double GetSweepSpeed() const override;
+
+    /**
+     * @brief Sets whether the grid is visible
+     * @param visible True to show the grid
+     */
+    void SetGridVisible(bool visible) override;
+
+    /**
+     * @brief Gets whether the grid is visible
+     * @return True if the grid is visible
+     */
+    bool isGridVisible() const override;
+
+    /**
+     * @brief Sets whether the time scale is visible
+     * @param visible True to show the time scale
+     */
+    void SetTimeScaleVisible(bool visible) override;
+
+    /**
+     * @brief Gets whether the time scale is visible
+     * @return True if the time scale is visible
+     */
+    bool isTimeScaleVisible() const override;
+
+    /**
+     * @brief Sets whether the amplitude scale is visible
+     * @param visible True to show the amplitude scale
+     */
+    void SetAmplitudeScaleVisible(bool visible) override;
+
+    /**
+     * @brief Gets whether the amplitude scale is visible
+     * @return True if the amplitude scale is visible
+     */
+    bool isAmplitudeScaleVisible() const override;
+
+    /**
+     * @brief Sets the grid color
+     * @param color The grid color
+     */
+    void SetGridColor(const QColor& color) override;
+
+    /**
+     * @brief Gets the grid color
+     * @return The grid color
+     */
+    QColor GetGridColor() const override;
+
+    /**
+     * @brief Sets the background color
+     * @param color The background color
+     */
+    void SetBackgroundColor(const QColor& color) override;
+
+    /**
+     * @brief Gets the background color
+     * @return The background color
+     */
+    QColor GetBackgroundColor() const override;
+
+    /**
+     * @brief Updates the view
+     */
+    void update() override;
+
+    /**
+     * @brief Sets whether the display is paused
+     * @param paused True to pause the display
+     */
+    void SetPaused(bool paused) override;
+
+    /**
+     * @brief Gets whether the display is paused
+     * @return True if the display is paused
+     */
+    bool isPaused() const override;
+
+    /**
+     * @brief Sets the rendering effort of the view
+     * @param quality Rendering settings
+     *
+     * The GPU draws one line strip per sweep whatever the settings, so only
+     * the frame divisor and the simplified grid apply.
+     */
+    void SetRenderQuality(const RenderQuality& quality) override;
+
+    /**
+     * @brief Gets the rendering effort of the view
+     * @return Rendering settings in use
+     */
+    RenderQuality GetRenderQuality() const override;
+
+    /**
+     * @brief Connects this view to the shared display clock
+     * @param scheduler The frame scheduler that drives the view
+     */
+    void AttachToScheduler(FrameScheduler* scheduler);
+
+public slots:
+    /**
+     * @brief Handles a tick of the shared display clock
+     * @param frameTimeMs Monotonic frame time in milliseconds
+     */
+    void OnFrame(qint64 frameTimeMs);
+
+protected:
+    /**
+     * @brief Creates the shader program and the ring buffers
+     */
+    void initializeGL() override;
+
+    /**
+     * @brief Handles a resize of the GL surface
+     * @param w New width in pixels
+     * @param h New height in pixels
+     */
+    void resizeGL(int w, int h) override;
+
+    /**
+     * @brief Uploads new samples and draws the view
+     */
+    void paintGL() override;
+
+private slots:
+    /**
+     * @brief Handles property changed signals from the model
+     */
+    void HandlePropertiesChanged();
+
+    /**
+     * @brief Releases all GL resources before the context goes away
+     */
+    void cleanupGL();
+
+private:
+    /**
+     * @brief Connects model signals
+     */
+    void connectModelSignals();
+
+    /**
+     * @brief Disconnects model signals
+     */
+    void disconnectModelSignals();
+
+    /**
+     * @brief Reads all samples that arrived since the last frame for upload
+     */
+    void ingestSamples();
+
+    /**
+     * @brief Computes the number of ring slots that make up one sweep
+     * @return Number of slots
+     */
+    int ringCapacity() const;
+
+    /**
+     * @brief Clears the sweep and restarts it at the left edge
+     */
+    void resetSweep();
+
+    /**
+     * @brief Writes the pending samples into the GPU ring
+     */
+    void uploadPending();
+
+    /**
+     * @brief Draws the ring with the line shader
+     */
+    void drawTrace();
+
+    /**
+     * @brief Rebuilds the cached background and label layers if they are stale
+     */
+    void ensureStaticLayers();
+
+    /**
+     * @brief Marks the cached background and label layers as stale
+     */
+    void invalidateStaticLayers();
+
+    /**
+     * @brief Draws the grid
+     * @param painter The painter to use
+     */
+    void drawGrid(QPainter& painter);
+
+    /**
+     * @brief Draws the labels
+     * @param painter The painter to use
+     */
+    void drawLabels(QPainter& painter);
+
+    /**
+     * @brief Gets the trace color of the current model
+     * @return The trace color
+     */
+    QColor traceColor() const;
+
+    /**
+     * @brief Gets the sweep speed converted to screen pixels
+     * @return Sweep speed in pixels per second
+     */
+    double pixelsPerSecond() const;
+
+    // Member variables
+    std::shared_ptr<IWaveformModel> model_; /**< The waveform data model */
+    mutable QMutex mutex_; /**< Mutex for thread safety */
+
+    // Model read position
+    quint64 read_sequence_; /**< Next model sample sequence to read */
+    float last_sample_; /**< Most recent sample value */
+    bool has_sample_; /**< Whether last_sample_ holds a real sample */
+    qint64 unpainted_write_time_; /**< Model write time of samples read but not painted yet, 0 if none */
+    QVector<float> read_buffer_; /**< Scratch buffer for reading from the model */
+    QVector<float> pending_; /**< Samples read from the model but not yet uploaded */
+
+    // GPU ring
+    std::unique_ptr<QOpenGLShaderProgram> program_; /**< Line shader for the trace */
+    QOpenGLBuffer slot_buffer_; /**< Static buffer holding the slot indices */
+    QOpenGLBuffer value_buffer_; /**< Ring buffer holding one sample value per slot */
+    int ring_capacity_; /**< Number of slots in one sweep */
+    int write_slot_; /**< Slot the next sample is written to */
+    bool ring_wrapped_; /**< Whether the sweep has wrapped at least once */
+    bool ring_reset_; /**< Whether the GPU buffers must be reallocated before the next upload */
+
+    // Display properties
+    double sweep_speed_; /**< Sweep speed in mm per second */
+    bool grid_visible_; /**< Whether the grid is visible */
+    bool time_scale_visible_; /**< Whether the time scale is visible */
+    bool amplitude_scale_visible_; /**< Whether the amplitude scale is visible */
+    QColor grid_color_; /**< Color of the grid */
+    QColor background_color_; /**< Color of the background */
+    bool is_paused_; /**< Whether the display is paused */
+    RenderQuality quality_; /**< Rendering effort set by the quality governor */
+    quint64 frame_count_; /**< Display ticks seen, to honour the frame divisor */
+
+    // Cached layers
+    QImage static_layer_; /**< Cached background and grid, composited below the trace */
+    QImage label_layer_; /**< Cached name and scale labels, composited above the trace */
+};
+
+#endif // GL_WAVEFORM_VIEW_H
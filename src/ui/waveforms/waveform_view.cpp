@@ -8,14 +8,19 @@
  * and response to user interactions.
  */
 #include "waveform_view.h"
+#include "../frame_scheduler.h"
 #include "../../../include/config_manager.h"
 #include "../../../include/vital_sync_types.h"
+#include "../../utils/log_categories.h"
+#include "../../utils/metrics.h"
+#include "../../utils/signal_kernels.h"
 #include <QPainter>
 #include <QPaintEvent>
 #include <QResizeEvent>
 #include <QDebug>
 #include <QFontMetrics>
 #include <QPainterPath>
+#include <QVarLengthArray>
 #include <algorithm> // For std::min
 #include <cmath>
 
@@ -25,13 +30,59 @@
  */
 // Constants
 namespace {
-    const int UPDATE_INTERVAL_MS = 50;      /**< Update interval in milliseconds */
     const int DEFAULT_GRID_MAJOR_X = 50;    /**< Default major grid spacing in X direction */
     const int DEFAULT_GRID_MAJOR_Y = 50;    /**< Default major grid spacing in Y direction */
     const int DEFAULT_GRID_MINOR_X = 10;    /**< Default minor grid spacing in X direction */
     const int DEFAULT_GRID_MINOR_Y = 10;    /**< Default minor grid spacing in Y direction */
     const int LABEL_MARGIN = 5;             /**< Margin for labels in pixels */
     const int WAVEFORM_MARGIN = 20;         /**< Margin around waveform in pixels */
+    const double MM_PER_INCH = 25.4;        /**< Millimetres per inch, for converting the sweep speed */
+    const int TRACE_REPAINT_MARGIN = 2;     /**< Extra pixels repainted around changed columns */
+    const int ERASE_BAR_WIDTH = 12;         /**< Width of the blank bar ahead of the sweep cursor in pixels */
+    const qint64 DEFAULT_OVERVIEW_SPAN_MS = 10 * 60 * 1000; /**< Default overview window of ten minutes */
+
+    /**
+     * @brief Maps a range of sweep columns onto screen column ranges
+     * @param begin First column, counted from the start of the sweep
+     * @param end Last column, counted from the start of the sweep
+     * @param width Number of columns on screen
+     * @param fn Callable invoked as fn(int first, int last) for each screen range
+     *
+     * A range wraps around the right edge at most once, so fn is called at most
+     * twice. Ranges at least one screen wide cover the whole screen.
+     */
+    template <typename Fn>
+    void forEachScreenRange(qint64 begin, qint64 end, qint64 width, Fn&& fn)
+    {
+        if (width <= 0 || end < begin) {
+            return;
+        }
+        if (end - begin + 1 >= width) {
+            fn(0, static_cast<int>(width - 1));
+            return;
+        }
+        const int first = static_cast<int>(begin % width);
+        const int last = static_cast<int>(end % width);
+        if (first <= last) {
+            fn(first, last);
+        } else {
+            fn(first, static_cast<int>(width - 1));
+            fn(0, last);
+        }
+    }
+
+    /**
+     * @brief Widens a range of screen columns to whole decimation groups
+     * @param first First column, moved down to the start of its group
+     * @param last Last column, moved up to the end of its group
+     * @param factor Columns per group
+     * @param width Number of columns on screen
+     */
+    void alignToGroups(int& first, int& last, int factor, int width)
+    {
+        first -= first % factor;
+        last = std::min(last - last % factor + factor - 1, width - 1);
+    }
 }
 
 /**
@@ -44,7 +95,6 @@ namespace {
 WaveformView::WaveformView(QWidget* parent)
     : QWidget(parent)
     , model_(nullptr)
-    , display_timer_(new QTimer(this))
     , axis_x_(0.0)
     , sweep_speed_(25.0)
     , grid_visible_(true)
@@ -54,12 +104,27 @@ WaveformView::WaveformView(QWidget* parent)
     , background_color_(Qt::black)
     , is_paused_(false)
     , wave_form_data_counter_(0)
+    , showing_demo_(false)
+    , read_sequence_(0)
+    , last_sample_(0.0f)
+    , has_sample_(false)
+    , unpainted_write_time_(0)
+    , render_mode_(RenderMode::SweepCanvas)
+    , sweep_position_(0.0)
+    , sweep_column_(-1)
+    , dirty_begin_(0)
+    , dirty_end_(-1)
+    , overview_span_ms_(DEFAULT_OVERVIEW_SPAN_MS)
+    , overview_end_(0)
+    , last_step_time_(0)
+    , frame_count_(0)
 {
     // Set up widget properties
     setMinimumSize(300, 100);
     
-    // Ensure the background is painted properly
-    setAutoFillBackground(true);
+    // The cached static layer covers the whole widget, so Qt does not need
+    // to erase the background before each paint
+    setAttribute(Qt::WA_OpaquePaintEvent);
     QPalette pal = palette();
     pal.setColor(QPalette::Window, background_color_);
     setPalette(pal);
@@ -67,28 +132,15 @@ WaveformView::WaveformView(QWidget* parent)
     // Initialize the path
     waveform_path_ = QPainterPath();
     draw_starting_point_ = QPointF(-5, 0); // Start off-screen exactly like original
-    
-    // Create update timer with EXACT same interval as original (25ms)
-    // In original: draw_timer.start(25);
-    display_timer_->setInterval(25);
-    connect(display_timer_, &QTimer::timeout, this, &WaveformView::UpdateDisplay);
-    
-    // Start the timer
-    display_timer_->start();
 }
 
 /**
  * @brief Destroys the WaveformView widget
  *
- * Stops the display timer and disconnects any model signals.
+ * Disconnects any model signals.
  */
 WaveformView::~WaveformView()
 {
-    // Stop the timer
-    if (display_timer_->isActive()) {
-        display_timer_->stop();
-    }
-    
     // Disconnect model signals
     if (model_) {
         disconnectModelSignals();
@@ -113,6 +165,12 @@ void WaveformView::SetModel(std::shared_ptr<IWaveformModel> model)
     
     // Set new model
     model_ = model;
+    showing_demo_ = model_ && model_->GetIsDemo();
+    read_sequence_ = 0;
+    has_sample_ = false;
+    unpainted_write_time_ = 0;
+    resetSweep();
+    invalidateStaticLayers();
     
     // Connect signals to new model
     if (model_) {
@@ -137,8 +195,8 @@ std::shared_ptr<IWaveformModel> WaveformView::GetModel() const
  * @brief Sets the sweep speed in pixels per second
  * @param pixelsPerSecond The new sweep speed
  *
- * Updates the sweep speed and adjusts the update interval accordingly.
- * Also resets the waveform path for a clean start.
+ * Updates the sweep speed, which also sets the pixel-step rate, and resets
+ * the waveform path for a clean start.
  */
 void WaveformView::SetSweepSpeed(double pixelsPerSecond)
 {
@@ -151,22 +209,8 @@ void WaveformView::SetSweepSpeed(double pixelsPerSecond)
         // Reset waveform path on sweep speed change for clean start
         waveform_path_ = QPainterPath();
         axis_x_ = 0;
-        
-        // Adjust update interval immediately based on new sweep speed
-        int newInterval = UPDATE_INTERVAL_MS;
-        
-        if (sweep_speed_ > 50.0) {
-            newInterval = 20; // 50 Hz for very fast speeds
-        } else if (sweep_speed_ > 25.0) {
-            newInterval = 30; // ~33 Hz for fast speeds
-        } else if (sweep_speed_ < 12.5) {
-            newInterval = 80; // 12.5 Hz for slow speeds
-        }
-        
-        // Only change the interval if needed
-        if (display_timer_->interval() != newInterval) {
-            display_timer_->setInterval(newInterval);
-        }
+        resetSweep();
+        invalidateStaticLayers();
         
         // Force an immediate update
         update();
@@ -193,6 +237,7 @@ void WaveformView::SetGridVisible(bool visible)
     
     if (grid_visible_ != visible) {
         grid_visible_ = visible;
+        invalidateStaticLayers();
         update();
     }
 }
@@ -217,6 +262,7 @@ void WaveformView::SetTimeScaleVisible(bool visible)
     
     if (time_scale_visible_ != visible) {
         time_scale_visible_ = visible;
+        invalidateStaticLayers();
         update();
     }
 }
@@ -241,6 +287,7 @@ void WaveformView::SetAmplitudeScaleVisible(bool visible)
     
     if (amplitude_scale_visible_ != visible) {
         amplitude_scale_visible_ = visible;
+        invalidateStaticLayers();
         update();
     }
 }
@@ -265,6 +312,7 @@ void WaveformView::SetGridColor(const QColor& color)
     
     if (grid_color_ != color) {
         grid_color_ = color;
+        invalidateStaticLayers();
         update();
     }
 }
@@ -294,6 +342,7 @@ void WaveformView::SetBackgroundColor(const QColor& color)
         QPalette pal = palette();
         pal.setColor(QPalette::Window, color);
         setPalette(pal);
+        invalidateStaticLayers();
         update();
     }
 }
@@ -322,7 +371,7 @@ void WaveformView::update()
  * @brief Sets whether the waveform display is paused
  * @param paused True to pause the display, false to resume
  *
- * When paused, the display timer is stopped and a "PAUSED" indicator is shown.
+ * When paused, frame ticks are ignored and a "PAUSED" indicator is shown.
  */
 void WaveformView::SetPaused(bool paused)
 {
@@ -330,18 +379,6 @@ void WaveformView::SetPaused(bool paused)
     
     if (is_paused_ != paused) {
         is_paused_ = paused;
-        
-        // Start or stop display timer based on pause state
-        if (is_paused_) {
-            if (display_timer_->isActive()) {
-                display_timer_->stop();
-            }
-        } else {
-            if (!display_timer_->isActive()) {
-                display_timer_->start();
-            }
-        }
-        
         update();
     }
 }
@@ -356,33 +393,159 @@ bool WaveformView::isPaused() const
     return is_paused_;
 }
 
+/**
+ * @brief Sets the rendering effort of the view
+ * @param quality Rendering settings
+ *
+ * A new grid setting rebuilds the static layer and a new decimation redraws
+ * the trace canvas, so the whole view changes over at once. Antialiasing and
+ * the frame divisor apply from the next frame.
+ */
+void WaveformView::SetRenderQuality(const RenderQuality& quality)
+{
+    QMutexLocker locker(&mutex_);
+    
+    RenderQuality applied = quality;
+    applied.frameDivisor = std::max(1, quality.frameDivisor);
+    applied.decimation = std::max(1, quality.decimation);
+    if (quality_ == applied) {
+        return;
+    }
+    
+    const bool gridChanged = quality_.simplifiedGrid != applied.simplifiedGrid;
+    const bool decimationChanged = quality_.decimation != applied.decimation;
+    quality_ = applied;
+    
+    if (gridChanged) {
+        invalidateStaticLayers();
+    }
+    if (decimationChanged && render_mode_ == RenderMode::SweepCanvas) {
+        redrawCanvas();
+    }
+    if (gridChanged || decimationChanged) {
+        update();
+    }
+}
+
+/**
+ * @brief Gets the rendering effort of the view
+ * @return Rendering settings in use
+ */
+IWaveformView::RenderQuality WaveformView::GetRenderQuality() const
+{
+    QMutexLocker locker(&mutex_);
+    return quality_;
+}
+
+/**
+ * @brief Sets how live model data is rendered
+ * @param mode The render mode
+ *
+ * Switching modes restarts the sweep. Demo data is synthesized per display
+ * tick, so it is always drawn pixel-step, either directly or into the sweep
+ * canvas when the SweepCanvas mode is selected.
+ */
+void WaveformView::SetRenderMode(RenderMode mode)
+{
+    QMutexLocker locker(&mutex_);
+    
+    if (render_mode_ != mode) {
+        render_mode_ = mode;
+        waveform_path_ = QPainterPath();
+        axis_x_ = 0;
+        read_sequence_ = 0;
+        has_sample_ = false;
+        resetSweep();
+        if (render_mode_ == RenderMode::Overview) {
+            refreshOverview();
+        }
+        update();
+    }
+}
+
+/**
+ * @brief Gets the current render mode
+ * @return The render mode
+ */
+WaveformView::RenderMode WaveformView::GetRenderMode() const
+{
+    QMutexLocker locker(&mutex_);
+    return render_mode_;
+}
+
+/**
+ * @brief Sets the time window shown in Overview mode
+ * @param spanMs Length of the window in milliseconds
+ * @param endTimestamp End of the window in milliseconds since epoch, 0 to follow the newest data
+ *
+ * A fixed end scrolls the overview back in time; the window may reach
+ * further back than the model's sample buffer.
+ */
+void WaveformView::SetOverviewWindow(qint64 spanMs, qint64 endTimestamp)
+{
+    QMutexLocker locker(&mutex_);
+    
+    overview_span_ms_ = std::max<qint64>(spanMs, 1);
+    overview_end_ = std::max<qint64>(endTimestamp, 0);
+    if (render_mode_ == RenderMode::Overview) {
+        refreshOverview();
+        update();
+    }
+}
+
+/**
+ * @brief Gets the length of the time window shown in Overview mode
+ * @return Window length in milliseconds
+ */
+qint64 WaveformView::GetOverviewSpan() const
+{
+    QMutexLocker locker(&mutex_);
+    return overview_span_ms_;
+}
+
 /**
  * @brief Handles paint events for the widget
  * @param event The paint event
  *
- * Draws the background, grid, waveform, labels, and pause indicator if paused.
+ * Composites the cached background and grid, the waveform, the cached labels,
+ * and the pause indicator if paused. The paint duration and, when the paint
+ * shows newly read samples, their display latency are recorded in the metrics.
  */
 void WaveformView::paintEvent(QPaintEvent* event)
 {
-    Q_UNUSED(event);
-    
+    ScopedMetricsTimer paintTimer(Metrics::Histogram::WaveformPaint);
     QPainter painter(this);
     
-    // Ensure the background is filled with the correct color
-    painter.fillRect(rect(), background_color_);
+    // Composite the cached background and grid; the paint engine clips the
+    // blit to the exposed area
+    QMutexLocker layerLocker(&mutex_);
+    ensureStaticLayers();
+    painter.drawPixmap(0, 0, static_layer_);
     
-    // Draw grid if visible
-    if (grid_visible_) {
-        drawGrid(painter);
+    if (model_ && render_mode_ == RenderMode::SweepCanvas) {
+        ensureCanvas();
+        painter.drawImage(0, 0, trace_canvas_);
     }
+    layerLocker.unlock();
     
     // Draw waveform if we have a model
-    if (model_) {
-        drawWaveform(painter);
+    if (model_ && render_mode_ != RenderMode::SweepCanvas) {
+        if ((render_mode_ == RenderMode::TimeBased || render_mode_ == RenderMode::Overview)
+            && !model_->GetIsDemo()) {
+            drawTimeBasedWaveform(painter, event->rect());
+        } else {
+            drawWaveform(painter);
+        }
     }
     
-    // Draw labels
-    drawLabels(painter);
+    // Composite the cached labels on top of the trace
+    layerLocker.relock();
+    painter.drawPixmap(0, 0, label_layer_);
+    if (unpainted_write_time_ != 0) {
+        Metrics::RecordSince(Metrics::Histogram::DisplayLatency, unpainted_write_time_);
+        unpainted_write_time_ = 0;
+    }
+    layerLocker.unlock();
     
     // Draw pause indicator if paused
     if (is_paused_) {
@@ -402,77 +565,162 @@ void WaveformView::paintEvent(QPaintEvent* event)
 void WaveformView::resizeEvent(QResizeEvent* event)
 {
     QWidget::resizeEvent(event);
+    
+    QMutexLocker locker(&mutex_);
+    
+    // Sweep columns map one-to-one to pixels, so a new width restarts the sweep
+    if (event->size().width() != event->oldSize().width()) {
+        resetSweep();
+        axis_x_ = 0;
+        if (render_mode_ == RenderMode::Overview) {
+            refreshOverview();
+        }
+    }
+    
+    // All layers are reallocated at the new size on the next paint
+    trace_canvas_ = QImage();
+    invalidateStaticLayers();
 }
 
 /**
- * @brief Handles data updated signals from the model
+ * @brief Handles property changes in the model
  *
- * Updates a small region of the widget around the current drawing position.
+ * Updates the widget if not paused and a model is set. When the model
+ * switches between demo and ingested data, the trace starts over so the
+ * demo trace and the rendered samples never share a sweep.
  */
-void WaveformView::HandleDataUpdated()
+void WaveformView::HandlePropertiesChanged()
 {
+    if (!model_) {
+        return;
+    }
+    
+    QMutexLocker locker(&mutex_);
+    const bool demo = model_->GetIsDemo();
+    if (demo != showing_demo_) {
+        showing_demo_ = demo;
+        read_sequence_ = 0;
+        has_sample_ = false;
+        unpainted_write_time_ = 0;
+        waveform_path_ = QPainterPath();
+        axis_x_ = 0;
+        resetSweep();
+    }
+    
     // Only update if not paused
     if (!is_paused_) {
-        // Create a small rect around the current drawing position to update
-        // This is more efficient than updating the entire widget
-        QRect UpdateRect = rect();
-        int margin = 20; // Provide enough margin for the curve
-        
-        int x = qBound(0, static_cast<int>(axis_x_ - margin), width());
-        int width = qMin(2 * margin, this->width() - x);
+        // The name and scaling range shown in the labels may have changed
+        invalidateStaticLayers();
         
-        UpdateRect.setLeft(x);
-        UpdateRect.setWidth(width);
-        
-        // Update just that section of the widget
-        QWidget::update(UpdateRect);
+        // The scaling range may have changed, so re-rasterize the retained sweep
+        if (render_mode_ == RenderMode::SweepCanvas && !showing_demo_) {
+            redrawCanvas();
+        }
+        update();
     }
 }
 
 /**
- * @brief Handles property changes in the model
- *
- * Updates the widget if not paused and a model is set.
+ * @brief Connects this view to the shared display clock
+ * @param scheduler The frame scheduler that drives the view
  */
-void WaveformView::HandlePropertiesChanged()
+void WaveformView::AttachToScheduler(FrameScheduler* scheduler)
 {
-    // Only update if not paused and we have a model
-    if (!is_paused_ && model_) {
-        update();
+    if (scheduler) {
+        connect(scheduler, &FrameScheduler::frameTick, this, &WaveformView::OnFrame);
     }
 }
 
 /**
- * @brief Updates the display timer and redraws the waveform
+ * @brief Handles a tick of the shared display clock
+ * @param frameTimeMs Monotonic frame time in milliseconds
  *
- * Called by the display timer to update the waveform display. Adjusts
- * the display timer interval based on the sweep speed.
+ * Ticks are skipped while the view is paused or scrolled out of sight. The
+ * pixel-step trace advances one pixel per step, so it only steps at the rate
+ * belonging to the sweep speed. The time-based renderers work on every n-th
+ * frame for a frame divisor of n, but only when the model has received
+ * samples since the previous one; samples keep arriving in the model while
+ * ticks are skipped, so the sweep just advances in larger steps.
  */
-void WaveformView::UpdateDisplay()
+void WaveformView::OnFrame(qint64 frameTimeMs)
 {
-    // Skip updates if paused
-    if (is_paused_) {
+    if (is_paused_ || !model_ || visibleRegion().isEmpty()) {
         return;
     }
     
-    // Adjust the display update interval based on sweep speed to match old implementation
-    // Faster sweep speeds need more frequent updates
-    int newInterval = 25; // Use the EXACT original timer interval (25ms)
+    const bool pixelStep = render_mode_ == RenderMode::PixelStep || model_->GetIsDemo();
+    if (pixelStep) {
+        if (frameTimeMs - last_step_time_ < stepIntervalMs()) {
+            return;
+        }
+        last_step_time_ = frameTimeMs;
+    } else {
+        if (++frame_count_ % quality_.frameDivisor != 0) {
+            return;
+        }
+        if (model_->GetWriteSequence() == read_sequence_) {
+            return;
+        }
+    }
     
+    UpdateDisplay();
+}
+
+/**
+ * @brief Gets the interval between two pixel steps
+ * @return Step interval in milliseconds
+ *
+ * Faster sweep speeds need more frequent steps. These are the display timer
+ * intervals of the original implementation.
+ */
+int WaveformView::stepIntervalMs() const
+{
     if (sweep_speed_ > 50.0) {
-        // Very fast sweep speeds need more frequent updates
-        newInterval = 20; // 50 Hz
+        return 20; // 50 Hz for very fast speeds
     } else if (sweep_speed_ > 25.0) {
-        // Fast sweep speeds
-        newInterval = 30; // ~33 Hz
+        return 30; // ~33 Hz for fast speeds
     } else if (sweep_speed_ < 12.5) {
-        // Slow sweep speeds can update less frequently
-        newInterval = 80; // 12.5 Hz
+        return 80; // 12.5 Hz for slow speeds
+    }
+    return 25; // The EXACT original timer interval
+}
+
+/**
+ * @brief Advances the waveform and requests the repaint of the changed area
+ *
+ * Called from OnFrame() whenever there is something to draw.
+ */
+void WaveformView::UpdateDisplay()
+{
+    // The sweep canvas only rasterizes what changed since the previous tick
+    if (render_mode_ == RenderMode::SweepCanvas && model_) {
+        if (model_->GetIsDemo()) {
+            advancePixelStepCanvas();
+        } else {
+            ingestSamples();
+            rasterizeSweep();
+            updateDirtyColumns();
+        }
+        return;
+    }
+    
+    // The overview is rebuilt from the model envelope, which costs one
+    // query per pixel column however long the window is
+    if (render_mode_ == RenderMode::Overview && model_ && !model_->GetIsDemo()) {
+        {
+            QMutexLocker locker(&mutex_);
+            refreshOverview();
+        }
+        QWidget::update();
+        return;
     }
     
-    // Update timer interval if needed
-    if (display_timer_->interval() != newInterval) {
-        display_timer_->setInterval(newInterval);
+    // Time-based mode consumes the new samples here and repaints only the
+    // columns they landed in
+    if (render_mode_ == RenderMode::TimeBased && model_ && !model_->GetIsDemo()) {
+        ingestSamples();
+        updateDirtyColumns();
+        return;
     }
     
     // Trigger a redraw to update the scrolling waveform
@@ -495,13 +743,15 @@ void WaveformView::UpdateDisplay()
 /**
  * @brief Connects signals from the model
  *
- * Connects the dataUpdated and propertiesChanged signals from the model
- * to the corresponding handler methods in this class.
+ * Connects the propertiesChanged signal from the model to the corresponding
+ * handler. The dataUpdated signal is deliberately not connected: samples are
+ * added on the acquisition thread, and waking the GUI thread for every chunk
+ * would defeat the purpose of acquiring off the GUI thread. New samples are
+ * instead picked up on the next tick of the shared display clock.
  */
 void WaveformView::connectModelSignals()
 {
     if (model_) {
-        connect(model_.get(), &IWaveformModel::dataUpdated, this, &WaveformView::HandleDataUpdated);
         connect(model_.get(), &IWaveformModel::propertiesChanged, this, &WaveformView::HandlePropertiesChanged);
     }
 }
@@ -509,12 +759,11 @@ void WaveformView::connectModelSignals()
 /**
  * @brief Disconnects signals from the model
  *
- * Disconnects the dataUpdated and propertiesChanged signals from the model.
+ * Disconnects the propertiesChanged signal from the model.
  */
 void WaveformView::disconnectModelSignals()
 {
     if (model_) {
-        disconnect(model_.get(), &IWaveformModel::dataUpdated, this, &WaveformView::HandleDataUpdated);
         disconnect(model_.get(), &IWaveformModel::propertiesChanged, this, &WaveformView::HandlePropertiesChanged);
     }
 }
@@ -523,7 +772,8 @@ void WaveformView::disconnectModelSignals()
  * @brief Draws the grid
  * @param painter The painter to use
  *
- * Draws minor and major grid lines with different styles.
+ * Draws minor and major grid lines with different styles. A simplified grid
+ * has the major lines only.
  */
 void WaveformView::drawGrid(QPainter& painter)
 {
@@ -537,16 +787,18 @@ void WaveformView::drawGrid(QPainter& painter)
     QPen majorGridPen(grid_color_, 0.9, Qt::SolidLine);
     
     // Draw minor grid lines
-    painter.setPen(gridPen);
-    
-    // Vertical minor grid lines (time)
-    for (int x = gridRect.left(); x <= gridRect.right(); x += DEFAULT_GRID_MINOR_X) {
-        painter.drawLine(x, gridRect.top(), x, gridRect.bottom());
-    }
-    
-    // Horizontal minor grid lines (amplitude)
-    for (int y = gridRect.top(); y <= gridRect.bottom(); y += DEFAULT_GRID_MINOR_Y) {
-        painter.drawLine(gridRect.left(), y, gridRect.right(), y);
+    if (!quality_.simplifiedGrid) {
+        painter.setPen(gridPen);
+        
+        // Vertical minor grid lines (time)
+        for (int x = gridRect.left(); x <= gridRect.right(); x += DEFAULT_GRID_MINOR_X) {
+            painter.drawLine(x, gridRect.top(), x, gridRect.bottom());
+        }
+        
+        // Horizontal minor grid lines (amplitude)
+        for (int y = gridRect.top(); y <= gridRect.bottom(); y += DEFAULT_GRID_MINOR_Y) {
+            painter.drawLine(gridRect.left(), y, gridRect.right(), y);
+        }
     }
     
     // Draw major grid lines
@@ -573,21 +825,29 @@ void WaveformView::drawGrid(QPainter& painter)
 void WaveformView::drawWaveform(QPainter& painter)
 {
     if (!model_) {
-        qDebug() << "WaveformView::drawWaveform - No model attached";
+        VITALSYNC_TRACE(lcDisplay) << "WaveformView::drawWaveform - No model attached";
         return;
     }
     
     QMutexLocker locker(&mutex_);
     
-    // Get waveform data
-    const QVector<float>& data = model_->GetData();
-    if (data.isEmpty() && !model_->GetIsDemo()) {
-        qDebug() << "WaveformView::drawWaveform - Empty data for waveform ID:" << model_->GetWaveformId();
+    // Look at the samples that arrived since the last paint through a
+    // copy-free snapshot, without taking the model lock
+    const WaveformSnapshot snapshot = model_->GetSnapshot(read_sequence_);
+    if (snapshot.GetValidFirstSequence() < snapshot.GetEndSequence()) {
+        last_sample_ = snapshot.last();
+        has_sample_ = true;
+        if (unpainted_write_time_ == 0) {
+            unpainted_write_time_ = model_->GetLastWriteTime();
+        }
+    }
+    read_sequence_ = snapshot.GetEndSequence();
+    if (!has_sample_ && !model_->GetIsDemo()) {
+        VITALSYNC_TRACE(lcDisplay) << "WaveformView::drawWaveform - Empty data for waveform ID:" << model_->GetWaveformId();
         return;
     }
     
     // Get model properties
-    QColor waveformColor = model_->GetColor();
     float minValue = model_->GetMinValue();
     float maxValue = model_->GetMaxValue();
     double valueRange = maxValue - minValue;
@@ -609,34 +869,10 @@ void WaveformView::drawWaveform(QPainter& painter)
     painter.setTransform(transform);
     
     // Set up pen for drawing waveform - using the same settings as the old implementation
-    QPen waveformPen;
-    
-    // Apply different pen settings based on waveform type (same as old implementation)
-    switch (static_cast<VitalSync::WaveformType>(waveformId)) {
-        case VitalSync::WaveformType::ECG_I:
-        case VitalSync::WaveformType::ECG_II:
-        case VitalSync::WaveformType::ECG_III:
-            waveformPen = QPen(Qt::green, 1.5, Qt::SolidLine);
-            break;
-        case VitalSync::WaveformType::RESP:
-            waveformPen = QPen(Qt::yellow, 1.5, Qt::SolidLine);
-            break;
-        case VitalSync::WaveformType::PLETH:
-            waveformPen = QPen(Qt::cyan, 1.5, Qt::SolidLine);
-            break;
-        case VitalSync::WaveformType::ABP:
-            waveformPen = QPen(Qt::red, 1.5, Qt::SolidLine);
-            break;
-        case VitalSync::WaveformType::CAPNO:
-            waveformPen = QPen(Qt::white, 1.5, Qt::SolidLine);
-            break;
-        default:
-            waveformPen = QPen(waveformColor, 1.5, Qt::SolidLine);
-            break;
-    }
+    QPen waveformPen = tracePen();
     
     painter.setPen(waveformPen);
-    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.setRenderHint(QPainter::Antialiasing, quality_.antialiasing);
     
     // Set the waveform bounding rect for partial updates - identical to original
     QRect waveformBoundingRect;
@@ -658,40 +894,15 @@ void WaveformView::drawWaveform(QPainter& painter)
     if (model_->GetIsDemo()) {
         // In original: chooseWaveFormType(waveformOption, this->height());
         liveTrace = ProcessDemoData(waveformId);
-    } else if (!data.isEmpty()) {
-        // Use real data
-        int index = wave_form_data_counter_ % data.size();
-        float value = data[index];
-        liveTrace = (value - minValue) / valueRange;
+    } else if (has_sample_) {
+        // Use the newest real sample
+        liveTrace = (last_sample_ - minValue) / valueRange;
     } else {
         liveTrace = 0.5f;
     }
     
     // Scale value based on waveform type and height - like in chooseWaveFormType
-    float scaledValue = 0;
-    
-    switch (static_cast<VitalSync::WaveformType>(waveformId)) {
-        case VitalSync::WaveformType::ECG_I:
-        case VitalSync::WaveformType::ECG_II:
-        case VitalSync::WaveformType::ECG_III:
-            scaledValue = liveTrace * (drawRect.height() * 0.7); // Increased from height/2.0
-            break;
-        case VitalSync::WaveformType::PLETH:
-            scaledValue = liveTrace * (drawRect.height() * 0.5); // Increased from height/3.0
-            break;
-        case VitalSync::WaveformType::ABP:
-            scaledValue = liveTrace * (drawRect.height() * 0.5); // Increased from height/3.0
-            break;
-        case VitalSync::WaveformType::RESP:
-            scaledValue = liveTrace * (drawRect.height() * 0.8); // Significantly increased from height/2.0
-            break;
-        case VitalSync::WaveformType::CAPNO:
-            scaledValue = liveTrace * (drawRect.height() * 0.8); // Significantly increased from height/2.0
-            break;
-        default:
-            scaledValue = liveTrace * (drawRect.height() * 0.7); // Increased from height/2.0
-            break;
-    }
+    float scaledValue = scaleTrace(liveTrace, waveformId, drawRect.height());
     
     // Create drawing points - EXACTLY like original
     // In original: QPointF drawEdingPoint(axisX, singletonData->liveTrace);
@@ -739,6 +950,531 @@ void WaveformView::drawWaveform(QPainter& painter)
     painter.resetTransform();
 }
 
+/**
+ * @brief Scales a normalized trace value to the pixel-step display height
+ * @param liveTrace Trace value normalized to the range 0-1
+ * @param waveformId The waveform ID
+ * @param height Height of the drawing area
+ * @return Y position measured from the bottom edge
+ */
+float WaveformView::scaleTrace(float liveTrace, int waveformId, int height) const
+{
+    return liveTrace * (height * VitalSync::GetWaveformTraits(waveformId).traceScale);
+}
+
+/**
+ * @brief Gets the pen used for the trace of the current model
+ * @return The trace pen
+ *
+ * Well-known waveform types use their conventional monitor colors; all
+ * others use the color configured on the model.
+ */
+QPen WaveformView::tracePen() const
+{
+    const VitalSync::WaveformTraits& traits = VitalSync::GetWaveformTraits(model_->GetWaveformId());
+    return QPen(traits.conventionalColor ? QColor(traits.color) : model_->GetColor(), 1.5, Qt::SolidLine);
+}
+
+/**
+ * @brief Gets the pen used for the min/max column lines
+ * @return The trace pen with flat caps, one pixel wide per merged column
+ */
+QPen WaveformView::columnPen() const
+{
+    QPen pen = tracePen();
+    pen.setWidthF(quality_.decimation);
+    pen.setCapStyle(Qt::FlatCap);
+    return pen;
+}
+
+/**
+ * @brief Gets the sweep speed converted to screen pixels
+ * @return Sweep speed in pixels per second
+ *
+ * The sweep speed is specified in mm/s like on a paper recorder, so the
+ * conversion uses the logical DPI of the screen the view is shown on.
+ */
+double WaveformView::pixelsPerSecond() const
+{
+    return sweep_speed_ * logicalDpiX() / MM_PER_INCH;
+}
+
+/**
+ * @brief Clears the time-based sweep and restarts it at the left edge
+ *
+ * Allocates one column per pixel of the current width and blanks the trace
+ * canvas. The caller must hold mutex_.
+ */
+void WaveformView::resetSweep()
+{
+    if (!trace_canvas_.isNull()) {
+        trace_canvas_.fill(Qt::transparent);
+    }
+    columns_ = QVector<ColumnExtent>(std::max(width(), 0));
+    sweep_position_ = 0.0;
+    sweep_column_ = -1;
+    dirty_begin_ = 0;
+    dirty_end_ = -1;
+}
+
+/**
+ * @brief Fills the columns with the model envelope of the overview window
+ *
+ * The window ends at the newest data unless a fixed end was set, so a live
+ * overview scrolls as data arrives. The caller must hold mutex_.
+ */
+void WaveformView::refreshOverview()
+{
+    const int width = static_cast<int>(columns_.size());
+    if (!model_ || width == 0) {
+        return;
+    }
+    
+    read_sequence_ = model_->GetWriteSequence();
+    const qint64 end = overview_end_ > 0 ? overview_end_
+                                         : model_->GetLastUpdateTime().toMSecsSinceEpoch();
+    model_->GetEnvelope(end - overview_span_ms_, end, width, envelope_);
+    
+    for (int x = 0; x < width; ++x) {
+        const EnvelopeColumn& column = envelope_[x];
+        columns_[x] = ColumnExtent{ column.min, column.max, column.valid };
+    }
+}
+
+/**
+ * @brief Reads all samples that arrived since the last frame into the sweep columns
+ *
+ * Every new sample is placed on the sweep at a distance of one sample period
+ * from its predecessor, using the sample rate the model measured from the data
+ * timestamps, so the trace advances at the configured speed regardless of the
+ * display rate. Samples the view could not read in time still occupy their
+ * slot on the sweep, keeping the time axis accurate.
+ */
+void WaveformView::ingestSamples()
+{
+    QMutexLocker locker(&mutex_);
+    
+    if (!model_) {
+        return;
+    }
+    
+    if (columns_.size() != width()) {
+        resetSweep();
+    }
+    if (columns_.isEmpty()) {
+        return;
+    }
+    
+    // Start at the live edge rather than replaying the whole buffer
+    if (!has_sample_ && read_sequence_ == 0) {
+        read_sequence_ = model_->GetWriteSequence();
+    }
+    
+    const double pixelsPerSample = pixelsPerSecond() / std::max(model_->GetSampleRate(), 1.0);
+    const WaveformSnapshot snapshot = model_->GetSnapshot(read_sequence_);
+    
+    // Samples lost to an overrun still take up their time on the sweep
+    const quint64 firstSequence = snapshot.GetValidFirstSequence();
+    if (has_sample_ && firstSequence > read_sequence_) {
+        sweep_position_ += static_cast<double>(firstSequence - read_sequence_) * pixelsPerSample;
+        Metrics::Add(Metrics::Counter::SamplesDropped, firstSequence - read_sequence_);
+    }
+    if (firstSequence < snapshot.GetEndSequence() && unpainted_write_time_ == 0) {
+        unpainted_write_time_ = model_->GetLastWriteTime();
+    }
+    
+    snapshot.ForEachSpan([this, pixelsPerSample](const float* data, int count, quint64) {
+        for (int i = 0; i < count; ++i) {
+            plotSample(data[i], pixelsPerSample);
+        }
+    });
+    
+    read_sequence_ = snapshot.GetEndSequence();
+}
+
+/**
+ * @brief Places one sample on the sweep
+ * @param value The sample value
+ * @param pixelsPerSample Horizontal distance between two consecutive samples
+ *
+ * Samples that fall into the current column widen its min/max range. When a
+ * sample lands in a new column, every column from the previous sample up to
+ * it is overwritten with the linearly interpolated segment between the two
+ * samples, so the trace stays continuous at any ratio of sample rate to
+ * sweep speed. The caller must hold mutex_.
+ */
+void WaveformView::plotSample(float value, double pixelsPerSample)
+{
+    const qint64 width = columns_.size();
+    const qint64 column = static_cast<qint64>(sweep_position_);
+    
+    if (column == sweep_column_) {
+        ColumnExtent& extent = columns_[static_cast<int>(column % width)];
+        extent.min = std::min(extent.min, value);
+        extent.max = std::max(extent.max, value);
+    } else {
+        const float previous = has_sample_ ? last_sample_ : value;
+        const double span = static_cast<double>(column - sweep_column_);
+        const qint64 first = std::max(sweep_column_ + 1, column - width + 1);
+        
+        for (qint64 c = first; c <= column; ++c) {
+            const float from = previous + (value - previous) * static_cast<float>((c - 1 - sweep_column_) / span);
+            const float to = previous + (value - previous) * static_cast<float>((c - sweep_column_) / span);
+            columns_[static_cast<int>(c % width)] = ColumnExtent{std::min(from, to), std::max(from, to), true};
+        }
+        
+        if (dirty_end_ < dirty_begin_) {
+            dirty_begin_ = first;
+        }
+        sweep_column_ = column;
+    }
+    
+    dirty_end_ = column;
+    last_sample_ = value;
+    has_sample_ = true;
+    sweep_position_ += pixelsPerSample;
+}
+
+/**
+ * @brief Requests a repaint of the columns changed since the last frame
+ *
+ * The changed range wraps around the right edge at most once, so it maps to
+ * at most two update rectangles. The caller must not hold mutex_.
+ */
+void WaveformView::updateDirtyColumns()
+{
+    QMutexLocker locker(&mutex_);
+    
+    const qint64 width = columns_.size();
+    if (width == 0 || dirty_end_ < dirty_begin_) {
+        return;
+    }
+    
+    // Decimated lines cover their whole group of columns
+    const int margin = TRACE_REPAINT_MARGIN + quality_.decimation - 1;
+    forEachScreenRange(dirty_begin_, dirty_end_, width, [this, margin](int first, int last) {
+        QWidget::update(QRect(first, 0, last - first + 1, height()).adjusted(-margin, 0, margin, 0));
+    });
+    
+    // Keep the current column dirty, later samples may still widen it
+    dirty_begin_ = sweep_column_;
+    dirty_end_ = sweep_column_ - 1;
+}
+
+/**
+ * @brief Rebuilds the cached background and label layers if they are stale
+ *
+ * The background layer holds the background fill and the grid; the label
+ * layer holds the waveform name and the amplitude and time scales on a
+ * transparent background. Both are allocated at device resolution and only
+ * rebuilt after invalidateStaticLayers() or a size change, so a regular frame
+ * composites two blits instead of rebuilding grid geometry and text layouts.
+ * The caller must hold mutex_.
+ */
+void WaveformView::ensureStaticLayers()
+{
+    const qreal ratio = devicePixelRatioF();
+    const QSize deviceSize = size() * ratio;
+    
+    if (static_layer_.size() != deviceSize) {
+        static_layer_ = QPixmap(deviceSize);
+        static_layer_.setDevicePixelRatio(ratio);
+        static_layer_.fill(background_color_);
+        if (grid_visible_) {
+            QPainter layerPainter(&static_layer_);
+            drawGrid(layerPainter);
+        }
+    }
+    
+    if (label_layer_.size() != deviceSize) {
+        label_layer_ = QPixmap(deviceSize);
+        label_layer_.setDevicePixelRatio(ratio);
+        label_layer_.fill(Qt::transparent);
+        QPainter layerPainter(&label_layer_);
+        layerPainter.setFont(font());
+        drawLabels(layerPainter);
+    }
+}
+
+/**
+ * @brief Marks the cached background and label layers as stale
+ *
+ * Called whenever something shown on them changes. The layers are rebuilt
+ * on the next paint. The caller must hold mutex_.
+ */
+void WaveformView::invalidateStaticLayers()
+{
+    static_layer_ = QPixmap();
+    label_layer_ = QPixmap();
+}
+
+/**
+ * @brief Builds the trace lines of a range of columns
+ * @param first First column to include
+ * @param last Last column to include
+ * @return One vertical min/max line per valid column
+ *
+ * The pixel rows of all columns are computed in one SignalKernels pass. A
+ * column holding a single value yields a one pixel high line. When
+ * decimating, the columns are merged in groups aligned to multiples of the
+ * decimation factor, and each group yields one line spanning the min/max of
+ * its valid columns, to be drawn with columnPen(). Groups cut by the range
+ * are merged over the part inside it only. The caller must hold mutex_.
+ */
+QVector<QLineF> WaveformView::buildColumnLines(int first, int last) const
+{
+    QVector<QLineF> lines;
+    if (!model_ || last < first) {
+        return lines;
+    }
+    
+    const float minValue = model_->GetMinValue();
+    double valueRange = model_->GetMaxValue() - minValue;
+    if (qFuzzyCompare(valueRange, 0.0)) {
+        valueRange = 1.0; // Prevent division by zero
+    }
+    
+    const QRect drawRect = rect().adjusted(0, WAVEFORM_MARGIN, 0, -WAVEFORM_MARGIN);
+    const float scale = static_cast<float>(drawRect.height() / valueRange);
+    
+    // Collect the max/min pair and the center of every valid column or group
+    const int factor = quality_.decimation;
+    const int capacity = (last - first) / factor + 2;
+    QVarLengthArray<float, 2048> rows;
+    QVarLengthArray<double, 1024> centers;
+    rows.reserve(2 * capacity);
+    centers.reserve(capacity);
+    for (int begin = first; begin <= last; ) {
+        const int end = std::min(last, begin - begin % factor + factor - 1);
+        bool valid = false;
+        float high = 0.0f;
+        float low = 0.0f;
+        for (int x = begin; x <= end; ++x) {
+            const ColumnExtent& column = columns_[x];
+            if (!column.valid) {
+                continue;
+            }
+            high = valid ? std::max(high, column.max) : column.max;
+            low = valid ? std::min(low, column.min) : column.min;
+            valid = true;
+        }
+        if (valid) {
+            rows.append(high);
+            rows.append(low);
+            centers.append(0.5 * (begin + end + 1));
+        }
+        begin = end + 1;
+    }
+    
+    // Map them to pixel rows in one vectorized pass
+    const int count = static_cast<int>(centers.size());
+    SignalKernels::ScaleOffset(rows.constData(), rows.data(), 2 * count, -scale, drawRect.bottom() + minValue * scale,
+                               drawRect.top(), drawRect.bottom());
+    
+    lines.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const double top = rows[2 * i];
+        const double bottom = std::max<double>(rows[2 * i + 1], top + 1.0);
+        lines.append(QLineF(centers[i], top, centers[i], bottom));
+    }
+    return lines;
+}
+
+/**
+ * @brief Makes sure the trace canvas matches the widget size
+ *
+ * The canvas is allocated at device resolution. A newly allocated canvas
+ * is filled from the retained sweep columns. The caller must hold mutex_.
+ */
+void WaveformView::ensureCanvas()
+{
+    const qreal ratio = devicePixelRatioF();
+    const QSize deviceSize = size() * ratio;
+    
+    if (render_mode_ == RenderMode::SweepCanvas && trace_canvas_.size() != deviceSize) {
+        trace_canvas_ = QImage(deviceSize, QImage::Format_ARGB32_Premultiplied);
+        trace_canvas_.setDevicePixelRatio(ratio);
+        redrawCanvas();
+    }
+}
+
+/**
+ * @brief Redraws the complete trace canvas from the sweep columns
+ *
+ * Used when the canvas is reallocated or the scaling range changes. The
+ * pixel-step trace of demo data is not retained and starts over. The caller
+ * must hold mutex_.
+ */
+void WaveformView::redrawCanvas()
+{
+    if (trace_canvas_.isNull()) {
+        return;
+    }
+    trace_canvas_.fill(Qt::transparent);
+    
+    const QVector<QLineF> lines = buildColumnLines(0, static_cast<int>(columns_.size()) - 1);
+    if (lines.isEmpty()) {
+        return;
+    }
+    
+    QPainter canvasPainter(&trace_canvas_);
+    canvasPainter.setPen(columnPen());
+    canvasPainter.drawLines(lines);
+}
+
+/**
+ * @brief Rasterizes the columns changed since the last frame and the erase bar
+ *
+ * Changed columns are cleared and redrawn from their min/max extents, and the
+ * columns just ahead of the cursor are blanked to form the erase bar. The
+ * work is proportional to the number of columns swept since the last frame.
+ * The dirty range is widened to include the erase bar so that the following
+ * updateDirtyColumns() repaints it.
+ */
+void WaveformView::rasterizeSweep()
+{
+    QMutexLocker locker(&mutex_);
+    
+    const qint64 width = columns_.size();
+    if (width == 0 || dirty_end_ < dirty_begin_) {
+        return;
+    }
+    ensureCanvas();
+    
+    const int canvasHeight = height();
+    QPainter canvasPainter(&trace_canvas_);
+    canvasPainter.setCompositionMode(QPainter::CompositionMode_Clear);
+    
+    // Blank the erase bar ahead of the cursor and forget what it covered
+    const qint64 barEnd = dirty_end_ + ERASE_BAR_WIDTH;
+    forEachScreenRange(dirty_end_ + 1, barEnd, width, [&](int first, int last) {
+        canvasPainter.fillRect(QRect(first, 0, last - first + 1, canvasHeight), Qt::transparent);
+        for (int x = first; x <= last; ++x) {
+            columns_[x].valid = false;
+        }
+    });
+    
+    // Redraw the changed columns, whole decimation groups at a time
+    const QPen pen = columnPen();
+    forEachScreenRange(dirty_begin_, dirty_end_, width, [&](int first, int last) {
+        alignToGroups(first, last, quality_.decimation, static_cast<int>(width));
+        canvasPainter.setCompositionMode(QPainter::CompositionMode_Clear);
+        canvasPainter.fillRect(QRect(first, 0, last - first + 1, canvasHeight), Qt::transparent);
+        canvasPainter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+        canvasPainter.setPen(pen);
+        canvasPainter.drawLines(buildColumnLines(first, last));
+    });
+    
+    dirty_end_ = barEnd;
+}
+
+/**
+ * @brief Advances the pixel-step demo trace by one pixel into the canvas
+ *
+ * Produces the same segment per tick as the path based drawWaveform(), but
+ * only rasterizes that segment and the erase bar ahead of it instead of the
+ * whole path accumulated since the left edge.
+ */
+void WaveformView::advancePixelStepCanvas()
+{
+    QMutexLocker locker(&mutex_);
+    
+    if (!model_ || width() <= 0) {
+        return;
+    }
+    ensureCanvas();
+    
+    const int waveformId = model_->GetWaveformId();
+    const int canvasWidth = width();
+    const int canvasHeight = height();
+    
+    const float scaledValue = scaleTrace(ProcessDemoData(waveformId), waveformId, canvasHeight);
+    
+    const QPointF previous = draw_starting_point_;
+    axis_x_ += 1.0;
+    
+    QPainter canvasPainter(&trace_canvas_);
+    
+    if (axis_x_ >= canvasWidth) {
+        // Wrap around to the left edge
+        axis_x_ = 0;
+        draw_starting_point_ = QPointF(axis_x_, scaledValue);
+    } else {
+        // Same segment as the path renderer: a quadratic curve from the
+        // previous point, with the ABP trace returning to the baseline
+        const QPointF control(axis_x_, scaledValue);
+        QPointF end(axis_x_, scaledValue);
+        if (static_cast<VitalSync::WaveformType>(waveformId) == VitalSync::WaveformType::ABP) {
+            end.setY(0);
+        }
+        
+        QPainterPath segment;
+        segment.moveTo(previous);
+        segment.quadTo(control, end);
+        
+        canvasPainter.save();
+        canvasPainter.translate(0, canvasHeight);
+        canvasPainter.scale(1, -1);
+        canvasPainter.setRenderHint(QPainter::Antialiasing, quality_.antialiasing);
+        canvasPainter.setPen(tracePen());
+        canvasPainter.drawPath(segment);
+        canvasPainter.restore();
+        
+        draw_starting_point_ = end;
+    }
+    
+    // Blank the erase bar ahead of the cursor, leaving room for antialiasing
+    const qint64 cursor = static_cast<qint64>(axis_x_);
+    canvasPainter.setCompositionMode(QPainter::CompositionMode_Clear);
+    forEachScreenRange(cursor + 2, cursor + 1 + ERASE_BAR_WIDTH, canvasWidth, [&](int first, int last) {
+        canvasPainter.fillRect(QRect(first, 0, last - first + 1, canvasHeight), Qt::transparent);
+    });
+    canvasPainter.end();
+    
+    // Repaint from the previous point through the erase bar, across the wrap if needed
+    const qint64 repaintBegin = std::max<qint64>(static_cast<qint64>(previous.x()), 0);
+    qint64 repaintEnd = cursor + 1 + ERASE_BAR_WIDTH;
+    if (cursor < repaintBegin) {
+        repaintEnd += canvasWidth;
+    }
+    locker.unlock();
+    
+    forEachScreenRange(repaintBegin, repaintEnd, canvasWidth, [this](int first, int last) {
+        QWidget::update(QRect(first, 0, last - first + 1, height())
+                            .adjusted(-TRACE_REPAINT_MARGIN, 0, TRACE_REPAINT_MARGIN, 0));
+    });
+}
+
+/**
+ * @brief Draws the time-based waveform
+ * @param painter The painter to use
+ * @param exposed The area that needs to be repainted
+ *
+ * Each pixel column is drawn as one vertical line spanning the minimum and
+ * maximum of the samples it covers, so the cost of a repaint depends on the
+ * width of the exposed area and not on the sample rate. A column holding a
+ * single value is drawn as a one pixel high line.
+ */
+void WaveformView::drawTimeBasedWaveform(QPainter& painter, const QRect& exposed)
+{
+    QMutexLocker locker(&mutex_);
+    
+    const int width = static_cast<int>(columns_.size());
+    if (width == 0) {
+        return;
+    }
+    
+    // Whole decimation groups are drawn; the paint engine clips them to the exposed area
+    int first = std::max(exposed.left(), 0);
+    int last = std::min(exposed.right(), width - 1);
+    alignToGroups(first, last, quality_.decimation, width);
+    const QVector<QLineF> lines = buildColumnLines(first, last);
+    
+    painter.setPen(columnPen());
+    painter.setRenderHint(QPainter::Antialiasing, false);
+    painter.drawLines(lines);
+}
+
 /**
  * @brief Processes demo waveform data based on waveform type
  * @param waveformId The waveform ID
@@ -12,14 +12,19 @@
 
 #include <QWidget>
 #include <QPainterPath>
-#include <QTimer>
+#include <QPen>
 #include <QMutex>
 #include <QColor>
+#include <QImage>
+#include <QPixmap>
+#include <QVector>
 #include <memory>
 
 #include <i_waveform_model.h>
 #include <i_waveform_view.h>
 
+class FrameScheduler;
+
 /**
  * @brief Demo data arrays for ECG waveform simulation
  * 
@@ -71,12 +76,28 @@ constexpr static const float respSimulate[995] = {
  * The class implements the IWaveformView interface and uses a model-view architecture where
  * an IWaveformModel provides the data to be displayed. It supports both live data from actual
  * monitoring systems and simulated demo data for various physiological parameters.
+ *
+ * Live data is drawn time-based by default: every sample is placed at the x position
+ * given by its time and the sweep speed, and all samples that fall into one pixel
+ * column are reduced to their minimum and maximum. The default backend rasterizes
+ * only the newly swept columns into a persistent canvas and clears an erase bar
+ * ahead of the cursor, so the cost of a frame does not depend on the widget width.
  */
 class WaveformView : public QWidget, public IWaveformView
 {
     Q_OBJECT
     
 public:
+    /**
+     * @brief How live model data is mapped onto the screen
+     */
+    enum class RenderMode {
+        PixelStep,  ///< Advance one pixel per display tick using the newest sample
+        TimeBased,  ///< Place every sample by time and sweep speed, one min/max pair per column
+        SweepCanvas, ///< Rasterize new sweep segments into a persistent canvas with an erase bar
+        Overview    ///< Show a long time window as one min/max envelope column per pixel
+    };
+    
     /**
      * @brief Constructor
      * @param parent The parent widget
@@ -195,6 +216,56 @@ public:
      */
     bool isPaused() const override;
     
+    /**
+     * @brief Sets the rendering effort of the view
+     * @param quality Rendering settings
+     */
+    void SetRenderQuality(const RenderQuality& quality) override;
+    
+    /**
+     * @brief Gets the rendering effort of the view
+     * @return Rendering settings in use
+     */
+    RenderQuality GetRenderQuality() const override;
+    
+    /**
+     * @brief Sets how live model data is rendered
+     * @param mode The render mode
+     */
+    void SetRenderMode(RenderMode mode);
+    
+    /**
+     * @brief Gets the current render mode
+     * @return The render mode
+     */
+    RenderMode GetRenderMode() const;
+    
+    /**
+     * @brief Sets the time window shown in Overview mode
+     * @param spanMs Length of the window in milliseconds
+     * @param endTimestamp End of the window in milliseconds since epoch, 0 to follow the newest data
+     */
+    void SetOverviewWindow(qint64 spanMs, qint64 endTimestamp = 0);
+    
+    /**
+     * @brief Gets the length of the time window shown in Overview mode
+     * @return Window length in milliseconds
+     */
+    qint64 GetOverviewSpan() const;
+    
+    /**
+     * @brief Connects this view to the shared display clock
+     * @param scheduler The frame scheduler that drives the view
+     */
+    void AttachToScheduler(FrameScheduler* scheduler);
+    
+public slots:
+    /**
+     * @brief Handles a tick of the shared display clock
+     * @param frameTimeMs Monotonic frame time in milliseconds
+     */
+    void OnFrame(qint64 frameTimeMs);
+    
 protected:
     /**
      * @brief Paint event handler
@@ -209,22 +280,23 @@ protected:
     void resizeEvent(QResizeEvent* event) override;
     
 private slots:
-    /**
-     * @brief Handles data updated signals from the model
-     */
-    void HandleDataUpdated();
-    
     /**
      * @brief Handles property changed signals from the model
      */
     void HandlePropertiesChanged();
     
+private:
     /**
-     * @brief Updates the display
+     * @brief Advances the waveform and requests the repaint of the changed area
      */
     void UpdateDisplay();
     
-private:
+    /**
+     * @brief Gets the interval between two pixel steps for the current sweep speed
+     * @return Step interval in milliseconds
+     */
+    int stepIntervalMs() const;
+    
     /**
      * @brief Connects model signals
      */
@@ -260,9 +332,117 @@ private:
      */
     float ProcessDemoData(int waveformId);
     
+    /**
+     * @brief Scales a normalized trace value to the pixel-step display height
+     * @param liveTrace Trace value normalized to the range 0-1
+     * @param waveformId The waveform ID
+     * @param height Height of the drawing area
+     * @return Y position measured from the bottom edge
+     */
+    float scaleTrace(float liveTrace, int waveformId, int height) const;
+    
+    /**
+     * @brief Gets the pen used for the trace of the current model
+     * @return The trace pen
+     */
+    QPen tracePen() const;
+    
+    /**
+     * @brief Gets the pen used for the min/max column lines
+     * @return The trace pen, as wide as the columns merged into one line
+     */
+    QPen columnPen() const;
+    
+    /**
+     * @brief Gets the sweep speed converted to screen pixels
+     * @return Sweep speed in pixels per second
+     */
+    double pixelsPerSecond() const;
+    
+    /**
+     * @brief Clears the time-based sweep and restarts it at the left edge
+     */
+    void resetSweep();
+    
+    /**
+     * @brief Reads all samples that arrived since the last frame into the sweep columns
+     */
+    void ingestSamples();
+    
+    /**
+     * @brief Places one sample on the sweep
+     * @param value The sample value
+     * @param pixelsPerSample Horizontal distance between two consecutive samples
+     */
+    void plotSample(float value, double pixelsPerSample);
+    
+    /**
+     * @brief Fills the columns with the model envelope of the overview window
+     */
+    void refreshOverview();
+    
+    /**
+     * @brief Requests a repaint of the columns changed since the last frame
+     */
+    void updateDirtyColumns();
+    
+    /**
+     * @brief Builds the trace lines of a range of columns
+     * @param first First column to include
+     * @param last Last column to include
+     * @return One vertical min/max line per valid column, or per group of
+     *         columns when decimating
+     */
+    QVector<QLineF> buildColumnLines(int first, int last) const;
+    
+    /**
+     * @brief Makes sure the trace canvas matches the widget size
+     */
+    void ensureCanvas();
+    
+    /**
+     * @brief Rebuilds the cached background and label layers if they are stale
+     */
+    void ensureStaticLayers();
+    
+    /**
+     * @brief Marks the cached background and label layers as stale
+     */
+    void invalidateStaticLayers();
+    
+    /**
+     * @brief Redraws the complete trace canvas from the sweep columns
+     */
+    void redrawCanvas();
+    
+    /**
+     * @brief Rasterizes the columns changed since the last frame and the erase bar into the canvas
+     */
+    void rasterizeSweep();
+    
+    /**
+     * @brief Advances the pixel-step trace by one pixel and rasterizes the new segment into the canvas
+     */
+    void advancePixelStepCanvas();
+    
+    /**
+     * @brief Draws the time-based waveform
+     * @param painter The painter to use
+     * @param exposed The area that needs to be repainted
+     */
+    void drawTimeBasedWaveform(QPainter& painter, const QRect& exposed);
+    
+    /**
+     * @brief Value range of the samples that fell into one pixel column
+     */
+    struct ColumnExtent {
+        float min = 0.0f; /**< Lowest sample in the column */
+        float max = 0.0f; /**< Highest sample in the column */
+        bool valid = false; /**< Whether the column holds any data */
+    };
+    
     // Member variables
     std::shared_ptr<IWaveformModel> model_; /**< The waveform data model */
-    QTimer* display_timer_; /**< Timer for updating the display */
     mutable QMutex mutex_; /**< Mutex for thread safety */
     
     // Path variables
@@ -272,6 +452,38 @@ private:
     
     // Demo data variables
     int wave_form_data_counter_; /**< Counter for cycling through demo data */
+    bool showing_demo_; /**< Whether the view draws the demo trace of a demo model */
+    
+    // Model read position
+    quint64 read_sequence_; /**< Next model sample sequence to read */
+    float last_sample_; /**< Most recent sample value */
+    bool has_sample_; /**< Whether any sample has been read from the model */
+    qint64 unpainted_write_time_; /**< Model write time of samples read but not painted yet, 0 if none */
+    
+    // Time-based sweep
+    RenderMode render_mode_; /**< How live model data is rendered */
+    QVector<ColumnExtent> columns_; /**< Min/max of the samples in each pixel column */
+    double sweep_position_; /**< X position of the next sample, counted from the start of the sweep */
+    qint64 sweep_column_; /**< Column of the last plotted sample, counted from the start of the sweep */
+    qint64 dirty_begin_; /**< First column changed since the last repaint request */
+    qint64 dirty_end_; /**< Last column changed since the last repaint request */
+    
+    // Overview
+    qint64 overview_span_ms_; /**< Length of the overview window in milliseconds */
+    qint64 overview_end_; /**< End of the overview window, 0 to follow the newest data */
+    QVector<EnvelopeColumn> envelope_; /**< Envelope received from the model, reused between frames */
+    
+    // Sweep canvas
+    QImage trace_canvas_; /**< Persistent, transparent canvas holding the rasterized trace */
+    
+    // Static layers
+    QPixmap static_layer_; /**< Cached background and grid, composited below the trace */
+    QPixmap label_layer_; /**< Cached name and scale labels, composited above the trace */
+    
+    // Frame scheduling
+    qint64 last_step_time_; /**< Frame time of the last pixel step */
+    quint64 frame_count_; /**< Display ticks seen, to honour the frame divisor */
+    RenderQuality quality_; /**< Rendering effort set by the quality governor */
     
     // Drawing settings
     double sweep_speed_; /**< Sweep speed in pixels per second */
@@ -283,7 +495,6 @@ private:
     bool is_paused_; /**< Whether the waveform is paused */
     
     // Constants
-    static constexpr int UPDATE_INTERVAL_MS = 40; /**< Default update interval in milliseconds */
     static constexpr int WAVEFORM_MARGIN = 10; /**< Margin around the waveform in pixels */
     static constexpr int DEFAULT_GRID_MINOR_X = 50; /**< Minor grid spacing in X direction */
     static constexpr int DEFAULT_GRID_MINOR_Y = 50; /**< Minor grid spacing in Y direction */
@@ -0,0 +1,174 @@
+/**
+ * @file biquad_cascade.cpp
+ * @brief Implementation of the BiquadCascade class
+ *
+ * This file implements the section designs, after the widely used audio
+ * cookbook formulas, and the bookkeeping of the multi-channel cascade.
+ */
+#include "biquad_cascade.h"
+#include <QtMath>
+#include <algorithm>
+
+/**
+ * @namespace Anonymous namespace for helper functions
+ * @brief Contains the coefficient normalization used by the BiquadCascade implementation
+ */
+namespace {
+    /**
+     * @brief Normalizes section coefficients to a0 = 1
+     * @return Normalized coefficients
+     */
+    BiquadCoefficients normalized(double b0, double b1, double b2, double a0, double a1, double a2)
+    {
+        return BiquadCoefficients{ static_cast<float>(b0 / a0), static_cast<float>(b1 / a0),
+                                   static_cast<float>(b2 / a0), static_cast<float>(a1 / a0),
+                                   static_cast<float>(a2 / a0) };
+    }
+}
+
+/**
+ * @brief Designs a second-order low-pass section
+ * @param sampleRate Sample rate in samples per second
+ * @param cutoffHz Cutoff frequency
+ * @param q Quality factor
+ * @return Section coefficients
+ */
+BiquadCoefficients BiquadCascade::LowPass(double sampleRate, double cutoffHz, double q)
+{
+    const double w = 2.0 * M_PI * cutoffHz / sampleRate;
+    const double alpha = qSin(w) / (2.0 * q);
+    const double c = qCos(w);
+    return normalized((1.0 - c) / 2.0, 1.0 - c, (1.0 - c) / 2.0, 1.0 + alpha, -2.0 * c, 1.0 - alpha);
+}
+
+/**
+ * @brief Designs a second-order high-pass section
+ * @param sampleRate Sample rate in samples per second
+ * @param cutoffHz Cutoff frequency
+ * @param q Quality factor
+ * @return Section coefficients
+ */
+BiquadCoefficients BiquadCascade::HighPass(double sampleRate, double cutoffHz, double q)
+{
+    const double w = 2.0 * M_PI * cutoffHz / sampleRate;
+    const double alpha = qSin(w) / (2.0 * q);
+    const double c = qCos(w);
+    return normalized((1.0 + c) / 2.0, -(1.0 + c), (1.0 + c) / 2.0, 1.0 + alpha, -2.0 * c, 1.0 - alpha);
+}
+
+/**
+ * @brief Designs a notch section
+ * @param sampleRate Sample rate in samples per second
+ * @param centerHz Frequency to remove
+ * @param q Quality factor
+ * @return Section coefficients
+ */
+BiquadCoefficients BiquadCascade::Notch(double sampleRate, double centerHz, double q)
+{
+    const double w = 2.0 * M_PI * centerHz / sampleRate;
+    const double alpha = qSin(w) / (2.0 * q);
+    const double c = qCos(w);
+    return normalized(1.0, -2.0 * c, 1.0, 1.0 + alpha, -2.0 * c, 1.0 - alpha);
+}
+
+/**
+ * @brief Constructs an empty cascade
+ * @param channels Number of channels
+ */
+BiquadCascade::BiquadCascade(int channels)
+    : stage_count_(0)
+    , channels_(0)
+{
+    SetChannelCount(channels);
+}
+
+/**
+ * @brief Appends a section to the chain
+ * @param coefficients Section coefficients
+ * @return False if the chain is full
+ *
+ * The memory of the new section starts cleared.
+ */
+bool BiquadCascade::AddStage(const BiquadCoefficients& coefficients)
+{
+    if (stage_count_ >= SignalKernels::MAX_BIQUAD_STAGES) {
+        return false;
+    }
+    stages_[static_cast<size_t>(stage_count_++)] = coefficients;
+    state_.resize(static_cast<size_t>(2 * stage_count_ * channels_), 0.0f);
+    return true;
+}
+
+/**
+ * @brief Removes all sections and clears the filter memory
+ */
+void BiquadCascade::ClearStages()
+{
+    stage_count_ = 0;
+    state_.clear();
+}
+
+/**
+ * @brief Gets the number of sections
+ * @return Number of sections
+ */
+int BiquadCascade::GetStageCount() const
+{
+    return stage_count_;
+}
+
+/**
+ * @brief Sets the number of channels, clearing the filter memory
+ * @param channels Number of channels, negative values are treated as zero
+ */
+void BiquadCascade::SetChannelCount(int channels)
+{
+    channels_ = std::max(channels, 0);
+    state_.assign(static_cast<size_t>(2 * stage_count_ * channels_), 0.0f);
+}
+
+/**
+ * @brief Gets the number of channels
+ * @return Number of channels
+ */
+int BiquadCascade::GetChannelCount() const
+{
+    return channels_;
+}
+
+/**
+ * @brief Filters a planar block of all channels in place
+ * @param block Samples of the first channel
+ * @param stride Distance between the first samples of two channels
+ * @param count Number of samples per channel
+ */
+void BiquadCascade::Process(float* block, int stride, int count)
+{
+    SignalKernels::BiquadPlanar(stages_.data(), stage_count_, state_.data(), channels_, block, stride, channels_,
+                                count);
+}
+
+/**
+ * @brief Filters the samples of one channel in place
+ * @param channel Channel index
+ * @param samples Samples
+ * @param count Number of samples
+ *
+ * Unknown channels are left unfiltered.
+ */
+void BiquadCascade::ProcessChannel(int channel, float* samples, int count)
+{
+    if (channel < 0 || channel >= channels_) {
+        return;
+    }
+    SignalKernels::BiquadPlanar(stages_.data(), stage_count_, state_.data() + channel, channels_, samples, count, 1,
+                                count);
+}
+
+/**
+ * @brief Clears the filter memory of all channels
+ */
+void BiquadCascade::Reset()
+{
+    std::fill(state_.begin(), state_.end(), 0.0f);
+}
@@ -0,0 +1,119 @@
+/**
+ * @file biquad_cascade.h
+ * @brief Definition of the BiquadCascade class
+ *
+ * This file contains the definition of the BiquadCascade class, a
+ * multi-channel chain of biquad filter sections with the standard filter
+ * designs used on physiological waveforms.
+ */
+#ifndef BIQUAD_CASCADE_H
+#define BIQUAD_CASCADE_H
+
+#include "signal_kernels.h"
+#include <array>
+#include <vector>
+
+/**
+ * @brief Chain of biquad sections applied to several channels
+ *
+ * All channels share the sections and keep their own filter memory, so a
+ * planar block of all channels is filtered in one vectorized pass through
+ * SignalKernels::BiquadPlanar(). Channels that arrive on their own can be
+ * filtered one at a time with the same memory.
+ *
+ * Not thread-safe; each cascade belongs to one thread.
+ */
+class BiquadCascade {
+public:
+    /**
+     * @brief Design a second-order Butterworth-style low-pass section
+     * @param sampleRate Sample rate in samples per second
+     * @param cutoffHz Cutoff frequency
+     * @param q Quality factor, 1/sqrt(2) for a maximally flat response
+     * @return Section coefficients
+     */
+    static BiquadCoefficients LowPass(double sampleRate, double cutoffHz, double q = 0.7071067811865476);
+
+    /**
+     * @brief Design a second-order Butterworth-style high-pass section
+     * @param sampleRate Sample rate in samples per second
+     * @param cutoffHz Cutoff frequency
+     * @param q Quality factor, 1/sqrt(2) for a maximally flat response
+     * @return Section coefficients
+     */
+    static BiquadCoefficients HighPass(double sampleRate, double cutoffHz, double q = 0.7071067811865476);
+
+    /**
+     * @brief Design a notch section
+     * @param sampleRate Sample rate in samples per second
+     * @param centerHz Frequency to remove
+     * @param q Quality factor, the center frequency divided by the notch width
+     * @return Section coefficients
+     */
+    static BiquadCoefficients Notch(double sampleRate, double centerHz, double q);
+
+    /**
+     * @brief Constructor
+     * @param channels Number of channels
+     */
+    explicit BiquadCascade(int channels = 1);
+
+    /**
+     * @brief Append a section to the chain
+     * @param coefficients Section coefficients
+     * @return False if the chain already holds SignalKernels::MAX_BIQUAD_STAGES sections
+     */
+    bool AddStage(const BiquadCoefficients& coefficients);
+
+    /**
+     * @brief Remove all sections and clear the filter memory
+     */
+    void ClearStages();
+
+    /**
+     * @brief Get the number of sections
+     * @return Number of sections
+     */
+    int GetStageCount() const;
+
+    /**
+     * @brief Set the number of channels, clearing the filter memory
+     * @param channels Number of channels
+     */
+    void SetChannelCount(int channels);
+
+    /**
+     * @brief Get the number of channels
+     * @return Number of channels
+     */
+    int GetChannelCount() const;
+
+    /**
+     * @brief Filter a planar block of all channels in place
+     * @param block Samples of the first channel; channel c starts at block + c * stride
+     * @param stride Distance between the first samples of two channels
+     * @param count Number of samples per channel
+     */
+    void Process(float* block, int stride, int count);
+
+    /**
+     * @brief Filter the samples of one channel in place
+     * @param channel Channel index
+     * @param samples Samples
+     * @param count Number of samples
+     */
+    void ProcessChannel(int channel, float* samples, int count);
+
+    /**
+     * @brief Clear the filter memory of all channels
+     */
+    void Reset();
+
+private:
+    std::array<BiquadCoefficients, SignalKernels::MAX_BIQUAD_STAGES> stages_;  ///< Sections in order
+    int stage_count_;                   ///< Number of sections in use
+    int channels_;                      ///< Number of channels
+    std::vector<float> state_;          ///< Filter memory, laid out as BiquadPlanar() expects
+};
+
+#endif // BIQUAD_CASCADE_H
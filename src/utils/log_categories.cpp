@@ -0,0 +1,14 @@
+/**
+ * @file log_categories.cpp
+ * @brief Definition of the logging categories of the application
+ *
+ * Debug messages are disabled by default in every category; warnings and
+ * informational messages are shown.
+ */
+#include "log_categories.h"
+
+Q_LOGGING_CATEGORY(lcIngest, "vitalsync.ingest", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcProvider, "vitalsync.provider", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcDisplay, "vitalsync.display", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcMetrics, "vitalsync.metrics", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcServer, "vitalsync.server", QtInfoMsg)
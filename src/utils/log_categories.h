@@ -0,0 +1,36 @@
+/**
+ * @file log_categories.h
+ * @brief Logging categories of the application
+ *
+ * This file declares the Qt logging categories the application logs under
+ * and the VITALSYNC_TRACE macro for per-chunk and per-value diagnostics on
+ * the hot paths.
+ */
+#ifndef LOG_CATEGORIES_H
+#define LOG_CATEGORIES_H
+
+#include <QLoggingCategory>
+
+Q_DECLARE_LOGGING_CATEGORY(lcIngest)    ///< "vitalsync.ingest": models and the data manager
+Q_DECLARE_LOGGING_CATEGORY(lcProvider)  ///< "vitalsync.provider": data providers
+Q_DECLARE_LOGGING_CATEGORY(lcDisplay)   ///< "vitalsync.display": waveform and parameter views
+Q_DECLARE_LOGGING_CATEGORY(lcMetrics)   ///< "vitalsync.metrics": periodic metrics reports
+Q_DECLARE_LOGGING_CATEGORY(lcServer)    ///< "vitalsync.server": the headless server
+
+/**
+ * @def VITALSYNC_TRACE(category)
+ * @brief Debug stream for diagnostics written for every chunk or value
+ *
+ * Unless the build defines VITALSYNC_TRACE_LOGGING, the statement is
+ * compiled out entirely, including the evaluation of its arguments. When it
+ * is compiled in, it behaves like qCDebug(category); the debug level of the
+ * categories is off by default and is enabled with a logging rule such as
+ * QT_LOGGING_RULES="vitalsync.ingest.debug=true".
+ */
+#if defined(VITALSYNC_TRACE_LOGGING)
+#define VITALSYNC_TRACE(category) qCDebug(category)
+#else
+#define VITALSYNC_TRACE(category) while (false) qCDebug(category)
+#endif
+
+#endif // LOG_CATEGORIES_H
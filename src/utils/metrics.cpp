@@ -0,0 +1,381 @@
+/**
+ * @file metrics.cpp
+ * @brief Implementation of the Metrics class
+ *
+ * This file implements the per-thread shards the metrics are recorded in,
+ * their registry, and the summing and formatting of snapshots.
+ */
+#include "metrics.h"
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStringList>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+/**
+ * @namespace Anonymous namespace for the shard registry
+ * @brief Contains the per-thread storage used by the Metrics implementation
+ */
+namespace {
+    /**
+     * @brief Recording state of one histogram in one thread
+     */
+    struct HistogramShard {
+        std::atomic<quint64> count{ 0 };
+        std::atomic<quint64> sum{ 0 };
+        std::atomic<quint64> max{ 0 };
+        std::array<std::atomic<quint64>, Metrics::HISTOGRAM_BUCKETS> buckets{};
+    };
+
+    /**
+     * @brief Counters and histograms written by one thread only
+     *
+     * The values are atomics so that TakeSnapshot() may read them while the
+     * owner writes, but the owner never needs more than a relaxed store.
+     * Shards are cache line aligned to keep threads from sharing lines.
+     */
+    struct alignas(64) Shard {
+        std::array<std::atomic<quint64>, Metrics::COUNTER_COUNT> counters{};
+        std::array<HistogramShard, Metrics::HISTOGRAM_COUNT> histograms;
+    };
+
+    /**
+     * @brief Adds to a value that only the calling thread writes
+     * @param value Value to add to
+     * @param amount Amount to add
+     */
+    inline void bump(std::atomic<quint64>& value, quint64 amount)
+    {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Adds the values of a shard to snapshot totals
+     * @param shard Shard to read
+     * @param out Totals to add to
+     */
+    void accumulate(const Shard& shard, Metrics::Snapshot& out)
+    {
+        for (int i = 0; i < Metrics::COUNTER_COUNT; ++i) {
+            out.counters[static_cast<size_t>(i)] += shard.counters[static_cast<size_t>(i)].load(std::memory_order_relaxed);
+        }
+        for (int h = 0; h < Metrics::HISTOGRAM_COUNT; ++h) {
+            const HistogramShard& in = shard.histograms[static_cast<size_t>(h)];
+            Metrics::HistogramData& total = out.histograms[static_cast<size_t>(h)];
+            total.count += in.count.load(std::memory_order_relaxed);
+            total.sum += in.sum.load(std::memory_order_relaxed);
+            total.max = std::max(total.max, in.max.load(std::memory_order_relaxed));
+            for (int b = 0; b < Metrics::HISTOGRAM_BUCKETS; ++b) {
+                total.buckets[static_cast<size_t>(b)] += in.buckets[static_cast<size_t>(b)].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Shards of the live threads and the totals of exited ones
+     */
+    struct Registry {
+        QMutex mutex;
+        std::vector<Shard*> shards;
+        Metrics::Snapshot retired;
+    };
+
+    /**
+     * @brief Gets the registry
+     * @return Registry, created on first use and never destroyed
+     *
+     * The registry outlives every thread_local shard owner, including those of
+     * threads that exit during static destruction.
+     */
+    Registry& registry()
+    {
+        static Registry* instance = new Registry();
+        return *instance;
+    }
+
+    /**
+     * @brief Owner of the calling thread's shard
+     *
+     * Registers the shard on construction. When the thread exits, its values
+     * are folded into the retired totals and the shard is released.
+     */
+    struct ShardOwner {
+        std::unique_ptr<Shard> shard;
+
+        ShardOwner()
+            : shard(std::make_unique<Shard>())
+        {
+            Registry& r = registry();
+            QMutexLocker locker(&r.mutex);
+            r.shards.push_back(shard.get());
+        }
+
+        ~ShardOwner()
+        {
+            Registry& r = registry();
+            QMutexLocker locker(&r.mutex);
+            accumulate(*shard, r.retired);
+            r.shards.erase(std::remove(r.shards.begin(), r.shards.end(), shard.get()), r.shards.end());
+        }
+    };
+
+    /**
+     * @brief Gets the calling thread's shard
+     * @return Shard, registered on first use
+     */
+    Shard& localShard()
+    {
+        thread_local ShardOwner owner;
+        return *owner.shard;
+    }
+
+    /**
+     * @brief Gets the bucket of a value
+     * @param value Value
+     * @return 0 for 0, otherwise one more than the index of the highest set bit
+     */
+    inline int bucketOf(quint64 value)
+    {
+        return std::min(static_cast<int>(std::bit_width(value)), Metrics::HISTOGRAM_BUCKETS - 1);
+    }
+
+    std::atomic<bool> recording_enabled{ true };   ///< Whether values are recorded
+}
+
+/**
+ * @brief Gets the mean of the recorded values
+ * @return Mean, 0 if nothing was recorded
+ */
+double Metrics::HistogramData::Mean() const
+{
+    return count > 0 ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+}
+
+/**
+ * @brief Estimates a percentile from the buckets
+ * @param fraction Percentile as a fraction, 0.99 for the 99th
+ * @return Upper bound of the bucket holding the percentile, at most max
+ */
+quint64 Metrics::HistogramData::Percentile(double fraction) const
+{
+    if (count == 0) {
+        return 0;
+    }
+    const quint64 rank = std::max<quint64>(1, static_cast<quint64>(std::clamp(fraction, 0.0, 1.0) * count + 0.5));
+    quint64 seen = 0;
+    for (int b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+        seen += buckets[static_cast<size_t>(b)];
+        if (seen >= rank) {
+            const quint64 upper = b == 0 ? 0 : (quint64(1) << b) - 1;
+            return std::min(upper, max);
+        }
+    }
+    return max;
+}
+
+/**
+ * @brief Gets what was recorded since an earlier snapshot
+ * @param earlier Earlier snapshot
+ * @return Difference, with takenAt holding the length of the interval;
+ *         maxima cover the whole lifetime, not the interval
+ */
+Metrics::Snapshot Metrics::Snapshot::Since(const Snapshot& earlier) const
+{
+    Snapshot interval = *this;
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        interval.counters[static_cast<size_t>(i)] -= earlier.counters[static_cast<size_t>(i)];
+    }
+    for (int h = 0; h < HISTOGRAM_COUNT; ++h) {
+        HistogramData& total = interval.histograms[static_cast<size_t>(h)];
+        const HistogramData& before = earlier.histograms[static_cast<size_t>(h)];
+        total.count -= before.count;
+        total.sum -= before.sum;
+        for (int b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+            total.buckets[static_cast<size_t>(b)] -= before.buckets[static_cast<size_t>(b)];
+        }
+    }
+    interval.takenAt = takenAt - earlier.takenAt;
+    return interval;
+}
+
+/**
+ * @brief Gets the monotonic clock recordings are measured with
+ * @return Microseconds since an arbitrary epoch
+ */
+qint64 Metrics::Now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Gets the wall clock, to compare with provider timestamps
+ * @return Microseconds since the Unix epoch
+ */
+qint64 Metrics::WallClock()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Checks if recording is enabled
+ * @return True if values are recorded
+ */
+bool Metrics::IsEnabled()
+{
+    return recording_enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Enables or disables recording
+ * @param enabled True to record values
+ */
+void Metrics::SetEnabled(bool enabled)
+{
+    recording_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Adds to a counter
+ * @param counter Counter
+ * @param amount Amount to add
+ */
+void Metrics::Add(Counter counter, quint64 amount)
+{
+    if (!IsEnabled()) {
+        return;
+    }
+    bump(localShard().counters[static_cast<size_t>(counter)], amount);
+}
+
+/**
+ * @brief Records a value in a histogram
+ * @param histogram Histogram
+ * @param value Value; negative values are recorded as 0
+ */
+void Metrics::Record(Histogram histogram, qint64 value)
+{
+    if (!IsEnabled()) {
+        return;
+    }
+    const quint64 v = value > 0 ? static_cast<quint64>(value) : 0;
+    HistogramShard& h = localShard().histograms[static_cast<size_t>(histogram)];
+    bump(h.count, 1);
+    bump(h.sum, v);
+    if (v > h.max.load(std::memory_order_relaxed)) {
+        h.max.store(v, std::memory_order_relaxed);
+    }
+    bump(h.buckets[static_cast<size_t>(bucketOf(v))], 1);
+}
+
+/**
+ * @brief Records the time elapsed since a Now() reading
+ * @param histogram Histogram
+ * @param start Earlier Now() reading
+ */
+void Metrics::RecordSince(Histogram histogram, qint64 start)
+{
+    Record(histogram, Now() - start);
+}
+
+/**
+ * @brief Sums the shards of all threads
+ * @return Current totals
+ *
+ * Values recorded while the shards are read may or may not be included, and
+ * a histogram's count and buckets may briefly disagree by those values.
+ */
+Metrics::Snapshot Metrics::TakeSnapshot()
+{
+    Registry& r = registry();
+    QMutexLocker locker(&r.mutex);
+    Snapshot snapshot = r.retired;
+    for (const Shard* shard : r.shards) {
+        accumulate(*shard, snapshot);
+    }
+    snapshot.takenAt = Now();
+    return snapshot;
+}
+
+/**
+ * @brief Gets the display name of a counter
+ * @param counter Counter
+ * @return Name
+ */
+QString Metrics::GetName(Counter counter)
+{
+    switch (counter) {
+        case Counter::FramesIngested:           return QStringLiteral("Frames ingested");
+        case Counter::SamplesIngested:          return QStringLiteral("Samples ingested");
+        case Counter::SamplesDropped:           return QStringLiteral("Samples dropped");
+        case Counter::OutOfOrderRejects:        return QStringLiteral("Out-of-order rejects");
+        case Counter::NetworkFramesLost:        return QStringLiteral("Network frames lost");
+        case Counter::RecordingChunksDropped:   return QStringLiteral("Recording chunks dropped");
+        case Counter::SampleBlocksAllocated:    return QStringLiteral("Sample blocks allocated");
+        case Counter::StreamFramesSent:         return QStringLiteral("Stream frames sent");
+        case Counter::StreamFramesDropped:      return QStringLiteral("Stream frames dropped");
+        default:                                return QStringLiteral("Unknown");
+    }
+}
+
+/**
+ * @brief Gets the display name of a histogram
+ * @param histogram Histogram
+ * @return Name
+ */
+QString Metrics::GetName(Histogram histogram)
+{
+    switch (histogram) {
+        case Histogram::IngestLatency:          return QStringLiteral("Ingest latency");
+        case Histogram::DisplayLatency:         return QStringLiteral("Display latency");
+        case Histogram::WaveformPaint:          return QStringLiteral("Waveform paint");
+        case Histogram::GlWaveformPaint:        return QStringLiteral("GL waveform paint");
+        case Histogram::ParameterPaint:         return QStringLiteral("Parameter paint");
+        case Histogram::FrameInterval:          return QStringLiteral("Frame interval");
+        case Histogram::RecorderQueueDepth:     return QStringLiteral("Recorder queue depth");
+        default:                                return QStringLiteral("Unknown");
+    }
+}
+
+/**
+ * @brief Formats an interval as text, one metric per line
+ * @param interval Difference of two snapshots, as returned by Snapshot::Since()
+ * @return Counter rates and histogram percentiles of the interval
+ *
+ * Counters are shown as totals and rates per second. Histograms without
+ * values in the interval are left out; durations are shown in
+ * milliseconds, the queue depth in chunks.
+ */
+QString Metrics::Format(const Snapshot& interval)
+{
+    const double seconds = std::max(interval.takenAt, qint64(1)) / 1e6;
+    QStringList lines;
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        const Counter counter = static_cast<Counter>(i);
+        const quint64 total = interval.Get(counter);
+        lines << QStringLiteral("%1: %2 (%3/s)").arg(GetName(counter)).arg(total)
+                 .arg(static_cast<double>(total) / seconds, 0, 'f', 1);
+    }
+    for (int h = 0; h < HISTOGRAM_COUNT; ++h) {
+        const Histogram histogram = static_cast<Histogram>(h);
+        const HistogramData& data = interval.Get(histogram);
+        if (data.count == 0) {
+            continue;
+        }
+        const double scale = histogram == Histogram::RecorderQueueDepth ? 1.0 : 1e-3;
+        const QString unit = histogram == Histogram::RecorderQueueDepth ? QString() : QStringLiteral(" ms");
+        lines << QStringLiteral("%1: n=%2 mean=%3%7 p50=%4%7 p99=%5%7 max=%6%7")
+                 .arg(GetName(histogram)).arg(data.count)
+                 .arg(data.Mean() * scale, 0, 'f', 2)
+                 .arg(data.Percentile(0.5) * scale, 0, 'f', 2)
+                 .arg(data.Percentile(0.99) * scale, 0, 'f', 2)
+                 .arg(data.max * scale, 0, 'f', 2)
+                 .arg(unit);
+    }
+    return lines.join(QLatin1Char('\n'));
+}
@@ -0,0 +1,232 @@
+/**
+ * @file metrics.h
+ * @brief Definition of the Metrics class
+ *
+ * This file contains the definition of the Metrics class, the built-in
+ * counters and latency histograms of the acquisition and display paths, and
+ * of the ScopedMetricsTimer helper that times a block into a histogram.
+ */
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <QString>
+#include <QtGlobal>
+#include <array>
+
+/**
+ * @brief Low-overhead hot-path counters and histograms
+ *
+ * Every thread that records a value gets its own shard of counters and
+ * histogram buckets on first use. Recording only touches the calling
+ * thread's shard, with plain relaxed loads and stores: there is no lock, no
+ * atomic read-modify-write and no shared cache line on the hot path.
+ * TakeSnapshot() sums all shards, together with the totals of threads that
+ * have exited, under a mutex that recorders never take.
+ *
+ * Histograms have logarithmic buckets: bucket 0 holds the value 0 and bucket b
+ * the values in [2^(b-1), 2^b), so percentiles are exact to within a factor
+ * of two while a histogram stays a few hundred bytes. Latencies and
+ * durations are recorded in microseconds. The ingest latency compares frame
+ * timestamps with the local wall clock, so for network sources it also
+ * contains the offset between the sender's clock and ours.
+ *
+ * Recording is enabled by default and can be switched off at run time, which
+ * reduces every call to one relaxed load.
+ */
+class Metrics {
+public:
+    /**
+     * @brief Event counters
+     */
+    enum class Counter {
+        FramesIngested,         ///< Frames and chunks handled by the data managers
+        SamplesIngested,        ///< Waveform samples handled by the data managers
+        SamplesDropped,         ///< Samples overwritten before a view could show them
+        OutOfOrderRejects,      ///< Chunks and values rejected for an old timestamp
+        NetworkFramesLost,      ///< Frames missing from a network stream's sequence
+        RecordingChunksDropped, ///< Recording chunks dropped because the writer fell behind
+        SampleBlocksAllocated,  ///< Sample blocks allocated because the pool had none free
+        StreamFramesSent,       ///< Encoded frames written to stream subscribers
+        StreamFramesDropped,    ///< Encoded frames dropped for stream subscribers that fell behind
+        COUNT                   ///< Number of counters
+    };
+
+    /**
+     * @brief Value distributions
+     */
+    enum class Histogram {
+        IngestLatency,          ///< Frame timestamp to the end of its dispatch to the models, in microseconds
+        DisplayLatency,         ///< Model write to the paint that shows it, in microseconds
+        WaveformPaint,          ///< WaveformView paint duration, in microseconds
+        GlWaveformPaint,        ///< GLWaveformView paint duration, in microseconds
+        ParameterPaint,         ///< ParameterView paint duration, in microseconds
+        FrameInterval,          ///< Time between two ticks of the display clock, in microseconds
+        RecorderQueueDepth,     ///< Chunks waiting for the recording writer
+        COUNT                   ///< Number of histograms
+    };
+
+    static constexpr int COUNTER_COUNT = static_cast<int>(Counter::COUNT);       ///< Number of counters
+    static constexpr int HISTOGRAM_COUNT = static_cast<int>(Histogram::COUNT);   ///< Number of histograms
+    static constexpr int HISTOGRAM_BUCKETS = 40;    ///< Buckets per histogram, the last one open-ended
+
+    /**
+     * @brief Summed state of one histogram
+     */
+    struct HistogramData {
+        quint64 count = 0;      ///< Number of recorded values
+        quint64 sum = 0;        ///< Sum of the recorded values
+        quint64 max = 0;        ///< Largest recorded value
+        std::array<quint64, HISTOGRAM_BUCKETS> buckets = {};   ///< Values per bucket
+
+        /**
+         * @brief Get the mean of the recorded values
+         * @return Mean, 0 if nothing was recorded
+         */
+        double Mean() const;
+
+        /**
+         * @brief Estimate a percentile from the buckets
+         * @param fraction Percentile as a fraction, 0.99 for the 99th
+         * @return Upper bound of the bucket holding the percentile, at most max
+         */
+        quint64 Percentile(double fraction) const;
+    };
+
+    /**
+     * @brief Totals of all counters and histograms at one point in time
+     */
+    struct Snapshot {
+        qint64 takenAt = 0;     ///< Now() when the snapshot was taken
+        std::array<quint64, COUNTER_COUNT> counters = {};           ///< Counter totals
+        std::array<HistogramData, HISTOGRAM_COUNT> histograms = {}; ///< Histogram totals
+
+        /**
+         * @brief Get the total of a counter
+         * @param counter Counter
+         * @return Total
+         */
+        quint64 Get(Counter counter) const { return counters[static_cast<size_t>(counter)]; }
+
+        /**
+         * @brief Get the totals of a histogram
+         * @param histogram Histogram
+         * @return Totals
+         */
+        const HistogramData& Get(Histogram histogram) const { return histograms[static_cast<size_t>(histogram)]; }
+
+        /**
+         * @brief Get what was recorded since an earlier snapshot
+         * @param earlier Earlier snapshot
+         * @return Difference, with takenAt holding the length of the interval;
+         *         maxima cover the whole lifetime, not the interval
+         */
+        Snapshot Since(const Snapshot& earlier) const;
+    };
+
+    /**
+     * @brief Get the monotonic clock recordings are measured with
+     * @return Microseconds since an arbitrary epoch
+     */
+    static qint64 Now();
+
+    /**
+     * @brief Get the wall clock, to compare with provider timestamps
+     * @return Microseconds since the Unix epoch
+     */
+    static qint64 WallClock();
+
+    /**
+     * @brief Check if recording is enabled
+     * @return True if values are recorded
+     */
+    static bool IsEnabled();
+
+    /**
+     * @brief Enable or disable recording
+     * @param enabled True to record values
+     */
+    static void SetEnabled(bool enabled);
+
+    /**
+     * @brief Add to a counter
+     * @param counter Counter
+     * @param amount Amount to add
+     */
+    static void Add(Counter counter, quint64 amount = 1);
+
+    /**
+     * @brief Record a value in a histogram
+     * @param histogram Histogram
+     * @param value Value; negative values are recorded as 0
+     */
+    static void Record(Histogram histogram, qint64 value);
+
+    /**
+     * @brief Record the time elapsed since a Now() reading
+     * @param histogram Histogram
+     * @param start Earlier Now() reading
+     */
+    static void RecordSince(Histogram histogram, qint64 start);
+
+    /**
+     * @brief Sum the shards of all threads
+     * @return Current totals
+     */
+    static Snapshot TakeSnapshot();
+
+    /**
+     * @brief Get the display name of a counter
+     * @param counter Counter
+     * @return Name
+     */
+    static QString GetName(Counter counter);
+
+    /**
+     * @brief Get the display name of a histogram
+     * @param histogram Histogram
+     * @return Name
+     */
+    static QString GetName(Histogram histogram);
+
+    /**
+     * @brief Format an interval as text, one metric per line
+     * @param interval Difference of two snapshots, as returned by Snapshot::Since()
+     * @return Counter rates and histogram percentiles of the interval
+     */
+    static QString Format(const Snapshot& interval);
+};
+
+/**
+ * @brief Records the duration of a scope in a histogram
+ */
+class ScopedMetricsTimer {
+public:
+    /**
+     * @brief Constructor, starts timing
+     * @param histogram Histogram the duration is recorded in
+     */
+    explicit ScopedMetricsTimer(Metrics::Histogram histogram)
+        : histogram_(histogram)
+        , start_(Metrics::IsEnabled() ? Metrics::Now() : 0)
+    {
+    }
+
+    /**
+     * @brief Destructor, records the duration
+     */
+    ~ScopedMetricsTimer()
+    {
+        if (start_ != 0) {
+            Metrics::RecordSince(histogram_, start_);
+        }
+    }
+
+    ScopedMetricsTimer(const ScopedMetricsTimer&) = delete;
+    ScopedMetricsTimer& operator=(const ScopedMetricsTimer&) = delete;
+
+private:
+    Metrics::Histogram histogram_;      ///< Histogram the duration is recorded in
+    qint64 start_;                      ///< Now() at construction, 0 when not recording
+};
+
+#endif // METRICS_H
@@ -0,0 +1,68 @@
+/**
+ * @file metrics_reporter.cpp
+ * @brief Implementation of the MetricsReporter class
+ *
+ * This file implements the periodic logging of the metrics.
+ */
+#include "metrics_reporter.h"
+#include "log_categories.h"
+#include "../../include/sample_block_pool.h"
+
+/**
+ * @brief Constructs a MetricsReporter
+ * @param parent The parent QObject
+ *
+ * Nothing is reported until Start() is called.
+ */
+MetricsReporter::MetricsReporter(QObject* parent)
+    : QObject(parent)
+    , timer_(this)
+{
+    connect(&timer_, &QTimer::timeout, this, &MetricsReporter::HandleTimeout);
+}
+
+/**
+ * @brief Starts reporting
+ * @param intervalMs Interval between two reports in milliseconds; 0 or less stops reporting
+ *
+ * The first report covers the time from this call on.
+ */
+void MetricsReporter::Start(int intervalMs)
+{
+    if (intervalMs <= 0) {
+        Stop();
+        return;
+    }
+    previous_ = Metrics::TakeSnapshot();
+    timer_.start(intervalMs);
+}
+
+/**
+ * @brief Stops reporting
+ */
+void MetricsReporter::Stop()
+{
+    timer_.stop();
+}
+
+/**
+ * @brief Checks if reports are being written
+ * @return True if running
+ */
+bool MetricsReporter::isRunning() const
+{
+    return timer_.isActive();
+}
+
+/**
+ * @brief Logs the metrics of the interval that just ended
+ */
+void MetricsReporter::HandleTimeout()
+{
+    const Metrics::Snapshot current = Metrics::TakeSnapshot();
+    const Metrics::Snapshot interval = current.Since(previous_);
+    previous_ = current;
+    qCInfo(lcMetrics).noquote() << QStringLiteral("Metrics of the last %1 s:\n").arg(interval.takenAt / 1e6, 0, 'f', 1)
+                                   + Metrics::Format(interval) + QLatin1Char('\n')
+                                   + VitalSync::SampleBlockPool::GetInstance().FormatStatistics();
+}
@@ -0,0 +1,61 @@
+/**
+ * @file metrics_reporter.h
+ * @brief Definition of the MetricsReporter class
+ *
+ * This file contains the definition of the MetricsReporter class, which
+ * writes the metrics of every interval to the log.
+ */
+#ifndef METRICS_REPORTER_H
+#define METRICS_REPORTER_H
+
+#include "metrics.h"
+#include <QObject>
+#include <QTimer>
+
+/**
+ * @brief Periodic dump of the metrics
+ *
+ * Every interval, the counter rates and histogram percentiles recorded since
+ * the previous report are logged as one info message in the
+ * "vitalsync.metrics" category.
+ */
+class MetricsReporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor
+     * @param parent Parent QObject
+     */
+    explicit MetricsReporter(QObject* parent = nullptr);
+
+    /**
+     * @brief Start reporting
+     * @param intervalMs Interval between two reports in milliseconds; 0 or less stops reporting
+     */
+    void Start(int intervalMs);
+
+    /**
+     * @brief Stop reporting
+     */
+    void Stop();
+
+    /**
+     * @brief Check if reports are being written
+     * @return True if running
+     */
+    bool isRunning() const;
+
+private slots:
+    /**
+     * @brief Logs the metrics of the interval that just ended
+     */
+    void HandleTimeout();
+
+private:
+    QTimer timer_;                      ///< Report interval timer
+    Metrics::Snapshot previous_;        ///< Totals at the previous report
+};
+
+#endif // METRICS_REPORTER_H
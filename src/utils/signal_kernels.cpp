@@ -0,0 +1,296 @@
+/**
+ * @file signal_kernels.cpp
+ * @brief Implementation of the SignalKernels class
+ *
+ * This file implements the NEON register abstraction, the processor feature
+ * detection and the dispatch of the signal kernels. The scalar and SSE2
+ * kernels come from signal_kernels_impl.h; the AVX2 kernels live in
+ * signal_kernels_avx2.cpp, which is the only file compiled with AVX2 enabled.
+ */
+#include "signal_kernels.h"
+#include "signal_kernels_impl.h"
+#include <atomic>
+
+#if defined(VITALSYNC_KERNELS_SSE2) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define VITALSYNC_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+/**
+ * @namespace Anonymous namespace for the NEON registers and dispatch
+ * @brief Contains the NEON registers and the kernel tables
+ */
+namespace {
+#if defined(VITALSYNC_KERNELS_NEON)
+    /**
+     * @brief Four float lanes in a NEON register
+     */
+    struct NeonLanes {
+        using Reg = float32x4_t;
+        static constexpr int WIDTH = 4;
+
+        static Reg Load(const float* p) { return vld1q_f32(p); }
+        static void Store(float* p, Reg v) { vst1q_f32(p, v); }
+        static Reg Set1(float v) { return vdupq_n_f32(v); }
+        static Reg Mul(Reg a, Reg b) { return vmulq_f32(a, b); }
+        static Reg MulAdd(Reg a, Reg b, Reg c) { return vmlaq_f32(c, a, b); }
+        static Reg Min(Reg a, Reg b) { return vminq_f32(a, b); }
+        static Reg Max(Reg a, Reg b) { return vmaxq_f32(a, b); }
+
+        static float ReduceMin(Reg v)
+        {
+            float32x2_t half = vpmin_f32(vget_low_f32(v), vget_high_f32(v));
+            return vget_lane_f32(vpmin_f32(half, half), 0);
+        }
+
+        static float ReduceMax(Reg v)
+        {
+            float32x2_t half = vpmax_f32(vget_low_f32(v), vget_high_f32(v));
+            return vget_lane_f32(vpmax_f32(half, half), 0);
+        }
+
+        static void Transpose(Reg* r)
+        {
+            const float32x4x2_t ab = vtrnq_f32(r[0], r[1]);
+            const float32x4x2_t cd = vtrnq_f32(r[2], r[3]);
+            r[0] = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+            r[1] = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+            r[2] = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+            r[3] = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+        }
+    };
+#endif
+
+    /**
+     * @brief Kernel implementations of one instruction set
+     */
+    struct KernelTable {
+        SignalKernels::InstructionSet instruction_set;
+        void (*scale_offset)(const float*, float*, int, float, float, float, float);
+        void (*min_max)(const float*, int, float&, float&);
+        void (*biquad_planar)(const BiquadCoefficients*, int, float*, int, float*, int, int, int);
+    };
+
+    const KernelTable SCALAR_TABLE = {
+        SignalKernels::InstructionSet::Scalar, scaleOffsetScalar, minMaxScalar, biquadPlanarScalar
+    };
+
+#if defined(VITALSYNC_KERNELS_SSE2)
+    const KernelTable SSE2_TABLE = {
+        SignalKernels::InstructionSet::SSE2, scaleOffsetLanes<SseLanes>, minMaxLanes<SseLanes>,
+        biquadPlanarLanes<SseLanes>
+    };
+#endif
+
+#if defined(VITALSYNC_KERNELS_AVX2)
+    const KernelTable AVX2_TABLE = {
+        SignalKernels::InstructionSet::AVX2, SignalKernelsAvx2::ScaleOffset, SignalKernelsAvx2::MinMax,
+        SignalKernelsAvx2::BiquadPlanar
+    };
+#endif
+
+#if defined(VITALSYNC_KERNELS_NEON)
+    const KernelTable NEON_TABLE = {
+        SignalKernels::InstructionSet::NEON, scaleOffsetLanes<NeonLanes>, minMaxLanes<NeonLanes>,
+        biquadPlanarLanes<NeonLanes>
+    };
+#endif
+
+    /**
+     * @brief Checks whether the processor and operating system support AVX2 and FMA
+     * @return True if the AVX2 kernels may run
+     */
+    bool cpuSupportsAvx2()
+    {
+#if defined(VITALSYNC_KERNELS_AVX2) && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(VITALSYNC_KERNELS_AVX2) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        const bool fma = (info[2] & (1 << 12)) != 0;
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        if (!fma || !osxsave || (_xgetbv(0) & 0x6) != 0x6) {
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Gets the kernel table of an instruction set
+     * @param instructionSet Instruction set
+     * @return Table, or nullptr if the build or processor does not support it
+     */
+    const KernelTable* tableFor(SignalKernels::InstructionSet instructionSet)
+    {
+        switch (instructionSet) {
+            case SignalKernels::InstructionSet::Scalar:
+                return &SCALAR_TABLE;
+#if defined(VITALSYNC_KERNELS_SSE2)
+            case SignalKernels::InstructionSet::SSE2:
+                return &SSE2_TABLE;
+#endif
+#if defined(VITALSYNC_KERNELS_AVX2)
+            case SignalKernels::InstructionSet::AVX2:
+                return cpuSupportsAvx2() ? &AVX2_TABLE : nullptr;
+#endif
+#if defined(VITALSYNC_KERNELS_NEON)
+            case SignalKernels::InstructionSet::NEON:
+                return &NEON_TABLE;
+#endif
+            default:
+                return nullptr;
+        }
+    }
+
+    /**
+     * @brief Gets the fastest kernel table the processor supports
+     * @return Kernel table
+     */
+    const KernelTable* bestTable()
+    {
+        for (SignalKernels::InstructionSet instructionSet : { SignalKernels::InstructionSet::AVX2,
+                                                              SignalKernels::InstructionSet::SSE2,
+                                                              SignalKernels::InstructionSet::NEON }) {
+            if (const KernelTable* table = tableFor(instructionSet)) {
+                return table;
+            }
+        }
+        return &SCALAR_TABLE;
+    }
+
+    /**
+     * @brief Gets the table selected for the kernels
+     * @return Table pointer, selected on first use
+     */
+    std::atomic<const KernelTable*>& activeTable()
+    {
+        static std::atomic<const KernelTable*> table{ bestTable() };
+        return table;
+    }
+
+    /**
+     * @brief Gets the active kernels
+     * @return Kernel table
+     */
+    const KernelTable& kernels()
+    {
+        return *activeTable().load(std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Gets the instruction set the kernels currently use
+ * @return Active instruction set
+ */
+SignalKernels::InstructionSet SignalKernels::GetInstructionSet()
+{
+    return kernels().instruction_set;
+}
+
+/**
+ * @brief Gets the best instruction set this processor supports
+ * @return Fastest supported instruction set
+ */
+SignalKernels::InstructionSet SignalKernels::GetBestInstructionSet()
+{
+    return bestTable()->instruction_set;
+}
+
+/**
+ * @brief Selects the instruction set the kernels use
+ * @param instructionSet Instruction set to use
+ * @return False if the processor or build does not support it
+ *
+ * Meant for benchmarks and for comparing results; calls already running
+ * finish with the previous implementation.
+ */
+bool SignalKernels::SetInstructionSet(InstructionSet instructionSet)
+{
+    const KernelTable* table = tableFor(instructionSet);
+    if (!table) {
+        return false;
+    }
+    activeTable().store(table, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief Gets the name of an instruction set
+ * @param instructionSet Instruction set
+ * @return Name for logs and reports
+ */
+const char* SignalKernels::GetInstructionSetName(InstructionSet instructionSet)
+{
+    switch (instructionSet) {
+        case InstructionSet::SSE2:
+            return "SSE2";
+        case InstructionSet::AVX2:
+            return "AVX2";
+        case InstructionSet::NEON:
+            return "NEON";
+        default:
+            return "Scalar";
+    }
+}
+
+/**
+ * @brief Applies a gain and offset to samples and clamps the results
+ * @param in Input samples
+ * @param out Output samples, may be the same as in
+ * @param count Number of samples
+ * @param gain Factor applied to every sample
+ * @param offset Value added after the gain
+ * @param low Lowest output value
+ * @param high Highest output value
+ */
+void SignalKernels::ScaleOffset(const float* in, float* out, int count, float gain, float offset, float low, float high)
+{
+    if (count > 0) {
+        kernels().scale_offset(in, out, count, gain, offset, low, high);
+    }
+}
+
+/**
+ * @brief Finds the smallest and largest of a run of samples
+ * @param in Input samples, not containing NaN
+ * @param count Number of samples
+ * @param min Receives the smallest sample
+ * @param max Receives the largest sample
+ *
+ * min and max are left unchanged if count is not positive.
+ */
+void SignalKernels::MinMax(const float* in, int count, float& min, float& max)
+{
+    if (count > 0) {
+        kernels().min_max(in, count, min, max);
+    }
+}
+
+/**
+ * @brief Filters a planar multi-channel block in place through a biquad cascade
+ * @param stages Filter sections, applied in order
+ * @param stageCount Number of sections, limited to MAX_BIQUAD_STAGES
+ * @param state Filter memory, two values per section and channel
+ * @param stateStride Distance between the memory rows of two sections' values
+ * @param block Samples of the first channel
+ * @param stride Distance between the first samples of two channels
+ * @param channels Number of channels
+ * @param count Number of samples per channel
+ */
+void SignalKernels::BiquadPlanar(const BiquadCoefficients* stages, int stageCount, float* state, int stateStride,
+                                 float* block, int stride, int channels, int count)
+{
+    stageCount = std::min(stageCount, MAX_BIQUAD_STAGES);
+    if (stageCount > 0 && channels > 0 && count > 0) {
+        kernels().biquad_planar(stages, stageCount, state, stateStride, block, stride, channels, count);
+    }
+}
@@ -0,0 +1,120 @@
+/**
+ * @file signal_kernels.h
+ * @brief Definition of the SignalKernels class
+ *
+ * This file contains the definition of the SignalKernels class, a small
+ * library of vectorized per-sample kernels for waveform ingest and display
+ * mapping, with SSE2, AVX2 and NEON implementations and a scalar fallback.
+ */
+#ifndef SIGNAL_KERNELS_H
+#define SIGNAL_KERNELS_H
+
+/**
+ * @brief Coefficients of one biquad filter section, normalized to a0 = 1
+ *
+ * The section computes y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2]
+ * - a1 y[n-1] - a2 y[n-2].
+ */
+struct BiquadCoefficients {
+    float b0 = 1.0f;    ///< Gain of the current input
+    float b1 = 0.0f;    ///< Gain of the previous input
+    float b2 = 0.0f;    ///< Gain of the input before that
+    float a1 = 0.0f;    ///< Feedback of the previous output
+    float a2 = 0.0f;    ///< Feedback of the output before that
+};
+
+/**
+ * @brief Vectorized kernels with runtime instruction set dispatch
+ *
+ * The best implementation the processor supports is chosen on first use:
+ * AVX2 with FMA where available on x86, otherwise SSE2, NEON on ARM, and
+ * plain C++ everywhere else. All implementations produce the same results
+ * up to floating point rounding, and none requires aligned buffers.
+ *
+ * The biquad kernel works on planar multi-channel blocks, one contiguous
+ * run of samples per channel. Because an IIR filter is sequential in time,
+ * it is vectorized across channels instead: groups of four or eight
+ * channels are transposed in registers and filtered side by side, so a
+ * 12-lead ECG costs little more than three or two single channels.
+ */
+class SignalKernels {
+public:
+    /**
+     * @brief Instruction sets the kernels are implemented for
+     */
+    enum class InstructionSet {
+        Scalar,     ///< Portable C++
+        SSE2,       ///< x86 SSE2, four lanes
+        AVX2,       ///< x86 AVX2 with FMA, eight lanes
+        NEON        ///< ARM NEON, four lanes
+    };
+
+    static constexpr int MAX_BIQUAD_STAGES = 8;     ///< Longest cascade BiquadPlanar() processes
+
+    /**
+     * @brief Get the instruction set the kernels currently use
+     * @return Active instruction set
+     */
+    static InstructionSet GetInstructionSet();
+
+    /**
+     * @brief Get the best instruction set this processor supports
+     * @return Fastest supported instruction set
+     */
+    static InstructionSet GetBestInstructionSet();
+
+    /**
+     * @brief Select the instruction set the kernels use, for benchmarks and comparisons
+     * @param instructionSet Instruction set to use
+     * @return False if the processor or build does not support it
+     */
+    static bool SetInstructionSet(InstructionSet instructionSet);
+
+    /**
+     * @brief Get the name of an instruction set
+     * @param instructionSet Instruction set
+     * @return Name for logs and reports
+     */
+    static const char* GetInstructionSetName(InstructionSet instructionSet);
+
+    /**
+     * @brief Apply a gain and offset to samples and clamp the results
+     * @param in Input samples
+     * @param out Output samples, may be the same as in
+     * @param count Number of samples
+     * @param gain Factor applied to every sample
+     * @param offset Value added after the gain
+     * @param low Lowest output value
+     * @param high Highest output value
+     */
+    static void ScaleOffset(const float* in, float* out, int count, float gain, float offset, float low, float high);
+
+    /**
+     * @brief Find the smallest and largest of a run of samples
+     * @param in Input samples, not containing NaN
+     * @param count Number of samples, at least 1
+     * @param min Receives the smallest sample
+     * @param max Receives the largest sample
+     */
+    static void MinMax(const float* in, int count, float& min, float& max);
+
+    /**
+     * @brief Filter a planar multi-channel block in place through a biquad cascade
+     * @param stages Filter sections, applied in order
+     * @param stageCount Number of sections, at most MAX_BIQUAD_STAGES
+     * @param state Filter memory, two values per section and channel
+     * @param stateStride Distance between the memory rows of two sections' values
+     * @param block Samples of the first channel; channel c starts at block + c * stride
+     * @param stride Distance between the first samples of two channels
+     * @param channels Number of channels
+     * @param count Number of samples per channel
+     *
+     * The filters use the transposed direct form II. The first and second
+     * memory value of section s for channel c are state[2 s stateStride + c]
+     * and state[(2 s + 1) stateStride + c].
+     */
+    static void BiquadPlanar(const BiquadCoefficients* stages, int stageCount, float* state, int stateStride,
+                             float* block, int stride, int channels, int count);
+};
+
+#endif // SIGNAL_KERNELS_H
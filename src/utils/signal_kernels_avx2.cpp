@@ -0,0 +1,113 @@
+/**
+ * @file signal_kernels_avx2.cpp
+ * @brief AVX2 implementation of the signal kernels
+ *
+ * This file instantiates the kernel templates for eight-lane AVX2 registers
+ * with fused multiply-add. It is the only file built with AVX2 enabled, and
+ * its functions are only called once the processor has been found to
+ * support them.
+ */
+#include "signal_kernels_impl.h"
+
+#if defined(VITALSYNC_KERNELS_AVX2)
+#include <immintrin.h>
+
+/**
+ * @namespace Anonymous namespace for the AVX2 register abstraction
+ * @brief Contains the eight-lane register operations used by the kernel templates
+ */
+namespace {
+    /**
+     * @brief Eight float lanes in an AVX register
+     */
+    struct Avx2Lanes {
+        using Reg = __m256;
+        static constexpr int WIDTH = 8;
+
+        static Reg Load(const float* p) { return _mm256_loadu_ps(p); }
+        static void Store(float* p, Reg v) { _mm256_storeu_ps(p, v); }
+        static Reg Set1(float v) { return _mm256_set1_ps(v); }
+        static Reg Mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+        static Reg MulAdd(Reg a, Reg b, Reg c) { return _mm256_fmadd_ps(a, b, c); }
+        static Reg Min(Reg a, Reg b) { return _mm256_min_ps(a, b); }
+        static Reg Max(Reg a, Reg b) { return _mm256_max_ps(a, b); }
+
+        static float ReduceMin(Reg v)
+        {
+            __m128 h = _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+            h = _mm_min_ps(h, _mm_shuffle_ps(h, h, _MM_SHUFFLE(1, 0, 3, 2)));
+            h = _mm_min_ps(h, _mm_shuffle_ps(h, h, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_cvtss_f32(h);
+        }
+
+        static float ReduceMax(Reg v)
+        {
+            __m128 h = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+            h = _mm_max_ps(h, _mm_shuffle_ps(h, h, _MM_SHUFFLE(1, 0, 3, 2)));
+            h = _mm_max_ps(h, _mm_shuffle_ps(h, h, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_cvtss_f32(h);
+        }
+
+        static void Transpose(Reg* r)
+        {
+            const __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+            const __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+            const __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+            const __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+            const __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+            const __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+            const __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+            const __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+            const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+            r[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+            r[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+            r[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+            r[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+            r[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+            r[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+            r[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+            r[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+        }
+    };
+}
+
+/**
+ * @brief AVX2 version of SignalKernels::ScaleOffset()
+ */
+void SignalKernelsAvx2::ScaleOffset(const float* in, float* out, int count, float gain, float offset,
+                                    float low, float high)
+{
+    scaleOffsetLanes<Avx2Lanes>(in, out, count, gain, offset, low, high);
+}
+
+/**
+ * @brief AVX2 version of SignalKernels::MinMax()
+ */
+void SignalKernelsAvx2::MinMax(const float* in, int count, float& min, float& max)
+{
+    minMaxLanes<Avx2Lanes>(in, count, min, max);
+}
+
+/**
+ * @brief AVX2 version of SignalKernels::BiquadPlanar()
+ *
+ * Groups of eight channels are filtered together, a remaining group of four
+ * in SSE registers, and the rest on the scalar path.
+ */
+void SignalKernelsAvx2::BiquadPlanar(const BiquadCoefficients* stages, int stageCount, float* state, int stateStride,
+                                     float* block, int stride, int channels, int count)
+{
+    const int wide = channels - channels % Avx2Lanes::WIDTH;
+    biquadPlanarLanes<Avx2Lanes>(stages, stageCount, state, stateStride, block, stride, wide, count);
+    biquadPlanarLanes<SseLanes>(stages, stageCount, state + wide, stateStride,
+                                block + static_cast<long long>(wide) * stride, stride, channels - wide, count);
+}
+
+#endif // VITALSYNC_KERNELS_AVX2
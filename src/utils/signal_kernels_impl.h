@@ -0,0 +1,292 @@
+/**
+ * @file signal_kernels_impl.h
+ * @brief Instruction set independent templates of the signal kernels
+ *
+ * This file contains the kernel algorithms written once against a small
+ * register abstraction, together with the scalar reference versions. It is
+ * included by the translation units that instantiate the kernels for one
+ * instruction set each, and everything in it has internal linkage, so code
+ * compiled for AVX2 can never be picked by the linker for a caller compiled
+ * for the baseline instruction set.
+ */
+#ifndef SIGNAL_KERNELS_IMPL_H
+#define SIGNAL_KERNELS_IMPL_H
+
+#include "signal_kernels.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VITALSYNC_KERNELS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/**
+ * @namespace Anonymous namespace for the kernel templates
+ * @brief Contains the scalar kernels, the lane-generic kernel templates and the SSE2 registers
+ */
+namespace {
+    /**
+     * @brief Scalar version of SignalKernels::ScaleOffset()
+     */
+    inline void scaleOffsetScalar(const float* in, float* out, int count, float gain, float offset,
+                                  float low, float high)
+    {
+        for (int i = 0; i < count; ++i) {
+            out[i] = std::min(std::max(in[i] * gain + offset, low), high);
+        }
+    }
+
+    /**
+     * @brief Scalar version of SignalKernels::MinMax()
+     */
+    inline void minMaxScalar(const float* in, int count, float& min, float& max)
+    {
+        float lowest = in[0];
+        float highest = in[0];
+        for (int i = 1; i < count; ++i) {
+            lowest = std::min(lowest, in[i]);
+            highest = std::max(highest, in[i]);
+        }
+        min = lowest;
+        max = highest;
+    }
+
+    /**
+     * @brief Filters one channel through a biquad cascade
+     * @param stages Filter sections
+     * @param stageCount Number of sections
+     * @param state Memory of the channel's first section, rows stateStride apart
+     * @param stateStride Distance between memory rows
+     * @param samples Samples, filtered in place
+     * @param count Number of samples
+     */
+    inline void biquadChannelScalar(const BiquadCoefficients* stages, int stageCount, float* state,
+                                    int stateStride, float* samples, int count)
+    {
+        for (int s = 0; s < stageCount; ++s) {
+            const BiquadCoefficients& c = stages[s];
+            float& z1 = state[(2 * s) * stateStride];
+            float& z2 = state[(2 * s + 1) * stateStride];
+            float m1 = z1;
+            float m2 = z2;
+            for (int i = 0; i < count; ++i) {
+                const float x = samples[i];
+                const float y = c.b0 * x + m1;
+                m1 = c.b1 * x - c.a1 * y + m2;
+                m2 = c.b2 * x - c.a2 * y;
+                samples[i] = y;
+            }
+            z1 = m1;
+            z2 = m2;
+        }
+    }
+
+    /**
+     * @brief Scalar version of SignalKernels::BiquadPlanar()
+     */
+    inline void biquadPlanarScalar(const BiquadCoefficients* stages, int stageCount, float* state, int stateStride,
+                                   float* block, int stride, int channels, int count)
+    {
+        for (int c = 0; c < channels; ++c) {
+            biquadChannelScalar(stages, stageCount, state + c, stateStride, block + static_cast<long long>(c) * stride,
+                                count);
+        }
+    }
+
+    /**
+     * @brief Lane-generic version of SignalKernels::ScaleOffset()
+     * @tparam Lanes Register abstraction of one instruction set
+     */
+    template <typename Lanes>
+    void scaleOffsetLanes(const float* in, float* out, int count, float gain, float offset, float low, float high)
+    {
+        using Reg = typename Lanes::Reg;
+        const Reg g = Lanes::Set1(gain);
+        const Reg o = Lanes::Set1(offset);
+        const Reg lo = Lanes::Set1(low);
+        const Reg hi = Lanes::Set1(high);
+
+        int i = 0;
+        for (; i + Lanes::WIDTH <= count; i += Lanes::WIDTH) {
+            Lanes::Store(out + i, Lanes::Min(Lanes::Max(Lanes::MulAdd(Lanes::Load(in + i), g, o), lo), hi));
+        }
+        scaleOffsetScalar(in + i, out + i, count - i, gain, offset, low, high);
+    }
+
+    /**
+     * @brief Lane-generic version of SignalKernels::MinMax()
+     * @tparam Lanes Register abstraction of one instruction set
+     *
+     * Two accumulator pairs hide the latency of the compare instructions.
+     */
+    template <typename Lanes>
+    void minMaxLanes(const float* in, int count, float& min, float& max)
+    {
+        using Reg = typename Lanes::Reg;
+        constexpr int W = Lanes::WIDTH;
+        if (count < 2 * W) {
+            minMaxScalar(in, count, min, max);
+            return;
+        }
+
+        Reg min0 = Lanes::Load(in);
+        Reg max0 = min0;
+        Reg min1 = Lanes::Load(in + W);
+        Reg max1 = min1;
+        int i = 2 * W;
+        for (; i + 2 * W <= count; i += 2 * W) {
+            const Reg a = Lanes::Load(in + i);
+            const Reg b = Lanes::Load(in + i + W);
+            min0 = Lanes::Min(min0, a);
+            max0 = Lanes::Max(max0, a);
+            min1 = Lanes::Min(min1, b);
+            max1 = Lanes::Max(max1, b);
+        }
+
+        float lowest = Lanes::ReduceMin(Lanes::Min(min0, min1));
+        float highest = Lanes::ReduceMax(Lanes::Max(max0, max1));
+        for (; i < count; ++i) {
+            lowest = std::min(lowest, in[i]);
+            highest = std::max(highest, in[i]);
+        }
+        min = lowest;
+        max = highest;
+    }
+
+    /**
+     * @brief Lane-generic version of SignalKernels::BiquadPlanar()
+     * @tparam Lanes Register abstraction of one instruction set
+     *
+     * Channels are processed in groups of one register width. Within a group
+     * a square tile of samples is loaded per channel and transposed, so each
+     * register holds one instant of all channels in the group and the
+     * cascade runs on all of them at once. The filter memory of the group
+     * stays in registers for the whole block. Channels left over after the
+     * last full group take the scalar path.
+     */
+    template <typename Lanes>
+    void biquadPlanarLanes(const BiquadCoefficients* stages, int stageCount, float* state, int stateStride,
+                           float* block, int stride, int channels, int count)
+    {
+        using Reg = typename Lanes::Reg;
+        constexpr int W = Lanes::WIDTH;
+        constexpr int MAX = SignalKernels::MAX_BIQUAD_STAGES;
+
+        Reg b0[MAX], b1[MAX], b2[MAX], a1[MAX], a2[MAX];
+        for (int s = 0; s < stageCount; ++s) {
+            b0[s] = Lanes::Set1(stages[s].b0);
+            b1[s] = Lanes::Set1(stages[s].b1);
+            b2[s] = Lanes::Set1(stages[s].b2);
+            a1[s] = Lanes::Set1(-stages[s].a1);
+            a2[s] = Lanes::Set1(-stages[s].a2);
+        }
+
+        auto step = [&](Reg x, Reg* z1, Reg* z2) {
+            for (int s = 0; s < stageCount; ++s) {
+                const Reg y = Lanes::MulAdd(b0[s], x, z1[s]);
+                z1[s] = Lanes::MulAdd(a1[s], y, Lanes::MulAdd(b1[s], x, z2[s]));
+                z2[s] = Lanes::MulAdd(a2[s], y, Lanes::Mul(b2[s], x));
+                x = y;
+            }
+            return x;
+        };
+
+        int c = 0;
+        for (; c + W <= channels; c += W) {
+            Reg z1[MAX], z2[MAX];
+            for (int s = 0; s < stageCount; ++s) {
+                z1[s] = Lanes::Load(state + (2 * s) * stateStride + c);
+                z2[s] = Lanes::Load(state + (2 * s + 1) * stateStride + c);
+            }
+
+            float* rows[W];
+            for (int k = 0; k < W; ++k) {
+                rows[k] = block + static_cast<long long>(c + k) * stride;
+            }
+
+            int t = 0;
+            for (; t + W <= count; t += W) {
+                Reg tile[W];
+                for (int k = 0; k < W; ++k) {
+                    tile[k] = Lanes::Load(rows[k] + t);
+                }
+                Lanes::Transpose(tile);
+                for (int k = 0; k < W; ++k) {
+                    tile[k] = step(tile[k], z1, z2);
+                }
+                Lanes::Transpose(tile);
+                for (int k = 0; k < W; ++k) {
+                    Lanes::Store(rows[k] + t, tile[k]);
+                }
+            }
+
+            // Samples after the last full tile, one instant at a time
+            for (; t < count; ++t) {
+                alignas(32) float instant[W];
+                for (int k = 0; k < W; ++k) {
+                    instant[k] = rows[k][t];
+                }
+                Lanes::Store(instant, step(Lanes::Load(instant), z1, z2));
+                for (int k = 0; k < W; ++k) {
+                    rows[k][t] = instant[k];
+                }
+            }
+
+            for (int s = 0; s < stageCount; ++s) {
+                Lanes::Store(state + (2 * s) * stateStride + c, z1[s]);
+                Lanes::Store(state + (2 * s + 1) * stateStride + c, z2[s]);
+            }
+        }
+
+        biquadPlanarScalar(stages, stageCount, state + c, stateStride, block + static_cast<long long>(c) * stride,
+                           stride, channels - c, count);
+    }
+
+#if defined(VITALSYNC_KERNELS_SSE2)
+    /**
+     * @brief Four float lanes in an SSE2 register
+     */
+    struct SseLanes {
+        using Reg = __m128;
+        static constexpr int WIDTH = 4;
+
+        static Reg Load(const float* p) { return _mm_loadu_ps(p); }
+        static void Store(float* p, Reg v) { _mm_storeu_ps(p, v); }
+        static Reg Set1(float v) { return _mm_set1_ps(v); }
+        static Reg Mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+        static Reg MulAdd(Reg a, Reg b, Reg c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+        static Reg Min(Reg a, Reg b) { return _mm_min_ps(a, b); }
+        static Reg Max(Reg a, Reg b) { return _mm_max_ps(a, b); }
+
+        static float ReduceMin(Reg v)
+        {
+            v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+            v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_cvtss_f32(v);
+        }
+
+        static float ReduceMax(Reg v)
+        {
+            v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+            v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_cvtss_f32(v);
+        }
+
+        static void Transpose(Reg* r) { _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]); }
+    };
+#endif
+}
+
+/**
+ * @brief AVX2 kernels, compiled in their own translation unit with AVX2 enabled
+ *
+ * Only called after the processor has been found to support AVX2 and FMA.
+ */
+namespace SignalKernelsAvx2 {
+    void ScaleOffset(const float* in, float* out, int count, float gain, float offset, float low, float high);
+    void MinMax(const float* in, int count, float& min, float& max);
+    void BiquadPlanar(const BiquadCoefficients* stages, int stageCount, float* state, int stateStride,
+                      float* block, int stride, int channels, int count);
+}
+
+#endif // SIGNAL_KERNELS_IMPL_H
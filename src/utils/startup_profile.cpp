@@ -0,0 +1,139 @@
+/**
+ * @file startup_profile.cpp
+ * @brief Implementation of the StartupProfile class
+ *
+ * This file implements the StartupProfile class, which keeps the phase
+ * timings of the launch and writes them to the log.
+ */
+#include "startup_profile.h"
+#include "log_categories.h"
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+
+/**
+ * @namespace Anonymous namespace for the profile state
+ * @brief Contains the clock and the phases recorded so far
+ */
+namespace {
+    const int PHASE_NAME_WIDTH = 32;    ///< Column width of the phase names in the report
+
+    /**
+     * @brief A closed phase of the launch
+     */
+    struct Phase {
+        QString name;       ///< Name of the phase
+        qint64 durationMs;  ///< Duration of the phase
+    };
+
+    /**
+     * @brief State of the profile
+     */
+    struct ProfileState {
+        QMutex mutex;               ///< Guards the state
+        QElapsedTimer clock;        ///< Started by StartupProfile::Start()
+        qint64 lastMarkMs = 0;      ///< Time of the last mark
+        QVector<Phase> phases;      ///< Phases closed so far
+    };
+
+    /**
+     * @brief Gets the state of the profile
+     * @return The state, never destroyed
+     */
+    ProfileState& state()
+    {
+        static ProfileState* profile = new ProfileState();
+        return *profile;
+    }
+}
+
+std::atomic<bool> StartupProfile::first_frame_marked_(false);
+
+/**
+ * @brief Starts the clock and forgets earlier phases
+ */
+void StartupProfile::Start()
+{
+    ProfileState& profile = state();
+    QMutexLocker locker(&profile.mutex);
+    profile.clock.start();
+    profile.lastMarkMs = 0;
+    profile.phases.clear();
+    first_frame_marked_.store(false, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Closes the current phase
+ * @param phase Name of the phase that ends now
+ *
+ * Does nothing before Start().
+ */
+void StartupProfile::Mark(const QString& phase)
+{
+    ProfileState& profile = state();
+    QMutexLocker locker(&profile.mutex);
+    if (!profile.clock.isValid()) {
+        return;
+    }
+
+    const qint64 now = profile.clock.elapsed();
+    profile.phases.append({ phase, now - profile.lastMarkMs });
+    profile.lastMarkMs = now;
+}
+
+/**
+ * @brief Gets the time since Start()
+ * @return Elapsed milliseconds, 0 before Start()
+ */
+qint64 StartupProfile::ElapsedMs()
+{
+    ProfileState& profile = state();
+    QMutexLocker locker(&profile.mutex);
+    return profile.clock.isValid() ? profile.clock.elapsed() : 0;
+}
+
+/**
+ * @brief Formats the phases closed so far
+ * @return One line per phase with its duration and share of the total
+ */
+QString StartupProfile::FormatReport()
+{
+    ProfileState& profile = state();
+    QMutexLocker locker(&profile.mutex);
+
+    const qint64 total = profile.lastMarkMs;
+    QString report = QStringLiteral("Startup took %1 ms:").arg(total);
+    for (const Phase& phase : profile.phases) {
+        const double share = total > 0 ? 100.0 * static_cast<double>(phase.durationMs) / static_cast<double>(total) : 0.0;
+        report += QStringLiteral("\n  %1 %2 ms %3%")
+                      .arg(phase.name, -PHASE_NAME_WIDTH)
+                      .arg(phase.durationMs, 6)
+                      .arg(share, 5, 'f', 1);
+    }
+    return report;
+}
+
+/**
+ * @brief Logs the phases closed so far
+ */
+void StartupProfile::Report()
+{
+    qCInfo(lcMetrics).noquote() << FormatReport();
+}
+
+/**
+ * @brief Logs the first frame unless another thread already did
+ */
+void StartupProfile::markFirstFrame()
+{
+    if (first_frame_marked_.exchange(true, std::memory_order_relaxed)) {
+        return;
+    }
+
+    const qint64 elapsed = ElapsedMs();
+    if (elapsed > 0) {
+        qCInfo(lcMetrics).noquote() << QStringLiteral("Startup: first frame ingested after %1 ms").arg(elapsed);
+    }
+}
@@ -0,0 +1,78 @@
+/**
+ * @file startup_profile.h
+ * @brief Definition of the StartupProfile class
+ *
+ * This file contains the definition of the StartupProfile class, which times
+ * the phases of the application's launch and reports where the time to the
+ * first waveform goes.
+ */
+#ifndef STARTUP_PROFILE_H
+#define STARTUP_PROFILE_H
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+/**
+ * @brief Phase timings of the launch
+ *
+ * The clock starts with Start() at the top of main(). Every Mark() closes a
+ * phase that began with the previous mark, so the phases add up to the time
+ * since start. Report() logs the breakdown as one info message in the
+ * "vitalsync.metrics" category once the event loop runs; the first frame any
+ * data manager ingests is logged on its own when it arrives.
+ *
+ * Mark() and Report() are meant for the GUI thread. MarkFirstFrame() may be
+ * called from any thread and costs one relaxed load once the first frame was
+ * seen.
+ */
+class StartupProfile {
+public:
+    /**
+     * @brief Start the clock and forget earlier phases
+     */
+    static void Start();
+
+    /**
+     * @brief Close the current phase
+     * @param phase Name of the phase that ends now
+     */
+    static void Mark(const QString& phase);
+
+    /**
+     * @brief Get the time since Start()
+     * @return Elapsed milliseconds
+     */
+    static qint64 ElapsedMs();
+
+    /**
+     * @brief Log the time to the first ingested frame, once
+     */
+    static void MarkFirstFrame()
+    {
+        if (!first_frame_marked_.load(std::memory_order_relaxed)) {
+            markFirstFrame();
+        }
+    }
+
+    /**
+     * @brief Format the phases closed so far
+     * @return One line per phase with its duration and share of the total
+     */
+    static QString FormatReport();
+
+    /**
+     * @brief Log the phases closed so far
+     */
+    static void Report();
+
+private:
+    /**
+     * @brief Log the first frame unless another thread already did
+     */
+    static void markFirstFrame();
+
+    static std::atomic<bool> first_frame_marked_;   ///< Whether the first frame was logged
+};
+
+#endif // STARTUP_PROFILE_H
@@ -0,0 +1,124 @@
+/**
+ * @file thread_tuning.cpp
+ * @brief Implementation of the ThreadTuning class
+ *
+ * This file implements the ThreadTuning class, which applies processor
+ * affinity and real-time priority to the calling thread.
+ */
+#include "thread_tuning.h"
+#include "log_categories.h"
+
+#include <QDebug>
+#include <QStringList>
+#include <QThread>
+#include <algorithm>
+
+#if defined(Q_OS_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * @namespace Anonymous namespace for constants
+ * @brief Contains constants used by the ThreadTuning implementation
+ */
+namespace {
+    const int MAX_CPU = 1023;   ///< Highest processor number accepted in a processor list
+}
+
+/**
+ * @brief Tunes the thread that calls this
+ * @param options Affinity and priority to apply
+ * @return True if all options were applied
+ *
+ * Options that fail are logged and the others are still applied, so a
+ * missing privilege for real-time scheduling does not lose the affinity.
+ */
+bool ThreadTuning::ApplyToCurrentThread(const Options& options)
+{
+    const QString name = QThread::currentThread()->objectName();
+    bool success = true;
+
+#if defined(Q_OS_LINUX)
+    if (!options.cpus.isEmpty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : options.cpus) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &set);
+            }
+        }
+
+        const int error = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (error != 0) {
+            qWarning() << "ThreadTuning: Cannot pin" << name << "to processors" << options.cpus
+                       << ":" << qt_error_string(error);
+            success = false;
+        } else {
+            qCInfo(lcIngest) << "ThreadTuning: Pinned" << name << "to processors" << options.cpus;
+        }
+    }
+
+    if (options.realtimePriority > 0) {
+        sched_param param {};
+        param.sched_priority = std::clamp(options.realtimePriority,
+                                          sched_get_priority_min(SCHED_FIFO),
+                                          sched_get_priority_max(SCHED_FIFO));
+
+        const int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (error != 0) {
+            qWarning() << "ThreadTuning: Cannot give" << name << "real-time priority" << param.sched_priority
+                       << ":" << qt_error_string(error);
+            success = false;
+        } else {
+            qCInfo(lcIngest) << "ThreadTuning: Running" << name << "at real-time priority" << param.sched_priority;
+        }
+    }
+#else
+    if (!options.cpus.isEmpty()) {
+        qWarning() << "ThreadTuning: Processor affinity is not supported on this platform";
+        success = false;
+    }
+
+    if (options.realtimePriority > 0) {
+        QThread::currentThread()->setPriority(QThread::TimeCriticalPriority);
+        qCInfo(lcIngest) << "ThreadTuning: Running" << name << "at time-critical priority";
+    }
+#endif
+
+    return success;
+}
+
+/**
+ * @brief Parses a processor list such as "2,3" or "0-3,6"
+ * @param text Comma-separated processor numbers and ranges
+ * @param cpus Receives the processors in ascending order
+ * @return True if the list is valid and not empty
+ */
+bool ThreadTuning::ParseCpuList(const QString& text, QVector<int>& cpus)
+{
+    cpus.clear();
+
+    for (const QString& item : text.split(',', Qt::SkipEmptyParts)) {
+        const QStringList bounds = item.trimmed().split('-');
+        if (bounds.size() > 2) {
+            return false;
+        }
+
+        bool firstOk = false;
+        bool lastOk = false;
+        const int first = bounds.first().toInt(&firstOk);
+        const int last = bounds.size() == 2 ? bounds.last().toInt(&lastOk) : first;
+        if (!firstOk || (bounds.size() == 2 && !lastOk) || first < 0 || last < first || last > MAX_CPU) {
+            return false;
+        }
+
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.append(cpu);
+        }
+    }
+
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return !cpus.isEmpty();
+}
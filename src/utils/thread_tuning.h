@@ -0,0 +1,55 @@
+/**
+ * @file thread_tuning.h
+ * @brief Definition of the ThreadTuning class
+ *
+ * This file contains the definition of the ThreadTuning class, which pins a
+ * thread to a set of processors and gives it a real-time scheduling
+ * priority, so acquisition keeps its timing on a loaded server.
+ */
+#ifndef THREAD_TUNING_H
+#define THREAD_TUNING_H
+
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief Processor affinity and scheduling priority of threads
+ *
+ * On Linux the affinity is set with pthread_setaffinity_np() and the
+ * priority with the SCHED_FIFO policy, which needs CAP_SYS_NICE or a
+ * matching RLIMIT_RTPRIO. Elsewhere the affinity is not supported and a
+ * real-time priority falls back to QThread::TimeCriticalPriority.
+ */
+class ThreadTuning {
+public:
+    /**
+     * @brief How a thread is to be tuned
+     */
+    struct Options {
+        QVector<int> cpus;          ///< Processors the thread may run on, empty for all
+        int realtimePriority = 0;   ///< SCHED_FIFO priority, 0 for the default scheduling
+
+        /**
+         * @brief Check if the options change anything
+         * @return True if neither affinity nor priority is set
+         */
+        bool IsEmpty() const { return cpus.isEmpty() && realtimePriority <= 0; }
+    };
+
+    /**
+     * @brief Tune the thread that calls this
+     * @param options Affinity and priority to apply
+     * @return True if all options were applied
+     */
+    static bool ApplyToCurrentThread(const Options& options);
+
+    /**
+     * @brief Parse a processor list such as "2,3" or "0-3,6"
+     * @param text Comma-separated processor numbers and ranges
+     * @param cpus Receives the processors in ascending order
+     * @return True if the list is valid and not empty
+     */
+    static bool ParseCpuList(const QString& text, QVector<int>& cpus);
+};
+
+#endif // THREAD_TUNING_H